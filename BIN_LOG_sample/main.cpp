@@ -0,0 +1,189 @@
+//=====================================================================//
+/*! @file
+    @brief  バイナリ・ログ（utils::bin_log）サンプル @n
+			CMT 割り込みとメインループから BIN_LOG でレコードを積み、 @n
+			「run」の間、レコード列をそのまま SCI に送る。 @n
+			受け取ったデータは、ホストの test/host/bin_log_dec で、ELF の @n
+			フォーマット文字列を使いテキストに戻す。 @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/cmt_mgr.hpp"
+
+#include "common/format.hpp"
+#include "common/command.hpp"
+#include "common/bin_log.hpp"
+
+namespace {
+
+	typedef utils::fixed_fifo<char, 512> RXB;  // RX (RECV) バッファの定義
+	typedef utils::fixed_fifo<char, 1024> TXB;  // TX (SEND) バッファの定義
+	typedef device::sci_io<board_profile::SCI_CH, RXB, TXB, board_profile::SCI_ORDER> SCI;
+	SCI		sci_;
+
+	static constexpr uint32_t TICK_FREQ = 1000;  ///< タイムスタンプの周波数 [Hz]
+
+	typedef device::cmt_mgr<board_profile::CMT_CH> CMT;
+	CMT		cmt_;
+
+	// タイムスタンプは CMT のカウンター（TICK_FREQ）
+	typedef utils::bin_log<4096, CMT> BLOG;
+	BLOG	blog_;
+
+	volatile bool	run_;
+	uint32_t		loop_;
+
+	typedef utils::command<256> CMD;
+	CMD		cmd_;
+
+
+	// CMT 割り込みから呼ばれる
+	void tick_task_()
+	{
+		if(!run_) return;
+
+		auto cnt = CMT::get_counter();
+		if((cnt % 100) == 0) {
+			BIN_LOG(blog_, "Tick: %u, LED: %d\n", cnt, static_cast<int>(board_profile::LED::P()));
+		}
+	}
+
+
+	void list_stat_()
+	{
+		utils::format("Buffer: %u [bytes], Lost: %u [records]\n")
+			% blog_.length() % blog_.get_lost();
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		if(cmd_.cmp_word(0, "run")) {
+			utils::format("Run (stop: any key)...\n");
+			loop_ = 0;
+			BIN_LOG(blog_, "Start: %s, %u [Hz]\n", board_profile::system_str_, TICK_FREQ);
+			run_ = true;
+		} else if(cmd_.cmp_word(0, "stat")) {
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    run                     send the record stream to SCI (stop: any key)\n");
+			utils::format("    stat                    list status\n");
+			utils::format("    help                    command list (this)\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+	}
+
+
+	void run_service_()
+	{
+		++loop_;
+		if((loop_ % 1000) == 0) {
+			BIN_LOG(blog_, "Main: %u loops, Lost: %u, %5.3f\n",
+				loop_, blog_.get_lost(), static_cast<float>(loop_) / 1000.0f);
+		}
+
+		// 確定したレコードを送る
+		blog_.service(sci_);
+
+		if(sci_.recv_length() > 0) {  // キー入力で止める
+			while(sci_.recv_length() > 0) {
+				sci_.getch();
+			}
+			run_ = false;
+			BIN_LOG(blog_, "Stop: %u loops\n", loop_);
+			blog_.service(sci_);
+			utils::format("\nStop\n");
+			list_stat_();
+		}
+	}
+}
+
+
+extern "C" {
+
+	// syscalls.c から呼ばれる、標準出力（stdout, stderr）
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+	// syscalls.c から呼ばれる、標準入力（stdin）
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // タイマー設定（タイムスタンプ）
+		auto intr = device::ICU::LEVEL::_4;
+		cmt_.start(TICK_FREQ, intr, tick_task_);
+	}
+
+	{  // SCI の開始
+		auto intr = device::ICU::LEVEL::_2;
+		uint32_t baud = 115200;  // ボーレート
+		sci_.start(baud, intr);
+	}
+
+	auto clk = device::clock_profile::ICLK / 1'000'000;
+	utils::format("Start binary log sample for '%s' %d[MHz]\n") % system_str_ % clk;
+
+	LED::DIR = 1;
+	LED::P = 0;
+
+	cmd_.set_prompt("# ");
+
+	uint32_t cnt = 0;
+	while(1) {
+		cmt_.sync();
+
+		if(run_) {
+			run_service_();
+		} else {
+			command_();
+		}
+
+		++cnt;
+		if(cnt >= (TICK_FREQ / 2)) {
+			cnt = 0;
+		}
+		LED::P = (cnt < (TICK_FREQ / 4)) ? 0 : 1;
+	}
+}
@@ -0,0 +1,250 @@
+//=====================================================================//
+/*! @file
+    @brief  CAN FD サンプル @n
+			シリアルターミナルを接続して、対話式で、通信を行う @n
+			受信したフレームは、そのまま表示する @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/cmt_mgr.hpp"
+
+#include "common/format.hpp"
+#include "common/input.hpp"
+
+#include "common/canfd_io.hpp"
+
+#include "common/command.hpp"
+
+namespace {
+
+	typedef utils::fixed_fifo<char, 512> RXB;  // RX (RECV) バッファの定義
+	typedef utils::fixed_fifo<char, 256> TXB;  // TX (SEND) バッファの定義
+	typedef device::sci_io<board_profile::SCI_CH, RXB, TXB, board_profile::SCI_ORDER> SCI;
+	SCI		sci_;
+
+	typedef device::cmt_mgr<board_profile::CMT_CH> CMT;
+	CMT		cmt_;
+
+	//
+	// CAN FD 関連定義
+	//
+	typedef device::canfd_io_def CANFD;
+
+	// CAN FD 受信バッファの定義
+	typedef utils::fixed_fifo<device::canfd_frame, 32> CANFD_RXB;
+	// CAN FD 送信バッファの定義
+	typedef utils::fixed_fifo<device::canfd_frame, 32> CANFD_TXB;
+
+	typedef device::canfd_io<board_profile::CANFD0_CH, CANFD_RXB, CANFD_TXB, board_profile::CANFD_PORT> CANFD0;
+	CANFD0	canfd0_;
+
+	bool	ext_id_ = false;
+
+	typedef utils::command<256> CMD;
+	CMD		cmd_;
+
+
+	bool get_cmd_value_(uint32_t i, uint32_t& val)
+	{
+		char tmp[64];
+		cmd_.get_word(i, tmp, sizeof(tmp));
+		if(!(utils::input("%a", tmp) % val).status()) {
+			utils::format("Parse error: '%s'\n") % tmp;
+			return false;
+		}
+		return true;
+	}
+
+
+	void list_frame_(const device::canfd_frame& frm)
+	{
+		utils::format("(%05u) ID: 0x%08X%s, DLC: %u%s%s:")
+			% frm.get_TS()
+			% frm.get_id() % (frm.get_IDE() ? " (ext)" : "")
+			% frm.get_DLC()
+			% (frm.get_FDF() ? ", FD" : "") % (frm.get_BRS() ? ", BRS" : "");
+		for(uint32_t i = 0; i < frm.get_length(); ++i) {
+			if((i & 15) == 0 && i > 0) utils::format("\n      ");
+			utils::format(" %02X") % static_cast<uint16_t>(frm.get_DATA(i));
+		}
+		utils::format("\n");
+	}
+
+
+	void list_stat_()
+	{
+		const auto& st = CANFD0::get_recv_stat();
+		utils::format("Frames: %u, Lost (buffer): %u, Lost (FIFO): %u\n")
+			% st.frames % st.lost_soft % st.lost_hard;
+		uint32_t avg = st.frames > 0 ? (st.latency_sum / st.frames) : 0;
+		utils::format("IRQ: %u, Batch max: %u, Latency max: %u, avg: %u [bit]\n")
+			% st.irq % st.batch_max % st.latency_max % avg;
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		bool error = false;
+		if(cmd_.cmp_word(0, "ext")) {
+			ext_id_ = true;
+		} else if(cmd_.cmp_word(0, "std")) {
+			ext_id_ = false;
+		} else if(cmd_.cmp_word(0, "send") || cmd_.cmp_word(0, "send_cls")) {
+			// send は FD フォーマット（BRS 有り）、send_cls はクラシック CAN のフォーマットで送る
+			bool cls = cmd_.cmp_word(0, "send_cls");
+			uint32_t id = 0;
+			if(cmdn < 2 || !get_cmd_value_(1, id)) {
+				error = true;
+			} else if((cmdn - 2) > 64 || (cls && (cmdn - 2) > 8)) {
+				utils::format("Too many data...\n");
+				error = true;
+			} else {
+				device::canfd_frame frm;
+				frm.set_IDE(ext_id_);
+				frm.set_id(id);
+				uint32_t len = cmdn - 2;
+				auto dlc = device::canfd_frame::length_to_dlc(len);
+				frm.set_DLC(dlc);
+				for(uint32_t i = 0; i < device::canfd_frame::dlc_to_length(dlc); ++i) {
+					uint32_t v = 0;
+					if(i < len) {
+						if(!get_cmd_value_(2 + i, v)) {
+							error = true;
+							break;
+						}
+					}
+					frm.set_DATA(i, v);
+				}
+				if(!cls) {
+					frm.set_FDF(true);
+					frm.set_BRS(true);
+				}
+				if(!error && !canfd0_.send(frm)) {
+					utils::format("Send buffer full...\n");
+				}
+			}
+		} else if(cmd_.cmp_word(0, "stat")) {
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "clear")) {
+			CANFD0::clear_recv_stat();
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    ext                       set ext-id mode\n");
+			utils::format("    std                       set std-id mode\n");
+			utils::format("    send CAN-ID [data...]     send FD frame with BRS (data: 0 to 64)\n");
+			utils::format("    send_cls CAN-ID [data...] send classical frame (data: 0 to 8)\n");
+			utils::format("    stat                      list recv stat\n");
+			utils::format("    clear                     clear recv stat\n");
+			utils::format("    help                      command list (this)\n");
+			utils::format("\n");
+			utils::format("  Input number: nnn decimal, xnnn hexa-decimal, bnnn binary\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+
+		if(error) {
+			utils::format("Parameter error...\n");
+		}
+	}
+}
+
+
+extern "C" {
+
+	// syscalls.c から呼ばれる、標準出力（stdout, stderr）
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+
+	// syscalls.c から呼ばれる、標準入力（stdin）
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // タイマー設定（100Hz）
+		auto intr = device::ICU::LEVEL::_4;
+		cmt_.start(100, intr);
+	}
+
+	{  // SCI の開始
+		auto intr = device::ICU::LEVEL::_2;
+		uint32_t baud = 115200;  // ボーレート
+		sci_.start(baud, intr);
+	}
+
+	auto clk = device::clock_profile::ICLK / 1000000;
+	utils::format("Start CAN FD sample for '%s' %d[MHz]\n") % system_str_ % clk;
+
+	{  // CAN FD 開始（公称 500Kbps、データ 2Mbps）
+		if(!canfd0_.start(CANFD::SPEED::_500K, CANFD::DATA::_2M)) {
+			utils::format("Can't start CANFD0...\n");
+		} else {
+			utils::format("CANFD0: SPEED: %u [bps], DATA: %u [bps]\n")
+				% static_cast<uint32_t>(CANFD::SPEED::_500K) % static_cast<uint32_t>(CANFD::DATA::_2M);
+		}
+	}
+
+	LED::DIR = 1;
+	LED::P = 0;
+
+	cmd_.set_prompt("# ");
+
+	uint8_t cnt = 0;
+	while(1) {
+		cmt_.sync();
+
+		command_();
+
+		while(canfd0_.get_recv_num() > 0) {
+			auto frm = canfd0_.get_recv_frame();
+			list_frame_(frm);
+		}
+
+		++cnt;
+		if(cnt >= 50) {
+			cnt = 0;
+		}
+		LED::P = (cnt < 25) ? 0 : 1;
+	}
+}
@@ -4,9 +4,10 @@
 			シリアルターミナルを接続して、対話式で、通信を行う @n
 			※使い方は、コマンド「help」を参照 @n
 			「MULTI」を有効にするとマルチチャネルサポート @n
-			「LEGACY」モードの場合、メールボックス直接操作
+			「LEGACY」モードの場合、メールボックス直接操作 @n
+			コマンド「mode」で、CAN0 の受信をメールボックスと受信 FIFO で切り替える
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2020, 2023 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2020, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -35,7 +36,7 @@
 
 namespace {
 
-	static constexpr uint32_t can_cmd_ver_ = 100;
+	static constexpr uint32_t can_cmd_ver_ = 101;
 
 #if defined(SIG_RX71M)
 	#define MULTI
@@ -165,6 +166,27 @@ namespace {
 	}
 
 
+	// CAN0 の受信モードを切り替える（停止して、同じ速度で再開）
+	void recv_mode_(CAN::RECV_MODE mode)
+	{
+		constexpr auto can_speed = CAN::SPEED::_1M;
+		can0_.destroy(false);
+		if(!can0_.start(can_speed, CAN::interrupt_t(device::ICU::LEVEL::_1), mode)) {
+			utils::format("Can't start CAN0...\n");
+		}
+	}
+
+
+	void list_recv_mode_()
+	{
+		const auto& t = can0_.get_recv_stat();
+		utils::format("CAN0: Recv mode: %s\n")
+			% (can0_.get_recv_mode() == CAN::RECV_MODE::FIFO ? "FIFO" : "MAILBOX");
+		utils::format("    Frames: %u, Lost: %u (soft) %u (hard), IRQ: %u, Batch max: %u\n")
+			% t.frames % t.lost_soft % t.lost_hard % t.irq % t.batch_max;
+	}
+
+
 	void send_data_(uint32_t id, const uint8_t* src, uint32_t len)
 	{
 		if(cur_ch_ == 0) {
@@ -267,6 +289,16 @@ namespace {
 			}
 		} else if(cmd_.cmp_word(0, "status")) { // status
 			status_();
+		} else if(cmd_.cmp_word(0, "mode")) { // recv mode
+			if(cmdn == 1) {
+				list_recv_mode_();
+			} else if(cmdn == 2 && cmd_.cmp_word(1, "mailbox")) {
+				recv_mode_(CAN::RECV_MODE::MAILBOX);
+			} else if(cmdn == 2 && cmd_.cmp_word(1, "fifo")) {
+				recv_mode_(CAN::RECV_MODE::FIFO);
+			} else {
+				error = true;
+			}
 		} else if(cmd_.cmp_word(0, "stat")) { // stat
 			if(cmdn == 2) {
 				int32_t val;
@@ -322,6 +354,24 @@ namespace {
 			} else {
 				error = true;
 			}
+		} else if(cmd_.cmp_word(0, "filter")) {
+			if(cmdn == 1) {
+				analize_.list_filter();
+			} else if(cmdn == 2 && cmd_.cmp_word(1, "reset")) {
+				analize_.reset_filter();
+			} else if(cmdn == 4) {
+				int32_t idx;
+				int32_t lo;
+				int32_t hi;
+				if(!cmd_.get_integer(1, idx, false) || !cmd_.get_integer(2, lo, true)
+					|| !cmd_.get_integer(3, hi, true)) {
+					error = true;
+				} else if(!analize_.set_filter(idx, lo, hi)) {
+					utils::format("Illegal filter: %d, x%07X - x%07X\n") % idx % lo % hi;
+				}
+			} else {
+				error = true;
+			}
 		} else if(cmd_.cmp_word(0, "send_loop")) {
 			if(cmdn >= 2) {
 				int32_t val;
@@ -353,9 +403,12 @@ namespace {
 			utils::format("    stat MB-no             stat MCTLx register (MB-no: 0 to 31)\n");
 			utils::format("    list MB-no             list MBx register (MB-no: 0 to 31)\n");
 			utils::format("    status                 list recv/send error count\n");
+			utils::format("    mode [mailbox/fifo]    set/list CAN0 recv mode\n");
 			utils::format("    clear [CAN-ID]         clear map\n");
 			utils::format("    map [CAN-ID]           Display all collected IDs\n");
 			utils::format("    dump CAN-ID            dump frame data\n");
+			utils::format("    filter [NO LO HI]      set/list map ID range filter (NO: 0 to 3)\n");
+			utils::format("    filter reset           reset map ID range filter\n");
 			utils::format("    send_loop NUM [-rtr]   random ID, random DATA, send loop (RTR)\n");
 			utils::format("    help                   command list (this)\n");
 			utils::format("\n");
@@ -467,7 +520,7 @@ int main(int argc, char** argv)
 
 		command_();
 
-		analize_.service();
+		analize_.service(cmt_.get_counter(), cmt_.get_rate());
 
 #ifdef MULTI
 		while(can1_.get_recv_num() > 0) {
@@ -0,0 +1,259 @@
+//=====================================================================//
+/*! @file
+    @brief  CRC 演算器（device::crc_mgr）サンプル @n
+			CRC-8/16/32 を、演算器（CPU 入力、DMA 入力）とソフトウェア @n
+			（utils::crc_engine）で計算し、結果を比べて、速さを表示する。 @n
+			演算器が持たない種類（RX64M の CRC-32/CRC-32C）は、crc_mgr の中で @n
+			ソフトウェアになる。 @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/cmt_mgr.hpp"
+
+#include "common/format.hpp"
+#include "common/input.hpp"
+#include "common/command.hpp"
+
+#include "common/crc_engine.hpp"
+#include "RX600/crc_mgr.hpp"
+
+namespace {
+
+	typedef utils::fixed_fifo<char, 512> RXB;  // RX (RECV) バッファの定義
+	typedef utils::fixed_fifo<char, 256> TXB;  // TX (SEND) バッファの定義
+	typedef device::sci_io<board_profile::SCI_CH, RXB, TXB, board_profile::SCI_ORDER> SCI;
+	SCI		sci_;
+
+	static constexpr uint32_t TICK_FREQ = 1000;  ///< 計測の周波数 [Hz]
+
+	typedef device::cmt_mgr<board_profile::CMT_CH> CMT;
+	CMT		cmt_;
+
+	typedef utils::crc_def::TYPE TYPE;
+
+#if defined(SIG_RX64M) || defined(SIG_RX71M)
+	typedef device::CRC CRC_UNIT;	// CRC-8/16 だけ
+#else
+	typedef device::CRCA CRC_UNIT;	// CRC-8/16/32、16/32 ビット入力
+#endif
+	typedef device::crc_mgr<CRC_UNIT> CRC_CPU;					///< 演算器、CPU で入力
+	typedef device::crc_mgr<CRC_UNIT, device::DMAC0> CRC_DMA;	///< 演算器、DMA で入力
+
+	static constexpr uint32_t DATA_SIZE = 4096;
+	uint8_t		data_[DATA_SIZE + 4];
+
+	typedef utils::command<256> CMD;
+	CMD		cmd_;
+
+
+	const char* type_str_(TYPE t)
+	{
+		switch(t) {
+		case TYPE::CRC8:		return "CRC-8       ";
+		case TYPE::CRC16:		return "CRC-16      ";
+		case TYPE::CRC16_CCITT:	return "CRC-16/CCITT";
+		case TYPE::CRC32:		return "CRC-32      ";
+		case TYPE::CRC32C:		return "CRC-32C     ";
+		default:				return "?";
+		}
+	}
+
+
+	void fill_(uint32_t seed)
+	{
+		for(uint32_t i = 0; i < sizeof(data_); ++i) {
+			seed = seed * 1103515245 + 12345;
+			data_[i] = seed >> 16;
+		}
+	}
+
+
+	// 計算の時間（loop 回）[ms]
+	template <class F>
+	uint32_t time_(uint32_t loop, F f)
+	{
+		cmt_.sync();
+		auto t = CMT::get_counter();
+		for(uint32_t i = 0; i < loop; ++i) {
+			f();
+		}
+		return CMT::get_counter() - t;
+	}
+
+
+	template <TYPE T>
+	bool check_(uint32_t ofs, uint32_t len, uint32_t loop)
+	{
+		typedef utils::crc_engine<T, 4> SOFT;
+		constexpr auto spec = utils::crc_def::get_spec(T);
+
+		static const char str[] = "123456789";
+		bool ok = CRC_CPU::template calc<T>(str, 9) == spec.check;
+		ok = ok && CRC_DMA::template calc<T>(str, 9) == spec.check;
+
+		auto src = &data_[ofs];
+		auto s = SOFT::calc(src, len);
+		ok = ok && CRC_CPU::template calc<T>(src, len) == s;
+		ok = ok && CRC_DMA::template calc<T>(src, len) == s;
+
+		// 分割して計算しても同じ
+		auto h = len / 3;
+		auto reg = CRC_DMA::template update<T>(SOFT::init(), src, h);
+		reg = SOFT::update(reg, src + h, h);
+		reg = CRC_CPU::template update<T>(reg, src + h * 2, len - h * 2);
+		ok = ok && SOFT::final(reg) == s;
+
+		utils::format("%s (%s): %08X: %s")
+			% type_str_(T) % (CRC_CPU::is_hardware(T) ? "hard" : "soft")
+			% s % (ok ? "OK" : "NG");
+		if(loop > 0) {
+			auto ts = time_(loop, [=]() { SOFT::calc(src, len); });
+			auto tc = time_(loop, [=]() { CRC_CPU::template calc<T>(src, len); });
+			auto td = time_(loop, [=]() { CRC_DMA::template calc<T>(src, len); });
+			utils::format(", soft: %u, CPU: %u, DMA: %u [ms]") % ts % tc % td;
+		}
+		utils::format("\n");
+		return ok;
+	}
+
+
+	void check_all_(uint32_t ofs, uint32_t len, uint32_t loop)
+	{
+		utils::format("Data: %u [bytes] (offset: %u), loop: %u\n") % len % ofs % loop;
+		bool ok = check_<TYPE::CRC8>(ofs, len, loop);
+		ok = check_<TYPE::CRC16>(ofs, len, loop) && ok;
+		ok = check_<TYPE::CRC16_CCITT>(ofs, len, loop) && ok;
+		ok = check_<TYPE::CRC32>(ofs, len, loop) && ok;
+		ok = check_<TYPE::CRC32C>(ofs, len, loop) && ok;
+		if(!ok) {
+			utils::format("CRC check: NG\n");
+		}
+	}
+
+
+	bool get_value_(uint32_t n, uint32_t& v)
+	{
+		char tmp[32];
+		cmd_.get_word(n, tmp, sizeof(tmp));
+		if(!(utils::input("%d", tmp) % v).status()) {
+			utils::format("Parse error: '%s'\n") % tmp;
+			return false;
+		}
+		return true;
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		if(cmd_.cmp_word(0, "check")) {
+			uint32_t seed = 1;
+			if(cmdn >= 2 && !get_value_(1, seed)) return;
+			fill_(seed);
+			for(uint32_t ofs = 0; ofs < 4; ++ofs) {
+				check_all_(ofs, DATA_SIZE - ofs * 7, 0);
+			}
+		} else if(cmd_.cmp_word(0, "bench")) {
+			uint32_t loop = 100;
+			if(cmdn >= 2 && !get_value_(1, loop)) return;
+			check_all_(0, DATA_SIZE, loop);
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    check [seed]            compare hardware (CPU, DMA) with software\n");
+			utils::format("    bench [loop]            time of 4096 bytes x loop (default 100)\n");
+			utils::format("    help                    command list (this)\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+	}
+}
+
+
+extern "C" {
+
+	// syscalls.c から呼ばれる、標準出力（stdout, stderr）
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+	// syscalls.c から呼ばれる、標準入力（stdin）
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // タイマー設定（計測用）
+		auto intr = device::ICU::LEVEL::_4;
+		cmt_.start(TICK_FREQ, intr);
+	}
+
+	{  // SCI の開始
+		auto intr = device::ICU::LEVEL::_2;
+		uint32_t baud = 115200;  // ボーレート
+		sci_.start(baud, intr);
+	}
+
+	auto clk = device::clock_profile::ICLK / 1'000'000;
+	utils::format("Start CRC sample for '%s' %d[MHz]\n") % system_str_ % clk;
+
+	// 演算器、DMAC の電源を入れる
+	CRC_CPU::start();
+	CRC_DMA::start();
+
+	fill_(1);
+	check_all_(0, DATA_SIZE, 0);
+
+	LED::DIR = 1;
+	LED::P = 0;
+
+	cmd_.set_prompt("# ");
+
+	uint32_t cnt = 0;
+	while(1) {
+		cmt_.sync();
+
+		command_();
+
+		++cnt;
+		if(cnt >= (TICK_FREQ / 2)) {
+			cnt = 0;
+		}
+		LED::P = (cnt < (TICK_FREQ / 4)) ? 0 : 1;
+	}
+}
@@ -0,0 +1,253 @@
+//=====================================================================//
+/*! @file
+    @brief  RX72N Envision Kit DRW2D 表示リスト・サンプル @n
+			変わらない背景（グリッド、パネル、文字）を表示リスト（drw2d_list）に @n
+			一度だけ記録し、毎フレーム call_list で描画する。 @n
+			最初の描画は、次の sync_frame で d2 ディスプレイ・リストに変換され、 @n
+			以降のフレームは、それをコピーするだけで描画する。 @n
+			比較の為、「direct」で毎フレーム描画する方法に切り替えられる。 @n
+			ダブルバッファを使うので、RX72N 専用 @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/format.hpp"
+#include "common/command.hpp"
+
+#include "graphics/font8x16.hpp"
+#include "graphics/kfont.hpp"
+#include "graphics/font.hpp"
+
+namespace {
+
+	typedef graphics::font8x16 AFONT;
+	typedef graphics::kfont_null KFONT;
+	typedef graphics::font<AFONT, KFONT> FONT;
+	AFONT		afont_;
+	KFONT		kfont_;
+	FONT		font_(afont_, kfont_);
+
+	static const uint16_t LCD_X = 480;
+	static const uint16_t LCD_Y = 272;
+	uint16_t* fb_ = reinterpret_cast<uint16_t*>(board_profile::LCD_ORG);
+	typedef device::glcdc_mgr<device::GLCDC, LCD_X, LCD_Y, graphics::pixel::TYPE::RGB565> GLCDC_MGR;
+	typedef device::drw2d_mgr<GLCDC_MGR, FONT> RENDER;
+
+	GLCDC_MGR	glcdc_mgr_(nullptr, fb_);
+	RENDER		render_(glcdc_mgr_, font_);
+
+	typedef device::drw2d_list<512> LIST;
+	LIST		back_;		///< 背景の表示リスト
+
+	typedef graphics::def_color DEF_COLOR;
+
+	typedef utils::fixed_fifo<char, 512>  RECV_BUFF;
+	typedef utils::fixed_fifo<char, 1024> SEND_BUFF;
+	typedef device::sci_io<board_profile::SCI_CH, RECV_BUFF, SEND_BUFF, board_profile::SCI_ORDER> SCI;
+	SCI			sci_;
+
+	typedef utils::command<256> CMD;
+	CMD			cmd_;
+
+	bool		list_ = true;
+	bool		batch_ = true;
+
+
+	// 背景（グリッド、パネル、文字）
+	void draw_back_()
+	{
+		render_.clear(DEF_COLOR::Black);
+		render_.set_fore_color(DEF_COLOR::Darkgray);
+		for(int16_t x = 0; x < LCD_X; x += 16) {
+			render_.line(vtx::spos(x, 0), vtx::spos(x, LCD_Y - 1));
+		}
+		for(int16_t y = 0; y < LCD_Y; y += 16) {
+			render_.line(vtx::spos(0, y), vtx::spos(LCD_X - 1, y));
+		}
+		// 色違いのパネルを交互に置く（batch で同じ色がまとまる）
+		for(int16_t i = 0; i < 8; ++i) {
+			render_.set_fore_color((i & 1) ? DEF_COLOR::Navy : DEF_COLOR::Teal);
+			render_.round_box(vtx::srect(16 + i * 56, 200, 48, 48), 8);
+		}
+		render_.set_fore_color(DEF_COLOR::White);
+		for(int16_t i = 0; i < 8; ++i) {
+			char tmp[8];
+			utils::sformat("P%d", tmp, sizeof(tmp)) % i;
+			render_.draw_text(vtx::spos(16 + i * 56 + 16, 216), tmp);
+		}
+		render_.draw_text(vtx::spos(8, 4), "DRW2D display list");
+	}
+
+
+	void record_back_()
+	{
+		render_.free_list(back_);
+		render_.begin_list(back_);
+		draw_back_();
+		if(!render_.end_list(batch_)) {
+			utils::format("List overflow: %u\n") % back_.size();
+		}
+	}
+
+
+	void list_stat_()
+	{
+		const auto& st = render_.get_frame_stat();
+		utils::format("Mode: %s, List: %u [cmds], Batch: %s, Cached: %s\n")
+			% (list_ ? "list" : "direct") % back_.size() % (batch_ ? "on" : "off")
+			% (back_.is_cached() ? "yes" : "no");
+		utils::format("Frame: busy %u, total %u, wait %u [cycles]\n")
+			% st.busy % st.total % st.wait;
+		utils::format("Commands: %u, Lists: %u\n") % st.cmds % st.lists;
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		if(cmd_.cmp_word(0, "list")) {
+			list_ = true;
+		} else if(cmd_.cmp_word(0, "direct")) {
+			list_ = false;
+		} else if(cmd_.cmp_word(0, "batch") && cmdn >= 2) {
+			batch_ = cmd_.cmp_word(1, "on");
+			record_back_();
+		} else if(cmd_.cmp_word(0, "stat")) {
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    list                    draw the background from the display list\n");
+			utils::format("    direct                  draw the background every frame\n");
+			utils::format("    batch on|off            record the list again with/without batching\n");
+			utils::format("    stat                    list frame status (previous frame)\n");
+			utils::format("    help                    command list (this)\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+	}
+}
+
+
+extern "C" {
+
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+}
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // SCI 設定
+		auto intr_lvl = device::ICU::LEVEL::_2;
+		sci_.start(115200, intr_lvl);
+	}
+
+	utils::format("\r%s Start for DRW2D display list: %u, %u\n") % system_str_ % LCD_X % LCD_Y;
+
+	{  // GLCDC 初期化
+		LCD_DISP::DIR  = 1;
+		LCD_LIGHT::DIR = 1;
+		LCD_DISP::P  = 0;  // DISP Disable
+		LCD_LIGHT::P = 0;  // BackLight Disable (No PWM)
+		if(glcdc_mgr_.start(device::ICU::LEVEL::_2)) {
+			utils::format("Start GLCDC\n");
+			LCD_DISP::P  = 1;  // DISP Enable
+			LCD_LIGHT::P = 1;  // BackLight Enable (No PWM)
+			if(!glcdc_mgr_.control(GLCDC_MGR::CONTROL_CMD::START_DISPLAY)) {
+				utils::format("GLCDC ctrl fail...\n");
+			} else {
+				if(!glcdc_mgr_.enable_double_buffer()) {  // ダブルバッファを有効にする。
+					utils::format("Can't enable double-buffer\n");
+				}
+			}
+		} else {
+			utils::format("Fail GLCDC\n");
+		}
+	}
+
+	{  // DRW2D 初期化（d2 ディスプレイ・リストを保存する）
+		if(render_.start(device::ICU::LEVEL::_2, true)) {
+			utils::format("DRW2D Start\n");
+			render_.list_info();
+		} else {
+			utils::format("DRW2D Fail...\n");
+		}
+	}
+
+	record_back_();
+
+	cmd_.set_prompt("# ");
+
+	LED::OUTPUT();
+
+	uint8_t n = 0;
+	int16_t x = 0;
+	int16_t dx = 2;
+	while(1) {
+		render_.sync_frame();
+
+		command_();
+
+		if(list_) {
+			render_.call_list(back_);
+		} else {
+			draw_back_();
+		}
+
+		// 動く部分は、毎フレーム描画する
+		render_.set_fore_color(DEF_COLOR::Orange);
+		render_.fill_box(vtx::srect(x, 80, 64, 64));
+		x += dx;
+		if(x <= 0 || x >= (LCD_X - 64)) dx = -dx;
+
+		++n;
+		if(n >= 30) {
+			n = 0;
+		}
+		if(n < 10) {
+			LED::P = 0;
+		} else {
+			LED::P = 1;
+		}
+
+		render_.flip();
+	}
+}
@@ -3,9 +3,13 @@
 /*! @file
     @brief  A/D 変換、キャプチャー制御クラス @n
 			最大サンプルレート 2MHz (RX65N/RX72N) @n
+			A/D 変換は TPU0 のトリガーで始め、変換値は DMAC がリングに書く。 @n
+			トリガー検出は、周期割り込みでリングをブロック毎に走査して行う。 @n
+			キャプチャー・リングの最小値、最大値はミップ（wave_mip）で管理する。 @n
+			ミップは、書き込まれたサンプル数を数えて、その区間だけを更新する。 @n
 			※「GLFW_SIM」を有効にする事で、キャプチャー動作をシュミレートする。
     @author 平松邦仁 (hira@rvf-rc45.net)
-    @copyright  Copyright (C) 2018, 2022 Kunihito Hiramatsu @n
+    @copyright  Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
                 Released under the MIT license @n
                 https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -16,6 +20,7 @@
 #endif
 
 #include "render_base.hpp"
+#include "wave_mip.hpp"
 #include "common/vtx.hpp"
 #include "common/string_utils.hpp"
 
@@ -33,6 +38,8 @@ namespace dsos {
 #ifndef GLFW_SIM
 		typedef device::S12AD  ADC0;
 		typedef device::S12AD1 ADC1;
+		typedef device::DMAC0  DMA0;
+		typedef device::DMAC1  DMA1;
 #if defined(SIG_RX65N)
 		static constexpr auto ADC_CH0 = ADC0::ANALOG::AN000;  ///< P40 CN10(1)
 		static constexpr auto ADC_CH1 = ADC1::ANALOG::AN114;  ///< P90 CN10(5)
@@ -88,175 +95,298 @@ namespace dsos {
 		static constexpr uint32_t CAP_NUM = CAPN;	///< キャプチャー数
 		static constexpr int16_t CAP_OFS  = 2048;	///< 12bit A/D offset（中間）
 
-		// キャプチャー・タスク
+		static constexpr uint32_t SCAN_FREQ  = 1000;	///< ブロック走査の周波数 [Hz]
+		static constexpr uint32_t SCAN_BLOCK = 64;		///< 走査ブロックのサンプル数
+
+		// キャプチャー・タスク @n
+		// A/D 変換値は、DMAC が raw_ のリングに書く（CPU 割り込みを使わない）。 @n
+		// タスクは走査タイマーの割り込みで、リングに増えたサンプルをブロック毎に @n
+		// 取り出し、状態毎にまとめて処理する。トリガー待ちは、ブロックの最小値、 @n
+		// 最大値で基準を越えないと分かるブロックを、サンプルを調べずに飛ばす。
 		class cap_task {
-		public:
-			DATA				data_[CAPN];
 
-			volatile uint32_t	pos_;
-			volatile uint32_t	before_count_;
-			volatile uint32_t	after_count_;
-			volatile uint16_t	cycle_;	
-			volatile int16_t	trg_ref_;
-			volatile uint32_t	trg_pos_;
-			volatile TRG_MODE	trg_mode_main_;
-			volatile TRG_MODE	trg_mode_;
-			DIVIDER				divider_ch0_;
-			DIVIDER				divider_ch1_;
+			static_assert((CAPN & (CAPN - 1)) == 0, "CAPN must be power of 2");
 
-			DATA	min_;
-			DATA	max_;
+			enum class COND : uint8_t {
+				LT,		///< 基準より小さい
+				GE,		///< 基準以上
+				GT,		///< 基準より大きい
+				LE,		///< 基準以下
+			};
 
-#ifdef GLFW_SIM
-			DATA	adv_;
-#endif
+			static bool test_(COND c, int16_t v, int16_t ref) noexcept
+			{
+				switch(c) {
+				case COND::LT: return v <  ref;
+				case COND::GE: return v >= ref;
+				case COND::GT: return v >  ref;
+				default:       return v <= ref;
+				}
+			}
 
-			cap_task() noexcept :
-				data_ { { CAP_OFS, CAP_OFS } }, pos_(0),
-				before_count_(0), after_count_(0), cycle_(0),
-				trg_ref_(0), trg_pos_(0),
-				trg_mode_main_(TRG_MODE::STOP), trg_mode_(TRG_MODE::STOP),
-				divider_ch0_(DIVIDER::LOW), divider_ch1_(DIVIDER::LOW),
-				min_(4096 - 1), max_(0)
-			{ }
+			// 条件を満たす最初のサンプル位置（無ければ n）
+			uint32_t find_(const DATA* src, uint32_t n, const DATA& min, const DATA& max, bool whole,
+				bool ch1, COND c) const noexcept
+			{
+				int16_t ref = trg_ref_;
+				if(whole) {  // ブロックの最小値、最大値で、条件を満たさないと分かれば調べない
+					if(c == COND::LT || c == COND::LE) {
+						if(!test_(c, ch1 ? min.y : min.x, ref)) return n;
+					} else {
+						if(!test_(c, ch1 ? max.y : max.x, ref)) return n;
+					}
+				}
+				for(uint32_t i = 0; i < n; ++i) {
+					if(test_(c, ch1 ? src[i].y : src[i].x, ref)) return i;
+				}
+				return n;
+			}
 
-			void operator() ()
+			// 書き込み（リングの終端で折り返す）
+			void store_(const DATA* src, uint32_t n) noexcept
+			{
+				uint32_t pos = pos_;
+				for(uint32_t i = 0; i < n; ++i) {
+					data_[pos] = src[i];
+					pos = (pos + 1) & (CAPN - 1);
+				}
+				pos_ = pos;
+				count_ += n;
+			}
+
+			// トリガー待ち（条件を満たしたサンプルまで書いて、次の状態へ）
+			uint32_t arm_(const DATA* src, uint32_t n, const DATA& min, const DATA& max, bool whole,
+				bool ch1, COND c, TRG_MODE next) noexcept
+			{
+				auto i = find_(src, n, min, max, whole, ch1, c);
+				if(i < n) {
+					++i;
+					trg_mode_ = next;
+				}
+				store_(src, i);
+				return i;
+			}
+
+			// トリガー検出（条件を満たしたサンプルの位置をトリガー位置にする）
+			uint32_t fire_(const DATA* src, uint32_t n, const DATA& min, const DATA& max, bool whole,
+				bool ch1, COND c) noexcept
+			{
+				auto i = find_(src, n, min, max, whole, ch1, c);
+				store_(src, i);
+				if(i < n) {
+					trg_pos_ = pos_;
+					store_(src + i, 1);
+					trg_mode_ = TRG_MODE::_TRG_AFTER;
+					++i;
+				}
+				return i;
+			}
+
+			// 状態毎に、まとめて処理出来るサンプルを処理して、その数を返す
+			uint32_t step_(const DATA* src, uint32_t n, const DATA& min, const DATA& max, bool whole) noexcept
 			{
-#ifdef GLFW_SIM
-				DATA t = adv_;
-#else
-				DATA t(ADC0::ADDR(ADC_CH0) - CAP_OFS, ADC1::ADDR(ADC_CH1) - CAP_OFS);
-				// プリアンプで、入力信号を反転しているので、元に戻す。
-				t.x = -t.x;
-				t.y = -t.y;
-				ADC0::ADCSR = ADC0::ADCSR.ADCS.b(0b01) | ADC0::ADCSR.ADST.b();
-				ADC1::ADCSR = ADC1::ADCSR.ADCS.b(0b01) | ADC1::ADCSR.ADST.b();
-#endif
 				switch(trg_mode_) {
 				case TRG_MODE::STOP:
-					// オートゲイン制御
-					if(t.x >= ADC_MAX || t.x <= ADC_MIN) {  // Over voltage CH0
-//						select_divider_ch0_(DIVIDER::LOW);
-//						divider_ch0_ = DIVIDER::LOW;
-					}
-					if(t.y >= ADC_MAX || t.y <= ADC_MIN) {  // Over voltage CH1
-						select_divider_ch1_(DIVIDER::LOW);
-						divider_ch1_ = DIVIDER::LOW;
+					{  // オートゲイン制御
+						auto lo = min;
+						auto hi = max;
+						if(!whole) {
+							lo = hi = src[0];
+							for(uint32_t i = 1; i < n; ++i) {
+								if(src[i].y < lo.y) lo.y = src[i].y;
+								if(src[i].y > hi.y) hi.y = src[i].y;
+							}
+						}
+						if(hi.y >= ADC_MAX || lo.y <= ADC_MIN) {  // Over voltage CH1
+							select_divider_ch1_(DIVIDER::LOW);
+							divider_ch1_ = DIVIDER::LOW;
+						}
 					}
-					break;
-				case TRG_MODE::_BEFORE:  // 入力されている電圧を監視して、セレクタを切り替える。
-					break;
+					return n;
 				case TRG_MODE::SINGLE:
 				case TRG_MODE::AUTO:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(pos_ == (CAPN - 1)) {
-						if(trg_mode_ == TRG_MODE::SINGLE) {
-							trg_mode_ = TRG_MODE::STOP;
+					{  // 最後の位置は飛ばして０に戻る
+						uint32_t k = ((CAPN - 1) - pos_) & (CAPN - 1);
+						if(k == 0) k = CAPN;
+						if(k > n) k = n;
+						store_(src, k);
+						if(pos_ == (CAPN - 1)) {
+							if(trg_mode_ == TRG_MODE::SINGLE) {
+								trg_mode_ = TRG_MODE::STOP;
+							}
+							trg_pos_ = CAPN / 4;
+							pos_ = 0;
+							++cycle_;
 						}
-						trg_pos_ = CAPN / 4;
-						pos_ = 0;
-						++cycle_;
+						return k;
 					}
-					break;
 
 				case TRG_MODE::_TRG_BEFORE:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(before_count_ > 0) {
-						before_count_--;
-					} else {
+					if(before_count_ < n) {
+						n = before_count_ + 1;
+						before_count_ = 0;
 						trg_mode_ = trg_mode_main_;
+					} else {
+						before_count_ -= n;
 					}
-					break;
+					store_(src, n);
+					return n;
 
 				case TRG_MODE::CH0_POS:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(t.x < trg_ref_) {
-						trg_mode_ = TRG_MODE::_CH0_POSA;
-					}
-					break;
+					return arm_(src, n, min, max, whole, false, COND::LT, TRG_MODE::_CH0_POSA);
 				case TRG_MODE::_CH0_POSA:
-					data_[pos_] = t;
-					if(t.x >= trg_ref_) {
-						trg_pos_ = pos_;
-						trg_mode_ = TRG_MODE::_TRG_AFTER;
-					}
-					++pos_;
-					pos_ &= CAPN - 1;
-					break;
-
+					return fire_(src, n, min, max, whole, false, COND::GE);
 				case TRG_MODE::CH1_POS:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(t.y < trg_ref_) {
-						trg_mode_ = TRG_MODE::_CH1_POSA;
-					}
-					break;
+					return arm_(src, n, min, max, whole, true,  COND::LT, TRG_MODE::_CH1_POSA);
 				case TRG_MODE::_CH1_POSA:
-					data_[pos_] = t;
-					if(t.y >= trg_ref_) {
-						trg_pos_ = pos_;
-						trg_mode_ = TRG_MODE::_TRG_AFTER;
-					}
-					++pos_;
-					pos_ &= CAPN - 1;
-					break;
-
+					return fire_(src, n, min, max, whole, true,  COND::GE);
 				case TRG_MODE::CH0_NEG:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(t.x > trg_ref_) {
-						trg_mode_ = TRG_MODE::_CH0_NEGA;
-					}
-					break;
+					return arm_(src, n, min, max, whole, false, COND::GT, TRG_MODE::_CH0_NEGA);
 				case TRG_MODE::_CH0_NEGA:
-					data_[pos_] = t;
-					if(t.x <= trg_ref_) {
-						trg_pos_ = pos_;
-						trg_mode_ = TRG_MODE::_TRG_AFTER;
-					}
-					++pos_;
-					pos_ &= CAPN - 1;
-					break;
-
+					return fire_(src, n, min, max, whole, false, COND::LE);
 				case TRG_MODE::CH1_NEG:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(t.y > trg_ref_) {
-						trg_mode_ = TRG_MODE::_CH1_NEGA;
-					}
-					break;
+					return arm_(src, n, min, max, whole, true,  COND::GT, TRG_MODE::_CH1_NEGA);
 				case TRG_MODE::_CH1_NEGA:
-					data_[pos_] = t;
-					if(t.y <= trg_ref_) {
-						trg_pos_ = pos_;
-						trg_mode_ = TRG_MODE::_TRG_AFTER;
-					}
-					++pos_;
-					pos_ &= CAPN - 1;
-					break;
+					return fire_(src, n, min, max, whole, true,  COND::LE);
 
 				case TRG_MODE::_TRG_AFTER:
-					data_[pos_] = t;
-					++pos_;
-					pos_ &= CAPN - 1;
-					if(after_count_ > 0) {
-						after_count_--;
-					} else {
+					if(after_count_ < n) {
+						n = after_count_ + 1;
+						after_count_ = 0;
 						trg_mode_ = TRG_MODE::STOP;
 						++cycle_;
+					} else {
+						after_count_ -= n;
 					}
-					break;
+					store_(src, n);
+					return n;
+
+				case TRG_MODE::_BEFORE:  // 入力されている電圧を監視して、セレクタを切り替える。
 				default:
-					break;
+					return n;
+				}
+			}
+
+			// DMAC の書き込み位置（２つの変換器は同じトリガーで動くので、遅い方まで）
+			uint32_t get_wr_() const noexcept
+			{
+#ifdef GLFW_SIM
+				return wr_;
+#else
+				auto p0 = ((DMA0::DMDAR() - reinterpret_cast<uint32_t>(raw_[0])) >> 1) & (CAPN - 1);
+				auto p1 = ((DMA1::DMDAR() - reinterpret_cast<uint32_t>(raw_[1])) >> 1) & (CAPN - 1);
+				if(((p0 - rd_) & (CAPN - 1)) < ((p1 - rd_) & (CAPN - 1))) {
+					return p0;
+				} else {
+					return p1;
+				}
+#endif
+			}
+
+		public:
+			/// A/D 変換値のリング（DMAC が書く、拡張リピートエリアの為、大きさの境界に置く）
+			alignas(CAPN * sizeof(uint16_t)) uint16_t raw_[2][CAPN];
+			uint32_t			rd_;		///< リングの読み出し位置
+#ifdef GLFW_SIM
+			uint32_t			wr_;		///< リングの書き込み位置（DMAC の代わり）
+#endif
+
+			DATA				data_[CAPN];
+
+			volatile uint32_t	pos_;
+			volatile uint32_t	count_;		///< 書き込んだサンプル数（ミップの更新用）
+			volatile uint32_t	before_count_;
+			volatile uint32_t	after_count_;
+			volatile uint16_t	cycle_;	
+			volatile int16_t	trg_ref_;
+			volatile uint32_t	trg_pos_;
+			volatile TRG_MODE	trg_mode_main_;
+			volatile TRG_MODE	trg_mode_;
+			DIVIDER				divider_ch0_;
+			DIVIDER				divider_ch1_;
+
+			DATA	min_;
+			DATA	max_;
+
+			cap_task() noexcept :
+				raw_ { { 0 } }, rd_(0),
+#ifdef GLFW_SIM
+				wr_(0),
+#endif
+				data_ { { CAP_OFS, CAP_OFS } }, pos_(0), count_(0),
+				before_count_(0), after_count_(0), cycle_(0),
+				trg_ref_(0), trg_pos_(0),
+				trg_mode_main_(TRG_MODE::STOP), trg_mode_(TRG_MODE::STOP),
+				divider_ch0_(DIVIDER::LOW), divider_ch1_(DIVIDER::LOW),
+				min_(4096 - 1), max_(0)
+			{ }
+
+
+			//-------------------------------------------------------------//
+			/*!
+				@brief  ブロックの処理 @n
+						トリガーの状態機械を、サンプル毎では無く、状態が @n
+						変わる所まで、まとめて進める。
+				@param[in]	src		サンプル列
+				@param[in]	n		サンプル数
+				@param[in]	min		サンプル列の最小値
+				@param[in]	max		サンプル列の最大値
+			*/
+			//-------------------------------------------------------------//
+			void put_block(const DATA* src, uint32_t n, const DATA& min, const DATA& max) noexcept
+			{
+				bool whole = true;
+				while(n > 0) {
+					auto k = step_(src, n, min, max, whole);
+					src += k;
+					n -= k;
+					whole = false;  // 残りは、ブロックの最小値、最大値が使えない
+				}
+			}
+
+#ifdef GLFW_SIM
+			//-------------------------------------------------------------//
+			/*!
+				@brief  リングに書く（DMAC の代わり）
+				@param[in]	t	サンプル
+			*/
+			//-------------------------------------------------------------//
+			void put(const DATA& t) noexcept
+			{
+				raw_[0][wr_] = CAP_OFS - t.x;
+				raw_[1][wr_] = CAP_OFS - t.y;
+				wr_ = (wr_ + 1) & (CAPN - 1);
+			}
+#endif
+
+			//-------------------------------------------------------------//
+			/*!
+				@brief  ブロック走査（走査タイマーの割り込みから呼ぶ） @n
+						リングは SCAN_FREQ の周期より十分長い事（2MHz で約 8ms）
+			*/
+			//-------------------------------------------------------------//
+			void operator() ()
+			{
+				auto wr = get_wr_();
+				while(rd_ != wr) {
+					uint32_t n = (wr - rd_) & (CAPN - 1);
+					if(n > (CAPN - rd_)) n = CAPN - rd_;
+					if(n > SCAN_BLOCK) n = SCAN_BLOCK;
+
+					DATA tmp[SCAN_BLOCK];
+					DATA min(CAP_OFS, CAP_OFS);
+					DATA max(-CAP_OFS, -CAP_OFS);
+					for(uint32_t i = 0; i < n; ++i) {
+						// プリアンプで、入力信号を反転しているので、元に戻す。
+						DATA t(CAP_OFS - raw_[0][rd_ + i], CAP_OFS - raw_[1][rd_ + i]);
+						if(t.x < min.x) min.x = t.x;
+						if(t.x > max.x) max.x = t.x;
+						if(t.y < min.y) min.y = t.y;
+						if(t.y > max.y) max.y = t.y;
+						tmp[i] = t;
+					}
+					put_block(tmp, n, min, max);
+					rd_ = (rd_ + n) & (CAPN - 1);
 				}
 			}
 		};
@@ -264,8 +394,26 @@ namespace dsos {
 	private:
 
 #ifndef GLFW_SIM
-		typedef device::tpu_io<device::TPU0, cap_task> TPU0;
-		TPU0        tpu0_;
+		static constexpr uint8_t ADC_TRG_TPU0 = 0b010100;	///< TPU0.TGRA コンペアマッチ (TPTRG0AN)
+
+		typedef device::tpu_io<device::TPU0> TRG;
+		TRG			trg_;		///< A/D 変換の開始トリガー（割り込み無し）
+		typedef device::tpu_io<device::TPU1, cap_task> SCAN;
+		SCAN		scan_;		///< ブロック走査のタイマー
+		typedef device::dmac_mgr<DMA0> RING0;
+		typedef device::dmac_mgr<DMA1> RING1;
+		RING0		ring0_;		///< CH0 のリング転送
+		RING1		ring1_;		///< CH1 のリング転送
+
+		// リングの大きさ（2^n バイト）
+		static constexpr uint8_t ring_bits_() noexcept
+		{
+			uint8_t n = 0;
+			while((static_cast<uint32_t>(1) << n) < (CAPN * sizeof(uint16_t))) ++n;
+			return n;
+		}
+
+		static INTERRUPT_FUNC void adi_task_() { }  // DMAC を起動するだけ（CPU 割り込みは無し）
 #else
 		cap_task	cap_task_;
 #endif
@@ -274,6 +422,11 @@ namespace dsos {
 		uint32_t	capture_samplerate_;
 		TRG_MODE	trg_mode_;
 
+		typedef wave_mip<DATA, CAPN> MIP;
+		MIP			mip_;
+		uint32_t	mip_count_;
+		bool		mip_full_;
+
 
 		static int16_t limit_(int16_t val) noexcept
 		{
@@ -359,7 +512,7 @@ namespace dsos {
 		*/
 		//-----------------------------------------------------------------//
 		capture() noexcept : samplerate_(2'000'000), capture_samplerate_(2'000'000),
-			trg_mode_(TRG_MODE::STOP)
+			trg_mode_(TRG_MODE::STOP), mip_(), mip_count_(0), mip_full_(true)
 		{ }
 
 
@@ -372,15 +525,11 @@ namespace dsos {
 		void set_samplerate(uint32_t freq) noexcept
 		{
 #ifndef GLFW_SIM
-			auto intr_level = device::ICU::LEVEL::_5;
-			if(!tpu0_.start(freq, intr_level)) {
+			// コンペアマッチで A/D 変換を開始する（CPU 割り込みは使わない）
+			if(!trg_.start(freq, device::ICU::LEVEL::NONE)) {
 				utils::format("TPU0 start error...\n");
 			} else {
-				auto vec = tpu0_.get_intr_vec();
-				// スーパーバイザーモード中に、MVTC xxx,FINTV で割り込みベクタアドレスを設定する必要がある。
-//				device::ICU::IER.enable(vec, false);
-//				device::icu_mgr::enable_fast_interrupt(vec);
-//				device::ICU::IER.enable(vec);
+				device::TPU0::TIER.TTGE = 1;
 			}
 #endif
 			samplerate_ = freq;
@@ -479,17 +628,42 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 				ADC0::enable(ADC_CH0);
 				ADC0::ADANSA.set(ADC_CH0);
 				ADC0::ADSSTR.set(ADC_CH0, 11);
-				ADC0::ADSTRGR = ADC0::ADSTRGR.TRSA.b(0b100000) | ADC0::ADSTRGR.TRSB.b(0b111111);
+				ADC0::ADSTRGR = ADC0::ADSTRGR.TRSA.b(ADC_TRG_TPU0) | ADC0::ADSTRGR.TRSB.b(0b111111);
 				ADC0::ADSAM.SAM = 0;
-				ADC0::ADCSR.ADCS = 0b01;
+				// シングルスキャン、トリガー開始、変換終了で S12ADI（DMAC の起動）
+				ADC0::ADCSR = ADC0::ADCSR.ADCS.b(0b00) | ADC0::ADCSR.ADIE.b() | ADC0::ADCSR.TRGE.b();
 
 				device::power_mgr::turn(ADC1::PERIPHERAL);
 				ADC1::enable(ADC_CH1);
 				ADC1::ADANSA.set(ADC_CH1);
 				ADC1::ADSSTR.set(ADC_CH1, 11);
-				ADC1::ADSTRGR = ADC1::ADSTRGR.TRSA.b(0b100000) | ADC1::ADSTRGR.TRSB.b(0b111111);
+				ADC1::ADSTRGR = ADC1::ADSTRGR.TRSA.b(ADC_TRG_TPU0) | ADC1::ADSTRGR.TRSB.b(0b111111);
 				ADC1::ADSAM.SAM = 1;
-				ADC1::ADCSR.ADCS = 0b01;
+				ADC1::ADCSR = ADC1::ADCSR.ADCS.b(0b00) | ADC1::ADCSR.ADIE.b() | ADC1::ADCSR.TRGE.b();
+			}
+
+			{  // 変換終了（S12ADI）で DMAC を起動して、A/D データレジスタをリングに書く
+				auto& task = at_cap_task();
+				constexpr auto bits = ring_bits_();
+				auto lvl = device::ICU::LEVEL::_1;
+				auto vec0 = device::icu_mgr::set_interrupt(ADC0::ADI, adi_task_, lvl);
+				auto src0 = ADC0::BASE::ADDR0_::address + static_cast<uint32_t>(ADC_CH0) * 2;
+				auto dst0 = reinterpret_cast<uint32_t>(task.raw_[0]);
+				auto vec1 = device::icu_mgr::set_interrupt(ADC1::ADI, adi_task_, lvl);
+				auto src1 = ADC1::BASE::ADDR0_::address + static_cast<uint32_t>(ADC_CH1) * 2;
+				auto dst1 = reinterpret_cast<uint32_t>(task.raw_[1]);
+				if(!ring0_.start_ring(RING0::TRANS_TYPE::SN_DP_16, vec0, src0, dst0, bits)
+				|| !ring1_.start_ring(RING1::TRANS_TYPE::SN_DP_16, vec1, src1, dst1, bits)) {
+					utils::format("DMAC ring start error...\n");
+				}
+				task.rd_ = 0;
+			}
+
+			{  // ブロック走査
+				auto intr_level = device::ICU::LEVEL::_5;
+				if(!scan_.start(SCAN_FREQ, intr_level)) {
+					utils::format("TPU1 start error...\n");
+				}
 			}
 #endif
 			CH0_SA::OUTPUT();
@@ -520,7 +694,7 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 #ifdef GLFW_SIM
 		auto& at_cap_task() noexcept { return cap_task_; }
 #else
-		auto& at_cap_task() noexcept { return tpu0_.at_task(); }
+		auto& at_cap_task() noexcept { return scan_.at_task(); }
 #endif
 
 
@@ -533,13 +707,46 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 #ifdef GLFW_SIM
 		const auto& get_cap_task() const noexcept { return cap_task_; }
 #else
-		const auto& get_cap_task() const noexcept { return tpu0_.get_task(); }
+		const auto& get_cap_task() const noexcept { return scan_.get_task(); }
 #endif
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief  最低値、最大値を検出
+			@brief  ミップのサービス（描画前に呼ぶ） @n
+					前回から書き込まれたサンプルを含むブロックだけを更新する。 @n
+					リング１周以上書き込まれていた場合だけ全体を更新するので、 @n
+					手間は書き込まれたサンプル数に比例する。
+		*/
+		//-----------------------------------------------------------------//
+		void service() noexcept
+		{
+			const auto& task = get_cap_task();
+			// 割り込みと重ならない、位置と書き込み数の組を読む
+			uint32_t count;
+			uint32_t pos;
+			do {
+				count = task.count_;
+				pos = task.pos_;
+			} while(count != task.count_);
+
+			auto n = count - mip_count_;
+			mip_count_ = count;
+			if(mip_full_ || n >= (CAP_NUM - 1)) {
+				mip_full_ = false;
+				mip_.update(task.data_, 0, CAP_NUM);
+			} else if(n > 0) {
+				// 書き込みは pos の手前に連続する。AUTO の周回では最後の位置を
+				// 飛ばして０に戻るので、１つ広げる。
+				mip_.update(task.data_, pos - n - 1, n + 1);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  最低値、最大値を検出 @n
+					ミップを使うので、区間の長さに依らずほぼ一定時間で終わる。
 			@param[in]	org		開始位置
 			@param[in]	end		終端位置
 			@param[out]	min		最小値
@@ -550,16 +757,8 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 		{
 			if(end < org) end += CAP_NUM;
 
-			min.x = get(org).x;
-			max.x = get(org).x;
-			min.y = get(org).y;
-			max.y = get(org).y;
-			for(int32_t i = org + 1; i < end; ++i) {
-				min.x = std::min(min.x, get(i).x);
-				max.x = std::max(max.x, get(i).x);
-				min.y = std::min(min.y, get(i).y);
-				max.y = std::max(max.y, get(i).y);
-			}
+			const auto& task = get_cap_task();
+			mip_.get(task.data_, org + task.trg_pos_, end - org, min, max);
 		}
 
 
@@ -592,6 +791,7 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 		{
 			at_cap_task().trg_ref_ = limit_(ref);
 			at_cap_task().pos_ = 0;
+			mip_full_ = true;  // 書き込み位置が飛ぶので、次は全体を更新
 			at_cap_task().before_count_ = get_before_count();
 			at_cap_task().after_count_  = get_after_count();
 			at_cap_task().trg_mode_main_ = trg_mode;
@@ -666,6 +866,8 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 		//-----------------------------------------------------------------//
 		void auto_analize() noexcept
 		{
+			service();
+
 			DATA min;
 			DATA max;
 			uint32_t org = 0;
@@ -720,18 +922,22 @@ at_cap_task().divider_ch1_ = DIVIDER::HIGH;
 			auto vgain1 = voltage_to_value(1, ppv);
 			for(uint32_t i = 0; i < num; ++i) {
 				auto a = static_cast<float>(count % static_cast<int32_t>(unit)) / unit;
-				task.adv_.x = -pwave_(ch0, a, vgain0);
-				task.adv_.y = -pwave_(ch1, a, vgain1);
-				if(task.adv_.x < -CAP_OFS) task.adv_.x = -CAP_OFS;
-				else if(task.adv_.x > (CAP_OFS-1)) task.adv_.x = CAP_OFS-1;
-				if(task.adv_.y < -CAP_OFS) task.adv_.y = -CAP_OFS;
-				else if(task.adv_.y > (CAP_OFS-1)) task.adv_.y = CAP_OFS-1;
-				task();
+				DATA t(-pwave_(ch0, a, vgain0), -pwave_(ch1, a, vgain1));
+				if(t.x < -CAP_OFS) t.x = -CAP_OFS;
+				else if(t.x > (CAP_OFS-1)) t.x = CAP_OFS-1;
+				if(t.y < -CAP_OFS) t.y = -CAP_OFS;
+				else if(t.y > (CAP_OFS-1)) t.y = CAP_OFS-1;
+				task.put(t);
+				// リングが溢れる前に走査する（ハードウェアでは走査タイマー）
+				if((i % (CAP_NUM / 4)) == (CAP_NUM / 4 - 1)) {
+					task();
+				}
 				++count;
 				if(count >= CAP_NUM) {
 					count = 0;
 				}
 			}
+			task();
 		}
 
 
@@ -300,9 +300,7 @@ namespace dsos {
 				side_button_stall_(opt_btn_, !ena);
 				if(ena) {
 					auto opt = static_cast<OPT_MODE>(opt_menu_.get_select_pos());
-					if(opt != OPT_MODE::NONE) {
-
-					}
+					render_wave_.set_spectrum(opt);
 				}
 			};
 			opt_menu_.set_layer(WIDGET::LAYER::_0);
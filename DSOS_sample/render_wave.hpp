@@ -9,8 +9,10 @@
 */
 //=====================================================================//
 #include <cstdint>
+#include <algorithm>
 #include "common/enum_utils.hpp"
 #include "common/intmath.hpp"
+#include "common/fixed_fft.hpp"
 #include "graphics/color.hpp"
 
 #include "render_base.hpp"
@@ -117,6 +119,91 @@ namespace dsos {
 		vtx::spos	volt_min_[2];
 		vtx::spos	volt_max_[2];
 
+	public:
+		typedef utils::fixed_fft<1024> FFT;
+
+		static constexpr uint32_t SPEC_NUM = FFT::SIZE / 2;		///< スペクトラムのビン数
+		static constexpr int32_t SPEC_DB_TOP = 90 * 256;		///< 表示上端（dB Q8）
+		static constexpr int32_t SPEC_DB_RANGE = 120;			///< 表示範囲（dB、20dB/div）
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  スペクトラム平均化型
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class SPEC_AVG : uint8_t {
+			NONE,	///< 平均化無し
+			EXP,	///< 指数移動平均
+			PEAK,	///< ピーク・ホールド（緩やかに減衰）
+		};
+
+	private:
+		FFT			fft_;
+		OPT_MODE	spec_mode_;
+		SPEC_AVG	spec_avg_;
+		int16_t		spec_db_[SPEC_NUM];
+
+
+		void render_spectrum_() noexcept
+		{
+			const bool ch0 = spec_mode_ == OPT_MODE::CH0_FFT;
+			// トリガー位置を中心に FFT 点数分を取り込む（12 ビット → Q15）
+			int32_t org = -static_cast<int32_t>(FFT::SIZE / 2);
+			for(uint32_t i = 0; i < FFT::SIZE; ++i) {
+				const auto& d = capture_.get(org + static_cast<int32_t>(i));
+				int32_t v = ch0 ? d.x : d.y;
+				fft_.set(i, v << 4);
+			}
+			fft_.transform();
+
+			for(uint32_t i = 0; i < SPEC_NUM; ++i) {
+				int32_t db = FFT::power_to_db(fft_.get_power(i));
+				switch(spec_avg_) {
+				case SPEC_AVG::EXP:
+					spec_db_[i] += (db - spec_db_[i]) >> 2;
+					break;
+				case SPEC_AVG::PEAK:
+					if(db > spec_db_[i]) spec_db_[i] = db;
+					else spec_db_[i] -= 64;  // 0.25dB / frame
+					break;
+				default:
+					spec_db_[i] = db;
+					break;
+				}
+			}
+
+			// 横軸：０～fs/2 を TIME_SIZE に、縦軸：SPEC_DB_TOP から SPEC_DB_RANGE を VOLT_SIZE に
+			// 列に複数のビンが入る場合は最大値を使う。
+			render_.set_fore_color(ch0 ? CH0_COLOR : CH1_COLOR);
+			static constexpr int32_t YS = (VOLT_SIZE << 8) / SPEC_DB_RANGE;
+			int16_t y0 = 0;
+			uint32_t bin = 0;
+			for(int16_t x = 0; x < TIME_SIZE; ++x) {
+				uint32_t end = (static_cast<uint32_t>(x + 1) * SPEC_NUM) / TIME_SIZE;
+				if(end <= bin) end = bin + 1;
+				int32_t db = spec_db_[bin];
+				while(bin < end) {
+					db = std::max(db, static_cast<int32_t>(spec_db_[bin]));
+					++bin;
+				}
+				int32_t y = ((SPEC_DB_TOP - db) * YS) >> 16;
+				if(y < 0) y = 0;
+				else if(y >= VOLT_SIZE) y = VOLT_SIZE - 1;
+				int16_t y1 = 16 + y;
+				if(x == 0) y0 = y1;
+				render_.line(vtx::spos(x, y0), vtx::spos(x, y1));
+				y0 = y1;
+			}
+
+			render_.set_fore_color(DEF_COLOR::White);
+			char tmp[48];
+			static constexpr const char* wins[] = { "Rect", "Hann", "Blackman" };
+			auto fn = capture_.get_capture_samplerate() / 2000;  // KHz
+			utils::sformat("CH%d FFT %s, 0-%dKHz, 20dB/div", tmp, sizeof(tmp))
+				% (ch0 ? 0 : 1) % wins[static_cast<uint8_t>(fft_.get_window())] % fn;
+			render_.draw_text(vtx::spos(4, 16 + 2), tmp);
+		}
+
 
 		void scan_area_(const vtx::spos& pos) noexcept
 		{
@@ -327,7 +414,8 @@ namespace dsos {
 			cap_cycle_(0), cur_smp_mode_(SMP_MODE::_1us), wave_info0_(), wave_info1_(),
 			ch_info_count_(0),
 			area_(AREA::NONE),
-			cap_win_org_(0), cap_win_end_(0), volt_min_(), volt_max_()
+			cap_win_org_(0), cap_win_end_(0), volt_min_(), volt_max_(),
+			fft_(FFT::WINDOW::HANN), spec_mode_(OPT_MODE::NONE), spec_avg_(SPEC_AVG::EXP), spec_db_{ }
 		{ }
 
 
@@ -412,6 +500,53 @@ namespace dsos {
 		void set_measere(MEASERE mes) noexcept { measere_ = mes; }
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  スペクトラム表示の設定 @n
+					CH0_FFT, CH1_FFT で周波数軸表示、NONE で時間軸表示に戻る。
+			@param[in]	opt	オプション型
+		*/
+		//-----------------------------------------------------------------//
+		void set_spectrum(OPT_MODE opt) noexcept
+		{
+			if(opt == OPT_MODE::CH0_FFT || opt == OPT_MODE::CH1_FFT) {
+				if(spec_mode_ != opt) {
+					for(uint32_t i = 0; i < SPEC_NUM; ++i) spec_db_[i] = 0;
+				}
+				spec_mode_ = opt;
+			} else if(opt == OPT_MODE::NONE) {
+				spec_mode_ = OPT_MODE::NONE;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  スペクトラム表示モードの取得
+			@return オプション型（NONE なら時間軸表示）
+		*/
+		//-----------------------------------------------------------------//
+		auto get_spectrum() const noexcept { return spec_mode_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  スペクトラムの窓関数を設定
+			@param[in]	win		窓関数型
+		*/
+		//-----------------------------------------------------------------//
+		void set_spectrum_window(FFT::WINDOW win) noexcept { fft_.set_window(win); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  スペクトラムの平均化型を設定
+			@param[in]	avg		平均化型
+		*/
+		//-----------------------------------------------------------------//
+		void set_spectrum_average(SPEC_AVG avg) noexcept { spec_avg_ = avg; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  グリッドの描画
@@ -764,11 +899,19 @@ namespace dsos {
 		//-----------------------------------------------------------------//
 		void update() noexcept
 		{
+			capture_.service();
+
 			render_.set_fore_color(DEF_COLOR::Black);
 			render_.fill_box(vtx::srect(0, 16, 440, 240));
 
 			draw_grid(0, 16, 440, 240, GRID);
 
+			if(spec_mode_ != OPT_MODE::NONE) {  // 周波数軸（スペクトラム）表示
+				render_spectrum_();
+				draw_sampling_info();
+				return;
+			}
+
 			auto sr = static_cast<float>(get_smp_rate(smp_mode_) * 1e-6 / static_cast<float>(GRID));
 			auto step = sr / (1.0f / static_cast<float>(capture_.get_capture_samplerate()));
 			auto istep = static_cast<int32_t>(step * 16384.0f);
@@ -793,6 +936,10 @@ namespace dsos {
 			int32_t p0;
 			int16_t ch0_y;
 			int16_t ch1_y;
+			// １ピクセルに複数サンプルが入る場合、区間の最小値～最大値を縦線で描く。
+			const bool decimate = istep > 16384;
+			typename CAPTURE::DATA dmin;
+			typename CAPTURE::DATA dmax;
 			for(int16_t x = 0; x < (TIME_SIZE - 1); ++x) {  // ピクセル単位
 				if(x == 0) {
 					p0 = tofs + (pos >> 14);
@@ -808,6 +955,9 @@ namespace dsos {
 				if(p0 <= -static_cast<int32_t>(capture_.get_before_count()) || p0 >= static_cast<int32_t>(capture_.get_after_count())) {
 					clipout = true;
 				}
+				if(decimate && !clipout) {
+					capture_.get_min_max(p0, p1, dmin, dmax);
+				}
 				p0 = p1;
 				if(ch0_mode_ != CH_MODE::OFF) {
 					if(x == 0) {
@@ -817,7 +967,15 @@ namespace dsos {
 					if(!clipout) {
 						render_.set_fore_color(CH0_COLOR);
 						int16_t ofs = ch0_vpos_;
-						render_.line(vtx::spos(x, ofs - ch0_y), vtx::spos(x + 1, ofs - y1));
+						if(decimate) {
+							int16_t ymin = (static_cast<int32_t>(dmin.x) * ich0) >> 14;
+							int16_t ymax = (static_cast<int32_t>(dmax.x) * ich0) >> 14;
+							ymin = std::min(ymin, ch0_y);
+							ymax = std::max(ymax, ch0_y);
+							render_.line(vtx::spos(x + 1, ofs - ymax), vtx::spos(x + 1, ofs - ymin));
+						} else {
+							render_.line(vtx::spos(x, ofs - ch0_y), vtx::spos(x + 1, ofs - y1));
+						}
 					}
 					ch0_y = y1;
 				}
@@ -829,7 +987,15 @@ namespace dsos {
 					if(!clipout) {
 						render_.set_fore_color(CH1_COLOR);
 						int16_t ofs = ch1_vpos_;
-						render_.line(vtx::spos(x, ofs - ch1_y), vtx::spos(x + 1, ofs - y1));
+						if(decimate) {
+							int16_t ymin = (static_cast<int32_t>(dmin.y) * ich1) >> 14;
+							int16_t ymax = (static_cast<int32_t>(dmax.y) * ich1) >> 14;
+							ymin = std::min(ymin, ch1_y);
+							ymax = std::max(ymax, ch1_y);
+							render_.line(vtx::spos(x + 1, ofs - ymax), vtx::spos(x + 1, ofs - ymin));
+						} else {
+							render_.line(vtx::spos(x, ofs - ch1_y), vtx::spos(x + 1, ofs - y1));
+						}
 					}
 					ch1_y = y1;
 				}
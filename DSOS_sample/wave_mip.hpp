@@ -0,0 +1,182 @@
+#pragma once
+//=====================================================================//
+/*! @file
+    @brief  波形の最小値、最大値ピラミッド（ミップ）クラス @n
+			キャプチャー・リングのブロック毎の最小値、最大値を多段に保持して、 @n
+			任意区間の最小値、最大値を「O(log N)」で求める。 @n
+			描画時の列毎の走査を無くし、どの時間軸スケールでも画面幅に比例した @n
+			処理量で波形を描画する為に使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+    @copyright  Copyright (C) 2026 Kunihito Hiramatsu @n
+                Released under the MIT license @n
+                https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <algorithm>
+
+namespace dsos {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  波形ミップ・クラス
+		@param[in]	DATA	サンプルの型（x: CH0, y: CH1）
+		@param[in]	CAPN	リングのサンプル数（２のべき乗）
+		@param[in]	BLKS	最下層ブロックのサンプル数（２のべき乗）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class DATA, uint32_t CAPN, uint32_t BLKS = 16>
+	class wave_mip {
+
+		static_assert((CAPN & (CAPN - 1)) == 0, "CAPN must be power of 2");
+		static_assert((BLKS & (BLKS - 1)) == 0, "BLKS must be power of 2");
+		static_assert(CAPN >= BLKS * 2, "CAPN too small");
+
+		static constexpr uint32_t level_num_() noexcept
+		{
+			uint32_t n = 0;
+			for(uint32_t sz = BLKS; sz <= CAPN; sz <<= 1) ++n;
+			return n;
+		}
+
+	public:
+		static constexpr uint32_t LEVEL_NUM = level_num_();		///< 段数
+		static constexpr uint32_t NODE_NUM = (CAPN / BLKS) * 2 - 1;	///< 全ノード数
+
+		struct node_t {
+			DATA	min;
+			DATA	max;
+		};
+
+	private:
+		node_t		node_[NODE_NUM];
+
+		// 段 lv の先頭インデックス（段 0 が最下層）
+		static constexpr uint32_t top_(uint32_t lv) noexcept
+		{
+			uint32_t ofs = 0;
+			for(uint32_t i = 0; i < lv; ++i) {
+				ofs += (CAPN / BLKS) >> i;
+			}
+			return ofs;
+		}
+
+		static void merge_(node_t& t, const DATA& min, const DATA& max) noexcept
+		{
+			t.min.x = std::min(t.min.x, min.x);
+			t.min.y = std::min(t.min.y, min.y);
+			t.max.x = std::max(t.max.x, max.x);
+			t.max.y = std::max(t.max.y, max.y);
+		}
+
+		static void scan_(const DATA* src, uint32_t org, uint32_t end, node_t& t) noexcept
+		{
+			for(uint32_t i = org; i < end; ++i) {
+				merge_(t, src[i], src[i]);
+			}
+		}
+
+		// リングを跨がない区間 [org, end) の問い合わせ
+		void query_(const DATA* src, uint32_t org, uint32_t end, node_t& t) const noexcept
+		{
+			auto blk = (org + BLKS - 1) & ~(BLKS - 1);
+			if(blk >= end) {
+				scan_(src, org, end, t);
+				return;
+			}
+			scan_(src, org, blk, t);
+			auto blk_end = end & ~(BLKS - 1);
+			// 整列した区間を、取れるだけ大きな段のノードで覆う。
+			while(blk < blk_end) {
+				uint32_t lv = 0;
+				while((lv + 1) < LEVEL_NUM) {
+					auto sz = BLKS << (lv + 1);
+					if((blk & (sz - 1)) != 0 || (blk + sz) > blk_end) break;
+					++lv;
+				}
+				const auto& n = node_[top_(lv) + (blk / (BLKS << lv))];
+				merge_(t, n.min, n.max);
+				blk += BLKS << lv;
+			}
+			scan_(src, blk_end, end, t);
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクタ
+		*/
+		//-----------------------------------------------------------------//
+		wave_mip() noexcept : node_{ } { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  区間の更新（変更されたサンプルを含むブロックと、その親を再計算）
+			@param[in]	src		リングの先頭
+			@param[in]	org		変更開始位置（リング上）
+			@param[in]	len		変更サンプル数
+		*/
+		//-----------------------------------------------------------------//
+		void update(const DATA* src, uint32_t org, uint32_t len) noexcept
+		{
+			if(len == 0) return;
+			if(len > CAPN) len = CAPN;
+			org &= CAPN - 1;
+			if((org + len) > CAPN) {  // リングを跨ぐ場合は分割
+				auto n = CAPN - org;
+				update(src, org, n);
+				update(src, 0, len - n);
+				return;
+			}
+
+			auto bo = org / BLKS;
+			auto be = (org + len + BLKS - 1) / BLKS;
+			for(auto b = bo; b < be; ++b) {
+				auto& n = node_[b];
+				n.min = src[b * BLKS];
+				n.max = src[b * BLKS];
+				scan_(src, b * BLKS + 1, (b + 1) * BLKS, n);
+			}
+			for(uint32_t lv = 1; lv < LEVEL_NUM; ++lv) {
+				bo >>= 1;
+				be = (be + 1) >> 1;
+				const auto* low = &node_[top_(lv - 1)];
+				auto* cur = &node_[top_(lv)];
+				for(auto b = bo; b < be; ++b) {
+					cur[b] = low[b * 2];
+					merge_(cur[b], low[b * 2 + 1].min, low[b * 2 + 1].max);
+				}
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  区間の最小値、最大値を取得
+			@param[in]	src		リングの先頭
+			@param[in]	org		開始位置（リング上）
+			@param[in]	len		サンプル数（１以上）
+			@param[out]	min		最小値
+			@param[out]	max		最大値
+		*/
+		//-----------------------------------------------------------------//
+		void get(const DATA* src, uint32_t org, uint32_t len, DATA& min, DATA& max) const noexcept
+		{
+			if(len == 0) len = 1;
+			if(len > CAPN) len = CAPN;
+			org &= CAPN - 1;
+			node_t t;
+			t.min = src[org];
+			t.max = src[org];
+			if((org + len) > CAPN) {
+				query_(src, org, CAPN, t);
+				query_(src, 0, org + len - CAPN, t);
+			} else {
+				query_(src, org, org + len, t);
+			}
+			min = t.min;
+			max = t.max;
+		}
+	};
+}
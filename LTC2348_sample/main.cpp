@@ -0,0 +1,271 @@
+//=====================================================================//
+/*! @file
+    @brief  LTC2348-16 バースト取得サンプル @n
+			CNV を MTU の PWM で出し、BUSY 割り込みで取ったフレームを、 @n
+			メインループで read() してから、SD カードのファイルに書く。 @n
+			LTC2348ILX-16 (38:BUSY) ---> P16 / IRQ6 @n
+			LTC2348ILX-16 (24:CNV)  ---> MTIOC0B（RX64M/port_map_mtu.hpp） @n
+			LTC2348ILX-16 (29:SCKI) ---> PA5 / RSPCKA-B @n
+			LTC2348ILX-16 (37:SDI)  ---> PA6 / MOSIA-B @n
+			LTC2348ILX-16 (25:SDO0) ---> PA7 / MISOA-B @n
+			LTC2348ILX-16 (CS)      ---> P40 @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/cmt_mgr.hpp"
+
+#include "common/format.hpp"
+#include "common/input.hpp"
+#include "common/string_utils.hpp"
+
+#include "common/spi_io2.hpp"
+#include "common/rspi_io.hpp"
+#include "common/mtu_io.hpp"
+#include "common/command.hpp"
+#include "common/file_io.hpp"
+
+#include "chip/LTC2348_16b.hpp"
+
+namespace {
+
+	typedef utils::fixed_fifo<char, 512> RXB;  // RX (RECV) バッファの定義
+	typedef utils::fixed_fifo<char, 256> TXB;  // TX (SEND) バッファの定義
+	typedef device::sci_io<board_profile::SCI_CH, RXB, TXB, board_profile::SCI_ORDER> SCI;
+	SCI		sci_;
+
+	typedef device::cmt_mgr<board_profile::CMT_CH> CMT;
+	CMT		cmt_;
+
+	// SDCARD 制御リソース（ソフト SPI）
+	typedef device::PORT<device::PORTC, device::bitpos::B3> MISO;
+	typedef device::PORT<device::PORT7, device::bitpos::B6> MOSI;
+	typedef device::PORT<device::PORT7, device::bitpos::B7> SPCK;
+	typedef device::spi_io2<MISO, MOSI, SPCK> SDC_SPI;
+
+	typedef device::PORT<device::PORTC, device::bitpos::B2> SDC_SELECT;	///< カード選択信号
+	typedef device::PORT<device::PORT8, device::bitpos::B2, 0> SDC_POWER;	///< カード電源制御
+	typedef device::PORT<device::PORT8, device::bitpos::B1> SDC_DETECT;	///< カード検出
+	typedef device::NULL_PORT SDC_WPRT;  ///< カード書き込み禁止
+
+	SDC_SPI	sdc_spi_;
+	typedef fatfs::mmc_io<SDC_SPI, SDC_SELECT, SDC_POWER, SDC_DETECT, SDC_WPRT> SDC;
+	SDC		sdc_(sdc_spi_, 20'000'000);
+
+	// LTC2348-16 制御リソース
+	typedef device::PORT<device::PORT4, device::bitpos::B0> LTC_CSN;
+	typedef device::rspi_io<device::RSPI0, device::port_map::ORDER::SECOND> LTC_SPI;
+	LTC_SPI	ltc_spi_;
+	typedef device::mtu_io<board_profile::MTU_CH> LTC_MTU;
+	LTC_MTU	ltc_mtu_;
+
+	typedef chip::LTC2348_16b<LTC_CSN, LTC_SPI, LTC_MTU, device::ICU::VECTOR::IRQ6> LTC;
+	LTC		ltc_(ltc_spi_, ltc_mtu_);
+
+	static constexpr uint32_t LTC_SPEED = 30'000'000;	///< SCKI のクロック
+	static constexpr uint32_t READ_NUM = 64;			///< 一度に取り出すフレーム数
+
+	LTC::frame_t	frame_[READ_NUM];
+
+	utils::file_io	fio_;
+	uint32_t		write_len_;
+
+	typedef utils::command<256> CMD;
+	CMD		cmd_;
+
+
+	void list_stat_()
+	{
+		utils::format("Rate: %u [Hz] (achieved: %u [Hz])\n")
+			% ltc_.get_rate() % static_cast<uint32_t>(ltc_.get_achieved_rate());
+		utils::format("Frames: %u, Missed: %u, Dropped: %u, Error: %u\n")
+			% ltc_.get_count() % ltc_.get_missed() % ltc_.get_dropped() % ltc_.get_error();
+		utils::format("Write: %u [bytes]\n") % write_len_;
+	}
+
+
+	void stop_()
+	{
+		ltc_.stop();
+		// リングに残ったフレームも書く
+		uint32_t n;
+		while((n = ltc_.read(frame_, READ_NUM)) > 0) {
+			write_len_ += fio_.write(frame_, n * sizeof(LTC::frame_t));
+		}
+		fio_.close();
+		list_stat_();
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		if(cmd_.cmp_word(0, "start") && cmdn >= 2) {
+			if(fio_.is_open()) {
+				utils::format("Already started...\n");
+				return;
+			}
+			uint32_t rate = 10'000;
+			if(cmdn >= 3) {
+				char tmp[32];
+				cmd_.get_word(2, tmp, sizeof(tmp));
+				if(!(utils::input("%d", tmp) % rate).status()) {
+					utils::format("Parse error: '%s'\n") % tmp;
+					return;
+				}
+			}
+			char fname[128];
+			cmd_.get_word(1, fname, sizeof(fname));
+			if(!fio_.open(fname, "wb")) {
+				utils::format("Can't create file: '%s'\n") % fname;
+				return;
+			}
+			write_len_ = 0;
+			if(!ltc_.start(LTC_SPEED, rate, LTC::span_type::M10_24P10_24, device::ICU::LEVEL::_5)) {
+				utils::format("Can't start LTC2348 (rate: %u [Hz])\n") % rate;
+				fio_.close();
+				return;
+			}
+			utils::format("Start: '%s', %u [Hz]\n") % fname % ltc_.get_rate();
+		} else if(cmd_.cmp_word(0, "stop")) {
+			if(fio_.is_open()) {
+				stop_();
+			}
+		} else if(cmd_.cmp_word(0, "stat")) {
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    start filename [rate]   start the burst to file (rate: Hz, default 10000)\n");
+			utils::format("    stop                    stop the burst, close file\n");
+			utils::format("    stat                    list status\n");
+			utils::format("    help                    command list (this)\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+	}
+}
+
+
+extern "C" {
+
+	// syscalls.c から呼ばれる、標準出力（stdout, stderr）
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+	// syscalls.c から呼ばれる、標準入力（stdin）
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+
+	// FatFs から呼ばれるファイル操作関数
+	DSTATUS disk_initialize(BYTE drv) {
+		return sdc_.disk_initialize(drv);
+	}
+
+	DSTATUS disk_status(BYTE drv) {
+		return sdc_.disk_status(drv);
+	}
+
+	DRESULT disk_read(BYTE drv, BYTE* buff, DWORD sector, UINT count) {
+		return sdc_.disk_read(drv, buff, sector, count);
+	}
+
+	DRESULT disk_write(BYTE drv, const BYTE* buff, DWORD sector, UINT count) {
+		return sdc_.disk_write(drv, buff, sector, count);
+	}
+
+	DRESULT disk_ioctl(BYTE drv, BYTE ctrl, void* buff) {
+		return sdc_.disk_ioctl(drv, ctrl, buff);
+	}
+
+	DWORD get_fattime(void) {
+		auto t = utils::str::make_time(nullptr, nullptr);
+		return utils::str::get_fattime(t);
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // タイマー設定（100Hz）
+		auto intr = device::ICU::LEVEL::_4;
+		cmt_.start(100, intr);
+	}
+
+	{  // SCI の開始
+		auto intr = device::ICU::LEVEL::_2;
+		uint32_t baud = 115200;  // ボーレート
+		sci_.start(baud, intr);
+	}
+
+	auto clk = device::clock_profile::ICLK / 1'000'000;
+	utils::format("Start LTC2348 burst sample for '%s' %d[MHz]\n") % system_str_ % clk;
+
+	LED::DIR = 1;
+	LED::P = 0;
+
+	cmd_.set_prompt("# ");
+
+	uint8_t cnt = 0;
+	while(1) {
+		cmt_.sync();
+
+		sdc_.service();
+
+		command_();
+
+		// 溜まったフレームを、まとめてファイルに書く
+		if(fio_.is_open()) {
+			uint32_t n;
+			while((n = ltc_.read(frame_, READ_NUM)) > 0) {
+				auto len = n * sizeof(LTC::frame_t);
+				auto wl = fio_.write(frame_, len);
+				write_len_ += wl;
+				if(wl != len) {
+					utils::format("Write error...\n");
+					stop_();
+					break;
+				}
+			}
+		}
+
+		++cnt;
+		if(cnt >= 50) {
+			cnt = 0;
+		}
+		LED::P = (cnt < 25) ? 0 : 1;
+	}
+}
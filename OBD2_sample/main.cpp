@@ -14,7 +14,7 @@
 					P40 ピンにLEDを接続する @n
 					SCI2 を使用する
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2020 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2020, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -688,7 +688,7 @@ int main(int argc, char** argv)
 			CAN::list(frm, "  ");
 		}
 #endif
-		analize_.service();
+		analize_.service(cmt_.get_counter(), cmt_.get_rate());
 
 #ifdef MULTI
 		while(can1_.get_recv_num() > 0) {
@@ -287,6 +287,9 @@ int main(int argc, char** argv)
 
 	psg_mng_.set_score(0, score::_0);
 	psg_mng_.set_score(1, score::_1);
+	if(sizeof(SOUND_OUT::value_type) > 1) {  // D/A 出力では帯域制限した波形を使う
+		psg_mng_.enable_blep();
+	}
 
 #ifdef USE_SW2
 	SW2::INPUT();
@@ -319,16 +322,11 @@ int main(int argc, char** argv)
 			}
 
 			pos = newpos;
-			int8_t tmp[n];
+			SOUND_OUT::value_type tmp[n];
 			psg_mng_.render(n, tmp);
 			for(uint32_t i = 0; i < n; ++i) {
-				auto w = tmp[i];
 				typename SOUND_OUT::WAVE t;
-				if(sizeof(SOUND_OUT::value_type) > 1) {
-					t.set((static_cast<int16_t>(w) << 8) | ((w & 0x7f) << 1));
-				} else {
-					t.set(w);
-				}
+				t.set(tmp[i]);
 				sound_out_.at_fifo().put(t);
 			}
 
@@ -7,12 +7,13 @@
 			・RX261 @n
 			・RX26T
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2023, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2023, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=========================================================================//
 #include "common/device.hpp"
+#include "RX600/canfd_frame.hpp"
 
 namespace device {
 
@@ -98,7 +99,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct chsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -130,7 +130,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct chesr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -239,7 +238,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct fdsts_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -267,7 +265,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct fdcrc_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bits_ro_t<in_, bitpos::B0, 21>  CRC21;
 
@@ -341,7 +338,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct gsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>  RSTST;
 			bit_ro_t <in_, bitpos::B1>  HLTST;
@@ -360,7 +356,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct gesr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -386,7 +381,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct tisr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>  TSIF0;
 			bit_ro_t <in_, bitpos::B1>  TAIF0;
@@ -656,7 +650,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct rfsrn_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -737,7 +730,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct cfsr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -783,7 +775,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct fesr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      RFEMP0;
 			bit_ro_t <in_, bitpos::B1>      RFEMP1;
@@ -802,7 +793,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct ffsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      RFFUL0;
 			bit_ro_t <in_, bitpos::B1>      RFFUL1;
@@ -821,7 +811,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct fmlsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      RFML0;
 			bit_ro_t <in_, bitpos::B1>      RFML1;
@@ -840,7 +829,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct rfisr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      RFIF0;
 			bit_ro_t <in_, bitpos::B1>      RFIF1;
@@ -879,7 +867,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct dtsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      RFDTS0;
 			bit_ro_t <in_, bitpos::B1>      RFDTS1;
@@ -955,7 +942,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct tmtrsr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      TXRQS0;
 			bit_ro_t <in_, bitpos::B1>      TXRQS1;
@@ -974,7 +960,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct tmarsr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      TARQS0;
 			bit_ro_t <in_, bitpos::B1>      TARQS1;
@@ -993,7 +978,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct tmtcsr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      TXCF0;
 			bit_ro_t <in_, bitpos::B1>      TXCF1;
@@ -1012,7 +996,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct tmtasr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bit_ro_t <in_, bitpos::B0>      TAF0;
 			bit_ro_t <in_, bitpos::B1>      TAF1;
@@ -1077,7 +1060,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct tqsr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -1144,7 +1126,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct thsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
@@ -1170,7 +1151,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct thacr0_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bits_ro_t<in_, bitpos::B0, 3>   BT;
 			bits_ro_t<in_, bitpos::B3, 2>   BN;
@@ -1189,7 +1169,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct thacr1_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 
 			bits_ro_t<in_, bitpos::B0,  16> PTR;
 			bits_ro_t<in_, bitpos::B16, 2>  IFL;
@@ -1442,19 +1421,19 @@ namespace device {
 		struct msgbuf_rod_t {
 
 			typedef rw32_index_t<base + ofs + 0> hf0_;
-			rw32_t<hf0_::address> HF0;
+			hf0_ HF0;
 			bits_rw_t<hf0_, bitpos::B0,  29>  ID;
 			bit_rw_t <hf0_, bitpos::B29>      THENT;
 			bit_rw_t <hf0_, bitpos::B30>      RTR;
 			bit_rw_t <hf0_, bitpos::B31>      IDE;
 
 			typedef rw32_index_t<base + ofs + 4> hf1_;
-			rw32_t<hf1_::address> HF1;
+			hf1_ HF1;
 			bits_rw_t<hf1_, bitpos::B0,  16>  TS;
 			bits_rw_t<hf1_, bitpos::B28,  4>  DLC;
 
 			typedef rw32_index_t<base + ofs + 8> hf2_;
-			rw32_t<hf2_::address> HF2;
+			hf2_ HF2;
 			bit_rw_t <hf2_, bitpos::B0>       ESI;
 			bit_rw_t <hf2_, bitpos::B1>       BRS;
 			bit_rw_t <hf2_, bitpos::B2>       FDF;
@@ -1468,12 +1447,12 @@ namespace device {
 				// 32ビット単位、読出し専用
 				uint32_t operator() (uint32_t n) noexcept {
 					if(n >= 16) n = 15;
-					return rd32_(df0_::address + n * 4);
+					return rd32_(df0_::address + df0_::index + n * 4);
 				}
 
 				volatile const uint32_t& operator [] (uint32_t n) const noexcept {
 					if(n >= 16) n = 15;
-					return *reinterpret_cast<volatile uint32_t*>(df0_::address + n * 4);
+					return *reinterpret_cast<volatile uint32_t*>(df0_::address + df0_::index + n * 4);
 				}
 			};
 			df_t	DF;
@@ -1482,13 +1461,13 @@ namespace device {
 				// バイト単位、読出し専用
 				uint8_t operator() (uint32_t n) noexcept {
 					if(n >= 64) n = 63;
-					return rd8_(df0_::address + n);
+					return rd8_(df0_::address + df0_::index + n);
 				}
 
 
 				volatile const uint8_t& operator [] (uint32_t n) const noexcept {
 					if(n >= 64) n = 63;
-					return *reinterpret_cast<volatile uint8_t*>(df0_::address + n);
+					return *reinterpret_cast<volatile uint8_t*>(df0_::address + df0_::index + n);
 				}
 			};
 			data_t	DATA;
@@ -1526,19 +1505,19 @@ namespace device {
 		struct msgbuf_rwd_t {
 
 			typedef rw32_index_t<base + ofs + 0> hf0_;
-			rw32_t<hf0_::address> HF0;
+			hf0_ HF0;
 			bits_rw_t<hf0_, bitpos::B0,  29>  ID;
 			bit_rw_t <hf0_, bitpos::B29>      THENT;
 			bit_rw_t <hf0_, bitpos::B30>      RTR;
 			bit_rw_t <hf0_, bitpos::B31>      IDE;
 
 			typedef rw32_index_t<base + ofs + 4> hf1_;
-			rw32_t<hf1_::address> HF1;
+			hf1_ HF1;
 			bits_rw_t<hf1_, bitpos::B0,  16>  TS;
 			bits_rw_t<hf1_, bitpos::B28,  4>  DLC;
 
 			typedef rw32_index_t<base + ofs + 8> hf2_;
-			rw32_t<hf2_::address> HF2;
+			hf2_ HF2;
 			bit_rw_t <hf2_, bitpos::B0>       ESI;
 			bit_rw_t <hf2_, bitpos::B1>       BRS;
 			bit_rw_t <hf2_, bitpos::B2>       FDF;
@@ -1552,17 +1531,17 @@ namespace device {
 				// 32ビット単位、読出し専用
 				uint32_t operator() (uint32_t n) noexcept {
 					if(n >= 16) n = 15;
-					return rd32_(df0_::address + n * 4);
+					return rd32_(df0_::address + df0_::index + n * 4);
 				}
 
 				void set(uint32_t n, uint32_t d) noexcept {
 					if(n >= 16) n = 15;
-					return wr32_(df0_::address + n * 4, d);
+					return wr32_(df0_::address + df0_::index + n * 4, d);
 				}
 
 				volatile uint32_t& operator [] (uint32_t n) noexcept {
 					if(n >= 16) n = 15;
-					return *reinterpret_cast<volatile uint32_t*>(df0_::address + n * 4);
+					return *reinterpret_cast<volatile uint32_t*>(df0_::address + df0_::index + n * 4);
 				}
 			};
 			df_t	DF;
@@ -1571,17 +1550,17 @@ namespace device {
 				// バイト単位、読出し専用
 				uint8_t operator() (uint32_t n) noexcept {
 					if(n >= 64) n = 63;
-					return rd8_(df0_::address + n);
+					return rd8_(df0_::address + df0_::index + n);
 				}
 
 				void set(uint32_t n, uint32_t d) noexcept {
 					if(n >= 64) n = 64;
-					return wr8_(df0_::address + n, d);
+					return wr8_(df0_::address + df0_::index + n, d);
 				}
 
 				volatile uint8_t& operator [] (uint32_t n) noexcept {
 					if(n >= 64) n = 63;
-					return *reinterpret_cast<volatile uint8_t*>(df0_::address + n);
+					return *reinterpret_cast<volatile uint8_t*>(df0_::address + df0_::index + n);
 				}
 			};
 			data_t	DATA;
@@ -1659,7 +1638,6 @@ namespace device {
 		template <uint32_t ofs>
 		struct eccsr_t : public rw32_t<ofs> {
 			typedef ro32_t<ofs> in_;
-			using in_::operator ();
 			typedef rw32_t<ofs> io_;
 			using io_::operator =;
 			using io_::operator ();
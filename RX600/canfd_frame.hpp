@@ -3,7 +3,7 @@
 /*!	@file
 	@brief	CANFD フレーム・クラス
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2024, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -16,21 +16,15 @@ namespace device {
 	/*!
 		@brief	CANFD フレーム構造・クラス @n
 				・RX CANFD のメッセージバッファ構造を表現したもの @n
-				・内部は、32 ビット x 4 ワードの単純な構造 @n
-				pad[0]::B31 = IDE @n
-				pad[0]::B30 = RTR @n
-				pad[0]::B28-B18 = SID @n
-				pad[0]::B17-B0  = EID @n
-				pad[1]::B20-B16 = DLC @n
-				pad[1]::B15-B8  = DATA0 @n
-				pad[1]::B7-B0   = DATA1 @n
-				pad[2]::B31-B24 = DATA2 @n
-				pad[2]::B23-B16 = DATA3 @n
-				pad[2]::B15-B8  = DATA4 @n
-				pad[2]::B7-B0   = DATA5 @n
-				pad[3]::B31-B24 = DATA6 @n
-				pad[3]::B23-B16 = DATA7 @n
-				pad[3]::B15-B0  = TS
+				hf0_::B31 = IDE @n
+				hf0_::B30 = RTR @n
+				hf0_::B28-B0 = ID（標準 ID の場合 B10-B0） @n
+				hf1_::B31-B28 = DLC @n
+				hf1_::B15-B0  = TS @n
+				hf2_::B2 = FDF @n
+				hf2_::B1 = BRS @n
+				hf2_::B0 = ESI @n
+				df_[0..15] = DATA0 ～ DATA63（リトルエンディアン）
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	class canfd_frame {
@@ -39,7 +33,241 @@ namespace device {
 		uint32_t	hf2_;
 		uint32_t	df_[16];
 
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  DLC からデータ長（バイト）へ変換
+			@param[in]	dlc	DLC
+			@return データ長
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr uint32_t dlc_to_length(uint32_t dlc) noexcept
+		{
+			constexpr uint8_t tbl[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+			return tbl[dlc & 15];
+		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  データ長（バイト）から DLC へ変換（切り上げ）
+			@param[in]	len	データ長
+			@return DLC
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr uint32_t length_to_dlc(uint32_t len) noexcept
+		{
+			if(len <= 8) return len;
+			for(uint32_t dlc = 9; dlc < 15; ++dlc) {
+				if(len <= dlc_to_length(dlc)) return dlc;
+			}
+			return 15;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクタ
+		*/
+		//-----------------------------------------------------------------//
+		canfd_frame() noexcept : hf0_(0), hf1_(0), hf2_(0), df_{ 0 } { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ヘッダーの設定
+			@param[in]	hf0	HF0
+			@param[in]	hf1	HF1
+			@param[in]	hf2	HF2
+		*/
+		//-----------------------------------------------------------------//
+		void set_header(uint32_t hf0, uint32_t hf1, uint32_t hf2) noexcept
+		{
+			hf0_ = hf0;
+			hf1_ = hf1;
+			hf2_ = hf2;
+		}
+
+
+		uint32_t get_HF0() const noexcept { return hf0_; }
+		uint32_t get_HF1() const noexcept { return hf1_; }
+		uint32_t get_HF2() const noexcept { return hf2_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	IDE の設定
+			@param[in]	v	値
+		*/
+		//-----------------------------------------------------------------//
+		void set_IDE(bool v) noexcept { if(v) hf0_ |= 1 << 31; else hf0_ &= ~(1 << 31); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	IDE の取得
+			@return IDE
+		*/
+		//-----------------------------------------------------------------//
+		bool get_IDE() const noexcept { return (hf0_ >> 31) & 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	RTR の設定
+			@param[in]	v	値
+		*/
+		//-----------------------------------------------------------------//
+		void set_RTR(bool v) noexcept { if(v) hf0_ |= 1 << 30; else hf0_ &= ~(1 << 30); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	RTR の取得
+			@return RTR
+		*/
+		//-----------------------------------------------------------------//
+		bool get_RTR() const noexcept { return (hf0_ >> 30) & 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ID の設定（標準 ID は 11 ビット、拡張 ID は 29 ビット）
+			@param[in]	id	ID
+		*/
+		//-----------------------------------------------------------------//
+		void set_id(uint32_t id) noexcept
+		{
+			hf0_ &= ~0x1fff'ffff;
+			hf0_ |= id & 0x1fff'ffff;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ID の取得
+			@return ID
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_id() const noexcept { return hf0_ & 0x1fff'ffff; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	DLC の設定
+			@param[in]	n	DLC
+		*/
+		//-----------------------------------------------------------------//
+		void set_DLC(uint32_t n) noexcept
+		{
+			hf1_ &= ~(0xf << 28);
+			hf1_ |= (n & 0xf) << 28;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	DLC の取得
+			@return DLC
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_DLC() const noexcept { return hf1_ >> 28; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	データ長（バイト）の取得
+			@return データ長
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_length() const noexcept { return dlc_to_length(get_DLC()); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	TS の取得
+			@return TS
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_TS() const noexcept { return hf1_ & 0xffff; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	FDF（CAN FD フレーム）の設定
+			@param[in]	v	値
+		*/
+		//-----------------------------------------------------------------//
+		void set_FDF(bool v) noexcept { if(v) hf2_ |= 1 << 2; else hf2_ &= ~(1 << 2); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	FDF（CAN FD フレーム）の取得
+			@return FDF
+		*/
+		//-----------------------------------------------------------------//
+		bool get_FDF() const noexcept { return (hf2_ >> 2) & 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	BRS（ビットレート・スイッチ）の設定
+			@param[in]	v	値
+		*/
+		//-----------------------------------------------------------------//
+		void set_BRS(bool v) noexcept { if(v) hf2_ |= 1 << 1; else hf2_ &= ~(1 << 1); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	BRS（ビットレート・スイッチ）の取得
+			@return BRS
+		*/
+		//-----------------------------------------------------------------//
+		bool get_BRS() const noexcept { return (hf2_ >> 1) & 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ESI（エラー状態）の取得
+			@return ESI
+		*/
+		//-----------------------------------------------------------------//
+		bool get_ESI() const noexcept { return hf2_ & 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	DATA の設定
+			@param[in]	idx	インデックス（０～６３）
+			@param[in]	d	設定値
+		*/
+		//-----------------------------------------------------------------//
+		void set_DATA(uint32_t idx, uint8_t d) noexcept
+		{
+			uint32_t sfc = (idx & 3) << 3;
+			auto& w = df_[(idx >> 2) & 15];
+			w &= ~(0xff << sfc);
+			w |= static_cast<uint32_t>(d) << sfc;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	DATA の取得
+			@param[in]	idx	インデックス（０～６３）
+			@return 値
+		*/
+		//-----------------------------------------------------------------//
+		uint8_t get_DATA(uint32_t idx) const noexcept
+		{
+			return df_[(idx >> 2) & 15] >> ((idx & 3) << 3);
+		}
+
+
+		const uint32_t& operator [] (uint32_t idx) const noexcept { return df_[idx & 15]; }
+
+		uint32_t& operator [] (uint32_t idx) noexcept { return df_[idx & 15]; }
 	};
 }
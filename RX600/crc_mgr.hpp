@@ -0,0 +1,265 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	CRC マネージャー（CRC/CRCA 演算器） @n
+			・utils::crc_engine と同じ定義（crc_def::TYPE）、同じ結果になる。 @n
+			・演算器が持たない種類（CRC では CRC-32/CRC-32C）は、ソフトウェア @n
+			  （slice-by-N テーブル）で計算する。 @n
+			・CRCA の 16/32 ビット入力で割り切れない端数は、ソフトウェアで続けて @n
+			  計算する（途中の値が CRCDOR と同じ形なので、混ぜて使える）。 @n
+			・DMAC を指定すると、DMA_MIN 単位以上の LSB ファーストの入力を、 @n
+			  ソフトウェア起動の DMA で CRCDIR に送る（計算中は、その DMAC @n
+			  チャネルを占有し、転送の終了を待つ）。 @n
+			※演算器は一つなので、割り込みと両方から使う場合は、呼び出し側で排他する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <type_traits>
+#include "common/device.hpp"
+#include "common/crc_engine.hpp"
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  CRC マネージャー
+		@param[in]	CRC		CRC 演算器（CRC 又は CRCA）
+		@param[in]	DMAC	入力に使う DMAC チャネル（void なら CPU で入力）
+		@param[in]	SLICE	ソフトウェアで計算する場合のテーブル（1、4、8）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CRC, class DMAC = void, uint32_t SLICE = 4>
+	class crc_mgr : public utils::crc_def {
+	public:
+		static constexpr uint32_t DMA_MIN = 64;	///< DMA を使う最小の入力回数
+
+	private:
+		// CRCA（32 ビット入力を持つ）か？
+		template <class T, class = void>
+		struct is_crca_ : std::false_type { };
+		template <class T>
+		struct is_crca_<T, std::void_t<decltype(T::CRCDIR32)>> : std::true_type { };
+
+		static constexpr bool CRCA = is_crca_<CRC>::value;
+
+		template <TYPE T>
+		using soft_ = utils::crc_engine<T, SLICE>;
+
+		// 演算器で計算できるか？
+		static constexpr bool hard_(TYPE t) noexcept
+		{
+			return CRCA || get_spec(t).width <= 16;
+		}
+
+		// 入力単位（バイト）
+		static constexpr uint32_t unit_(TYPE t) noexcept
+		{
+			if constexpr (CRCA) {
+				auto w = get_spec(t).width;
+				if(w == 16) {
+					// CRCDIR16 が８ビットのデバイスでは、バイトで入力
+					return decltype(CRC::CRCDIR16)::bus == 16 ? 2 : 1;
+				}
+				return w / 8;
+			} else {
+				return 1;
+			}
+		}
+
+		static constexpr uint8_t gps_(TYPE t) noexcept
+		{
+			switch(t) {
+			case TYPE::CRC8:		return 1;
+			case TYPE::CRC16:		return 2;
+			case TYPE::CRC16_CCITT:	return 3;
+			case TYPE::CRC32:		return 4;
+			case TYPE::CRC32C:
+			default:				return 5;
+			}
+		}
+
+		template <TYPE T>
+		static void setup_(uint32_t reg) noexcept
+		{
+			constexpr auto spec = get_spec(T);
+			CRC::CRCCR = CRC::CRCCR.GPS.b(gps_(T)) | CRC::CRCCR.LMS.b(!spec.refl) | CRC::CRCCR.DORCLR.b();
+			if constexpr (CRCA) {
+				if constexpr (spec.width == 32) CRC::CRCDOR32 = reg;
+				else if constexpr (spec.width == 16) CRC::CRCDOR16 = reg;
+				else CRC::CRCDOR8 = reg;
+			} else {
+				CRC::CRCDOR = reg;
+			}
+		}
+
+		template <TYPE T>
+		static uint32_t result_() noexcept
+		{
+			constexpr auto spec = get_spec(T);
+			if constexpr (CRCA) {
+				if constexpr (spec.width == 32) return CRC::CRCDOR32();
+				else if constexpr (spec.width == 16) return CRC::CRCDOR16();
+				else return CRC::CRCDOR8();
+			} else {
+				return CRC::CRCDOR() & ((1 << spec.width) - 1);
+			}
+		}
+
+		template <uint32_t U>
+		static void cpu_feed_(const uint8_t* p, uint32_t n, bool refl) noexcept
+		{
+			for(uint32_t i = 0; i < n; ++i) {
+				if constexpr (U == 4) {
+					CRC::CRCDIR32 = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+						| (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+				} else if constexpr (U == 2) {
+					// MSB ファーストは、上位バイトから入力される
+					if(refl) {
+						CRC::CRCDIR16 = static_cast<uint16_t>(p[0] | (p[1] << 8));
+					} else {
+						CRC::CRCDIR16 = static_cast<uint16_t>((p[0] << 8) | p[1]);
+					}
+				} else if constexpr (CRCA) {
+					CRC::CRCDIR8 = p[0];
+				} else {
+					CRC::CRCDIR = p[0];
+				}
+				p += U;
+			}
+		}
+
+		template <uint32_t U>
+		static void dma_feed_(const uint8_t* p, uint32_t n) noexcept
+		{
+			uint32_t dst;
+			if constexpr (U == 4) dst = decltype(CRC::CRCDIR32)::address;
+			else if constexpr (U == 2) dst = decltype(CRC::CRCDIR16)::address;
+			else if constexpr (CRCA) dst = decltype(CRC::CRCDIR8)::address;
+			else dst = decltype(CRC::CRCDIR)::address;
+			constexpr uint8_t sz = U == 4 ? 2 : (U == 2 ? 1 : 0);
+
+			// CPU が書いたデータを、DMA より先にメモリーへ出す
+			asm volatile ("" : : : "memory");
+
+			auto src = reinterpret_cast<uint32_t>(p);
+			while(n > 0) {
+				auto num = n > 65535 ? 65535 : n;
+				DMAC::DMCNT.DTE = 0;
+				// 転送元 (+1)、転送先 固定
+				DMAC::DMAMD = DMAC::DMAMD.DM.b(0b00) | DMAC::DMAMD.SM.b(0b10);
+				DMAC::DMTMD = DMAC::DMTMD.DCTG.b(0b00) | DMAC::DMTMD.SZ.b(sz) |
+							  DMAC::DMTMD.DTS.b(0b10)  | DMAC::DMTMD.MD.b(0b00);
+				DMAC::DMSAR = src;
+				DMAC::DMDAR = dst;
+				DMAC::DMCRA = num;
+				DMAC::DMINT = 0x00;
+				DMAC::DMCNT.DTE = 1;
+				DMAC::DMREQ = DMAC::DMREQ.SWREQ.b() | DMAC::DMREQ.CLRS.b();
+				while(DMAC::DMCNT.DTE() != 0) ;
+				src += num * U;
+				n -= num;
+			}
+		}
+
+		template <TYPE T>
+		static uint32_t hard_update_(uint32_t reg, const uint8_t* p, uint32_t n) noexcept
+		{
+			constexpr auto spec = get_spec(T);
+			constexpr auto U = unit_(T);
+			setup_<T>(reg);
+			if constexpr (!std::is_void_v<DMAC>) {
+				// MSB ファーストの 16 ビット入力は、バイト順が合わないので CPU で入力
+				if((U == 1 || spec.refl) && n >= DMA_MIN) {
+					dma_feed_<U>(p, n);
+					return result_<T>();
+				}
+			}
+			cpu_feed_<U>(p, n, spec.refl);
+			return result_<T>();
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始（演算器、DMAC の電源を入れる）
+		*/
+		//-----------------------------------------------------------------//
+		static void start() noexcept
+		{
+			power_mgr::turn(CRC::PERIPHERAL);
+			if constexpr (!std::is_void_v<DMAC>) {
+				power_mgr::turn(DMAC::PERIPHERAL);
+				DMAC::DMCNT.DTE = 0;
+				DMAC::DMAST.DMST = 1;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  演算器で計算するか？
+			@param[in]	type	CRC の種類
+			@return 演算器で計算する場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr bool is_hardware(TYPE type) noexcept { return hard_(type); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レジスタの更新（分割して計算できる）
+			@param[in]	reg	レジスタ（最初は crc_engine<T>::init()）
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+			@return レジスタ
+		*/
+		//-----------------------------------------------------------------//
+		template <TYPE T>
+		static uint32_t update(uint32_t reg, const void* src, uint32_t len) noexcept
+		{
+			if constexpr (!hard_(T)) {
+				return soft_<T>::update(reg, src, len);
+			} else {
+				constexpr auto U = unit_(T);
+				auto p = static_cast<const uint8_t*>(src);
+				if constexpr (!std::is_void_v<DMAC> && U > 1) {
+					// DMA の境界に合わせる
+					auto ofs = reinterpret_cast<uint32_t>(p) & (U - 1);
+					if(ofs != 0 && len > (U - ofs)) {
+						reg = soft_<T>::update(reg, p, U - ofs);
+						p += U - ofs;
+						len -= U - ofs;
+					}
+				}
+				auto n = len / U;
+				if(n > 0) {
+					reg = hard_update_<T>(reg, p, n);
+					p += n * U;
+					len -= n * U;
+				}
+				if(len > 0) {
+					reg = soft_<T>::update(reg, p, len);
+				}
+				return reg;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  CRC の計算
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+			@return CRC
+		*/
+		//-----------------------------------------------------------------//
+		template <TYPE T>
+		static uint32_t calc(const void* src, uint32_t len) noexcept
+		{
+			return soft_<T>::final(update<T>(soft_<T>::init(), src, len));
+		}
+	};
+}
@@ -0,0 +1,809 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	DMA サービス（DMAC/EXDMAC チャネルの調停とジョブ・キュー） @n
+			・与えられた全てのチャネルを所有し、登録されたジョブを空いている @n
+			  チャネルに割り当てる。 @n
+			・ジョブは優先度順（同じ優先度は登録順）に実行する。 @n
+			・転送回数の上限（65535）を超えるノーマル転送は、自動で分割し、 @n
+			  終了割り込みで次の区間を起動する。 @n
+			・CHAIN は、ディスクリプタの列（スキャッタ／ギャザー）を一つの @n
+			  チャネルで順番に転送する。 @n
+			・完了コールバックは、DMA 終了割り込みの中から、排他を解いてから呼ばれる。 @n
+			・sample() を一定周期（タイマー割り込みなど）で呼ぶと、チャネルの @n
+			  使用率を測定する。 @n
+			EXDMAC チャネルは、ソフトウェア起動のジョブ（COPY、FILL、CHAIN）だけ @n
+			を受け持つ（周辺機能の要因は DMAC チャネルのみ）。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include "common/device.hpp"
+#include "common/vect.h"
+#include "RX600/dmac_mgr.hpp"
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  DMA サービス、定数クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct dma_service_def : public dmac_mgr_def {
+
+		static constexpr uint32_t COUNT_MAX = 65535;	///< ノーマル転送の最大回数
+		static constexpr uint32_t NONE = 0;				///< 無効なジョブ ID
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  優先度
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class PRIORITY : uint8_t {
+			LOW,	///< 低い
+			NORMAL,	///< 通常
+			HIGH,	///< 高い
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  ジョブの状態
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class STATE : uint8_t {
+			NONE,	///< 無効（完了済み、又は存在しない）
+			WAIT,	///< 待ち
+			RUN,	///< 転送中
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  完了コールバック（割り込み内で呼ばれる）
+			@param[in]	id	ジョブ ID
+			@param[in]	ctx	登録時のコンテキスト
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		typedef void (*DONE_TASK)(uint32_t id, void* ctx);
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  CHAIN のディスクリプタ（転送が終わるまで保持する事）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct desc_t {
+			const void*	src;	///< 転送元
+			void*		dst;	///< 転送先
+			uint32_t	len;	///< バイト数
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  チャネルの統計
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct stat_t {
+			uint32_t	jobs;		///< 完了したジョブ数
+			uint32_t	segments;	///< 起動した区間数
+			uint32_t	bytes;		///< 転送したバイト数
+			uint32_t	busy;		///< sample() で転送中だった回数
+			uint32_t	samples;	///< sample() の回数
+		};
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  DMA サービス・クラス
+		@param[in]	JOB_MAX	同時に登録できるジョブの最大数
+		@param[in]	CHS		管理する DMAC/EXDMAC チャネル（DMAC0、EXDMAC0 など）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t JOB_MAX, class... CHS>
+	class dma_service : public dma_service_def {
+
+		static_assert(sizeof...(CHS) > 0, "No DMA channel");
+		static_assert(JOB_MAX > 0 && JOB_MAX < 256, "JOB_MAX out of range");
+
+	public:
+		static constexpr uint32_t CHN_NUM = sizeof...(CHS);	///< チャネル数
+
+	private:
+		template <uint32_t I>
+		using chn_t = std::tuple_element_t<I, std::tuple<CHS...>>;
+
+		// EXDMAC チャネル（EDMSAR を持つ）か？
+		template <class CH, class = void>
+		struct is_ex_ : std::false_type { };
+		template <class CH>
+		struct is_ex_<CH, std::void_t<decltype(CH::EDMSAR)>> : std::true_type { };
+
+		static constexpr uint8_t IDX_NONE = 0xff;
+
+		enum class TYPE : uint8_t {
+			COPY,
+			FILL,
+			TRIGGER,
+			CHAIN,
+		};
+
+		struct job_t {
+			uint32_t	sar;		// 次の区間の転送元
+			uint32_t	dar;		// 次の区間の転送先
+			uint32_t	remain;		// 残りの転送回数
+			uint32_t	pattern;	// FILL の値
+			const desc_t* desc;
+			DONE_TASK	done;
+			void*		ctx;
+			uint16_t	gen;
+			uint16_t	desc_num;
+			uint16_t	desc_idx;
+			uint16_t	blk;		// REPEAT/BLOCK のサイズ
+			ICU::VECTOR	trg;
+			TYPE		type;
+			TRANS_MODE	mode;
+			STATE		state;
+			PRIORITY	pri;
+			uint8_t		sz;			// 0:8, 1:16, 2:32 ビット
+			uint8_t		sm;			// 0b00:固定, 0b10:＋, 0b11:－
+			uint8_t		dm;
+			uint8_t		chn;
+			uint8_t		next;		// 待ち行列
+			bool		disel;
+		};
+
+		static inline job_t		job_[JOB_MAX];
+		static inline uint8_t	head_[3];
+		static inline uint8_t	tail_[3];
+		static inline uint8_t	run_[CHN_NUM];
+		static inline stat_t	stat_[CHN_NUM];
+		static inline uint16_t	gen_;
+		static inline ICU::LEVEL	level_;
+
+		struct done_t {
+			DONE_TASK	task;
+			uint32_t	id;
+			void*		ctx;
+		};
+
+		static void sleep_() noexcept { asm("nop"); }
+
+		static uint32_t lock_() noexcept
+		{
+#ifdef __RX__
+			uint32_t psw;
+			asm volatile ("mvfc psw,%0\n\tclrpsw i" : "=r"(psw) : : "memory");
+			return psw;
+#else
+			return 0;
+#endif
+		}
+
+		static void unlock_(uint32_t psw) noexcept
+		{
+#ifdef __RX__
+			asm volatile ("mvtc %0,psw" : : "r"(psw) : "memory");
+#else
+			(void)psw;
+#endif
+		}
+
+		// 実行時のチャネル番号で、チャネルの型を選ぶ
+		template <class F, uint32_t... I>
+		static void visit_(uint32_t idx, F&& f, std::integer_sequence<uint32_t, I...>) noexcept
+		{
+			((idx == I ? (f(std::integral_constant<uint32_t, I>{ }), 0) : 0), ...);
+		}
+
+		template <class F>
+		static void visit_(uint32_t idx, F&& f) noexcept
+		{
+			visit_(idx, f, std::make_integer_sequence<uint32_t, CHN_NUM>{ });
+		}
+
+		static bool is_ex_chn_(uint32_t idx) noexcept
+		{
+			bool ex = false;
+			visit_(idx, [&](auto c) { ex = is_ex_<chn_t<decltype(c)::value>>::value; });
+			return ex;
+		}
+
+		static uint32_t make_id_(uint32_t idx) noexcept
+		{
+			return (static_cast<uint32_t>(job_[idx].gen) << 8) | (idx + 1);
+		}
+
+		static job_t* find_(uint32_t id) noexcept
+		{
+			auto idx = (id & 0xff) - 1;
+			if(id == NONE || idx >= JOB_MAX) return nullptr;
+			auto& j = job_[idx];
+			if(j.state == STATE::NONE || j.gen != (id >> 8)) return nullptr;
+			return &j;
+		}
+
+		// アドレスと長さから、転送単位を決める
+		static uint8_t unit_(uint32_t src, uint32_t dst, uint32_t len) noexcept
+		{
+			if(((src | dst | len) & 3) == 0) return 2;
+			else if(((src | dst | len) & 1) == 0) return 1;
+			else return 0;
+		}
+
+		static void step_(uint32_t& adr, uint8_t md, uint32_t n) noexcept
+		{
+			if(md == 0b10) adr += n;
+			else if(md == 0b11) adr -= n;
+		}
+
+		// メモリー間の転送を設定（オーバーラップする場合は、上から転送）
+		static void setup_copy_(job_t& j, uint32_t src, uint32_t dst, uint32_t len) noexcept
+		{
+			j.sz = unit_(src, dst, len);
+			j.remain = len >> j.sz;
+			if(dst > src && dst < (src + len)) {
+				auto top = len - (1 << j.sz);
+				j.sar = src + top;
+				j.dar = dst + top;
+				j.sm = 0b11;
+				j.dm = 0b11;
+			} else {
+				j.sar = src;
+				j.dar = dst;
+				j.sm = 0b10;
+				j.dm = 0b10;
+			}
+		}
+
+		template <class CH>
+		static void program_(job_t& j, uint32_t cnt) noexcept
+		{
+			uint8_t dctg = j.type == TYPE::TRIGGER ? 0b01 : 0b00;
+			auto md = static_cast<uint8_t>(j.mode);
+			if constexpr (is_ex_<CH>::value) {
+				CH::EDMCNT.DTE = 0;
+				CH::EDMAMD = CH::EDMAMD.DM.b(j.dm) | CH::EDMAMD.SM.b(j.sm);
+				CH::EDMTMD = CH::EDMTMD.DCTG.b(dctg) | CH::EDMTMD.SZ.b(j.sz) |
+							 CH::EDMTMD.DTS.b(0b10) | CH::EDMTMD.MD.b(md);
+				CH::EDMSAR = j.sar;
+				CH::EDMDAR = j.dar;
+				CH::EDMCRA = cnt;
+				CH::EDMINT = CH::EDMINT.DTIE.b();
+				CH::EDMCNT.DTE = 1;
+				CH::EDMREQ = CH::EDMREQ.SWREQ.b() | CH::EDMREQ.CLRS.b();
+			} else {
+				CH::DMCNT.DTE = 0;
+				CH::DMAMD = CH::DMAMD.DM.b(j.dm) | CH::DMAMD.SM.b(j.sm);
+				CH::DMTMD = CH::DMTMD.DCTG.b(dctg) | CH::DMTMD.SZ.b(j.sz) |
+							CH::DMTMD.DTS.b(j.mode == TRANS_MODE::NORMAL ? 0b10 : 0b01) | CH::DMTMD.MD.b(md);
+				CH::DMSAR = j.sar;
+				CH::DMDAR = j.dar;
+				if(j.mode == TRANS_MODE::NORMAL) {
+					CH::DMCRA = cnt;
+				} else {
+					// サイズ（リロード値とカウンター）、REPEAT/BLOCK の回数（０で１０２４）
+					uint32_t blk = j.blk & 0x3ff;
+					CH::DMCRA = (blk << 16) | blk;
+					CH::DMCRB = cnt & 0x3ff;
+				}
+				CH::DMINT = CH::DMINT.DTIE.b();
+				if(j.type == TYPE::TRIGGER) {
+					icu_mgr::set_dmac(CH::PERIPHERAL, j.trg);
+					CH::DMCSL.DISEL = j.disel;
+					CH::DMCNT.DTE = 1;
+				} else {
+					CH::DMCSL.DISEL = 0;
+					CH::DMCNT.DTE = 1;
+					CH::DMREQ = CH::DMREQ.SWREQ.b() | CH::DMREQ.CLRS.b();
+				}
+			}
+		}
+
+		// 次の区間を起動（無ければ「false」）
+		static bool next_segment_(uint32_t chn, job_t& j) noexcept
+		{
+			while(j.remain == 0) {
+				if(j.type != TYPE::CHAIN || j.desc_idx >= j.desc_num) return false;
+				const auto& d = j.desc[j.desc_idx];
+				++j.desc_idx;
+				if(d.len == 0) continue;
+				setup_copy_(j, reinterpret_cast<uint32_t>(d.src), reinterpret_cast<uint32_t>(d.dst), d.len);
+			}
+			uint32_t cnt = j.remain;
+			if(j.mode != TRANS_MODE::NORMAL) {
+				j.remain = 0;
+			} else {
+				if(cnt > COUNT_MAX) cnt = COUNT_MAX;
+				j.remain -= cnt;
+			}
+			auto& st = stat_[chn];
+			++st.segments;
+			st.bytes += (j.mode == TRANS_MODE::NORMAL ? cnt : cnt * j.blk) << j.sz;
+			visit_(chn, [&](auto c) { program_<chn_t<decltype(c)::value>>(j, cnt); });
+			// 次の区間のアドレス
+			auto n = (j.mode == TRANS_MODE::NORMAL ? cnt : 0) << j.sz;
+			step_(j.sar, j.sm, n);
+			step_(j.dar, j.dm, n);
+			return true;
+		}
+
+		static void enqueue_(uint8_t idx) noexcept
+		{
+			auto p = static_cast<uint8_t>(job_[idx].pri);
+			job_[idx].next = IDX_NONE;
+			if(head_[p] == IDX_NONE) {
+				head_[p] = idx;
+			} else {
+				job_[tail_[p]].next = idx;
+			}
+			tail_[p] = idx;
+		}
+
+		// 待ち行列から、チャネルで実行できる最初のジョブを取り出す
+		static uint8_t dequeue_(bool ex) noexcept
+		{
+			for(int32_t p = 2; p >= 0; --p) {
+				uint8_t prev = IDX_NONE;
+				auto idx = head_[p];
+				while(idx != IDX_NONE) {
+					const auto& j = job_[idx];
+					if(!ex || j.type != TYPE::TRIGGER) {
+						if(prev == IDX_NONE) head_[p] = j.next;
+						else job_[prev].next = j.next;
+						if(tail_[p] == idx) tail_[p] = prev;
+						return idx;
+					}
+					prev = idx;
+					idx = j.next;
+				}
+			}
+			return IDX_NONE;
+		}
+
+		// コールバックは、排他を解いてから呼ぶ（ジョブは再利用されるので、先に取り出す）
+		static done_t complete_(uint32_t chn, job_t& j) noexcept
+		{
+			done_t d { j.done, make_id_(&j - job_), j.ctx };
+			++stat_[chn].jobs;
+			run_[chn] = IDX_NONE;
+			j.state = STATE::NONE;
+			return d;
+		}
+
+		// 空いているチャネルに、待ちのジョブを割り当てる
+		static void dispatch_() noexcept
+		{
+			for(uint32_t i = 0; i < CHN_NUM; ++i) {
+				while(run_[i] == IDX_NONE) {
+					auto idx = dequeue_(is_ex_chn_(i));
+					if(idx == IDX_NONE) break;
+					auto& j = job_[idx];
+					j.state = STATE::RUN;
+					j.chn = i;
+					run_[i] = idx;
+					// 登録時に長さを確かめているので、最初の区間は必ずある
+					next_segment_(i, j);
+				}
+			}
+		}
+
+		template <class CH>
+		static bool check_() noexcept
+		{
+			if constexpr (is_ex_<CH>::value) {
+				if(!CH::EDMSTS.DTIF()) return false;
+				CH::EDMSTS.DTIF = 0;
+			} else {
+				if(!CH::DMSTS.DTIF()) return false;
+				CH::DMSTS.DTIF = 0;
+			}
+			return true;
+		}
+
+		static void service_(uint32_t chn) noexcept
+		{
+			done_t d { nullptr, NONE, nullptr };
+			auto psw = lock_();
+			if(run_[chn] != IDX_NONE) {
+				auto& j = job_[run_[chn]];
+				if(!next_segment_(chn, j)) {
+					d = complete_(chn, j);
+					dispatch_();
+				}
+			}
+			unlock_(psw);
+			if(d.task != nullptr) (*d.task)(d.id, d.ctx);
+		}
+
+		// 同じベクターを共有するチャネル（DMAC4～7 など）を全て調べる
+		template <uint32_t I, uint32_t... J>
+		static void itask_main_(std::integer_sequence<uint32_t, J...>) noexcept
+		{
+			((chn_t<J>::IVEC == chn_t<I>::IVEC && check_<chn_t<J>>() ? service_(J) : void()), ...);
+		}
+
+		template <uint32_t I>
+		static INTERRUPT_FUNC void itask_() noexcept
+		{
+			itask_main_<I>(std::make_integer_sequence<uint32_t, CHN_NUM>{ });
+		}
+
+		template <uint32_t... I>
+		static void start_chn_(std::integer_sequence<uint32_t, I...>) noexcept
+		{
+			(start_chn_<chn_t<I>, I>(), ...);
+		}
+
+		template <class CH, uint32_t I>
+		static void start_chn_() noexcept
+		{
+			power_mgr::turn(CH::PERIPHERAL);
+			if constexpr (is_ex_<CH>::value) {
+				CH::EDMCNT.DTE = 0;
+				CH::EDMSTS.DTIF = 0;
+				CH::COMMON::EDMAST.DMST = 1;
+			} else {
+				CH::DMCNT.DTE = 0;
+				CH::DMSTS.DTIF = 0;
+				CH::DMAST.DMST = 1;
+			}
+			icu_mgr::set_interrupt(CH::IVEC, itask_<I>, level_);
+		}
+
+		template <class CH>
+		static bool active_() noexcept
+		{
+			if constexpr (is_ex_<CH>::value) {
+				return CH::EDMCNT.DTE();
+			} else {
+				return CH::DMCNT.DTE();
+			}
+		}
+
+		static uint32_t submit_(job_t& j) noexcept
+		{
+			auto psw = lock_();
+			enqueue_(&j - job_);
+			dispatch_();
+			auto id = make_id_(&j - job_);
+			unlock_(psw);
+			return id;
+		}
+
+		static job_t* alloc_(TYPE type, PRIORITY pri, DONE_TASK done, void* ctx) noexcept
+		{
+			auto psw = lock_();
+			job_t* p = nullptr;
+			for(uint32_t i = 0; i < JOB_MAX; ++i) {
+				if(job_[i].state == STATE::NONE) {
+					p = &job_[i];
+					++gen_;
+					if(gen_ == 0) gen_ = 1;
+					p->gen = gen_;
+					p->state = STATE::WAIT;
+					break;
+				}
+			}
+			unlock_(psw);
+			if(p == nullptr) return nullptr;
+			p->type = type;
+			p->pri = pri;
+			p->done = done;
+			p->ctx = ctx;
+			p->mode = TRANS_MODE::NORMAL;
+			p->desc = nullptr;
+			p->desc_num = 0;
+			p->desc_idx = 0;
+			p->blk = 0;
+			p->remain = 0;
+			p->disel = false;
+			return p;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	開始（全てのチャネルを初期化）
+			@param[in]	lvl		DMA 終了割り込みレベル（NONE は不可）
+			@return 割り込みレベルが NONE なら「false」
+		 */
+		//-----------------------------------------------------------------//
+		static bool start(ICU::LEVEL lvl) noexcept
+		{
+			if(lvl == ICU::LEVEL::NONE) return false;
+
+			level_ = lvl;
+			for(uint32_t i = 0; i < 3; ++i) {
+				head_[i] = IDX_NONE;
+				tail_[i] = IDX_NONE;
+			}
+			for(uint32_t i = 0; i < JOB_MAX; ++i) {
+				job_[i].state = STATE::NONE;
+			}
+			for(uint32_t i = 0; i < CHN_NUM; ++i) {
+				run_[i] = IDX_NONE;
+				stat_[i] = stat_t { };
+			}
+			start_chn_(std::make_integer_sequence<uint32_t, CHN_NUM>{ });
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コピー（オーバーラップする場合は、上から転送）
+			@param[in]	src		転送元
+			@param[in]	dst		転送先
+			@param[in]	len		バイト数
+			@param[in]	pri		優先度
+			@param[in]	done	完了コールバック
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return ジョブ ID（登録出来ない場合 NONE）
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t copy(const void* src, void* dst, uint32_t len, PRIORITY pri = PRIORITY::NORMAL,
+			DONE_TASK done = nullptr, void* ctx = nullptr) noexcept
+		{
+			if(src == nullptr || dst == nullptr || len == 0) return NONE;
+			auto p = alloc_(TYPE::COPY, pri, done, ctx);
+			if(p == nullptr) return NONE;
+			setup_copy_(*p, reinterpret_cast<uint32_t>(src), reinterpret_cast<uint32_t>(dst), len);
+			return submit_(*p);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	定数で埋める
+			@param[out]	dst		転送先
+			@param[in]	val		値（８ビット）
+			@param[in]	len		バイト数
+			@param[in]	pri		優先度
+			@param[in]	done	完了コールバック
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return ジョブ ID（登録出来ない場合 NONE）
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t fill(void* dst, uint8_t val, uint32_t len, PRIORITY pri = PRIORITY::NORMAL,
+			DONE_TASK done = nullptr, void* ctx = nullptr) noexcept
+		{
+			if(dst == nullptr || len == 0) return NONE;
+			auto p = alloc_(TYPE::FILL, pri, done, ctx);
+			if(p == nullptr) return NONE;
+			auto adr = reinterpret_cast<uint32_t>(dst);
+			p->pattern = static_cast<uint32_t>(val) * 0x0101'0101;
+			p->sz = unit_(0, adr, len);
+			p->remain = len >> p->sz;
+			p->sar = reinterpret_cast<uint32_t>(&p->pattern);
+			p->dar = adr;
+			p->sm = 0b00;
+			p->dm = 0b10;
+			return submit_(*p);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	周辺機能の要因による転送（DMAC チャネルのみ）
+			@param[in]	trm		転送モード型（NORMAL は回数の制限なし）
+			@param[in]	trt		転送タイプ型
+			@param[in]	trg		転送開始要因
+			@param[in]	src		転送元アドレス
+			@param[in]	dst		転送先アドレス
+			@param[in]	siz		REPEAT/BLOCK のサイズ（１～１０２４）
+			@param[in]	cnt		転送回数（REPEAT/BLOCK はリピート／ブロックの回数、１～１０２４）
+			@param[in]	isel	CPU にも割り込みをかける場合「true」
+			@param[in]	pri		優先度
+			@param[in]	done	完了コールバック
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return ジョブ ID（登録出来ない場合 NONE）
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t trigger(TRANS_MODE trm, TRANS_TYPE trt, ICU::VECTOR trg,
+			uint32_t src, uint32_t dst, uint16_t siz, uint32_t cnt, bool isel = false,
+			PRIORITY pri = PRIORITY::NORMAL, DONE_TASK done = nullptr, void* ctx = nullptr) noexcept
+		{
+			if(cnt == 0) return NONE;
+			if(trm != TRANS_MODE::NORMAL && (siz == 0 || siz > 1024 || cnt > 1024)) return NONE;
+
+			auto p = alloc_(TYPE::TRIGGER, pri, done, ctx);
+			if(p == nullptr) return NONE;
+			p->mode = trm;
+			p->trg = trg;
+			p->disel = isel;
+			p->blk = siz;
+			p->remain = cnt;
+			p->sar = src;
+			p->dar = dst;
+			switch(trt) {
+			case TRANS_TYPE::SN_DP_8:  p->sm = 0b00; p->dm = 0b10; p->sz = 0; break;
+			case TRANS_TYPE::SP_DN_8:  p->sm = 0b10; p->dm = 0b00; p->sz = 0; break;
+			case TRANS_TYPE::SN_DP_16: p->sm = 0b00; p->dm = 0b10; p->sz = 1; break;
+			case TRANS_TYPE::SP_DN_16: p->sm = 0b10; p->dm = 0b00; p->sz = 1; break;
+			case TRANS_TYPE::SN_DP_32: p->sm = 0b00; p->dm = 0b10; p->sz = 2; break;
+			case TRANS_TYPE::SP_DN_32: p->sm = 0b10; p->dm = 0b00; p->sz = 2; break;
+			default: break;
+			}
+			return submit_(*p);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディスクリプタ列の転送（スキャッタ／ギャザー）
+			@param[in]	desc	ディスクリプタ列（完了まで保持する事）
+			@param[in]	num		ディスクリプタ数
+			@param[in]	pri		優先度
+			@param[in]	done	完了コールバック
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return ジョブ ID（登録出来ない場合、全ての長さが０の場合 NONE）
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t chain(const desc_t* desc, uint16_t num, PRIORITY pri = PRIORITY::NORMAL,
+			DONE_TASK done = nullptr, void* ctx = nullptr) noexcept
+		{
+			if(desc == nullptr || num == 0) return NONE;
+			uint32_t len = 0;
+			for(uint16_t i = 0; i < num; ++i) len |= desc[i].len;
+			if(len == 0) return NONE;  // 転送するものが無い
+			auto p = alloc_(TYPE::CHAIN, pri, done, ctx);
+			if(p == nullptr) return NONE;
+			p->desc = desc;
+			p->desc_num = num;
+			return submit_(*p);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ジョブの状態を取得
+			@param[in]	id	ジョブ ID
+			@return 状態（完了したジョブは NONE）
+		 */
+		//-----------------------------------------------------------------//
+		static STATE get_state(uint32_t id) noexcept
+		{
+			auto psw = lock_();
+			auto p = find_(id);
+			auto st = p != nullptr ? p->state : STATE::NONE;
+			unlock_(psw);
+			return st;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ジョブの完了を待つ
+			@param[in]	id	ジョブ ID
+		 */
+		//-----------------------------------------------------------------//
+		static void sync(uint32_t id) noexcept
+		{
+			while(get_state(id) != STATE::NONE) {
+				sleep_();
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	待ちのジョブを取り消す（転送中のジョブは取り消せない）
+			@param[in]	id	ジョブ ID
+			@return 取り消した場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		static bool cancel(uint32_t id) noexcept
+		{
+			auto psw = lock_();
+			auto p = find_(id);
+			bool ret = false;
+			if(p != nullptr && p->state == STATE::WAIT) {
+				auto idx = static_cast<uint8_t>(p - job_);
+				auto pri = static_cast<uint8_t>(p->pri);
+				uint8_t prev = IDX_NONE;
+				for(auto i = head_[pri]; i != IDX_NONE; i = job_[i].next) {
+					if(i == idx) {
+						if(prev == IDX_NONE) head_[pri] = p->next;
+						else job_[prev].next = p->next;
+						if(tail_[pri] == idx) tail_[pri] = prev;
+						break;
+					}
+					prev = i;
+				}
+				p->state = STATE::NONE;
+				ret = true;
+			}
+			unlock_(psw);
+			return ret;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	待ちのジョブ数を取得
+			@return 待ちのジョブ数
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t get_wait_num() noexcept
+		{
+			uint32_t n = 0;
+			for(uint32_t i = 0; i < JOB_MAX; ++i) {
+				if(job_[i].state == STATE::WAIT) ++n;
+			}
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	使用率のサンプリング（一定周期で呼ぶ、割り込み内でも可）
+		 */
+		//-----------------------------------------------------------------//
+		static void sample() noexcept
+		{
+			for(uint32_t i = 0; i < CHN_NUM; ++i) {
+				auto& st = stat_[i];
+				++st.samples;
+				bool act = false;
+				visit_(i, [&](auto c) { act = active_<chn_t<decltype(c)::value>>(); });
+				if(act || run_[i] != IDX_NONE) ++st.busy;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	チャネルの統計を取得
+			@param[in]	chn	チャネル番号（CHS の並び順）
+			@return 統計
+		 */
+		//-----------------------------------------------------------------//
+		static stat_t get_stat(uint32_t chn) noexcept
+		{
+			if(chn >= CHN_NUM) return stat_t { };
+			auto psw = lock_();
+			auto st = stat_[chn];
+			unlock_(psw);
+			return st;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	チャネルの使用率を取得（sample() の結果）
+			@param[in]	chn	チャネル番号（CHS の並び順）
+			@return 使用率（％）
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t get_utilization(uint32_t chn) noexcept
+		{
+			auto st = get_stat(chn);
+			if(st.samples == 0) return 0;
+			return static_cast<uint64_t>(st.busy) * 100 / st.samples;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	統計のクリア
+		 */
+		//-----------------------------------------------------------------//
+		static void clear_stat() noexcept
+		{
+			auto psw = lock_();
+			for(uint32_t i = 0; i < CHN_NUM; ++i) {
+				stat_[i] = stat_t { };
+			}
+			unlock_(psw);
+		}
+	};
+}
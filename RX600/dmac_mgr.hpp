@@ -264,6 +264,61 @@ namespace device {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	割り込み要因によるリング転送開始 @n
+					ノーマル転送をフリーランニング（DMCRA=0）で動かし、 @n
+					転送先は拡張リピートエリア（2^bits バイト）で折り返す。 @n
+					転送に終わりが無いので、転送完了割り込みは使わない。 @n
+					書き込み位置は get_dst() で知る。
+			@param[in]	trt		転送タイプ型（SN_DP_8, SN_DP_16, SN_DP_32）
+			@param[in]	trg		転送開始要因
+			@param[in]	src		転送元アドレス
+			@param[in]	dst		転送先アドレス（2^bits バイト境界）
+			@param[in]	bits	リングの大きさ（2^bits バイト、１～２７）
+			@return 成功なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool start_ring(TRANS_TYPE trt, ICU::VECTOR trg, uint32_t src, uint32_t dst, uint8_t bits) noexcept
+		{
+			uint8_t sz = 0;
+			switch(trt) {
+			case TRANS_TYPE::SN_DP_8:  sz = 0; break;
+			case TRANS_TYPE::SN_DP_16: sz = 1; break;
+			case TRANS_TYPE::SN_DP_32: sz = 2; break;
+			default:
+				return false;
+			}
+			if(bits == 0 || bits > 27 || (dst & ((1 << bits) - 1)) != 0) {
+				return false;
+			}
+
+			power_mgr::turn(DMAC::PERIPHERAL);
+
+			DMAC::DMCNT.DTE = 0;  // 念のため停止させる。
+
+			// 転送元固定、転送先 (+)、転送先を拡張リピートエリアにする
+			DMAC::DMAMD = DMAC::DMAMD.DM.b(0b10) | DMAC::DMAMD.DARA.b(bits) | DMAC::DMAMD.SM.b(0b00);
+			DMAC::DMTMD = DMAC::DMTMD.DCTG.b(0b01) | DMAC::DMTMD.SZ.b(sz) |
+						  DMAC::DMTMD.DTS.b(0b10)  | DMAC::DMTMD.MD.b(0b00);
+			DMAC::DMSAR = src;
+			DMAC::DMDAR = dst;
+			DMAC::DMCRA = 0;  // フリーランニング
+
+			level_ = ICU::LEVEL::NONE;
+			set_vector_(DMAC::IVEC);
+			icu_mgr::set_dmac(DMAC::PERIPHERAL, trg);
+			DMAC::DMINT = 0x00;
+			DMAC::DMCSL.DISEL = 0;
+
+			DMAC::DMCNT.DTE = 1;
+
+			DMAC::DMAST.DMST = 1;
+
+			return true;
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	転送再開 @n
@@ -303,6 +358,17 @@ namespace device {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	転送先アドレスの取得（リング転送の書き込み位置）
+			@return 転送先アドレス
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_dst() const noexcept {
+			return DMAC::DMDAR();
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	DMA 動作中か検査
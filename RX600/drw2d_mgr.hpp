@@ -1,13 +1,24 @@
 #pragma once
 //=========================================================================//
 /*!	@file
-	@brief	RX65N/RX651/RX72N/RX72M DRW2D マネージャー
+	@brief	RX65N/RX651/RX72N/RX72M DRW2D マネージャー @n
+			・描画ステート（カラー、クリップ、フィル・モード、パターン、テクスチャー、 @n
+			  CLUT）は、変化した場合だけ d2 ライブラリに設定する。 @n
+			・表示リスト（drw2d_list）に描画を記録し、重ならない範囲で同じステート @n
+			  の描画をまとめて、フレーム毎に呼び出す事が出来る。 @n
+			  start で list を有効にすると、内容が変わらない表示リストは、d2 の @n
+			  ディスプレイ・リストとして保存し、次のフレームからはそれをコピー @n
+			  するだけで描画する。 @n
+			・d2_startframe/d2_endframe により、CPU がフレーム N+1 を記録して @n
+			  いる間に、DRW2D はフレーム N を描画する。 @n
+			  DRW2D のビジー時間、CPU の待ち時間をフレーム毎に計測する。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2019, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2019, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=========================================================================//
+#include <cstring>
 #include "graphics/color.hpp"
 #include "RX600/drw2d.hpp"
 
@@ -26,6 +37,214 @@ extern "C" {
 
 namespace device {
 
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  DRW2D 表示リスト・ベース・クラス（記録の実体）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class drw2d_list_base {
+
+		template <class GLC, class FONT> friend class drw2d_mgr;
+
+	protected:
+		enum class CMD : uint8_t {
+			BOX,
+			LINE,
+			CIRCLE,
+			WEDGE,
+			TRI,
+			QUAD,
+			BLIT,
+			MOVE,
+			CLEAR,
+		};
+
+		enum class FILL : uint8_t {
+			COLOR,
+			TEXTURE,
+			PATTERN,
+		};
+
+		struct area_t {
+			int16_t	x0;
+			int16_t	y0;
+			int16_t	x1;
+			int16_t	y1;
+
+			bool operator == (const area_t& t) const noexcept {
+				return x0 == t.x0 && y0 == t.y0 && x1 == t.x1 && y1 == t.y1;
+			}
+			bool operator != (const area_t& t) const noexcept { return !(*this == t); }
+
+			bool is_overlap(const area_t& t) const noexcept {
+				return x0 < t.x1 && t.x0 < x1 && y0 < t.y1 && t.y0 < y1;
+			}
+		};
+
+		// 描画ステート（同じなら d2 への設定を省略できる）
+		struct state_t {
+			uint32_t	fore;
+			uint32_t	back;
+			uint32_t	stipple;
+			uint32_t	tex_form;
+			area_t		clip;
+			const void*	tex;	// テクスチャー、又はブリットのソース
+			int16_t		tex_w;
+			int16_t		tex_h;
+			FILL		fill;
+			uint8_t		pdir;	// パターンの方向（0:水平、1:垂直）
+			uint16_t	rsv;
+
+			bool operator == (const state_t& t) const noexcept {
+				return fore == t.fore && back == t.back && stipple == t.stipple && tex_form == t.tex_form
+					&& clip == t.clip && tex == t.tex && tex_w == t.tex_w && tex_h == t.tex_h
+					&& fill == t.fill && pdir == t.pdir;
+			}
+		};
+
+		struct cmd_t {
+			state_t		st;
+			area_t		box;	// 描画範囲（重なりの判定）
+			int32_t		p[8];
+			uint32_t	flag;
+			int16_t		pen;
+			CMD			type;
+			uint8_t		rsv;
+		};
+
+		cmd_t*		cmd_;
+		uint32_t	max_;
+		uint32_t	num_;
+		uint32_t	hash_;
+		bool		over_;
+
+		// 保存した d2 ディスプレイ・リスト（フレームバッファ毎）
+		const void*	fb_[2];
+		void*		dump_[2];
+		int32_t		dump_size_[2];
+		uint32_t	dump_idx_;
+
+		const void*	comp_fb_;	// 保存待ち
+		drw2d_list_base*	next_;
+
+		bool add_(const cmd_t& c) noexcept
+		{
+			if(num_ >= max_) {
+				over_ = true;
+				return false;
+			}
+			cmd_[num_] = c;
+			++num_;
+			return true;
+		}
+
+		// 前後関係を保ったまま、同じステートの描画を隣り合わせにする
+		void batch_() noexcept
+		{
+			for(uint32_t i = 1; i < num_; ++i) {
+				if(cmd_[i].type == CMD::MOVE || cmd_[i].type == CMD::CLEAR) continue;
+				uint32_t j = i;
+				while(j > 0) {
+					const auto& q = cmd_[j - 1];
+					if(q.st == cmd_[i].st) break;
+					if(q.box.is_overlap(cmd_[i].box)) {
+						j = 0;
+						break;
+					}
+					--j;
+				}
+				if(j == 0 || j == i) continue;
+				auto c = cmd_[i];
+				std::memmove(&cmd_[j + 1], &cmd_[j], (i - j) * sizeof(cmd_t));
+				cmd_[j] = c;
+			}
+		}
+
+		uint32_t make_hash_() const noexcept
+		{
+			uint32_t h = 0x811c'9dc5;
+			auto p = reinterpret_cast<const uint8_t*>(cmd_);
+			for(uint32_t i = 0; i < (num_ * sizeof(cmd_t)); ++i) {
+				h = (h ^ p[i]) * 0x0100'0193;
+			}
+			return h;
+		}
+
+		int32_t find_(const void* fb) const noexcept
+		{
+			for(uint32_t i = 0; i < 2; ++i) {
+				if(dump_[i] != nullptr && fb_[i] == fb) return i;
+			}
+			return -1;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクタ
+			@param[in]	cmd		コマンド・バッファ
+			@param[in]	max		コマンド・バッファの大きさ
+		*/
+		//-----------------------------------------------------------------//
+		drw2d_list_base(void* cmd, uint32_t max) noexcept :
+			cmd_(static_cast<cmd_t*>(cmd)), max_(max), num_(0), hash_(0), over_(false),
+			fb_{ nullptr }, dump_{ nullptr }, dump_size_{ 0 }, dump_idx_(0),
+			comp_fb_(nullptr), next_(nullptr)
+		{ }
+
+		drw2d_list_base(const drw2d_list_base&) = delete;
+		drw2d_list_base& operator = (const drw2d_list_base&) = delete;
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	記録したコマンド数を取得
+			@return コマンド数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t size() const noexcept { return num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	記録があふれたか検査
+			@return あふれた場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool is_overflow() const noexcept { return over_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	d2 ディスプレイ・リストとして保存されているか
+			@return 保存されている場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool is_cached() const noexcept { return dump_[0] != nullptr || dump_[1] != nullptr; }
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  DRW2D 表示リスト・クラス
+		@param[in]	CMD_MAX	記録できるコマンドの最大数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t CMD_MAX>
+	class drw2d_list : public drw2d_list_base {
+
+		cmd_t	buff_[CMD_MAX];
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクタ
+		*/
+		//-----------------------------------------------------------------//
+		drw2d_list() noexcept : drw2d_list_base(buff_, CMD_MAX) { }
+	};
+
+
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  DRW2D 制御／マネージャー・クラス
@@ -45,8 +264,39 @@ namespace device {
 		typedef GLC glc_type;
 		typedef FONT font_type;
 
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  フレームの統計（sync_frame で更新、サイクルは DRW2D クロック）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct frame_t {
+			uint32_t	busy;	///< DRW2D が描画していたサイクル
+			uint32_t	total;	///< フレームの全サイクル
+			uint32_t	wait;	///< CPU が描画の終了を待ったサイクル
+			uint32_t	cmds;	///< d2 に発行したコマンド数
+			uint32_t	lists;	///< 保存したリストで描画した数
+		};
+
 	private:
 		typedef device::DRW2D DRW;
+		typedef drw2d_list_base::CMD CMD;
+		typedef drw2d_list_base::FILL FILL;
+		typedef drw2d_list_base::area_t area_t;
+		typedef drw2d_list_base::state_t state_t;
+		typedef drw2d_list_base::cmd_t cmd_t;
+
+		// 未設定のステート
+		enum DIRTY : uint8_t {
+			FORE    = 0x01,
+			BACK    = 0x02,
+			CLIP    = 0x04,
+			MODE    = 0x08,
+			PATTERN = 0x10,
+			TEXTURE = 0x20,
+			CLUT    = 0x40,
+			BLIT    = 0x80,
+		};
 
 		GLC&		glc_;
 
@@ -65,15 +315,35 @@ namespace device {
 		typedef utils::fixed_stack<vtx::srect, CLIP_STACK_SIZE> CLIP_STACK;
 		CLIP_STACK	clip_stack_;
 		int16_t		pen_size_;
-		bool		set_fore_color_;
-		bool		set_back_color_;
-		bool		set_clip_;
 		bool		start_frame_enable_;
+		bool		list_enable_;
+		bool		perf_enable_;
 
 		int32_t		last_error_;
 
 		d2_color	clut_[256];
 
+		const void*	tex_img_;
+		int16_t		tex_w_;
+		int16_t		tex_h_;
+		uint32_t	tex_form_;
+
+		state_t		cur_;		// d2 に設定済みのステート
+		uint8_t		dirty_;
+		const void*	blit_src_;
+		uint32_t	blit_mode_;
+		int32_t		blit_pitch_;
+		int32_t		blit_w_;
+		int32_t		blit_h_;
+		const void*	bind_fb_;	// d2_framebuffer で設定したフレームバッファ
+
+		drw2d_list_base*	rec_;	// 記録中のリスト
+		drw2d_list_base*	comp_;	// d2 ディスプレイ・リストへの変換待ち
+
+		frame_t		frame_;
+		uint32_t	cmds_;
+		uint32_t	lists_;
+
 
 		static uint32_t get_mode_()
 		{
@@ -94,45 +364,284 @@ namespace device {
 		}
 
 
-		void setup_(bool texture)
+		static area_t make_area_(const vtx::srect& r) noexcept
+		{
+			return area_t { r.org.x, r.org.y, static_cast<int16_t>(r.end_x()), static_cast<int16_t>(r.end_y()) };
+		}
+
+
+		// 1/16 ピクセルの頂点列から描画範囲を求める
+		static area_t bound_(const int32_t* p, uint32_t n, int32_t ext) noexcept
+		{
+			int32_t x0 = p[0];
+			int32_t y0 = p[1];
+			int32_t x1 = x0;
+			int32_t y1 = y0;
+			for(uint32_t i = 1; i < n; ++i) {
+				auto x = p[i * 2 + 0];
+				auto y = p[i * 2 + 1];
+				if(x < x0) x0 = x; else if(x > x1) x1 = x;
+				if(y < y0) y0 = y; else if(y > y1) y1 = y;
+			}
+			return area_t { static_cast<int16_t>((x0 - ext) >> 4), static_cast<int16_t>((y0 - ext) >> 4),
+				static_cast<int16_t>(((x1 + ext) >> 4) + 1), static_cast<int16_t>(((y1 + ext) >> 4) + 1) };
+		}
+
+
+		static area_t screen_() noexcept
+		{
+			return area_t { 0, 0, static_cast<int16_t>(GLC::width), static_cast<int16_t>(GLC::height) };
+		}
+
+
+		state_t make_state_(FILL fill, uint8_t pdir = 0) const noexcept
+		{
+			state_t t { };
+			t.fore = fore_color_.rgba8.rgba;
+			t.back = back_color_.rgba8.rgba;
+			t.stipple = fill == FILL::PATTERN ? stipple_ : 0xffffffff;
+			t.clip = make_area_(clip_);
+			if(fill == FILL::TEXTURE) {
+				t.tex = tex_img_;
+				t.tex_w = tex_w_;
+				t.tex_h = tex_h_;
+				t.tex_form = tex_form_;
+			}
+			t.fill = fill;
+			t.pdir = pdir;
+			return t;
+		}
+
+
+		FILL line_fill_() const noexcept { return stipple_ != 0xffffffff ? FILL::PATTERN : FILL::COLOR; }
+
+
+		void apply_clip_(const area_t& clip) noexcept
 		{
-			if(!set_fore_color_) {
-				d2_setcolor(d2_, 0, fore_color_.rgba8.rgba);
-				set_fore_color_ = true;
+			if((dirty_ & DIRTY::CLIP) != 0 || cur_.clip != clip) {
+				d2_cliprect(d2_, clip.x0, clip.y0, clip.x1, clip.y1);
+				cur_.clip = clip;
+				dirty_ &= ~DIRTY::CLIP;
 			}
-			if(!set_back_color_) {
-				d2_setcolor(d2_, 1, back_color_.rgba8.rgba);
-				set_back_color_ = true;
+		}
+
+
+		// 変化したステートだけ設定する
+		void apply_(const state_t& t) noexcept
+		{
+			if((dirty_ & DIRTY::FORE) != 0 || cur_.fore != t.fore) {
+				d2_setcolor(d2_, 0, t.fore);
+				cur_.fore = t.fore;
+				dirty_ &= ~DIRTY::FORE;
 			}
-			if(!set_clip_) {
-				d2_cliprect(d2_, clip_.org.x, clip_.org.y, clip_.end_x(), clip_.end_y());
-				set_clip_ = true;
+			if((dirty_ & DIRTY::BACK) != 0 || cur_.back != t.back) {
+				d2_setcolor(d2_, 1, t.back);
+				cur_.back = t.back;
+				dirty_ &= ~DIRTY::BACK;
 			}
-			if(texture) {
-				d2_setfillmode(d2_, d2_fm_texture);
-			} else {
-				d2_setfillmode(d2_, d2_fm_color);
+			apply_clip_(t.clip);
+			if(t.fill == FILL::PATTERN) {
+				if((dirty_ & DIRTY::PATTERN) != 0 || cur_.stipple != t.stipple || cur_.pdir != t.pdir) {
+					d2_setpatternsize(d2_, 8);
+					if(t.pdir == 0) {
+						d2_setpatternparam(d2_, 0, 0, 128, 0);
+					} else {
+						d2_setpatternparam(d2_, 0, 0, 0, 128);
+					}
+					d2_setpattern(d2_, t.stipple);
+					cur_.stipple = t.stipple;
+					cur_.pdir = t.pdir;
+					dirty_ &= ~DIRTY::PATTERN;
+				}
+			} else if(t.fill == FILL::TEXTURE) {
+				if((dirty_ & DIRTY::TEXTURE) != 0 || cur_.tex != t.tex || cur_.tex_w != t.tex_w
+					|| cur_.tex_h != t.tex_h || cur_.tex_form != t.tex_form) {
+					d2_settexture(d2_, const_cast<void*>(t.tex), t.tex_w, t.tex_w, t.tex_h, t.tex_form);
+					d2_settexturemode(d2_, d2_tm_wrapu | d2_tm_wrapv | d2_tm_filter);
+					d2_settexturemapping(d2_, 0, 0, 0, 0, 65536 / 64, 0, 0, 65536 / 64);
+					cur_.tex = t.tex;
+					cur_.tex_w = t.tex_w;
+					cur_.tex_h = t.tex_h;
+					cur_.tex_form = t.tex_form;
+					dirty_ &= ~DIRTY::TEXTURE;
+				}
+			}
+			if((dirty_ & DIRTY::MODE) != 0 || cur_.fill != t.fill) {
+				switch(t.fill) {
+				case FILL::TEXTURE:
+					d2_setfillmode(d2_, d2_fm_texture);
+					break;
+				case FILL::PATTERN:
+					d2_setfillmode(d2_, d2_fm_pattern);
+					break;
+				default:
+					d2_setfillmode(d2_, d2_fm_color);
+					break;
+				}
+				cur_.fill = t.fill;
+				dirty_ &= ~DIRTY::MODE;
+			}
+		}
+
+
+		void blit_(const cmd_t& c) noexcept
+		{
+			const auto& t = c.st;
+			apply_clip_(t.clip);
+			if(c.p[5] != 0) {  // 1 ビット・イメージは、CLUT の 0、1 にカラーを設定
+				auto c0 = t.back;
+				if(c.p[6] == 0) c0 &= 0xffffff;
+				auto c1 = t.fore;
+				if((dirty_ & DIRTY::CLUT) != 0 || clut_[0] != c0 || clut_[1] != c1) {
+					clut_[0] = c0;
+					clut_[1] = c1;
+					d2_settexclut_part(d2_, clut_, 0, 2);
+					dirty_ &= ~DIRTY::CLUT;
+				}
+			}
+			// ソースが同じなら設定を省略（フォントの描画など）
+			if((dirty_ & DIRTY::BLIT) != 0 || blit_src_ != t.tex || blit_mode_ != t.tex_form
+				|| blit_pitch_ != c.p[0] || blit_w_ != c.p[1] || blit_h_ != c.p[2]) {
+				d2_setblitsrc(d2_, const_cast<void*>(t.tex), c.p[0], c.p[1], c.p[2], t.tex_form);
+				blit_src_ = t.tex;
+				blit_mode_ = t.tex_form;
+				blit_pitch_ = c.p[0];
+				blit_w_ = c.p[1];
+				blit_h_ = c.p[2];
+				dirty_ &= ~DIRTY::BLIT;
+			}
+			last_error_ = d2_blitcopy(d2_, c.p[1], c.p[2],
+				0, 0, c.p[1] * 16, c.p[2] * 16, c.p[3] * 16, c.p[4] * 16, c.flag);
+		}
+
+
+		void emit_(const cmd_t& c) noexcept
+		{
+			const auto* p = c.p;
+			switch(c.type) {
+			case CMD::BOX:
+				apply_(c.st);
+				last_error_ = d2_renderbox(d2_, p[0], p[1], p[2], p[3]);
+				break;
+			case CMD::LINE:
+				apply_(c.st);
+				last_error_ = d2_renderline(d2_, p[0], p[1], p[2], p[3], c.pen, c.flag);
+				break;
+			case CMD::CIRCLE:
+				apply_(c.st);
+				last_error_ = d2_rendercircle(d2_, p[0], p[1], p[2], p[3]);
+				break;
+			case CMD::WEDGE:
+				apply_(c.st);
+				last_error_ = d2_renderwedge(d2_, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], c.flag);
+				break;
+			case CMD::TRI:
+				apply_(c.st);
+				last_error_ = d2_rendertri(d2_, p[0], p[1], p[2], p[3], p[4], p[5], c.flag);
+				break;
+			case CMD::QUAD:
+				apply_(c.st);
+				last_error_ = d2_renderquad(d2_, p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], c.flag);
+				break;
+			case CMD::BLIT:
+				blit_(c);
+				break;
+			case CMD::MOVE:
+				last_error_ = d2_utility_fbblitcopy(d2_, p[0], p[1], p[2], p[3], p[4], p[5], c.flag);
+				dirty_ |= DIRTY::BLIT | DIRTY::CLIP;
+				break;
+			case CMD::CLEAR:
+				last_error_ = d2_clear(d2_, static_cast<d2_color>(p[0]));
+				break;
+			default:
+				break;
 			}
 		}
 
 
-		void setup_stipple_(const vtx::spos& d)
+		// 記録中ならリストに追加、そうでなければ描画
+		bool put_(const cmd_t& c) noexcept
 		{
-			if(stipple_ != 0xffffffff) {
-				d2_setpatternsize(d2_, 8);
-//				d2_setpatternalpha(d2_, 0, 255);
-//				d2_setpatternalpha(d2_, 1, 255);
-				d2_setpatternparam(d2_, 0, 0, d.x, d.y);
-				d2_setpattern(d2_, stipple_);
-  				d2_setfillmode(d2_, d2_fm_pattern);
+			if(rec_ != nullptr) {
+				return rec_->add_(c);
 			}
+			emit_(c);
+			++cmds_;
+			return last_error_ == D2_OK;
+		}
+
+
+		bool line_(FILL fill, uint8_t pdir, int32_t x0, int32_t y0, int32_t x1, int32_t y1) noexcept
+		{
+			cmd_t c { };
+			c.st = make_state_(fill, pdir);
+			c.type = CMD::LINE;
+			c.p[0] = x0;
+			c.p[1] = y0;
+			c.p[2] = x1;
+			c.p[3] = y1;
+			c.pen = pen_size_;
+			c.flag = d2_le_exclude_none;
+			c.box = bound_(c.p, 2, pen_size_);
+			return put_(c);
+		}
+
+
+		bool box_(int16_t x, int16_t y, int16_t w, int16_t h) noexcept
+		{
+			cmd_t c { };
+			c.st = make_state_(FILL::COLOR);
+			c.type = CMD::BOX;
+			c.p[0] = x << 4;
+			c.p[1] = y << 4;
+			c.p[2] = w << 4;
+			c.p[3] = h << 4;
+			c.box = area_t { x, y, static_cast<int16_t>(x + w), static_cast<int16_t>(y + h) };
+			return put_(c);
 		}
 
 
 		void arc_(const vtx::spos& cen, int16_t rad, int16_t w, const vtx::spos& n1, const vtx::spos& n2, uint32_t f = 0)
 		{
-			d2_renderwedge(d2_, cen.x << 4, cen.y << 4, rad << 4, w,
-				n1.x << 16, n1.y << 16, n2.x << 16, n2.y << 16, f);
+			cmd_t c { };
+			c.st = make_state_(FILL::COLOR);
+			c.type = CMD::WEDGE;
+			c.p[0] = cen.x << 4;
+			c.p[1] = cen.y << 4;
+			c.p[2] = rad << 4;
+			c.p[3] = w;
+			c.p[4] = n1.x << 16;
+			c.p[5] = n1.y << 16;
+			c.p[6] = n2.x << 16;
+			c.p[7] = n2.y << 16;
+			c.flag = f;
+			c.box = bound_(c.p, 1, (rad + 1) << 4);
+			put_(c);
+		}
+
+
+		void bitmap_(const vtx::spos& pos, const void* src, const vtx::spos& ssz, int16_t pitch, d2_u32 mode,
+			uint32_t flag, bool mono, bool back) noexcept
+		{
+			cmd_t c { };
+			c.st = make_state_(FILL::COLOR);
+			if(!mono) {  // CLUT はカラーに依存しない
+				c.st.fore = 0;
+				c.st.back = 0;
+			}
+			c.st.tex = src;
+			c.st.tex_form = mode;
+			c.type = CMD::BLIT;
+			c.p[0] = pitch;
+			c.p[1] = ssz.x;
+			c.p[2] = ssz.y;
+			c.p[3] = pos.x;
+			c.p[4] = pos.y;
+			c.p[5] = mono;
+			c.p[6] = back;
+			c.flag = flag;
+			c.box = area_t { pos.x, pos.y, static_cast<int16_t>(pos.x + ssz.x), static_cast<int16_t>(pos.y + ssz.y) };
+			put_(c);
 		}
 
 
@@ -145,8 +654,14 @@ namespace device {
 
 			auto xs = GLC::width;
 			auto ys = GLC::height;
-			d2_framebuffer(d2_, fb_, xs, xs, ys, get_mode_());
+			// フレームバッファが変わらなければ、再設定しない
+			if(bind_fb_ != fb_) {
+				d2_framebuffer(d2_, fb_, xs, xs, ys, get_mode_());
+				bind_fb_ = fb_;
+			}
 			d2_cliprect(d2_, 0, 0, xs, ys);
+			cur_.clip = screen_();
+			dirty_ &= ~DIRTY::CLIP;
 //			d2_settexclut(d2_, clut_);
 		}
 
@@ -162,14 +677,63 @@ namespace device {
 
 		void draw_bitmapn_(const vtx::spos& pos, const void* src, const vtx::spos& ssz, bool alpha, int16_t pitch, d2_u32 mode) noexcept
 		{
-			int16_t w = ssz.x;
-			int16_t h = ssz.y;
-			if(pitch == 0) pitch = w;
-			d2_setblitsrc(d2_, src, pitch, w, h, mode | d2_mode_clut);
+			if(pitch == 0) pitch = ssz.x;
 			auto copyflag = d2_bf_filter;
 			if(alpha) copyflag |= d2_bf_usealpha;
-			d2_blitcopy(d2_, w, h,
-				0, 0, w * 16, h * 16, pos.x * 16, pos.y * 16, copyflag);
+			bitmap_(pos, src, ssz, pitch, mode | d2_mode_clut, copyflag, false, false);
+		}
+
+
+		void free_dump_(drw2d_list_base& list) noexcept
+		{
+			for(uint32_t i = 0; i < 2; ++i) {
+				if(list.dump_[i] != nullptr) {
+					d2_freedumpedbuffer(d2_, list.dump_[i]);
+					list.dump_[i] = nullptr;
+				}
+				list.fb_[i] = nullptr;
+				list.dump_size_[i] = 0;
+			}
+		}
+
+
+		// 描画したリストを d2 ディスプレイ・リストに変換（DRW2D が停止している時に行う）
+		void compile_lists_() noexcept
+		{
+			if(comp_ == nullptr) return;
+
+			while(comp_ != nullptr) {
+				auto& l = *comp_;
+				comp_ = l.next_;
+				l.next_ = nullptr;
+				auto fb = l.comp_fb_;
+				l.comp_fb_ = nullptr;
+				if(l.num_ == 0 || l.find_(fb) >= 0) continue;
+
+				auto rb = d2_newrenderbuffer(d2_, 32, 32);
+				if(rb == nullptr) continue;
+				d2_selectrenderbuffer(d2_, rb);
+				d2_framebuffer(d2_, const_cast<void*>(fb), GLC::width, GLC::width, GLC::height, get_mode_());
+				dirty_ = 0xff;  // リストの中で全てのステートを設定する
+				for(uint32_t i = 0; i < l.num_; ++i) {
+					emit_(l.cmd_[i]);
+				}
+				void* data = nullptr;
+				d2_s32 size = 0;
+				d2_dumprenderbuffer(d2_, rb, &data, &size);
+				d2_selectrenderbuffer(d2_, nullptr);
+				d2_freerenderbuffer(d2_, rb);
+				if(data != nullptr) {
+					auto n = l.dump_idx_;
+					if(l.dump_[n] != nullptr) d2_freedumpedbuffer(d2_, l.dump_[n]);
+					l.fb_[n] = fb;
+					l.dump_[n] = data;
+					l.dump_size_[n] = size;
+					l.dump_idx_ = n ^ 1;
+				}
+			}
+			bind_fb_ = nullptr;
+			dirty_ = 0xff;
 		}
 
 	public:
@@ -187,10 +751,14 @@ namespace device {
 			fore_color_(DEF_COLOR::White), back_color_(DEF_COLOR::Black),
 			clip_(0, 0, GLC::width, GLC::height), clip_stack_(),
 			pen_size_(16),
-			set_fore_color_(false), set_back_color_(false),
-			set_clip_(false), start_frame_enable_(false),
+			start_frame_enable_(false), list_enable_(false), perf_enable_(false),
 			last_error_(D2_OK),
-			clut_{ 0 }
+			clut_{ 0 },
+			tex_img_(nullptr), tex_w_(0), tex_h_(0), tex_form_(0),
+			cur_(), dirty_(0xff),
+			blit_src_(nullptr), blit_mode_(0), blit_pitch_(0), blit_w_(0), blit_h_(0),
+			bind_fb_(nullptr), rec_(nullptr), comp_(nullptr),
+			frame_{ }, cmds_(0), lists_(0)
 		{ }
 
 
@@ -234,20 +802,37 @@ namespace device {
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	開始
+			@brief	開始 @n
+					list を有効にすると、d2 ディスプレイ・リストを保存できるように、 @n
+					d2_df_no_dwclear、d2_df_no_registercaching でデバイスを開く。
 			@param[in]	lvl		割り込みレベル
+			@param[in]	list	表示リストを d2 ディスプレイ・リストとして保存する場合「true」
 			@return 成功なら「true」
 		*/
 		//-----------------------------------------------------------------//
-		bool start(ICU::LEVEL lvl) noexcept
+		bool start(ICU::LEVEL lvl, bool list = false) noexcept
 		{
 			// DRW2D power management
 			power_mgr::turn(DRW::PERIPHERAL);
 
 			// initialization Dave2D
-			d2_ = d2_opendevice(0);
+			d2_u32 dev_flag = 0;
+			if(list) dev_flag = d2_df_no_dwclear | d2_df_no_registercaching;
+			d2_ = d2_opendevice(dev_flag);
 			uint32_t init_flag = 0;
 			d2_inithw(d2_, init_flag);
+			list_enable_ = list;
+			dirty_ = 0xff;
+			bind_fb_ = nullptr;
+
+			// フレーム毎の DRW2D ビジー・サイクルと全サイクル
+			perf_enable_ = DRW::HWVER.PERFCNT();
+			if(perf_enable_) {
+				d2_setperfcountevent(d2_, 0, d2_pc_davecycles);
+				d2_setperfcountevent(d2_, 1, d2_pc_clkcycles);
+				d2_setperfcountvalue(d2_, 0, 0);
+				d2_setperfcountvalue(d2_, 1, 0);
+			}
 
 			icu_mgr::install_group_task(DRW::IVEC, drw_int_isr);
 			icu_mgr::set_level(ICU::VECTOR::GROUPAL1, lvl);
@@ -265,7 +850,9 @@ namespace device {
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	フレームの同期
+			@brief	フレームの同期 @n
+					前のフレームの描画終了を待ち、このフレームで記録した描画を開始する。 @n
+					DRW2D がこのフレームを描画している間に、次のフレームを記録できる。
 			@param[in]	vsync	垂直同期を行わない場合「false」	
 		*/
 		//-----------------------------------------------------------------//
@@ -274,12 +861,48 @@ namespace device {
 //			if(d2_ == nullptr) {
 //				start(ICU::LEVEL::_2);
 //			}
+			uint32_t t0 = 0;
+			if(perf_enable_) t0 = d2_getperfcountvalue(d2_, 1);
 			end_frame_();
+			if(perf_enable_) {
+				auto t1 = d2_getperfcountvalue(d2_, 1);
+				frame_.busy = d2_getperfcountvalue(d2_, 0);
+				frame_.total = t1;
+				frame_.wait = t1 - t0;
+				d2_setperfcountvalue(d2_, 0, 0);
+				d2_setperfcountvalue(d2_, 1, 0);
+			}
+			frame_.cmds = cmds_;
+			frame_.lists = lists_;
+			cmds_ = 0;
+			lists_ = 0;
+			compile_lists_();
 			if(vsync) glc_.sync_vpos();
 			start_frame_();
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	DRW2D が描画中か検査（sync_frame の前に他の処理を行う場合など）
+			@return 描画中なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool is_frame_busy() const noexcept
+		{
+			return DRW::STATUS.DLSTACT() || DRW::STATUS.BSYENUM() || DRW::STATUS.BSYWR();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	前のフレームの統計を取得
+			@return フレームの統計
+		*/
+		//-----------------------------------------------------------------//
+		const frame_t& get_frame_stat() const noexcept { return frame_; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	ダブルバッファが有効か検査
@@ -345,7 +968,6 @@ namespace device {
 		void set_fore_color(const COLOR& color) noexcept
 		{
 			fore_color_ = color;
-			set_fore_color_ = false;
 		}
 
 
@@ -367,7 +989,6 @@ namespace device {
 		void set_back_color(const COLOR& color) noexcept
 		{
 			back_color_ = color;
-			set_back_color_ = false;
 		}
 
 
@@ -380,8 +1001,7 @@ namespace device {
 		{
 			std::swap(fore_color_, back_color_);
 			std::swap(clut_[0], clut_[1]);
-			set_fore_color_ = false;
-			set_back_color_ = false;
+			dirty_ |= DIRTY::CLUT;
 		}
 
 
@@ -394,7 +1014,6 @@ namespace device {
 		void set_clip(const vtx::srect& clip) noexcept
 		{
 			clip_ = clip;
-			set_clip_ = false;
 		}
 
 
@@ -511,11 +1130,7 @@ namespace device {
         //-----------------------------------------------------------------//
         bool line_h(int16_t y, int16_t x, int16_t w) noexcept
 		{
-			setup_(false);
-			setup_stipple_(vtx::spos(128, 0));
-			last_error_ = d2_renderline(d2_, x << 4, y << 4, (x + w - 1) << 4, y << 4,
-				pen_size_, d2_le_exclude_none);
-			return last_error_ == D2_OK;
+			return line_(line_fill_(), 0, x << 4, y << 4, (x + w - 1) << 4, y << 4);
 		}
 
 
@@ -530,11 +1145,7 @@ namespace device {
         //-----------------------------------------------------------------//
         bool line_v(int16_t x, int16_t y, int16_t h) noexcept
 		{
-			setup_(false);
-			setup_stipple_(vtx::spos(0, 128));
-			last_error_ = d2_renderline(d2_, x << 4, y << 4, x << 4, (y + h - 1) << 4,
-				pen_size_, d2_le_exclude_none);
-			return last_error_ == D2_OK;
+			return line_(line_fill_(), 1, x << 4, y << 4, x << 4, (y + h - 1) << 4);
 		}
 
 
@@ -547,10 +1158,7 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool fill_box(const vtx::srect& rect) noexcept
 		{
-			setup_(false);
-			last_error_ = d2_renderbox(d2_, rect.org.x << 4, rect.org.y << 4,
-				rect.size.x << 4, rect.size.y << 4);
-			return last_error_ == D2_OK;
+			return box_(rect.org.x, rect.org.y, rect.size.x, rect.size.y);
 		}
 
 
@@ -563,8 +1171,11 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool clear(const COLOR& col) noexcept
 		{
-			last_error_ = d2_clear(d2_, col.rgba8.rgba);
-			return last_error_ == D2_OK;
+			cmd_t c { };
+			c.type = CMD::CLEAR;
+			c.p[0] = col.rgba8.rgba;
+			c.box = screen_();
+			return put_(c);
 		}
 
 
@@ -578,11 +1189,7 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool line_d(const vtx::spos& org, const vtx::spos& end) noexcept
 		{
-			setup_(false);
-			// setup_stipple_();
-			last_error_ = d2_renderline(d2_, org.x, org.y, end.x, end.y,
-				pen_size_, d2_le_exclude_none);
-			return last_error_ == D2_OK;
+			return line_(FILL::COLOR, 0, org.x, org.y, end.x, end.y);
 		}
 
 
@@ -596,11 +1203,7 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool line(const vtx::spos& org, const vtx::spos& end) noexcept
 		{
-			setup_(false);
-			// setup_stipple_();
-			last_error_ = d2_renderline(d2_, org.x << 4, org.y << 4, end.x << 4, end.y << 4,
-				pen_size_, d2_le_exclude_none);
-			return last_error_ == D2_OK;
+			return line_(FILL::COLOR, 0, org.x << 4, org.y << 4, end.x << 4, end.y << 4);
 		}
 
 
@@ -615,10 +1218,18 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool triangle_d(const vtx::spos& p0, const vtx::spos& p1, const vtx::spos& p2, bool texture = false) noexcept
 		{
-			setup_(texture);
-			last_error_ = d2_rendertri(d2_, p0.x, p0.y, p1.x, p1.y, p2.x, p2.y,
-				d2_le_exclude_none);
-			return last_error_ == D2_OK;
+			cmd_t c { };
+			c.st = make_state_(texture ? FILL::TEXTURE : FILL::COLOR);
+			c.type = CMD::TRI;
+			c.p[0] = p0.x;
+			c.p[1] = p0.y;
+			c.p[2] = p1.x;
+			c.p[3] = p1.y;
+			c.p[4] = p2.x;
+			c.p[5] = p2.y;
+			c.flag = d2_le_exclude_none;
+			c.box = bound_(c.p, 3, 16);
+			return put_(c);
 		}
 
 
@@ -634,10 +1245,20 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool quad_d(const vtx::spos& p0, const vtx::spos& p1, const vtx::spos& p2, const vtx::spos& p3, bool texture = false) noexcept
 		{
-			setup_(texture);
-			last_error_ = d2_renderquad(d2_, p0.x, p0.y, p1.x, p1.y, p2.x, p2.y, p3.x, p3.y,
-				d2_le_exclude_none);
-			return last_error_ == D2_OK;
+			cmd_t c { };
+			c.st = make_state_(texture ? FILL::TEXTURE : FILL::COLOR);
+			c.type = CMD::QUAD;
+			c.p[0] = p0.x;
+			c.p[1] = p0.y;
+			c.p[2] = p1.x;
+			c.p[3] = p1.y;
+			c.p[4] = p2.x;
+			c.p[5] = p2.y;
+			c.p[6] = p3.x;
+			c.p[7] = p3.y;
+			c.flag = d2_le_exclude_none;
+			c.box = bound_(c.p, 4, 16);
+			return put_(c);
 		}
 
 
@@ -706,11 +1327,10 @@ namespace device {
             }
             auto cen = rect.org + rad;
 			auto len = rect.size - (rad * 2);
-			setup_(false);
 			auto yo = rect.org.y;
 			auto yl = len.y;
 			if(up) {
-				d2_renderbox(d2_, cen.x << 4, rect.org.y << 4, len.x << 4, rad << 4);
+				box_(cen.x, rect.org.y, len.x, rad);
 				yo += rad;
 			} else {
 				yl += rad;
@@ -718,10 +1338,10 @@ namespace device {
 			if(!dn) {
 				yl += rad;
 			}
-			d2_renderbox(d2_, rect.org.x << 4, yo << 4, rect.size.x << 4, yl << 4);
+			box_(rect.org.x, yo, rect.size.x, yl);
 			auto end = rect.end() - rad - 1;
 			if(dn) {
-				d2_renderbox(d2_, cen.x << 4, (end.y + 1) << 4, len.x << 4, rad << 4);
+				box_(cen.x, end.y + 1, len.x, rad);
 			}
 
 //			uint32_t f = d2_edge0_shared | d2_edge1_shared;
@@ -749,9 +1369,15 @@ namespace device {
 		//-----------------------------------------------------------------//
 		bool circle(const vtx::spos& cen, int16_t rad, int16_t w = 1) noexcept
 		{
-			setup_(false);
-			last_error_ = d2_rendercircle(d2_, cen.x << 4, cen.y << 4, rad << 4, w << 4);
-			return last_error_ == D2_OK;
+			cmd_t c { };
+			c.st = make_state_(FILL::COLOR);
+			c.type = CMD::CIRCLE;
+			c.p[0] = cen.x << 4;
+			c.p[1] = cen.y << 4;
+			c.p[2] = rad << 4;
+			c.p[3] = w << 4;
+			c.box = bound_(c.p, 1, (rad + w + 1) << 4);
+			return put_(c);
 		}
 
 
@@ -765,9 +1391,7 @@ namespace device {
         //-----------------------------------------------------------------//
         bool fill_circle(const vtx::spos& cen, int16_t rad) noexcept
 		{
-			setup_(false);
-			last_error_ = d2_rendercircle(d2_, cen.x << 4, cen.y << 4, rad << 4, 0);
-			return last_error_ == D2_OK;
+			return circle(cen, rad, 0);
 		}
 
 
@@ -810,8 +1434,17 @@ namespace device {
 		//-----------------------------------------------------------------//
 		void move(const vtx::srect& src, const vtx::spos& dst) noexcept
 		{
-			d2_utility_fbblitcopy(d2_, src.size.x, src.size.y, src.org.x, src.org.y, dst.x, dst.y,
-				d2_bf_filter);
+			cmd_t c { };
+			c.type = CMD::MOVE;
+			c.p[0] = src.size.x;
+			c.p[1] = src.size.y;
+			c.p[2] = src.org.x;
+			c.p[3] = src.org.y;
+			c.p[4] = dst.x;
+			c.p[5] = dst.y;
+			c.flag = d2_bf_filter;
+			c.box = screen_();
+			put_(c);
 		}
 
 
@@ -845,30 +1478,11 @@ namespace device {
 		noexcept {
 			if(img == nullptr) return;
 
-			const uint8_t* src = static_cast<const uint8_t*>(img);
-			int16_t w = ssz.x;
-			int16_t h = ssz.y;
-
-			if(!set_clip_) {
-				d2_cliprect(d2_, clip_.org.x, clip_.org.y, clip_.end_x(), clip_.end_y());
-				set_clip_ = true;
-			}
-
-			auto c0 = clut_[0];
-			auto c1 = clut_[1];
-			clut_[0] = back_color_.rgba8.rgba;
 			auto copyflag = d2_bf_filter;
 			if(!back) {
-				clut_[0] &= 0xffffff;
 				copyflag |= d2_bf_usealpha;
 			}
-			clut_[1] = fore_color_.rgba8.rgba;
-			if(c0 != clut_[0] || c1 != clut_[1]) {
-				d2_settexclut_part(d2_, clut_, 0, 2);
-			}
-			d2_setblitsrc(d2_, src, w, w, h, d2_mode_i1 | d2_mode_clut);
-			d2_blitcopy(d2_, w, h,
-				0, 0, w * 16, h * 16, pos.x * 16, pos.y * 16, copyflag);
+			bitmap_(pos, img, ssz, ssz.x, d2_mode_i1 | d2_mode_clut, copyflag, true, back);
 		}
 
 
@@ -1100,22 +1714,121 @@ namespace device {
 		//-----------------------------------------------------------------//
 		void set_texture(const void* image, const vtx::spos& size, uint32_t form)
 		{
-			d2_settexture(d2_, image, size.x, size.x, size.y, form);
+			// テクスチャーを使う描画の時に設定する
+			tex_img_ = image;
+			tex_w_ = size.x;
+			tex_h_ = size.y;
+			tex_form_ = form;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	描画フラッシュ
+		*/
+		//-----------------------------------------------------------------//
+		void flush() noexcept { d2_flushframe(d2_); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	表示リストの記録開始 @n
+					end_list までの描画は、表示リストに記録され、描画されない。
+			@param[in]	list	表示リスト
+			@return 記録中の場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool begin_list(drw2d_list_base& list) noexcept
+		{
+			if(rec_ != nullptr) return false;
 
-			d2_settexturemode(d2_, d2_tm_wrapu | d2_tm_wrapv | d2_tm_filter);
+			list.num_ = 0;
+			list.over_ = false;
+			rec_ = &list;
+			return true;
+		}
 
-			d2_point x = 0;
-			d2_point y = 0;
-			d2_settexturemapping(d2_, x, y, 0, 0, 65536 / 64, 0, 0, 65536 / 64);
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	表示リストの記録終了 @n
+					内容が前の記録と同じなら、保存した d2 ディスプレイ・リストを使い続ける。
+			@param[in]	batch	同じステートの描画をまとめる場合「true」 @n
+								（重なる描画の前後関係は変えない）
+			@return 記録があふれた場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool end_list(bool batch = true) noexcept
+		{
+			if(rec_ == nullptr) return false;
+
+			auto& l = *rec_;
+			rec_ = nullptr;
+			if(batch) l.batch_();
+			auto h = l.make_hash_();
+			if(l.over_ || h != l.hash_) {
+				free_dump_(l);
+				l.hash_ = h;
+			}
+			return !l.over_;
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	描画フラッシュ
+			@brief	表示リストの描画 @n
+					このフレームバッファ用に保存した d2 ディスプレイ・リストがあれば @n
+					コピーするだけで描画する。無ければ記録から描画し、次の sync_frame @n
+					で d2 ディスプレイ・リストに変換する（start で list を有効にした場合）。
+			@param[in]	list	表示リスト
+			@return エラー無い場合「true」
 		*/
 		//-----------------------------------------------------------------//
-		void flush() noexcept { d2_flushframe(d2_); }
+		bool call_list(drw2d_list_base& list) noexcept
+		{
+			if(rec_ != nullptr) return false;
+
+			auto n = list.find_(fb_);
+			if(n >= 0) {
+				last_error_ = d2_adddlist(d2_, list.dump_[n], list.dump_size_[n], d2_al_copy);
+				dirty_ = 0xff;  // ハードウェアのステートが変わった
+				++lists_;
+				return last_error_ == D2_OK;
+			}
+			for(uint32_t i = 0; i < list.num_; ++i) {
+				emit_(list.cmd_[i]);
+			}
+			cmds_ += list.num_;
+			if(list_enable_ && !list.over_ && list.num_ > 0 && list.comp_fb_ == nullptr) {
+				list.comp_fb_ = fb_;
+				list.next_ = comp_;
+				comp_ = &list;
+			}
+			return last_error_ == D2_OK;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	表示リストの廃棄（保存した d2 ディスプレイ・リストを解放）
+			@param[in]	list	表示リスト
+		*/
+		//-----------------------------------------------------------------//
+		void free_list(drw2d_list_base& list) noexcept
+		{
+			drw2d_list_base** pp = &comp_;
+			while(*pp != nullptr) {
+				if(*pp == &list) {
+					*pp = list.next_;
+					break;
+				}
+				pp = &(*pp)->next_;
+			}
+			list.next_ = nullptr;
+			list.comp_fb_ = nullptr;
+			free_dump_(list);
+			list.num_ = 0;
+			list.hash_ = 0;
+		}
 	};
 }
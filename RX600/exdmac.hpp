@@ -10,7 +10,7 @@
 			EXDMACa: RX671 @n
 			EXDMACa: RX72N/RX72M 
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2018, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -352,6 +352,7 @@ namespace device {
 	struct exdmac0_t : public exdmac_core_t<base, per> {
 
 		static constexpr auto IVEC = ivec;
+		typedef exdmac_t COMMON;	///< EXDMAC0、EXDMAC1 共通定義（EDMAST など）
 
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
@@ -396,6 +397,7 @@ namespace device {
 	struct exdmaca0_t : public exdmac_core_t<base, per> {
 
 		static constexpr auto IVEC = ivec;
+		typedef exdmaca_t COMMON;	///< EXDMAC0、EXDMAC1 共通定義（EDMAST など）
 
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
@@ -441,6 +443,7 @@ namespace device {
 	struct exdmac1_t : public exdmac_core_t<base, per> {
 
 		static constexpr auto IVEC = ivec;
+		typedef exdmac_t COMMON;	///< EXDMAC0、EXDMAC1 共通定義（EDMAST など）
 
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
@@ -476,6 +479,7 @@ namespace device {
 	struct exdmaca1_t : public exdmac_core_t<base, per> {
 
 		static constexpr auto IVEC = ivec;
+		typedef exdmaca_t COMMON;	///< EXDMAC0、EXDMAC1 共通定義（EDMAST など）
 
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
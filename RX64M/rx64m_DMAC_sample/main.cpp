@@ -1,9 +1,11 @@
 //=====================================================================//
 /*! @file
     @brief  RX64M DMAC サンプル @n
+			device::dma_service（DMAC0、DMAC1、EXDMAC0）で、コピー、フィル、 @n
+			ディスクリプタ列（CHAIN）の転送を行い、完了コールバックを数える。 @n
 			・P07(176) ピンに赤色LED（VF:1.9V）を吸い込みで接続する @n
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2018 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -16,6 +18,7 @@
 #include "common/format.hpp"
 #include "common/delay.hpp"
 #include "common/command.hpp"
+#include "RX600/dma_service.hpp"
 
 namespace {
 
@@ -30,24 +33,18 @@ namespace {
 
 	utils::command<256> cmd_;
 
-	/// DMAC 終了割り込み
-	class dmac_task {
-		uint32_t	count_;
-	public:
-		dmac_task() : count_(0) { }
-
-		void operator() () {
-			++count_;
-		}
-
-		uint32_t get_count() const { return count_; }
-	};
+	typedef device::dma_service<4, device::DMAC0, device::DMAC1, device::EXDMAC0> DMA;
 
+	volatile uint32_t	done_count_;
 
-	typedef device::dmac_mgr<device::DMAC0, dmac_task> DMAC_MGR;
-	DMAC_MGR	dmac_mgr_;
+	/// 完了コールバック（DMA 終了割り込みから呼ばれる）
+	void done_task_(uint32_t id, void* ctx)
+	{
+		++done_count_;
+	}
 
 	char	tmp_[256];
+	char	big_[80000];	// COUNT_MAX を超える転送（区間に分割される）
 }
 
 extern "C" {
@@ -97,40 +94,74 @@ int main(int argc, char** argv)
 
 	{
 		auto intr_level = device::ICU::LEVEL::_4;
-		dmac_mgr_.start(intr_level);
+		DMA::start(intr_level);
 	}
 
 	// copy 機能の確認
 	std::memset(tmp_, 0, sizeof(tmp_));
 	std::strcpy(tmp_, "ASDFGHJKLQWERTYUZXCVBNMIOP");
 	uint32_t copy_len = 16;
-	dmac_mgr_.copy(&tmp_[0], &tmp_[128], copy_len, true); 
+	auto id = DMA::copy(&tmp_[0], &tmp_[128], copy_len, DMA::PRIORITY::NORMAL, done_task_);
 
 	utils::format("DMA Copy: %d\n") % copy_len;
-	while(dmac_mgr_.probe()) ;
+	DMA::sync(id);
 
 	utils::format("ORG(%d): '%s'\n") % std::strlen(tmp_) % tmp_;
 	utils::format("CPY(%d): '%s'\n") % std::strlen(&tmp_[128]) % &tmp_[128];
-	utils::format("DMAC task: %d\n") % dmac_mgr_.at_task().get_count();
+	utils::format("DMA done: %d\n") % done_count_;
 
-	dmac_mgr_.fill(&tmp_[0], 4, copy_len, true);
+	// 重なる領域のコピー（上から転送される）
+	id = DMA::copy(&tmp_[0], &tmp_[4], copy_len, DMA::PRIORITY::NORMAL, done_task_);
 
-	utils::format("DMA fill: %d\n") % copy_len;
-	while(dmac_mgr_.probe()) ;
+	utils::format("DMA Copy (overlap): %d\n") % copy_len;
+	DMA::sync(id);
 
 	utils::format("ORG(%d): '%s'\n") % std::strlen(tmp_) % tmp_;
-	utils::format("DMAC task: %d\n") % dmac_mgr_.at_task().get_count();
+	utils::format("DMA done: %d\n") % done_count_;
 
 	uint8_t val = 'Z';
 	copy_len = 31;
-	dmac_mgr_.memset(&tmp_[0], val, copy_len, true);
+	id = DMA::fill(&tmp_[0], val, copy_len, DMA::PRIORITY::NORMAL, done_task_);
 
-	utils::format("DMA memset: %d\n") % copy_len;
-	while(dmac_mgr_.probe()) ;
+	utils::format("DMA fill: %d\n") % copy_len;
+	DMA::sync(id);
 
 	utils::format("ORG(%d): '%s'\n") % std::strlen(tmp_) % tmp_;
-	utils::format("DMAC task: %d\n") % dmac_mgr_.at_task().get_count();
+	utils::format("DMA done: %d\n") % done_count_;
+
+	{  // ディスクリプタ列（ギャザー）
+		static const char a[] = "DMA ";
+		static const char b[] = "chain ";
+		static const char c[] = "transfer";
+		static const DMA::desc_t desc[] = {
+			{ a, &tmp_[128], 4 },
+			{ b, &tmp_[132], 6 },
+			{ c, &tmp_[138], sizeof(c) },
+		};
+		id = DMA::chain(desc, 3, DMA::PRIORITY::HIGH, done_task_);
+
+		utils::format("DMA chain: %d\n") % 3;
+		DMA::sync(id);
+
+		utils::format("CPY(%d): '%s'\n") % std::strlen(&tmp_[128]) % &tmp_[128];
+		utils::format("DMA done: %d\n") % done_count_;
+	}
 
+	{  // 大きな転送を、チャネルに振り分ける
+		uint32_t ids[3];
+		ids[0] = DMA::fill(big_, 0x55, sizeof(big_), DMA::PRIORITY::LOW, done_task_);
+		ids[1] = DMA::copy(tmp_, &big_[100], 64, DMA::PRIORITY::NORMAL, done_task_);
+		ids[2] = DMA::fill(&tmp_[192], 'x', 32, DMA::PRIORITY::NORMAL, done_task_);
+		for(auto i : ids) {
+			DMA::sync(i);
+		}
+		utils::format("DMA done: %d\n") % done_count_;
+		for(uint32_t i = 0; i < DMA::CHN_NUM; ++i) {
+			auto st = DMA::get_stat(i);
+			utils::format("CH%d: jobs: %u, segments: %u, bytes: %u\n")
+				% i % st.jobs % st.segments % st.bytes;
+		}
+	}
 
 	uint32_t cnt = 0;
 	while(1) {
@@ -2,7 +2,7 @@
 /*! @file
     @brief  RX65N/RX72N Envision Kit SYNTH sample
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2020, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2020, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -190,6 +190,12 @@ namespace {
 	SynthUnit	synth_unit_(ring_buffer_);
 	char		synth_color_name_[16 * 32];
 
+	// シンセサイザーの負荷計測（ポーリング、周期はフレームと同じ）
+	typedef device::cmt_mgr<device::CMT1> LOAD_CMT;
+	LOAD_CMT	load_cmt_;
+	// 負荷の上限（フレーム時間に対する％）、超えたら発音数を減らす
+	static constexpr int SYNTH_LOAD_BUDGET = 50;
+
 #ifdef USE_DAC
 	typedef sound::dac_stream<device::R12DA, device::MTU0, device::DMAC0, SOUND_OUT> DAC_STREAM;
 	DAC_STREAM	dac_stream_(sound_out_);
@@ -1433,6 +1439,8 @@ int main(int argc, char** argv)
 
 	SynthUnit::Init(SYNTH_SAMPLE_RATE);
 
+	load_cmt_.start(60);
+
 	{  // サンプリング・タイマー周期設定
 		set_sample_rate(AUDIO_SAMPLE_RATE);
 	}
@@ -1503,7 +1511,14 @@ int main(int argc, char** argv)
 		{  // シンセサイザー・サービス
 			uint32_t n = SYNTH_SAMPLE_RATE / 60;
 			int16_t tmp[n];
+			auto org = load_cmt_.get_cmt_count();
 			synth_unit_.GetSamples(n, tmp);
+			{  // 負荷（％）に合わせて、発音数の上限を調整
+				int32_t t = static_cast<int32_t>(load_cmt_.get_cmt_count()) - org;
+				int32_t prd = static_cast<int32_t>(load_cmt_.get_cmp_count()) + 1;
+				if(t < 0) t += prd;
+				synth_unit_.AdjustVoiceLimit(t * 100 / prd, SYNTH_LOAD_BUDGET);
+			}
 
 			typename SOUND_OUT::WAVE t;
 			for(uint32_t i = 0; i < n; ++i) {
@@ -0,0 +1,187 @@
+//=====================================================================//
+/*! @file
+    @brief  ソフトウェア・タイマー・サービス、サンプル @n
+			device::timer_service（ティックレス・モード）で、LED の点滅と、 @n
+			コマンドで登録したワンショット・タイマーを動かす。 @n
+			イベントの無い間は idle() で CPU を止め、コールバックの遅れと @n
+			ジッターを「stat」で表示する。 @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/timer_service.hpp"
+
+#include "common/format.hpp"
+#include "common/input.hpp"
+#include "common/command.hpp"
+
+namespace {
+
+	typedef utils::fixed_fifo<char, 512> RXB;  // RX (RECV) バッファの定義
+	typedef utils::fixed_fifo<char, 256> TXB;  // TX (SEND) バッファの定義
+	typedef device::sci_io<board_profile::SCI_CH, RXB, TXB, board_profile::SCI_ORDER> SCI;
+	SCI		sci_;
+
+	static constexpr uint32_t TICK_FREQ = 1000;  ///< ティックの周波数 [Hz]
+
+	typedef device::timer_service<board_profile::CMT_CH> TIMER;
+	TIMER	timer_;
+
+	uint32_t	led_id_;
+	uint32_t	led_period_;
+
+	typedef utils::command<256> CMD;
+	CMD		cmd_;
+
+
+	void led_task_(uint32_t id, void* ctx)
+	{
+		board_profile::LED::P = !board_profile::LED::P();
+	}
+
+
+	void once_task_(uint32_t id, void* ctx)
+	{
+		auto n = reinterpret_cast<uintptr_t>(ctx);
+		utils::format("One-shot: %u [ms], tick: %u\n") % static_cast<uint32_t>(n) % timer_.get_tick();
+	}
+
+
+	void list_stat_()
+	{
+		const auto& st = timer_.get_stat();
+		utils::format("Tick: %u (%u [Hz], real: %u [Hz])\n")
+			% timer_.get_tick() % timer_.get_rate() % timer_.get_rate(true);
+		utils::format("Wakeups: %u, Services: %u, Fired: %u, Max span: %u [tick]\n")
+			% st.wakeups % st.services % st.fired % st.span_max;
+		utils::format("Late: avg %u [us], max %u [us], Jitter max: %u [us]\n")
+			% timer_.count_to_usec(st.late_avg) % timer_.count_to_usec(st.late_max)
+			% timer_.count_to_usec(st.jitter_max);
+	}
+
+
+	bool get_value_(uint32_t n, uint32_t& v)
+	{
+		char tmp[32];
+		cmd_.get_word(n, tmp, sizeof(tmp));
+		if(!(utils::input("%d", tmp) % v).status()) {
+			utils::format("Parse error: '%s'\n") % tmp;
+			return false;
+		}
+		return true;
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		if(cmd_.cmp_word(0, "stat")) {
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "clear")) {
+			timer_.clear_stat();
+		} else if(cmd_.cmp_word(0, "once") && cmdn >= 2) {
+			uint32_t ms;
+			if(!get_value_(1, ms)) return;
+			auto delay = ms * TICK_FREQ / 1000;
+			if(timer_.add(delay, once_task_, reinterpret_cast<void*>(static_cast<uintptr_t>(ms))) == TIMER::ID_NONE) {
+				utils::format("Timer full...\n");
+			}
+		} else if(cmd_.cmp_word(0, "led") && cmdn >= 2) {
+			uint32_t ms;
+			if(!get_value_(1, ms)) return;
+			timer_.cancel(led_id_);
+			led_period_ = ms * TICK_FREQ / 1000;
+			if(led_period_ == 0) led_period_ = 1;
+			led_id_ = timer_.add_periodic(led_period_, led_task_);
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    once ms                 one-shot timer (print after ms)\n");
+			utils::format("    led ms                  LED toggle period (ms)\n");
+			utils::format("    stat                    list status\n");
+			utils::format("    clear                   clear status\n");
+			utils::format("    help                    command list (this)\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+	}
+}
+
+
+extern "C" {
+
+	// syscalls.c から呼ばれる、標準出力（stdout, stderr）
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+	// syscalls.c から呼ばれる、標準入力（stdin）
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // SCI の開始
+		auto intr = device::ICU::LEVEL::_2;
+		uint32_t baud = 115200;  // ボーレート
+		sci_.start(baud, intr);
+	}
+
+	{  // タイマー・サービスの開始（ティックレス）
+		auto intr = device::ICU::LEVEL::_4;
+		if(!timer_.start(TICK_FREQ, intr, true)) {
+			utils::format("Timer service start fail...\n");
+		}
+	}
+
+	auto clk = device::clock_profile::ICLK / 1'000'000;
+	utils::format("Start timer service sample for '%s' %d[MHz]\n") % system_str_ % clk;
+
+	LED::DIR = 1;
+	LED::P = 0;
+	led_period_ = TICK_FREQ / 4;
+	led_id_ = timer_.add_periodic(led_period_, led_task_);
+
+	cmd_.set_prompt("# ");
+
+	while(1) {
+		command_();
+		timer_.service();
+		// 次のイベント（又は SCI の受信）まで眠る
+		timer_.idle();
+	}
+}
@@ -0,0 +1,301 @@
+//=====================================================================//
+/*! @file
+    @brief  VS1063 オーディオ・コーデック、再生／録音サンプル @n
+			SD カードの MP3 などを VS1063 で再生し、VS1063 のエンコーダーで @n
+			録音したデータを SD カードに書く。 @n
+			再生は DREQ 割り込みで送り、録音データは CMT 割り込みからも取り出す。 @n
+			VS1063 (xCS)   ---> P40 @n
+			VS1063 (xDCS)  ---> P41 @n
+			VS1063 (DREQ)  ---> P12 / IRQ2 @n
+			VS1063 (SCLK)  ---> PA5 / RSPCKA-B @n
+			VS1063 (SI)    ---> PA6 / MOSIA-B @n
+			VS1063 (SO)    ---> PA7 / MISOA-B @n
+			※使い方は、コマンド「help」を参照
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/renesas.hpp"
+
+#include "common/fixed_fifo.hpp"
+#include "common/sci_io.hpp"
+#include "common/cmt_mgr.hpp"
+
+#include "common/format.hpp"
+#include "common/input.hpp"
+#include "common/string_utils.hpp"
+
+#include "common/spi_io2.hpp"
+#include "common/rspi_io.hpp"
+#include "common/command.hpp"
+#include "common/file_io.hpp"
+
+#include "chip/VS1063.hpp"
+
+namespace {
+
+	typedef utils::fixed_fifo<char, 512> RXB;  // RX (RECV) バッファの定義
+	typedef utils::fixed_fifo<char, 256> TXB;  // TX (SEND) バッファの定義
+	typedef device::sci_io<board_profile::SCI_CH, RXB, TXB, board_profile::SCI_ORDER> SCI;
+	SCI		sci_;
+
+	// SDCARD 制御リソース（ソフト SPI）
+	typedef device::PORT<device::PORTC, device::bitpos::B3> MISO;
+	typedef device::PORT<device::PORT7, device::bitpos::B6> MOSI;
+	typedef device::PORT<device::PORT7, device::bitpos::B7> SPCK;
+	typedef device::spi_io2<MISO, MOSI, SPCK> SDC_SPI;
+
+	typedef device::PORT<device::PORTC, device::bitpos::B2> SDC_SELECT;	///< カード選択信号
+	typedef device::PORT<device::PORT8, device::bitpos::B2, 0> SDC_POWER;	///< カード電源制御
+	typedef device::PORT<device::PORT8, device::bitpos::B1> SDC_DETECT;	///< カード検出
+	typedef device::NULL_PORT SDC_WPRT;  ///< カード書き込み禁止
+
+	SDC_SPI	sdc_spi_;
+	typedef fatfs::mmc_io<SDC_SPI, SDC_SELECT, SDC_POWER, SDC_DETECT, SDC_WPRT> SDC;
+	SDC		sdc_(sdc_spi_, 20'000'000);
+
+	// VS1063 制御リソース（SD カードとは別の SPI）
+	typedef device::rspi_io<device::RSPI0, device::port_map::ORDER::SECOND> VS_SPI;
+	VS_SPI	vs_spi_;
+	typedef device::PORT<device::PORT4, device::bitpos::B0> VS_SEL;	///< xCS
+	typedef device::PORT<device::PORT4, device::bitpos::B1> VS_DCS;	///< xDCS
+	typedef device::PORT<device::PORT1, device::bitpos::B2> VS_REQ;	///< DREQ
+	typedef chip::VS1063<VS_SPI, VS_SEL, VS_DCS, VS_REQ, device::ICU::VECTOR::IRQ2, 2048> VS1063;
+	VS1063	vs1063_(vs_spi_);
+
+	// 録音データは、CMT 割り込みからも取り出す（ファイルの書き込み中も溢れない様に）
+	class cmt_task {
+	public:
+		void operator() () {
+			vs1063_.rec_poll();
+		}
+	};
+
+	typedef device::cmt_mgr<board_profile::CMT_CH, cmt_task> CMT;
+	CMT		cmt_;
+
+	FIL		fil_;
+	bool	open_;
+
+	typedef utils::command<256> CMD;
+	CMD		cmd_;
+
+
+	bool open_file_(const char* name, BYTE mode)
+	{
+		if(open_) {
+			utils::format("Already started...\n");
+			return false;
+		}
+		char path[FF_MAX_LFN + 1];
+		utils::file_io::make_full_path(name, path, sizeof(path));
+		if(f_open(&fil_, path, mode) != FR_OK) {
+			utils::format("Can't open file: '%s'\n") % path;
+			return false;
+		}
+		open_ = true;
+		return true;
+	}
+
+
+	void close_file_()
+	{
+		if(open_) {
+			f_close(&fil_);
+			open_ = false;
+		}
+	}
+
+
+	void list_stat_()
+	{
+		static const char* state[] = { "idle", "play", "record" };
+		utils::format("State: %s%s, Volume: %u\n")
+			% state[static_cast<uint8_t>(vs1063_.get_state())]
+			% (vs1063_.is_pause() ? " (pause)" : "") % static_cast<uint32_t>(vs1063_.get_volume());
+		utils::format("Decode time: %u [sec], Underrun: %u, Overrun: %u\n")
+			% vs1063_.get_decode_time() % vs1063_.get_underrun() % vs1063_.get_overrun();
+	}
+
+
+	bool get_value_(uint32_t n, uint32_t& v)
+	{
+		char tmp[32];
+		cmd_.get_word(n, tmp, sizeof(tmp));
+		if(!(utils::input("%d", tmp) % v).status()) {
+			utils::format("Parse error: '%s'\n") % tmp;
+			return false;
+		}
+		return true;
+	}
+
+
+	void command_()
+	{
+		if(!cmd_.service()) {
+			return;
+		}
+
+		auto cmdn = cmd_.get_words();
+		if(cmdn == 0) return;
+
+		if(cmd_.cmp_word(0, "play") && cmdn >= 2) {
+			char name[128];
+			cmd_.get_word(1, name, sizeof(name));
+			if(!open_file_(name, FA_READ)) return;
+			vs1063_.clear_count();
+			if(!vs1063_.play(&fil_)) {
+				utils::format("Play error: '%s'\n") % name;
+				close_file_();
+			}
+		} else if(cmd_.cmp_word(0, "rec") && cmdn >= 2) {
+			uint32_t rate = 44'100;
+			if(cmdn >= 3 && !get_value_(2, rate)) return;
+			char name[128];
+			cmd_.get_word(1, name, sizeof(name));
+			if(!open_file_(name, FA_WRITE | FA_CREATE_ALWAYS)) return;
+			vs1063_.clear_count();
+			if(!vs1063_.record(&fil_, rate, VS1063::REC_FORMAT::MP3, VS1063::REC_CH::JOINT_STEREO)) {
+				utils::format("Record error: '%s'\n") % name;
+				close_file_();
+			}
+		} else if(cmd_.cmp_word(0, "stop")) {
+			vs1063_.stop();
+			close_file_();
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "pause")) {
+			vs1063_.pause(!vs1063_.is_pause());
+		} else if(cmd_.cmp_word(0, "vol") && cmdn >= 2) {
+			uint32_t vol;
+			if(!get_value_(1, vol)) return;
+			if(vol > 255) vol = 255;
+			vs1063_.set_volume(vol);
+		} else if(cmd_.cmp_word(0, "stat")) {
+			list_stat_();
+		} else if(cmd_.cmp_word(0, "help")) {
+			utils::format("    play filename           play the file (MP3, WAV, Ogg, ...)\n");
+			utils::format("    rec filename [rate]     record MP3 to file (rate: Hz, default 44100)\n");
+			utils::format("    stop                    stop play/record, close file\n");
+			utils::format("    pause                   pause/resume\n");
+			utils::format("    vol n                   volume (0 to 255)\n");
+			utils::format("    stat                    list status\n");
+			utils::format("    help                    command list (this)\n");
+		} else {
+			char tmp[64];
+			cmd_.get_word(0, tmp, sizeof(tmp));
+			utils::format("Command error: '%s'\n") % tmp;
+		}
+	}
+}
+
+
+extern "C" {
+
+	// syscalls.c から呼ばれる、標準出力（stdout, stderr）
+	void sci_putch(char ch)
+	{
+		sci_.putch(ch);
+	}
+
+	void sci_puts(const char* str)
+	{
+		sci_.puts(str);
+	}
+
+	// syscalls.c から呼ばれる、標準入力（stdin）
+	char sci_getch(void)
+	{
+		return sci_.getch();
+	}
+
+	uint16_t sci_length()
+	{
+		return sci_.recv_length();
+	}
+
+	// FatFs から呼ばれるファイル操作関数
+	DSTATUS disk_initialize(BYTE drv) {
+		return sdc_.disk_initialize(drv);
+	}
+
+	DSTATUS disk_status(BYTE drv) {
+		return sdc_.disk_status(drv);
+	}
+
+	DRESULT disk_read(BYTE drv, BYTE* buff, DWORD sector, UINT count) {
+		return sdc_.disk_read(drv, buff, sector, count);
+	}
+
+	DRESULT disk_write(BYTE drv, const BYTE* buff, DWORD sector, UINT count) {
+		return sdc_.disk_write(drv, buff, sector, count);
+	}
+
+	DRESULT disk_ioctl(BYTE drv, BYTE ctrl, void* buff) {
+		return sdc_.disk_ioctl(drv, ctrl, buff);
+	}
+
+	DWORD get_fattime(void) {
+		auto t = utils::str::make_time(nullptr, nullptr);
+		return utils::str::get_fattime(t);
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	SYSTEM_IO::boost_master_clock();
+
+	using namespace board_profile;
+
+	{  // タイマー設定（100Hz）
+		auto intr = device::ICU::LEVEL::_4;
+		cmt_.start(100, intr);
+	}
+
+	{  // SCI の開始
+		auto intr = device::ICU::LEVEL::_2;
+		uint32_t baud = 115200;  // ボーレート
+		sci_.start(baud, intr);
+	}
+
+	auto clk = device::clock_profile::ICLK / 1'000'000;
+	utils::format("Start VS1063 sample for '%s' %d[MHz]\n") % system_str_ % clk;
+
+	{  // VS1063 の開始（DREQ は IRQ2、P12）
+		auto intr = device::ICU::LEVEL::_5;
+		if(!vs1063_.start(intr, device::port_map_irq::ORDER::SECOND)) {
+			utils::format("VS1063 start fail...\n");
+		}
+		vs1063_.set_volume(200);
+	}
+
+	LED::DIR = 1;
+	LED::P = 0;
+
+	cmd_.set_prompt("# ");
+
+	uint8_t cnt = 0;
+	while(1) {
+		cmt_.sync();
+
+		sdc_.service();
+
+		command_();
+
+		// 最後まで再生した、又は書き込みエラーで止まった
+		if(!vs1063_.service() && open_) {
+			close_file_();
+			list_stat_();
+		}
+
+		++cnt;
+		if(cnt >= 50) {
+			cnt = 0;
+		}
+		LED::P = (cnt < 25) ? 0 : 1;
+	}
+}
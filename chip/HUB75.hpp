@@ -1,5 +1,5 @@
 #pragma once
-//=====================================================================//
+//=========================================================================//
 /*!	@file
 	@brief	HUB75 RGB LED Panel Driver クラス @n
 				R[01], G[01], B[01], SCLK, LATCH, BLANK(/OE), ADR[0-3] @n
@@ -11,40 +11,50 @@
 				 9: A      10: B     @n
 				11: C      12: D     @n
 				13: CLK    14: LAT   @n
-				15: /OE    16: GND
-	@copyright	Copyright (C) 2018 Kunihito Hiramatsu @n
+				15: /OE    16: GND   @n
+			・BCM（Binary Code Modulation）でリフレッシュする。 @n
+			・R1, G1, B1, R2, G2, B2, CLK は、一つの８ビット・ポートの B0～B6 に接続する。 @n
+			  （B7 は DMA で常に０が書かれるので、他の用途に使えない） @n
+			・ポート・パターンは、シフト用タイマーの割り込み要因で DMA 転送する。 @n
+			・プレーン毎の表示時間（OE）は、OE 用タイマーで「base x 2^plane」とする。 @n
+			・シフトと表示は並行して行い、両方が終わったらラッチして次に進む。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
-//=====================================================================//
-#include <cmath>
+//=========================================================================//
+#include "common/cmt_mgr.hpp"
+#include "chip/HUB75_BCM.hpp"
 
 namespace chip {
 
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
-		@brief  HUB75 カラム選択ポート・クラス
-		@param[in]	a	デコーダーＡ
-		@param[in]	b	デコーダーＢ
-		@param[in]	c	デコーダーＣ
-		@param[in]	d	デコーダーＤ
+		@brief  HUB75 行選択ポート・クラス
+		@param[in]	A	デコーダーＡ
+		@param[in]	B	デコーダーＢ
+		@param[in]	C	デコーダーＣ
+		@param[in]	D	デコーダーＤ
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <PORT a, PORT b, PORT c, PORT d>
-	class PORTS {
-	public:
-		static void init() {
-			a::DIR = 1;
-			b::DIR = 1;
-			c::DIR = 1;
-			d::DIR = 1;
+	template <class A, class B, class C, class D = device::NULL_PORT>
+	struct PORTS {
+
+		static void init() noexcept
+		{
+			A::DIR = 1;
+			B::DIR = 1;
+			C::DIR = 1;
+			D::DIR = 1;
 		}
 
-		static void out(uint32_t v) {
-			a::P = v & 1;
-			b::P = (v >> 1) & 1;
-			c::P = (v >> 2) & 1;
-			d::P = (v >> 3) & 1;
+		static void out(uint32_t v) noexcept
+		{
+			A::P = v & 1;
+			B::P = (v >> 1) & 1;
+			C::P = (v >> 2) & 1;
+			D::P = (v >> 3) & 1;
 		}
 	};
 
@@ -52,43 +62,199 @@ namespace chip {
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  HUB75 テンプレートクラス
-		@param[in]	red		赤シリアル・ポート
-		@param[in]	green	緑シリアル・ポート
-		@param[in]	blue	青シリアル・ポート
-		@param[in]	sclk	シリアル・クロック・ポート
-		@param[in]	latch	ラッチ・ポート
-		@param[in]	blank	ブランキング・ポート
-		@param[in]	adr		カラム・デコーダー・ポート		
+		@param[in]	DATA	データ・ポート（R1, G1, B1, R2, G2, B2, CLK：B0～B6）
+		@param[in]	LAT		ラッチ・ポート
+		@param[in]	OE		表示許可ポート（/OE なので、通常は反転論理で定義する）
+		@param[in]	ADR		行選択ポート（chip::PORTS）
+		@param[in]	DMAC	DMAC チャネル
+		@param[in]	SFT		シフト用 CMT チャネル（DMA の起動要因） @n
+							※割り込みベクターが固定のチャネル（CMT0、CMT1 など）
+		@param[in]	OET		表示時間用 CMT チャネル
+		@param[in]	WIDTH	横幅（ピクセル）
+		@param[in]	HEIGHT	高さ（ピクセル）
+		@param[in]	DEPTH	階調ビット数
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <PORT red, PORT green, PORT blue, PORT sclk, PORT latch, PORT blank, PORTS adr>
+	template <class DATA, class LAT, class OE, class ADR, class DMAC, class SFT, class OET,
+		uint32_t WIDTH = 64, uint32_t HEIGHT = 32, uint32_t DEPTH = 8>
 	class HUB75 {
 	public:
+		typedef HUB75_BCM<WIDTH, HEIGHT, DEPTH> BCM;
+
+	private:
+		static inline BCM	bcm_;
+
+		static inline uint16_t	base_;
+		static inline volatile bool	run_;
+		static inline volatile bool	shift_;	///< シフト完了
+		static inline volatile bool	show_;	///< 表示完了
+		static inline volatile uint32_t	frame_;
+
+		// ラッチしたプレーンを表示して、次のプレーンのシフトを始める
+		static void next_() noexcept
+		{
+			shift_ = false;
+			show_ = false;
+
+			ADR::out(bcm_.get_row());
+			LAT::P = 1;
+			LAT::P = 0;
+			OET::CMCNT = 0;
+			OET::CMCOR = (static_cast<uint32_t>(base_) << bcm_.get_plane()) - 1;
+			OE::P = 1;
+			OET::enable();
+
+			if(bcm_.step()) {
+				++frame_;
+			}
+			DMAC::DMSAR = reinterpret_cast<uint32_t>(bcm_.get_line());
+			DMAC::DMCRA = BCM::LINE_SIZE;
+			DMAC::DMCNT.DTE = 1;
+		}
+
+		struct oe_task {
+			void operator() () noexcept
+			{
+				OE::P = 0;
+				OET::enable(false);
+				show_ = true;
+				if(run_ && shift_) next_();
+			}
+		};
+
+		struct dma_task {
+			void operator() () noexcept
+			{
+				shift_ = true;
+				if(run_ && show_) next_();
+			}
+		};
+
+		typedef device::cmt_mgr<SFT> SFT_MGR;
+		typedef device::cmt_mgr<OET, oe_task> OET_MGR;
+		typedef device::dmac_mgr<DMAC, dma_task> DMA_MGR;
+
+		SFT_MGR		sft_mgr_;
+		OET_MGR		oet_mgr_;
+		DMA_MGR		dma_mgr_;
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		 */
+		//-----------------------------------------------------------------//
+		HUB75() noexcept : sft_mgr_(), oet_mgr_(), dma_mgr_() { }
+
+
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	開始
+			@brief	開始 @n
+					１フレームの時間は、およそ「ROWS x Σ max(シフト時間, base x 2^plane)」
+			@param[in]	shift_freq	シフト周波数（１バイト毎、１カラムは２バイト）
+			@param[in]	base		最下位プレーンの表示時間（OET のカウント、PCLK/8 単位）
+			@param[in]	level		割り込みレベル（DMA 終了、OE タイマー）
+			@return 設定が範囲外なら「false」
 		 */
 		//-----------------------------------------------------------------//
-		void start()
+		bool start(uint32_t shift_freq, uint16_t base, device::ICU::LEVEL level) noexcept
 		{
-			red::DIR = 1;
-			green::DIR = 1;
-			blue::DIR = 1;
-			sclk::DIR = 1;
-			latch::DIR = 1;
-			blank::DIR = 1;
-			adr::init();
+			if(level == device::ICU::LEVEL::NONE) return false;
+			if(base == 0 || (static_cast<uint32_t>(base) << (DEPTH - 1)) > 65536) return false;
+
+			base_ = base;
+
+			DATA::PODR = DATA::PODR() & 0x80;
+			DATA::PDR = DATA::PDR() | 0x7f;
+			LAT::P = 0;
+			LAT::DIR = 1;
+			OE::P = 0;
+			OE::DIR = 1;
+			ADR::init();
+
+			bcm_.reset_scan();
+			frame_ = 0;
+			shift_ = false;
+			show_ = true;
+			run_ = true;
+
+			if(!oet_mgr_.start(OET_MGR::DIRECT::MAX, OET_MGR::DIVIDE::I8, level)) {
+				return false;
+			}
+			OET::enable(false);
+
+			if(!sft_mgr_.start(shift_freq, level)) {
+				return false;
+			}
+
+			return dma_mgr_.start(DMA_MGR::TRANS_MODE::NORMAL, DMA_MGR::TRANS_TYPE::SP_DN_8,
+				SFT::CMI, reinterpret_cast<uint32_t>(bcm_.get_line()),
+				DATA::PODR.address, 0, BCM::LINE_SIZE, level);
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	コピー
-			@param[in]	src		ソース
+			@brief	停止（消灯）
 		 */
 		//-----------------------------------------------------------------//
-		void copy(const void* src)
+		void stop() noexcept
 		{
+			run_ = false;
+			dma_mgr_.stop();
+			OET::enable(false);
+			SFT::enable(false);
+			OE::P = 0;
 		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	RGB565 イメージをコピー（次のフレームから表示）
+			@param[in]	src		ソース（WIDTH x HEIGHT）
+			@return 前のコピーが切り替え待ちなら「false」
+		 */
+		//-----------------------------------------------------------------//
+		bool copy(const uint16_t* src) noexcept
+		{
+			if(bcm_.is_flip()) return false;
+			bcm_.convert(src);
+			bcm_.flip();
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	RGB888 イメージをコピー（次のフレームから表示）
+			@param[in]	src		ソース（R, G, B の順で WIDTH x HEIGHT）
+			@return 前のコピーが切り替え待ちなら「false」
+		 */
+		//-----------------------------------------------------------------//
+		bool copy(const uint8_t* src) noexcept
+		{
+			if(bcm_.is_flip()) return false;
+			bcm_.convert(src);
+			bcm_.flip();
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	表示したフレーム数を取得
+			@return フレーム数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_frame_count() const noexcept { return frame_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	BCM バッファの参照（ガンマ設定など）
+			@return BCM バッファ
+		 */
+		//-----------------------------------------------------------------//
+		static auto& at_bcm() noexcept { return bcm_; }
 	};
 }
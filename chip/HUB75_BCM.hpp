@@ -0,0 +1,293 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	HUB75 RGB LED Panel BCM（Binary Code Modulation）バッファ・クラス @n
+			フレームバッファ（RGB565/RGB888）を、ビットプレーン毎のポート・パターン @n
+			に変換する。 @n
+			・出力ポート（8 ビット）のビット配置 @n
+			  B0: R1, B1: G1, B2: B1, B3: R2, B4: G2, B5: B2, B6: CLK, B7: 常に０ @n
+			・１カラムは「データ」、「データ｜CLK」の２バイト（CLK の立ち上がりでシフト） @n
+			・バッファの並び：[行ペア][プレーン][WIDTH * 2] @n
+			・ダブルバッファ、切り替えはフレームの境界で行う。 @n
+			※デバイスに依存しないので、ホストでも検証出来る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+#include <cmath>
+
+namespace chip {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  HUB75 BCM バッファ・テンプレート・クラス
+		@param[in]	WIDTH	横幅（ピクセル）
+		@param[in]	HEIGHT	高さ（ピクセル、上下２分割で駆動）
+		@param[in]	DEPTH	階調ビット数（１～８）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t WIDTH = 64, uint32_t HEIGHT = 32, uint32_t DEPTH = 8>
+	class HUB75_BCM {
+	public:
+		static_assert(DEPTH >= 1 && DEPTH <= 8, "DEPTH is 1 to 8");
+		static_assert((HEIGHT & 1) == 0, "HEIGHT must be even");
+
+		static constexpr uint32_t ROWS       = HEIGHT / 2;			///< 行ペア数（スキャン数）
+		static constexpr uint32_t LINE_SIZE  = WIDTH * 2;			///< １プレーン（１行ペア）のバイト数
+		static constexpr uint32_t FRAME_SIZE = ROWS * DEPTH * LINE_SIZE;	///< １フレームのバイト数
+		static constexpr uint32_t LEVEL_MAX  = (1 << DEPTH) - 1;	///< 最大階調
+
+		static constexpr uint8_t R1  = 0b0000'0001;	///< 上半分、赤
+		static constexpr uint8_t G1  = 0b0000'0010;	///< 上半分、緑
+		static constexpr uint8_t B1  = 0b0000'0100;	///< 上半分、青
+		static constexpr uint8_t R2  = 0b0000'1000;	///< 下半分、赤
+		static constexpr uint8_t G2  = 0b0001'0000;	///< 下半分、緑
+		static constexpr uint8_t B2  = 0b0010'0000;	///< 下半分、青
+		static constexpr uint8_t CLK = 0b0100'0000;	///< シフト・クロック
+
+	private:
+		uint8_t		buff_[2][FRAME_SIZE];
+		uint8_t		gamma_[256];
+
+		volatile uint8_t	front_;
+		volatile bool	flip_;
+
+		uint8_t		row_;
+		uint8_t		plane_;
+
+		// R, G, B（DEPTH ビット）をカラムの２バイトに展開
+		void put_(uint8_t* dst, uint8_t r1, uint8_t g1, uint8_t b1, uint8_t r2, uint8_t g2, uint8_t b2) noexcept
+		{
+			for(uint32_t p = 0; p < DEPTH; ++p) {
+				uint8_t d = 0;
+				if(r1 & 1) d |= R1;
+				if(g1 & 1) d |= G1;
+				if(b1 & 1) d |= B1;
+				if(r2 & 1) d |= R2;
+				if(g2 & 1) d |= G2;
+				if(b2 & 1) d |= B2;
+				r1 >>= 1; g1 >>= 1; b1 >>= 1;
+				r2 >>= 1; g2 >>= 1; b2 >>= 1;
+				dst[0] = d;
+				dst[1] = d | CLK;
+				dst += LINE_SIZE;
+			}
+		}
+
+		void clear_(uint8_t* dst) noexcept
+		{
+			for(uint32_t i = 0; i < FRAME_SIZE; i += 2) {
+				dst[i + 0] = 0;
+				dst[i + 1] = CLK;
+			}
+		}
+
+		static uint8_t r565_(uint16_t c) noexcept { auto v = (c >> 11) & 0x1f; return (v << 3) | (v >> 2); }
+		static uint8_t g565_(uint16_t c) noexcept { auto v = (c >> 5) & 0x3f; return (v << 2) | (v >> 4); }
+		static uint8_t b565_(uint16_t c) noexcept { auto v = c & 0x1f; return (v << 3) | (v >> 2); }
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター（ガンマ 2.2、黒で初期化）
+		 */
+		//-----------------------------------------------------------------//
+		HUB75_BCM() noexcept : buff_{ }, gamma_{ }, front_(0), flip_(false), row_(0), plane_(0)
+		{
+			set_gamma(2.2f);
+			clear_(buff_[0]);
+			clear_(buff_[1]);
+		}
+
+
+		HUB75_BCM(const HUB75_BCM& th) = delete;
+		HUB75_BCM& operator = (const HUB75_BCM& th) = delete;
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ガンマ補正テーブルを作成 @n
+					８ビット入力を DEPTH ビットの階調に変換する。
+			@param[in]	gamma	ガンマ値（1.0 ならリニア）
+		 */
+		//-----------------------------------------------------------------//
+		void set_gamma(float gamma) noexcept
+		{
+			for(uint32_t i = 0; i < 256; ++i) {
+				auto v = std::pow(static_cast<float>(i) / 255.0f, gamma);
+				gamma_[i] = static_cast<uint8_t>(v * static_cast<float>(LEVEL_MAX) + 0.5f);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ガンマ補正テーブルを取得
+			@return ガンマ補正テーブル（256 エントリー）
+		 */
+		//-----------------------------------------------------------------//
+		const uint8_t* get_gamma() const noexcept { return gamma_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	バック・バッファを黒で埋める
+		 */
+		//-----------------------------------------------------------------//
+		void clear() noexcept { clear_(buff_[front_ ^ 1]); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	RGB565 フレームバッファをバック・バッファに変換
+			@param[in]	src		ソース（WIDTH x HEIGHT）
+			@param[in]	stride	１ラインのピクセル数
+		 */
+		//-----------------------------------------------------------------//
+		void convert(const uint16_t* src, uint32_t stride = WIDTH) noexcept
+		{
+			auto dst = buff_[front_ ^ 1];
+			for(uint32_t y = 0; y < ROWS; ++y) {
+				auto up = src + y * stride;
+				auto dn = src + (y + ROWS) * stride;
+				for(uint32_t x = 0; x < WIDTH; ++x) {
+					auto c1 = up[x];
+					auto c2 = dn[x];
+					put_(dst + x * 2,
+						gamma_[r565_(c1)], gamma_[g565_(c1)], gamma_[b565_(c1)],
+						gamma_[r565_(c2)], gamma_[g565_(c2)], gamma_[b565_(c2)]);
+				}
+				dst += DEPTH * LINE_SIZE;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	RGB888 フレームバッファをバック・バッファに変換
+			@param[in]	src		ソース（R, G, B の順で WIDTH x HEIGHT）
+			@param[in]	stride	１ラインのバイト数
+		 */
+		//-----------------------------------------------------------------//
+		void convert(const uint8_t* src, uint32_t stride = WIDTH * 3) noexcept
+		{
+			auto dst = buff_[front_ ^ 1];
+			for(uint32_t y = 0; y < ROWS; ++y) {
+				auto up = src + y * stride;
+				auto dn = src + (y + ROWS) * stride;
+				for(uint32_t x = 0; x < WIDTH; ++x) {
+					put_(dst + x * 2,
+						gamma_[up[0]], gamma_[up[1]], gamma_[up[2]],
+						gamma_[dn[0]], gamma_[dn[1]], gamma_[dn[2]]);
+					up += 3;
+					dn += 3;
+				}
+				dst += DEPTH * LINE_SIZE;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	バッファ切り替え要求（次のフレーム境界で切り替わる）
+		 */
+		//-----------------------------------------------------------------//
+		void flip() noexcept { flip_ = true; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	切り替え待ちか？ @n
+					※待ちの間にバック・バッファを書き換えても、表示は乱れない。
+			@return 切り替え待ちなら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_flip() const noexcept { return flip_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	フロント・バッファを取得
+			@return フロント・バッファ
+		 */
+		//-----------------------------------------------------------------//
+		const uint8_t* get_front() const noexcept { return buff_[front_]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	バック・バッファを取得
+			@return バック・バッファ
+		 */
+		//-----------------------------------------------------------------//
+		const uint8_t* get_back() const noexcept { return buff_[front_ ^ 1]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	スキャン位置をフレームの先頭に戻す
+		 */
+		//-----------------------------------------------------------------//
+		void reset_scan() noexcept
+		{
+			row_ = 0;
+			plane_ = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	シフトする行ペアを取得
+			@return 行ペア（アドレス）
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_row() const noexcept { return row_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	シフトするプレーンを取得（表示時間は 2^plane 倍）
+			@return プレーン
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_plane() const noexcept { return plane_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	シフトするポート・パターンを取得（LINE_SIZE バイト）
+			@return ポート・パターン
+		 */
+		//-----------------------------------------------------------------//
+		const uint8_t* get_line() const noexcept
+		{
+			return buff_[front_] + (row_ * DEPTH + plane_) * LINE_SIZE;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	スキャン位置を進める（割り込みから呼ぶ） @n
+					フレーム境界で切り替え要求があれば、バッファを切り替える。
+			@return フレーム境界なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool step() noexcept
+		{
+			++plane_;
+			if(plane_ < DEPTH) return false;
+			plane_ = 0;
+			++row_;
+			if(row_ < ROWS) return false;
+			row_ = 0;
+			if(flip_) {
+				front_ ^= 1;
+				flip_ = false;
+			}
+			return true;
+		}
+	};
+}
@@ -0,0 +1,207 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	LTC2348-16 フレーム・リング @n
+			バースト取得（chip/LTC2348_16b.hpp）の、変換結果を溜めるリング。 @n
+			・割り込み側は、SDO0 から読んだ 24 ビット・ワード（８チャネル分）を @n
+			  そのまま置くだけ（変換番号を付ける）。 @n
+			・メイン側は、まとめて取り出し、変換値、チャネル ID、スパンに分ける。 @n
+			  チャネル ID が並び順と違うフレームは、エラーとして数える。 @n
+			・リングが一杯なら、そのフレームは捨てて数える。 @n
+			※デバイスに依存しないので、ホストでも検証出来る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+
+namespace chip {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  LTC2348-16 フレーム・リング・クラス
+		@param[in]	FRAMES	リングのフレーム数（２のべき乗）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t FRAMES = 256>
+	class LTC2348_16_FRAME {
+	public:
+		static_assert((FRAMES & (FRAMES - 1)) == 0 && FRAMES >= 2, "FRAMES must be a power of 2");
+
+		static constexpr uint32_t CHANNELS = 8;	///< チャネル数
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  生データ（SDO0 の 24 ビット・ワード x ８） @n
+					ワード：D15～D0, 0, 0, チャネル ID(3), スパン(3)
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct raw_t {
+			uint32_t	seq;				///< 変換番号
+			uint32_t	word[CHANNELS];		///< 24 ビット・ワード
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  フレーム（ファイル、ネットワークに送る形）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct frame_t {
+			uint32_t	seq;				///< 変換番号（欠落の検出用）
+			uint16_t	value[CHANNELS];	///< 変換値（バイポーラ・スパンは２の補数）
+			uint32_t	span;				///< スパン（チャネル毎に３ビット、CH0 が B2～B0）
+		};
+
+	private:
+		raw_t		raw_[FRAMES];
+
+		volatile uint32_t	put_;
+		volatile uint32_t	get_;
+		volatile uint32_t	dropped_;
+		uint32_t	error_;
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		 */
+		//-----------------------------------------------------------------//
+		LTC2348_16_FRAME() noexcept : raw_{ }, put_(0), get_(0), dropped_(0), error_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	クリア（割り込みを止めて呼ぶ）
+		 */
+		//-----------------------------------------------------------------//
+		void clear() noexcept
+		{
+			put_ = 0;
+			get_ = 0;
+			dropped_ = 0;
+			error_ = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	書き込み先を取得（割り込み側）
+			@return 一杯なら「nullptr」（捨てたフレームとして数える）
+		 */
+		//-----------------------------------------------------------------//
+		raw_t* alloc() noexcept
+		{
+			if((put_ - get_) >= FRAMES) {
+				dropped_ = dropped_ + 1;
+				return nullptr;
+			}
+			return &raw_[put_ & (FRAMES - 1)];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	書き込みを確定（割り込み側、alloc() の後）
+		 */
+		//-----------------------------------------------------------------//
+		void commit() noexcept { put_ = put_ + 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	溜まっているフレーム数を取得
+			@return フレーム数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t length() const noexcept { return put_ - get_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	１フレームを変換
+			@param[in]	raw	生データ
+			@param[out]	out	フレーム
+			@return チャネル ID が並び順と違う場合「false」
+		 */
+		//-----------------------------------------------------------------//
+		static bool decode(const raw_t& raw, frame_t& out) noexcept
+		{
+			out.seq = raw.seq;
+			uint32_t span = 0;
+			uint32_t err = 0;
+			for(uint32_t i = 0; i < CHANNELS; ++i) {
+				auto w = raw.word[i];
+				out.value[i] = w >> 8;
+				err |= ((w >> 3) & 0b11111) ^ i;  // 0, 0, チャネル ID
+				span |= (w & 0b111) << (i * 3);
+			}
+			out.span = span;
+			return err == 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	まとめて取り出して変換（メイン側）
+			@param[out]	dst	フレームの格納先
+			@param[in]	max	最大フレーム数
+			@return 取り出したフレーム数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t read(frame_t* dst, uint32_t max) noexcept
+		{
+			uint32_t n = put_ - get_;
+			if(n > max) n = max;
+			uint32_t g = get_;
+			for(uint32_t i = 0; i < n; ++i) {
+				if(!decode(raw_[(g + i) & (FRAMES - 1)], dst[i])) {
+					++error_;
+				}
+			}
+			get_ = g + n;
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	リングが一杯で、捨てたフレーム数を取得
+			@return 捨てたフレーム数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_dropped() const noexcept { return dropped_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	チャネル ID が合わなかったフレーム数を取得
+			@return エラー・フレーム数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_error() const noexcept { return error_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変換値を電圧にする
+			@param[in]	value	変換値
+			@param[in]	span	スパン・コード（０～７）
+			@return 電圧 [V]
+		 */
+		//-----------------------------------------------------------------//
+		static float to_voltage(uint16_t value, uint32_t span) noexcept
+		{
+			// フルスケール（スパン幅）
+			static constexpr float fs[8] = { 0.0f, 5.12f, 10.0f, 10.24f, 10.0f, 10.24f, 20.0f, 20.48f };
+			span &= 7;
+			if(span == 2 || span == 3 || span == 6 || span == 7) {  // バイポーラ
+				return static_cast<float>(static_cast<int16_t>(value)) * fs[span] / 65536.0f;
+			} else {
+				return static_cast<float>(value) * fs[span] / 65536.0f;
+			}
+		}
+	};
+}
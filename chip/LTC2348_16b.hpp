@@ -0,0 +1,308 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	LTC2348-16b ドライバー（バースト取得） @n
+			LTC2348/16 bits A/D コンバーター @n
+			・CNV は MTU の PWM モード２（周期：TGRA、出力：TGRB）で出す @n
+			  （ソフトのジッターが乗らない）。 @n
+			・BUSY の立下り（IRQ 割り込み）で、SDO0 から８チャネル分の @n
+			  24 ビット・ワードを RSPI で読み、フレーム・リングに置く。 @n
+			  最初のワードで、次の変換のスパンを SDI に送る。 @n
+			・変換番号は MTU の周期割り込みで数え、BUSY 割り込みの間で @n
+			  番号が飛んだ分を、取りこぼした変換として数える。 @n
+			・メインループは read() でまとめて取り出し、ファイルや @n
+			  ネットワークに送る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+#include "common/device.hpp"
+#include "chip/LTC2348_16_FRAME.hpp"
+
+namespace chip {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  LTC2348-16 バースト取得テンプレートクラス @n
+				※PD パワーダウン制御は０で使う事（1: PowerDown）@n
+				※SCKO は使わない、SDI、SCKI、SDO0 を RSPI に繋ぐ @n
+				※MTU_IO の割り込みレベルは、BUSY と同じか高くする事
+		@param[in]	CSN			デバイス選択
+		@param[in]	SPI			SPI クラス（device::rspi_io）
+		@param[in]	MTU_IO		CNV 用 MTU I/O クラス（PWM、device::mtu_io）
+		@param[in]	BUSY_IRQ	BUSY を接続した IRQ（ベクター）
+		@param[in]	FRAMES		フレーム・リングの数（２のべき乗）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CSN, class SPI, class MTU_IO, device::ICU::VECTOR BUSY_IRQ, uint32_t FRAMES = 256>
+	class LTC2348_16b {
+	public:
+		typedef typename MTU_IO::mtu_type MTU;
+		typedef LTC2348_16_FRAME<FRAMES> FRAME;
+		typedef typename FRAME::frame_t frame_t;
+
+		static_assert(BUSY_IRQ >= device::ICU::VECTOR::IRQ0 && BUSY_IRQ <= device::ICU::VECTOR::IRQ7, "BUSY_IRQ must be IRQ0 to IRQ7");
+
+		static constexpr uint32_t RATE_MAX = 200'000;	///< 最大サンプル・レート [Hz]
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  ソフト・スパン種別 @n
+					Internal VREFBUF: 4.096V
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class span_type : uint8_t {
+			DISABLE,  		///< 000, Chanel Disable
+			P5_12,			///< 001, 1.25 * VREFBUF          (+0      to +5.12V)
+			M5P5,			///< 010, 2.5  * VREFBUF / 1.024  (-5V     to +5V)
+			P5_12M5_12,		///< 011, 2.5  * VREFBUF          (-5.12V  to +5.12V)
+			P10,			///< 100, 2.5  * VREFBUF / 1.024  (+0      to +10V)
+			P10_24,			///< 101, 2.5  * VREFBUF          (+0      to +10.24V)
+			M10P10,			///< 110, 5.0  * VREFBUF / 1.024  (-10V    to +10V)
+			M10_24P10_24,	///< 111, 5.0  * VREFBUF          (-10.24V to +10.24V)
+		};
+
+	private:
+		static constexpr uint32_t CNV_HIGH_NS = 60;	///< CNV パルス幅（tCNVH: min 40ns）
+		static constexpr uint32_t IRQN = static_cast<uint32_t>(BUSY_IRQ) - static_cast<uint32_t>(device::ICU::VECTOR::IRQ0);
+		static constexpr uint8_t IRQMD_NEGATIVE = 0b01;	///< 立下りエッジ
+
+		static inline device::ICU::irqcrn_t<0x0008'7500 + IRQN>	IRQCR_;
+
+		SPI&		spi_;
+		MTU_IO&		mtu_io_;
+
+		static inline SPI*	spi_ptr_;
+
+		static inline FRAME		frame_;
+
+		static inline volatile uint32_t	span_;
+		static inline volatile uint32_t	tick_org_;
+		static inline volatile uint32_t	tick_last_;
+		static inline volatile uint32_t	count_;
+		static inline volatile uint32_t	missed_;
+
+		// BUSY の立下り（変換終了）
+		static INTERRUPT_FUNC void busy_task_() noexcept
+		{
+			auto tick = MTU_IO::get_main_tick();
+			auto d = tick - tick_last_;
+			tick_last_ = tick;
+			if(d > 1) missed_ = missed_ + d - 1;
+
+			auto raw = frame_.alloc();
+			if(raw == nullptr) return;
+
+			CSN::P = 0;
+			raw->word[0] = spi_ptr_->xchg32(span_) & 0xffffff;
+			for(uint32_t i = 1; i < FRAME::CHANNELS; ++i) {
+				raw->word[i] = spi_ptr_->xchg32() & 0xffffff;
+			}
+			CSN::P = 1;
+			raw->seq = tick - tick_org_;
+			frame_.commit();
+			count_ = count_ + 1;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター
+			@param[in]	spi		SPI クラス
+			@param[in]	mtu_io	MTU I/O クラス
+		*/
+		//-----------------------------------------------------------------//
+		LTC2348_16b(SPI& spi, MTU_IO& mtu_io) noexcept : spi_(spi), mtu_io_(mtu_io) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始 @n
+					※スパンは全てのチャネルに同一、最初のフレームから有効
+			@param[in]	speed	SPI クロック
+			@param[in]	rate	サンプル・レート [Hz]
+			@param[in]	span	変換スパン種別
+			@param[in]	level	割り込みレベル（BUSY、MTU）
+			@param[in]	cnv_order	CNV 出力（MTIOCxB）のオーダー
+			@param[in]	busy_order	BUSY 入力（IRQ）のオーダー
+			@return エラーがあれば「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool start(uint32_t speed, uint32_t rate, span_type span, device::ICU::LEVEL level,
+			device::port_map_mtu::ORDER cnv_order = device::port_map_mtu::ORDER::FIRST,
+			device::port_map_irq::ORDER busy_order = device::port_map_irq::ORDER::FIRST) noexcept
+		{
+			if(level == device::ICU::LEVEL::NONE || rate == 0 || rate > RATE_MAX) return false;
+
+			stop();
+
+			spi_ptr_ = &spi_;
+			uint32_t ss = 0;
+			for(uint32_t i = 0; i < FRAME::CHANNELS; ++i) {
+				ss <<= 3;
+				ss |= static_cast<uint32_t>(span);
+			}
+			span_ = ss;
+			frame_.clear();
+			count_ = 0;
+			missed_ = 0;
+
+			CSN::DIR = 1;
+			CSN::P   = 1;
+
+			if(!spi_.start(speed, SPI::PHASE::TYPE1, SPI::DLEN::W24, 0)) {
+				return false;
+			}
+
+			// BUSY 立下り
+			device::icu_mgr::set_level(BUSY_IRQ, device::ICU::LEVEL::NONE);
+			if(!device::port_map_irq::turn(BUSY_IRQ, true, busy_order)) {
+				return false;
+			}
+			IRQCR_.IRQMD = IRQMD_NEGATIVE;
+
+			// CNV：周期の始めから CNV_HIGH_NS の間 High
+			typename MTU_IO::port_t po(MTU::CHANNEL::B, MTU_IO::OUTPUT::H_TO_L, cnv_order);
+			if(!mtu_io_.start_pwm2(MTU::CHANNEL::A, rate, po, level)) {
+				return false;
+			}
+			MTU::enable(false);
+			uint64_t clk = static_cast<uint64_t>(static_cast<uint32_t>(MTU::TGR[MTU::CHANNEL::A]) + 1) * MTU_IO::get_rate(true);
+			uint32_t cnt = (clk * CNV_HIGH_NS + 999'999'999) / 1'000'000'000;
+			MTU::rw_enable();
+			MTU::TGR[MTU::CHANNEL::B] = cnt;
+			MTU::TCNT = 0;
+			MTU::rw_enable(false);
+
+			// MTU が止まっている間に、基準を決めてから BUSY を許可する
+			tick_org_ = MTU_IO::get_main_tick();
+			tick_last_ = tick_org_;
+			device::ICU::IR[BUSY_IRQ] = 0;
+			device::icu_mgr::set_interrupt(BUSY_IRQ, busy_task_, level);
+			MTU::enable();
+
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  停止（リングに残ったフレームは読める）
+		*/
+		//-----------------------------------------------------------------//
+		void stop() noexcept
+		{
+			MTU::enable(false);
+			device::icu_mgr::set_level(BUSY_IRQ, device::ICU::LEVEL::NONE);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  フレームをまとめて取り出す
+			@param[out]	dst	フレームの格納先
+			@param[in]	max	最大フレーム数
+			@return 取り出したフレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t read(frame_t* dst, uint32_t max) noexcept { return frame_.read(dst, max); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  溜まっているフレーム数を取得
+			@return フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t length() const noexcept { return frame_.length(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  チャネルにスパン種別を設定（次の変換から有効）
+			@param[in]	ch		チャネル
+			@param[in]	span	スパン種別
+		*/
+		//-----------------------------------------------------------------//
+		void set_span(uint8_t ch, span_type span) noexcept
+		{
+			auto ss = span_ & ~(0b111 << (ch * 3));
+			span_ = ss | (static_cast<uint32_t>(span) << (ch * 3));
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  設定されたサンプル・レートを取得
+			@return サンプル・レート [Hz]
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_rate() const noexcept { return MTU_IO::get_rate(true); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始した変換の数を取得 @n
+					最初の変換はカウント開始時なので、周期割り込みの数＋１
+			@return 変換数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_started() const noexcept { return MTU_IO::get_main_tick() - tick_org_ + 1; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  リングに置いたフレーム数を取得
+			@return フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_count() const noexcept { return count_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  取りこぼした変換の数を取得 @n
+					BUSY 割り込みが、次の CNV までに処理されなかった
+			@return 取りこぼした変換の数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_missed() const noexcept { return missed_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  リングが一杯で、捨てたフレーム数を取得 @n
+					read() が間に合っていない
+			@return 捨てたフレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_dropped() const noexcept { return frame_.get_dropped(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  チャネル ID が合わなかったフレーム数を取得
+			@return エラー・フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_error() const noexcept { return frame_.get_error(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  実際に取れたサンプル・レートを取得 @n
+					設定レート x（リングに置いたフレーム数 / 開始した変換の数）
+			@return サンプル・レート [Hz]
+		*/
+		//-----------------------------------------------------------------//
+		float get_achieved_rate() const noexcept
+		{
+			auto n = get_started();
+			if(n == 0) return 0.0f;
+			return static_cast<float>(get_rate()) * static_cast<float>(count_) / static_cast<float>(n);
+		}
+	};
+}
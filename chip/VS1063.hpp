@@ -1,45 +1,88 @@
 #pragma once
 //=====================================================================//
 /*!	@file
-	@brief	VS1063 VLSI Audio Codec ドライバー
+	@brief	VS1063 VLSI Audio Codec ドライバー @n
+			・再生：ファイルをダブルバッファに先読みし、DREQ の立ち上がり @n
+			  （IRQ 割り込み）で、32 バイトずつ SDI に送る。 @n
+			  service() はメインループから呼び、空いたバッファを読むだけなので、 @n
+			  メインループは待たされない。 @n
+			・録音：エンコーダーのデータ（SCI_RECDATA）をダブルバッファに溜め、 @n
+			  一杯になったバッファをファイルに書く。 @n
+			  書き込み中も取り出せる様に、rec_poll() をタイマー割り込みから呼べる。 @n
+			・バッファが間に合わなかった回数（アンダーラン、オーバーラン）を数える。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2017 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2017, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=====================================================================//
 #include <cstdint>
-#include "G13/port.hpp"
-#include "common/csi_io.hpp"
+#include "common/device.hpp"
 #include "common/delay.hpp"
-#include "common/format.hpp"
-#include "ff12a/src/ff.h"
-
-extern "C" {
-	char sci_getch(void);
-	uint16_t sci_length();
-}
+#include "ff14/source/ff.h"
 
 namespace chip {
 
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  VS1063 テンプレートクラス
-		@param[in]	CSI	CSI(SPI) 制御クラス
-		@param[in]	SEL	/xCS 制御クラス
-		@param[in]	DCS /xDCS 制御クラス
-		@param[in]	REQ	DREQ 入力クラス
+		@param[in]	CSI			CSI(SPI) 制御クラス
+		@param[in]	SEL			/xCS 制御クラス
+		@param[in]	DCS 		/xDCS 制御クラス
+		@param[in]	REQ			DREQ 入力クラス
+		@param[in]	IRQV		DREQ を接続した IRQ（ベクター）
+		@param[in]	BUFF_SIZE	バッファ１面のサイズ（セクターの倍数）
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <class CSI, class SEL, class DCS, class REQ>
+	template <class CSI, class SEL, class DCS, class REQ, device::ICU::VECTOR IRQV, uint32_t BUFF_SIZE = 1024>
 	class VS1063 {
+	public:
+		static_assert((BUFF_SIZE % 512) == 0, "BUFF_SIZE must be a multiple of 512");
+		static_assert(BUFF_SIZE <= 65535, "BUFF_SIZE must be less than 65536 (16 bits position)");
+		static_assert(IRQV >= device::ICU::VECTOR::IRQ0 && IRQV <= device::ICU::VECTOR::IRQ7, "IRQV must be IRQ0 to IRQ7");
 
-		CSI&	csi_;
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  状態
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class STATE : uint8_t {
+			IDLE,		///< 停止
+			PLAY,		///< 再生
+			RECORD,		///< 録音
+		};
 
-		uint8_t	frame_;
 
-		uint8_t buff_[256];
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  録音フォーマット（SCI_RECMODE の B7～B4）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class REC_FORMAT : uint8_t {
+			IMA_ADPCM,	///< IMA ADPCM
+			PCM,		///< PCM
+			G711_ULAW,	///< G.711 u-law
+			G711_ALAW,	///< G.711 A-law
+			G722,		///< G.722
+			OGG,		///< Ogg Vorbis
+			MP3,		///< MP3
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  録音チャネル（SCI_RECMODE の B3～B0）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class REC_CH : uint8_t {
+			JOINT_STEREO,	///< ステレオ（共通 AGC）
+			DUAL,			///< ステレオ（個別 AGC）
+			LEFT,			///< 左
+			RIGHT,			///< 右
+			MONO,			///< モノラル（左右の和）
+		};
 
+	private:
 		/// VS1063a コマンド表
 		enum class CMD {
 			MODE,			///< モード制御
@@ -49,27 +92,71 @@ namespace chip {
 			DECODE_TIME,	///< 再生時間［秒］
 			AUDATA,			///< 各種オーディオ・データ
 			WRAM,			///< RAM リード／ライト
-			WRAMADDR,		///< RAM リード／ライト・アドレス
-			HDAT0,			///< ストリーム・ヘッダ・データ０
-			HDAT1,			///< ストリーム・ヘッダ・データ１
+			WRAMADDR,		///< RAM リード／ライト・アドレス（録音：品質）
+			HDAT0,			///< ストリーム・ヘッダ・データ０（録音：データ）
+			HDAT1,			///< ストリーム・ヘッダ・データ１（録音：ワード数）
 			AIADDR,			///< アプリケーション開始アドレス
 			VOL,			///< ボリューム制御
-			AICTRL0,   		///< アプリケーション制御レジスタ０
-			AICTRL1,		///< アプリケーション制御レジスタ１
-			AICTRL2,		///< アプリケーション制御レジスタ２
-			AICTRL3			///< アプリケーション制御レジスタ３
+			AICTRL0,   		///< アプリケーション制御レジスタ０（録音：サンプルレート）
+			AICTRL1,		///< アプリケーション制御レジスタ１（録音：ゲイン）
+			AICTRL2,		///< アプリケーション制御レジスタ２（録音：AGC 最大ゲイン）
+			AICTRL3			///< アプリケーション制御レジスタ３（録音：モード）
 		};
 
-		bool	pause_;
+		static constexpr uint16_t SM_RESET   = 0x0004;
+		static constexpr uint16_t SM_CANCEL  = 0x0008;
+		static constexpr uint16_t SM_SDINEW  = 0x0800;
+		static constexpr uint16_t SM_ENCODE  = 0x1000;
+		static constexpr uint16_t SM_LINE1   = 0x4000;
+		static constexpr uint16_t MODE_INIT  = SM_SDINEW | SM_LINE1;
 
-		inline void sleep_() { asm("nop"); }
+		static constexpr uint16_t PARA_END_FILL = 0x1e06;	///< endFillByte のアドレス
+		static constexpr uint32_t BURST = 32;				///< DREQ １回で送れるバイト数
+		static constexpr uint32_t REC_RISK = 768;			///< 録音 FIFO が溢れる恐れのあるワード数（少なめ）
+
+		static constexpr uint32_t IRQN = static_cast<uint32_t>(IRQV) - static_cast<uint32_t>(device::ICU::VECTOR::IRQ0);
+		static constexpr uint8_t IRQMD_POSITIVE = 0b10;		///< 立ち上がりエッジ
+
+		struct buff_t {
+			uint8_t		data[BUFF_SIZE];
+			volatile uint16_t	len;
+			volatile bool		full;
+		};
+
+		CSI&	csi_;
+
+		static inline VS1063*	self_;
+
+		buff_t	buff_[2];
+		volatile uint8_t	rd_;	///< 読み出し側（再生：SDI、録音：ファイル）
+		volatile uint8_t	wr_;	///< 書き込み側（再生：ファイル、録音：SCI）
+		volatile uint16_t	pos_;	///< 割り込み側の位置
 
+		FIL*	fp_;
 
-		inline bool get_status_()
+		volatile STATE	state_;
+		volatile bool	pause_;
+		volatile bool	eof_;
+		volatile bool	starve_;
+		volatile bool	lock_;
+		volatile bool	stall_;	///< 録音で、両方のバッファが書き込み待ち
+		bool			share_;	///< SD カードと SPI を共有
+
+		volatile uint32_t	underrun_;
+		volatile uint32_t	overrun_;
+
+		uint8_t		volume_;
+
+		static inline device::ICU::irqcrn_t<0x0008'7500 + IRQN>	IRQCR_;
+
+		// DREQ の立ち上がり
+		static INTERRUPT_FUNC void dreq_task_() noexcept
 		{
-			return REQ::P();
+			self_->feed_();
 		}
 
+		inline void sleep_() { asm("nop"); }
+
 
 		inline void wait_ready_()
 		{
@@ -77,7 +164,7 @@ namespace chip {
 		}
 
 
-		void write_(CMD cmd, uint16_t data)
+		void sci_write_(CMD cmd, uint16_t data)
 		{
 			wait_ready_();
 
@@ -90,7 +177,7 @@ namespace chip {
 		}
 
 
-		uint16_t read_(CMD cmd)
+		uint16_t sci_read_(CMD cmd)
 		{
 			wait_ready_();
 
@@ -98,55 +185,278 @@ namespace chip {
 			SEL::P = 0;
 			csi_.xchg(0x03);	// Read command (0x03)
 			csi_.xchg(static_cast<uint8_t>(cmd));
-			data  = static_cast<uint16_t>(CSI::xchg()) << 8;
+			data  = static_cast<uint16_t>(csi_.xchg()) << 8;
 			data |= csi_.xchg();
 			SEL::P = 1;
 			return data;
 		}
 
-		bool probe_mp3_(FIL* fp)
+
+		// メイン側から SCI を使う時は、割り込み側（DREQ、rec_poll）を止める
+		void write_(CMD cmd, uint16_t data)
 		{
-			UINT len;
-			if(f_read(fp, buff_, 10, &len) != FR_OK) {
-				return false;
+			lock_ = true;
+			sci_write_(cmd, data);
+			lock_ = false;
+			if(starve_) kick_();
+		}
+
+
+		uint16_t read_(CMD cmd)
+		{
+			lock_ = true;
+			auto data = sci_read_(cmd);
+			lock_ = false;
+			if(starve_) kick_();
+			return data;
+		}
+
+
+		// DREQ が立っている間、32 バイトずつ送る（割り込み）
+		void feed_() noexcept
+		{
+			if(state_ != STATE::PLAY || pause_ || lock_) {
+				starve_ = true;
+				return;
 			}
-			if(len != 10) {
-				return false;
+			while(REQ::P()) {
+				auto& b = buff_[rd_];
+				if(!b.full) {
+					if(!eof_) ++underrun_;
+					starve_ = true;
+					return;
+				}
+				uint32_t n = b.len - pos_;
+				if(n > BURST) n = BURST;
+				DCS::P = 0;
+				csi_.send(&b.data[pos_], n);
+				DCS::P = 1;
+				pos_ = pos_ + n;
+				if(pos_ >= b.len) {
+					pos_ = 0;
+					b.full = false;
+					rd_ ^= 1;
+				}
 			}
+		}
 
-			if(buff_[0] == 'I' && buff_[1] == 'D' && buff_[2] == '3') ;
-			else {
-				return false;
+
+		// DREQ の割り込みを止めて送る（エッジを逃した場合）
+		void kick_() noexcept
+		{
+			device::ICU::IER.enable(IRQV, false);
+			starve_ = false;
+			feed_();
+			device::ICU::IER.enable(IRQV, true);
+		}
+
+
+		// 録音データを取り出す（lock_ の状態で呼ぶ）
+		void drain_() noexcept
+		{
+			uint32_t words = sci_read_(CMD::HDAT1);
+			uint32_t pos = pos_;
+			while(words > 0) {
+				auto& b = buff_[wr_];
+				if(b.full) {
+					// 両方のバッファが書き込み待ち：データは VS1063 の FIFO に残るので、
+					// FIFO が溢れそうになった時だけ、１回数える
+					if(words >= REC_RISK && !stall_) {
+						++overrun_;
+						stall_ = true;
+					}
+					break;
+				}
+				stall_ = false;
+				while(words > 0 && (pos + 2) <= BUFF_SIZE) {
+					auto w = sci_read_(CMD::HDAT0);
+					b.data[pos + 0] = w >> 8;
+					b.data[pos + 1] = w & 0xff;
+					pos += 2;
+					--words;
+				}
+				if(pos >= BUFF_SIZE) {
+					b.len = pos;
+					b.full = true;
+					wr_ ^= 1;
+					pos = 0;
+				}
 			}
+			pos_ = pos;
+		}
 
-			// skip TAG
-			uint32_t ofs = static_cast<uint32_t>(buff_[6]) << 21;
-			ofs |= static_cast<uint32_t>(buff_[7]) << 14;
-			ofs |= static_cast<uint32_t>(buff_[8]) << 7;
-			ofs |= static_cast<uint32_t>(buff_[9]);
-			f_lseek(fp, ofs);
 
-			utils::format("Find ID3 tag skip: %d\n") % ofs;
+		// SD カードと SPI を共有する場合、ファイル操作の間、割り込み側を止める
+		void share_lock_(bool ena) noexcept
+		{
+			if(!share_) return;
+			lock_ = ena;
+			if(!ena && starve_) kick_();
+		}
 
-			return true;
+
+		void reset_buff_() noexcept
+		{
+			buff_[0].full = false;
+			buff_[1].full = false;
+			rd_ = 0;
+			wr_ = 0;
+			pos_ = 0;
+			eof_ = false;
+			starve_ = false;
+			stall_ = false;
+		}
+
+
+		void init_regs_()
+		{
+			sci_write_(CMD::MODE, MODE_INIT);
+			sci_write_(CMD::CLOCKF, 0x9800);  // 12.288MHz
+			utils::delay::milli_second(10);
+			sci_write_(CMD::VOL, ((volume_ ^ 0xff) << 8) | (volume_ ^ 0xff));
+		}
+
+
+		void soft_reset_()
+		{
+			sci_write_(CMD::MODE, MODE_INIT | SM_RESET);
+			utils::delay::milli_second(2);
+			init_regs_();
+		}
+
+
+		// endFillByte を送る（SM_CANCEL の時は、解除されるまで）
+		bool end_fill_(uint32_t len, bool cancel)
+		{
+			sci_write_(CMD::WRAMADDR, PARA_END_FILL);
+			uint8_t tmp[BURST];
+			auto fill = static_cast<uint8_t>(sci_read_(CMD::WRAM) & 0xff);
+			for(uint32_t i = 0; i < BURST; ++i) tmp[i] = fill;
+
+			while(len > 0) {
+				wait_ready_();
+				uint32_t n = len > BURST ? BURST : len;
+				DCS::P = 0;
+				csi_.send(tmp, n);
+				DCS::P = 1;
+				len -= n;
+				if(cancel && (sci_read_(CMD::MODE) & SM_CANCEL) == 0) {
+					return true;
+				}
+			}
+			return !cancel;
+		}
+
+
+		void finish_play_(bool cancel)
+		{
+			device::ICU::IER.enable(IRQV, false);
+			state_ = STATE::IDLE;
+			lock_ = true;
+			if(cancel) {
+				sci_write_(CMD::MODE, MODE_INIT | SM_CANCEL);
+				if(!end_fill_(2048, true)) {
+					soft_reset_();
+				}
+			} else {
+				end_fill_(2052, false);
+				sci_write_(CMD::MODE, MODE_INIT | SM_CANCEL);
+				if(!end_fill_(2048, true)) {
+					soft_reset_();
+				}
+			}
+			lock_ = false;
+			reset_buff_();
+		}
+
+
+		bool write_file_(const buff_t& b)
+		{
+			UINT bw;
+			if(f_write(fp_, b.data, b.len, &bw) != FR_OK) return false;
+			return bw == b.len;
+		}
+
+
+		void finish_record_()
+		{
+			lock_ = true;
+			sci_write_(CMD::MODE, sci_read_(CMD::MODE) | SM_CANCEL);
+			// SM_ENCODE が消えるまで取り出す
+			while(1) {
+				drain_();
+				if(buff_[rd_].full) {
+					write_file_(buff_[rd_]);
+					buff_[rd_].full = false;
+					rd_ ^= 1;
+				}
+				if((sci_read_(CMD::MODE) & SM_ENCODE) == 0) break;
+			}
+			drain_();
+			for(uint32_t i = 0; i < 2; ++i) {
+				if(buff_[rd_].full) {
+					write_file_(buff_[rd_]);
+					buff_[rd_].full = false;
+					rd_ ^= 1;
+				}
+			}
+			if(pos_ > 0) {
+				auto& b = buff_[wr_];
+				b.len = pos_;
+				write_file_(b);
+			}
+			state_ = STATE::IDLE;
+			soft_reset_();
+			lock_ = false;
+			reset_buff_();
+		}
+
+
+		bool probe_mp3_(FIL* fp)
+		{
+			UINT len;
+			uint8_t tmp[10];
+			if(f_read(fp, tmp, 10, &len) != FR_OK) {
+				return false;
+			}
+			if(len == 10 && tmp[0] == 'I' && tmp[1] == 'D' && tmp[2] == '3') {
+				// skip TAG
+				uint32_t ofs = static_cast<uint32_t>(tmp[6] & 0x7f) << 21;
+				ofs |= static_cast<uint32_t>(tmp[7] & 0x7f) << 14;
+				ofs |= static_cast<uint32_t>(tmp[8] & 0x7f) << 7;
+				ofs |= static_cast<uint32_t>(tmp[9] & 0x7f);
+				return f_lseek(fp, ofs + 10) == FR_OK;
+			}
+			return f_lseek(fp, 0) == FR_OK;
 		}
 
 	public:
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  コンストラクター
+			@param[in]	csi		CSI(SPI) 制御クラス
 		*/
 		//-----------------------------------------------------------------//
-		VS1063(CSI& csi) : csi_(csi), frame_(0), pause_(false) { }
+		VS1063(CSI& csi) noexcept : csi_(csi), buff_{ }, rd_(0), wr_(0), pos_(0),
+			fp_(nullptr), state_(STATE::IDLE), pause_(false), eof_(false), starve_(false), lock_(false),
+			stall_(false), share_(false), underrun_(0), overrun_(0), volume_(255)
+		{ }
 
 
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  開始（初期化）
+			@param[in]	level	DREQ 割り込みレベル
+			@param[in]	order	IRQ 端子のオーダー
+			@return 失敗なら「false」
 		*/
 		//-----------------------------------------------------------------//
-		void start()
+		bool start(device::ICU::LEVEL level, device::port_map_irq::ORDER order = device::port_map_irq::ORDER::FIRST)
 		{
+			if(level == device::ICU::LEVEL::NONE) return false;
+
+			self_ = this;
+
 			SEL::DIR = 1;  // output
 			SEL::PU  = 0;
 
@@ -155,65 +465,97 @@ namespace chip {
 
 			REQ::DIR = 0;  // input
 			REQ::PU  = 0;
-	
+
 			SEL::P = 1;  // /xCS = H
 			DCS::P = 1;  // /xDCS = H
 
 			uint8_t intr_level = 0;
-			if(!csi_.start(500000, CSI::PHASE::TYPE4, intr_level)) {
-				utils::format("CSI1 Start fail ! (Clock spped over range)\n");
-				return;
+			if(!csi_.start(500000, CSI::PHASE::TYPE4, CSI::DLEN::W8, intr_level)) {
+				return false;
 			}
 
-///	   		write_(CMD::MODE, 0x4840);
-	   		write_(CMD::MODE, 0x4800);
-			write_(CMD::VOL,  0x4040);  // volume
-
-			write_(CMD::CLOCKF, 0x9800);  // 12.288MHz 
-//			write_(CMD::CLOCKF, 0x8BE8);  // 12MHz OSC 補正
+			init_regs_();
 
+			if(!csi_.start(8000000, CSI::PHASE::TYPE4, CSI::DLEN::W8, intr_level)) {
+				return false;
+			}
 			utils::delay::milli_second(10);
 
-			if(!csi_.start(8000000, CSI::PHASE::TYPE4, intr_level)) {
-				utils::format("CSI1 Start fail ! (Clock spped over range)\n");
-				return;
+			device::icu_mgr::set_level(IRQV, device::ICU::LEVEL::NONE);
+			if(!device::port_map_irq::turn(IRQV, true, order)) {
+				return false;
 			}
-			utils::delay::milli_second(10);
+			IRQCR_.IRQMD = IRQMD_POSITIVE;
+			device::ICU::IR[IRQV] = 0;
+			device::icu_mgr::set_interrupt(IRQV, dreq_task_, level);
 
-			set_volume(255);
+			return true;
 		}
 
 
 		//----------------------------------------------------------------//
 		/*!
-			@brief  サービス
+			@brief  サービス（メインループから呼ぶ、待たない） @n
+					再生：空いたバッファにファイルを読む、最後まで送ったら終了処理 @n
+					録音：データを取り出し、一杯になったバッファをファイルに書く
+			@return 停止したら「false」
 		*/
 		//----------------------------------------------------------------//
-		bool service(FIL* fp)
+		bool service()
 		{
-			UINT len;
-			if(f_read(fp, buff_, sizeof(buff_), &len) != FR_OK) {
-				return false;
-			}
-			if(len == 0) return false;
+			switch(state_) {
+			case STATE::PLAY:
+				for(uint32_t i = 0; i < 2; ++i) {
+					auto& b = buff_[wr_];
+					if(b.full || eof_) break;
+					UINT len;
+					share_lock_(true);
+					auto ret = f_read(fp_, b.data, BUFF_SIZE, &len);
+					share_lock_(false);
+					if(ret != FR_OK || len == 0) {
+						eof_ = true;
+						break;
+					}
+					b.len = len;
+					b.full = true;
+					wr_ ^= 1;
+				}
+				if(starve_) kick_();
+				if(eof_ && !buff_[0].full && !buff_[1].full) {
+					finish_play_(false);
+				}
+				break;
+
+			case STATE::RECORD:
+				rec_poll();
+				if(buff_[rd_].full) {
+					share_lock_(true);
+					auto ret = write_file_(buff_[rd_]);
+					share_lock_(false);
+					if(!ret) {
+						finish_record_();
+						break;
+					}
+					buff_[rd_].full = false;
+					rd_ ^= 1;
+				}
+				break;
 
-			const uint8_t* p = buff_;
-			while(len > 0) {
-				while(get_status_() == 0) ;
-				uint16_t l = 32;
-				if(l > len) l = len; 
-				csi_.send(p, l);
-				p += l;
-				len -= l;
+			default:
+				break;
 			}
-
-			return true;
+			return state_ != STATE::IDLE;
 		}
 
 
 		//----------------------------------------------------------------//
 		/*!
-			@brief  再生
+			@brief  再生開始 @n
+					DREQ の割り込みは、その中で CSI（SPI）を使って SDI に送る。 @n
+					SD カードが同じ SPI を使う場合、SD カードの転送の途中に割り込む @n
+					ので、set_bus_share(true) とし、service() 以外で SD カードを @n
+					使う間は lock_bus() で止める事。 @n
+					※終わるまで、ファイルを閉じてはならない。
 			@param[in]	fp	ファイル・ディスクリプタ
 			@return エラーなら「false」
 		*/
@@ -222,53 +564,189 @@ namespace chip {
 		{
 			if(fp == nullptr) return false;
 
-			// ファイル・フォーマットを確認
+			stop();
+
+			// ID3 タグを飛ばす
 			if(!probe_mp3_(fp)) {
-				f_close(fp);
 				return false;
 			}
 
-			{
-				frame_ = 0;
-				pause_ = false;
-				DCS::P = 0;
-				while(1) {
-					if(!pause_) {
-						if(!service(fp)) break;
-
-						++frame_;
-						if(frame_ >= 40) {
-							device::P4.B3 = !device::P4.B3();
-							frame_ = 0;
-						}
-					} else {
-						if(frame_ < 192) {
-							device::P4.B3 = (frame_ >> 5) & 1;
-						} else {
-							device::P4.B3 = 1;
-						}
-						utils::delay::milli_second(2);
-						++frame_;
-					}
+			fp_ = fp;
+			reset_buff_();
+			pause_ = false;
+			state_ = STATE::PLAY;
+			service();  // 先読み
+			kick_();
 
-					if(sci_length()) {
-						auto ch = sci_getch();
-						if(ch == '>') {
-							break;
-						} else if(ch == ' ') {
-							pause_ = !pause_;
-						}
-					}
-				}
-				DCS::P = 1;
-			}
+			return true;
+		}
 
-			f_close(fp);
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  録音開始 @n
+					※止めるまで、ファイルを閉じてはならない。
+			@param[in]	fp		ファイル・ディスクリプタ（書き込み）
+			@param[in]	rate	サンプルレート [Hz]
+			@param[in]	fmt		フォーマット
+			@param[in]	ch		チャネル
+			@param[in]	quality	品質（SCI_RECQUALITY、標準：MP3 CBR 128Kbps）
+			@param[in]	gain	ゲイン（1024 で１倍、０なら AGC）
+			@return エラーなら「false」
+		*/
+		//----------------------------------------------------------------//
+		bool record(FIL* fp, uint16_t rate, REC_FORMAT fmt, REC_CH ch, uint16_t quality = 0xE080, uint16_t gain = 0)
+		{
+			if(fp == nullptr) return false;
+
+			stop();
+
+			fp_ = fp;
+			reset_buff_();
+
+			lock_ = true;
+			sci_write_(CMD::AICTRL0, rate);
+			sci_write_(CMD::AICTRL1, gain);
+			sci_write_(CMD::AICTRL2, 4096);  // AGC 最大４倍
+			sci_write_(CMD::AICTRL3, (static_cast<uint16_t>(fmt) << 4) | static_cast<uint16_t>(ch));
+			sci_write_(CMD::WRAMADDR, quality);
+			sci_write_(CMD::MODE, MODE_INIT | SM_ENCODE);
+			sci_write_(CMD::AIADDR, 0x0050);  // エンコーダー起動
+			state_ = STATE::RECORD;
+			lock_ = false;
 
 			return true;
 		}
 
 
+		//----------------------------------------------------------------//
+		/*!
+			@brief  録音データの取り出し @n
+					タイマー割り込みから呼べば、ファイルの書き込み中も取り出せる。 @n
+					※メイン側が SCI を使っている間は何もしない。 @n
+					※SD カードと同じ SPI を使う場合、割り込みから呼んではならない。
+		*/
+		//----------------------------------------------------------------//
+		void rec_poll() noexcept
+		{
+			if(state_ != STATE::RECORD || lock_) return;
+			lock_ = true;
+			drain_();
+			lock_ = false;
+		}
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  停止（再生はキャンセル、録音は残りを書いて終了）
+		*/
+		//----------------------------------------------------------------//
+		void stop()
+		{
+			if(state_ == STATE::PLAY) {
+				finish_play_(true);
+			} else if(state_ == STATE::RECORD) {
+				finish_record_();
+			}
+		}
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  SD カードと SPI を共有するか設定 @n
+					共有する場合、service() のファイル操作の間、DREQ の送出と @n
+					録音データの取り出しを止める。
+			@param[in]	share	共有する場合「true」
+		*/
+		//----------------------------------------------------------------//
+		void set_bus_share(bool share = true) noexcept { share_ = share; }
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  SPI バスのロック（共有する SD カードを、service() 以外で使う場合） @n
+					ロックの間は DREQ に送らず、解除で再開する。
+			@param[in]	ena		解除する場合「false」
+		*/
+		//----------------------------------------------------------------//
+		void lock_bus(bool ena = true) noexcept
+		{
+			lock_ = ena;
+			if(!ena && starve_) kick_();
+		}
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  一時停止
+			@param[in]	ena		再開する場合「false」
+		*/
+		//----------------------------------------------------------------//
+		void pause(bool ena = true)
+		{
+			pause_ = ena;
+			if(!ena && starve_) kick_();
+		}
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  一時停止中か？
+			@return 一時停止中なら「true」
+		*/
+		//----------------------------------------------------------------//
+		bool is_pause() const { return pause_; }
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  状態を取得
+			@return 状態
+		*/
+		//----------------------------------------------------------------//
+		STATE get_state() const { return state_; }
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  再生時間を取得
+			@return 再生時間［秒］
+		*/
+		//----------------------------------------------------------------//
+		uint16_t get_decode_time() { return read_(CMD::DECODE_TIME); }
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  アンダーラン回数（再生で DREQ に間に合わなかった）
+			@return アンダーラン回数
+		*/
+		//----------------------------------------------------------------//
+		uint32_t get_underrun() const { return underrun_; }
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  オーバーラン回数（録音で両方のバッファが書き込み待ちの間に、 @n
+					VS1063 の FIFO が溢れそうになった）
+			@return オーバーラン回数
+		*/
+		//----------------------------------------------------------------//
+		uint32_t get_overrun() const { return overrun_; }
+
+
+		//----------------------------------------------------------------//
+		/*!
+			@brief  アンダーラン、オーバーラン回数をクリア
+		*/
+		//----------------------------------------------------------------//
+		void clear_count()
+		{
+			underrun_ = 0;
+			overrun_ = 0;
+		}
+
+
 		//----------------------------------------------------------------//
 		/*!
 			@brief  ボリュームを設定
@@ -277,6 +755,7 @@ namespace chip {
 		//----------------------------------------------------------------//
 		void set_volume(uint8_t vol)
 		{
+			volume_ = vol;
 			vol ^= 0xff;
 			write_(CMD::VOL, (vol << 8) | vol);
 		}
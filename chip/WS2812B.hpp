@@ -4,57 +4,232 @@
 	@brief	WS2812B class @n
 			WorldSemi @n
 			Intelligent control LED integrated light source @n
-			http://www.world-semi.com/Certifications/WS2812B.html
-	@copyright	Copyright (C) 2022 Kunihito Hiramatsu @n
+			http://www.world-semi.com/Certifications/WS2812B.html @n
+			・MTU の PWM モード２（周期：TGRA、出力：TGRB）で 800KHz を作る。 @n
+			・周期のコンペア・マッチで DMAC を起動し、次のビットのデューティーを @n
+			  TGRB に書く（CPU はビット毎の処理をしない）。 @n
+			・デューティーは小さなリング・バッファに置き、CMT の割り込みで @n
+			  DMA の転送位置を見ながら、続きを変換する（RAM は LED 数によらない）。 @n
+			・最後のビットの後は出力を Low にして、リセット時間を待つ。 @n
+			・送信していない間は、CMT を止める。
+	@copyright	Copyright (C) 2022, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 	@author	平松邦仁 (hira@rvf-rc45.net)
 */
 //=========================================================================//
 #include <cstdint>
+#include "common/cmt_mgr.hpp"
+#include "chip/WS2812B_ENC.hpp"
 
 namespace chip {
 
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  WS2812B テンプレートクラス
-		@param[in]	MTU_IO	MTU/GPT I/O クラス（PWM)
+		@param[in]	MTU_IO		MTU I/O クラス（PWM、device::mtu_io）
+		@param[in]	DMAC		DMAC チャネル
+		@param[in]	CMT			変換、リセット時間用 CMT チャネル
+		@param[in]	RING_SLOTS	リング・バッファのスロット数（２のべき乗）
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <class MTU_IO>
+	template <class MTU_IO, class DMAC, class CMT, uint32_t RING_SLOTS = 256>
 	class WS2812B {
+	public:
+		typedef typename MTU_IO::mtu_type MTU;
+
+		static_assert((RING_SLOTS & (RING_SLOTS - 1)) == 0 && RING_SLOTS >= 64, "RING_SLOTS must be a power of 2 (64 or more)");
+		static_assert(!MTU::TGR32, "16 bits TGR only");
+
+		static constexpr uint32_t FREQ = 800'000;	///< ビット・レート
+		static constexpr uint32_t RING_BYTES = RING_SLOTS * sizeof(uint16_t);	///< リング・バッファのバイト数
+		static constexpr uint32_t FILL_FREQ = FREQ * 4 / RING_SLOTS;	///< 変換の周期（リング１周に４回）
+		static constexpr uint32_t SLOT_MAX = 65535;	///< 一回で送れる最大スロット数（DMA の転送回数）
+
+	private:
+		// TIOR：初期出力０、コンペア・マッチで０（Low 固定）
+		static constexpr uint8_t TIOR_LOW = 0b0001;
 
 		MTU_IO&		mtu_io_;
 
-		void output_(uint8_t n)
+		static inline WS2812B_ENC	enc_;
+
+		alignas(RING_BYTES) static inline uint16_t	ring_[RING_SLOTS];
+
+		static inline volatile uint32_t	wpos_;
+		static inline volatile uint32_t	total_;
+		static inline volatile uint32_t	reset_;
+		static inline volatile uint32_t	underrun_;
+		static inline volatile bool		send_;
+		static inline volatile bool		busy_;
+
+		// DMA が読み終えたスロットの分だけ、続きを変換する
+		static void fill_() noexcept
 		{
+			uint32_t done = total_ - (DMAC::DMCRA() & 0xffff);
+			if(done > wpos_) {
+				++underrun_;
+			}
+			auto lim = done + RING_SLOTS;
+			if(lim > total_) lim = total_;
+			while(wpos_ < lim) {
+				auto ofs = wpos_ & (RING_SLOTS - 1);
+				auto n = lim - wpos_;
+				if(n > (RING_SLOTS - ofs)) n = RING_SLOTS - ofs;
+				enc_.encode(&ring_[ofs], n);
+				wpos_ = wpos_ + n;
+			}
 		}
 
+		struct fill_task {
+			void operator() () noexcept
+			{
+				if(send_) {
+					fill_();
+				} else if(reset_ > 0) {
+					reset_ = reset_ - 1;
+					if(reset_ == 0) {
+						busy_ = false;
+						CMT::enable(false);  // 次の send() まで止める
+					}
+				} else {
+					CMT::enable(false);
+				}
+			}
+		};
+
+		// 最後のスロットを書いた（最後の Low のスロットを出力中）
+		struct dma_task {
+			void operator() () noexcept
+			{
+				MTU::enable(false);
+				MTU::TIOR.set(MTU::CHANNEL::B, TIOR_LOW);
+				send_ = false;
+				reset_ = (WS2812B_ENC::RESET_US * FILL_FREQ + 999'999) / 1'000'000 + 1;
+			}
+		};
+
+		typedef device::cmt_mgr<CMT, fill_task> CMT_MGR;
+		typedef device::dmac_mgr<DMAC, dma_task> DMA_MGR;
+
+		CMT_MGR		cmt_mgr_;
+		DMA_MGR		dma_mgr_;
+
+		device::ICU::LEVEL	level_;
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	コンストラクタ
-			@param[in]	mtu_io		MTU/GPT I/O クラス
+			@param[in]	mtu_io		MTU I/O クラス
 		 */
 		//-----------------------------------------------------------------//
-		WS2812B(MTU_IO& mtu_io) noexcept : mtu_io_(mtu_io)
+		WS2812B(MTU_IO& mtu_io) noexcept : mtu_io_(mtu_io), cmt_mgr_(), dma_mgr_(),
+			level_(device::ICU::LEVEL::NONE)
 		{ }
 
 
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	開始
+			@param[in]	level	割り込みレベル（DMA 終了、CMT）
+			@param[in]	order	出力ポート（MTIOCxB）のオーダー
 			@return エラーがあれば「false」を返す。
 		 */
 		//-----------------------------------------------------------------//
-		bool start() noexcept
+		bool start(device::ICU::LEVEL level, device::port_map_mtu::ORDER order = device::port_map_mtu::ORDER::FIRST) noexcept
 		{
-			// PWM 周期設定（800KHz）
-			// mtu_io_.
+			if(level == device::ICU::LEVEL::NONE) return false;
 
+			level_ = level;
+			send_ = false;
+			busy_ = false;
+			reset_ = 0;
+			underrun_ = 0;
 
+			// PWM 周期設定（800KHz）、周期のコンペア・マッチを DMA の起動要因にする
+			typename MTU_IO::port_t po(MTU::CHANNEL::B, MTU_IO::OUTPUT::H_TO_L, order);
+			if(!mtu_io_.start_pwm2(MTU::CHANNEL::A, FREQ, po, level)) {
+				return false;
+			}
+			MTU::rw_enable();  // DMA で TGRB を書く
+			MTU::enable(false);
+			MTU::TIOR.set(MTU::CHANNEL::B, TIOR_LOW);
+			enc_.set_timing(static_cast<uint32_t>(MTU::TGR[MTU::CHANNEL::A]) + 1);
+
+			if(!cmt_mgr_.start(FILL_FREQ, level)) {
+				return false;
+			}
+			cmt_mgr_.enable(false);  // 送信中だけ動かす
 			return true;
 		}
-	};
 
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送信開始 @n
+					※送信が終わるまで、ソースを書き換えてはならない。
+			@param[in]	src		ソース（G, R, B の順、LED 数 x 3 バイト）
+			@param[in]	num		LED 数
+			@return 送信中、LED 数が多すぎる場合「false」
+		 */
+		//-----------------------------------------------------------------//
+		bool send(const uint8_t* src, uint32_t num) noexcept
+		{
+			if(busy_ || num == 0 || (num * 24 + 1) > SLOT_MAX) return false;
+
+			enc_.begin(src, num * 3);
+			total_ = enc_.get_total();
+			wpos_ = enc_.encode(ring_, RING_SLOTS);
+
+			busy_ = true;
+			send_ = true;
+
+			// 最初のビットは直接書き、２番目から DMA で送る
+			MTU::TCNT = 0;
+			MTU::TGR[MTU::CHANNEL::B] = ring_[0];
+			auto vec = mtu_io_.get_intr_vec();
+			device::ICU::IR[vec] = 0;
+			dma_mgr_.start(DMA_MGR::TRANS_MODE::NORMAL, DMA_MGR::TRANS_TYPE::SP_DN_16, vec,
+				reinterpret_cast<uint32_t>(&ring_[1]), MTU::TGRB.address, 0, total_ - 1, level_);
+			// 転送元をリング・バッファ（拡張リピート・エリア）にする
+			DMAC::DMCNT.DTE = 0;
+			DMAC::DMAMD.SARA = __builtin_ctz(RING_BYTES);
+			DMAC::DMCNT.DTE = 1;
+
+			MTU::TIOR.set(MTU::CHANNEL::B, static_cast<uint8_t>(MTU_IO::OUTPUT::H_TO_L));
+			MTU::enable();
+			cmt_mgr_.enable();
+
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送信中（リセット時間を含む）か？
+			@return 送信中なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_busy() const noexcept { return busy_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変換が間に合わなかった回数を取得 @n
+					※０以外なら、割り込みレベルを上げるか、RING_SLOTS を大きくする。
+			@return 変換が間に合わなかった回数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_underrun() const noexcept { return underrun_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	エンコーダーの参照（ガンマ、明るさの設定）
+			@return エンコーダー
+		 */
+		//-----------------------------------------------------------------//
+		static auto& at_encoder() noexcept { return enc_; }
+	};
 }
@@ -0,0 +1,202 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	WS2812B ビット・ストリーム・エンコーダー @n
+			GRB のバイト列を、１ビット１スロットの PWM デューティー（タイマー・ @n
+			カウント）に変換する。 @n
+			・１ビットは 1.25us、「０」は 0.4us、「１」は 0.8us の High @n
+			・バイト毎に階調テーブル（ガンマ、明るさ）を通す。 @n
+			・任意のスロット数ずつ変換出来るので、小さなリング・バッファで @n
+			  長いストリップを送れる。 @n
+			※デバイスに依存しないので、ホストでも検証出来る。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+#include <cmath>
+
+namespace chip {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  WS2812B エンコーダー・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class WS2812B_ENC {
+	public:
+		static constexpr uint32_t PERIOD_NS = 1250;	///< １ビットの周期 [ns]
+		static constexpr uint32_t T0H_NS    = 400;	///< 「０」の High 時間 [ns]
+		static constexpr uint32_t T1H_NS    = 800;	///< 「１」の High 時間 [ns]
+		static constexpr uint32_t RESET_US  = 300;	///< リセット（ラッチ）時間 [us]
+
+	private:
+		uint8_t		tone_[256];
+		float		gamma_;
+		uint8_t		bright_;
+
+		uint16_t	t0_;
+		uint16_t	t1_;
+
+		const uint8_t*	src_;
+		uint32_t	bits_;
+		uint32_t	total_;
+		uint32_t	pos_;
+
+		void make_tone_() noexcept
+		{
+			for(uint32_t i = 0; i < 256; ++i) {
+				auto v = std::pow(static_cast<float>(i) / 255.0f, gamma_);
+				tone_[i] = static_cast<uint8_t>(v * static_cast<float>(bright_) + 0.5f);
+			}
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター（ガンマ 1.0、明るさ 255：値をそのまま送る）
+		 */
+		//-----------------------------------------------------------------//
+		WS2812B_ENC() noexcept : tone_{ }, gamma_(1.0f), bright_(255), t0_(0), t1_(0),
+			src_(nullptr), bits_(0), total_(0), pos_(0)
+		{
+			make_tone_();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	タイミングを設定
+			@param[in]	period	１ビットのカウント数（PWM 周期）
+		 */
+		//-----------------------------------------------------------------//
+		void set_timing(uint32_t period) noexcept
+		{
+			t0_ = (period * T0H_NS + PERIOD_NS / 2) / PERIOD_NS;
+			t1_ = (period * T1H_NS + PERIOD_NS / 2) / PERIOD_NS;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	「０」のデューティー（カウント）を取得
+			@return 「０」のデューティー
+		 */
+		//-----------------------------------------------------------------//
+		uint16_t get_t0() const noexcept { return t0_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	「１」のデューティー（カウント）を取得
+			@return 「１」のデューティー
+		 */
+		//-----------------------------------------------------------------//
+		uint16_t get_t1() const noexcept { return t1_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ガンマを設定
+			@param[in]	gamma	ガンマ値（1.0 ならリニア）
+		 */
+		//-----------------------------------------------------------------//
+		void set_gamma(float gamma) noexcept
+		{
+			gamma_ = gamma;
+			make_tone_();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	明るさを設定（階調テーブルの最大値）
+			@param[in]	bright	明るさ（０～２５５）
+		 */
+		//-----------------------------------------------------------------//
+		void set_brightness(uint8_t bright) noexcept
+		{
+			bright_ = bright;
+			make_tone_();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	階調テーブルを取得
+			@return 階調テーブル（256 エントリー）
+		 */
+		//-----------------------------------------------------------------//
+		const uint8_t* get_tone() const noexcept { return tone_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変換開始
+			@param[in]	src		ソース（G, R, B の順、送る順）
+			@param[in]	len		バイト数（LED 数 x 3）
+			@param[in]	tail	最後に付ける Low（デューティー０）のスロット数
+		 */
+		//-----------------------------------------------------------------//
+		void begin(const uint8_t* src, uint32_t len, uint32_t tail = 1) noexcept
+		{
+			src_ = src;
+			bits_ = len * 8;
+			total_ = bits_ + tail;
+			pos_ = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全スロット数を取得
+			@return 全スロット数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_total() const noexcept { return total_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	残りのスロット数を取得
+			@return 残りのスロット数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_remain() const noexcept { return total_ - pos_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	続きを変換
+			@param[out]	dst		デューティーの出力先
+			@param[in]	num		最大スロット数
+			@return 変換したスロット数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t encode(uint16_t* dst, uint32_t num) noexcept
+		{
+			auto n = total_ - pos_;
+			if(num > n) num = n;
+
+			uint32_t i = 0;
+			while(i < num && pos_ < bits_) {
+				uint32_t b = tone_[src_[pos_ >> 3]] << (pos_ & 7);
+				auto m = 8 - (pos_ & 7);
+				if(m > (num - i)) m = num - i;
+				pos_ += m;
+				while(m > 0) {
+					dst[i++] = (b & 0x80) ? t1_ : t0_;
+					b <<= 1;
+					--m;
+				}
+			}
+			while(i < num) {  // 最後は Low のまま（パルスを出さない）
+				dst[i++] = 0;
+				++pos_;
+			}
+			return num;
+		}
+	};
+}
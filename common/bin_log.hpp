@@ -0,0 +1,321 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	バイナリ・ログ（遅延フォーマット）クラス @n
+			・ターゲットでは文字列を生成せず、「フォーマット文字列のアドレス（ID）」、 @n
+			  「タイムスタンプ」、「引数の生データ」だけをリングバッファに積む。 @n
+			・文字列への変換は、ホスト側のデコーダー（bin_log_dec）が ELF を参照して行う。 @n
+			・フォーマット文字列は、呼び出し場所毎に「.bin_log.N」セクションに置かれる。 @n
+			  リンカー・スクリプトの .rodata に「KEEP(*(.bin_log*))」を加えると一つに纏まる。 @n
+			  ※テンプレート内の呼び出しでは、gcc がセクション指定を無視して .rodata に置く @n
+			  場合があるが、デコーダーは ELF の全てのアロケート・セクションを検索する。 @n
+			・引数は、コンパイル時に型と数を検査する（utils::cform_base）。 @n
+			  整数は３２ビットまで、浮動小数点は float に変換、文字列は複製する。 @n
+			・予約（書き込み位置の確保）だけ割り込みを禁止し、コピーは割り込み許可で行う @n
+			  ので、割り込みハンドラー内からも使える。 @n
+			Ex: @n
+			  typedef utils::bin_log<4096, CMT_MGR> BLOG; @n
+			  BLOG blog_; @n
+			  BIN_LOG(blog_, "ADC: %d, %d\n", ch, val); @n
+			  ... @n
+			  blog_.service(sci_);	// メインループで、SCI などへ送出
+			レコード形式（リトルエンディアン）： @n
+			  [0] 0xA5（確定マーク）、[1] レコード長、[2..5] ID、[6..9] タイムスタンプ、 @n
+			  [10..] 引数（%c：１バイト、%s：長さ＋文字列、その他：４バイト）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "common/format.hpp"
+
+#define BIN_LOG_STR2_(x) #x
+#define BIN_LOG_STR_(x) BIN_LOG_STR2_(x)
+
+// 呼び出し場所毎のフォーマット文字列（ID）、セクション名を分けるのは comdat との衝突を避ける為
+#define BIN_LOG_ID(s) ([]() noexcept -> const char* { \
+	static const char bin_log_form_[] __attribute__((section(".bin_log." BIN_LOG_STR_(__COUNTER__)))) = s; \
+	return bin_log_form_; }())
+
+// バイナリ・ログ出力
+#define BIN_LOG(blog, s, ...) (blog).put(UTILS_FORM(s), BIN_LOG_ID(s), ##__VA_ARGS__)
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  バイナリ・ログ・クラス
+		@param[in]	SIZE	バッファサイズ（２のべき乗、256 以上）
+		@param[in]	TIME	タイムスタンプ（static get_counter() を持つ型、cmt_mgr など）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t SIZE, class TIME>
+	class bin_log {
+
+		static_assert(SIZE >= 256 && (SIZE & (SIZE - 1)) == 0, "SIZE must be power of 2 (256 or more)");
+
+	public:
+		static constexpr uint8_t  MARK = 0xA5;			///< 確定マーク
+		static constexpr uint32_t HEAD_SIZE = 10;		///< ヘッダーサイズ
+		static constexpr uint32_t RECORD_MAX = 255;		///< レコードの最大長
+		static constexpr uint32_t STR_MAX = 64;			///< 文字列の最大長
+
+	private:
+		static constexpr uint32_t MASK = SIZE - 1;
+
+		uint8_t				buf_[SIZE];
+		volatile uint32_t	resv_;	// 予約位置（フリーラン）
+		uint32_t			ready_;	// 確定済み位置
+		volatile uint32_t	get_;	// 送出済み位置
+		volatile uint32_t	lost_;
+
+		static uint32_t lock_() noexcept
+		{
+#ifdef __RX__
+			uint32_t psw;
+			asm volatile ("mvfc psw,%0\n\tclrpsw i" : "=r"(psw) : : "memory");
+			return psw;
+#else
+			return 0;
+#endif
+		}
+
+		static void unlock_(uint32_t psw) noexcept
+		{
+#ifdef __RX__
+			asm volatile ("mvtc %0,psw" : : "r"(psw) : "memory");
+#else
+			(void)psw;
+#endif
+		}
+
+		static constexpr bool is_float_(char conv) noexcept
+		{
+			switch(conv) {
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+				return true;
+			default:
+				return false;
+			}
+		}
+
+		template <class INFO>
+		static constexpr uint32_t str_num_() noexcept
+		{
+			uint32_t n = 0;
+			for(uint32_t i = 0; i < INFO::ARGS; ++i) {
+				if(INFO::table.arg_conv[i] == 's') ++n;
+			}
+			return n;
+		}
+
+		// 文字列以外の引数のサイズ
+		template <class INFO>
+		static constexpr uint32_t fixed_size_() noexcept
+		{
+			uint32_t n = HEAD_SIZE;
+			for(uint32_t i = 0; i < INFO::ARGS; ++i) {
+				auto c = INFO::table.arg_conv[i];
+				if(c == 'c' || c == 's') ++n;
+				else n += 4;
+			}
+			return n;
+		}
+
+		template <class INFO>
+		static constexpr uint32_t str_max_() noexcept
+		{
+			constexpr auto n = str_num_<INFO>();
+			if(n == 0) return 0;
+			auto l = (RECORD_MAX - fixed_size_<INFO>()) / n;
+			return l > STR_MAX ? STR_MAX : l;
+		}
+
+		template <typename T>
+		static const char* c_str_(const T& t) noexcept
+		{
+			if constexpr (std::is_same<T, std::string>::value) {
+				return t.c_str();
+			} else if constexpr (std::is_array<T>::value) {
+				return t;
+			} else {
+				return t != nullptr ? t : "";
+			}
+		}
+
+		template <char CONV, uint32_t SMAX, typename T>
+		static uint32_t arg_size_(const T& t) noexcept
+		{
+			if constexpr (CONV == 's') {
+				return 1 + strnlen(c_str_(t), SMAX);
+			} else if constexpr (CONV == 'c') {
+				return 1;
+			} else {
+				return 4;
+			}
+		}
+
+		void copy_(uint32_t& pos, const void* src, uint32_t len) noexcept
+		{
+			auto p = static_cast<const uint8_t*>(src);
+			for(uint32_t i = 0; i < len; ++i) {
+				buf_[pos & MASK] = p[i];
+				++pos;
+			}
+		}
+
+		template <char CONV, uint32_t SMAX, typename T>
+		void put_arg_(uint32_t& pos, const T& t) noexcept
+		{
+			typedef typename std::decay<T>::type D;
+			if constexpr (CONV == 's') {
+				auto s = c_str_(t);
+				uint8_t l = strnlen(s, SMAX);
+				buf_[pos & MASK] = l;
+				++pos;
+				copy_(pos, s, l);
+			} else if constexpr (CONV == 'c') {
+				buf_[pos & MASK] = static_cast<uint8_t>(t);
+				++pos;
+			} else if constexpr (is_float_(CONV)) {
+				float v = t;
+				copy_(pos, &v, 4);
+			} else if constexpr (CONV == 'p') {
+				uint32_t v = reinterpret_cast<uintptr_t>(t);
+				copy_(pos, &v, 4);
+			} else {
+				static_assert(sizeof(D) <= 4, "bin_log: 64 bits integer is not supported");
+				uint32_t v;
+				if constexpr (std::is_signed<D>::value) {
+					v = static_cast<int32_t>(t);
+				} else {
+					v = static_cast<uint32_t>(t);
+				}
+				copy_(pos, &v, 4);
+			}
+		}
+
+		template <class INFO, typename... Args, size_t... I>
+		uint32_t size_(std::index_sequence<I...>, const Args&... args) noexcept
+		{
+			return (HEAD_SIZE + ... + arg_size_<INFO::table.arg_conv[I], str_max_<INFO>()>(args));
+		}
+
+		template <class INFO, typename... Args, size_t... I>
+		void put_args_(uint32_t& pos, std::index_sequence<I...>, const Args&... args) noexcept
+		{
+			(put_arg_<INFO::table.arg_conv[I], str_max_<INFO>()>(pos, args), ...);
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		bin_log() noexcept : buf_{ }, resv_(0), ready_(0), get_(0), lost_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	レコードを積む（BIN_LOG マクロから呼ぶ） @n
+					バッファに空きが無い場合は捨てて、ロスト数を数える。
+			@param[in]	fs		フォーマット文字列（UTILS_FORM）
+			@param[in]	id		フォーマット文字列の実体（BIN_LOG_ID）
+			@param[in]	args	引数
+			@return 積めた場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		template <class FS, typename... Args>
+		bool put(FS fs, const char* id, const Args&... args) noexcept
+		{
+			typedef cform_base::info<FS> INFO;
+			static_assert(INFO::valid, "bin_log: illegal format");
+			static_assert(INFO::ARGS == sizeof...(Args), "bin_log: argument count mismatch");
+			static_assert(INFO::template check<Args...>(), "bin_log: argument type mismatch");
+			static_assert(fixed_size_<INFO>() + str_num_<INFO>() <= RECORD_MAX, "bin_log: too many arguments");
+
+			auto len = size_<INFO>(std::index_sequence_for<Args...>(), args...);
+
+			auto psw = lock_();
+			uint32_t pos = resv_;
+			if((pos + len - get_) > SIZE) {
+				lost_ = lost_ + 1;
+				unlock_(psw);
+				return false;
+			}
+			resv_ = pos + len;
+			buf_[pos & MASK] = 0;	// 未確定
+			unlock_(psw);
+
+			auto top = pos;
+			++pos;
+			buf_[pos & MASK] = len;
+			++pos;
+			uint32_t v = reinterpret_cast<uintptr_t>(id);
+			copy_(pos, &v, 4);
+			v = TIME::get_counter();
+			copy_(pos, &v, 4);
+			put_args_<INFO>(pos, std::index_sequence_for<Args...>(), args...);
+
+			asm volatile ("" : : : "memory");
+			buf_[top & MASK] = MARK;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	送出サービス（メインループから呼ぶ） @n
+					確定したレコードを、連続領域単位で出力先に渡す。 @n
+					出力先は「uint32_t write(const void* src, uint32_t len)」を持つ型 @n
+					（sci_io など、DMA 転送を有効にした sci_io を推奨）。
+			@param[in]	out		出力先
+			@return 送出したバイト数
+		*/
+		//-----------------------------------------------------------------//
+		template <class OUT>
+		uint32_t service(OUT& out) noexcept
+		{
+			uint32_t resv = resv_;
+			while(ready_ != resv) {
+				if(buf_[ready_ & MASK] != MARK) break;
+				ready_ += buf_[(ready_ + 1) & MASK];
+			}
+
+			uint32_t total = 0;
+			while(get_ != ready_) {
+				uint32_t pos = get_ & MASK;
+				uint32_t len = ready_ - get_;
+				if((pos + len) > SIZE) len = SIZE - pos;
+				auto n = out.write(&buf_[pos], len);
+				get_ = get_ + n;
+				total += n;
+				if(n < len) break;
+			}
+			return total;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	未送出のバイト数を取得
+			@return 未送出のバイト数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t length() const noexcept { return resv_ - get_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	バッファが溢れて捨てたレコード数を取得
+			@return 捨てたレコード数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_lost() const noexcept { return lost_; }
+	};
+}
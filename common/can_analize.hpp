@@ -2,15 +2,26 @@
 //=====================================================================//
 /*!	@file
 	@brief	CAN 通信解析クラス @n
-			std::map を使う場合、Makefile でのリンクを修正する (USER_DEFS = m stdc++) @n
+			・ID 毎の情報は、固定容量のオープン・アドレス表（線形探索）で管理し、 @n
+			  ヒープは使わない（表が一杯の場合、新しい ID は数えるだけで捨てる）。 @n
+			・ID 毎に、フレーム数、周期（フレーム／秒）、到着間隔の最小、最大、 @n
+			  標準偏差（ジッター）、ペイロードの変化回数、変化したバイトを集計する。 @n
+			・時間は、受信フレームの TS（CAN タイムスタンプ、１ビット時間毎）を @n
+			  ３２ビットに拡張して使う。TS は 1Mbps で約 65ms で一周する。 @n
+			  service(tick, rate) に CMT などの３２ビット・カウンターを渡すと、 @n
+			  呼び出し間隔が TS の一周を超えても、経過時間を合わせる（その間の @n
+			  到着間隔は不正確になるので、get_gap で回数を数える）。 @n
+			  service() は TS だけを使うので、TS の一周より短い間隔で呼ぶ事。 @n
+			・ID 範囲のフィルターを設定出来る（設定が無い場合、全ての ID を集計）。 @n
+			・表示は、ID の順に整列して行う。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2020, 2023 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2020, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=====================================================================//
-#include <boost/unordered_map.hpp>
-#include <map>
+#include <algorithm>
+#include <cmath>
 #include "common/can_io.hpp"
 #include "common/format.hpp"
 
@@ -20,31 +31,184 @@ namespace utils {
 	/*!
 		@brief  CAN 通信解析クラス
 		@param[in]	CAN_IO	can_io クラス型
+		@param[in]	NUM		ID 表の大きさ（２のべき乗、登録出来る ID は 3/4 まで）
+		@param[in]	FILT	ID 範囲フィルターの数
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <class CAN_IO>
+	template <class CAN_IO, uint32_t NUM = 256, uint32_t FILT = 4>
 	class can_analize {
 
-		CAN_IO&		can_io_;
+		static_assert(NUM >= 8 && NUM <= 32768 && (NUM & (NUM - 1)) == 0, "NUM must be power of 2 (8 to 32768)");
 
 		typedef device::can_frame FRAME;
 		typedef device::can_io_def CANDEF;
 
+		static constexpr uint32_t bits_() noexcept
+		{
+			uint32_t b = 0;
+			while((1u << b) < NUM) ++b;
+			return b;
+		}
+
+	public:
+		static constexpr uint32_t LIMIT = NUM - NUM / 4;	///< 登録出来る ID の最大数
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  ID 毎の情報
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		struct info_t {
-			uint32_t	count_;
-			FRAME		frame_;
-			info_t() : count_(0), frame_() { }
-			info_t(uint32_t count, const FRAME& frame) : count_(count), frame_(frame) { }
+			uint32_t	count_;		///< フレーム数
+			FRAME		frame_;		///< 最後のフレーム
+			uint32_t	first_;		///< 最初のフレームの時間
+			uint32_t	last_;		///< 最後のフレームの時間
+			uint32_t	ival_min_;	///< 到着間隔の最小
+			uint32_t	ival_max_;	///< 到着間隔の最大
+			float		ival_mean_;	///< 到着間隔の平均
+			float		ival_m2_;	///< 到着間隔の偏差二乗和
+			uint32_t	change_;	///< ペイロードが変化した回数
+			uint8_t		change_mask_;	///< 変化したバイト（B0: DATA0 ～ B7: DATA7）
+			info_t() noexcept : count_(0), frame_(), first_(0), last_(0),
+				ival_min_(0), ival_max_(0), ival_mean_(0.0f), ival_m2_(0.0f),
+				change_(0), change_mask_(0) { }
+		};
+
+	private:
+		static constexpr uint32_t BITS = bits_();
+		static constexpr uint32_t MASK = NUM - 1;
+
+		CAN_IO&		can_io_;
+
+		info_t		tbl_[NUM];
+		bool		used_[NUM];
+		uint32_t	num_;
+
+		struct filter_t {
+			uint32_t	lo;
+			uint32_t	hi;
+			bool		ena;
 		};
+		filter_t	filter_[FILT];
+		bool		filter_ena_;
+
+		uint32_t	time_;		// 拡張したタイムスタンプ
+		uint16_t	ts_;		// 最後に見た TS
+		uint32_t	tick_;		// 最後に見た service(tick, rate) のカウンター
+		bool		tick_ena_;
+		uint32_t	gap_;		// TS が一周以上進み、到着間隔が不正確になった回数
+		uint32_t	overflow_;	// 表が一杯で捨てたフレーム数
+		uint32_t	filtered_;	// フィルターで捨てたフレーム数
+
+		static uint32_t slot_(uint32_t id) noexcept
+		{
+			return (id * 0x9e3779b1) >> (32 - BITS);
+		}
+
+		// ID の位置（無い場合 NUM）
+		uint32_t find_(uint32_t id) const noexcept
+		{
+			auto i = slot_(id);
+			while(used_[i]) {
+				if(tbl_[i].frame_.get_id() == id) return i;
+				i = (i + 1) & MASK;
+			}
+			return NUM;
+		}
+
+		bool accept_(uint32_t id) const noexcept
+		{
+			if(!filter_ena_) return true;
+			for(uint32_t i = 0; i < FILT; ++i) {
+				const auto& f = filter_[i];
+				if(f.ena && f.lo <= id && id <= f.hi) return true;
+			}
+			return false;
+		}
+
+		// TS（１６ビット）を３２ビットに拡張する
+		uint32_t update_time_(uint16_t ts) noexcept
+		{
+			time_ += static_cast<uint16_t>(ts - ts_);
+			ts_ = ts;
+			return time_;
+		}
+
+		// 受信したフレームを集計
+		void drain_() noexcept
+		{
+			auto n = can_io_.get_recv_num();
+			while(n > 0) {
+				auto frm = can_io_.get_recv_frame();
+				--n;
+				auto time = update_time_(frm.get_TS());
+				auto id = frm.get_id();
+				if(!accept_(id)) {
+					++filtered_;
+					continue;
+				}
+				auto i = slot_(id);
+				while(used_[i]) {
+					if(tbl_[i].frame_.get_id() == id) break;
+					i = (i + 1) & MASK;
+				}
+				if(used_[i]) {  // 更新
+					update_(tbl_[i], frm, time);
+				} else if(num_ < LIMIT) {  // 登録
+					auto& t = tbl_[i];
+					t = info_t();
+					t.count_ = 1;
+					t.frame_ = frm;
+					t.first_ = time;
+					t.last_ = time;
+					used_[i] = true;
+					++num_;
+				} else {
+					++overflow_;
+				}
+			}
+		}
+
+		static uint8_t diff_mask_(const FRAME& a, const FRAME& b) noexcept
+		{
+			uint8_t m = 0;
+			uint32_t n = std::max(a.get_DLC(), b.get_DLC());
+			if(n > 8) n = 8;
+			for(uint32_t i = 0; i < n; ++i) {
+				if(a.get_DATA(i) != b.get_DATA(i)) m |= 1 << i;
+			}
+			return m;
+		}
+
+		static void update_(info_t& t, const FRAME& frm, uint32_t time) noexcept
+		{
+			// DLC、DATA0 ～ DATA7 の比較（TS は除く）
+			if((t.frame_[1] & 0x001f'ffff) != (frm[1] & 0x001f'ffff) || t.frame_[2] != frm[2]
+				|| (t.frame_[3] & 0xffff'0000) != (frm[3] & 0xffff'0000)) {
+				++t.change_;
+				t.change_mask_ |= diff_mask_(t.frame_, frm);
+			}
+
+			uint32_t ival = time - t.last_;
+			if(t.count_ == 1) {
+				t.ival_min_ = ival;
+				t.ival_max_ = ival;
+			} else {
+				if(ival < t.ival_min_) t.ival_min_ = ival;
+				if(ival > t.ival_max_) t.ival_max_ = ival;
+			}
+			// Welford 法による平均、分散の逐次計算
+			float x = static_cast<float>(ival);
+			float d = x - t.ival_mean_;
+			t.ival_mean_ += d / static_cast<float>(t.count_);
+			t.ival_m2_ += d * (x - t.ival_mean_);
 
-		// boost::unordered_map か std::map の選択
-		// std::map: 自動で ID の順序が整列する。
-		// boost::unordered_map: ハッシュによるので順番は不明。
-//		typedef boost::unordered_map<uint32_t, info_t> MAP;
-		typedef std::map<uint32_t, info_t> MAP;
-		MAP			map_;
+			++t.count_;
+			t.last_ = time;
+			t.frame_ = frm;
+		}
 
-		void list_line_(const info_t& t) const
+		void list_line_(const info_t& t) const noexcept
 		{
 			char ch;
 			if(t.frame_.get_RTR()) {
@@ -52,13 +216,32 @@ namespace utils {
 			} else {
 				ch = 'D';
 			}
+			char ex;
 			if(t.frame_.get_IDE()) {
-				utils::format("%c %6u E:x%07X (%u)\n")
-					% ch % t.count_ % t.frame_.get_id() % t.frame_.get_id();
+				ex = 'E';
 			} else {
-				utils::format("%c %6u S:x%07X (%u)\n")
-					% ch % t.count_ % t.frame_.get_id() % t.frame_.get_id();
+				ex = 'S';
 			}
+			utils::format("%c %6u %c:x%07X (%u)") % ch % t.count_ % ex % t.frame_.get_id() % t.frame_.get_id();
+			if(t.count_ >= 2) {
+				float freq = static_cast<float>(can_io_.get_speed());
+				float span = static_cast<float>(t.last_ - t.first_);
+				float ms = 1000.0f / freq;
+				utils::format(" %8.2f [f/s], %.2f/%.2f/%.2f [ms], J: %.3f [ms], C: %u (%02X)")
+					% (static_cast<float>(t.count_ - 1) * freq / span)
+					% (static_cast<float>(t.ival_min_) * ms)
+					% (t.ival_mean_ * ms)
+					% (static_cast<float>(t.ival_max_) * ms)
+					% (get_jitter_(t) * ms)
+					% t.change_ % static_cast<uint32_t>(t.change_mask_);
+			}
+			utils::format("\n");
+		}
+
+		static float get_jitter_(const info_t& t) noexcept
+		{
+			if(t.count_ < 3) return 0.0f;
+			return std::sqrt(t.ival_m2_ / static_cast<float>(t.count_ - 2));
 		}
 
 	public:
@@ -68,58 +251,101 @@ namespace utils {
 			@param[in]	can_io	can_io インスタンス
 		*/
 		//-----------------------------------------------------------------//
-		can_analize(CAN_IO& can_io) noexcept : can_io_(can_io), map_() { }
+		can_analize(CAN_IO& can_io) noexcept : can_io_(can_io), tbl_{ }, used_{ false }, num_(0),
+			filter_{ }, filter_ena_(false),
+			time_(0), ts_(0), tick_(0), tick_ena_(false), gap_(0), overflow_(0), filtered_(0)
+		{ }
 
 
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  サービス @n
-					CAN/ID の収集と更新
+					CAN/ID の収集と更新（メインループから呼ぶ） @n
+					TS だけで時間を追うので、TS の一周より短い間隔で呼ぶ事。
 		*/
 		//-----------------------------------------------------------------//
 		void service() noexcept
 		{
-			auto n = can_io_.get_recv_num();
-			while(n > 0) {
-				auto frm = can_io_.get_recv_frame();
-				auto it = map_.find(frm.get_id());
-				if(it != map_.end()) {  // 更新
-					it->second.count_++;
-					it->second.frame_ = frm;
-				} else {
-					map_.emplace(frm.get_id(), info_t(1, frm));
+			drain_();
+			// フレームが来ない間も、TS の一周を追う
+			update_time_(can_io_.get_time_stamp());
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  サービス（３２ビットの時間基準付き） @n
+					CAN/ID の収集と更新（メインループから呼ぶ） @n
+					tick から見た経過時間が、TS で追った時間より一周以上長い場合、 @n
+					呼び出しの間隔が空いたとして、その周回を時間に足す。
+			@param[in]	tick	３２ビット・カウンター（cmt_mgr::get_counter() など）
+			@param[in]	rate	tick の周波数 [Hz]（TS の半周より細かい事）
+		*/
+		//-----------------------------------------------------------------//
+		void service(uint32_t tick, uint32_t rate) noexcept
+		{
+			auto org = time_;
+			drain_();
+			auto now = update_time_(can_io_.get_time_stamp());
+			if(tick_ena_ && rate > 0) {
+				auto est = static_cast<uint64_t>(tick - tick_) * can_io_.get_speed() / rate;
+				uint32_t ela = now - org;
+				if(est > (static_cast<uint64_t>(ela) + 32768)) {
+					time_ += static_cast<uint32_t>((est - ela + 32768) >> 16) << 16;
+					++gap_;
 				}
-				--n;
 			}
+			tick_ = tick;
+			tick_ena_ = true;
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief  マップを全クリア
+			@brief  ID の情報をクリア
 			@param[in]	id	CAN/ID
 			@return ID のフレームが見つかった場合「true」
 		*/
 		//-----------------------------------------------------------------//
 		bool clear(uint32_t id) noexcept
 		{
-			auto it = map_.find(id);
-			if(it == map_.end()) {
+			auto i = find_(id);
+			if(i >= NUM) {
 				return false;
 			}
-			map_.erase(it);
+			// 後ろの要素を詰める（削除マークを使わない）
+			used_[i] = false;
+			auto j = (i + 1) & MASK;
+			while(used_[j]) {
+				auto k = slot_(tbl_[j].frame_.get_id());
+				// k が (i, j] の外なら、j を i へ移動
+				if(((j - k) & MASK) >= ((j - i) & MASK)) {
+					tbl_[i] = tbl_[j];
+					used_[i] = true;
+					used_[j] = false;
+					i = j;
+				}
+				j = (j + 1) & MASK;
+			}
+			--num_;
 			return true;
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief  マップを全クリア
+			@brief  全クリア
 		*/
 		//-----------------------------------------------------------------//
 		void clear_all() noexcept
 		{
-			map_.clear();
+			for(uint32_t i = 0; i < NUM; ++i) {
+				used_[i] = false;
+			}
+			num_ = 0;
+			overflow_ = 0;
+			filtered_ = 0;
+			gap_ = 0;
 		}
 
 
@@ -132,7 +358,148 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		bool find(uint32_t id) const noexcept
 		{
-			return map_.find(id) != map_.end();
+			return find_(id) < NUM;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ID の情報を取得
+			@param[in]	id	CAN/ID
+			@return ID の情報（見つからない場合「nullptr」）
+		*/
+		//-----------------------------------------------------------------//
+		const info_t* get(uint32_t id) const noexcept
+		{
+			auto i = find_(id);
+			if(i >= NUM) return nullptr;
+			return &tbl_[i];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  到着間隔の標準偏差（ジッター）を取得
+			@param[in]	t	ID の情報
+			@return ジッター（１ビット時間単位）
+		*/
+		//-----------------------------------------------------------------//
+		static float get_jitter(const info_t& t) noexcept { return get_jitter_(t); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  登録されている ID の数を取得
+			@return ID の数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t size() const noexcept { return num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  表が一杯で捨てたフレーム数を取得
+			@return フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_overflow() const noexcept { return overflow_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  フィルターで捨てたフレーム数を取得
+			@return フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_filtered() const noexcept { return filtered_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  TS が一周以上進み、到着間隔が不正確になった回数を取得 @n
+					service(tick, rate) を使った場合だけ数える。
+			@return 回数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_gap() const noexcept { return gap_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ID 範囲フィルターの設定 @n
+					有効なフィルターが一つも無い場合、全ての ID を集計する。
+			@param[in]	idx		フィルター番号（０～ FILT-1）
+			@param[in]	lo		ID の下限
+			@param[in]	hi		ID の上限
+			@param[in]	ena		無効にする場合「false」
+			@return 正常なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool set_filter(uint32_t idx, uint32_t lo, uint32_t hi, bool ena = true) noexcept
+		{
+			if(idx >= FILT || lo > hi) return false;
+			filter_[idx].lo = lo;
+			filter_[idx].hi = hi;
+			filter_[idx].ena = ena;
+			filter_ena_ = false;
+			for(uint32_t i = 0; i < FILT; ++i) {
+				if(filter_[i].ena) filter_ena_ = true;
+			}
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ID 範囲フィルターを全て無効にする
+		*/
+		//-----------------------------------------------------------------//
+		void reset_filter() noexcept
+		{
+			for(uint32_t i = 0; i < FILT; ++i) {
+				filter_[i].ena = false;
+			}
+			filter_ena_ = false;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ID 範囲フィルターの表示
+		*/
+		//-----------------------------------------------------------------//
+		void list_filter() const noexcept
+		{
+			for(uint32_t i = 0; i < FILT; ++i) {
+				const auto& f = filter_[i];
+				if(!f.ena) continue;
+				utils::format("%u: x%07X - x%07X\n") % i % f.lo % f.hi;
+			}
+			if(!filter_ena_) {
+				utils::format("Filter: disable (all ID)\n");
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ID の順に整列したスナップショットを作る
+			@param[out]	dst		ID の格納先
+			@param[in]	max		格納先の大きさ
+			@return 格納した ID の数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t snapshot(uint32_t* dst, uint32_t max) const noexcept
+		{
+			uint32_t n = 0;
+			for(uint32_t i = 0; i < NUM && n < max; ++i) {
+				if(used_[i]) {
+					dst[n] = tbl_[i].frame_.get_id();
+					++n;
+				}
+			}
+			std::sort(dst, dst + n);
+			return n;
 		}
 
 
@@ -146,30 +513,41 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		bool list(uint32_t id, bool verb = false) noexcept
 		{
-			auto it = map_.find(id);
-			if(it == map_.end()) {
+			auto i = find_(id);
+			if(i >= NUM) {
 				return false;
 			}
-			list_line_(it->second);
+			list_line_(tbl_[i]);
 			return true;
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief  収集された CAN/ID の全リストを表示
+			@brief  収集された CAN/ID の全リストを ID 順に表示 @n
+					[R/D] count [E/S]:ID rate min/mean/max jitter change (mask)
 			@param[in]	verb	詳細表示の場合「true」
 		*/
 		//-----------------------------------------------------------------//
 		void list_all(bool verb = false) noexcept
 		{
+			uint16_t idx[LIMIT];
 			uint32_t n = 0;
+			for(uint32_t i = 0; i < NUM; ++i) {
+				if(used_[i]) {
+					idx[n] = i;
+					++n;
+				}
+			}
+			std::sort(idx, idx + n, [this](uint16_t a, uint16_t b) {
+				return tbl_[a].frame_.get_id() < tbl_[b].frame_.get_id(); });
+
 			uint32_t a = 0;
 			uint32_t r = 0;
 			uint32_t df = 0;
 			uint32_t rf = 0;
-			for(auto&& it : map_) {
-				const auto& t = it.second;
+			for(uint32_t i = 0; i < n; ++i) {
+				const auto& t = tbl_[idx[i]];
 				list_line_(t);
 				a += t.count_;
 				r += t.frame_.get_DLC();
@@ -178,10 +556,12 @@ namespace utils {
 				} else {
 					++df;
 				}
-				++n;
 			}
 			utils::format("ID = %u / Total = %u, Records = %u, Df = %u, Rf = %u\n")
 				% n % a % r % df % rf;
+			if(overflow_ > 0 || filtered_ > 0 || gap_ > 0) {
+				utils::format("Overflow = %u, Filtered = %u, Gap = %u\n") % overflow_ % filtered_ % gap_;
+			}
 		}
 
 
@@ -194,12 +574,12 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		bool dump(uint32_t id) noexcept
 		{
-			auto it = map_.find(id);
-			if(it == map_.end()) {
+			auto i = find_(id);
+			if(i >= NUM) {
 				return false;
 			}
-			list_line_(it->second);
-			CANDEF::list(it->second.frame_);
+			list_line_(tbl_[i]);
+			CANDEF::list(tbl_[i].frame_);
 			return true;
 		}
 	};
@@ -4,9 +4,11 @@
 	@brief	RX グループ・CAN I/O 制御 @n
 			・CAN クロックは、正確に一致しない場合、エラーとする。 @n
 			・CAN ポートに、CAN バス・トランシーバーを接続する。 @n
-			・CAN ペリフェラル内蔵 FIFO 機能は使わない設計とする。
+			・通常は、受信メールボックス割り込みで、全てのフレームを RBF に移す。 @n
+			・RECV_MODE::FIFO を指定すると、受信 FIFO（４段）とアクセプタンス・ @n
+			  フィルターを使い、必要な ID だけを、割り込み毎にまとめて取り出す。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2019, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2019, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -55,6 +57,55 @@ namespace device {
 		};
 
 
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  受信モード型
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class RECV_MODE : uint8_t {
+			MAILBOX,	///< 受信メールボックス（全てのフレームを受信）
+			FIFO,		///< 受信 FIFO ＋ アクセプタンス・フィルター
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  アクセプタンス・フィルター @n
+					ID は can_frame::get_id() と同じ形式、mask のビットが「1」の @n
+					位置だけを比較する。
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct filter_t {
+			uint32_t	id;		///< ID
+			uint32_t	mask;	///< ID マスク
+			bool		ext;	///< 拡張 ID の場合「true」
+			bool		rtr;	///< リモートフレームの場合「true」
+			bool		ena;	///< 有効な場合「true」
+
+			filter_t() noexcept : id(0), mask(0), ext(false), rtr(false), ena(false) { }
+
+			filter_t(uint32_t id_, uint32_t mask_ = 0x1fff'ffff, bool ext_ = false, bool rtr_ = false) noexcept :
+				id(id_), mask(mask_), ext(ext_), rtr(rtr_), ena(true)
+			{ }
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  受信統計
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct recv_stat_t {
+			uint32_t	frames;			///< 受信フレーム数
+			uint32_t	lost_soft;		///< 受信バッファが一杯で捨てたフレーム数
+			uint32_t	lost_hard;		///< ハードウェアで失われた回数（FIFO 溢れ、メールボックスの上書き）
+			uint32_t	irq;			///< 受信割り込み回数
+			uint32_t	batch_max;		///< １回の割り込みで取り出した最大フレーム数
+			uint32_t	latency_max;	///< 受信から取り出しまでの最大遅延（ビット時間）
+			uint32_t	latency_sum;	///< 遅延の合計（平均の計算用）
+		};
+
+
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
 			@brief  割り込み設定
@@ -133,6 +184,8 @@ namespace device {
 		static constexpr uint32_t RX_MB_NUM = 8;	///< 受信用メールボックス数（最小８）
 		static constexpr uint32_t TX_MB_TOP = 8;	///< 送信用メールボックス先頭番号
 		static constexpr uint32_t TX_MB_NUM = 4;	///< 送信用メールボックス数（最小４）
+		static constexpr uint32_t FIFO_MB = 28;		///< 受信 FIFO のメールボックス番号
+		static constexpr uint32_t FILTER_NUM = 2 + RX_MB_NUM;	///< フィルター数（0,1: 受信 FIFO、2～: 受信用メールボックス）
 
 	private:
 
@@ -144,28 +197,83 @@ namespace device {
 
 		MODE			mode_;
 
+		RECV_MODE		recv_mode_;
+
 		static inline RBF		rbf_;
 		static inline SBF		sbf_;
-		static inline uint32_t lost_recv_;
+		static inline recv_stat_t	stat_;
+		static inline filter_t	filter_[FILTER_NUM];
+		static inline uint32_t	rx_mb_ena_;
 
 		void sleep_() const noexcept { asm("nop"); }
 
+		static void recv_frame_(uint32_t mb) noexcept
+		{
+			++stat_.frames;
+			if(rbf_.length() >= (rbf_.size() - 1)) {  // バッファに隙間が無い場合、受信をロストする。
+				++stat_.lost_soft;
+				return;
+			}
+			auto& t = rbf_.put_at();
+			CAN::MB[mb].get(t);
+			uint32_t lat = static_cast<uint16_t>(CAN::TSR() - t.get_TS());
+			if(lat > stat_.latency_max) stat_.latency_max = lat;
+			stat_.latency_sum += lat;
+			rbf_.put_go();
+		}
+
+		static void update_batch_(uint32_t n) noexcept
+		{
+			++stat_.irq;
+			if(n > stat_.batch_max) stat_.batch_max = n;
+		}
+
 		static INTERRUPT_FUNC void rxm_task_()
 		{
+			uint32_t n = 0;
 			for(uint32_t i = RX_MB_TOP; i < (RX_MB_TOP + RX_MB_NUM); ++i) {
+				if((rx_mb_ena_ & (1 << i)) == 0) continue;
 				if(CAN::MCTL[i].NEWDATA() != 0) {
-					if(rbf_.length() >= (rbf_.size() - 1)) {  // バッファに隙間が無い場合、受信をロストする。
-						lost_recv_++;
-					} else {
-						auto& t = rbf_.put_at();
-						CAN::MB[i].get(t);
-						rbf_.put_go();
-					}
+					if(CAN::MCTL[i].TMSGLOST() != 0) ++stat_.lost_hard;
+					recv_frame_(i);
+					++n;
 				}
 				CAN::MCTL[i] = 0;  // RECREQ を落とす
 				CAN::MCTL[i] = 0;  // NEWDATA を落とす
 				CAN::MCTL[i] = CAN::MCTL.RECREQ.b(1);  // 再度受信リクエスト
 			}
+			update_batch_(n);
+		}
+
+		// 受信 FIFO 割り込み、FIFO が空になるまで取り出す
+		static INTERRUPT_FUNC void rxf_task_()
+		{
+			uint32_t n = 0;
+			while(CAN::RFCR.RFEST() == 0) {
+				recv_frame_(FIFO_MB);
+				CAN::RFPCR = 0xff;  // 次のメッセージへ
+				++n;
+			}
+			if(CAN::RFCR.RFMLF() != 0) {
+				CAN::RFCR.RFMLF = 0;
+				++stat_.lost_hard;
+			}
+			update_batch_(n);
+		}
+
+		// FIDCR、MKR の形式（SID: B28-B18、EID: B17-B0）
+		static uint32_t id_reg_(uint32_t id) noexcept
+		{
+			return ((id & 0x7ff) << 18) | ((id >> 11) & 0x3'ffff);
+		}
+
+		template <class FIDCR>
+		static void set_fifo_filter_(FIDCR& fidcr, uint32_t mkr, const filter_t& f) noexcept
+		{
+			fidcr = id_reg_(f.id) | fidcr.RTR.b(f.rtr) | fidcr.IDE.b(f.ext);
+			auto m = id_reg_(f.mask);
+			if(!f.ext) m &= 0x1ffc'0000;  // 標準 ID は SID だけ比較
+			CAN::MKR[mkr] = m;
 		}
 
 		// 送信完了割り込みエントリー
@@ -226,7 +334,7 @@ namespace device {
 			@brief  コンストラクター
 		*/
 		//-----------------------------------------------------------------//
-		can_io() noexcept : mode_(MODE::RESET) { }
+		can_io() noexcept : mode_(MODE::RESET), recv_mode_(RECV_MODE::MAILBOX) { }
 
 
 		//-----------------------------------------------------------------//
@@ -252,10 +360,14 @@ namespace device {
 			@param[in]	intr	割り込み設定 @n
 								割り込みレベルは何も設定しないと「1」となる。 @n
 								割り込みを使わない指定は、コンパイルエラーとなる。 
+			@param[in]	mode	受信モード @n
+								FIFO の場合、set_filter で設定したフィルターを使う。 @n
+								フィルター 0、1 が無効なら、受信 FIFO は標準 ID、拡張 ID の @n
+								データフレームを全て受信する。
 			@return エラーなら「false」
 		*/
 		//-----------------------------------------------------------------//
-		bool start(SPEED speed, const interrupt_t& intr = interrupt_t(ICU::LEVEL::_1)) noexcept
+		bool start(SPEED speed, const interrupt_t& intr = interrupt_t(ICU::LEVEL::_1), RECV_MODE mode = RECV_MODE::MAILBOX) noexcept
 		{
 			if(intr.rxm_level == ICU::LEVEL::NONE || intr.txm_level == ICU::LEVEL::NONE) {
 				// 割り込み未使用では、常に失敗する。
@@ -337,26 +449,47 @@ namespace device {
 			}
 			CAN::MKIVLR = 0;  // マスク有効
 
-			// FIFO モードの場合： リモートフレーム、標準ID、拡張ID 受信可能設定
-			CAN::CTLR.MBM = 1;
-			CAN::FIDCR0 = CAN::FIDCR0.RTR.b(0) | CAN::FIDCR0.IDE.b(0);
-			CAN::FIDCR1 = CAN::FIDCR1.RTR.b(1) | CAN::FIDCR1.IDE.b(1);
-			CAN::CTLR.MBM = 0;
+			recv_mode_ = mode;
+			if(mode == RECV_MODE::FIFO) {
+				// 受信 FIFO のフィルター（無効なら、標準 ID、拡張 ID のデータフレーム全て）
+				CAN::CTLR.MBM = 1;
+				set_fifo_filter_(CAN::FIDCR0, 6, filter_[0].ena ? filter_[0] : filter_t(0, 0, false));
+				set_fifo_filter_(CAN::FIDCR1, 7, filter_[1].ena ? filter_[1] : filter_t(0, 0, true));
+			} else {
+				// FIFO モードの場合： リモートフレーム、標準ID、拡張ID 受信可能設定
+				CAN::CTLR.MBM = 1;
+				CAN::FIDCR0 = CAN::FIDCR0.RTR.b(0) | CAN::FIDCR0.IDE.b(0);
+				CAN::FIDCR1 = CAN::FIDCR1.RTR.b(1) | CAN::FIDCR1.IDE.b(1);
+				CAN::CTLR.MBM = 0;
+			}
 
 			// メールボックスを初期化
+			rx_mb_ena_ = 0;
 			for(uint32_t i = 0; i < 32; ++i) {
 				CAN::MCTL[i] = 0;  // 一応、MCTL も「０」クリア
 				CAN::MCTL[i] = 0;  // 完全にクリアするには、２度書く事が必要
+				if(mode == RECV_MODE::FIFO && i >= 24) continue;  // 送信、受信 FIFO
 				CAN::MB[i].clear();
 				if(i >= RX_MB_TOP && i < (RX_MB_TOP + RX_MB_NUM)) {
-					// データフレーム、リモートフレーム受信用
-					// 標準ID、拡張ID 受信用
-					CAN::MB[i].RTR = i & 1;
-					CAN::MB[i].IDE = (i >> 1) & 1;
+					if(mode == RECV_MODE::FIFO) {
+						// フィルター 2 ～ を、ID 一致（マスク無効）で受信
+						const auto& f = filter_[2 + i - RX_MB_TOP];
+						if(!f.ena) continue;
+						CAN::MB[i].set_id(f.id);
+						CAN::MB[i].RTR = f.rtr;
+						CAN::MB[i].IDE = f.ext;
+						CAN::MKIVLR.set(i);
+					} else {
+						// データフレーム、リモートフレーム受信用
+						// 標準ID、拡張ID 受信用
+						CAN::MB[i].RTR = i & 1;
+						CAN::MB[i].IDE = (i >> 1) & 1;
+					}
+					rx_mb_ena_ |= 1 << i;
 				}
 			}
 
-			lost_recv_ = 0;
+			clear_recv_stat();
 
 			CAN::MIER = 0;
 			if(intr.error_level != ICU::LEVEL::NONE) {
@@ -371,7 +504,11 @@ namespace device {
 			if(intr.rxm_level != ICU::LEVEL::NONE) {  // 受信割り込み設定
 				icu_mgr::set_interrupt(CAN::RXM, rxm_task_, intr.rxm_level);
 				for(uint32_t i = RX_MB_TOP; i < (RX_MB_TOP + RX_MB_NUM); ++i) {
-					CAN::MIER.set(i);
+					if(rx_mb_ena_ & (1 << i)) CAN::MIER.set(i);
+				}
+				if(mode == RECV_MODE::FIFO) {
+					icu_mgr::set_interrupt(CAN::RXF, rxf_task_, intr.rxm_level);
+					CAN::MIER.set(28);  // 受信 FIFO 割り込み許可（B29 = 0: 受信毎に発生）
 				}
 			}
 			if(intr.txm_level != ICU::LEVEL::NONE) {  // 送信割り込み設定
@@ -386,7 +523,7 @@ namespace device {
 			uint8_t bom  = 0b00;  // ISO 11898-1 規格、バスオフ復帰モード
 			bool tpm = 1;  // メールボックス番号優先送信モード
 			CAN::CTLR = CAN::CTLR.CANM.b(0b00) | CAN::CTLR.SLPM.b(0) | CAN::CTLR.IDFM.b(idfm)
-				| CAN::CTLR.BOM.b(bom) | CAN::CTLR.TPM.b(tpm);
+				| CAN::CTLR.BOM.b(bom) | CAN::CTLR.TPM.b(tpm) | CAN::CTLR.MBM.b(mode == RECV_MODE::FIFO);
 
 			// CAN オペレーションモードに移行するまで待機
 			while(CAN::STR.RSTST() != 0 || CAN::STR.HLTST() != 0) {
@@ -396,7 +533,10 @@ namespace device {
 
 			// 受信メールボックス設定
 			for(uint32_t i = RX_MB_TOP; i < (RX_MB_TOP + RX_MB_NUM); ++i) {
-				CAN::MCTL[i].RECREQ = 1;
+				if(rx_mb_ena_ & (1 << i)) CAN::MCTL[i].RECREQ = 1;
+			}
+			if(mode == RECV_MODE::FIFO) {
+				CAN::RFCR.RFE = 1;  // 受信 FIFO 有効
 			}
 			return true;
 		}
@@ -573,6 +713,18 @@ namespace device {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイムスタンプ・カウンターを返す @n
+					受信フレームの TS と同じカウンター（１ビット時間毎に進む）
+			@return タイムスタンプ・カウンター
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_time_stamp() const noexcept {
+			return CAN::TSR();
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  メールボックス制御をリセットする（レガシー）
@@ -778,7 +930,68 @@ namespace device {
 			@return ロストした受信フレーム数
 		*/
 		//-----------------------------------------------------------------//
-		static uint32_t get_lost_recv_num() noexcept { return lost_recv_; }
+		static uint32_t get_lost_recv_num() noexcept { return stat_.lost_soft; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信モードの取得
+			@return 受信モード
+		*/
+		//-----------------------------------------------------------------//
+		auto get_recv_mode() const noexcept { return recv_mode_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  アクセプタンス・フィルターの設定（start の前に行う） @n
+					・0、1: 受信 FIFO（マスク有効） @n
+					・2 ～ FILTER_NUM-1: 受信用メールボックス（ID 一致、マスク無効） @n
+					RECV_MODE::FIFO の場合だけ有効
+			@param[in]	idx		フィルター番号
+			@param[in]	f		フィルター
+			@return 設定出来ない場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool set_filter(uint32_t idx, const filter_t& f) noexcept
+		{
+			if(idx >= FILTER_NUM || mode_ == MODE::OPERATION) return false;
+			filter_[idx] = f;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  アクセプタンス・フィルターを全て無効にする（start の前に行う）
+		*/
+		//-----------------------------------------------------------------//
+		void reset_filter() noexcept
+		{
+			for(uint32_t i = 0; i < FILTER_NUM; ++i) {
+				filter_[i] = filter_t();
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信統計の取得
+			@return 受信統計
+		*/
+		//-----------------------------------------------------------------//
+		static const recv_stat_t& get_recv_stat() noexcept { return stat_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信統計のクリア
+		*/
+		//-----------------------------------------------------------------//
+		static void clear_recv_stat() noexcept
+		{
+			stat_ = recv_stat_t();
+		}
 
 
 		//-----------------------------------------------------------------//
@@ -802,15 +1015,21 @@ namespace device {
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  CAN を無効にしてパワーダウンする @n
-					・割り込みを解除する
+					・割り込み（RXM、TXM、RXF、ERS）を解除する
 			@param[in]	power パワーダウンをしない場合「false」
 		*/
 		//-----------------------------------------------------------------//
 		void destroy(bool power = true) noexcept
 		{
 			CAN::MIER = 0;
-			icu_mgr::set_interrupt(CAN::RXM_VEC, nullptr, 0);
-			icu_mgr::set_interrupt(CAN::TXM_VEC, nullptr, 0);
+			CAN::EIER = 0;
+			if(recv_mode_ == RECV_MODE::FIFO) {
+				CAN::RFCR.RFE = 0;
+				icu_mgr::set_interrupt(CAN::RXF, nullptr, ICU::LEVEL::NONE);
+			}
+			icu_mgr::set_interrupt(CAN::RXM, nullptr, ICU::LEVEL::NONE);
+			icu_mgr::set_interrupt(CAN::TXM, nullptr, ICU::LEVEL::NONE);
+			icu_mgr::install_group_task(CAN::ERS, nullptr);
 
 			CAN::CTLR = CAN::CTLR.CANM.b(0b11);  // CAN リセットモード（強制） 
 
@@ -3,13 +3,17 @@
 /*!	@file
 	@brief	RX グループ・CANFD I/O 制御 @n
 			・CANFD クロックは、正確に一致しない場合、エラーとする。 @n
-			・CANFD ポートに、CAN バス・トランシーバーを接続する。
+			・CANFD ポートに、CAN バス・トランシーバーを接続する。 @n
+			・受信はアクセプタンス・フィルター・リストで選別し、受信 FIFO 0 に入れる。 @n
+			  受信 FIFO 割り込み毎に、FIFO が空になるまで RBF に取り出す。 @n
+			・送信は、送信メッセージバッファ（TMB0 ～ TMB3）の空きを使う。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2024, 2025 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2024, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=========================================================================//
+#include <type_traits>
 #include "common/renesas.hpp"
 #include "common/vect.h"
 #include "common/delay.hpp"
@@ -52,6 +56,44 @@ namespace device {
 			_5M = 5'000'000,	///< 5Mbps
 			_8M = 8'000'000		///< 8Mbps
 		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  アクセプタンス・フィルター @n
+					ID は canfd_frame::get_id() と同じ形式、mask のビットが「1」の @n
+					位置だけを比較する。
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct filter_t {
+			uint32_t	id;		///< ID
+			uint32_t	mask;	///< ID マスク
+			bool		ext;	///< 拡張 ID の場合「true」
+			bool		rtr;	///< リモートフレームの場合「true」
+			bool		ena;	///< 有効な場合「true」
+
+			filter_t() noexcept : id(0), mask(0), ext(false), rtr(false), ena(false) { }
+
+			filter_t(uint32_t id_, uint32_t mask_ = 0x1fff'ffff, bool ext_ = false, bool rtr_ = false) noexcept :
+				id(id_), mask(mask_), ext(ext_), rtr(rtr_), ena(true)
+			{ }
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  受信統計
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct recv_stat_t {
+			uint32_t	frames;			///< 受信フレーム数
+			uint32_t	lost_soft;		///< 受信バッファが一杯で捨てたフレーム数
+			uint32_t	lost_hard;		///< 受信 FIFO が溢れた回数
+			uint32_t	irq;			///< 受信割り込み回数
+			uint32_t	batch_max;		///< １回の割り込みで取り出した最大フレーム数
+			uint32_t	latency_max;	///< 受信から取り出しまでの最大遅延（ビット時間）
+			uint32_t	latency_sum;	///< 遅延の合計（平均の計算用）
+		};
 	};
 
 
@@ -74,6 +116,9 @@ namespace device {
 		static_assert(RBF::size() > 16, "Receive buffer is too small.");
 		static_assert(SBF::size() > 16, "Transmission buffer is too small.");
 
+		static constexpr uint32_t FILTER_NUM = 16;	///< フィルター数（アクセプタンス・フィルター・リスト）
+		static constexpr uint32_t TMB_NUM = 4;		///< 送信メッセージバッファ数
+
 #ifndef NDEBUG
 		typedef utils::null_format	format;
 #else
@@ -81,7 +126,133 @@ namespace device {
 #endif
 	private:
 
+		// ビットタイミング
+		struct btr_t {
+			uint32_t	brp;
+			uint32_t	tseg1;
+			uint32_t	tseg2;
+			uint32_t	sjw;
+		};
+
+		// 分周後の TQ 数が範囲に収まる、最小の BRP を選ぶ（サンプル点は約 80%）
+		static constexpr bool get_btr_(uint32_t rate, uint32_t brp_max, uint32_t tseg1_max, uint32_t tseg2_max, btr_t& t) noexcept
+		{
+			for(uint32_t brp = 1; brp <= brp_max; ++brp) {
+				if((CANFD::PCLK % (rate * brp)) != 0) continue;
+				uint32_t tq = CANFD::PCLK / (rate * brp);
+				if(tq < 8 || tq > (1 + tseg1_max + tseg2_max)) continue;
+				uint32_t tseg2 = (tq + 4) / 5;
+				if(tseg2 < 2) tseg2 = 2;
+				if(tseg2 > tseg2_max) continue;
+				uint32_t tseg1 = tq - 1 - tseg2;
+				if(tseg1 > tseg1_max) continue;
+				t.brp = brp;
+				t.tseg1 = tseg1;
+				t.tseg2 = tseg2;
+				t.sjw = tseg2;
+				return true;
+			}
+			return false;
+		}
+
+		static constexpr uint32_t NBRP_MAX  = 1024;
+		static constexpr uint32_t NTSEG1_MAX = 256;
+		static constexpr uint32_t NTSEG2_MAX = 128;
+		static constexpr uint32_t DBRP_MAX  = 256;
+		static constexpr uint32_t DTSEG1_MAX = 32;
+		static constexpr uint32_t DTSEG2_MAX = 16;
+
+		static constexpr uint32_t RF_DEPTH = 3;	///< 受信 FIFO の段数（FDS: 3 = 16 段）
+
+		bool	run_;
+
+		static inline RBF			rbf_;
+		static inline recv_stat_t	stat_;
+		static inline filter_t		filter_[FILTER_NUM];
+
+		void sleep_() const noexcept { asm("nop"); }
+
+		static void update_latency_(uint16_t ts) noexcept
+		{
+			uint32_t lat = static_cast<uint16_t>(CANFD::TSCR.VAL() - ts);
+			if(lat > stat_.latency_max) stat_.latency_max = lat;
+			stat_.latency_sum += lat;
+		}
+
+		// 受信 FIFO 0 が空になるまで取り出す
+		static void rfr_service_() noexcept
+		{
+			uint32_t n = 0;
+			while(CANFD::RFSR0.EMPTY() == 0) {
+				++stat_.frames;
+				if(rbf_.length() >= (rbf_.size() - 1)) {  // バッファに隙間が無い場合、受信をロストする。
+					++stat_.lost_soft;
+				} else {
+					auto& t = rbf_.put_at();
+					auto& rfb = CANFD::RFB[0];
+					t.set_header(rfb.HF0(), rfb.HF1(), rfb.HF2());
+					uint32_t len = (t.get_length() + 3) >> 2;
+					for(uint32_t i = 0; i < len; ++i) {
+						t[i] = rfb.DF(i);
+					}
+					update_latency_(t.get_TS());
+					rbf_.put_go();
+				}
+				CANFD::RFPCR0 = 0xff;  // 次のメッセージへ
+				++n;
+			}
+			if(CANFD::RFSR0.LOST() != 0) {
+				CANFD::RFSR0.LOST = 0;
+				++stat_.lost_hard;
+			}
+			CANFD::RFSR0.RFIF = 0;
+			++stat_.irq;
+			if(n > stat_.batch_max) stat_.batch_max = n;
+		}
+
+		static INTERRUPT_FUNC void rfr_itask_() noexcept { rfr_service_(); }
+
+		static void rfr_gtask_() noexcept { rfr_service_(); }
 
+		// 受信 FIFO 割り込みは、デバイスにより通常割り込み、又はグループ割り込み
+		static void set_rfr_interrupt_(ICU::LEVEL lvl) noexcept
+		{
+			if constexpr (std::is_same<std::remove_cv_t<decltype(CANFD::RFRV)>, ICU::VECTOR>::value) {
+				icu_mgr::set_interrupt(CANFD::RFRV, rfr_itask_, lvl);
+			} else {
+				icu_mgr::set_interrupt(CANFD::RFRV, rfr_gtask_, lvl);
+			}
+		}
+
+		// アクセプタンス・フィルター・リストの設定（グローバル・リセット・モードで行う）
+		static void set_rules_() noexcept
+		{
+			uint32_t num = 0;
+			for(uint32_t i = 0; i < FILTER_NUM; ++i) {
+				if(filter_[i].ena) ++num;
+			}
+
+			CANFD::AFCFG.RN0 = num == 0 ? 1 : num;
+			CANFD::AFCR = CANFD::AFCR.PAGE.b(0) | CANFD::AFCR.AFLWE.b(1);
+			uint32_t j = 0;
+			for(uint32_t i = 0; i < FILTER_NUM; ++i) {
+				const auto& f = filter_[i];
+				if(!f.ena) continue;
+				CANFD::AFLIDR[j] = CANFD::AFLIDR.ID.b(f.id) | CANFD::AFLIDR.RTR.b(f.rtr) | CANFD::AFLIDR.IDE.b(f.ext);
+				auto m = f.mask & (f.ext ? 0x1fff'ffff : 0x7ff);
+				CANFD::AFLMASK[j] = CANFD::AFLMASK.IDM.b(m) | CANFD::AFLMASK.RTRM.b(1) | CANFD::AFLMASK.IDEM.b(1);
+				CANFD::AFLPTR0[j] = 0;
+				CANFD::AFLPTR1[j] = CANFD::AFLPTR1.RF0E.b(1);
+				++j;
+			}
+			if(num == 0) {  // フィルター無し：全てのフレームを受信
+				CANFD::AFLIDR[0] = 0;
+				CANFD::AFLMASK[0] = 0;
+				CANFD::AFLPTR0[0] = 0;
+				CANFD::AFLPTR1[0] = CANFD::AFLPTR1.RF0E.b(1);
+			}
+			CANFD::AFCR.AFLWE = 0;
+		}
 
 	public:
 		//-----------------------------------------------------------------//
@@ -89,7 +260,7 @@ namespace device {
 			@brief  コンストラクター
 		*/
 		//-----------------------------------------------------------------//
-		canfd_io() noexcept { }
+		canfd_io() noexcept : run_(false) { }
 
 
 		//-----------------------------------------------------------------//
@@ -101,7 +272,8 @@ namespace device {
 		//-----------------------------------------------------------------//
 		static constexpr bool probe_speed(SPEED speed) noexcept
 		{
-			return false;
+			btr_t t { };
+			return get_btr_(static_cast<uint32_t>(speed), NBRP_MAX, NTSEG1_MAX, NTSEG2_MAX, t);
 		}
 
 
@@ -114,12 +286,193 @@ namespace device {
 		//-----------------------------------------------------------------//
 		static constexpr bool probe_speed(DATA data) noexcept
 		{
+			btr_t t { };
+			return get_btr_(static_cast<uint32_t>(data), DBRP_MAX, DTSEG1_MAX, DTSEG2_MAX, t);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  アクセプタンス・フィルターの設定（start の前に行う） @n
+					一つも設定しない場合、全てのフレームを受信する。
+			@param[in]	idx		フィルター番号（0 ～ FILTER_NUM-1）
+			@param[in]	f		フィルター
+			@return 設定出来ない場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool set_filter(uint32_t idx, const filter_t& f) noexcept
+		{
+			if(idx >= FILTER_NUM || run_) return false;
+			filter_[idx] = f;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  アクセプタンス・フィルターを全て無効にする（start の前に行う）
+		*/
+		//-----------------------------------------------------------------//
+		void reset_filter() noexcept
+		{
+			for(uint32_t i = 0; i < FILTER_NUM; ++i) {
+				filter_[i] = filter_t();
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始
+			@param[in]	speed	公称ビットレート
+			@param[in]	data	データ・ビットレート
+			@param[in]	level	受信割り込みレベル（０の場合エラー）
+			@return エラーなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool start(SPEED speed, DATA data, ICU::LEVEL level = ICU::LEVEL::_1) noexcept
+		{
+			if(level == ICU::LEVEL::NONE) {
+				format("(0) RX Interrupt level cannot be set to 0...\n");
+				return false;
+			}
+
+			btr_t nbt { };
+			if(!get_btr_(static_cast<uint32_t>(speed), NBRP_MAX, NTSEG1_MAX, NTSEG2_MAX, nbt)) {
+				format("(1) CANFD nominal bit rate indivisible...\n");
+				return false;
+			}
+			btr_t dbt { };
+			if(!get_btr_(static_cast<uint32_t>(data), DBRP_MAX, DTSEG1_MAX, DTSEG2_MAX, dbt)) {
+				format("(2) CANFD data bit rate indivisible...\n");
+				return false;
+			}
+
+			if(!power_mgr::turn(CANFD::PERIPHERAL)) {
+				format("(3) fail power manager...\n");
+				return false;
+			}
+			if(!port_map::turn(CANFD::PERIPHERAL, true, PSEL)) {
+				power_mgr::turn(CANFD::PERIPHERAL, false);
+				format("(4) fail port mapping...\n");
+				return false;
+			}
+
+			// CAN RAM の初期化待ち
+			while(CANFD::GSR.RAMST() != 0) sleep_();
+
+			// グローバル・スリープ解除（グローバル・リセット・モードへ）
+			CANFD::GCR.SLPRQ = 0;
+			while(CANFD::GSR.SLPST() != 0) sleep_();
+			// チャネル・スリープ解除（チャネル・リセット・モードへ）
+			CANFD::CHCR.SLPRQ = 0;
+			while(CANFD::CHSR.SLPST() != 0) sleep_();
+
+			// タイムスタンプは、ビット時間クロック（CAN 側と同じ単位）
+			CANFD::GCFG = CANFD::GCFG.TSCS.b(1) | CANFD::GCFG.TSP.b(0);
+
+			set_rules_();
+
+			// 受信 FIFO 0： ペイロード 64 バイト、受信毎に割り込み
+			CANFD::RFCR0 = CANFD::RFCR0.PLS.b(0b111) | CANFD::RFCR0.FDS.b(RF_DEPTH)
+				| CANFD::RFCR0.RFIM.b(1) | CANFD::RFCR0.RFIE.b(1);
+
+			// ビットタイミング
+			CANFD::NBCR = CANFD::NBCR.BRP.b(nbt.brp - 1) | CANFD::NBCR.SJW.b(nbt.sjw - 1)
+				| CANFD::NBCR.TSEG1.b(nbt.tseg1 - 1) | CANFD::NBCR.TSEG2.b(nbt.tseg2 - 1);
+			CANFD::DBCR = CANFD::DBCR.BRP.b(dbt.brp - 1) | CANFD::DBCR.SJW.b(dbt.sjw - 1)
+				| CANFD::DBCR.TSEG1.b(dbt.tseg1 - 1) | CANFD::DBCR.TSEG2.b(dbt.tseg2 - 1);
+			// 送受信遅延補正（オフセットは、データ位相のサンプル点）
+			CANFD::FDCFG = CANFD::FDCFG.TDCE.b(1) | CANFD::FDCFG.TDCO.b((1 + dbt.tseg1) * dbt.brp - 1);
+
+			stat_ = recv_stat_t();
+			set_rfr_interrupt_(level);
+
+			// グローバル・オペレーション・モード
+			CANFD::GCR.MDC = 0b00;
+			while(CANFD::GSR.RSTST() != 0 || CANFD::GSR.HLTST() != 0) sleep_();
+			// チャネル・オペレーション・モード
+			CANFD::CHCR.MDC = 0b00;
+			while(CANFD::CHSR.RSTST() != 0 || CANFD::CHSR.HLTST() != 0) sleep_();
+
+			CANFD::RFCR0.RFE = 1;  // 受信 FIFO は、グローバル・オペレーション・モードで有効にする
+			run_ = true;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信フレーム数を取得
+			@return 受信フレーム数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_recv_num() const noexcept { return rbf_.length(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信フレームを取得
+			@return 受信フレーム
+		*/
+		//-----------------------------------------------------------------//
+		auto get_recv_frame() noexcept { return rbf_.get(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  フレームを送信（空いている送信メッセージバッファを使う）
+			@param[in]	t	送信フレーム
+			@return 空きが無い場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool send(const canfd_frame& t) noexcept
+		{
+			if(!run_) return false;
+			for(uint32_t i = 0; i < TMB_NUM; ++i) {
+				if(CANFD::TMSR[i].TXRQS() != 0) continue;
+				CANFD::TMSR[i] = 0;  // 送信結果をクリア
+				auto& tmb = CANFD::TMB[i];
+				tmb.HF0 = t.get_HF0();
+				tmb.HF1 = t.get_HF1() & 0xf000'0000;
+				tmb.HF2 = t.get_HF2() & 0x7;
+				uint32_t len = (t.get_length() + 3) >> 2;
+				for(uint32_t j = 0; j < len; ++j) {
+					tmb.DF.set(j, t[j]);
+				}
+				CANFD::TMCR[i] = CANFD::TMCR.TXRQ.b(1);
+				return true;
+			}
 			return false;
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信統計の取得
+			@return 受信統計
+		*/
+		//-----------------------------------------------------------------//
+		static const recv_stat_t& get_recv_stat() noexcept { return stat_; }
+
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  受信統計のクリア
+		*/
+		//-----------------------------------------------------------------//
+		static void clear_recv_stat() noexcept
+		{
+			stat_ = recv_stat_t();
+		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  現在のタイムスタンプを取得（ビット時間）
+			@return タイムスタンプ
+		*/
+		//-----------------------------------------------------------------//
+		uint16_t get_time_stamp() const noexcept { return CANFD::TSCR.VAL(); }
 	};
 }
@@ -1,9 +1,12 @@
 #pragma once
 //=====================================================================//
 /*!	@file
-	@brief	コマンド入力クラス
+	@brief	コマンド入力クラス @n
+			「Enter」キーで確定した行は、一度だけ単語に分解して保持する。 @n
+			（get_words、get_word、cmp_word などは、分解済みの単語を参照する） @n
+			コマンド名による分岐は、command_dispatch を使う事が出来る。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2016, 2017 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2016, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -25,15 +28,22 @@ namespace utils {
     /*!
         @brief  command class
 		@param[in]	BUFN	バッファサイズ（最小でも９）
+		@param[in]	ARGN	最大単語数
     */
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <uint16_t BUFN>
+	template <uint16_t BUFN, uint16_t ARGN = 32>
 	class command {
 		char		buff_[BUFN];
 		int16_t		bpos_;
 		int16_t		pos_;
 		uint16_t	len_;
 		int16_t		tab_top_;
+		uint16_t	tab_cnt_;
+
+		char		argb_[BUFN];	// 分解した単語（'\0' 終端）
+		uint16_t	argv_[ARGN];	// 単語の位置
+		uint32_t	argh_[ARGN];	// 単語のハッシュ
+		uint16_t	argc_;
 
 		const char*	prompt_;
 
@@ -64,17 +74,75 @@ namespace utils {
 			sci_putch('\n');	///< LF
 		}
 
+		// 行を単語に分解（バックスラッシュの次の文字は、区切りとしない）
+		void split_() noexcept
+		{
+			argc_ = 0;
+			uint16_t d = 0;
+			bool in = false;
+			bool bsc = false;
+			for(uint16_t i = 0; i < len_; ++i) {
+				char ch = buff_[i];
+				if(!bsc && ch == '\\') {
+					bsc = true;
+					continue;
+				}
+				if(!bsc && ch == ' ') {
+					if(in) {
+						argb_[d] = 0;
+						++d;
+						in = false;
+					}
+					continue;
+				}
+				bsc = false;
+				if(!in) {
+					if(argc_ >= ARGN) break;
+					argv_[argc_] = d;
+					++argc_;
+					in = true;
+				}
+				argb_[d] = ch;
+				++d;
+			}
+			if(in) {
+				argb_[d] = 0;
+			}
+			for(uint16_t i = 0; i < argc_; ++i) {
+				argh_[i] = hash(&argb_[argv_[i]]);
+			}
+		}
+
 	public:
         //-----------------------------------------------------------------//
         /*!
             @brief  コンストラクター
         */
         //-----------------------------------------------------------------//
-		command() : bpos_(-1), pos_(0), len_(0), tab_top_(-1),
+		command() : bpos_(-1), pos_(0), len_(0), tab_top_(-1), tab_cnt_(0),
+			argb_{ 0 }, argv_{ 0 }, argh_{ 0 }, argc_(0),
 			prompt_(nullptr), tab_(false), esc_(false), esc_step_(false)
 		{ buff_[0] = 0; }
 
 
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  単語のハッシュ（FNV-1a）
+			@param[in]	str		文字列
+			@return ハッシュ値
+        */
+        //-----------------------------------------------------------------//
+		static constexpr uint32_t hash(const char* str) noexcept
+		{
+			uint32_t h = 0x811c9dc5;
+			while(*str != 0) {
+				h = (h ^ static_cast<uint8_t>(*str)) * 0x01000193;
+				++str;
+			}
+			return h;
+		}
+
+
         //-----------------------------------------------------------------//
         /*!
             @brief  プロムプト文字列を設定
@@ -115,6 +183,7 @@ namespace utils {
 				case '\r':	// Enter キー
 					buff_[pos_] = 0;
 					len_ = pos_;
+					split_();
 					clear_line_();
 					crlf_();
 					pos_ = 0;
@@ -123,6 +192,7 @@ namespace utils {
 					return true;
 
 				case 0x08:	// バックスペース
+					tab_top_ = -1;
 					if(pos_) {
 						--pos_;
 						sci_putch(0x08);
@@ -139,8 +209,10 @@ namespace utils {
 				case '\t':  // TAB キー
 					if(tab_top_ < 0) {
 						tab_top_ = pos_;
+						tab_cnt_ = 0;
 						save_cursor_();
 					}
+					++tab_cnt_;
 					tab_ = true;
 					break;
 
@@ -165,6 +237,7 @@ namespace utils {
 							esc_ = false;
 						}
 					} else {
+						tab_top_ = -1;
 						if(ch < 0x20) {	///< 他の ctrl コード
 							buff_[pos_] = ch;
 							++pos_;
@@ -201,6 +274,7 @@ namespace utils {
         */
         //-----------------------------------------------------------------//
 		uint32_t get_words(char sch = ' ') const {
+			if(sch == ' ') return argc_;
 			return str::get_words(buff_, sch);
 		}
 
@@ -216,7 +290,11 @@ namespace utils {
         */
         //-----------------------------------------------------------------//
 		bool get_word(uint32_t argc, char* dst, uint32_t dstlen, char sch = ' ') const {
-			return str::get_word(buff_, argc, dst, dstlen);
+			if(sch != ' ') return str::get_word(buff_, argc, dst, dstlen, sch);
+			if(dst == nullptr || dstlen == 0 || argc >= argc_) return false;
+			std::strncpy(dst, &argb_[argv_[argc]], dstlen - 1);
+			dst[dstlen - 1] = 0;
+			return true;
 		}
 
 
@@ -230,7 +308,35 @@ namespace utils {
         */
         //-----------------------------------------------------------------//
 		bool cmp_word(uint32_t argc, const char* key, char sch = ' ') const {
-			return str::cmp_word(buff_, argc, key, sch);
+			if(sch != ' ') return str::cmp_word(buff_, argc, key, sch);
+			if(key == nullptr || argc >= argc_) return false;
+			return std::strcmp(&argb_[argv_[argc]], key) == 0;
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  分解済みの単語を参照
+			@param[in]	argc	ワード位置
+			@return 単語（'\0' 終端）、無い場合「nullptr」
+        */
+        //-----------------------------------------------------------------//
+		const char* get_argv(uint32_t argc) const noexcept {
+			if(argc >= argc_) return nullptr;
+			return &argb_[argv_[argc]];
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  分解済みの単語のハッシュを取得
+			@param[in]	argc	ワード位置
+			@return ハッシュ値（無い場合０）
+        */
+        //-----------------------------------------------------------------//
+		uint32_t get_hash(uint32_t argc) const noexcept {
+			if(argc >= argc_) return 0;
+			return argh_[argc];
 		}
 
 
@@ -245,14 +351,14 @@ namespace utils {
         //-----------------------------------------------------------------//
 		bool get_integer(uint8_t argc, int32_t& out, bool auton = false) const
 		{
-			char tmp[32];
-			if(!get_word(argc, tmp, sizeof(tmp))) return false;
+			auto p = get_argv(argc);
+			if(p == nullptr) return false;
 
 			char form[3];
 			form[0] = '%';
 			form[1] = auton ? 'a' : 'd';
 			form[2] = 0;
-			return (utils::input(form, tmp) % out).status();
+			return (utils::input(form, p) % out).status();
 		}
 
 
@@ -266,10 +372,10 @@ namespace utils {
         //-----------------------------------------------------------------//
 		bool get_float(uint8_t argc, float& out) const
 		{
-			char tmp[32];
-			if(!get_word(argc, tmp, sizeof(tmp))) return false;
+			auto p = get_argv(argc);
+			if(p == nullptr) return false;
 
-			return (utils::input("%f", tmp) % out).status();
+			return (utils::input("%f", p) % out).status();
 		}
 
 
@@ -290,6 +396,33 @@ namespace utils {
 		void reset_tab() { tab_top_ = -1; } 
 
 
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  TAB キーが押された位置の前までの入力を取得
+			@param[out]	dst		格納先
+			@param[in]	dstlen	格納先の大きさ
+			@return TAB キーが押されていない場合「false」
+        */
+        //-----------------------------------------------------------------//
+		bool get_tab_prefix(char* dst, uint32_t dstlen) const noexcept {
+			if(tab_top_ < 0 || dst == nullptr || dstlen == 0) return false;
+			uint32_t l = tab_top_;
+			if(l >= dstlen) l = dstlen - 1;
+			std::memcpy(dst, buff_, l);
+			dst[l] = 0;
+			return true;
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  TAB キーが続けて押された回数を取得（候補の切り替えに使う）
+			@return 回数
+        */
+        //-----------------------------------------------------------------//
+		uint32_t get_tab_count() const noexcept { return tab_top_ < 0 ? 0 : tab_cnt_; }
+
+
         //-----------------------------------------------------------------//
         /*!
             @brief  TAB キーの候補を注入
@@ -297,11 +430,18 @@ namespace utils {
         */
         //-----------------------------------------------------------------//
 		void injection_tab(const char* key) {
-			if(tab_top_ < 0) return;
-			std::strcpy(&buff_[tab_top_], key);
+			if(tab_top_ < 0 || key == nullptr) return;
+			uint32_t l = std::strlen(key);
+			if((tab_top_ + l) >= (BUFN - 1)) l = BUFN - 1 - tab_top_;
+			std::memcpy(&buff_[tab_top_], key, l);
+			pos_ = tab_top_ + l;
+			buff_[pos_] = 0;
 
 			load_cursor_();
-			sci_puts(key);
+			clear_line_();
+			for(uint32_t i = 0; i < l; ++i) {
+				sci_putch(key[i]);
+			}
 		}
 	};
 }
@@ -0,0 +1,233 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	コマンド・ディスパッチ・クラス @n
+			コマンド名の表から、コンパイル時に完全ハッシュを作り、分解済みの @n
+			先頭単語のハッシュ（command::get_hash）で、処理関数を一度で引く。 @n
+			コマンド名の重複はコンパイル・エラーになる。 @n
+			Ex: @n
+			  typedef utils::command<256> CMD; @n
+			  static void dump_(CTX& ctx, const CMD& cmd) { ... } @n
+			  static constexpr utils::command_entry<CTX, CMD> cmds_[] = { @n
+			    { "dump", "[org] [end]", "Dump memory", dump_ }, @n
+			    { "d",    nullptr,       nullptr,       dump_ },	// 別名（HELP 非表示） @n
+			  }; @n
+			  static constexpr auto disp_ = utils::make_command_dispatch(cmds_); @n
+			  ... @n
+			  if(cmd_.service()) { @n
+			    if(!disp_.exec(ctx, cmd_)) { ... } @n
+			  } else if(cmd_.probe_tab()) { @n
+			    disp_.complete(cmd_); @n
+			  }
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstring>
+#include "common/format.hpp"
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  コマンド定義
+		@param[in]	CTX		処理関数に渡すコンテキスト型
+		@param[in]	CMD		コマンド入力型（utils::command）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CTX, class CMD>
+	struct command_entry {
+		typedef void (*func_type)(CTX& ctx, const CMD& cmd);
+
+		const char*	name;	///< コマンド名
+		const char*	args;	///< 引数の説明（HELP 用、nullptr 可）
+		const char*	text;	///< 説明（HELP 用、nullptr なら HELP に表示しない）
+		func_type	func;	///< 処理関数
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  コマンド・ディスパッチ・クラス
+		@param[in]	CTX		処理関数に渡すコンテキスト型
+		@param[in]	CMD		コマンド入力型（utils::command）
+		@param[in]	N		コマンドの数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CTX, class CMD, uint32_t N>
+	class command_dispatch {
+
+		static_assert(N > 0 && N < 255, "command_dispatch: illegal number of commands");
+
+		static constexpr uint32_t bits_() noexcept
+		{
+			uint32_t b = 2;
+			while((1u << b) < (N * 2)) ++b;
+			return b;
+		}
+
+	public:
+		typedef command_entry<CTX, CMD> entry_type;
+
+		static constexpr uint32_t BITS = bits_();		///< ハッシュ表のビット数
+		static constexpr uint32_t SLOT = 1 << BITS;	///< ハッシュ表の大きさ
+
+	private:
+		static constexpr uint8_t EMPTY = 0xff;
+
+		const entry_type*	tbl_;
+		uint32_t			seed_;
+		uint8_t				index_[SLOT];
+
+		static constexpr uint32_t slot_(uint32_t h, uint32_t seed) noexcept
+		{
+			return ((h ^ seed) * 0x9e3779b1) >> (32 - BITS);
+		}
+
+		// 完全ハッシュの種が見つからない（コマンド名の重複）場合、定数式で無くなる
+		static void seed_not_found_() noexcept { }
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター（コンパイル時に評価する）
+			@param[in]	tbl		コマンド定義の表
+		*/
+		//-----------------------------------------------------------------//
+		constexpr command_dispatch(const entry_type (&tbl)[N]) noexcept :
+			tbl_(tbl), seed_(0), index_{ }
+		{
+			for(uint32_t seed = 0; seed < 0x10000; ++seed) {
+				for(uint32_t i = 0; i < SLOT; ++i) index_[i] = EMPTY;
+				bool ok = true;
+				for(uint32_t i = 0; i < N; ++i) {
+					auto s = slot_(CMD::hash(tbl[i].name), seed);
+					if(index_[s] != EMPTY) {
+						ok = false;
+						break;
+					}
+					index_[s] = i;
+				}
+				if(ok) {
+					seed_ = seed;
+					return;
+				}
+			}
+			seed_not_found_();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	先頭単語のコマンド定義を探す
+			@param[in]	cmd		コマンド入力
+			@return コマンド定義（無い場合「nullptr」）
+		*/
+		//-----------------------------------------------------------------//
+		const entry_type* find(const CMD& cmd) const noexcept
+		{
+			auto key = cmd.get_argv(0);
+			if(key == nullptr) return nullptr;
+			auto i = index_[slot_(cmd.get_hash(0), seed_)];
+			if(i == EMPTY) return nullptr;
+			if(std::strcmp(tbl_[i].name, key) != 0) return nullptr;
+			return &tbl_[i];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	先頭単語のコマンドを実行
+			@param[in]	ctx		コンテキスト
+			@param[in]	cmd		コマンド入力
+			@return コマンドが見つかった場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool exec(CTX& ctx, const CMD& cmd) const noexcept
+		{
+			auto e = find(cmd);
+			if(e == nullptr) return false;
+			e->func(ctx, cmd);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コマンド名の TAB 補完 @n
+					先頭単語の入力中に、TAB キーが押された場合、前方一致する @n
+					コマンド名を注入する。TAB キーを続けて押すと候補が切り替わる。
+			@param[in]	cmd		コマンド入力
+			@return 補完した場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool complete(CMD& cmd) const noexcept
+		{
+			char tmp[32];
+			if(!cmd.get_tab_prefix(tmp, sizeof(tmp))) return false;
+			if(std::strchr(tmp, ' ') != nullptr) return false;
+
+			auto l = std::strlen(tmp);
+			uint32_t n = 0;
+			for(uint32_t i = 0; i < N; ++i) {
+				if(std::strncmp(tbl_[i].name, tmp, l) == 0) ++n;
+			}
+			if(n == 0) return false;
+
+			auto k = (cmd.get_tab_count() - 1) % n;
+			for(uint32_t i = 0; i < N; ++i) {
+				if(std::strncmp(tbl_[i].name, tmp, l) != 0) continue;
+				if(k == 0) {
+					cmd.injection_tab(tbl_[i].name + l);
+					return true;
+				}
+				--k;
+			}
+			return false;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	HELP 表示
+			@param[in]	spc0	初期空白数
+			@param[in]	spc1	コマンド群文字数
+		*/
+		//-----------------------------------------------------------------//
+		void help(uint32_t spc0 = 4, uint32_t spc1 = 20) const noexcept
+		{
+			for(uint32_t i = 0; i < N; ++i) {
+				const auto& t = tbl_[i];
+				if(t.text == nullptr) continue;
+				for(uint32_t n = 0; n < spc0; ++n) {
+					utils::format(" ");
+				}
+				utils::format("%s") % t.name;
+				uint32_t n = std::strlen(t.name);
+				if(t.args != nullptr) {
+					utils::format(" %s") % t.args;
+					n += 1 + std::strlen(t.args);
+				}
+				while(n < spc1) { utils::format(" "); ++n; }
+				utils::format("%s\n") % t.text;
+			}
+		}
+	};
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	コマンド・ディスパッチの生成（コンパイル時）
+		@param[in]	tbl		コマンド定義の表
+		@return コマンド・ディスパッチ
+	*/
+	//-----------------------------------------------------------------//
+	template <class CTX, class CMD, uint32_t N>
+	constexpr auto make_command_dispatch(const command_entry<CTX, CMD> (&tbl)[N]) noexcept
+	{
+		return command_dispatch<CTX, CMD, N>(tbl);
+	}
+}
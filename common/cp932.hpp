@@ -0,0 +1,255 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	CP932（Shift-JIS）、Unicode 変換クラス @n
+			・二段の直接参照テーブル（cp932_tbl.hpp）で、１文字を定数時間で変換する。 @n
+			  （FatFs の ff_oem2uni、ff_uni2oem は、文字毎に二分探索を行う） @n
+			・変換結果は、FatFs（FF_CODE_PAGE 932）と同じ。 @n
+			・文字列変換では、ASCII の連続を４バイト単位で処理する。 @n
+			・CP932_COMPACT を有効にすると、Unicode → CP932 のテーブルを圧縮形式に @n
+			  する（約 46K バイト → 約 20K バイト、参照はビット数え上げが加わる）。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+#include <cstring>
+#include "common/cp932_tbl.hpp"
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  CP932 変換クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct cp932 {
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ２バイト文字の先頭バイトか検査
+			@param[in]	c	バイト
+			@return 先頭バイトなら「true」
+		*/
+		//-----------------------------------------------------------------//
+		static bool is_lead(uint8_t c) noexcept
+		{
+			return (0x81 <= c && c <= 0x9f) || (0xe0 <= c && c <= 0xfc);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  CP932 から Unicode（UTF-16）へ変換
+			@param[in]	sjis	CP932 コード
+			@return Unicode（変換出来ない場合０）
+		*/
+		//-----------------------------------------------------------------//
+		static uint16_t to_unicode(uint16_t sjis) noexcept
+		{
+			if(sjis < 0x80) return sjis;
+			if(sjis < 0x100) {
+				if(0xa1 <= sjis && sjis <= 0xdf) return 0xff61 + sjis - 0xa1;  // 半角カナ
+				return 0;
+			}
+			uint32_t hi = sjis >> 8;
+			uint32_t lo = sjis & 0xff;
+			if(hi < 0x80 || lo < cp932_tbl::SJIS_TRAIL_ORG) return 0;
+			lo -= cp932_tbl::SJIS_TRAIL_ORG;
+			if(lo >= cp932_tbl::SJIS_TRAIL_NUM) return 0;
+			auto row = cp932_tbl::sjis_lead[hi - 0x80];
+			if(row == 0) return 0;
+			return cp932_tbl::sjis_row[row - 1][lo];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  Unicode（UTF-16）から CP932 へ変換
+			@param[in]	uni		Unicode
+			@return CP932 コード（変換出来ない場合０）
+		*/
+		//-----------------------------------------------------------------//
+		static uint16_t from_unicode(uint32_t uni) noexcept
+		{
+			if(uni < 0x80) return uni;
+			if(uni >= 0x10000) return 0;
+			uint32_t blk = cp932_tbl::uni_idx[uni >> 6];
+			if(blk == 0) return 0;
+			--blk;
+			uint32_t bit = uni & 63;
+#ifndef CP932_COMPACT
+			return cp932_tbl::uni_blk[blk][bit];
+#else
+			const auto& m = cp932_tbl::uni_mask[blk];
+			uint32_t w = m[bit >> 5];
+			uint32_t sel = 1u << (bit & 31);
+			if((w & sel) == 0) return 0;
+			uint32_t n = cp932_tbl::uni_base[blk] + __builtin_popcount(w & (sel - 1));
+			if(bit >= 32) n += __builtin_popcount(m[0]);
+			return cp932_tbl::uni_val[n];
+#endif
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  CP932 文字列から UTF-8 文字列へ変換 @n
+					変換出来ない文字は捨てる。
+			@param[in]	src	ソース
+			@param[out]	dst	変換先
+			@param[in]	dsz	変換先のサイズ
+			@return 正常終了なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		static bool to_utf8(const char* src, char* dst, uint32_t dsz) noexcept
+		{
+			if(src == nullptr || dst == nullptr || dsz == 0) return false;
+
+			uint16_t wc = 0;
+			while(dsz > 1) {
+				if(wc == 0) {
+					auto n = ascii_copy_(src, dst, dsz);
+					src += n;
+					dst += n;
+					dsz -= n;
+					if(dsz <= 1) break;
+				}
+				uint8_t c = static_cast<uint8_t>(*src++);
+				if(c == 0) break;
+				uint16_t code;
+				if(wc != 0) {
+					code = 0;
+					if((0x40 <= c && c <= 0x7e) || (0x80 <= c && c <= 0xfc)) {
+						code = to_unicode((wc << 8) | c);
+					}
+					wc = 0;
+				} else if(is_lead(c)) {
+					wc = c;
+					continue;
+				} else {
+					code = to_unicode(c);
+				}
+				if(code == 0) continue;
+				auto len = put_utf8_(code, dst, dsz - 1);
+				if(len == 0) break;
+				dst += len;
+				dsz -= len;
+			}
+			*dst = 0;
+			return dsz > 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  UTF-8 文字列から CP932 文字列へ変換 @n
+					変換出来ない文字は捨てる。
+			@param[in]	src	ソース
+			@param[out]	dst	変換先
+			@param[in]	dsz	変換先のサイズ
+			@return 正常終了なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		static bool from_utf8(const char* src, char* dst, uint32_t dsz) noexcept
+		{
+			if(src == nullptr || dst == nullptr || dsz == 0) return false;
+
+			int8_t cnt = 0;
+			uint16_t code = 0;
+			while(dsz > 1) {
+				if(cnt == 0) {
+					auto n = ascii_copy_(src, dst, dsz);
+					src += n;
+					dst += n;
+					dsz -= n;
+					if(dsz <= 1) break;
+				}
+				uint8_t c = static_cast<uint8_t>(*src++);
+				if(c == 0) break;
+				if(c < 0x80) {
+					*dst++ = c;
+					--dsz;
+					code = 0;
+					cnt = 0;
+					continue;
+				} else if((c & 0xf0) == 0xe0) {
+					code = c & 0x0f;
+					cnt = 2;
+					continue;
+				} else if((c & 0xe0) == 0xc0) {
+					code = c & 0x1f;
+					cnt = 1;
+					continue;
+				} else if((c & 0xc0) == 0x80) {
+					code <<= 6;
+					code |= c & 0x3f;
+					--cnt;
+					if(cnt != 0) {
+						if(cnt < 0) cnt = 0;
+						continue;
+					}
+				} else {
+					cnt = 0;
+					continue;
+				}
+				auto wc = from_unicode(code);
+				if(code < 0x80 || wc == 0) continue;  // 冗長な符号化、変換出来ない文字
+				if(wc >= 0x100) {
+					if(dsz <= 2) break;
+					*dst++ = static_cast<char>(wc >> 8);
+					--dsz;
+				}
+				*dst++ = static_cast<char>(wc & 0xff);
+				--dsz;
+			}
+			*dst = 0;
+			return dsz > 0;
+		}
+
+	private:
+		// ASCII（0x01～0x7f）の連続を、４バイト単位でコピーする（終端の手前まで）
+		static uint32_t ascii_copy_(const char* src, char* dst, uint32_t dsz) noexcept
+		{
+			uint32_t n = 0;
+			// ４バイト境界まで（境界を跨いだ読み出しをしない為）
+			while((reinterpret_cast<uintptr_t>(src + n) & 3) != 0) {
+				uint8_t c = src[n];
+				if(c == 0 || c >= 0x80 || (n + 1) >= dsz) return n;
+				dst[n] = c;
+				++n;
+			}
+			while((n + 4) < dsz) {
+				uint32_t w;
+				std::memcpy(&w, src + n, 4);
+				if((w & 0x80808080) != 0) break;
+				if(((w - 0x01010101) & ~w & 0x80808080) != 0) break;  // ０を含む
+				std::memcpy(dst + n, &w, 4);
+				n += 4;
+			}
+			return n;
+		}
+
+		static uint32_t put_utf8_(uint16_t code, char* dst, uint32_t dsz) noexcept
+		{
+			if(code < 0x80) {
+				if(dsz < 1) return 0;
+				dst[0] = code;
+				return 1;
+			} else if(code < 0x800) {
+				if(dsz < 2) return 0;
+				dst[0] = 0xc0 | (code >> 6);
+				dst[1] = 0x80 | (code & 0x3f);
+				return 2;
+			} else {
+				if(dsz < 3) return 0;
+				dst[0] = 0xe0 | (code >> 12);
+				dst[1] = 0x80 | ((code >> 6) & 0x3f);
+				dst[2] = 0x80 | (code & 0x3f);
+				return 3;
+			}
+		}
+	};
+}
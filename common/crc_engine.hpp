@@ -0,0 +1,339 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	CRC／チェック・サム計算（ソフトウェア） @n
+			・CRC-8/16/32 をテーブル（slice-by-1/4/8）で計算する。 @n
+			  テーブルはコンパイル時に生成し、使う組み合わせだけが ROM に置かれる。 @n
+			  （slice-by-1: 1K バイト、slice-by-4: 4K バイト、slice-by-8: 8K バイト） @n
+			・インターネット・チェック・サム（RFC 1071） @n
+			・途中の値（レジスタ）は、ハードウェア（RX600/crc_mgr.hpp）の CRCDOR と @n
+			  同じ形なので、ソフトウェアとハードウェアを混ぜて使える。 @n
+			・ホストでも同じ結果になる。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  CRC 定義
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct crc_def {
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  CRC の種類
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class TYPE : uint8_t {
+			CRC8,			///< CRC-8/SMBUS（X^8+X^2+X+1、MSB ファースト）
+			CRC16,			///< CRC-16/ARC（X^16+X^15+X^2+1、LSB ファースト）
+			CRC16_CCITT,	///< CRC-16/XMODEM（X^16+X^12+X^5+1、MSB ファースト）
+			CRC32,			///< CRC-32（Ethernet、zip など、LSB ファースト）
+			CRC32C,			///< CRC-32C（Castagnoli、LSB ファースト）
+		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  CRC の仕様
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct spec_t {
+			uint32_t	poly;	///< 生成多項式（MSB ファーストの表記）
+			uint32_t	init;	///< 初期値
+			uint32_t	xorout;	///< 最後に XOR する値
+			uint32_t	check;	///< "123456789" の CRC
+			uint8_t		width;	///< ビット幅
+			bool		refl;	///< LSB ファーストの場合「true」
+		};
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  CRC の仕様を取得
+			@param[in]	type	CRC の種類
+			@return CRC の仕様
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr spec_t get_spec(TYPE type) noexcept
+		{
+			switch(type) {
+			case TYPE::CRC8:
+				return spec_t { 0x07, 0x00, 0x00, 0xF4, 8, false };
+			case TYPE::CRC16:
+				return spec_t { 0x8005, 0x0000, 0x0000, 0xBB3D, 16, true };
+			case TYPE::CRC16_CCITT:
+				return spec_t { 0x1021, 0x0000, 0x0000, 0x31C3, 16, false };
+			case TYPE::CRC32:
+				return spec_t { 0x04C1'1DB7, 0xFFFF'FFFF, 0xFFFF'FFFF, 0xCBF4'3926, 32, true };
+			case TYPE::CRC32C:
+			default:
+				return spec_t { 0x1EDC'6F41, 0xFFFF'FFFF, 0xFFFF'FFFF, 0xE306'9283, 32, true };
+			}
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  CRC テーブル（コンパイル時に生成）
+		@param[in]	CT		CRC の種類
+		@param[in]	SLICE	テーブルの数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <crc_def::TYPE CT, uint32_t SLICE>
+	struct crc_table {
+		static constexpr crc_def::spec_t SPEC = crc_def::get_spec(CT);
+		static constexpr uint32_t SHIFT = 32 - SPEC.width;	///< MSB ファーストは、上位に詰めて計算
+
+		uint32_t	t[SLICE][256];
+
+		constexpr crc_table() noexcept : t { } {
+			if constexpr (SPEC.refl) {
+				uint32_t poly = 0;
+				for(uint32_t i = 0; i < SPEC.width; ++i) {
+					poly = (poly << 1) | ((SPEC.poly >> i) & 1);
+				}
+				for(uint32_t i = 0; i < 256; ++i) {
+					uint32_t c = i;
+					for(uint32_t j = 0; j < 8; ++j) {
+						c = (c & 1) ? ((c >> 1) ^ poly) : (c >> 1);
+					}
+					t[0][i] = c;
+				}
+				for(uint32_t k = 1; k < SLICE; ++k) {
+					for(uint32_t i = 0; i < 256; ++i) {
+						auto c = t[k - 1][i];
+						t[k][i] = (c >> 8) ^ t[0][c & 0xff];
+					}
+				}
+			} else {
+				uint32_t poly = SPEC.poly << SHIFT;
+				for(uint32_t i = 0; i < 256; ++i) {
+					uint32_t c = i << 24;
+					for(uint32_t j = 0; j < 8; ++j) {
+						c = (c & 0x8000'0000) ? ((c << 1) ^ poly) : (c << 1);
+					}
+					t[0][i] = c;
+				}
+				for(uint32_t k = 1; k < SLICE; ++k) {
+					for(uint32_t i = 0; i < 256; ++i) {
+						auto c = t[k - 1][i];
+						t[k][i] = (c << 8) ^ t[0][c >> 24];
+					}
+				}
+			}
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  CRC 計算クラス（テーブル）
+		@param[in]	CT		CRC の種類
+		@param[in]	SLICE	一度に処理するバイト数（1、4、8）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <crc_def::TYPE CT, uint32_t SLICE = 4>
+	class crc_engine : public crc_def {
+
+		static_assert(SLICE == 1 || SLICE == 4 || SLICE == 8, "SLICE must be 1, 4 or 8");
+
+	public:
+		static constexpr spec_t SPEC = get_spec(CT);	///< CRC の仕様
+
+	private:
+		static constexpr uint32_t SHIFT = crc_table<CT, SLICE>::SHIFT;
+
+		static constexpr crc_table<CT, SLICE> table_ { };
+
+		static uint32_t le32_(const uint8_t* p) noexcept
+		{
+			return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+				| (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+		}
+
+		static uint32_t be32_(const uint8_t* p) noexcept
+		{
+			return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16)
+				| (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レジスタの初期値
+			@return 初期値
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr uint32_t init() noexcept { return SPEC.init; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レジスタから CRC を得る
+			@param[in]	reg	レジスタ
+			@return CRC
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr uint32_t final(uint32_t reg) noexcept { return reg ^ SPEC.xorout; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レジスタの更新（分割して計算できる）
+			@param[in]	reg	レジスタ
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+			@return レジスタ
+		*/
+		//-----------------------------------------------------------------//
+		static uint32_t update(uint32_t reg, const void* src, uint32_t len) noexcept
+		{
+			const auto& t = table_.t;
+			auto p = static_cast<const uint8_t*>(src);
+			if constexpr (SPEC.refl) {
+				uint32_t c = reg;
+				if constexpr (SLICE == 8) {
+					while(len >= 8) {
+						auto a = c ^ le32_(p);
+						auto b = le32_(p + 4);
+						c = t[7][a & 0xff] ^ t[6][(a >> 8) & 0xff] ^ t[5][(a >> 16) & 0xff] ^ t[4][a >> 24]
+						  ^ t[3][b & 0xff] ^ t[2][(b >> 8) & 0xff] ^ t[1][(b >> 16) & 0xff] ^ t[0][b >> 24];
+						p += 8;
+						len -= 8;
+					}
+				} else if constexpr (SLICE == 4) {
+					while(len >= 4) {
+						c ^= le32_(p);
+						c = t[3][c & 0xff] ^ t[2][(c >> 8) & 0xff] ^ t[1][(c >> 16) & 0xff] ^ t[0][c >> 24];
+						p += 4;
+						len -= 4;
+					}
+				}
+				while(len > 0) {
+					c = (c >> 8) ^ t[0][(c ^ *p) & 0xff];
+					++p;
+					--len;
+				}
+				return c;
+			} else {
+				uint32_t c = reg << SHIFT;
+				if constexpr (SLICE == 8) {
+					while(len >= 8) {
+						auto a = c ^ be32_(p);
+						auto b = be32_(p + 4);
+						c = t[7][a >> 24] ^ t[6][(a >> 16) & 0xff] ^ t[5][(a >> 8) & 0xff] ^ t[4][a & 0xff]
+						  ^ t[3][b >> 24] ^ t[2][(b >> 16) & 0xff] ^ t[1][(b >> 8) & 0xff] ^ t[0][b & 0xff];
+						p += 8;
+						len -= 8;
+					}
+				} else if constexpr (SLICE == 4) {
+					while(len >= 4) {
+						c ^= be32_(p);
+						c = t[3][c >> 24] ^ t[2][(c >> 16) & 0xff] ^ t[1][(c >> 8) & 0xff] ^ t[0][c & 0xff];
+						p += 4;
+						len -= 4;
+					}
+				}
+				while(len > 0) {
+					c = (c << 8) ^ t[0][(c >> 24) ^ *p];
+					++p;
+					--len;
+				}
+				return c >> SHIFT;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  CRC の計算
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+			@return CRC
+		*/
+		//-----------------------------------------------------------------//
+		static uint32_t calc(const void* src, uint32_t len) noexcept
+		{
+			return final(update(init(), src, len));
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  インターネット・チェック・サム（RFC 1071）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct inet_sum {
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  １６ビット（ビッグ・エンディアン）単位の和を加算 @n
+					奇数長の場合、最後のバイトは上位バイトとして加える。
+			@param[in]	sum	和
+			@param[in]	src	ソース
+			@param[in]	len	バイト数
+			@return 和（畳み込む前）
+		*/
+		//-----------------------------------------------------------------//
+		static uint32_t update(uint32_t sum, const void* src, uint32_t len) noexcept
+		{
+			auto p = static_cast<const uint8_t*>(src);
+			while(len >= 8) {
+				sum += ((static_cast<uint32_t>(p[0]) << 8) | p[1]) + ((static_cast<uint32_t>(p[2]) << 8) | p[3])
+					 + ((static_cast<uint32_t>(p[4]) << 8) | p[5]) + ((static_cast<uint32_t>(p[6]) << 8) | p[7]);
+				if(sum & 0x8000'0000) sum = (sum & 0xffff) + (sum >> 16);
+				p += 8;
+				len -= 8;
+			}
+			while(len >= 2) {
+				sum += (static_cast<uint32_t>(p[0]) << 8) | p[1];
+				p += 2;
+				len -= 2;
+			}
+			if(len > 0) {
+				sum += static_cast<uint32_t>(p[0]) << 8;
+			}
+			return sum;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  和を１６ビットに畳み込む
+			@param[in]	sum	和
+			@return １６ビットの和
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr uint16_t fold(uint32_t sum) noexcept
+		{
+			sum = (sum & 0xffff) + (sum >> 16);
+			sum = (sum & 0xffff) + (sum >> 16);
+			return sum;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  チェック・サムの計算
+			@param[in]	src		ソース
+			@param[in]	len		バイト数
+			@param[in]	sumorg	加える和（疑似ヘッダーなど）
+			@return チェック・サム
+		*/
+		//-----------------------------------------------------------------//
+		static uint16_t calc(const void* src, uint32_t len, uint16_t sumorg = 0) noexcept
+		{
+			return ~fold(update(sumorg, src, len));
+		}
+	};
+}
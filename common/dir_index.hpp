@@ -0,0 +1,707 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ディレクトリー・インデックス・クラス @n
+			・ディレクトリーの内容（名前、サイズ、日付、属性）を RAM に保持する。 @n
+			  名前は一つのプール（文字列を詰めて並べる）に置き、エントリーは @n
+			  プールのオフセットを持つ。（プールの先頭はディレクトリーのパス） @n
+			・並び順（名前、日付、サイズ）の表を持ち、取得しながら挿入する。 @n
+			  （ディレクトリーは常に先頭） @n
+			・service() で少しずつ取得するので、取得の途中でも先頭から表示できる。 @n
+			・dir_cache は、複数のディレクトリーのインデックスを保持し、戻った @n
+			  時に f_opendir/f_readdir をやり直さない。（ハッシュとパスで探す） @n
+			・file_io の書き込み（作成、追記、削除、名前の変更、ディレクトリーの @n
+			  作成）は、dir_index_base::touch で親ディレクトリーを通知し、 @n
+			  キャッシュを無効にする。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstring>
+#include <algorithm>
+#include "ff14/source/ff.h"
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  ディレクトリー・インデックス・ベース
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct dir_index_base {
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  並び順
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class SORT : uint8_t {
+			NONE,	///< 取得順
+			NAME,	///< 名前（英字の大小を区別しない）
+			DATE,	///< 日付
+			SIZE,	///< サイズ
+		};
+
+	private:
+		static constexpr uint32_t MOD_NUM = 8;	// 変更履歴の数（ディレクトリー）
+
+		static inline uint32_t mod_gen_ = 0;
+		static inline uint32_t mod_lost_ = 0;	// 捨てた履歴の最新の世代
+		static inline uint32_t mod_hash_[MOD_NUM] = { };
+		static inline uint32_t mod_tag_[MOD_NUM] = { };
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	パスのハッシュ（最後の「/」は含めない）
+			@param[in]	path	パス
+			@param[in]	len		長さ
+			@return ハッシュ
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t hash(const char* path, uint32_t len) noexcept
+		{
+			while(len > 0 && path[len - 1] == '/') --len;
+			uint32_t h = 0x811c'9dc5;
+			for(uint32_t i = 0; i < len; ++i) {
+				auto ch = static_cast<uint8_t>(path[i]);
+				if(ch >= 'A' && ch <= 'Z') ch += 'a' - 'A';
+				h = (h ^ ch) * 0x0100'0193;
+			}
+			return h;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	パスのハッシュ
+			@param[in]	path	パス
+			@return ハッシュ
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t hash(const char* path) noexcept
+		{
+			return hash(path, std::strlen(path));
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	パスの比較（hash と同じく、英字の大小、最後の「/」は区別しない）
+			@param[in]	a	パス
+			@param[in]	b	パス
+			@return 同じなら「true」
+		 */
+		//-----------------------------------------------------------------//
+		static bool same_path(const char* a, const char* b) noexcept
+		{
+			auto la = std::strlen(a);
+			auto lb = std::strlen(b);
+			while(la > 0 && a[la - 1] == '/') --la;
+			while(lb > 0 && b[lb - 1] == '/') --lb;
+			if(la != lb) return false;
+			for(uint32_t i = 0; i < la; ++i) {
+				auto ca = static_cast<uint8_t>(a[i]);
+				auto cb = static_cast<uint8_t>(b[i]);
+				if(ca >= 'A' && ca <= 'Z') ca += 'a' - 'A';
+				if(cb >= 'A' && cb <= 'Z') cb += 'a' - 'A';
+				if(ca != cb) return false;
+			}
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	親ディレクトリーのハッシュ
+			@param[in]	path	ファイル、ディレクトリーのフル・パス
+			@return ハッシュ
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t parent_hash(const char* path) noexcept
+		{
+			auto l = std::strlen(path);
+			while(l > 0 && path[l - 1] == '/') --l;
+			while(l > 0 && path[l - 1] != '/') --l;
+			return hash(path, l);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディレクトリーの変更を通知（キャッシュを無効にする）
+			@param[in]	h	ディレクトリーのハッシュ
+		 */
+		//-----------------------------------------------------------------//
+		static void touch_dir(uint32_t h) noexcept
+		{
+			++mod_gen_;
+			// 同じディレクトリーは、一つの履歴を更新する
+			uint32_t n = 0;
+			for(uint32_t i = 0; i < MOD_NUM; ++i) {
+				if(mod_tag_[i] != 0 && mod_hash_[i] == h) {
+					mod_tag_[i] = mod_gen_;
+					return;
+				}
+				if(static_cast<int32_t>(mod_tag_[i] - mod_tag_[n]) < 0) n = i;
+			}
+			// 最も古い履歴を捨てる
+			if(mod_tag_[n] != 0) mod_lost_ = mod_tag_[n];
+			mod_hash_[n] = h;
+			mod_tag_[n] = mod_gen_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変更の通知（親ディレクトリーのキャッシュを無効にする）
+			@param[in]	path	変更したファイル、ディレクトリーのフル・パス
+		 */
+		//-----------------------------------------------------------------//
+		static void touch(const char* path) noexcept
+		{
+			if(path == nullptr) return;
+
+			touch_dir(parent_hash(path));
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全てのキャッシュを無効にする（マウント状態の変化など）
+		 */
+		//-----------------------------------------------------------------//
+		static void touch_all() noexcept
+		{
+			++mod_gen_;
+			mod_lost_ = mod_gen_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	現在の変更世代を取得
+			@return 変更世代
+		 */
+		//-----------------------------------------------------------------//
+		static uint32_t get_generation() noexcept { return mod_gen_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変更されたか検査 @n
+					※捨てた履歴より古い場合は、変更されたとみなす。
+			@param[in]	h	ディレクトリーのハッシュ
+			@param[in]	gen	取得を開始した時の変更世代
+			@return 変更されたら「true」
+		 */
+		//-----------------------------------------------------------------//
+		static bool is_modified(uint32_t h, uint32_t gen) noexcept
+		{
+			if(mod_gen_ == gen) return false;
+			if(static_cast<int32_t>(mod_lost_ - gen) > 0) return true;
+			for(uint32_t i = 0; i < MOD_NUM; ++i) {
+				if(mod_hash_[i] == h && static_cast<int32_t>(mod_tag_[i] - gen) > 0) return true;
+			}
+			return false;
+		}
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  ディレクトリー・インデックス・クラス
+		@param[in]	ENTRY_MAX	エントリーの最大数
+		@param[in]	POOL_SIZE	名前プールの大きさ（バイト、先頭にディレクトリーのパスを置く）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t ENTRY_MAX, uint32_t POOL_SIZE>
+	class dir_index : public dir_index_base {
+
+		static_assert(ENTRY_MAX <= 65535, "ENTRY_MAX must be less than 65536");
+		static_assert(POOL_SIZE <= 65536, "POOL_SIZE must be 65536 or less");
+
+	public:
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  エントリー
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct entry_t {
+			uint32_t	size;	///< サイズ（4G 以上は 0xFFFFFFFF）
+			uint16_t	date;	///< 日付（FatFs の fdate）
+			uint16_t	time;	///< 時間（FatFs の ftime）
+			uint16_t	name;	///< 名前（プールのオフセット）
+			uint8_t		attr;	///< 属性（AM_DIR など）
+		};
+
+	private:
+		DIR			dir_;
+		entry_t		ent_[ENTRY_MAX];
+		uint16_t	order_[ENTRY_MAX];
+		char		pool_[POOL_SIZE];
+		uint32_t	num_;
+		uint32_t	pool_pos_;
+		uint32_t	hash_;
+		uint32_t	gen_;
+		uint32_t	serial_;
+		SORT		sort_;
+		bool		rev_;
+		bool		scan_;
+		bool		done_;
+		bool		over_;
+
+		static int cmp_name_(const char* a, const char* b) noexcept
+		{
+			while(1) {
+				auto ca = static_cast<uint8_t>(*a++);
+				auto cb = static_cast<uint8_t>(*b++);
+				if(ca >= 'A' && ca <= 'Z') ca += 'a' - 'A';
+				if(cb >= 'A' && cb <= 'Z') cb += 'a' - 'A';
+				if(ca != cb || ca == 0) return static_cast<int>(ca) - static_cast<int>(cb);
+			}
+		}
+
+		// a が b より前なら「true」
+		bool before_(uint16_t a, uint16_t b) const noexcept
+		{
+			const auto& ea = ent_[a];
+			const auto& eb = ent_[b];
+			bool da = (ea.attr & AM_DIR) != 0;
+			bool db = (eb.attr & AM_DIR) != 0;
+			if(da != db) return da;
+
+			int c = 0;
+			switch(sort_) {
+			case SORT::NAME:
+				break;
+			case SORT::DATE:
+				{
+					auto ta = (static_cast<uint32_t>(ea.date) << 16) | ea.time;
+					auto tb = (static_cast<uint32_t>(eb.date) << 16) | eb.time;
+					if(ta != tb) c = ta < tb ? -1 : 1;
+				}
+				break;
+			case SORT::SIZE:
+				if(ea.size != eb.size) c = ea.size < eb.size ? -1 : 1;
+				break;
+			case SORT::NONE:
+			default:
+				return a < b;
+			}
+			if(c == 0) c = cmp_name_(&pool_[ea.name], &pool_[eb.name]);
+			if(c == 0) return a < b;
+			return rev_ ? (c > 0) : (c < 0);
+		}
+
+		void insert_(uint16_t idx) noexcept
+		{
+			// 二分探索で挿入位置を決める
+			uint32_t lo = 0;
+			uint32_t hi = num_;
+			while(lo < hi) {
+				auto mid = (lo + hi) / 2;
+				if(before_(idx, order_[mid])) hi = mid;
+				else lo = mid + 1;
+			}
+			std::memmove(&order_[lo + 1], &order_[lo], (num_ - lo) * sizeof(uint16_t));
+			order_[lo] = idx;
+		}
+
+		bool add_(const FILINFO& fi) noexcept
+		{
+			auto l = std::strlen(fi.fname) + 1;
+			if(num_ >= ENTRY_MAX || (pool_pos_ + l) > POOL_SIZE) {
+				over_ = true;
+				return false;
+			}
+			auto& e = ent_[num_];
+			e.size = static_cast<uint64_t>(fi.fsize) > 0xffff'ffff ? 0xffff'ffff : static_cast<uint32_t>(fi.fsize);
+			e.date = fi.fdate;
+			e.time = fi.ftime;
+			e.name = pool_pos_;
+			e.attr = fi.fattrib;
+			std::memcpy(&pool_[pool_pos_], fi.fname, l);
+			pool_pos_ += l;
+			insert_(num_);
+			++num_;
+			return true;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		 */
+		//-----------------------------------------------------------------//
+		dir_index() noexcept : dir_(), ent_{ }, order_{ }, pool_{ }, num_(0), pool_pos_(0),
+			hash_(0), gen_(0), serial_(0), sort_(SORT::NAME), rev_(false),
+			scan_(false), done_(false), over_(false) { }
+
+
+		dir_index(const dir_index& th) = delete;
+		dir_index& operator = (const dir_index& th) = delete;
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	取得開始 @n
+					※「probe()」が「false」になるまで「service()」を呼ぶ
+			@param[in]	path	ディレクトリーのフル・パス
+			@return エラー無ければ「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool start(const char* path) noexcept
+		{
+			stop();
+			num_ = 0;
+			pool_pos_ = 0;
+			pool_[0] = 0;
+			hash_ = 0;
+			done_ = false;
+			over_ = false;
+			++serial_;
+			if(path == nullptr) return false;
+
+			// パスは、名前プールの先頭に置く
+			auto l = std::strlen(path) + 1;
+			if(l > POOL_SIZE) {
+				over_ = true;
+				return false;
+			}
+			std::memcpy(&pool_[0], path, l);
+			pool_pos_ = l;
+			hash_ = hash(path);
+			gen_ = get_generation();
+			if(f_opendir(&dir_, path) != FR_OK) {
+				return false;
+			}
+			scan_ = true;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	取得を止める（途中までのエントリーは残る）
+		 */
+		//-----------------------------------------------------------------//
+		void stop() noexcept
+		{
+			if(!scan_) return;
+
+			scan_ = false;
+			f_closedir(&dir_);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	サービス（取得を進める）
+			@param[in]	num		一回に取得するエントリー数
+			@return 取得中なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool service(uint32_t num) noexcept
+		{
+			if(!scan_) return false;
+
+			for(uint32_t i = 0; i < num; ++i) {
+				FILINFO fi;
+				if(f_readdir(&dir_, &fi) != FR_OK) {
+					stop();
+					break;
+				}
+				if(fi.fname[0] == 0) {
+					stop();
+					done_ = true;
+					break;
+				}
+				if(!add_(fi)) {
+					stop();
+					done_ = true;
+					break;
+				}
+			}
+			++serial_;
+			return scan_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	プローブ（状態）
+			@return 取得中なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool probe() const noexcept { return scan_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	取得中、又は取得を終えて、変更されていないか
+			@return 有効なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_valid() const noexcept { return (scan_ || done_) && !is_modified(hash_, gen_); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	エントリー、又は名前プールが溢れたか
+			@return 溢れた場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_overflow() const noexcept { return over_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディレクトリーのハッシュを取得
+			@return ハッシュ
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_hash() const noexcept { return hash_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディレクトリーのパスを取得
+			@return パス（開始していない場合は「""」）
+		 */
+		//-----------------------------------------------------------------//
+		const char* get_path() const noexcept { return &pool_[0]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	変化のシリアル（取得、並び替えで変わる、再描画の判定用）
+			@return シリアル
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t get_serial() const noexcept { return serial_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	エントリー数を取得（取得中は、その時点の数）
+			@return エントリー数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t size() const noexcept { return num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	エントリーを取得
+			@param[in]	pos	並び順の位置
+			@return エントリー
+		 */
+		//-----------------------------------------------------------------//
+		const entry_t& get(uint32_t pos) const noexcept { return ent_[order_[pos]]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	名前を取得
+			@param[in]	pos	並び順の位置
+			@return 名前（範囲外なら「""」）
+		 */
+		//-----------------------------------------------------------------//
+		const char* get_name(uint32_t pos) const noexcept
+		{
+			if(pos >= num_) return "";
+			return &pool_[get(pos).name];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディレクトリーか？
+			@param[in]	pos	並び順の位置
+			@return ディレクトリーなら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_dir(uint32_t pos) const noexcept
+		{
+			if(pos >= num_) return false;
+			return (get(pos).attr & AM_DIR) != 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	名前の位置を探す
+			@param[in]	name	名前
+			@return 並び順の位置（無い場合は size()）
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t find(const char* name) const noexcept
+		{
+			for(uint32_t i = 0; i < num_; ++i) {
+				if(cmp_name_(get_name(i), name) == 0) return i;
+			}
+			return num_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	並び順を設定（取得済みのエントリーも並べ替える）
+			@param[in]	sort	並び順
+			@param[in]	rev		逆順の場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		void set_sort(SORT sort, bool rev = false) noexcept
+		{
+			if(sort == sort_ && rev == rev_) return;
+
+			sort_ = sort;
+			rev_ = rev;
+			std::sort(&order_[0], &order_[num_],
+				[this](uint16_t a, uint16_t b) { return before_(a, b); });
+			++serial_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	並び順を取得
+			@return 並び順
+		 */
+		//-----------------------------------------------------------------//
+		SORT get_sort() const noexcept { return sort_; }
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  ディレクトリー・キャッシュ・クラス @n
+				最後に使われたディレクトリーから SLOT 個を保持する。
+		@param[in]	SLOT		保持するディレクトリー数
+		@param[in]	ENTRY_MAX	ディレクトリー毎のエントリーの最大数
+		@param[in]	POOL_SIZE	ディレクトリー毎の名前プールの大きさ
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t SLOT, uint32_t ENTRY_MAX, uint32_t POOL_SIZE>
+	class dir_cache : public dir_index_base {
+	public:
+		typedef dir_index<ENTRY_MAX, POOL_SIZE> INDEX;
+
+	private:
+		INDEX		index_[SLOT];
+		uint32_t	use_[SLOT];
+		uint32_t	tick_;
+		uint32_t	cur_;
+		SORT		sort_;
+		bool		rev_;
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		 */
+		//-----------------------------------------------------------------//
+		dir_cache() noexcept : index_(), use_{ }, tick_(0), cur_(0), sort_(SORT::NAME), rev_(false) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ディレクトリーを開く @n
+					キャッシュが有効ならそのまま、無効なら取得を開始する。
+			@param[in]	path	ディレクトリーのフル・パス
+			@return インデックス
+		 */
+		//-----------------------------------------------------------------//
+		INDEX& open(const char* path) noexcept
+		{
+			auto h = hash(path);
+			++tick_;
+			uint32_t n = SLOT;
+			for(uint32_t i = 0; i < SLOT; ++i) {
+				if(use_[i] != 0 && index_[i].get_hash() == h && same_path(index_[i].get_path(), path)) {
+					n = i;
+					break;
+				}
+			}
+			if(n < SLOT && index_[n].is_valid()) {
+				if(n != cur_) index_[cur_].stop();
+				cur_ = n;
+				use_[n] = tick_;
+				index_[n].set_sort(sort_, rev_);
+				return index_[n];
+			}
+			if(n == SLOT) {  // 最も古いスロット
+				n = 0;
+				for(uint32_t i = 1; i < SLOT; ++i) {
+					if(use_[i] < use_[n]) n = i;
+				}
+			}
+			index_[cur_].stop();
+			cur_ = n;
+			use_[n] = tick_;
+			index_[n].set_sort(sort_, rev_);
+			index_[n].start(path);
+			return index_[n];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	現在のインデックス
+			@return インデックス
+		 */
+		//-----------------------------------------------------------------//
+		INDEX& at() noexcept { return index_[cur_]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	現在のインデックス
+			@return インデックス
+		 */
+		//-----------------------------------------------------------------//
+		const INDEX& get() const noexcept { return index_[cur_]; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	サービス（現在のインデックスの取得を進める）
+			@param[in]	num		一回に取得するエントリー数
+			@return 取得中なら「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool service(uint32_t num) noexcept { return index_[cur_].service(num); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	並び順を設定
+			@param[in]	sort	並び順
+			@param[in]	rev		逆順の場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		void set_sort(SORT sort, bool rev = false) noexcept
+		{
+			sort_ = sort;
+			rev_ = rev;
+			index_[cur_].set_sort(sort, rev);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全て破棄（アンマウント時など）
+		 */
+		//-----------------------------------------------------------------//
+		void clear() noexcept
+		{
+			for(uint32_t i = 0; i < SLOT; ++i) {
+				index_[i].stop();
+				use_[i] = 0;
+			}
+		}
+	};
+}
@@ -4,9 +4,10 @@
 	@brief	ファイル・入出力クラス @n
 			※ FatFs のラッパー（ff14 以降が必要） @n
 			※ FatFs のファイル操作系をラップして fopen ぽい機能を提供する。@n
-			※ fopen と違って、バッファリング（キャッシュ）されない。
+			※ fopen と違って、バッファリング（キャッシュ）されない。@n
+			※ 書き込み、削除、名前の変更は、dir_index のキャッシュに通知する。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2018, 2020 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -18,6 +19,7 @@
 #include "common/string_utils.hpp"
 #include "common/format.hpp"
 #include "common/dir_list.hpp"
+#include "common/dir_index.hpp"
 
 // カレントパスの管理を自前で行う場合
 #if FF_FS_EXFAT > 0
@@ -67,6 +69,8 @@ namespace utils {
 		FIL			fp_;
 		bool		open_;
 		bool		error_;
+		bool		wr_;
+		uint32_t	wr_dir_;	// 書き込むファイルの親ディレクトリー（ハッシュ）
 
 		struct dir_list_t {
 			bool		ll_;
@@ -173,6 +177,15 @@ namespace utils {
 		static char current_path_[PATH_MAX_SIZE];
 #endif
 
+		// 親ディレクトリーのキャッシュを無効にする
+		static void touch_(const char* path) noexcept
+		{
+			char tmp[PATH_MAX_SIZE];
+			if(make_full_path(path, tmp, sizeof(tmp))) {
+				dir_index_base::touch(tmp);
+			}
+		}
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
@@ -181,7 +194,7 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		file_io_() noexcept :
 			fp_(),
-			open_(false), error_(false)
+			open_(false), error_(false), wr_(false), wr_dir_(0)
 		{ }
 
 
@@ -202,7 +215,9 @@ namespace utils {
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		static bool mkdir(const char* path) noexcept
 		{
-			return f_mkdir(path) == FR_OK;
+			if(f_mkdir(path) != FR_OK) return false;
+			touch_(path);
+			return true;
 		}
 
 
@@ -215,7 +230,9 @@ namespace utils {
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		static bool remove(const char* path) noexcept
 		{
-			return f_unlink(path) == FR_OK;
+			if(f_unlink(path) != FR_OK) return false;
+			touch_(path);
+			return true;
 		}
 
 
@@ -229,7 +246,10 @@ namespace utils {
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		static bool rename(const char* org_path, const char* new_path) noexcept
 		{
-			return f_rename(org_path, new_path) == FR_OK;
+			if(f_rename(org_path, new_path) != FR_OK) return false;
+			touch_(org_path);
+			touch_(new_path);
+			return true;
 		}
 
 
@@ -374,6 +394,16 @@ namespace utils {
 			}
 			open_ = true;
 			error_ = false;
+			wr_ = (mdf & FA_WRITE) != 0;
+			if(wr_) {
+				char tmp[PATH_MAX_SIZE];
+				if(make_full_path(filename, tmp, sizeof(tmp))) {
+					wr_dir_ = dir_index_base::parent_hash(tmp);
+				} else {
+					wr_dir_ = dir_index_base::hash("");
+				}
+				dir_index_base::touch_dir(wr_dir_);
+			}
 			return true;
 		}
 
@@ -421,7 +451,12 @@ namespace utils {
 				return false;
 			}
 			open_ = false;
-			return f_close(&fp_) == FR_OK;
+			auto ret = f_close(&fp_) == FR_OK;
+			if(wr_) {  // サイズ、日付が変わる
+				dir_index_base::touch_dir(wr_dir_);
+				wr_ = false;
+			}
+			return ret;
 		}
 
 
@@ -601,7 +636,11 @@ namespace utils {
 		{
 			if(!open_) return false;
 
-			return f_sync(&fp_) == FR_OK;
+			auto ret = f_sync(&fp_) == FR_OK;
+			if(wr_) {
+				dir_index_base::touch_dir(wr_dir_);
+			}
+			return ret;
 		}
 
 
@@ -0,0 +1,333 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	固定小数点 FFT クラス（基数４） @n
+			・点数は４のべき乗（64, 256, 1024, 4096） @n
+			・データは Q15 相当の整数（int32_t）で保持し、各段で 1/4 にスケーリング @n
+			  するので、結果は「入力 x 1/N」のスケールになる。 @n
+			・窓関数（Hann, Blackman）、対数振幅（dB）変換を含む。 @n
+			・FPU を使わないので、RX マイコンとホスト（gcc）で同じ結果になる。 @n
+			・回転因子と窓関数のテーブルは、コンパイル時に作る（ROM に置かれ、 @n
+			  実行時の三角関数、初期化の時間、RAM を使わない）。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  固定小数点 FFT クラス
+		@param[in]	N	点数（４のべき乗）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t N>
+	class fixed_fft {
+
+		static constexpr bool is_pow4_(uint32_t n) noexcept {
+			return n >= 4 && (n & (n - 1)) == 0 && (n & 0x55555555) != 0;
+		}
+		static_assert(is_pow4_(N), "N must be power of 4");
+
+		static constexpr uint32_t log4_(uint32_t n) noexcept {
+			uint32_t l = 0;
+			while(n > 1) { n >>= 2; ++l; }
+			return l;
+		}
+
+	public:
+		static constexpr uint32_t SIZE = N;				///< 点数
+		static constexpr uint32_t STAGE = log4_(N);		///< 段数
+		static constexpr int32_t ONE = 32768;			///< 1.0 (Q15)
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  窓関数型
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class WINDOW : uint8_t {
+			RECT,		///< 矩形（窓無し）
+			HANN,		///< ハン窓
+			BLACKMAN,	///< ブラックマン窓
+		};
+
+	private:
+		// コンパイル時の sin, cos（テイラー展開、|x| <= π/2 で誤差 1e-16 程度）
+		static constexpr double taylor_cos_(double x) noexcept
+		{
+			double t = 1.0;
+			double s = 1.0;
+			for(int n = 1; n <= 12; ++n) {
+				t *= -x * x / static_cast<double>((2 * n - 1) * (2 * n));
+				s += t;
+			}
+			return s;
+		}
+
+		static constexpr double taylor_sin_(double x) noexcept
+		{
+			double t = x;
+			double s = x;
+			for(int n = 1; n <= 12; ++n) {
+				t *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+				s += t;
+			}
+			return s;
+		}
+
+		// cos(2πk/N)：象限に分けて、展開する角度を π/2 未満にする
+		static constexpr double cos_k_(uint32_t k) noexcept
+		{
+			constexpr double PI_2 = 1.57079632679489661923;
+			k &= N - 1;
+			auto q = k / (N / 4);
+			auto a = PI_2 * static_cast<double>(k % (N / 4)) / static_cast<double>(N / 4);
+			switch(q) {
+			case 0:  return  taylor_cos_(a);
+			case 1:  return -taylor_sin_(a);
+			case 2:  return -taylor_cos_(a);
+			default: return  taylor_sin_(a);
+			}
+		}
+
+		static constexpr int16_t q15_(double v) noexcept
+		{
+			auto a = v * 32767.0 + 0.5;
+			auto i = static_cast<int32_t>(a);
+			if(static_cast<double>(i) > a) --i;  // floor
+			if(i > 32767) i = 32767;
+			else if(i < -32768) i = -32768;
+			return static_cast<int16_t>(i);
+		}
+
+		struct table_t {
+			int16_t	cos[N];			// cos(2πk/N) Q15（sin は位相をずらして参照）
+			int16_t	hann[N];
+			int16_t	blackman[N];
+		};
+
+		static constexpr table_t make_table_() noexcept
+		{
+			table_t t { };
+			for(uint32_t i = 0; i < N; ++i) {
+				auto c1 = cos_k_(i);
+				auto c2 = cos_k_(i * 2);
+				t.cos[i] = q15_(c1);
+				t.hann[i] = q15_(0.5 - 0.5 * c1);
+				t.blackman[i] = q15_(0.42 - 0.5 * c1 + 0.08 * c2);
+			}
+			return t;
+		}
+
+		static constexpr table_t table_ = make_table_();
+
+		const int16_t*	win_;	// nullptr なら矩形
+		WINDOW			window_;
+
+		int32_t		re_[N];
+		int32_t		im_[N];
+
+		static int32_t cos_tw_(uint32_t k) noexcept { return table_.cos[k & (N - 1)]; }
+		static int32_t sin_tw_(uint32_t k) noexcept { return table_.cos[(k - N / 4) & (N - 1)]; }
+
+		static uint32_t digit_rev_(uint32_t i) noexcept
+		{
+			uint32_t r = 0;
+			for(uint32_t s = 0; s < STAGE; ++s) {
+				r = (r << 2) | (i & 3);
+				i >>= 2;
+			}
+			return r;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクタ
+			@param[in]	win		窓関数型
+		*/
+		//-----------------------------------------------------------------//
+		fixed_fft(WINDOW win = WINDOW::HANN) noexcept : win_(nullptr), window_(win), re_{ }, im_{ }
+		{
+			set_window(win);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  窓関数の設定
+			@param[in]	win		窓関数型
+		*/
+		//-----------------------------------------------------------------//
+		void set_window(WINDOW win) noexcept
+		{
+			window_ = win;
+			switch(win) {
+			case WINDOW::HANN:
+				win_ = table_.hann;
+				break;
+			case WINDOW::BLACKMAN:
+				win_ = table_.blackman;
+				break;
+			default:
+				win_ = nullptr;
+				break;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  窓関数型の取得
+			@return 窓関数型
+		*/
+		//-----------------------------------------------------------------//
+		auto get_window() const noexcept { return window_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  実数入力の設定（窓関数を掛ける）
+			@param[in]	pos		位置
+			@param[in]	val		値（±32767 の範囲）
+		*/
+		//-----------------------------------------------------------------//
+		void set(uint32_t pos, int32_t val) noexcept
+		{
+			pos &= N - 1;
+			if(win_ != nullptr) {
+				re_[pos] = (val * win_[pos]) >> 15;
+			} else {
+				re_[pos] = val;
+			}
+			im_[pos] = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  FFT 実行（結果は周波数順に並ぶ）
+		*/
+		//-----------------------------------------------------------------//
+		void transform() noexcept
+		{
+			// 基数４、周波数間引き（DIF）
+			for(uint32_t n1 = N; n1 > 1; n1 >>= 2) {
+				uint32_t n2 = n1 >> 2;
+				uint32_t stride = N / n1;
+				for(uint32_t j = 0; j < n2; ++j) {
+					auto k1 = j * stride;
+					int32_t w1r = cos_tw_(k1);
+					int32_t w1i = -sin_tw_(k1);
+					int32_t w2r = cos_tw_(k1 * 2);
+					int32_t w2i = -sin_tw_(k1 * 2);
+					int32_t w3r = cos_tw_(k1 * 3);
+					int32_t w3i = -sin_tw_(k1 * 3);
+					for(uint32_t i = j; i < N; i += n1) {
+						auto i1 = i + n2;
+						auto i2 = i1 + n2;
+						auto i3 = i2 + n2;
+						int32_t b0r = re_[i] + re_[i2];
+						int32_t b0i = im_[i] + im_[i2];
+						int32_t b1r = re_[i] - re_[i2];
+						int32_t b1i = im_[i] - im_[i2];
+						int32_t b2r = re_[i1] + re_[i3];
+						int32_t b2i = im_[i1] + im_[i3];
+						int32_t b3r = re_[i1] - re_[i3];
+						int32_t b3i = im_[i1] - im_[i3];
+
+						re_[i] = (b0r + b2r) >> 2;
+						im_[i] = (b0i + b2i) >> 2;
+
+						// y1 = b1 - j*b3, y2 = b0 - b2, y3 = b1 + j*b3
+						int32_t y1r = (b1r + b3i) >> 2;
+						int32_t y1i = (b1i - b3r) >> 2;
+						int32_t y2r = (b0r - b2r) >> 2;
+						int32_t y2i = (b0i - b2i) >> 2;
+						int32_t y3r = (b1r - b3i) >> 2;
+						int32_t y3i = (b1i + b3r) >> 2;
+
+						re_[i1] = (y1r * w1r - y1i * w1i) >> 15;
+						im_[i1] = (y1r * w1i + y1i * w1r) >> 15;
+						re_[i2] = (y2r * w2r - y2i * w2i) >> 15;
+						im_[i2] = (y2r * w2i + y2i * w2r) >> 15;
+						re_[i3] = (y3r * w3r - y3i * w3i) >> 15;
+						im_[i3] = (y3r * w3i + y3i * w3r) >> 15;
+					}
+				}
+			}
+
+			// 桁反転（基数４）
+			for(uint32_t i = 0; i < N; ++i) {
+				auto r = digit_rev_(i);
+				if(r > i) {
+					auto t = re_[i]; re_[i] = re_[r]; re_[r] = t;
+					t = im_[i]; im_[i] = im_[r]; im_[r] = t;
+				}
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  パワー（振幅の二乗）の取得
+			@param[in]	pos		周波数ビン
+			@return パワー
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_power(uint32_t pos) const noexcept
+		{
+			pos &= N - 1;
+			auto r = re_[pos];
+			auto i = im_[pos];
+			return static_cast<uint32_t>(r * r) + static_cast<uint32_t>(i * i);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  パワーを dB（Q8）に変換 @n
+					log2 の近似を使う（誤差 0.1dB 以下）、0 入力は 0 を返す。
+			@param[in]	pwr		パワー
+			@return dB x 256
+		*/
+		//-----------------------------------------------------------------//
+		static int32_t power_to_db(uint32_t pwr) noexcept
+		{
+			if(pwr == 0) return 0;
+			int32_t e = 31;
+			while((pwr & 0x80000000) == 0) {
+				pwr <<= 1;
+				--e;
+			}
+			// 仮数部 m (0 ~ 1) の log2(1 + m) を二次式で近似: m + 0.34 m (1 - m)
+			int32_t m = (pwr >> 15) & 0xffff;  // Q16
+			int32_t l = m + ((((m * 0x5700) >> 16) * (0x10000 - m)) >> 16);
+			int32_t log2q16 = (e << 16) + l;
+			// 10 * log10(2) = 3.0103 (Q8: 770.6)
+			return static_cast<int32_t>((static_cast<int64_t>(log2q16) * 771) >> 16);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  実部の参照
+			@return 実部
+		*/
+		//-----------------------------------------------------------------//
+		const int32_t* get_re() const noexcept { return re_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  虚部の参照
+			@return 虚部
+		*/
+		//-----------------------------------------------------------------//
+		const int32_t* get_im() const noexcept { return im_; }
+	};
+}
@@ -92,6 +92,21 @@ namespace utils {
 		}
 
 
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  格納ポイントをまとめて移動（DMA、ブロック転送用）
+			@param[in]	n	移動数（SIZE 以下）
+        */
+        //-----------------------------------------------------------------//
+		inline void put_go(uint32_t n) noexcept {
+			volatile auto put = put_ + n;
+			if(put >= SIZE) {
+				put -= SIZE;
+			}
+			put_ = put;
+		}
+
+
         //-----------------------------------------------------------------//
         /*!
             @brief  値の格納
@@ -131,6 +146,21 @@ namespace utils {
 		}
 
 
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  取得ポイントをまとめて移動（DMA、ブロック転送用）
+			@param[in]	n	移動数（SIZE 以下）
+        */
+        //-----------------------------------------------------------------//
+		inline void get_go(uint32_t n) noexcept {
+			volatile auto get = get_ + n;
+			if(get >= SIZE) {
+				get -= SIZE;
+			}
+			get_ = get;
+		}
+
+
         //-----------------------------------------------------------------//
         /*!
             @brief  値の取得
@@ -0,0 +1,753 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	データ・フラッシュ KV（キー・バリュー）ストア @n
+			・データ・フラッシュを「セグメント」（消去単位の整数倍）に分け、 @n
+			  レコードを追記だけで書き込む（ログ構造）。 @n
+			・mount で一度だけ全体を走査し、キー → 位置の索引を RAM に作る。 @n
+			  以降の probe/read/write は、フラッシュを走査しない。 @n
+			・レコードの末尾の CRC ワードを最後に書き込み、これをコミットとする。 @n
+			  電源断で途切れたレコードは、mount 時に捨てる。 @n
+			・ガーベージ・コレクション（GC）は、service() から少しずつ行う @n
+			  （レコード１個のコピー、又は消去単位１個の消去）。 @n
+			・セグメント・ヘッダーに消去回数を持ち、空きセグメントは消去回数の @n
+			  少ない物から使う。消去回数の差が WEAR_DELTA を超えたら、書き換えの @n
+			  無いセグメントを移動する（静的ウェアレベリング）。 @n
+			セグメントの構造： @n
+			  +0: 消去回数、+4: MAGIC（消去直後に、この順で書く） @n
+			  +8: シーケンス番号、+12: ~シーケンス番号（使用開始時に書く、 @n
+			      ブランクなら空き） @n
+			  +16: レコード... @n
+			レコードの構造： @n
+			  +0: キー（B15-B0）、長さ（B30-B16）、削除（B31） @n
+			  +4: データ（４バイト単位に 0xFF で埋める） @n
+			  +n: CRC-32（レコード先頭ワードとデータ） @n
+			途切れたレコードの後ろには、mount 時に PAD ワードを書き、 @n
+			その後ろから追記を続ける。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+#include <cstring>
+#include "common/crc_engine.hpp"
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  データ・フラッシュ KV ストア・クラス
+		@param[in]	FIO			フラッシュ I/O（device::flash_io など）
+		@param[in]	SEG_SIZE	セグメント・サイズ（消去単位の整数倍、標準は 1024 又は消去単位）
+		@param[in]	KEY_MAX		キーの最大数（削除済みキーを含む）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class FIO, uint32_t SEG_SIZE = (FIO::DATA_ERASE_SIZE > 1024 ? FIO::DATA_ERASE_SIZE : 1024), uint32_t KEY_MAX = 64>
+	class flash_kv {
+
+		static_assert((SEG_SIZE % FIO::DATA_ERASE_SIZE) == 0, "SEG_SIZE must be a multiple of DATA_ERASE_SIZE");
+		static_assert((SEG_SIZE % 4) == 0 && SEG_SIZE >= 128, "SEG_SIZE is too small");
+		static_assert((FIO::DATA_SIZE / SEG_SIZE) >= 3, "At least 3 segments are required");
+
+	public:
+		static constexpr uint32_t SEG_NUM = FIO::DATA_SIZE / SEG_SIZE;	///< セグメント数
+		static constexpr uint32_t HEAD_SIZE = 16;						///< セグメント・ヘッダー・サイズ
+		static constexpr uint32_t VALUE_MAX = (SEG_SIZE - HEAD_SIZE - 8) < 0x7fff ? (SEG_SIZE - HEAD_SIZE - 8) : 0x7fff;	///< 値の最大長
+		static constexpr uint16_t KEY_NONE = 0xffff;					///< 使えないキー
+		static constexpr uint32_t WEAR_DELTA = 32;						///< 静的ウェアレベリングを行う消去回数の差
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  状態情報
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct info_t {
+			uint32_t	seg_free;	///< 空きセグメント数
+			uint32_t	seg_dirty;	///< 消去が必要なセグメント数
+			uint32_t	keys;		///< 有効なキーの数
+			uint32_t	live;		///< 有効なレコードの合計サイズ
+			uint32_t	erase_min;	///< 最小消去回数
+			uint32_t	erase_max;	///< 最大消去回数
+			uint32_t	gc_count;	///< GC で回収したセグメント数
+		};
+
+	private:
+		static constexpr uint32_t MAGIC = 0x3153'564B;	// "KVS1"
+		static constexpr uint32_t PAD = 0x0000'ffff;	// キー 0xFFFF、長さ０
+		static constexpr uint32_t NONE = SEG_NUM;
+		static constexpr uint32_t DEL = 0x8000;
+		static constexpr uint32_t CHUNK = 32;
+
+		enum class STATE : uint8_t {
+			DIRTY,	// 消去が必要
+			FREE,	// 空き
+			ACTIVE,	// 追記中
+			FULL,	// 追記終了
+		};
+
+		struct seg_t {
+			uint32_t	seq;
+			uint32_t	erase;
+			uint32_t	wp;		// 書き込み位置（SEG_SIZE なら終了）
+			uint32_t	tail;	// 書き込まれた最後のワードの次
+			uint32_t	live;	// 有効なレコードの合計サイズ
+			STATE		state;
+		};
+
+		struct idx_t {
+			uint16_t	key;
+			uint16_t	len;	// B15: 削除
+			uint32_t	pos;	// レコードの位置
+		};
+
+		FIO&		fio_;
+		seg_t		seg_[SEG_NUM];
+		idx_t		idx_[KEY_MAX];
+		uint32_t	idx_num_;
+		uint32_t	seq_;
+		uint32_t	active_;
+		uint32_t	gc_seg_;
+		uint32_t	gc_erase_;
+		uint32_t	gc_count_;
+		bool		mount_;
+
+		static uint32_t crc32_(uint32_t crc, const void* src, uint32_t len) noexcept
+		{
+			return utils::crc_engine<utils::crc_def::TYPE::CRC32, 1>::update(crc, src, len);
+		}
+
+		static constexpr uint32_t rec_size_(uint32_t len) noexcept
+		{
+			return 4 + ((len + 3) & ~3) + 4;
+		}
+
+		static constexpr uint32_t base_(uint32_t s) noexcept { return s * SEG_SIZE; }
+
+		// FIO の read は、RX600 系が (org, dst, len)、RX24T/RX62x 系が (org, len, dst)
+		template <class T>
+		static auto read_io_(T& io, uint32_t org, void* dst, uint32_t len, int) noexcept
+			-> decltype(io.read(org, dst, len), void())
+		{
+			io.read(org, dst, len);
+		}
+
+		template <class T>
+		static void read_io_(T& io, uint32_t org, void* dst, uint32_t len, long) noexcept
+		{
+			io.read(org, len, dst);
+		}
+
+		void read_(uint32_t org, void* dst, uint32_t len) noexcept { read_io_(fio_, org, dst, len, 0); }
+
+		bool blank_(uint32_t adr) noexcept { return fio_.erase_check_w(adr); }
+
+		uint32_t read32_(uint32_t adr) noexcept
+		{
+			uint32_t v = 0;
+			read_(adr, &v, 4);
+			return v;
+		}
+
+		bool write32_(uint32_t adr, uint32_t v) noexcept { return fio_.write(adr, &v, 4); }
+
+		uint32_t count_(STATE st) const noexcept
+		{
+			uint32_t n = 0;
+			for(uint32_t i = 0; i < SEG_NUM; ++i) {
+				if(seg_[i].state == st) ++n;
+			}
+			return n;
+		}
+
+		// 索引の二分探索（挿入位置）
+		uint32_t lower_(uint16_t key) const noexcept
+		{
+			uint32_t lo = 0;
+			uint32_t hi = idx_num_;
+			while(lo < hi) {
+				auto mid = (lo + hi) >> 1;
+				if(idx_[mid].key < key) lo = mid + 1;
+				else hi = mid;
+			}
+			return lo;
+		}
+
+		const idx_t* find_(uint16_t key) const noexcept
+		{
+			auto i = lower_(key);
+			if(i < idx_num_ && idx_[i].key == key) return &idx_[i];
+			return nullptr;
+		}
+
+		void remove_index_(uint32_t i) noexcept
+		{
+			seg_[idx_[i].pos / SEG_SIZE].live -= rec_size_(idx_[i].len & ~DEL);
+			--idx_num_;
+			std::memmove(&idx_[i], &idx_[i + 1], (idx_num_ - i) * sizeof(idx_t));
+		}
+
+		bool update_index_(uint16_t key, uint16_t len, uint32_t pos) noexcept
+		{
+			auto i = lower_(key);
+			if(i < idx_num_ && idx_[i].key == key) {
+				seg_[idx_[i].pos / SEG_SIZE].live -= rec_size_(idx_[i].len & ~DEL);
+			} else {
+				if(idx_num_ >= KEY_MAX) return false;
+				std::memmove(&idx_[i + 1], &idx_[i], (idx_num_ - i) * sizeof(idx_t));
+				++idx_num_;
+				idx_[i].key = key;
+			}
+			idx_[i].len = len;
+			idx_[i].pos = pos;
+			seg_[pos / SEG_SIZE].live += rec_size_(len & ~DEL);
+			return true;
+		}
+
+		// レコードの検査
+		bool check_(uint32_t adr, uint32_t pos, uint32_t h) noexcept
+		{
+			uint16_t key = h & 0xffff;
+			uint32_t n = (h >> 16) & ~DEL;
+			auto sz = rec_size_(n);
+			if(key == KEY_NONE || (pos + sz) > SEG_SIZE || blank_(adr + sz - 4)) return false;
+			auto crc = crc32_(~0, &h, 4);
+			uint8_t tmp[CHUNK];
+			for(uint32_t i = 0; i < n; i += CHUNK) {
+				auto l = (n - i) < CHUNK ? (n - i) : CHUNK;
+				read_(adr + 4 + i, tmp, l);
+				crc = crc32_(crc, tmp, l);
+			}
+			return ~crc == read32_(adr + sz - 4);
+		}
+
+		// セグメント内のレコードを走査して索引を作る（mount）
+		bool scan_seg_(uint32_t s) noexcept
+		{
+			auto& sg = seg_[s];
+			bool ok = true;
+			uint32_t pos = HEAD_SIZE;
+			while((pos + 4) <= SEG_SIZE) {
+				auto adr = base_(s) + pos;
+				if(blank_(adr)) {
+					sg.wp = pos;
+					sg.tail = pos;
+					return ok;
+				}
+				auto h = read32_(adr);
+				if(h == PAD) {
+					pos += 4;
+					continue;
+				}
+				if(check_(adr, pos, h)) {
+					if(!update_index_(h & 0xffff, h >> 16, adr)) ok = false;
+					pos += rec_size_((h >> 16) & ~DEL);
+					continue;
+				}
+				// 途切れたレコード、PAD を探す
+				pos += 4;
+				while((pos + 4) <= SEG_SIZE) {
+					adr = base_(s) + pos;
+					if(!blank_(adr) && read32_(adr) == PAD) break;
+					pos += 4;
+				}
+				if((pos + 4) <= SEG_SIZE) {
+					pos += 4;
+					continue;
+				}
+				// PAD が無い場合、書き込まれた最後のワードを探す
+				pos = SEG_SIZE;
+				while(pos > HEAD_SIZE && blank_(base_(s) + pos - 4)) {
+					pos -= 4;
+				}
+				sg.wp = SEG_SIZE;
+				sg.tail = pos;
+				return ok;
+			}
+			sg.wp = SEG_SIZE;
+			sg.tail = SEG_SIZE;
+			return ok;
+		}
+
+
+		// 空きセグメント（消去回数が最小）を、追記用にする
+		bool open_seg_() noexcept
+		{
+			uint32_t s = NONE;
+			for(uint32_t i = 0; i < SEG_NUM; ++i) {
+				if(seg_[i].state != STATE::FREE) continue;
+				if(s == NONE || seg_[i].erase < seg_[s].erase) s = i;
+			}
+			if(s == NONE) return false;
+
+			if(active_ != NONE) {
+				seg_[active_].state = STATE::FULL;
+				active_ = NONE;
+			}
+			auto& sg = seg_[s];
+			if(!write32_(base_(s) + 8, seq_ + 1) || !write32_(base_(s) + 12, ~(seq_ + 1))) {
+				sg.state = STATE::DIRTY;
+				return false;
+			}
+			++seq_;
+			sg.seq = seq_;
+			sg.wp = HEAD_SIZE;
+			sg.tail = HEAD_SIZE;
+			sg.live = 0;
+			sg.state = STATE::ACTIVE;
+			active_ = s;
+			return true;
+		}
+
+		// 追記領域の確保（for_gc が「false」の場合、空きを一つ残す）
+		bool reserve_(uint32_t need, bool for_gc) noexcept
+		{
+			while(1) {
+				if(active_ != NONE && (seg_[active_].wp + need) <= SEG_SIZE) return true;
+				if(count_(STATE::FREE) > (for_gc ? 0 : 1)) {
+					if(!open_seg_()) return false;
+					continue;
+				}
+				if(for_gc) return false;
+				if(!gc_step_(true)) return false;
+			}
+		}
+
+		// レコードの追記（src が nullptr の場合、フラッシュの org からコピー）
+		bool append_(uint16_t key, uint16_t len, const void* src, uint32_t org, bool for_gc) noexcept
+		{
+			uint32_t n = len & ~DEL;
+			auto sz = rec_size_(n);
+			if(!reserve_(sz, for_gc)) return false;
+
+			auto& sg = seg_[active_];
+			auto adr = base_(active_) + sg.wp;
+			uint32_t h = key | (static_cast<uint32_t>(len) << 16);
+			auto crc = crc32_(~0, &h, 4);
+			bool ok = write32_(adr, h);
+			uint8_t tmp[CHUNK];
+			for(uint32_t i = 0; ok && i < n; i += CHUNK) {
+				auto l = (n - i) < CHUNK ? (n - i) : CHUNK;
+				if(src != nullptr) {
+					std::memcpy(tmp, static_cast<const uint8_t*>(src) + i, l);
+				} else {
+					read_(org + i, tmp, l);
+				}
+				crc = crc32_(crc, tmp, l);
+				auto al = (l + 3) & ~3;
+				std::memset(tmp + l, 0xff, al - l);
+				ok = fio_.write(adr + 4 + i, tmp, al);
+			}
+			if(ok) ok = write32_(adr + sz - 4, ~crc);  // コミット
+			if(!ok) {  // 書き込みエラー、このセグメントには追記しない
+				sg.wp = SEG_SIZE;
+				sg.tail = SEG_SIZE;
+				return false;
+			}
+			sg.wp += sz;
+			sg.tail = sg.wp;
+			return update_index_(key, len, adr);
+		}
+
+		// 一番古いデータを持つセグメントか？
+		bool oldest_(uint32_t s) const noexcept
+		{
+			for(uint32_t i = 0; i < SEG_NUM; ++i) {
+				if(i == s) continue;
+				if((seg_[i].state == STATE::FULL || seg_[i].state == STATE::ACTIVE) && seg_[i].seq < seg_[s].seq) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// GC 対象の選択（有効なレコードを移せる空きがある物）
+		uint32_t select_victim_(bool for_space) const noexcept
+		{
+			uint32_t room = 0;
+			if(active_ != NONE) room = SEG_SIZE - seg_[active_].wp;
+			bool free = count_(STATE::FREE) > 0;
+			uint32_t s = NONE;
+			uint32_t cold = NONE;
+			uint32_t emax = 0;
+			for(uint32_t i = 0; i < SEG_NUM; ++i) {
+				const auto& sg = seg_[i];
+				if(sg.erase > emax) emax = sg.erase;
+				if(sg.state != STATE::FULL || (!free && sg.live > room)) continue;
+				if((sg.live + HEAD_SIZE) < SEG_SIZE && (s == NONE || sg.live < seg_[s].live)) s = i;
+				if(cold == NONE || sg.erase < seg_[cold].erase) cold = i;
+			}
+			if(!for_space && cold != NONE && (emax - seg_[cold].erase) > WEAR_DELTA) {
+				return cold;
+			}
+			return s;
+		}
+
+		// GC を一段階進める
+		bool gc_step_(bool for_space) noexcept
+		{
+			if(gc_seg_ == NONE) {
+				// 消去が必要なセグメントを優先
+				for(uint32_t i = 0; i < SEG_NUM; ++i) {
+					if(seg_[i].state == STATE::DIRTY) {
+						gc_seg_ = i;
+						gc_erase_ = 0;
+						return true;
+					}
+				}
+				auto s = select_victim_(for_space);
+				if(s == NONE) return false;
+				gc_seg_ = s;
+				gc_erase_ = 0;
+				return true;
+			}
+
+			auto& sg = seg_[gc_seg_];
+			if(sg.state == STATE::FULL) {  // 有効なレコードを一つコピー
+				auto org = base_(gc_seg_);
+				for(uint32_t i = 0; i < idx_num_; ++i) {
+					const auto& t = idx_[i];
+					if(t.pos < org || t.pos >= (org + SEG_SIZE)) continue;
+					if((t.len & DEL) != 0 && oldest_(gc_seg_)) {  // これより古いレコードが無い削除
+						remove_index_(i);
+						return true;
+					}
+					if(!append_(t.key, t.len, nullptr, t.pos + 4, true)) {
+						gc_seg_ = NONE;
+						return false;
+					}
+					return true;
+				}
+				sg.state = STATE::DIRTY;
+				sg.seq = 0;
+				return true;
+			}
+
+			static constexpr uint32_t ERASE_NUM = SEG_SIZE / FIO::DATA_ERASE_SIZE;
+			if(gc_erase_ < ERASE_NUM) {  // ヘッダーを含む消去単位から消す
+				if(!fio_.erase(gc_seg_ * ERASE_NUM + gc_erase_)) {
+					gc_seg_ = NONE;
+					return false;
+				}
+				++gc_erase_;
+				return true;
+			}
+
+			++sg.erase;
+			if(!write32_(base_(gc_seg_) + 0, sg.erase) || !write32_(base_(gc_seg_) + 4, MAGIC)) {
+				gc_seg_ = NONE;
+				return false;
+			}
+			sg.wp = HEAD_SIZE;
+			sg.tail = HEAD_SIZE;
+			sg.live = 0;
+			sg.state = STATE::FREE;
+			gc_seg_ = NONE;
+			++gc_count_;
+			return true;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクタ
+			@param[in]	fio	フラッシュ I/O
+		*/
+		//-----------------------------------------------------------------//
+		flash_kv(FIO& fio) noexcept : fio_(fio), seg_{ }, idx_{ }, idx_num_(0), seq_(0),
+			active_(NONE), gc_seg_(NONE), gc_erase_(0), gc_count_(0), mount_(false)
+		{ }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  FIO の参照
+			@return FIO
+		*/
+		//-----------------------------------------------------------------//
+		FIO& at_fio() noexcept { return fio_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  マウント（全セグメントを走査して、索引を作る） @n
+					フォーマットされていないセグメントは、GC で消去する。
+			@return 索引に入り切らないキーがあった場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool mount() noexcept
+		{
+			idx_num_ = 0;
+			seq_ = 0;
+			active_ = NONE;
+			gc_seg_ = NONE;
+			uint32_t emax = 0;
+			for(uint32_t s = 0; s < SEG_NUM; ++s) {
+				auto& sg = seg_[s];
+				auto adr = base_(s);
+				sg.seq = 0;
+				sg.erase = 0;
+				sg.wp = HEAD_SIZE;
+				sg.tail = HEAD_SIZE;
+				sg.live = 0;
+				sg.state = STATE::DIRTY;
+				if(blank_(adr) || blank_(adr + 4)) continue;
+				uint32_t h[4];
+				read_(adr, h, sizeof(h));
+				if(h[1] != MAGIC) continue;
+				sg.erase = h[0];
+				if(sg.erase > emax) emax = sg.erase;
+				bool b2 = blank_(adr + 8);
+				bool b3 = blank_(adr + 12);
+				if(b2 && b3) {
+					sg.state = STATE::FREE;
+				} else if(!b2 && !b3 && h[2] == ~h[3]) {
+					sg.seq = h[2];
+					sg.state = STATE::FULL;
+				}  // 使用開始の途中で電源断、レコードは無い
+			}
+			for(uint32_t s = 0; s < SEG_NUM; ++s) {
+				auto& sg = seg_[s];
+				if(sg.state == STATE::DIRTY && sg.erase == 0) sg.erase = emax;  // 消去回数は不明
+			}
+
+			// 古いセグメントから順に走査（新しいレコードで上書き）
+			bool ok = true;
+			uint32_t last = 0;
+			bool first = true;
+			while(1) {
+				uint32_t s = NONE;
+				for(uint32_t i = 0; i < SEG_NUM; ++i) {
+					const auto& sg = seg_[i];
+					if(sg.state != STATE::FULL) continue;
+					if(!first && sg.seq <= last) continue;
+					if(s == NONE || sg.seq < seg_[s].seq) s = i;
+				}
+				if(s == NONE) break;
+				first = false;
+				last = seg_[s].seq;
+				if(!scan_seg_(s)) ok = false;
+				seq_ = seg_[s].seq;
+				active_ = s;
+			}
+			if(active_ != NONE) {
+				auto& sg = seg_[active_];
+				if(sg.wp == SEG_SIZE && (sg.tail + 8 + 8) <= SEG_SIZE) {
+					// 途切れたレコードの後ろ（不完全なワードを一つ空ける）から続ける
+					if(write32_(base_(active_) + sg.tail + 4, PAD)) {
+						sg.wp = sg.tail + 8;
+						sg.tail = sg.wp;
+					}
+				}
+				if(sg.wp < SEG_SIZE) {
+					sg.state = STATE::ACTIVE;
+				} else {
+					active_ = NONE;
+				}
+			}
+			mount_ = true;
+			return ok;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  フォーマット（全セグメントを消去、消去回数は引き継ぐ）
+			@return エラーなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool format() noexcept
+		{
+			if(!mount_) mount();
+			for(uint32_t s = 0; s < SEG_NUM; ++s) {
+				seg_[s].state = STATE::DIRTY;
+			}
+			idx_num_ = 0;
+			active_ = NONE;
+			gc_seg_ = NONE;
+			while(count_(STATE::DIRTY) > 0) {
+				if(!gc_step_(true)) return false;
+			}
+			seq_ = 0;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  サービス（メインループから呼ぶ） @n
+					空きセグメントが少ない場合、GC を一段階進める。
+			@return GC を行った場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool service() noexcept
+		{
+			if(!mount_) return false;
+			if(gc_seg_ == NONE && count_(STATE::FREE) > 2 && count_(STATE::DIRTY) == 0) {
+				auto s = select_victim_(false);
+				if(s == NONE || (seg_[s].live + HEAD_SIZE) < SEG_SIZE) return false;  // ウェアレベリングのみ
+			}
+			return gc_step_(false);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  キーがあるか？
+			@param[in]	key	キー
+			@return ある場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool probe(uint16_t key) const noexcept
+		{
+			auto t = find_(key);
+			return t != nullptr && (t->len & DEL) == 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  値のサイズを取得
+			@param[in]	key	キー
+			@return サイズ（無い場合０）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_size(uint16_t key) const noexcept
+		{
+			auto t = find_(key);
+			if(t == nullptr || (t->len & DEL) != 0) return 0;
+			return t->len;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  書き込み（同じ内容の場合は書き込まない）
+			@param[in]	key		キー
+			@param[in]	src		ソース
+			@param[in]	size	サイズ（バイト、VALUE_MAX まで）
+			@return エラーなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool write(uint16_t key, const void* src, uint32_t size) noexcept
+		{
+			if(!mount_ || key == KEY_NONE || size > VALUE_MAX || (src == nullptr && size > 0)) return false;
+
+			auto t = find_(key);
+			if(t != nullptr && t->len == size) {
+				uint8_t tmp[CHUNK] = { };
+				uint32_t i = 0;
+				while(i < size) {
+					auto l = (size - i) < CHUNK ? (size - i) : CHUNK;
+					read_(t->pos + 4 + i, tmp, l);
+					if(std::memcmp(tmp, static_cast<const uint8_t*>(src) + i, l) != 0) break;
+					i += l;
+				}
+				if(i >= size) return true;
+			} else if(t == nullptr && idx_num_ >= KEY_MAX) {
+				return false;
+			}
+			return append_(key, size, src, 0, false);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  読み込み
+			@param[in]	key		キー
+			@param[out]	dst		転送先
+			@param[in]	size	転送先のサイズ（バイト）
+			@return 読み込んだサイズ（無い場合０）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t read(uint16_t key, void* dst, uint32_t size) noexcept
+		{
+			auto t = find_(key);
+			if(t == nullptr || (t->len & DEL) != 0 || dst == nullptr) return 0;
+			auto n = size < t->len ? size : t->len;
+			read_(t->pos + 4, dst, n);
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  削除
+			@param[in]	key		キー
+			@return キーが無い場合、エラーの場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool remove(uint16_t key) noexcept
+		{
+			if(!probe(key)) return false;
+			return append_(key, DEL, nullptr, 0, false);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  キーの列挙
+			@param[in]	idx		番号（０～）
+			@param[out]	key		キー
+			@return 番号が範囲外なら「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool get_key(uint32_t idx, uint16_t& key) const noexcept
+		{
+			for(uint32_t i = 0; i < idx_num_; ++i) {
+				if((idx_[i].len & DEL) != 0) continue;
+				if(idx == 0) {
+					key = idx_[i].key;
+					return true;
+				}
+				--idx;
+			}
+			return false;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  空き容量の取得（GC で回収できる領域を含む）
+			@return 空き容量（バイト）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_free() const noexcept
+		{
+			uint32_t live = 0;
+			for(uint32_t i = 0; i < SEG_NUM; ++i) {
+				live += seg_[i].live;
+			}
+			// GC 用に、１セグメントを残す
+			uint32_t cap = (SEG_NUM - 1) * (SEG_SIZE - HEAD_SIZE);
+			return cap > live ? cap - live : 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  状態情報の取得
+			@return 状態情報
+		*/
+		//-----------------------------------------------------------------//
+		info_t get_info() const noexcept
+		{
+			info_t t { };
+			t.seg_free = count_(STATE::FREE);
+			t.seg_dirty = count_(STATE::DIRTY);
+			t.erase_min = 0xffff'ffff;
+			for(uint32_t i = 0; i < SEG_NUM; ++i) {
+				t.live += seg_[i].live;
+				if(seg_[i].erase < t.erase_min) t.erase_min = seg_[i].erase;
+				if(seg_[i].erase > t.erase_max) t.erase_max = seg_[i].erase;
+			}
+			for(uint32_t i = 0; i < idx_num_; ++i) {
+				if((idx_[i].len & DEL) == 0) ++t.keys;
+			}
+			t.gc_count = gc_count_;
+			return t;
+		}
+	};
+}
@@ -47,8 +47,14 @@
 			+ 2025/01/02 13:17- (v121) cleanup
 			+ 2025/03/27 12:19- (V122) %-0xxxd の場合の不具合修正
 			+ 2025/03/28 16:19- (V123) 二進表示の場合にバッファを利用しない
+			+ 2026/10/19 10:00- (V124) コンパイル時にフォーマットを解析する out 関数を追加 @n
+			  出力ファンクタに、文字列（ポインター、長さ）出力を追加
+			Ex: コンパイル時フォーマット（型、引数の数をコンパイル時に検査） @n
+			  utils::format::out(UTILS_FORM("%d: %s\n"), idx, name); @n
+			  ※ d,i,u,x,X,c,s 以外の変換は、実行時フォーマットで処理する。 @n
+			  ※ sformat では、utils::sformat::chaout().set(buff, size) で出力先を設定する。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2013, 2025 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2013, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -58,6 +64,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <utility>
 
 // 最終的な出力として putchar を使う場合有効にする（通常は write [stdout] 関数）
 // #define USE_PUTCHAR
@@ -71,6 +78,9 @@
 // ８進表示をサポートしない場合（メモリの節約）
 // #define NO_OCTAL_FORM
 
+// コンパイル時フォーマット用、フォーマット文字列を型にする
+#define UTILS_FORM(s) ([]() noexcept { struct form_ { static constexpr const char* str() noexcept { return s; } }; return form_(); }())
+
 /* 
   e, E
      double 引き数を丸めて [-]d.ddde±dd の形に変換する。 小数点の前には一桁の数字があり、
@@ -113,6 +123,8 @@ namespace utils {
 
 		void operator() (char ch) noexcept { }
 
+		void operator() (const char* s, uint l) noexcept { }
+
 		void clear() noexcept { };
 
 		uint size() const noexcept { return 0; }
@@ -144,6 +156,10 @@ namespace utils {
 			++size_;
 		}
 
+		void operator() (const char* s, uint l) noexcept {
+			size_ += l;
+		}
+
 		void clear() noexcept { size_ = 0; };
 
 		uint size() const noexcept { return size_; }
@@ -181,6 +197,18 @@ namespace utils {
 			++size_;
 		}
 
+		void operator() (const char* s, uint l) noexcept
+		{
+#ifdef USE_PUTCHAR
+			for(uint i = 0; i < l; ++i) {
+				putchar(s[i]);
+			}
+#else
+			write(STDOUT_FILENO, s, l);
+#endif
+			size_ += l;
+		}
+
 		void clear() noexcept { size_ = 0; };
 
 		uint size() const noexcept { return size_; }
@@ -220,6 +248,26 @@ namespace utils {
 			++size_;
 		}
 
+		void operator() (const char* s, uint l) noexcept {
+			size_ += l;
+			bool nl = false;
+			while(l > 0) {
+				uint n = BFN - pos_;
+				if(n > l) n = l;
+				std::memcpy(&buff_[pos_], s, n);
+				if(std::memchr(s, '\n', n) != nullptr) nl = true;
+				pos_ += n;
+				s += n;
+				l -= n;
+				if(pos_ >= BFN) {
+					flush();
+				}
+			}
+			if(nl) {
+				flush();
+			}
+		}
+
 		void clear() noexcept { size_ = 0; };
 
 		auto size() const noexcept { return size_; }
@@ -330,6 +378,20 @@ namespace utils {
 				str_.clear();
 			}			
 		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ファンクタ用オペレータ（文字列）
+			@param[in]	s	出力文字列
+			@param[in]	l	長さ
+		*/
+		//-----------------------------------------------------------------//
+		void operator () (const char* s, unsigned int l) noexcept {
+			for(unsigned int i = 0; i < l; ++i) {
+				operator () (s[i]);
+			}
+		}
 	};
 
 
@@ -388,6 +450,22 @@ namespace utils {
 			}
 		}
 
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ファンクタ用オペレータ（文字列）
+			@param[in]	s	出力文字列
+			@param[in]	l	長さ
+		*/
+		//-----------------------------------------------------------------//
+		void operator () (const char* s, uint l) noexcept {
+			if(pos_ >= limit_) return;
+			if(l > (limit_ - pos_)) l = limit_ - pos_;
+			std::memcpy(&dst_[pos_], s, l);
+			pos_ += l;
+			dst_[pos_] = 0;
+		}
+
 		void clear() noexcept { pos_ = 0; }
 
 		auto size() const noexcept { return pos_; }
@@ -401,7 +479,7 @@ namespace utils {
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	struct base_format {
 
-		static constexpr uint16_t VERSION = 123;		///< バージョン番号（整数）
+		static constexpr uint16_t VERSION = 124;		///< バージョン番号（整数）
 
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
@@ -420,6 +498,219 @@ namespace utils {
 	};
 
 
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief	コンパイル時フォーマット解析クラス @n
+				フォーマット文字列（UTILS_FORM で型にしたもの）を、コンパイル時に @n
+				「リテラル区間」と「変換指定」の表に分解する。
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct cform_base {
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  変換指定
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct spec_t {
+			uint16_t	lit_ofs;	///< 前置リテラルの位置
+			uint16_t	lit_len;	///< 前置リテラルの長さ
+			uint16_t	ofs;		///< 変換指定の位置（'%'）
+			uint16_t	len;		///< 変換指定の長さ
+			char		conv;		///< 変換文字（０なら末尾のリテラルのみ）
+			uint16_t	width;		///< 幅
+			bool		zero;		///< ０サプレス
+			bool		left;		///< 左詰め
+			bool		plus;		///< 符号表示
+		};
+
+		static constexpr uint16_t SPEC_LEN_MAX = 31;	///< 変換指定の最大長
+
+		static constexpr bool is_conv_(char ch) noexcept
+		{
+			switch(ch) {
+			case 's': case 'c': case 'd': case 'i': case 'u': case 'x': case 'X':
+			case 'y': case 'p': case '%':
+#ifndef NO_BIN_FORM
+			case 'b':
+#endif
+#ifndef NO_OCTAL_FORM
+			case 'o':
+#endif
+#ifndef NO_FLOAT_FORM
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+#endif
+				return true;
+			default:
+				return false;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  高速変換（実行時フォーマットを使わない）が可能か
+			@param[in]	conv	変換文字
+			@return 可能なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		static constexpr bool is_fast(char conv) noexcept
+		{
+			switch(conv) {
+			case 'd': case 'i': case 'u': case 'x': case 'X': case 'c': case 's':
+				return true;
+			default:
+				return false;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  引数の型と変換文字の整合を検査
+			@param[in]	conv	変換文字
+			@return 整合するなら「true」
+		*/
+		//-----------------------------------------------------------------//
+		template <typename T>
+		static constexpr bool match(char conv) noexcept
+		{
+			typedef typename std::decay<T>::type D;
+			switch(conv) {
+			case 'c': case 'b': case 'o': case 'd': case 'i': case 'u': case 'x': case 'X': case 'y':
+				return std::is_integral<D>::value && !std::is_same<D, bool>::value;
+			case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+				return std::is_floating_point<D>::value;
+			case 's':
+				return std::is_same<D, const char*>::value || std::is_same<D, char*>::value
+					|| std::is_same<D, std::string>::value;
+			case 'p':
+				return std::is_pointer<D>::value;
+			default:
+				return false;
+			}
+		}
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  フォーマット情報
+			@param[in]	FS	フォーマット文字列型（UTILS_FORM）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		template <class FS>
+		struct info {
+
+			// 変換指定の数（'%%' を含む）、不正な場合は -1
+			static constexpr int32_t count_() noexcept
+			{
+				const char* s = FS::str();
+				int32_t n = 0;
+				uint32_t i = 0;
+				while(s[i] != 0) {
+					if(s[i] == '%') {
+						auto top = i;
+						++i;
+						while(s[i] != 0 && !is_conv_(s[i])) {
+							auto ch = s[i];
+							if(!(ch == '+' || ch == '-' || ch == '.' || ch == ':' || (ch >= '0' && ch <= '9'))) {
+								return -1;
+							}
+							++i;
+						}
+						if(s[i] == 0 || (i - top) >= SPEC_LEN_MAX || i > 0xffff) return -1;
+						++n;
+					}
+					++i;
+				}
+				return n;
+			}
+
+			static constexpr int32_t SPEC_NUM = count_();
+			static constexpr bool valid = SPEC_NUM >= 0;
+			static constexpr uint32_t NUM = valid ? (SPEC_NUM + 1) : 1;
+
+			struct table_t {
+				spec_t		spec[NUM];
+				char		arg_conv[NUM];	// 引数を取る変換指定の変換文字
+				uint32_t	args;			// 引数の数
+			};
+
+			static constexpr table_t build_() noexcept
+			{
+				table_t t { };
+				if(!valid) return t;
+				const char* s = FS::str();
+				uint32_t i = 0;
+				uint32_t lit = 0;
+				uint32_t n = 0;
+				while(s[i] != 0) {
+					if(s[i] != '%') {
+						++i;
+						continue;
+					}
+					auto& sp = t.spec[n];
+					sp.lit_ofs = lit;
+					sp.lit_len = i - lit;
+					sp.ofs = i;
+					++i;
+					bool point = false;
+					while(!is_conv_(s[i])) {
+						auto ch = s[i];
+						if(ch == '+') sp.plus = true;
+						else if(ch == '-') sp.left = true;
+						else if(ch == '.' || ch == ':') point = true;
+						else if(!point) {
+							if(sp.width == 0 && ch == '0') sp.zero = true;
+							sp.width = sp.width * 10 + (ch - '0');
+						}
+						++i;
+					}
+					sp.conv = s[i];
+					++i;
+					sp.len = i - sp.ofs;
+					if(sp.conv != '%') {
+						t.arg_conv[t.args] = sp.conv;
+						++t.args;
+					}
+					lit = i;
+					++n;
+				}
+				t.spec[n].lit_ofs = lit;
+				t.spec[n].lit_len = i - lit;
+				t.spec[n].conv = 0;
+				return t;
+			}
+
+			static constexpr table_t table = build_();
+			static constexpr uint32_t ARGS = table.args;	///< 引数の数
+
+			template <typename... Args, size_t... I>
+			static constexpr bool check_(std::index_sequence<I...>) noexcept
+			{
+				return (true && ... && match<Args>(table.arg_conv[I]));
+			}
+
+
+			//-------------------------------------------------------------//
+			/*!
+				@brief  引数の型を検査
+				@return 全て整合するなら「true」
+			*/
+			//-------------------------------------------------------------//
+			template <typename... Args>
+			static constexpr bool check() noexcept
+			{
+				if constexpr (sizeof...(Args) != ARGS) {
+					return false;
+				} else {
+					return check_<Args...>(std::index_sequence_for<Args...>());
+				}
+			}
+		};
+	};
+
+
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  簡易 format クラス
@@ -471,9 +762,34 @@ namespace utils {
 		bool		auto_mode_;
 		bool		exp_mode_;
 
+		// 文字列出力を持つ出力ファンクタか
+		template <class T, class = void>
+		struct has_span_ : std::false_type { };
+		template <class T>
+		struct has_span_<T, std::void_t<decltype(std::declval<T&>()(static_cast<const char*>(nullptr), 0u))>> :
+			std::true_type { };
+
+		static void out_(const char* str, uint32_t len) noexcept {
+			if constexpr (has_span_<CHAOUT>::value) {
+				if(len > 0) chaout_(str, len);
+			} else {
+				for(uint32_t i = 0; i < len; ++i) chaout_(str[i]);
+			}
+		}
+
+		static void fill_(char ch, uint32_t len) noexcept {
+			char tmp[16];
+			std::memset(tmp, ch, sizeof(tmp));
+			while(len > 0) {
+				auto l = len;
+				if(l > sizeof(tmp)) l = sizeof(tmp);
+				out_(tmp, l);
+				len -= l;
+			}
+		}
+
 		void str_(const char* str) noexcept {
-			char ch;
-			while((ch = *str++) != 0) chaout_(ch);
+			out_(str, std::strlen(str));
 		}
 
 		void reset_() noexcept {
@@ -1358,6 +1674,159 @@ namespace utils {
 			next_();
 			return *this;
 		}
+
+	private:
+		// out_str_、zero_spc_ と同じ配置
+		static void cpad_(const cform_base::spec_t& sp, char sign, const char* str, uint32_t n) noexcept
+		{
+			if(sp.left) {
+				if(sign != 0) { chaout_(sign); }
+				out_(str, n);
+			}
+			uint32_t num = sp.width;
+			if(sign != 0 && num > 0) { num--; }
+			if(n > 0 && n < num) {
+				auto cnt = num - n;
+				if(!sp.left && sp.zero) {
+					if(sign != 0) { chaout_(sign); }
+					fill_('0', cnt);
+				} else {
+					fill_(' ', cnt);
+					if(!sp.left && sign != 0) { chaout_(sign); }
+				}
+			} else {
+				if(!sp.left && sign != 0) { chaout_(sign); }
+			}
+			if(!sp.left) { out_(str, n); }
+		}
+
+		template <typename T>
+		static error cint_(const cform_base::spec_t& sp, T val) noexcept
+		{
+			typedef typename std::make_signed<T>::type S;
+			typedef typename std::make_unsigned<T>::type U;
+			if(sp.conv == 'c') {
+				auto chn = static_cast<int32_t>(val);
+				if(chn > -128 && chn < 128) {
+					chaout_(chn);
+					return error::none;
+				}
+				return error::over;
+			}
+			char buff[22];
+			char* end = &buff[sizeof(buff)];
+			char* p = end;
+			char sign = 0;
+			U u = static_cast<U>(val);
+			if(sp.conv == 'x' || sp.conv == 'X') {
+				char top = sp.conv == 'X' ? 'A' : 'a';
+				do {
+					char ch = u & 15;
+					*--p = ch >= 10 ? (ch - 10 + top) : (ch + '0');
+					u >>= 4;
+				} while(u != 0) ;
+			} else {
+				if(sp.conv != 'u' && static_cast<S>(val) < 0) {
+					u = static_cast<U>(0) - u;
+					sign = '-';
+				} else if(sp.plus) {
+					sign = '+';
+				}
+				do {
+					*--p = (u % 10) + '0';
+					u /= 10;
+				} while(u != 0) ;
+			}
+			cpad_(sp, sign, p, end - p);
+			return error::none;
+		}
+
+		static error cstr_(const cform_base::spec_t& sp, const char* str) noexcept
+		{
+			if(str == nullptr) {
+				static constexpr char nullstr[] = "(nullptr)";
+				cpad_(sp, 0, nullstr, sizeof(nullstr) - 1);
+				return error::null;
+			}
+			cpad_(sp, 0, str, std::strlen(str));
+			return error::none;
+		}
+
+		template <typename T>
+		static error cconv_(const char* form, const cform_base::spec_t& sp, const T& val) noexcept
+		{
+			if constexpr (std::is_integral<T>::value) {
+				if(cform_base::is_fast(sp.conv)) {
+					return cint_(sp, val);
+				}
+			} else if constexpr (std::is_same<T, std::string>::value) {
+				return cstr_(sp, val.c_str());
+			} else if constexpr (std::is_same<typename std::decay<T>::type, const char*>::value
+					|| std::is_same<typename std::decay<T>::type, char*>::value) {
+				if(sp.conv == 's') {
+					return cstr_(sp, val);
+				}
+			}
+			// 実行時フォーマットで変換（変換指定のみを渡す）
+			char tmp[cform_base::SPEC_LEN_MAX + 1];
+			std::memcpy(tmp, form + sp.ofs, sp.len);
+			tmp[sp.len] = 0;
+			basic_format f(tmp);
+			f % val;
+			return f.get_error();
+		}
+
+		// '%%' を含めたリテラルを出力して、次の変換指定を返す
+		template <class INFO>
+		static const cform_base::spec_t& clit_(const char* form, uint32_t& pos) noexcept
+		{
+			while(1) {
+				const auto& sp = INFO::table.spec[pos];
+				out_(form + sp.lit_ofs, sp.lit_len);
+				if(sp.conv != '%') {
+					return sp;
+				}
+				chaout_('%');
+				++pos;
+			}
+		}
+
+		template <class INFO, typename T>
+		static void carg_(const char* form, uint32_t& pos, error& err, const T& val) noexcept
+		{
+			const auto& sp = clit_<INFO>(form, pos);
+			auto e = cconv_(form, sp, val);
+			if(err == error::none) err = e;
+			++pos;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンパイル時フォーマット出力 @n
+					フォーマットはコンパイル時に、リテラル区間と変換指定に分解され、 @n
+					引数の数、型もコンパイル時に検査される。 @n
+					リテラル区間、変換した数値は、文字列として出力ファンクタに渡す。
+			@param[in]	fs		フォーマット文字列（UTILS_FORM("...")）
+			@param[in]	args	引数
+			@return エラー種別
+		*/
+		//-----------------------------------------------------------------//
+		template <class FS, typename... Args>
+		static error out(FS fs, const Args&... args) noexcept
+		{
+			typedef cform_base::info<FS> INFO;
+			static_assert(INFO::valid, "format: illegal conversion specifier");
+			static_assert(INFO::ARGS == sizeof...(Args), "format: argument count mismatch");
+			static_assert(INFO::template check<Args...>(), "format: argument type mismatch");
+
+			const char* form = FS::str();
+			uint32_t pos = 0;
+			error err = error::none;
+			(carg_<INFO>(form, pos, err, args), ...);
+			clit_<INFO>(form, pos);
+			return err;
+		}
 	};
 
 	template <class CHAOUT> CHAOUT basic_format<CHAOUT>::chaout_;
@@ -0,0 +1,496 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	割り込みプロファイラー（ISR の処理時間、割り込み遅延） @n
+			・ISR_PROFILE を定義した時だけ有効（vect.c のフックも同じ）。 @n
+			  定義しない場合、全ての関数は何もしない（コードも出ない）。 @n
+			・start() の後に登録（icu_mgr::set_interrupt など）された割り込み @n
+			  関数を、ベクター毎のスタブに置き換え、入口と出口の時間を、 @n
+			  フリーランの CMT/CMTW（16 ビット、PCLK/8 など）で測る。 @n
+			  ネストした（計測中の）割り込みの時間は、差し引く。 @n
+			・ベクター毎に、回数、合計、最大、ヒストグラム（２のべき乗）を持つ。 @n
+			・カウンターのコンペア・マッチ割り込み（プローブ）を有効にすると、 @n
+			  その割り込みレベルでの割り込み遅延（要求から ISR まで）と、経過 @n
+			  時間（負荷率）も測る。 @n
+			・レポートはシリアル（utils::format）に出す（monitor の "isr" コマンド）。 @n
+			※ 16 ビットなので、一回が 65536 カウントを超える ISR は正しく測れない。 @n
+			※ start() の前に登録済みのベクターは、attach() で追加する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <type_traits>
+#include <utility>
+#include "common/cmt_mgr.hpp"
+#include "common/cmtw_mgr.hpp"
+#include "common/format.hpp"
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  割り込みプロファイラー定義
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct isr_prof_def {
+
+		static constexpr uint32_t HIST_NUM = 16;	///< ヒストグラムの数（i 番目は 2^i カウント未満）
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  ベクター毎の統計（時間はカウント）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct stat_t {
+			uint32_t	vec;			///< ベクター番号
+			uint32_t	count;			///< 回数
+			uint64_t	total;			///< 合計
+			uint32_t	max;			///< 最大
+			uint32_t	hist[HIST_NUM];	///< ヒストグラム
+		};
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レポート関数（start() で設定される、monitor から使う）
+		*/
+		//-----------------------------------------------------------------//
+		static inline void (*report_func)(bool hist, bool clear) = nullptr;
+	};
+
+
+#ifdef ISR_PROFILE
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  割り込みプロファイラー・クラス
+		@param[in]	CNT			フリーランで使うチャネル（CMT 又は CMTW）
+		@param[in]	SLOT_MAX	計測するベクターの最大数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CNT, uint32_t SLOT_MAX = 16>
+	class isr_prof : public isr_prof_def {
+
+		static_assert(SLOT_MAX > 0 && SLOT_MAX <= 64, "SLOT_MAX out of range");
+
+		typedef void (*ITASK)(void);
+
+		// CMTW（CMWCNT を持つ）か？
+		template <class T, class = void>
+		struct is_cmtw_ : std::false_type { };
+		template <class T>
+		struct is_cmtw_<T, std::void_t<decltype(T::CMWCNT)>> : std::true_type { };
+
+		static constexpr bool CMTW = is_cmtw_<CNT>::value;
+		static constexpr uint32_t MASK = 0xffff;
+
+		struct slot_t {
+			ITASK		task;
+			stat_t		st;
+		};
+
+		static inline slot_t	slot_[SLOT_MAX];
+		static inline uint32_t	slot_num_;
+		static inline stat_t	probe_;
+		static inline volatile uint32_t	wraps_;
+		static inline uint32_t	inner_;		// ネストした ISR の時間
+		static inline uint32_t	bias_;		// スタブの呼び出しの時間
+		static inline ICU::LEVEL	level_;
+		static inline uint8_t	cks_;
+		static inline bool		run_;
+
+		static uint32_t count_() noexcept
+		{
+			if constexpr (CMTW) return CNT::CMWCNT() & MASK;
+			else return CNT::CMCNT();
+		}
+
+		static uint32_t bucket_(uint32_t v) noexcept
+		{
+			if(v == 0) return 0;
+			auto b = 32 - static_cast<uint32_t>(__builtin_clz(v));
+			return b < HIST_NUM ? b : (HIST_NUM - 1);
+		}
+
+		static void record_(stat_t& st, uint32_t v) noexcept
+		{
+			++st.count;
+			st.total += v;
+			if(v > st.max) st.max = v;
+			++st.hist[bucket_(v)];
+		}
+
+		// プローブ（カウンターのコンペア・マッチ）、CMCNT がそのまま遅延になる
+		struct probe_t {
+			void operator() () noexcept
+			{
+				auto lat = count_();
+				record_(probe_, lat);
+				wraps_ = wraps_ + 1;
+			}
+		};
+
+		typedef std::conditional_t<CMTW, cmtw_mgr<CNT, probe_t>, cmt_mgr<CNT, probe_t>> MGR;
+		static inline MGR	mgr_;
+
+		static uint32_t lock_() noexcept
+		{
+#ifdef __RX__
+			uint32_t psw;
+			asm volatile ("mvfc psw,%0\n\tclrpsw i" : "=r"(psw) : : "memory");
+			return psw;
+#else
+			return 0;
+#endif
+		}
+
+		static void unlock_(uint32_t psw) noexcept
+		{
+#ifdef __RX__
+			asm volatile ("mvtc %0,psw" : : "r"(psw) : "memory");
+#else
+			(void)psw;
+#endif
+		}
+
+		// 割り込みと同じスタック（PSW、PC）を積んで、割り込み関数を呼ぶ @n
+		// （割り込み関数は RTE で戻るので、普通には呼べない）
+		static void call_(ITASK task) noexcept
+		{
+#ifdef __RX__
+			asm volatile (
+				"mvfc psw, r14\n\t"
+				"push.l r14\n\t"
+				"mov.l #1f, r14\n\t"
+				"push.l r14\n\t"
+				"jmp %0\n"
+				"1:\n\t"
+				: : "r"(task) : "r14", "memory", "cc");
+#else
+			task();
+#endif
+		}
+
+		template <uint32_t I>
+		static INTERRUPT_FUNC void stub_() noexcept
+		{
+			auto t0 = count_();
+			auto inner = inner_;
+			inner_ = 0;
+			call_(slot_[I].task);
+			auto dt = (count_() - t0) & MASK;
+			auto self = dt - inner_;
+			self = self > bias_ ? (self - bias_) : 0;
+			inner_ = inner + dt;
+			record_(slot_[I].st, self);
+		}
+
+		static INTERRUPT_FUNC void null_() noexcept { }
+
+		template <uint32_t... I>
+		static ITASK get_stub_(uint32_t idx, std::integer_sequence<uint32_t, I...>) noexcept
+		{
+			static constexpr ITASK tbl[] = { stub_<I>... };
+			return tbl[idx];
+		}
+
+		static ITASK get_stub_(uint32_t idx) noexcept
+		{
+			return get_stub_(idx, std::make_integer_sequence<uint32_t, SLOT_MAX>{ });
+		}
+
+		static bool find_(uint32_t vec, uint32_t& idx) noexcept
+		{
+			for(uint32_t i = 0; i < slot_num_; ++i) {
+				if(slot_[i].st.vec == vec) {
+					idx = i;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		// set_interrupt_task のフック
+		static ITASK hook_(ITASK task, uint32_t vec) noexcept
+		{
+			uint32_t idx;
+			if(find_(vec, idx)) {
+				if(task == get_stub_(idx)) return task;
+				slot_[idx].task = task;
+				return task != nullptr ? get_stub_(idx) : nullptr;
+			}
+			if(task == nullptr || slot_num_ >= SLOT_MAX) return task;
+
+			idx = slot_num_;
+			slot_[idx].task = task;
+			slot_[idx].st = stat_t { };
+			slot_[idx].st.vec = vec;
+			++slot_num_;
+			return get_stub_(idx);
+		}
+
+		// スタブの呼び出しにかかる時間を測る
+		static void calibrate_() noexcept
+		{
+			uint32_t best = MASK;
+			for(uint32_t i = 0; i < 8; ++i) {
+				auto psw = lock_();
+				auto t0 = count_();
+				call_(null_);
+				auto dt = (count_() - t0) & MASK;
+				unlock_(psw);
+				if(dt < best) best = dt;
+			}
+			bias_ = best;
+		}
+
+		static uint32_t to_ns_(uint64_t cnt) noexcept
+		{
+			return cnt * 1'000'000'000 / get_count_rate();
+		}
+
+		static void list_hist_(const stat_t& st) noexcept
+		{
+			utils::format("     ");
+			for(uint32_t i = 0; i < HIST_NUM; ++i) {
+				if(st.hist[i] == 0) continue;
+				utils::format(" <%uns:%u") % to_ns_(1 << i) % st.hist[i];
+			}
+			utils::format("\n");
+		}
+
+		static void list_stat_(const stat_t& st, uint64_t elapsed, bool hist) noexcept
+		{
+			auto avg = st.count != 0 ? (st.total / st.count) : 0;
+			utils::format("%3u %9u %9u %9u %11u") % st.vec % st.count
+				% to_ns_(avg) % to_ns_(st.max) % static_cast<uint32_t>(st.total * 1'000 / get_count_rate());
+			if(elapsed != 0) {
+				auto per = static_cast<uint32_t>(st.total * 1'000 / elapsed);
+				utils::format(" %3u.%u%%") % (per / 10) % (per % 10);
+			}
+			utils::format("\n");
+			if(hist) list_hist_(st);
+		}
+
+		static void report_(bool hist, bool clear_req) noexcept
+		{
+			list(hist);
+			if(clear_req) clear();
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始（フックを設定する）
+			@param[in]	level	プローブの割り込みレベル（NONE なら遅延を測らない）
+			@param[in]	cks		カウンターの分周（0: 1/8、1: 1/32、2: 1/128、3: 1/512）
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		static bool start(ICU::LEVEL level = ICU::LEVEL::NONE, uint8_t cks = 0) noexcept
+		{
+			if(run_ || cks > 3) return false;
+
+			slot_num_ = 0;
+			probe_ = stat_t { };
+			wraps_ = 0;
+			inner_ = 0;
+			level_ = level;
+			cks_ = cks;
+
+			bool ret;
+			if constexpr (CMTW) {
+				ret = mgr_.start(static_cast<typename MGR::DIRECT>(MASK + 1),
+					static_cast<typename MGR::DIVIDE>(cks), level);
+			} else {
+				ret = mgr_.start(static_cast<typename MGR::DIRECT>(MASK),
+					static_cast<typename MGR::DIVIDE>(cks), level);
+			}
+			if(!ret) return false;
+
+			calibrate_();
+			interrupt_task_hook = hook_;
+			report_func = report_;
+			run_ = true;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  登録済みのベクターを計測に加える
+			@param[in]	vec		ベクター
+			@return 加えられない（スロットが無い、関数が無い）場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		template <typename VEC>
+		static bool attach(VEC vec) noexcept
+		{
+			if(!run_) return false;
+
+			auto v = static_cast<uint32_t>(vec);
+			auto psw = lock_();
+			auto task = interrupt_vectors[v];
+			auto stub = hook_(task, v);
+			bool ret = stub != task;
+			interrupt_vectors[v] = stub;
+			unlock_(psw);
+			return ret;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  停止（ベクターを元の関数に戻す）
+		*/
+		//-----------------------------------------------------------------//
+		static void stop() noexcept
+		{
+			if(!run_) return;
+
+			interrupt_task_hook = nullptr;
+			report_func = nullptr;
+			auto psw = lock_();
+			for(uint32_t i = 0; i < slot_num_; ++i) {
+				auto v = slot_[i].st.vec;
+				if(interrupt_vectors[v] == get_stub_(i) && slot_[i].task != nullptr) {
+					interrupt_vectors[v] = slot_[i].task;
+				}
+			}
+			unlock_(psw);
+			mgr_.destroy();
+			run_ = false;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  統計をクリア
+		*/
+		//-----------------------------------------------------------------//
+		static void clear() noexcept
+		{
+			auto psw = lock_();
+			for(uint32_t i = 0; i < slot_num_; ++i) {
+				auto v = slot_[i].st.vec;
+				slot_[i].st = stat_t { };
+				slot_[i].st.vec = v;
+			}
+			auto v = probe_.vec;
+			probe_ = stat_t { };
+			probe_.vec = v;
+			wraps_ = 0;
+			unlock_(psw);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  カウンターの周波数を取得
+			@return 周波数 [Hz]
+		*/
+		//-----------------------------------------------------------------//
+		static uint32_t get_count_rate() noexcept
+		{
+			return CNT::PCLK / (8 << (cks_ * 2));
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  統計を取得
+			@param[in]	vec		ベクター
+			@param[out]	st		統計
+			@return 計測していないベクターなら「false」
+		*/
+		//-----------------------------------------------------------------//
+		template <typename VEC>
+		static bool get_stat(VEC vec, stat_t& st) noexcept
+		{
+			uint32_t idx;
+			if(!find_(static_cast<uint32_t>(vec), idx)) return false;
+			auto psw = lock_();
+			st = slot_[idx].st;
+			unlock_(psw);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  割り込み遅延（プローブ）の統計を取得
+			@return 統計
+		*/
+		//-----------------------------------------------------------------//
+		static stat_t get_latency() noexcept
+		{
+			auto psw = lock_();
+			auto st = probe_;
+			unlock_(psw);
+			return st;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レポートを表示
+			@param[in]	hist	ヒストグラムも表示する場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		static void list(bool hist = false) noexcept
+		{
+			// 表示中に変わらないように、写しを取る
+			slot_t tmp[SLOT_MAX];
+			auto psw = lock_();
+			auto num = slot_num_;
+			for(uint32_t i = 0; i < num; ++i) tmp[i] = slot_[i];
+			auto lat = probe_;
+			uint64_t elapsed = static_cast<uint64_t>(wraps_) * (MASK + 1);
+			unlock_(psw);
+
+			utils::format("ISR profile: %u Hz counter, stub %u ns, %u vectors")
+				% get_count_rate() % to_ns_(bias_) % num;
+			if(elapsed != 0) {
+				utils::format(", %u ms") % static_cast<uint32_t>(elapsed * 1'000 / get_count_rate());
+			}
+			utils::format("\n");
+			utils::format("vec     count    avg ns    max ns    total us%s\n") % (elapsed != 0 ? "   load" : "");
+			for(uint32_t i = 0; i < num; ++i) {
+				list_stat_(tmp[i].st, elapsed, hist);
+			}
+			if(lat.count != 0) {
+				utils::format("Latency (probe, level %u): %u, avg %u ns, max %u ns\n")
+					% static_cast<uint32_t>(level_)
+					% lat.count % to_ns_(lat.total / lat.count) % to_ns_(lat.max);
+				if(hist) list_hist_(lat);
+			}
+		}
+	};
+#else
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  割り込みプロファイラー・クラス（ISR_PROFILE が無い場合、何もしない）
+		@param[in]	CNT			フリーランで使うチャネル（CMT 又は CMTW）
+		@param[in]	SLOT_MAX	計測するベクターの最大数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CNT, uint32_t SLOT_MAX = 16>
+	class isr_prof : public isr_prof_def {
+	public:
+		static bool start(ICU::LEVEL level = ICU::LEVEL::NONE, uint8_t cks = 0) noexcept { return false; }
+		template <typename VEC>
+		static bool attach(VEC vec) noexcept { return false; }
+		static void stop() noexcept { }
+		static void clear() noexcept { }
+		static uint32_t get_count_rate() noexcept { return 0; }
+		template <typename VEC>
+		static bool get_stat(VEC vec, stat_t& st) noexcept { return false; }
+		static stat_t get_latency() noexcept { return stat_t { }; }
+		static void list(bool hist = false) noexcept
+		{
+			utils::format("ISR profile: disabled (define ISR_PROFILE)\n");
+		}
+	};
+#endif
+}
@@ -2,9 +2,19 @@
 //=====================================================================//
 /*!	@file
 	@brief	ログ・マネージャー・クラス @n
-			・バックアップ可能な、領域を使ったログメモリー
+			・バックアップ可能な、領域を使ったログメモリー @n
+			・PAGE を指定すると、RAM にバッファして、ページ単位でまとめて書き込む @n
+			・ヘッダー（位置、長さ）は、CHECK バイト毎、又は flush で書き込む @n
+			  ヘッダーは２つのスロットに交互に書き、シーケンス番号とチェック・ @n
+			  サムで、書き込み途中の電源断から復帰する。 @n
+			  電源断で失われるのは、最後のチェック・ポイント以降のログだけ。 @n
+			・タイムスタンプ付きのバイナリー・レコードを、テキストと混在できる @n
+			  レコード：SYNC(0xFF), len, ~len, time(4 バイト、LE), data[len] @n
+			MEMIO の要件： @n
+			  SIZE、start()、put8(pos, data)、get8(pos, data)、 @n
+			  copy(src, len, dst)（書き込み）、copy(src, len, dst)（読み出し）
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2017 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2017, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -17,21 +27,107 @@ namespace utils {
     /*!
         @brief  log_man クラス
 		@param[in]	MEMIO	メモリー入出力
+		@param[in]	PAGE	書き込みページ・サイズ（０ならバッファしない）
+		@param[in]	CHECK	ヘッダーを書き込む間隔（バイト）
     */
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <class MEMIO>
+	template <class MEMIO, uint32_t PAGE = 0, uint32_t CHECK = 1>
 	class log_man {
+	public:
+		static constexpr uint8_t SYNC = 0xff;	///< バイナリー・レコードの先頭（テキストには現れない）
+		static constexpr uint32_t RECORD_MAX = 255;	///< バイナリー・レコードの最大長
 
-		static constexpr uint32_t offset_ = 8;
-		static constexpr uint32_t uniq_id_ = 0x1a3c5976;  // 初期化判定ユニークコード
+	private:
+		static constexpr uint32_t uniq_id_ = 0x1a3c5977;  // 初期化判定ユニークコード
 
-		struct area_t {
-			uint32_t	id_;
-			uint16_t	pos_;
-			uint16_t	len_;
+		struct slot_t {
+			uint32_t	seq_;
+			uint32_t	pos_;
+			uint32_t	len_;
+			uint32_t	sum_;
 		};
 
-		area_t		area_;
+		static constexpr uint32_t unit_ = PAGE > 0 ? PAGE : 4;
+		static constexpr uint32_t slot_size_ = (sizeof(slot_t) + unit_ - 1) / unit_ * unit_;
+		static constexpr uint32_t offset_ = slot_size_ * 2;	// スロットは別のページに置く
+		static constexpr uint32_t ring_ = MEMIO::SIZE - offset_;
+
+		static_assert(MEMIO::SIZE > (offset_ + PAGE), "MEMIO::SIZE is too small");
+
+		uint32_t	seq_;
+		uint32_t	pos_;	// 次の書き込み位置
+		uint32_t	len_;
+		uint32_t	check_;	// 最後のチェック・ポイントからのバイト数
+
+		uint8_t		buff_[PAGE > 0 ? PAGE : 1];
+		uint32_t	buff_pos_;	// バッファ先頭の位置
+		uint32_t	buff_len_;
+
+		static uint32_t sum_(const slot_t& t) noexcept
+		{
+			uint32_t h = 0x811c'9dc5;
+			h = (h ^ uniq_id_) * 0x0100'0193;
+			h = (h ^ t.seq_) * 0x0100'0193;
+			h = (h ^ t.pos_) * 0x0100'0193;
+			h = (h ^ t.len_) * 0x0100'0193;
+			return h;
+		}
+
+		void checkpoint_() noexcept
+		{
+			++seq_;
+			slot_t t;
+			t.seq_ = seq_;
+			t.pos_ = pos_;
+			t.len_ = len_;
+			t.sum_ = sum_(t);
+			MEMIO::copy(&t, sizeof(slot_t), (seq_ & 1) * slot_size_);
+			check_ = 0;
+		}
+
+		void flush_buff_() noexcept
+		{
+			if(buff_len_ == 0) return;
+			MEMIO::copy(buff_, buff_len_, offset_ + buff_pos_);
+			buff_len_ = 0;
+		}
+
+		void put_(uint8_t ch) noexcept
+		{
+			if constexpr (PAGE == 0) {
+				MEMIO::put8(offset_ + pos_, ch);
+			} else {
+				if(buff_len_ == 0) buff_pos_ = pos_;
+				buff_[buff_len_] = ch;
+				++buff_len_;
+			}
+			++pos_;
+			if(pos_ >= ring_) pos_ = 0;
+			if(len_ < ring_) ++len_;
+			++check_;
+			if constexpr (PAGE > 0) {
+				// ページ境界、又は領域の終わりでまとめて書き込む
+				if(((offset_ + pos_) % PAGE) != 0 && pos_ != 0 && buff_len_ < PAGE) return;
+				flush_buff_();
+			}
+			if(check_ >= CHECK) checkpoint_();
+		}
+
+		uint8_t get_(uint32_t pos) const noexcept
+		{
+			pos += pos_ + ring_ - len_;
+			pos %= ring_;
+			if constexpr (PAGE > 0) {
+				auto ofs = (pos + ring_ - buff_pos_) % ring_;
+				if(ofs < buff_len_) return buff_[ofs];
+			}
+			uint8_t data;
+			if(MEMIO::get8(pos + offset_, data)) {
+				return data;
+			} else {
+				return 0;
+			}
+		}
 
 	public:
         //-----------------------------------------------------------------//
@@ -39,7 +135,7 @@ namespace utils {
             @brief  コンストラクター
         */
         //-----------------------------------------------------------------//
-		log_man() noexcept { }
+		log_man() noexcept : seq_(0), pos_(0), len_(0), check_(0), buff_{ }, buff_pos_(0), buff_len_(0) { }
 
 
         //-----------------------------------------------------------------//
@@ -49,10 +145,11 @@ namespace utils {
         //-----------------------------------------------------------------//
 		void clear() noexcept
 		{
-			area_.id_ = uniq_id_;
-			area_.pos_ = 0;
-			area_.len_ = 0;
-			MEMIO::copy(&area_, sizeof(area_t), 0x0000);
+			pos_ = 0;
+			len_ = 0;
+			buff_len_ = 0;
+			checkpoint_();
+			checkpoint_();  // 両方のスロット
 		}
 
 
@@ -66,12 +163,40 @@ namespace utils {
 		bool start() noexcept
 		{
 			MEMIO::start();
-			MEMIO::copy(0x0000, sizeof(area_t), &area_);
-			if(area_.id_ == uniq_id_) {
-				return true;
+			buff_len_ = 0;
+			check_ = 0;
+			slot_t t[2];
+			bool ok[2];
+			for(uint32_t i = 0; i < 2; ++i) {
+				MEMIO::copy(i * slot_size_, sizeof(slot_t), &t[i]);
+				ok[i] = t[i].sum_ == sum_(t[i]) && t[i].pos_ < ring_ && t[i].len_ <= ring_;
 			}
-			clear();
-			return false;
+			uint32_t n;
+			if(ok[0] && ok[1]) {
+				n = static_cast<int32_t>(t[1].seq_ - t[0].seq_) > 0 ? 1 : 0;
+			} else if(ok[0] || ok[1]) {
+				n = ok[0] ? 0 : 1;
+			} else {
+				seq_ = 0;
+				clear();
+				return false;
+			}
+			seq_ = t[n].seq_;
+			pos_ = t[n].pos_;
+			len_ = t[n].len_;
+			return true;
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  フラッシュ（バッファを書き込み、ヘッダーを更新）
+        */
+        //-----------------------------------------------------------------//
+		void flush() noexcept
+		{
+			flush_buff_();
+			if(check_ > 0) checkpoint_();
 		}
 
 
@@ -83,13 +208,7 @@ namespace utils {
         //-----------------------------------------------------------------//
 		void putch(char ch) noexcept
 		{
-			MEMIO::put8(sizeof(area_t) + area_.pos_, ch);
-			++area_.pos_;
-			uint16_t limit = MEMIO::SIZE - sizeof(area_t);
-			if(area_.pos_ >= limit) area_.pos_ = 0;
-			++area_.len_;
-			if(area_.len_ > limit) area_.len_ = limit;
-			MEMIO::copy(&area_, sizeof(area_t), 0x0000);
+			put_(static_cast<uint8_t>(ch));
 		}
 
 
@@ -111,13 +230,40 @@ namespace utils {
 		}
 
 
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  タイムスタンプ付きバイナリー・レコードの追加
+			@param[in]	time	タイムスタンプ
+			@param[in]	src		データ
+			@param[in]	len		長さ（RECORD_MAX まで）
+			@return 長さが範囲外なら「false」
+        */
+        //-----------------------------------------------------------------//
+		bool put_record(uint32_t time, const void* src, uint32_t len) noexcept
+		{
+			if(len > RECORD_MAX || (src == nullptr && len > 0)) return false;
+
+			put_(SYNC);
+			put_(len);
+			put_(~len);
+			for(uint32_t i = 0; i < 4; ++i) {
+				put_(time >> (i * 8));
+			}
+			auto p = static_cast<const uint8_t*>(src);
+			for(uint32_t i = 0; i < len; ++i) {
+				put_(p[i]);
+			}
+			return true;
+		}
+
+
         //-----------------------------------------------------------------//
         /*!
             @brief  記録長の取得
 			@return 記録長
         */
         //-----------------------------------------------------------------//
-		uint16_t get_length() const noexcept { return area_.len_; }
+		uint32_t get_length() const noexcept { return len_; }
 
 
         //-----------------------------------------------------------------//
@@ -127,18 +273,52 @@ namespace utils {
 			@return 文字
         */
         //-----------------------------------------------------------------//
-		char getch(uint16_t pos) const noexcept
+		char getch(uint32_t pos) const noexcept
 		{
-			if(area_.len_ == 0) return 0;
+			if(len_ == 0 || pos >= len_) return 0;
 
-			pos += area_.pos_ - area_.len_;
-			pos %= MEMIO::SIZE - sizeof(area_t);
-			uint8_t data;
-			if(MEMIO::get8(pos + sizeof(area_t), data)) {
-				return static_cast<char>(data);
-			} else {
-				return 0;
+			return static_cast<char>(get_(pos));
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  バイナリー・レコードの取得 @n
+					pos から次のレコードを探す（テキストは読み飛ばす）
+			@param[in,out]	pos	検索開始位置、レコードの次の位置を返す
+			@param[out]	time	タイムスタンプ
+			@param[out]	dst		データの転送先
+			@param[in,out]	len	転送先のサイズ、レコードの長さを返す
+			@return レコードが無い場合「false」
+        */
+        //-----------------------------------------------------------------//
+		bool get_record(uint32_t& pos, uint32_t& time, void* dst, uint32_t& len) const noexcept
+		{
+			while((pos + 7) <= len_) {
+				if(get_(pos) != SYNC) {
+					++pos;
+					continue;
+				}
+				uint8_t n = get_(pos + 1);
+				if(static_cast<uint8_t>(~get_(pos + 2)) != n || (pos + 7 + n) > len_) {
+					++pos;
+					continue;
+				}
+				time = 0;
+				for(uint32_t i = 0; i < 4; ++i) {
+					time |= static_cast<uint32_t>(get_(pos + 3 + i)) << (i * 8);
+				}
+				auto p = static_cast<uint8_t*>(dst);
+				for(uint32_t i = 0; i < n && i < len; ++i) {
+					p[i] = get_(pos + 7 + i);
+				}
+				len = n;
+				pos += 7 + n;
+				return true;
 			}
+			pos = len_;
+			len = 0;
+			return false;
 		}
 	};
 }
@@ -1,17 +1,25 @@
 #pragma once
 //=========================================================================//
 /*!	@file
-	@brief	モニター（メモリの読出し、書き込み）
+	@brief	モニター（メモリの読出し、書き込み） @n
+			コマンドの分岐は command_dispatch（完全ハッシュ）で行い、 @n
+			TAB キーでコマンド名を補完出来る。 @n
+			ISR_PROFILE を定義すると、"isr" コマンドで割り込みプロファイラー @n
+			（device::isr_prof）のレポートを表示する。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2022 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2022, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=========================================================================//
 #include "common/command.hpp"
+#include "common/command_dispatch.hpp"
 #include "common/format.hpp"
 #include "common/input.hpp"
 #include "common/fixed_string.hpp"
+#ifdef ISR_PROFILE
+#include "common/isr_prof.hpp"
+#endif
 
 namespace utils {
 
@@ -176,6 +184,72 @@ namespace utils {
 			LIST,
 		};
 
+		typedef command_entry<monitor, CMD> ENTRY;
+
+		// HELP は、短縮形（d[ump] など）を含む、以前と同じ表記で出す
+		static void cmd_help_(monitor& m, const CMD& cmd) noexcept
+		{
+			if(cmd.get_words() != 1) {
+				m.unknown_(cmd);
+				return;
+			}
+			utils::format("d[ump] [org] [end]      Dump memory.\n");
+			utils::format("r[ead] [org]            Read memory.\n");
+			utils::format("w[rite] org data ...    Write memory.\n");
+			utils::format("bus [124]               Current bus width\n");
+#ifdef ISR_PROFILE
+			utils::format("isr [hist] [clear]      ISR profile.\n");
+#endif
+//			utils::format("sym address name        Set symbol\n");
+//			utils::format("list [name] ...         List symbol\n");
+		}
+
+		void unknown_(const CMD& cmd) noexcept
+		{
+			utils::format("Monitor command: '%s' ?\n") % cmd.get_argv(0);
+		}
+
+		static void cmd_dump_(monitor& m, const CMD& cmd) noexcept { m.operate_(OPR::DUMP, cmd); }
+		static void cmd_read_(monitor& m, const CMD& cmd) noexcept { m.operate_(OPR::READ, cmd); }
+		static void cmd_write_(monitor& m, const CMD& cmd) noexcept { m.operate_(OPR::WRITE, cmd); }
+		static void cmd_bus_(monitor& m, const CMD& cmd) noexcept { m.operate_(OPR::BUS, cmd); }
+#ifdef ISR_PROFILE
+		static void cmd_isr_(monitor& m, const CMD& cmd) noexcept
+		{
+			if(device::isr_prof_def::report_func == nullptr) {
+				utils::format("ISR profile: not started\n");
+				return;
+			}
+			bool hist = false;
+			bool clear = false;
+			for(uint32_t i = 1; i < cmd.get_words(); ++i) {
+				if(cmd.cmp_word(i, "hist")) hist = true;
+				else if(cmd.cmp_word(i, "clear")) clear = true;
+				else {
+					utils::format("Option: '%s' ?\n") % cmd.get_argv(i);
+					return;
+				}
+			}
+			device::isr_prof_def::report_func(hist, clear);
+		}
+#endif
+
+		// 説明は cmd_help_ が出すので、表には名前と処理だけを置く
+		static constexpr ENTRY cmds_[] = {
+			{ "dump",  nullptr, nullptr, cmd_dump_ },
+			{ "d",     nullptr, nullptr, cmd_dump_ },
+			{ "read",  nullptr, nullptr, cmd_read_ },
+			{ "r",     nullptr, nullptr, cmd_read_ },
+			{ "write", nullptr, nullptr, cmd_write_ },
+			{ "w",     nullptr, nullptr, cmd_write_ },
+			{ "bus",   nullptr, nullptr, cmd_bus_ },
+#ifdef ISR_PROFILE
+			{ "isr",   nullptr, nullptr, cmd_isr_ },
+#endif
+			{ "help",  nullptr, nullptr, cmd_help_ },
+		};
+		static constexpr auto disp_ = make_command_dispatch(cmds_);
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
@@ -202,58 +276,29 @@ namespace utils {
 			}
 
 			if(!cmd_.service()) {
+				if(cmd_.probe_tab()) {
+					disp_.complete(cmd_);
+				}
 				return;
 			}
 
-			uint32_t cmdn = cmd_.get_words();
-			if(cmdn == 0) return;
+			if(cmd_.get_words() == 0) return;
 
-			if(cmdn == 1 && cmd_.cmp_word(0, "help")) {
-				utils::format("d[ump] [org] [end]      Dump memory.\n");
-				utils::format("r[ead] [org]            Read memory.\n");
-				utils::format("w[rite] org data ...    Write memory.\n");
-				utils::format("bus [124]               Current bus width\n");
-//				utils::format("sym address name        Set symbol\n");
-//				utils::format("list [name] ...         List symbol\n");
-				return;
-			}
-
-			auto opr = OPR::NONE;
-			if(cmdn >= 1) {
-				if(cmd_.cmp_word(0, "dump")) {
-					opr = OPR::DUMP;
-				} else if(cmd_.cmp_word(0, "d")) {
-					opr = OPR::DUMP;
-				} else if(cmd_.cmp_word(0, "read")) {
-					opr = OPR::READ;
-				} else if(cmd_.cmp_word(0, "r")) {
-					opr = OPR::READ;
-				} else if(cmd_.cmp_word(0, "write")) {
-					opr = OPR::WRITE;
-				} else if(cmd_.cmp_word(0, "w")) {
-					opr = OPR::WRITE;
-				} else if(cmd_.cmp_word(0, "bus")) {
-					opr = OPR::BUS;
-//				} else if(cmd_.cmp_word(0, "sym")) {
-//					opr = OPR::SYM;
-//				} else if(cmd_.cmp_word(0, "list")) {
-//					opr = OPR::LIST;
-				}
-			}
-			if(opr == OPR::NONE) {
-				char tmp[256];
-				cmd_.get_word(0, tmp, sizeof(tmp));
-				utils::format("Monitor command: '%s' ?\n") % tmp;
-				return;
+			if(!disp_.exec(*this, cmd_)) {
+				unknown_(cmd_);
 			}
+		}
 
+	private:
+		void operate_(OPR opr, const CMD& cmd) noexcept
+		{
+			uint32_t cmdn = cmd.get_words();
 			uint32_t n = 1;
 			uint32_t org = address_;
 			uint32_t end = address_ + 16 - step_();
 			uint32_t m = 0;
 			while(n < cmdn) {
-				char tmp[64];
-				cmd_.get_word(n, tmp, sizeof(tmp));
+				auto tmp = cmd.get_argv(n);
 				uint32_t v = 0;
 				if((utils::input("%x", tmp) % v).status()) {
 					if(m == 0) {
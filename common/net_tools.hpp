@@ -3,7 +3,7 @@
 /*!	@file
 	@brief	ネットワーク・ツール
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2017 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2017, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -13,6 +13,7 @@
 #include <random>
 #include "common/byte_order.h"
 #include "common/time.h"
+#include "common/crc_engine.hpp"
 
 #if defined(BIG_ENDIAN)
 #elif defined(LITTLE_ENDIAN)
@@ -86,21 +87,7 @@ namespace net {
 		//-----------------------------------------------------------------//
 		static uint16_t calc_sum(const void* src, uint16_t len, uint16_t sumorg = 0)
 		{
-			const uint8_t* d = static_cast<const uint8_t*>(src);
-			uint32_t sum = sumorg;
-			bool mod = false;
-			if(len & 1) {
-				len &= 0xfffe;
-				mod = true;
-			}
-			for(uint16_t i = 0; i < len; i += 2) {
-				sum += (d[0] << 8) | d[1];
-				d += 2;
-			}
-			if(mod) {
-				sum += d[0] << 8;
-			}
-			return ~((sum & 0xffff) + (sum >> 16));
+			return utils::inet_sum::calc(src, len, sumorg);
 		}
 
 
@@ -2,19 +2,30 @@
 //=========================================================================//
 /*!	@file
 	@brief	RX グループ・RSCI I/O 制御（調歩同期モード） @n
-			※内臓の FIFO バッファを利用しない実装（扱いにくいので利用しない）
+			※内臓の FIFO バッファを利用しない実装（扱いにくいので利用しない） @n
+			・DMAC による送信、受信をサポート（DTX、DRX に DMAC チャネルを指定した場合） @n
+			  送信、受信の方法は sci_io と同じ（送信は TEI から起動、受信は循環書き込み）。 @n
+			  TDR、RDR は 32 ビットなので、DMA は下位バイト（リトル・エンディアン）をアクセスする。 @n
+			Ex: DMAC を使う場合の定義例（送信 DMAC0、受信 DMAC1） @n
+			  typedef device::rsci_io<device::RSCI8, RBF, SBF, device::port_map::ORDER::FIRST, @n
+			    device::DMAC0, device::DMAC1> RSCI;
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2023, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2023, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=========================================================================//
+#include <cstring>
+#include <type_traits>
 #include "common/renesas.hpp"
 #include "common/vect.h"
 #include "common/sci_io_base.hpp"
 
 namespace device {
 
+	// DMAC を持たないデバイス用の前方宣言（DMA を使う場合のみ実体化される）
+	template <class DMAC, class TASK> class dmac_mgr;
+
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  RSCI I/O 制御クラス
@@ -22,14 +33,23 @@ namespace device {
 		@param[in]	RBF		受信バッファクラス
 		@param[in]	SBF		送信バッファクラス
 		@param[in]	PSEL	ポート選択
+		@param[in]	DTX		送信 DMAC チャネル（NULL_DMAC の場合、割り込み送信）
+		@param[in]	DRX		受信 DMAC チャネル（NULL_DMAC の場合、割り込み受信）
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <class RSCI, class RBF, class SBF, port_map::ORDER PSEL = port_map::ORDER::FIRST>
+	template <class RSCI, class RBF, class SBF, port_map::ORDER PSEL = port_map::ORDER::FIRST,
+		class DTX = sci_io_base::NULL_DMAC, class DRX = sci_io_base::NULL_DMAC>
 	class rsci_io : public sci_io_base {
 
 		static_assert(RBF::size() > 8, "Receive buffer is too small.");
 		static_assert(SBF::size() > 8, "Transmission buffer is too small.");
 
+		static constexpr bool DMA_SEND = !std::is_same<DTX, sci_io_base::NULL_DMAC>::value;
+		static constexpr bool DMA_RECV = !std::is_same<DRX, sci_io_base::NULL_DMAC>::value;
+
+		static_assert(!DMA_SEND || SBF::size() <= 65535, "Transmission buffer is too large for DMA.");
+		static_assert(!DMA_RECV || RBF::size() <= 65535, "Receive buffer is too large for DMA.");
+
 	public:
 		typedef RSCI peripheral_type;
 		typedef RBF  recv_buffer_type;
@@ -42,6 +62,33 @@ namespace device {
 		static inline volatile uint16_t	per_cnt_;
 		static inline volatile uint16_t	fer_cnt_;
 
+		static inline volatile uint32_t	rxi_cnt_;
+		static inline volatile uint32_t	txi_cnt_;
+		static inline volatile uint32_t	dma_cnt_;
+		static inline volatile uint32_t	recv_bytes_;
+		static inline volatile uint32_t	send_bytes_;
+
+		static inline volatile uint16_t	recv_idle_;
+		static inline uint32_t			recv_idle_ref_;
+
+		static inline ICU::LEVEL		dma_level_;
+		static inline volatile uint32_t	send_dma_len_;	// 転送中の DMA 長（０なら停止中）
+		static inline uint32_t			recv_dma_org_;	// 受信 DMA 先頭アドレス
+		static inline volatile uint32_t	recv_dma_ofs_;	// 受信 DMA の開始位置（受信バッファ内）
+		static inline volatile uint32_t	recv_dma_len_;	// 受信 DMA の転送数
+		static inline volatile uint32_t	recv_dma_seq_;	// 受信 DMA の再設定回数（一貫した読み出し用）
+		static inline uint32_t			recv_sync_;		// 受信バッファに反映した受信バイト数
+		static inline volatile uint32_t	recv_lost_;		// 上書きで失った受信バイト数
+
+		struct send_dma_task_t {
+			void operator() () noexcept { send_dma_end_(); }
+		};
+		struct recv_dma_task_t {
+			void operator() () noexcept { recv_dma_end_(); }
+		};
+		typedef dmac_mgr<DTX, send_dma_task_t> SEND_DMA;
+		typedef dmac_mgr<DRX, recv_dma_task_t> RECV_DMA;
+
 		ICU::LEVEL	level_;
 		bool		auto_crlf_;
 		uint32_t	baud_;
@@ -78,22 +125,202 @@ namespace device {
 		{
 			volatile uint8_t rd = RSCI::RDR.RDAT();
 			recv_.put(rd);
+			++rxi_cnt_;
+			++recv_bytes_;
 		}
 
 		static INTERRUPT_FUNC void txi_task_()
 		{
+			++txi_cnt_;
 			if(send_.length() > 0) {
 				RSCI::TDR.TDAT = send_.get();
+				++send_bytes_;
+			} else {
+				RSCI::SCR0.TIE = 0;
+			}
+		}
+
+		static inline void tei_task_()
+		{
+			RSCI::SCR0.TEIE = 0;
+			if(send_dma_len_ == 0 && send_.length() > 0) {  // 送信完了待ちからの起動
+				send_dma_first_();
+			}
+		}
+
+		static INTERRUPT_FUNC void tei_itask_()
+		{
+			tei_task_();
+		}
+
+		// DMA 再設定の隙間に、要求が CPU に回った場合は、DMA の書き込み位置に格納して、
+		// その次から DMA を再開する
+		static INTERRUPT_FUNC void rxi_dma_task_()
+		{
+			++rxi_cnt_;
+			RECV_DMA dma;
+			dma.stop();
+			uint32_t n = recv_dma_len_ - (dma.get_count() & 0xffff);
+			uint32_t ofs = recv_dma_ofs_ + n;
+			if(ofs >= RBF::size()) ofs = 0;
+			reinterpret_cast<volatile uint8_t*>(recv_dma_org_)[ofs] = RSCI::RDR.RDAT();
+			recv_bytes_ += n + 1;
+			++ofs;
+			if(ofs >= RBF::size()) ofs = 0;
+			recv_dma_start_(ofs);
+		}
+
+		static INTERRUPT_FUNC void txi_dma_task_()
+		{
+			++txi_cnt_;
+			if(send_dma_len_ == 0) {
+				RSCI::SCR0.TIE = 0;
+			}
+		}
+
+		// 送信バッファの連続領域（ラップアラウンドまで）を DMA 転送
+		static bool send_dma_next_() noexcept
+		{
+			uint32_t len = send_.length();
+			if(len == 0) {
+				send_dma_len_ = 0;
+				return false;
+			}
+			auto get = send_.pos_get();
+			if((get + len) > SBF::size()) {
+				len = SBF::size() - get;
+			}
+			send_dma_len_ = len;
+			SEND_DMA dma;
+			dma.start(SEND_DMA::TRANS_MODE::NORMAL, SEND_DMA::TRANS_TYPE::SP_DN_8, RSCI::TXI,
+				reinterpret_cast<uint32_t>(&send_.get_at()), RSCI::TDR.address, 0, len, dma_level_);
+			return true;
+		}
+
+		// 最初の１バイトを書き込み、TXI で続きを DMA 転送（送信完了状態で呼ぶ）
+		static void send_dma_first_() noexcept
+		{
+			ICU::IR[RSCI::TXI] = 0;
+			RSCI::TDR.TDAT = send_.get();
+			++send_bytes_;
+			if(send_dma_next_()) {
+				RSCI::SCR0.TIE = 1;
+			}
+		}
+
+		static void send_dma_end_() noexcept
+		{
+			++dma_cnt_;
+			send_.get_go(send_dma_len_);
+			send_bytes_ += send_dma_len_;
+			if(!send_dma_next_()) {
+				RSCI::SCR0.TIE = 0;
+			}
+		}
+
+		// 受信は、ofs から受信バッファの終端までを DMA で書き込み、終了で先頭に戻る
+		// recv_bytes_ は、現在の DMA より前に受信したバイト数
+		static void recv_dma_start_(uint32_t ofs) noexcept
+		{
+			recv_dma_ofs_ = ofs;
+			recv_dma_len_ = RBF::size() - ofs;
+			++recv_dma_seq_;
+			RECV_DMA dma;
+			dma.start(RECV_DMA::TRANS_MODE::NORMAL, RECV_DMA::TRANS_TYPE::SN_DP_8, RSCI::RXI,
+				RSCI::RDR.address, recv_dma_org_ + ofs, 0, recv_dma_len_, dma_level_);
+		}
+
+		static void recv_dma_end_() noexcept
+		{
+			++dma_cnt_;
+			RECV_DMA dma;
+			if((dma.get_count() & 0xffff) != 0) return;  // rxi_dma_task_ で再開済み
+			recv_bytes_ += recv_dma_len_;
+			recv_dma_start_(0);
+		}
+
+		// DMA が書き込んだ位置まで、受信バッファの格納ポイントを進める @n
+		// 読み出しが間に合わず、未読の領域まで上書きされた場合は、最新の SIZE-1 バイトを残す
+		static void recv_dma_sync_() noexcept
+		{
+			auto total = recv_total_();
+			uint32_t n = total - recv_sync_;
+			if(n == 0) return;
+			recv_sync_ = total;
+			uint32_t space = RBF::size() - 1 - recv_.length();
+			recv_.put_go(n % RBF::size());
+			if(n > space) {
+				recv_lost_ += n - space;
+				recv_.get_go((recv_.pos_put() + 1 + RBF::size() - recv_.pos_get()) % RBF::size());
+			}
+		}
+
+		static uint32_t recv_total_() noexcept
+		{
+			if constexpr (DMA_RECV) {
+				RECV_DMA dma;
+				uint32_t seq;
+				uint32_t n;
+				do {  // 途中で DMA が再設定された場合は読み直す
+					seq = recv_dma_seq_;
+					n = recv_bytes_ + recv_dma_len_ - (dma.get_count() & 0xffff);
+				} while(seq != recv_dma_seq_);
+				return n;
 			} else {
+				return recv_bytes_;
+			}
+		}
+
+		uint32_t recv_len_() noexcept
+		{
+			if constexpr (DMA_RECV) {
+				recv_dma_sync_();
+			}
+			return recv_.length();
+		}
+
+		// 送信の起動（送信中なら何もしない）
+		void send_kick_() noexcept
+		{
+			if(send_.length() == 0) return;
+
+			if constexpr (DMA_SEND) {
+				if(send_dma_len_ != 0 || RSCI::SCR0.TEIE() != 0) return;  // DMA 転送中、TEI 待ち
+				// TXI を発生させる為、送信完了で最初の１バイトを書き込む
 				RSCI::SCR0.TIE = 0;
+				if(RSCI::SSR.TEND() == 0) {  // 送信中なら、TEI 割り込みから起動
+					RSCI::SCR0.TEIE = 1;
+					return;
+				}
+				send_dma_first_();
+			} else {
+				if(RSCI::SCR0.TIE() == 0) {
+					RSCI::SCR0.TIE = 1;
+					RSCI::TDR.TDAT = send_.get();
+					++send_bytes_;
+				}
 			}
 		}
 
 		void set_intr_() noexcept
 		{
 			if(level_ != ICU::LEVEL::NONE) {
-				icu_mgr::set_interrupt(RSCI::RXI, rxi_task_, level_);
-				icu_mgr::set_interrupt(RSCI::TXI, txi_task_, level_);
+				if constexpr (DMA_RECV) {
+					icu_mgr::set_interrupt(RSCI::RXI, rxi_dma_task_, level_);
+				} else {
+					icu_mgr::set_interrupt(RSCI::RXI, rxi_task_, level_);
+				}
+				if constexpr (DMA_SEND) {
+					icu_mgr::set_interrupt(RSCI::TXI, txi_dma_task_, level_);
+					auto gv = icu_mgr::get_group_vector(RSCI::TEI);
+					if(gv == ICU::VECTOR::NONE) {
+						icu_mgr::set_interrupt(RSCI::TEI, tei_itask_, level_);
+					} else {
+						icu_mgr::set_interrupt(RSCI::TEI, tei_task_, level_);
+					}
+				} else {
+					icu_mgr::set_interrupt(RSCI::TXI, txi_task_, level_);
+				}
 				{  // エラー割り込みの設定
 					auto gv = icu_mgr::get_group_vector(RSCI::ERI);
 					if(gv == ICU::VECTOR::NONE) {  // not group vector
@@ -106,6 +333,9 @@ namespace device {
 				icu_mgr::set_interrupt(RSCI::RXI, nullptr, level_);
 				icu_mgr::set_interrupt(RSCI::TXI, nullptr, level_);
 				icu_mgr::set_interrupt(RSCI::ERI, nullptr, level_);
+				if(DMA_SEND) {
+					icu_mgr::set_interrupt(RSCI::TEI, nullptr, level_);
+				}
 			}
 		}
 
@@ -172,6 +402,7 @@ namespace device {
 			orer_cnt_ = 0;
 			fer_cnt_ = 0;
 			per_cnt_ = 0;
+			reset_stat();
 		}
 
 
@@ -215,6 +446,84 @@ namespace device {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	統計情報の取得 @n
+					DMA 受信の場合、受信割り込み回数は数えない（DMA が処理する）
+			@return 統計情報
+		 */
+		//-----------------------------------------------------------------//
+		static stat_t get_stat() noexcept
+		{
+			stat_t t;
+			t.rxi_count = rxi_cnt_;
+			t.txi_count = txi_cnt_;
+			t.dma_count = dma_cnt_;
+			t.recv_bytes = recv_total_();
+			t.recv_lost = recv_lost_;
+			t.send_bytes = send_bytes_;
+			return t;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	統計情報のリセット（DMA 受信中は、受信バイト数をリセットしない）
+		 */
+		//-----------------------------------------------------------------//
+		static void reset_stat() noexcept
+		{
+			rxi_cnt_ = 0;
+			txi_cnt_ = 0;
+			dma_cnt_ = 0;
+			recv_lost_ = 0;
+			if(!DMA_RECV) {
+				recv_bytes_ = 0;
+			}
+			send_bytes_ = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信アイドル・サービス @n
+					タイマー割り込みなどから一定周期で呼ぶ、受信が無い周期を数える。
+		 */
+		//-----------------------------------------------------------------//
+		static void idle_service() noexcept
+		{
+			auto n = recv_total_();
+			if(n != recv_idle_ref_) {
+				recv_idle_ref_ = n;
+				recv_idle_ = 0;
+			} else if(recv_idle_ < 0xffff) {
+				++recv_idle_;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信アイドル周期数の取得
+			@return 最後の受信からの idle_service 呼び出し回数
+		 */
+		//-----------------------------------------------------------------//
+		static uint16_t get_recv_idle() noexcept { return recv_idle_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信アイドルの検査（可変長フレームの区切り）
+			@param[in]	cnt		アイドルと判定する idle_service の周期数
+			@return 受信データがあり、cnt 周期以上受信が無い場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_recv_idle(uint16_t cnt) noexcept
+		{
+			return recv_idle_ >= cnt && recv_length() > 0;
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	LF 時、CR 自動送出
@@ -289,7 +598,22 @@ namespace device {
 				return false;
 			}
 
+			if((DMA_SEND || DMA_RECV) && level == ICU::LEVEL::NONE) {
+				// DMA 転送では、割り込みを使わない設定は NG
+				return false;
+			}
+
 			level_ = level;
+			dma_level_ = level;
+			recv_.clear();
+			send_.clear();
+			send_dma_len_ = 0;
+			recv_dma_org_ = reinterpret_cast<uint32_t>(&recv_.put_at());
+			recv_bytes_ = 0;
+			recv_sync_ = 0;
+			recv_lost_ = 0;
+			recv_idle_ = 0;
+			recv_idle_ref_ = 0;
 
 			RSCI::SCR0 = 0x0000;	// TE, RE disable.
 
@@ -358,6 +682,10 @@ namespace device {
 			RSCI::SCR2 = RSCI::SCR2.CKS.b(cks) | RSCI::SCR2.MDDR.b(mddr) | RSCI::SCR2.BRR.b(brr)
 					   | RSCI::SCR2.ABCS.b(abcs) | RSCI::SCR2.BGDM.b(bgdm) | RSCI::SCR2.BRME.b(brme);
 
+			if constexpr (DMA_RECV) {
+				recv_dma_start_(0);
+			}
+
 			if(level_ != ICU::LEVEL::NONE) {
 				RSCI::SCR0 = RSCI::SCR0.RIE.b() | RSCI::SCR0.TE.b() | RSCI::SCR0.RE.b();
 			} else {
@@ -466,10 +794,7 @@ namespace device {
 					while(send_.length() != 0) sleep_();
 				}
 				send_.put(ch);
-				if(RSCI::SCR0.TIE() == 0) {
-					RSCI::SCR0.TIE = 1;
-					RSCI::TDR.TDAT = send_.get();
-				}
+				send_kick_();
 			} else {
 				while(RSCI::SSR.TDRE() == 0) sleep_();
 				RSCI::TDR.TDAT = ch;
@@ -486,7 +811,7 @@ namespace device {
 		uint32_t recv_length() noexcept
 		{
 			if(level_ != ICU::LEVEL::NONE) {
-				return recv_.length();
+				return recv_len_();
 			} else {
 				if(RSCI::RDR.PER()) {	///< パリティ・エラー状態確認
 				}
@@ -505,7 +830,11 @@ namespace device {
 		void flush_recv() noexcept
 		{
 			if(recv_length() > 0) {
-				recv_.clear();
+				if(DMA_RECV) {  // DMA が書き込み中なので、取得ポイントを進める
+					recv_.get_go(recv_.length());
+				} else {
+					recv_.clear();
+				}
 			}
 		}
 
@@ -519,7 +848,7 @@ namespace device {
 		char getch() noexcept
 		{
 			if(level_ != ICU::LEVEL::NONE) {
-				while(recv_.length() == 0) sleep_();
+				while(recv_len_() == 0) sleep_();
 				return recv_.get();
 			} else {
 				while(recv_length() == 0) sleep_();
@@ -529,6 +858,91 @@ namespace device {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ブロック出力 @n
+					送信バッファの連続領域単位でコピーし、空きが無い場合は待つ。 @n
+					LF の CR 自動送出は行わない。
+			@param[in]	src		転送元
+			@param[in]	len		バイト数
+			@return 書き込んだバイト数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t write(const void* src, uint32_t len) noexcept
+		{
+			if(src == nullptr) return 0;
+
+			auto p = static_cast<const uint8_t*>(src);
+			if(level_ == ICU::LEVEL::NONE) {
+				for(uint32_t i = 0; i < len; ++i) {
+					while(RSCI::SSR.TDRE() == 0) sleep_();
+					RSCI::TDR.TDAT = p[i];
+				}
+				return len;
+			}
+
+			uint32_t n = 0;
+			while(n < len) {
+				uint32_t space = SBF::size() - 1 - send_.length();
+				if(space == 0) {
+					send_kick_();
+					sleep_();
+					continue;
+				}
+				auto put = send_.pos_put();
+				uint32_t l = len - n;
+				if(l > space) l = space;
+				if((put + l) > SBF::size()) {
+					l = SBF::size() - put;
+				}
+				std::memcpy(&send_.put_at(), p + n, l);
+				send_.put_go(l);
+				n += l;
+				send_kick_();
+			}
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ブロック入力（ノンブロック） @n
+					受信バッファの連続領域単位でコピーする。
+			@param[out]	dst		転送先
+			@param[in]	len		最大バイト数
+			@return 読み出したバイト数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t read(void* dst, uint32_t len) noexcept
+		{
+			if(dst == nullptr) return 0;
+
+			auto p = static_cast<uint8_t*>(dst);
+			uint32_t n = 0;
+			if(level_ == ICU::LEVEL::NONE) {
+				while(n < len && recv_length() > 0) {
+					p[n] = RSCI::RDR.RDAT();
+					++n;
+				}
+				return n;
+			}
+
+			while(n < len) {
+				uint32_t l = recv_len_();
+				if(l == 0) break;
+				auto get = recv_.pos_get();
+				if(l > (len - n)) l = len - n;
+				if((get + l) > RBF::size()) {
+					l = RBF::size() - get;
+				}
+				std::memcpy(p + n, &recv_.get_at(), l);
+				recv_.get_go(l);
+				n += l;
+			}
+			return n;
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	uart文字列出力
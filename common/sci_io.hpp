@@ -7,8 +7,13 @@
 			  通常の非同期通信では、ボーレートの設定範囲と精度が異なるだけです。 @n
 			・SCI の機能によって、ポーリングが出来ない場合があります。 @n
 			   SCIx::SSR_RDRF 定数が false の場合はポーリング不可です。 @n
-			・DMAC による転送をサポートしていませんが、必要性を感じていません。 @n
-			・同期通信で、ブロック転送を行うような場合は、必要かもしれません。 @n
+			・DMAC による送信、受信をサポート（DTX、DRX に DMAC チャネルを指定した場合） @n
+			  送信は、送信バッファの連続領域（ラップアラウンドまで）を TXI 起動の DMA で転送する。 @n
+			  受信は、受信バッファ全体を RXI 起動の DMA で循環して書き込む。 @n
+			  DMA 受信では、フロー制御は使えない、受信バッファは十分な大きさにする事。 @n
+			  読み出しが間に合わず上書きされたバイト数は、統計情報（recv_lost）で分かる。 @n
+			・バイナリ・データは write、read を使う（バッファへのコピーは連続領域単位） @n
+			・可変長フレームの受信は、idle_service を一定周期で呼び、is_recv_idle で区切りを検出する。 @n
 			Ex: 定義例 @n
 			・受信バッファ、送信バッファの大きさは、最低１６バイトは必要です。 @n
 			・ボーレート、サービスする内容に応じて適切に設定して下さい。 @n
@@ -35,6 +40,9 @@
 				} @n
 			  }; @n
 			上記関数を定義しておけば、syscalls.c との連携で、printf が使えるようになる。 @n
+			Ex: DMAC を使う場合の定義例（送信 DMAC0、受信 DMAC1） @n
+			  typedef device::sci_io<device::SCI1, RBF, SBF, device::port_map::ORDER::FIRST, @n
+			    device::sci_io_base::FLOW_CTRL::NONE, device::NULL_PORT, device::DMAC0, device::DMAC1> SCI; @n
 			※ C++ では printf は推奨しないし使う理由が無い、utils::format を使って下さい。 @n
 			RS-485： @n
 			・レシーバーの受信ゲートは常に有効にしておく。 @n
@@ -54,12 +62,17 @@
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=========================================================================//
+#include <cstring>
+#include <type_traits>
 #include "common/renesas.hpp"
 #include "common/fixed_fifo.hpp"
 #include "common/sci_io_base.hpp"
 
 namespace device {
 
+	// DMAC を持たないデバイス用の前方宣言（DMA を使う場合のみ実体化される）
+	template <class DMAC, class TASK> class dmac_mgr;
+
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief  SCI I/O 制御クラス
@@ -69,15 +82,26 @@ namespace device {
 		@param[in]	PSEL	ポート候補
 		@param[in]	FLCT	フロー制御型
 		@param[in]	RTS		制御ポート（RTS/RS-485_DE）
+		@param[in]	DTX		送信 DMAC チャネル（NULL_DMAC の場合、割り込み送信）
+		@param[in]	DRX		受信 DMAC チャネル（NULL_DMAC の場合、割り込み受信）
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	template <class SCI, class RBF, class SBF, port_map::ORDER PSEL = port_map::ORDER::FIRST,
-		typename sci_io_base::FLOW_CTRL FLCT = sci_io_base::FLOW_CTRL::NONE, class RTS = NULL_PORT>
+		typename sci_io_base::FLOW_CTRL FLCT = sci_io_base::FLOW_CTRL::NONE, class RTS = NULL_PORT,
+		class DTX = sci_io_base::NULL_DMAC, class DRX = sci_io_base::NULL_DMAC>
 	class sci_io : public sci_io_base {
 
 		static_assert(RBF::size() > 15, "Receive buffer is too small.");
 		static_assert(SBF::size() > 15, "Transmission buffer is too small.");
 
+		static constexpr bool DMA_SEND = !std::is_same<DTX, sci_io_base::NULL_DMAC>::value;
+		static constexpr bool DMA_RECV = !std::is_same<DRX, sci_io_base::NULL_DMAC>::value;
+
+		static_assert(!DMA_RECV || FLCT == sci_io_base::FLOW_CTRL::NONE || FLCT == sci_io_base::FLOW_CTRL::RS485,
+			"DMA receive does not support flow control.");
+		static_assert(!DMA_SEND || SBF::size() <= 65535, "Transmission buffer is too large for DMA.");
+		static_assert(!DMA_RECV || RBF::size() <= 65535, "Receive buffer is too large for DMA.");
+
 	public:
 		typedef SCI peripheral_type;
 		typedef RBF recv_buffer_type;
@@ -98,6 +122,36 @@ namespace device {
 		static inline volatile uint16_t	per_cnt_;
 		static inline volatile uint16_t	fer_cnt_;
 
+		static inline volatile uint32_t	rxi_cnt_;
+		static inline volatile uint32_t	txi_cnt_;
+		static inline volatile uint32_t	dma_cnt_;
+		static inline volatile uint32_t	recv_bytes_;
+		static inline volatile uint32_t	send_bytes_;
+
+		static inline volatile uint16_t	recv_idle_;
+		static inline uint32_t			recv_idle_ref_;
+
+		static inline ICU::LEVEL		dma_level_;
+		static inline volatile uint32_t	send_dma_len_;	// 転送中の DMA 長（０なら停止中）
+		static inline uint32_t			recv_dma_org_;	// 受信 DMA 先頭アドレス
+		static inline volatile uint32_t	recv_dma_ofs_;	// 受信 DMA の開始位置（受信バッファ内）
+		static inline volatile uint32_t	recv_dma_len_;	// 受信 DMA の転送数
+		static inline volatile uint32_t	recv_dma_seq_;	// 受信 DMA の再設定回数（一貫した読み出し用）
+		static inline uint32_t			recv_sync_;		// 受信バッファに反映した受信バイト数
+		static inline volatile uint32_t	recv_lost_;		// 上書きで失った受信バイト数
+
+		static_assert(sizeof(send_.get_at()) == 1, "Transmission buffer unit must be byte.");
+		static_assert(sizeof(recv_.get_at()) == 1, "Receive buffer unit must be byte.");
+
+		struct send_dma_task_t {
+			void operator() () noexcept { send_dma_end_(); }
+		};
+		struct recv_dma_task_t {
+			void operator() () noexcept { recv_dma_end_(); }
+		};
+		typedef dmac_mgr<DTX, send_dma_task_t> SEND_DMA;
+		typedef dmac_mgr<DRX, recv_dma_task_t> RECV_DMA;
+
 		ICU::LEVEL	level_;
 		bool		auto_crlf_;
 		uint32_t	baud_;
@@ -155,12 +209,16 @@ namespace device {
 #endif
 			}
 			recv_.put(rd);
+			++rxi_cnt_;
+			++recv_bytes_;
 		}
 
 		static INTERRUPT_FUNC void txi_task_()
 		{
+			++txi_cnt_;
 			if(send_.length() > 0) {
 				SCI::TDR = send_.get();
+				++send_bytes_;
 			} else {
 				SCI::SCR.TIE = 0;
 				if(FLCT == FLOW_CTRL::RS485) {
@@ -171,10 +229,16 @@ namespace device {
 
 		static inline void tei_task_()
 		{
-			if(send_.length() == 0) {
+			SCI::SCR.TEIE = 0;
+			if constexpr (DMA_SEND) {
+				if(send_dma_len_ == 0 && send_.length() > 0) {  // 送信完了待ちからの起動
+					send_dma_first_();
+					return;
+				}
+			}
+			if(FLCT == FLOW_CTRL::RS485 && send_.length() == 0) {
 				RTS::P = 0;
 			}
-			SCI::SCR.TEIE = 0;
 		}
 
 		static INTERRUPT_FUNC void tei_itask_()
@@ -182,12 +246,176 @@ namespace device {
 			tei_task_();
 		}
 
+		// DMA 再設定の隙間に、要求が CPU に回った場合は、DMA の書き込み位置に格納して、
+		// その次から DMA を再開する
+		static INTERRUPT_FUNC void rxi_dma_task_()
+		{
+			++rxi_cnt_;
+			RECV_DMA dma;
+			dma.stop();
+			uint32_t n = recv_dma_len_ - (dma.get_count() & 0xffff);
+			uint32_t ofs = recv_dma_ofs_ + n;
+			if(ofs >= RBF::size()) ofs = 0;
+			reinterpret_cast<volatile uint8_t*>(recv_dma_org_)[ofs] = SCI::RDR();
+			recv_bytes_ += n + 1;
+			++ofs;
+			if(ofs >= RBF::size()) ofs = 0;
+			recv_dma_start_(ofs);
+		}
+
+		static INTERRUPT_FUNC void txi_dma_task_()
+		{
+			++txi_cnt_;
+			if(send_dma_len_ == 0) {
+				SCI::SCR.TIE = 0;
+			}
+		}
+
+		// 送信バッファの連続領域（ラップアラウンドまで）を DMA 転送
+		static bool send_dma_next_() noexcept
+		{
+			uint32_t len = send_.length();
+			if(len == 0) {
+				send_dma_len_ = 0;
+				return false;
+			}
+			auto get = send_.pos_get();
+			if((get + len) > SBF::size()) {
+				len = SBF::size() - get;
+			}
+			send_dma_len_ = len;
+			SEND_DMA dma;
+			dma.start(SEND_DMA::TRANS_MODE::NORMAL, SEND_DMA::TRANS_TYPE::SP_DN_8, SCI::TXI,
+				reinterpret_cast<uint32_t>(&send_.get_at()), SCI::TDR.address, 0, len, dma_level_);
+			return true;
+		}
+
+		// 最初の１バイトを書き込み、TXI で続きを DMA 転送（送信完了状態で呼ぶ）
+		static void send_dma_first_() noexcept
+		{
+			ICU::IR[SCI::TXI] = 0;
+			if(FLCT == FLOW_CTRL::RS485) {
+				RTS::P = 1;
+			}
+			SCI::TDR = send_.get();
+			++send_bytes_;
+			if(send_dma_next_()) {
+				SCI::SCR.TIE = 1;
+			} else if(FLCT == FLOW_CTRL::RS485) {
+				SCI::SCR.TEIE = 1;
+			}
+		}
+
+		static void send_dma_end_() noexcept
+		{
+			++dma_cnt_;
+			send_.get_go(send_dma_len_);
+			send_bytes_ += send_dma_len_;
+			if(!send_dma_next_()) {
+				SCI::SCR.TIE = 0;
+				if(FLCT == FLOW_CTRL::RS485) {
+					SCI::SCR.TEIE = 1;
+				}
+			}
+		}
+
+		// 受信は、ofs から受信バッファの終端までを DMA で書き込み、終了で先頭に戻る
+		// recv_bytes_ は、現在の DMA より前に受信したバイト数
+		static void recv_dma_start_(uint32_t ofs) noexcept
+		{
+			recv_dma_ofs_ = ofs;
+			recv_dma_len_ = RBF::size() - ofs;
+			++recv_dma_seq_;
+			RECV_DMA dma;
+			dma.start(RECV_DMA::TRANS_MODE::NORMAL, RECV_DMA::TRANS_TYPE::SN_DP_8, SCI::RXI,
+				SCI::RDR.address, recv_dma_org_ + ofs, 0, recv_dma_len_, dma_level_);
+		}
+
+		static void recv_dma_end_() noexcept
+		{
+			++dma_cnt_;
+			RECV_DMA dma;
+			if((dma.get_count() & 0xffff) != 0) return;  // rxi_dma_task_ で再開済み
+			recv_bytes_ += recv_dma_len_;
+			recv_dma_start_(0);
+		}
+
+		// DMA が書き込んだ位置まで、受信バッファの格納ポイントを進める @n
+		// 読み出しが間に合わず、未読の領域まで上書きされた場合は、最新の SIZE-1 バイトを残す
+		static void recv_dma_sync_() noexcept
+		{
+			auto total = recv_total_();
+			uint32_t n = total - recv_sync_;
+			if(n == 0) return;
+			recv_sync_ = total;
+			uint32_t space = RBF::size() - 1 - recv_.length();
+			recv_.put_go(n % RBF::size());
+			if(n > space) {
+				recv_lost_ += n - space;
+				recv_.get_go((recv_.pos_put() + 1 + RBF::size() - recv_.pos_get()) % RBF::size());
+			}
+		}
+
+		static uint32_t recv_total_() noexcept
+		{
+			if constexpr (DMA_RECV) {
+				RECV_DMA dma;
+				uint32_t seq;
+				uint32_t n;
+				do {  // 途中で DMA が再設定された場合は読み直す
+					seq = recv_dma_seq_;
+					n = recv_bytes_ + recv_dma_len_ - (dma.get_count() & 0xffff);
+				} while(seq != recv_dma_seq_);
+				return n;
+			} else {
+				return recv_bytes_;
+			}
+		}
+
+		uint32_t recv_len_() noexcept
+		{
+			if constexpr (DMA_RECV) {
+				recv_dma_sync_();
+			}
+			return recv_.length();
+		}
+
+		// 送信の起動（送信中なら何もしない）
+		void send_kick_() noexcept
+		{
+			if(send_.length() == 0) return;
+
+			if constexpr (DMA_SEND) {
+				if(send_dma_len_ != 0 || SCI::SCR.TEIE() != 0) return;  // DMA 転送中、TEI 待ち
+				// TXI を発生させる為、送信完了で最初の１バイトを書き込む
+				SCI::SCR.TIE = 0;
+				if(SCI::SSR.TEND() == 0) {  // 送信中なら、TEI 割り込みから起動
+					SCI::SCR.TEIE = 1;
+					return;
+				}
+				send_dma_first_();
+			} else {
+				if(SCI::SCR.TIE() == 0) {
+					if(FLCT == FLOW_CTRL::RS485) {
+						RTS::P = 1;
+					}
+					SCI::SCR.TIE = 1;
+					SCI::TDR = send_.get();
+					++send_bytes_;
+				}
+			}
+		}
+
 		void set_intr_(ICU::LEVEL level) noexcept
 		{
 			if(level != ICU::LEVEL::NONE) {
-				icu_mgr::set_interrupt(SCI::RXI, rxi_task_, level);
-				icu_mgr::set_interrupt(SCI::TXI, txi_task_, level);
-				if(FLCT == FLOW_CTRL::RS485) {
+				if constexpr (DMA_RECV) {
+					icu_mgr::set_interrupt(SCI::RXI, rxi_dma_task_, level);
+				} else {
+					icu_mgr::set_interrupt(SCI::RXI, rxi_task_, level);
+				}
+				icu_mgr::set_interrupt(SCI::TXI, DMA_SEND ? txi_dma_task_ : txi_task_, level);
+				if(FLCT == FLOW_CTRL::RS485 || DMA_SEND) {
 					auto gv = icu_mgr::get_group_vector(SCI::TEI);
 					if(gv == ICU::VECTOR::NONE) {
 						icu_mgr::set_interrupt(SCI::TEI, tei_itask_, level);
@@ -207,7 +435,7 @@ namespace device {
 				icu_mgr::set_interrupt(SCI::RXI, nullptr, level);
 				icu_mgr::set_interrupt(SCI::TXI, nullptr, level);
 				icu_mgr::set_interrupt(SCI::ERI, nullptr, level);
-				if(FLCT == FLOW_CTRL::RS485) {
+				if(FLCT == FLOW_CTRL::RS485 || DMA_SEND) {
 					icu_mgr::set_interrupt(SCI::TEI, nullptr, level);
 				}
 			}
@@ -280,6 +508,7 @@ namespace device {
 			orer_cnt_ = 0;
 			fer_cnt_ = 0;
 			per_cnt_ = 0;
+			reset_stat();
 		}
 
 
@@ -323,6 +552,84 @@ namespace device {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	統計情報の取得 @n
+					DMA 受信の場合、受信割り込み回数は数えない（DMA が処理する）
+			@return 統計情報
+		 */
+		//-----------------------------------------------------------------//
+		static stat_t get_stat() noexcept
+		{
+			stat_t t;
+			t.rxi_count = rxi_cnt_;
+			t.txi_count = txi_cnt_;
+			t.dma_count = dma_cnt_;
+			t.recv_bytes = recv_total_();
+			t.recv_lost = recv_lost_;
+			t.send_bytes = send_bytes_;
+			return t;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	統計情報のリセット（DMA 受信中は、受信バイト数をリセットしない）
+		 */
+		//-----------------------------------------------------------------//
+		static void reset_stat() noexcept
+		{
+			rxi_cnt_ = 0;
+			txi_cnt_ = 0;
+			dma_cnt_ = 0;
+			recv_lost_ = 0;
+			if(!DMA_RECV) {
+				recv_bytes_ = 0;
+			}
+			send_bytes_ = 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信アイドル・サービス @n
+					タイマー割り込みなどから一定周期で呼ぶ、受信が無い周期を数える。
+		 */
+		//-----------------------------------------------------------------//
+		static void idle_service() noexcept
+		{
+			auto n = recv_total_();
+			if(n != recv_idle_ref_) {
+				recv_idle_ref_ = n;
+				recv_idle_ = 0;
+			} else if(recv_idle_ < 0xffff) {
+				++recv_idle_;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信アイドル周期数の取得
+			@return 最後の受信からの idle_service 呼び出し回数
+		 */
+		//-----------------------------------------------------------------//
+		static uint16_t get_recv_idle() noexcept { return recv_idle_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	受信アイドルの検査（可変長フレームの区切り）
+			@param[in]	cnt		アイドルと判定する idle_service の周期数
+			@return 受信データがあり、cnt 周期以上受信が無い場合「true」
+		 */
+		//-----------------------------------------------------------------//
+		bool is_recv_idle(uint16_t cnt) noexcept
+		{
+			return recv_idle_ >= cnt && recv_length() > 0;
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	LF 時、CR 自動送出
@@ -408,10 +715,23 @@ namespace device {
 				return false;
 			}
 
+			if((DMA_SEND || DMA_RECV) && level == ICU::LEVEL::NONE) {
+				// DMA 転送では、割り込みを使わない設定は NG
+				return false;
+			}
+
 			level_ = level;
+			dma_level_ = level;
 			stop_ = false;
 			recv_.clear();
 			send_.clear();
+			send_dma_len_ = 0;
+			recv_dma_org_ = reinterpret_cast<uint32_t>(&recv_.put_at());
+			recv_bytes_ = 0;
+			recv_sync_ = 0;
+			recv_lost_ = 0;
+			recv_idle_ = 0;
+			recv_idle_ref_ = 0;
 
 			if(!power_mgr::turn(SCI::PERIPHERAL)) {
 				return false;
@@ -526,6 +846,10 @@ namespace device {
 			if(brr > 0) --brr;
 			SCI::BRR = brr;
 
+			if constexpr (DMA_RECV) {
+				recv_dma_start_(0);
+			}
+
 			if(level != ICU::LEVEL::NONE) {
 				SCI::SCR = SCI::SCR.RIE.b() | SCI::SCR.TE.b() | SCI::SCR.RE.b();
 			} else {
@@ -640,13 +964,7 @@ namespace device {
 					}
 				}
 				send_.put(ch);
-				if(SCI::SCR.TIE() == 0) {
-					if(FLCT == FLOW_CTRL::RS485) {
-						RTS::P = 1;
-					}
-					SCI::SCR.TIE = 1;
-					SCI::TDR = send_.get();
-				}
+				send_kick_();
 			} else {
 				while(SCI::SSR.TEND() == 0) sleep_();
 				SCI::TDR = ch;
@@ -663,7 +981,7 @@ namespace device {
 		uint32_t recv_length() noexcept
 		{
 			if(level_ != ICU::LEVEL::NONE) {
-				return recv_.length();
+				return recv_len_();
 			} else {
 				if(SCI::SSR.ORER()) {	///< 受信オーバランエラー状態確認
 					SCI::SSR.ORER = 0;	///< 受信オーバランエラークリア
@@ -681,7 +999,11 @@ namespace device {
 		void flush_recv() noexcept
 		{
 			if(recv_length() > 0) {
-				recv_.clear();
+				if(DMA_RECV) {  // DMA が書き込み中なので、取得ポイントを進める
+					recv_.get_go(recv_.length());
+				} else {
+					recv_.clear();
+				}
 			}
 		}
 
@@ -695,7 +1017,7 @@ namespace device {
 		char getch() noexcept
 		{
 			if(level_ != ICU::LEVEL::NONE) {  // 割り込み受信
-				while(recv_.length() == 0) {
+				while(recv_len_() == 0) {
 					sleep_();
 				}
 				auto ch = recv_.get();
@@ -727,7 +1049,98 @@ namespace device {
 				putch(ch);
 			}
 		}
-	
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ブロック出力 @n
+					送信バッファの連続領域単位でコピーし、空きが無い場合は待つ。 @n
+					LF の CR 自動送出は行わない。
+			@param[in]	src		転送元
+			@param[in]	len		バイト数
+			@return 書き込んだバイト数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t write(const void* src, uint32_t len) noexcept
+		{
+			if(src == nullptr) return 0;
+
+			auto p = static_cast<const uint8_t*>(src);
+			if(level_ == ICU::LEVEL::NONE) {
+				for(uint32_t i = 0; i < len; ++i) {
+					while(SCI::SSR.TEND() == 0) sleep_();
+					SCI::TDR = p[i];
+				}
+				return len;
+			}
+
+			uint32_t n = 0;
+			while(n < len) {
+				uint32_t space = SBF::size() - 1 - send_.length();
+				if(space == 0) {
+					send_kick_();
+					sleep_();
+					continue;
+				}
+				auto put = send_.pos_put();
+				uint32_t l = len - n;
+				if(l > space) l = space;
+				if((put + l) > SBF::size()) {
+					l = SBF::size() - put;
+				}
+				std::memcpy(&send_.put_at(), p + n, l);
+				send_.put_go(l);
+				n += l;
+				send_kick_();
+			}
+			return n;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ブロック入力（ノンブロック） @n
+					受信バッファの連続領域単位でコピーする。
+			@param[out]	dst		転送先
+			@param[in]	len		最大バイト数
+			@return 読み出したバイト数
+		 */
+		//-----------------------------------------------------------------//
+		uint32_t read(void* dst, uint32_t len) noexcept
+		{
+			if(dst == nullptr) return 0;
+
+			auto p = static_cast<uint8_t*>(dst);
+			uint32_t n = 0;
+			if(level_ == ICU::LEVEL::NONE) {
+				while(n < len && recv_length() > 0) {
+					p[n] = SCI::RDR();
+					++n;
+				}
+				return n;
+			}
+
+			while(n < len) {
+				uint32_t l = recv_len_();
+				if(l == 0) break;
+				auto get = recv_.pos_get();
+				if(l > (len - n)) l = len - n;
+				if((get + l) > RBF::size()) {
+					l = RBF::size() - get;
+				}
+				std::memcpy(p + n, &recv_.get_at(), l);
+				recv_.get_go(l);
+				n += l;
+			}
+			if(FLCT == FLOW_CTRL::HARD || FLCT == FLOW_CTRL::SOFT_HARD) {
+				if(recv_.length() == 0) {
+					RTS::P = 1;
+				}
+			}
+			return n;
+		}
+
+
 		// オペレーターのオーバーロード
 		char operator () () noexcept { return getch(); }
 		void operator = (char ch) noexcept { putch(ch); }
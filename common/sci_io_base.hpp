@@ -4,7 +4,7 @@
 	@brief	RX グループ・SCI I/O 制御ベースクラス @n
 			SCI I/O、SCIF I/O、RSCI I/O 共通定義
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2023 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2023, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -78,5 +78,32 @@ namespace device {
 			SOFT_HARD,	///< ソフトフローとハードフロー制御
 			RS485,		///< ポートを使い、RS485 レシーバーの DE を制御（送信時「1」となる）
 		};
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief	DMAC を使わない場合の型（DMAC チャネル型の代わりに指定）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct NULL_DMAC { };
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief	統計情報型 @n
+					受信、送信バイト数を時間で割るとスループットになる。
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct stat_t {
+			uint32_t	rxi_count;	///< 受信割り込み回数
+			uint32_t	txi_count;	///< 送信割り込み回数
+			uint32_t	dma_count;	///< DMA 終了割り込み回数
+			uint32_t	recv_bytes;	///< 受信バイト数
+			uint32_t	send_bytes;	///< 送信バイト数
+			uint32_t	recv_lost;	///< DMA 受信で、読み出しが間に合わず上書きされたバイト数
+
+			stat_t() noexcept : rxi_count(0), txi_count(0), dma_count(0), recv_bytes(0), send_bytes(0),
+				recv_lost(0) { }
+		};
 	};
 }
@@ -6,9 +6,11 @@
 			・ls [-l] [file] @n
 			・pwd @n
 			・cd [file] @n
-			・free
+			・free @n
+			コマンドの分岐は command_dispatch（完全ハッシュ）で行い、 @n
+			TAB キーでコマンド名を補完出来る（complete）。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2019, 2020 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2019, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -16,6 +18,7 @@
 #include "common/file_io.hpp"
 #include "common/format.hpp"
 #include "common/string_utils.hpp"
+#include "common/command_dispatch.hpp"
 
 namespace utils {
 
@@ -45,6 +48,83 @@ namespace utils {
 			cmd_.set_prompt(prompt_);
 		}
 
+		// オプション（'-' で始まる単語）と、パスの位置
+		static void scan_args_(const CMD& cmd, uint32_t& opt, uint32_t& path) noexcept
+		{
+			opt = 0;
+			path = 0;
+			for(uint32_t n = 1; n < cmd.get_words(); ++n) {
+				if(cmd.get_argv(n)[0] == '-') opt = n;
+				else path = n;
+			}
+		}
+
+		static void ls_(shell& sh, const CMD& cmd) noexcept
+		{
+			uint32_t opt;
+			uint32_t path;
+			scan_args_(cmd, opt, path);
+			bool ll = false;
+			if(opt > 0 && cmd.cmp_word(opt, "-l")) ll = true;
+			if(path == 0) {
+				char tmp[utils::file_io::PATH_MAX_SIZE];
+				if(!utils::file_io::pwd(tmp, sizeof(tmp))) {
+					sh.state_ = false;
+				} else {
+					sh.state_ = utils::file_io::dir(tmp, ll);
+				}
+			} else {
+				sh.state_ = utils::file_io::dir(cmd.get_argv(path), ll);
+			}
+		}
+
+		static void pwd_(shell& sh, const CMD& cmd) noexcept
+		{
+			char tmp[utils::file_io::PATH_MAX_SIZE];
+			if(!utils::file_io::pwd(tmp, sizeof(tmp))) {
+				sh.state_ = false;
+			} else {
+				utils::format("%s\n") % tmp;
+				sh.make_prompt_();
+			}
+		}
+
+		static void cd_(shell& sh, const CMD& cmd) noexcept
+		{
+			uint32_t opt;
+			uint32_t path;
+			scan_args_(cmd, opt, path);
+			const char* tmp = path == 0 ? "/" : cmd.get_argv(path);
+			sh.state_ = utils::file_io::cd(tmp);
+			if(sh.state_) {
+				sh.make_prompt_();
+			} else {
+				utils::format("Illegal file path: '%s'\n") % tmp; 
+			}
+		}
+
+		static void free_(shell& sh, const CMD& cmd) noexcept
+		{
+			uint32_t fre;
+			uint32_t max;
+			if(utils::file_io::get_free_space(fre, max)) {
+				uint32_t rate = fre * 1000 / max;
+				utils::format("%u/%u [KB] (%u.%u%%)\n")
+					% fre % max % (rate / 10) % (rate % 10);
+				sh.state_ = true;
+			} else {
+				sh.state_ = false;
+			}
+		}
+
+		static constexpr command_entry<shell, CMD> cmds_[] = {
+			{ "ls",   "[-l] [file]", "list current directory (-l: long)", ls_ },
+			{ "pwd",  nullptr,       "current directory path",            pwd_ },
+			{ "cd",   "[file]",      "change current directory",          cd_ },
+			{ "free", nullptr,       "list disk space",                   free_ },
+		};
+		static constexpr auto disp_ = make_command_dispatch(cmds_);
+
 	public:
         //-----------------------------------------------------------------//
         /*!
@@ -85,71 +165,25 @@ namespace utils {
 				make_prompt_("/");
 			}
 
-			auto cmdn = cmd_.get_words();
-			if(cmdn >= 1) {
-
-				int opt = 0;
-				int path = 0;
-				for(uint32_t n = 1; n < cmd_.get_words(); ++n) {
-					char tmp[16];
-					cmd_.get_word(n, tmp, sizeof(tmp));
-					if(tmp[0] == '-') opt = n;
-					else path = n;
-				}
-
-                if(cmd_.cmp_word(0, "ls")) {  // ls [xxx]
-					char tmp[utils::file_io::PATH_MAX_SIZE];
-					bool ll = false;
-					if(opt > 0 && cmd_.cmp_word(opt, "-l")) ll = true;
-					if(path == 0) {
-						if(!utils::file_io::pwd(tmp, sizeof(tmp))) {
-							state_ = false;
-						} else {
-							state_ = utils::file_io::dir(tmp, ll);
-						}
-					} else {
-						cmd_.get_word(path, tmp, sizeof(tmp));
-						state_ = utils::file_io::dir(tmp, ll);
-					}
-				} else if(cmd_.cmp_word(0, "pwd")) {  // pwd
-					char tmp[utils::file_io::PATH_MAX_SIZE];
-					if(!utils::file_io::pwd(tmp, sizeof(tmp))) {
-						state_ = false;
-					} else {
-						utils::format("%s\n") % tmp;
-						make_prompt_();
-					}
-				} else if(cmd_.cmp_word(0, "cd")) {  // cd [xxx]
-					char tmp[utils::file_io::PATH_MAX_SIZE];
-					if(path == 0) {
-						strcpy(tmp, "/");
-					} else {
-						cmd_.get_word(1, tmp, sizeof(tmp));
-					}
-					state_ = utils::file_io::cd(tmp);
-					if(state_) {
-						make_prompt_();
-					} else {
-						utils::format("Illegal file path: '%s'\n") % tmp; 
-					}
-				} else if(cmd_.cmp_word(0, "free")) {  // free
-					uint32_t fre;
-					uint32_t max;
-					if(utils::file_io::get_free_space(fre, max)) {
-						uint32_t rate = fre * 1000 / max;
-						utils::format("%u/%u [KB] (%u.%u%%)\n")
-							% fre % max % (rate / 10) % (rate % 10);
-						state_ = true;
-					} else {
-						state_ = false;
-					}
-				} else {
-					return false;
-				}
-			} else {
+			if(cmd_.get_words() == 0) {
 				make_prompt_();
+				return true;
 			}
-			return true;
+			return disp_.exec(*this, cmd_);
+		}
+
+
+        //-----------------------------------------------------------------//
+        /*!
+            @brief  コマンド名の TAB 補完 @n
+					cmd.service() が「false」を返した時に呼ぶ。
+			@return 補完した場合「true」
+        */
+        //-----------------------------------------------------------------//
+		bool complete() noexcept
+		{
+			if(!cmd_.probe_tab()) return false;
+			return disp_.complete(cmd_);
 		}
 
 
@@ -161,25 +195,7 @@ namespace utils {
         */
         //-----------------------------------------------------------------//
 		void help(int spc0 = 4, int spc1 = 20) const {
-			struct str_t {
-				const char*	cmd;
-				const char*	text;
-			};
-			static const str_t t[] = {
-				{ "ls [-l] [file]", "list current directory (-l: long)" },
-				{ "pwd",      "current directory path" },
-				{ "cd [file]", "change current directory" },
-				{ "free",     "list disk space" },
-			};
-			for(uint32_t i = 0; i < std::size(t); ++i) {
-				for(int n = 0; n < spc0; ++n) {
-					utils::format(" ");
-				}
-				utils::format("%s") % t[i].cmd;
-				int n = strlen(t[i].cmd);
-				while(n < spc1) { utils::format(" "); ++n; }
-				utils::format("%s\n") % t[i].text;
-			}
+			disp_.help(spc0, spc1);
 		}
 	};
 }
@@ -3,7 +3,7 @@
 /*!	@file
 	@brief	文字列操作ユーティリティー
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2016, 2021 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2016, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -16,6 +16,9 @@
 #include "common/time.h"
 #include "common/format.hpp"
 #include "common/input.hpp"
+#if defined(FF_CODE_PAGE) && FF_CODE_PAGE == 932
+#include "common/cp932.hpp"
+#endif
 
 /// string, vector が使える環境
 // #define STRING_VECTOR
@@ -271,7 +274,8 @@ namespace utils {
 #if FF_USE_LFN != 0
 		//-----------------------------------------------------------------//
 		/*!
-			@brief  OEM code から UTF-8 への変換
+			@brief  OEM code から UTF-8 への変換 @n
+					CP932 の場合は、utils::cp932（直接参照テーブル）を使う。
 			@param[in]	src	ソース
 			@param[in]	dst	変換先
 			@param[in]	dsz	変換先のサイズ
@@ -280,6 +284,9 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		static bool oemc_to_utf8(const char* src, char* dst, uint32_t dsz) noexcept
 		{
+#if FF_CODE_PAGE == 932
+			return cp932::to_utf8(src, dst, dsz);
+#else
 			if(src == nullptr) return false;
 
 			uint16_t wc = 0;
@@ -316,12 +323,14 @@ namespace utils {
 			}
 			*dst = 0;
 			return dsz > 0;
+#endif
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief  UTF-8 から OEM code への変換
+			@brief  UTF-8 から OEM code への変換 @n
+					CP932 の場合は、utils::cp932（直接参照テーブル）を使う。
 			@param[in]	src	ソース
 			@param[out]	dst	変換先
 			@param[in]	dsz	変換先のサイズ
@@ -330,6 +339,9 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		static bool utf8_to_oemc(const char* src, char* dst, uint32_t dsz) noexcept
 		{
+#if FF_CODE_PAGE == 932
+			return cp932::from_utf8(src, dst, dsz);
+#else
 			int8_t cnt = 0;
 			uint16_t code = 0;
 			char tc;
@@ -368,6 +380,7 @@ namespace utils {
 			}
 			*dst = 0;
 			return dsz > 0;
+#endif
 		}
 #endif
 
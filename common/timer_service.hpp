@@ -0,0 +1,510 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	ソフトウェア・タイマー・サービス（CMT/CMTW） @n
+			・utils::timer_wheel を、cmt_mgr/cmtw_mgr のコンペア・マッチで進める。 @n
+			・ワンショット、周期のコールバックを、メインループの service() から呼ぶ。 @n
+			  （割り込みは、ティックを数えるだけ） @n
+			・ティックレス・モードでは、コンペア・マッチを次のイベントに合わせて @n
+			  設定し直し、その間は idle() で CPU を止める（スリープ・モード）。 @n
+			  CMT（16 ビット）は、一回に 65536 カウントまで、長く眠れるように @n
+			  大きい分周比を選ぶ。 @n
+			・コールバックの遅れ（期限からの時間）と、周期タイマーのジッター @n
+			  （遅れの変化）を、カウンターの値で測る。 @n
+			※ソフトウェア・スタンバイでは CMT が止まるので、使わない事。 @n
+			※タイマーの操作は、割り込みからは行わない事。 @n
+			例： @n
+				typedef device::timer_service<device::CMT1> TIMER; @n
+				TIMER	timer_; @n
+				timer_.start(1000, device::ICU::LEVEL::_4, true); @n
+				timer_.add_periodic(500, task, nullptr); @n
+				while(1) { timer_.service(); timer_.idle(); }
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <type_traits>
+#include "common/cmt_mgr.hpp"
+#include "common/cmtw_mgr.hpp"
+#include "common/timer_wheel.hpp"
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  タイマー・サービス・クラス
+		@param[in]	CMT			チャネル・クラス（CMT 又は CMTW）
+		@param[in]	TIMER_MAX	同時に登録できるタイマーの最大数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <class CMT, uint32_t TIMER_MAX = 16>
+	class timer_service : public utils::timer_wheel_def {
+	public:
+
+		typedef utils::timer_wheel<TIMER_MAX> WHEEL;	///< ホイール型
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  サービスの統計（時間はカウンターのカウント）
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct stat_t {
+			uint32_t	wakeups;	///< コンペア・マッチ割り込みの回数
+			uint32_t	services;	///< service() の回数
+			uint32_t	fired;		///< 呼んだコールバックの数
+			uint32_t	late_max;	///< 最大の遅れ
+			uint32_t	late_avg;	///< 平均の遅れ
+			uint32_t	jitter_max;	///< 周期タイマーの最大ジッター
+			uint32_t	span_max;	///< 最長のコンペア周期（ティック）
+		};
+
+	private:
+		// CMTW（CMWCNT を持つ）か？
+		template <class T, class = void>
+		struct is_cmtw_ : std::false_type { };
+		template <class T>
+		struct is_cmtw_<T, std::void_t<decltype(T::CMWCNT)>> : std::true_type { };
+
+		static constexpr bool CMTW = is_cmtw_<CMT>::value;
+
+		// コンペア値を、今のカウントからこれより近くに置かない（書く前に過ぎる）
+		static constexpr uint32_t GUARD = 4;
+
+		static inline volatile uint32_t tick_;	// 最後のコンペア・マッチまでのティック
+		static inline volatile uint32_t span_;	// 今のコンペア周期（ティック）
+		static inline volatile uint32_t wakeups_;
+
+		struct task_t {
+			void operator() () noexcept
+			{
+				tick_ = tick_ + span_;
+				wakeups_ = wakeups_ + 1;
+			}
+		};
+
+		typedef std::conditional_t<CMTW, cmtw_mgr<CMT, task_t>, cmt_mgr<CMT, task_t>> MGR;
+
+		MGR			mgr_;
+		WHEEL		wheel_;
+		uint32_t	per_;		// ティック当たりのカウント
+		uint32_t	guard_;
+		uint32_t	span_lim_;	// 設定できる最長のコンペア周期（ティック）
+		uint32_t	rate_;
+		uint32_t	seen_;		// service() の最後に見た wakeups_
+		ICU::VECTOR	vec_;		// コンペア・マッチ割り込みのベクター（IR の確認用）
+		uint8_t		cks_;
+		bool		tickless_;
+		bool		in_service_;
+
+		uint64_t	late_sum_;
+		stat_t		stat_;
+
+		static uint32_t lock_() noexcept
+		{
+#ifdef __RX__
+			uint32_t psw;
+			asm volatile ("mvfc psw,%0\n\tclrpsw i" : "=r"(psw) : : "memory");
+			return psw;
+#else
+			return 0;
+#endif
+		}
+
+		static void unlock_(uint32_t psw) noexcept
+		{
+#ifdef __RX__
+			asm volatile ("mvtc %0,psw" : : "r"(psw) : "memory");
+#else
+			(void)psw;
+#endif
+		}
+
+		static uint32_t count_() noexcept
+		{
+			if constexpr (CMTW) return CMT::CMWCNT();
+			else return CMT::CMCNT();
+		}
+
+		static void compare_(uint32_t n) noexcept
+		{
+			if constexpr (CMTW) CMT::CMWCOR = n;
+			else CMT::CMCOR = n;
+		}
+
+		static constexpr uint32_t count_limit_() noexcept
+		{
+			return CMTW ? 0xffff'ffff : 0x1'0000;
+		}
+
+		static constexpr uint32_t count_clock_(uint8_t cks) noexcept
+		{
+			return CMT::PCLK / (8 << (cks * 2));
+		}
+
+		// 選択型割り込み（CMT2、CMT3 など）は、割り当てられたベクターを探す @n
+		// （SLIBR が無いデバイスもあるので、I に依存させる）
+		template <class I = ICU>
+		static ICU::VECTOR find_vector_() noexcept
+		{
+			if constexpr (CMTW) {
+				return CMT::CMWI;
+			} else if constexpr (std::is_same_v<std::remove_cv_t<decltype(CMT::CMI)>, ICU::VECTOR>) {
+				return CMT::CMI;
+			} else {
+				for(uint16_t i = 128; i < 256; ++i) {  // 選択型は、ベクター 128 以降
+					auto vec = static_cast<ICU::VECTOR>(i);
+					if(I::SLIBR[vec] == CMT::CMI) return vec;
+				}
+				return ICU::VECTOR::NONE;
+			}
+		}
+
+		// 割り込みを止めて、カウンターを読む @n
+		// コンペア・マッチが保留（ISR が、まだ tick_ を進めていない）なら、ここで進める
+		uint32_t lock_count_(uint32_t& cnt) const noexcept
+		{
+			auto psw = lock_();
+			cnt = count_();
+			if(ICU::IR[vec_] != 0) {
+				ICU::IR[vec_] = 0;
+				tick_ = tick_ + span_;
+				wakeups_ = wakeups_ + 1;
+				cnt = count_();  // 一致の後のカウント
+			}
+			return psw;
+		}
+
+		// カウント単位の時刻（32 ビットで一周する）
+		uint32_t get_count_time_() const noexcept
+		{
+			uint32_t cnt;
+			auto psw = lock_count_(cnt);
+			auto t = tick_ * per_ + cnt;
+			unlock_(psw);
+			return t;
+		}
+
+		// 次のイベントに、コンペア・マッチを合わせる
+		void reprogram_() noexcept
+		{
+			auto d = wheel_.next();
+			uint32_t cnt;
+			auto psw = lock_count_(cnt);
+			auto k = span_lim_;
+			if(d != TICK_NONE) {
+				auto rel = wheel_.get_now() + d - tick_;
+				if(rel >= 0x8000'0000) rel = 0;  // 過ぎている
+				if(rel < k) k = rel;
+			}
+			auto cur = cnt / per_;
+			if(k <= cur) k = cur + 1;
+			if((k * per_ - 1) < (cnt + guard_)) ++k;
+			if(k <= span_lim_) {
+				compare_(k * per_ - 1);
+				span_ = k;
+				if(k > stat_.span_max) stat_.span_max = k;
+			}
+			unlock_(psw);
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		timer_service() noexcept : mgr_(), wheel_(), per_(1), guard_(0), span_lim_(1), rate_(0),
+			seen_(0), vec_(ICU::VECTOR::NONE), cks_(0),
+			tickless_(false), in_service_(false), late_sum_(0), stat_() { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  開始
+			@param[in]	freq		ティックの周波数 [Hz]
+			@param[in]	level		割り込みレベル（NONE は不可）
+			@param[in]	tickless	ティックレス・モードの場合「true」
+			@return 周波数が範囲を超えた場合「false」を返す
+		*/
+		//-----------------------------------------------------------------//
+		bool start(uint32_t freq, ICU::LEVEL level, bool tickless = false) noexcept
+		{
+			if(freq == 0 || level == ICU::LEVEL::NONE) return false;
+
+			// CMT は、誤差 1% 以内で最も大きい分周比（長く眠れる） @n
+			// CMTW は、最も小さい分周比（分解能が高い）
+			uint32_t per = 0;
+			uint8_t cks = 0;
+			for(uint8_t i = 0; i < 4; ++i) {
+				uint8_t n = CMTW ? i : (3 - i);
+				auto p = (count_clock_(n) + freq / 2) / freq;
+				if(p >= 100 && p <= count_limit_()) {
+					per = p;
+					cks = n;
+					break;
+				}
+			}
+			if(per == 0) {
+				per = (count_clock_(0) + freq / 2) / freq;
+				if(per == 0 || per > count_limit_()) return false;
+			}
+
+			per_ = per;
+			guard_ = per > (GUARD * 2) ? GUARD : 0;
+			cks_ = cks;
+			span_lim_ = tickless ? (count_limit_() / per) : 1;
+			if(span_lim_ > WHEEL::RANGE) span_lim_ = WHEEL::RANGE;
+			tickless_ = tickless;
+			rate_ = freq;
+
+			tick_ = 0;
+			span_ = 1;
+			wakeups_ = 0;
+			seen_ = 0;
+			wheel_.reset();
+			late_sum_ = 0;
+			stat_ = stat_t { };
+
+			bool ret;
+			if constexpr (CMTW) {
+				ret = mgr_.start(static_cast<typename MGR::DIRECT>(per),
+					static_cast<typename MGR::DIVIDE>(cks), level);
+			} else {
+				ret = mgr_.start(static_cast<typename MGR::DIRECT>(per - 1),
+					static_cast<typename MGR::DIVIDE>(cks), level);
+			}
+			vec_ = find_vector_();
+			return ret;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  廃棄（タイマーも全て取り消す）
+			@param[in]	power	消費電力を低減しない場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		void destroy(bool power = false) noexcept
+		{
+			mgr_.destroy(power);
+			wheel_.reset();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  現在のティックを取得
+			@return ティック
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_tick() const noexcept
+		{
+			uint32_t cnt;
+			auto psw = lock_count_(cnt);
+			auto t = tick_ + cnt / per_;
+			unlock_(psw);
+			return t;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ワンショット・タイマーを登録
+			@param[in]	delay	期限までのティック（０なら次のティック）
+			@param[in]	task	コールバック（service() から呼ばれる）
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return タイマー ID（空きが無い場合 ID_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t add(uint32_t delay, TASK task, void* ctx = nullptr) noexcept
+		{
+			return add_periodic(delay, task, ctx, 0);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  周期タイマーを登録
+			@param[in]	period	周期（ティック）
+			@param[in]	task	コールバック（service() から呼ばれる）
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@param[in]	first	最初の期限までのティック（０なら周期と同じ）
+			@return タイマー ID（空きが無い場合 ID_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t add_periodic(uint32_t period, TASK task, void* ctx = nullptr, uint32_t first = 0) noexcept
+		{
+			uint32_t delay = first != 0 ? first : period;
+			if(delay == 0) delay = 1;
+			// コールバックの中では、ホイールの時刻、外では今の時刻から数える
+			auto base = in_service_ ? wheel_.get_now() : get_tick();
+			auto id = wheel_.add_at(base + delay, period, task, ctx);
+			if(id != ID_NONE && tickless_ && !in_service_) {
+				reprogram_();
+			}
+			return id;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイマーを取り消す
+			@param[in]	id	タイマー ID
+			@return 登録されていない（終了済み）場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool cancel(uint32_t id) noexcept { return wheel_.cancel(id); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイマーが登録されているか？
+			@param[in]	id	タイマー ID
+			@return 登録されていれば「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool is_active(uint32_t id) const noexcept { return wheel_.is_active(id); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  サービス（メインループから呼ぶ） @n
+					期限になったタイマーのコールバックを呼び、ティックレス・ @n
+					モードでは、次のイベントにコンペア・マッチを合わせる。
+			@return 呼んだコールバックの数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t service() noexcept
+		{
+			++stat_.services;
+			stat_.wakeups = wakeups_;
+			auto fired = stat_.fired;
+
+			in_service_ = true;
+			auto d = get_tick() - wheel_.get_now();
+			if(d >= 0x8000'0000) d = 0;  // ホイールが先（負）なら進めない
+			wheel_.advance(d, [this](uint32_t expire, uint32_t period, uint32_t& user) {
+				auto late = get_count_time_() - expire * per_;
+				if(late >= 0x8000'0000) late = 0;
+				++stat_.fired;
+				late_sum_ += late;
+				if(late > stat_.late_max) stat_.late_max = late;
+				if(period != 0) {
+					if(user != TICK_NONE) {
+						auto j = late > user ? (late - user) : (user - late);
+						if(j > stat_.jitter_max) stat_.jitter_max = j;
+					}
+					user = late;
+				}
+			});
+			in_service_ = false;
+			if(stat_.fired != fired) {
+				stat_.late_avg = late_sum_ / stat_.fired;
+			}
+
+			if(tickless_) {
+				reprogram_();
+			}
+			seen_ = wakeups_;
+			return stat_.fired - fired;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  次の割り込みまで CPU を止める（スリープ・モード） @n
+					service() の後にコンペア・マッチがあった場合は、止めずに戻る。 @n
+					（割り込みを止めて確かめ、WAIT で割り込みを許可する） @n
+					※他の割り込みでも起きる。
+		*/
+		//-----------------------------------------------------------------//
+		void idle() const noexcept
+		{
+			auto psw = lock_();
+			if(wakeups_ == seen_ && ICU::IR[vec_] == 0) {
+#ifdef __RX__
+				asm volatile ("wait" : : : "memory");
+#endif
+			}
+			unlock_(psw);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ティックの周波数を取得
+			@param[in]	real	「true」にした場合、実際の値
+			@return 周波数 [Hz]
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_rate(bool real = false) const noexcept
+		{
+			if(real) {
+				return count_clock_(cks_) / per_;
+			} else {
+				return rate_;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  カウンターの周波数を取得（統計の時間の単位）
+			@return 周波数 [Hz]
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_count_rate() const noexcept { return count_clock_(cks_); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  カウントを、マイクロ秒に変換
+			@param[in]	cnt		カウント
+			@return マイクロ秒
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t count_to_usec(uint32_t cnt) const noexcept
+		{
+			return static_cast<uint64_t>(cnt) * 1'000'000 / count_clock_(cks_);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  統計を取得
+			@return 統計
+		*/
+		//-----------------------------------------------------------------//
+		const stat_t& get_stat() const noexcept { return stat_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  統計をクリア
+		*/
+		//-----------------------------------------------------------------//
+		void clear_stat() noexcept
+		{
+			stat_ = stat_t { };
+			late_sum_ = 0;
+			// service() がまだ見ていない割り込みは残す（idle() が眠らない様に）
+			auto psw = lock_();
+			wakeups_ = wakeups_ - seen_;
+			seen_ = 0;
+			unlock_(psw);
+			wheel_.clear_stat();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  ホイールの参照
+			@return ホイール
+		*/
+		//-----------------------------------------------------------------//
+		const WHEEL& get_wheel() const noexcept { return wheel_; }
+	};
+}
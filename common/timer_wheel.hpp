@@ -0,0 +1,467 @@
+#pragma once
+//=========================================================================//
+/*!	@file
+	@brief	階層タイマー・ホイール（ソフトウェア・タイマー） @n
+			・32 スロット × 5 段のホイールで、2^25 ティック先まで直接置ける。 @n
+			  それより先のタイマーは、最上段のカスケード時に置き直す。 @n
+			・タイマーは固定数のプールに置き、双方向リストで繋ぐので、 @n
+			  登録、取り消しは O(1) で行える。 @n
+			・各段のスロットの使用状況をビットマップで持ち、次のイベント @n
+			  （期限、又はカスケード）までのティック数を O(1) で求める。 @n
+			  advance() は、イベントの無い区間を飛ばして進める。 @n
+			・周期タイマーは期限を周期で進める（遅れが積み重ならない）。 @n
+			  advance() の範囲で取り残した周期は、まとめて呼ばずに飛ばす。 @n
+			・ティックの元（ハードウェア）は持たない（device::timer_service 参照）。 @n
+			※割り込みからは操作しない事。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdint>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  タイマー・ホイール定義
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct timer_wheel_def {
+
+		static constexpr uint32_t ID_NONE   = 0;			///< 無効な ID
+		static constexpr uint32_t TICK_NONE = 0xffff'ffff;	///< イベントが無い
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  タイマー・コールバック
+			@param[in]	id	タイマー ID
+			@param[in]	ctx	登録時のコンテキスト
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		typedef void (*TASK)(uint32_t id, void* ctx);
+
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  ホイールの統計
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct stat_t {
+			uint32_t	fired;		///< 呼んだコールバックの数
+			uint32_t	overruns;	///< 周期タイマーで飛ばした周期の数
+			uint32_t	cascades;	///< 下の段に置き直したタイマーの数
+			uint32_t	steps;		///< スロットを処理したティック数
+			uint32_t	skips;		///< 飛ばしたティック数
+		};
+	};
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  階層タイマー・ホイール・クラス
+		@param[in]	TIMER_MAX	同時に登録できるタイマーの最大数
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t TIMER_MAX>
+	class timer_wheel : public timer_wheel_def {
+
+		static_assert(TIMER_MAX > 0 && TIMER_MAX < 255, "TIMER_MAX out of range");
+
+	public:
+		static constexpr uint32_t SLOT_BITS = 5;					///< 一段のスロット数（ビット）
+		static constexpr uint32_t SLOT_NUM  = 1 << SLOT_BITS;		///< 一段のスロット数
+		static constexpr uint32_t LEVEL_NUM = 5;					///< 段数
+		static constexpr uint32_t RANGE = 1 << (SLOT_BITS * LEVEL_NUM);	///< 直接置ける範囲（ティック）
+
+	private:
+		static constexpr uint8_t IDX_NONE = 0xff;
+		static constexpr uint8_t LIST_DUE = LEVEL_NUM * SLOT_NUM;	// 期限になったタイマー
+		static constexpr uint32_t LIST_NUM = LIST_DUE + 1;
+
+		struct node_t {
+			TASK		task;
+			void*		ctx;
+			uint32_t	expire;		// 期限（ティック）
+			uint32_t	period;		// 周期（０ならワンショット）
+			uint32_t	user;		// advance() のフックが使う値
+			uint16_t	gen;
+			uint8_t		next;
+			uint8_t		prev;
+			uint8_t		list;		// IDX_NONE なら未使用
+		};
+
+		node_t		node_[TIMER_MAX];
+		uint8_t		head_[LIST_NUM];
+		uint32_t	map_[LEVEL_NUM];
+		uint8_t		free_;
+		uint16_t	gen_;
+		uint32_t	num_;
+		uint32_t	now_;
+		uint32_t	end_;
+		stat_t		stat_;
+
+		static uint32_t rotr_(uint32_t m, uint32_t s) noexcept
+		{
+			s &= 31;
+			return s != 0 ? ((m >> s) | (m << (32 - s))) : m;
+		}
+
+		void link_(uint8_t idx, uint8_t list) noexcept
+		{
+			auto& n = node_[idx];
+			n.list = list;
+			n.prev = IDX_NONE;
+			n.next = head_[list];
+			if(n.next != IDX_NONE) node_[n.next].prev = idx;
+			head_[list] = idx;
+			if(list < LIST_DUE) {
+				map_[list / SLOT_NUM] |= 1 << (list % SLOT_NUM);
+			}
+		}
+
+		void unlink_(uint8_t idx) noexcept
+		{
+			auto& n = node_[idx];
+			if(n.prev != IDX_NONE) {
+				node_[n.prev].next = n.next;
+			} else {
+				head_[n.list] = n.next;
+			}
+			if(n.next != IDX_NONE) node_[n.next].prev = n.prev;
+			if(n.list < LIST_DUE && head_[n.list] == IDX_NONE) {
+				map_[n.list / SLOT_NUM] &= ~(1 << (n.list % SLOT_NUM));
+			}
+		}
+
+		void release_(uint8_t idx) noexcept
+		{
+			auto& n = node_[idx];
+			n.list = IDX_NONE;
+			n.next = free_;
+			free_ = idx;
+			--num_;
+		}
+
+		// 期限までの距離で段を決め、期限のビットでスロットを決める
+		void place_(uint8_t idx) noexcept
+		{
+			const auto& n = node_[idx];
+			auto d = n.expire - now_;
+			if(d == 0 || d >= 0x8000'0000) {
+				link_(idx, LIST_DUE);
+				return;
+			}
+			auto t = n.expire;
+			if(d >= RANGE) {  // 最上段に置き、カスケードの時に置き直す
+				d = RANGE - 1;
+				t = now_ + d;
+			}
+			uint32_t lv = 0;
+			while(d >= (1u << (SLOT_BITS * (lv + 1)))) ++lv;
+			auto slot = (t >> (SLOT_BITS * lv)) & (SLOT_NUM - 1);
+			link_(idx, lv * SLOT_NUM + slot);
+		}
+
+		// 一つのスロットを、置き直す（カスケード）
+		void cascade_(uint32_t lv) noexcept
+		{
+			auto list = lv * SLOT_NUM + ((now_ >> (SLOT_BITS * lv)) & (SLOT_NUM - 1));
+			while(head_[list] != IDX_NONE) {
+				auto idx = head_[list];
+				unlink_(idx);
+				place_(idx);
+				++stat_.cascades;
+			}
+		}
+
+		// １ティック進め、上の段からカスケードして、期限のスロットを取り出す
+		void step_() noexcept
+		{
+			++now_;
+			++stat_.steps;
+			for(uint32_t lv = LEVEL_NUM - 1; lv > 0; --lv) {
+				if((now_ & ((1u << (SLOT_BITS * lv)) - 1)) == 0) {
+					cascade_(lv);
+				}
+			}
+			auto list = now_ & (SLOT_NUM - 1);
+			while(head_[list] != IDX_NONE) {
+				auto idx = head_[list];
+				unlink_(idx);
+				link_(idx, LIST_DUE);
+			}
+		}
+
+		template <class HOOK>
+		void run_due_(HOOK& hook) noexcept
+		{
+			while(head_[LIST_DUE] != IDX_NONE) {
+				auto idx = head_[LIST_DUE];
+				unlink_(idx);
+				auto& n = node_[idx];
+				auto id = make_id_(idx);
+				auto task = n.task;
+				auto ctx = n.ctx;
+				hook(n.expire, n.period, n.user);
+				if(n.period != 0) {
+					n.expire += n.period;
+					auto late = end_ - n.expire;
+					if(late != 0 && late < 0x8000'0000) {  // 取り残した周期は、まとめて呼ばずに飛ばす
+						auto k = (late - 1) / n.period + 1;
+						n.expire += k * n.period;
+						stat_.overruns += k;
+					}
+					place_(idx);
+				} else {
+					release_(idx);
+				}
+				++stat_.fired;
+				if(task != nullptr) task(id, ctx);
+			}
+		}
+
+		uint32_t make_id_(uint8_t idx) const noexcept
+		{
+			return (static_cast<uint32_t>(node_[idx].gen) << 8) | (idx + 1);
+		}
+
+		bool find_(uint32_t id, uint8_t& idx) const noexcept
+		{
+			auto i = (id & 0xff) - 1;
+			if(i >= TIMER_MAX) return false;
+			if(node_[i].list == IDX_NONE || node_[i].gen != (id >> 8)) return false;
+			idx = i;
+			return true;
+		}
+
+		struct null_hook_ {
+			void operator() (uint32_t expire, uint32_t period, uint32_t& user) noexcept { }
+		};
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		timer_wheel() noexcept : gen_(0), now_(0), end_(0) { reset(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  リセット（全てのタイマーを取り消す）
+			@param[in]	now		現在のティック
+		*/
+		//-----------------------------------------------------------------//
+		void reset(uint32_t now = 0) noexcept
+		{
+			for(uint32_t i = 0; i < LIST_NUM; ++i) head_[i] = IDX_NONE;
+			for(uint32_t i = 0; i < LEVEL_NUM; ++i) map_[i] = 0;
+			for(uint32_t i = 0; i < TIMER_MAX; ++i) {
+				node_[i].list = IDX_NONE;
+				node_[i].next = (i + 1) < TIMER_MAX ? (i + 1) : IDX_NONE;
+			}
+			free_ = 0;
+			num_ = 0;
+			now_ = now;
+			end_ = now;
+			stat_ = stat_t { };
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイマーを登録（期限を指定）
+			@param[in]	expire	期限（ティック、現在より先）
+			@param[in]	period	周期（ティック、０ならワンショット）
+			@param[in]	task	コールバック
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return タイマー ID（空きが無い場合 ID_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t add_at(uint32_t expire, uint32_t period, TASK task, void* ctx = nullptr) noexcept
+		{
+			if(free_ == IDX_NONE) return ID_NONE;
+
+			auto idx = free_;
+			auto& n = node_[idx];
+			free_ = n.next;
+			++num_;
+			++gen_;
+			n.task = task;
+			n.ctx = ctx;
+			n.expire = expire;
+			n.period = period;
+			n.user = TICK_NONE;
+			n.gen = gen_;
+			place_(idx);
+			return make_id_(idx);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイマーを登録
+			@param[in]	delay	最初の期限までのティック（０なら次のティック）
+			@param[in]	period	周期（ティック、０ならワンショット）
+			@param[in]	task	コールバック
+			@param[in]	ctx		コールバックに渡すコンテキスト
+			@return タイマー ID（空きが無い場合 ID_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t add(uint32_t delay, uint32_t period, TASK task, void* ctx = nullptr) noexcept
+		{
+			if(delay == 0) delay = 1;
+			return add_at(now_ + delay, period, task, ctx);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイマーを取り消す（コールバックの中からも呼べる）
+			@param[in]	id	タイマー ID
+			@return 登録されていない（終了済み）場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool cancel(uint32_t id) noexcept
+		{
+			uint8_t idx;
+			if(!find_(id, idx)) return false;
+
+			unlink_(idx);
+			release_(idx);
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  タイマーが登録されているか？
+			@param[in]	id	タイマー ID
+			@return 登録されていれば「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool is_active(uint32_t id) const noexcept
+		{
+			uint8_t idx;
+			return find_(id, idx);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  期限までのティック数を取得
+			@param[in]	id	タイマー ID
+			@return 期限までのティック数（登録されていない場合 TICK_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_remain(uint32_t id) const noexcept
+		{
+			uint8_t idx;
+			if(!find_(id, idx)) return TICK_NONE;
+			auto d = node_[idx].expire - now_;
+			return d < 0x8000'0000 ? d : 0;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  次のイベント（期限、又はカスケード）までのティック数
+			@return ティック数（期限のタイマーが残っている場合０、無い場合 TICK_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t next() const noexcept
+		{
+			if(head_[LIST_DUE] != IDX_NONE) return 0;
+
+			uint32_t dist = TICK_NONE;
+			for(uint32_t lv = 0; lv < LEVEL_NUM; ++lv) {
+				if(map_[lv] == 0) continue;
+				auto sh = SLOT_BITS * lv;
+				auto cur = (now_ >> sh) & (SLOT_NUM - 1);
+				// 今のスロットの次を、ビット０に回す
+				auto m = rotr_(map_[lv], cur + 1);
+				auto k = static_cast<uint32_t>(__builtin_ctz(m)) + 1;
+				auto d = (((now_ >> sh) + k) << sh) - now_;
+				if(d < dist) dist = d;
+			}
+			return dist;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  時間を進め、期限になったタイマーのコールバックを呼ぶ
+			@param[in]	ticks	進めるティック数
+			@param[in]	hook	コールバックの前に呼ぶ関数 @n
+								hook(uint32_t expire, uint32_t period, uint32_t& user) @n
+								user はタイマー毎の値（登録時 TICK_NONE）
+		*/
+		//-----------------------------------------------------------------//
+		template <class HOOK>
+		void advance(uint32_t ticks, HOOK hook) noexcept
+		{
+			end_ = now_ + ticks;
+			run_due_(hook);
+			while(ticks > 0) {
+				auto d = next();
+				if(d > ticks) {
+					now_ += ticks;
+					stat_.skips += ticks;
+					break;
+				}
+				now_ += d - 1;
+				stat_.skips += d - 1;
+				ticks -= d;
+				step_();
+				run_due_(hook);
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  時間を進め、期限になったタイマーのコールバックを呼ぶ
+			@param[in]	ticks	進めるティック数
+		*/
+		//-----------------------------------------------------------------//
+		void advance(uint32_t ticks) noexcept { advance(ticks, null_hook_()); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  現在のティックを取得
+			@return 現在のティック
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_now() const noexcept { return now_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  登録されているタイマーの数
+			@return タイマーの数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t size() const noexcept { return num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  統計を取得
+			@return 統計
+		*/
+		//-----------------------------------------------------------------//
+		const stat_t& get_stat() const noexcept { return stat_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  統計をクリア
+		*/
+		//-----------------------------------------------------------------//
+		void clear_stat() noexcept { stat_ = stat_t { }; }
+	};
+}
@@ -2,7 +2,7 @@
 /*! @file
     @brief  ハードウェアー・ベクター関係
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2016, 2017 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2016, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -12,6 +12,10 @@
 
 void (*interrupt_vectors[256])(void);
 
+#ifdef ISR_PROFILE
+void (*(*interrupt_task_hook)(void (*task)(void), uint32_t idx))(void) = NULL;
+#endif
+
 // null interrupt TASK
 INTERRUPT_FUNC void null_task_(void)
 {
@@ -66,6 +70,11 @@ void init_interrupt(void)
 void set_interrupt_task(void (*task)(void), uint32_t idx)
 {
 	if(idx < 256) {
+#ifdef ISR_PROFILE
+		if(interrupt_task_hook != NULL) {
+			task = interrupt_task_hook(task, idx);
+		}
+#endif
 		if(task == NULL) {
 			task = null_task_;
 		}
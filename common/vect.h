@@ -3,7 +3,7 @@
 /*! @file
     @brief  ハードウェアー・ベクター関係
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2016, 2017 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2016, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -37,6 +37,25 @@ extern "C" {
 	//-----------------------------------------------------------------//
 	void set_interrupt_task(void (*task)(void), uint32_t idx);
 
+#ifdef ISR_PROFILE
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	割り込み関数の設定をフックする関数（ISR_PROFILE の場合） @n
+				戻り値を、ベクターテーブルに設定する。 @n
+				（device::isr_prof が使う）
+	 */
+	//-----------------------------------------------------------------//
+	extern void (*(*interrupt_task_hook)(void (*task)(void), uint32_t idx))(void);
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief	割り込みベクターテーブル（ISR_PROFILE の場合）
+	 */
+	//-----------------------------------------------------------------//
+	extern void (*interrupt_vectors[256])(void);
+#endif
+
 #ifndef TEST_MODE
 	//-----------------------------------------------------------------//
 	/*!
@@ -3,7 +3,7 @@
 /*!	@file
 	@brief	漢字フォント・クラス
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2018 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -11,6 +11,7 @@
 #include <cstdint>
 #include "ff14/source/ff.h"
 #include "common/vtx.hpp"
+#include "common/cp932.hpp"
 
 // 漢字フォントデータをＳＤカード上に置いて、キャッシュアクセスする場合有効にする
 // #define CASH_KFONT
@@ -180,7 +181,7 @@ namespace graphics {
 
 			if(fatfs_get_mount() == 0) return nullptr;
 #endif
-			uint32_t lin = sjis_to_liner_(ff_uni2oem(code, FF_CODE_PAGE));
+			uint32_t lin = sjis_to_liner_(utils::cp932::from_unicode(code));
 
 			if(lin == 0xffff) {
 				return nullptr;
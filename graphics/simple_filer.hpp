@@ -20,14 +20,18 @@
 			・ファイラーがオープンしたら、上下にドラッグでスクロール @n
 			・右にドラッグでファイル選択（フォーカスされているファイル） @n
 			・ディレクトリー選択した場合、ディレクトリー移動 @n
-			・左にドラッグでディレクトリーを一つ手前に戻る
+			・左にドラッグでディレクトリーを一つ手前に戻る @n
+			ディレクトリーの内容は utils::dir_cache に保持し、戻った時は取得を @n
+			やり直さない。取得中でも、取得した分から表示、操作できる。 @n
+			描画は、画面に見えている行だけを行う。
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2018, 2022 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=====================================================================//
 #include "common/file_io.hpp"
+#include "common/dir_index.hpp"
 #include "common/fixed_stack.hpp"
 
 namespace gui {
@@ -86,10 +90,13 @@ namespace gui {
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 	/*!
 		@brief	ファイラー・クラス
-		@param[in]	RDR	描画クラス型
+		@param[in]	RDR			描画クラス型
+		@param[in]	ENTRY_MAX	ディレクトリー毎のエントリーの最大数
+		@param[in]	POOL_SIZE	ディレクトリー毎の名前プールの大きさ
+		@param[in]	SLOT		キャッシュするディレクトリー数
 	*/
 	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
-	template <class RDR>
+	template <class RDR, uint32_t ENTRY_MAX = 512, uint32_t POOL_SIZE = 8192, uint32_t SLOT = 2>
 	class simple_filer : public simple_filer_base {
 
 		using GLC = typename RDR::glc_type;
@@ -108,20 +115,17 @@ namespace gui {
 
 		RDR&		rdr_;
 
-		typedef utils::dir_list DLIST;
-		DLIST		dlist_;
+		typedef utils::dir_cache<SLOT, ENTRY_MAX, POOL_SIZE> CACHE;
+		CACHE		cache_;
 
 		uint32_t	ctrl_;
 
 		struct rdr_st {
 			int16_t		vofs_;
-			int16_t		vpos_;
 			int16_t		sel_pos_;
-			uint16_t	num_;
-			int16_t		match_;
+			uint32_t	serial_;	// 描画したインデックスの状態
 
-			rdr_st() noexcept : vofs_(0), vpos_(0),
-				sel_pos_(0), num_(0), match_(-1)
+			rdr_st() noexcept : vofs_(0), sel_pos_(0), serial_(0)
 			{ }
 		};
 		rdr_st		rdr_st_;
@@ -157,42 +161,45 @@ namespace gui {
 		}
 
 
-		void dir_draw_func_(const char* name, const FILINFO* fi, bool dir, void* opt) noexcept
+		// 一行の描画
+		void draw_row_(uint32_t idx) noexcept
 		{
-			rdr_st& t = *static_cast<rdr_st*>(opt);
-			bool draw = false;
-			if(t.match_ < 0) {
-				draw = true;
-			} else if(t.num_ == static_cast<uint16_t>(t.match_)) {
-				draw = true;
+			const auto& index = cache_.get();
+			int16_t y = rdr_st_.vofs_ + 2 + static_cast<int16_t>(idx) * FLN;
+			if(y < 0 || y >= RDR::glc_type::height) return;
+
+			rdr_.set_fore_color(DEF_COLOR::Black);
+			rdr_.fill_box(vtx::srect(SPC, y,
+				RDR::glc_type::width - SPC * 2, RDR::font_type::height));
+			if(idx >= index.size()) {
+				// 溢れた場合、最後に一行（以降のエントリーは、表示されない）
+				if(idx == index.size() && index.is_overflow()) {
+					rdr_.set_fore_color(DEF_COLOR::Red);
+					rdr_.draw_text(vtx::spos(SPC + 8, y), "... (too many entries)");
+				}
+				return;
 			}
-			if(draw && t.vpos_ >= 0 && t.vpos_ < RDR::glc_type::height) {
-				rdr_.set_fore_color(DEF_COLOR::Black);
-				rdr_.fill_box(vtx::srect(SPC, t.vpos_,
-					RDR::glc_type::width - SPC * 2, RDR::font_type::height));
+
+			bool dir = index.is_dir(idx);
+			rdr_.set_fore_color(DEF_COLOR::White);
+			if(dir) rdr_.draw_font(vtx::spos(SPC, y), '/');
+			if(dir) {
+				rdr_.set_fore_color(DEF_COLOR::Blue);
+			} else {
 				rdr_.set_fore_color(DEF_COLOR::White);
-				if(dir) rdr_.draw_font(vtx::spos(SPC, t.vpos_), '/');
-				if(dir) {
-					rdr_.set_fore_color(DEF_COLOR::Blue);
-				} else {
-					rdr_.set_fore_color(DEF_COLOR::White);
-				}
-				auto w = rdr_.draw_text(vtx::spos(SPC + 8, t.vpos_), name);
 			}
-			t.vpos_ += FLN;
-			++t.num_;
+			rdr_.draw_text(vtx::spos(SPC + 8, y), index.get_name(idx));
 		}
 
 
-		void start_dir_draw_(int16_t match = -1) noexcept
+		// 見えている行だけを描画
+		void draw_rows_() noexcept
 		{
-			rdr_st_.vpos_ = rdr_st_.vofs_ + 2;
-			rdr_st_.num_ = 0;
-			rdr_st_.match_ = match;
-			char tmp[FF_MAX_LFN + 1];
-			if(utils::file_io::pwd(tmp, sizeof(tmp))) {
-				dlist_.start(tmp);
+			uint32_t top = -rdr_st_.vofs_ / FLN;
+			for(uint32_t i = 0; i <= static_cast<uint32_t>(SCN); ++i) {
+				draw_row_(top + i);
 			}
+			rdr_st_.serial_ = cache_.get().get_serial();
 		}
 
 
@@ -219,7 +226,23 @@ namespace gui {
 				rdr_st_.vofs_ = 0;
 				rdr_st_.sel_pos_ = 0;
 			}
-			start_dir_draw_();
+			char tmp[FF_MAX_LFN + 1];
+			if(utils::file_io::pwd(tmp, sizeof(tmp))) {
+				cache_.open(tmp);
+			}
+			draw_rows_();
+		}
+
+
+		// 選択されているエントリーのフル・パス
+		bool get_sel_path_(char* dst, uint32_t dstlen, bool& dir) const noexcept
+		{
+			const auto& index = cache_.get();
+			uint32_t idx = rdr_st_.sel_pos_ - rdr_st_.vofs_ / FLN;
+			if(idx >= index.size()) return false;
+
+			dir = index.is_dir(idx);
+			return utils::file_io::make_full_path(index.get_name(idx), dst, dstlen);
 		}
 
 	public:
@@ -230,7 +253,7 @@ namespace gui {
 			@param[in]	tto		３本指タッチオープンを有効にする場合「true」
 		*/
 		//-----------------------------------------------------------------//
-		simple_filer(RDR& rdr, bool tto = false) noexcept : rdr_(rdr), dlist_(),
+		simple_filer(RDR& rdr, bool tto = false) noexcept : rdr_(rdr), cache_(),
 			ctrl_(0), rdr_st_(), open_(false), info_(false), 
 			touch_lvl_(false), touch_pos_(false), touch_neg_(false), touch_num_(0),
 			touch_(0), touch_org_(0), touch_end_(0),
@@ -297,6 +320,19 @@ namespace gui {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	並び順を設定（ディレクトリーは常に先頭）
+			@param[in]	sort	並び順
+			@param[in]	rev		逆順の場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		void set_sort(utils::dir_index_base::SORT sort, bool rev = false) noexcept
+		{
+			cache_.set_sort(sort, rev);
+		}
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	アップデート（毎フレーム呼ぶ）
@@ -312,12 +348,9 @@ namespace gui {
 			uint32_t ntrg =  ctrl_ & ~ctrl;
 			ctrl_ = ctrl;
 
-			dlist_.service(FRAME_PER_FILES,
-				[&](const char* name, const FILINFO* fi, bool dir, void* opt) {
-				dir_draw_func_(name, fi, dir, opt); }, true, &rdr_st_);
-
 			if((ntrg & ctrl_mask_(ctrl::MOUNT))) {  // SD カードのマウント状態
 				pos_stack_.clear();
+				cache_.clear();
 				if(open_) {
 					rdr_.clear(DEF_COLOR::Black);
 				}
@@ -393,12 +426,12 @@ namespace gui {
 				}
 			}
 
-			{
-				if(dlist_.probe()) return status::NONE;
-				if(rdr_st_.num_ < static_cast<int16_t>(dlist_.get_total())) {
-					return status::NONE;
-				}
+			// 取得を進め、変化があれば見えている行を描き直す
+			cache_.service(FRAME_PER_FILES);
+			if(!info_ && rdr_st_.serial_ != cache_.get().get_serial()) {
+				draw_rows_();
 			}
+			int16_t num = cache_.get().size() + (cache_.get().is_overflow() ? 1 : 0);
 
 			if(ptrg & ctrl_mask_(ctrl::INFO)) {
 				if(info_) {
@@ -408,22 +441,15 @@ namespace gui {
 					scan_dir_(true);
 					return status::NONE;
 				} else {
-					info_ = true;
+					const auto& index = cache_.get();
 					uint32_t idx = rdr_st_.sel_pos_ - rdr_st_.vofs_ / FLN;
-					char tmp[FF_MAX_LFN + 1];
-					if(!utils::file_io::pwd(tmp, sizeof(tmp))) {
+					if(idx >= index.size()) {
 						return status::NONE;
 					}
-					if(!utils::file_io::get_dir_path(tmp, idx, dst, dstlen)) {
-						return status::NONE;
-					}
-					bool dir = false;
-					uint32_t l = strlen(dst);
-					if(dst[l - 1] == '/') {
-						dir = true;
-						dst[l - 1] = 0;
-					}
-					auto t = utils::file_io::get_time(dst);
+					info_ = true;
+					const auto& e = index.get(idx);
+					char tmp[FF_MAX_LFN + 1];
+					auto t = utils::str::fatfs_time_to(e.date, e.time);
 					struct tm *m = localtime(&t);
 					utils::sformat("%s %2d %4d %02d:%02d\n", tmp, sizeof(tmp))
 						% get_mon(m->tm_mon)
@@ -431,10 +457,9 @@ namespace gui {
 						% static_cast<int>(m->tm_year + 1900)
 						% static_cast<int>(m->tm_hour)
 						% static_cast<int>(m->tm_min);
-					if(!dir) {
-						auto n = utils::file_io::get_file_size(dst);
-						l = strlen(tmp);
-						utils::sformat("%u bytes", &tmp[l], sizeof(tmp) - l) % n;
+					if(!index.is_dir(idx)) {
+						auto l = strlen(tmp);
+						utils::sformat("%u bytes", &tmp[l], sizeof(tmp) - l) % e.size;
 					}
 					modal(vtx::spos(300, 80), tmp);
 				}
@@ -455,7 +480,8 @@ namespace gui {
 			}
 			int16_t vofs = rdr_st_.vofs_;
 			int16_t scn = SCN;
-			if(rdr_st_.num_ < scn) scn = rdr_st_.num_; 
+			if(num < scn) scn = num;
+			if(scn <= 0) scn = 1;
 			if(pos < 0) {
 				pos = 0;
 				vofs += FLN;
@@ -464,8 +490,8 @@ namespace gui {
 				vofs -= FLN;
 			}
 			int16_t lim = 0;
-			if(rdr_st_.num_ > scn) {
-				lim = -(rdr_st_.num_ - scn) * FLN;
+			if(num > scn) {
+				lim = -(num - scn) * FLN;
 			}
 			if(vofs > 0) {
 				vofs = 0;
@@ -475,16 +501,16 @@ namespace gui {
 			if(vofs != rdr_st_.vofs_) {
 				rdr_.set_fore_color(DEF_COLOR::Black);
 				draw_sel_frame_(rdr_st_.sel_pos_);  // delete frame
-				int16_t match = -1;
+				// スクロールして、現れた行だけを描画
 				if(vofs < rdr_st_.vofs_) {  // down
 					rdr_.scroll(FLN);
-					match = -vofs / FLN + (RDR::glc_type::height / FLN) - 1;
-				} else if(vofs > rdr_st_.vofs_) {  // up
+					rdr_st_.vofs_ = vofs;
+					draw_row_(-vofs / FLN + (RDR::glc_type::height / FLN) - 1);
+				} else {  // up
 					rdr_.scroll(-FLN);
-					match = -vofs / FLN;
+					rdr_st_.vofs_ = vofs;
+					draw_row_(-vofs / FLN);
 				}
-				rdr_st_.vofs_ = vofs;
-				start_dir_draw_(match);
 			}
 			
 			if(pos != rdr_st_.sel_pos_) {
@@ -494,18 +520,12 @@ namespace gui {
 			}
 
 			if(ptrg & ctrl_mask_(ctrl::SELECT)) {
-				uint32_t idx = rdr_st_.sel_pos_ - rdr_st_.vofs_ / FLN;
-				char root[FF_MAX_LFN + 1];
-				if(!utils::file_io::pwd(root, sizeof(root))) {
+				bool dir;
+				if(!get_sel_path_(dst, dstlen, dir)) {
 					return status::NONE;
 				}
-				if(!utils::file_io::get_dir_path(root, idx, dst, dstlen)) {
-					return status::NONE;
-				}
-				uint32_t l = strlen(dst);
-				if(dst[l - 1] == '/') {  // directory ?
+				if(dir) {
 					pos_stack_.push(pos_t(rdr_st_.vofs_, rdr_st_.sel_pos_));
-					dst[l - 1] = 0;
 					utils::file_io::cd(dst);
 					rdr_.clear(DEF_COLOR::Black);
 					scan_dir_(false);
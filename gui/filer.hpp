@@ -1,15 +1,23 @@
 #pragma once
 //=====================================================================//
 /*!	@file
-	@brief	ファイル選択ユーティリティー (widget 版)
+	@brief	ファイル選択ユーティリティー (widget 版) @n
+			・ディレクトリーの内容は utils::dir_cache に保持し、戻った時は @n
+			  取得をやり直さない。 @n
+			・取得中でも、取得した分から表示、操作できる。 @n
+			・描画は、見えている行だけを行う。 @n
+			・上下にドラッグでスクロール、タッチして離すと選択 @n
+			  （ディレクトリーなら移動、ファイルなら選択関数を呼ぶ）
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2022 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2022, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=====================================================================//
+#include <functional>
 #include "gui/widget.hpp"
 #include "common/file_io.hpp"
+#include "common/dir_index.hpp"
 #include "common/fixed_string.hpp"
 
 namespace gui {
@@ -23,27 +31,47 @@ namespace gui {
 
 		typedef filer value_type;
 
-//		typedef std::function<void(uint32_t pos, uint32_t num)> SELECT_FUNC_TYPE;
+		typedef std::function<void(const char* path)> SELECT_FUNC_TYPE;
 
 	private:
 
-		typedef utils::dir_list DLIST;
-		DLIST		dlist_;
+		typedef utils::dir_cache<DEF_FILER_SLOT, DEF_FILER_ENTRY_MAX, DEF_FILER_POOL_SIZE> CACHE;
+		CACHE		cache_;
 
-		vtx::spos	touch_org_;
-		uint16_t	focus_pos_;
-		uint16_t	select_pos_;
-		uint16_t	offset_;
+		SELECT_FUNC_TYPE	select_func_;
 
 		typedef utils::fixed_string<255> STRING;
+		STRING		root_;
+
+		vtx::spos	touch_org_;
+		uint32_t	offset_;	///< 先頭に表示する行
+		uint32_t	focus_pos_;
+		uint32_t	select_pos_;
+		uint32_t	serial_;
+		bool		drag_;
+		bool		sel_req_;
+
+		static constexpr const char* OVERFLOW_TEXT_ = "... (too many entries)";
 
-		struct file_info {
-			STRING		fn;
-			uint32_t	fs;
-			bool		dir;
-			file_info() noexcept : fn(), fs(0), dir(false) { }
-		};
-		file_info	file_info_[DEF_FILER_LOOP];
+		uint32_t get_rows_() const noexcept
+		{
+			return (get_location().size.y + DEF_FILER_HEIGHT - 1) / DEF_FILER_HEIGHT;
+		}
+
+		void scroll_(int32_t d) noexcept
+		{
+			const auto& index = cache_.get();
+			auto num = index.size() + (index.is_overflow() ? 1 : 0);  // 溢れた場合は、最後に一行
+			auto rows = get_rows_();
+			int32_t lim = num > rows ? (num - rows) : 0;
+			int32_t ofs = static_cast<int32_t>(offset_) + d;
+			if(ofs > lim) ofs = lim;
+			if(ofs < 0) ofs = 0;
+			if(static_cast<uint32_t>(ofs) != offset_) {
+				offset_ = ofs;
+				set_update();
+			}
+		}
 
 	public:
 		//-----------------------------------------------------------------//
@@ -55,8 +83,8 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		filer(const vtx::srect& loc = vtx::srect(0), const char* str = nullptr) noexcept :
 			widget(loc, str),
-			dlist_(), touch_org_(), focus_pos_(0), select_pos_(0), offset_(0),
-			file_info_{ }
+			cache_(), select_func_(), root_(), touch_org_(),
+			offset_(0), focus_pos_(0), select_pos_(0), serial_(0), drag_(false), sel_req_(false)
 		{
 			insert_widget(this);
 		}
@@ -102,7 +130,7 @@ namespace gui {
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	タッチ判定を更新
+			@brief	タッチ判定を更新（毎フレーム呼ばれる）
 			@param[in]	pos		判定位置
 			@param[in]	num		タッチ数
 		*/
@@ -113,37 +141,43 @@ namespace gui {
 			const auto& st = get_touch_state();
 			if(st.positive_) {
 				touch_org_ = st.position_;
+				drag_ = false;
 			}
 			if(st.level_) {
 				if(get_focus()) {
-					auto d = st.position_ - touch_org_;
-					if(std::abs(d.y) > DEF_FILER_DRAG_TH) {
-						
+					auto d = st.position_.y - touch_org_.y;
+					if(!drag_ && std::abs(d) > DEF_FILER_DRAG_TH) {
+						drag_ = true;
+					}
+					if(drag_) {  // 行単位でスクロール
+						auto n = d / DEF_FILER_HEIGHT;
+						if(n != 0) {
+							scroll_(-n);
+							touch_org_.y += n * DEF_FILER_HEIGHT;
+						}
+					}
+					uint32_t fp = st.relative_.y / DEF_FILER_HEIGHT;
+					if(fp != focus_pos_) {
+						focus_pos_ = fp;
+						set_update();
 					}
-					focus_pos_ = st.relative_.y / DEF_FILER_HEIGHT;
 				}
 			}
 			if(st.negative_) {
-				if(get_focus()) {
-				//	auto newpos = st.relative_.y / DEF_FILER_HEIGHT;
-				//	if(newpos >= 0 && newpos < static_cast<int16_t>(num_)) {
-				//		select_pos_ = newpos;
-				//	}
+				if(get_focus() && !drag_) {
+					select_pos_ = offset_ + st.relative_.y / DEF_FILER_HEIGHT;
+					sel_req_ = true;
 				}
 			}
 
-			if(dlist_.probe()) {
-				dlist_.service(DEF_FILER_LOOP,
-					[this](const char* name, const FILINFO* fi, bool dir, void* option) {
-						auto info = static_cast<file_info*>(option);
-						auto idx = dlist_.get_total() % DEF_FILER_LOOP;
-						info[idx].fn = name;
-						info[idx].fs = fi->fsize;
-						info[idx].dir = dir;
-					}, true, file_info_);
+			// 取得を進め、変化があれば再描画
+			cache_.service(DEF_FILER_LOOP);
+			if(serial_ != cache_.get().get_serial()) {
+				serial_ = cache_.get().get_serial();
+				set_update();
 			}
 		}
-	
+
 
 		//-----------------------------------------------------------------//
 		/*!
@@ -152,8 +186,22 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		void exec_select() noexcept override
 		{
+			if(!sel_req_) return;
+			sel_req_ = false;
+
+			const auto& index = cache_.get();
+			if(select_pos_ >= index.size()) return;
+
+			STRING path = root_;
+			if(path.size() == 0 || path.back() != '/') path += '/';
+			path += index.get_name(select_pos_);
+			if(index.is_dir(select_pos_)) {
+				set_root(path.c_str());
+			} else if(select_func_) {
+				select_func_(path.c_str());
+			}
 		}
-	
+
 
 		//-----------------------------------------------------------------//
 		/*!
@@ -174,37 +222,107 @@ namespace gui {
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	ルートパス設定（取得開始）
-			@param[in] root	ルートパス
+			@brief	ルートパス設定（取得開始、キャッシュが有効ならそのまま）
+			@param[in] root	ルートパス（フル・パス）
 		*/
 		//-----------------------------------------------------------------//
 		void set_root(const char* root) noexcept
 		{
-			dlist_.stop();
-			dlist_.start(root);
+			if(root == nullptr) return;
+
+			root_ = root;
+			cache_.open(root_.c_str());
+			offset_ = 0;
+			select_pos_ = 0;
+			serial_ = cache_.get().get_serial();
+			set_update();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ルートパスを取得
+			@return ルートパス
+		*/
+		//-----------------------------------------------------------------//
+		const char* get_root() const noexcept { return root_.c_str(); }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	一つ上のディレクトリーに戻る
+			@return 戻れない場合「false」
+		*/
+		//-----------------------------------------------------------------//
+		bool back() noexcept
+		{
+			STRING path = root_;
+			while(path.size() > 1 && path.back() == '/') path.pop_back();
+			while(path.size() > 0 && path.back() != '/') path.pop_back();
+			if(path.size() == 0 || path == root_) return false;
+			if(path.size() > 1) path.pop_back();
+			set_root(path.c_str());
+			return true;
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	描画
+			@brief	並び順を設定（ディレクトリーは常に先頭）
+			@param[in]	sort	並び順
+			@param[in]	rev		逆順の場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		void set_sort(utils::dir_index_base::SORT sort, bool rev = false) noexcept
+		{
+			cache_.set_sort(sort, rev);
+			set_update();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	キャッシュを破棄（アンマウント時など）
+		*/
+		//-----------------------------------------------------------------//
+		void clear() noexcept
+		{
+			cache_.clear();
+			offset_ = 0;
+			set_update();
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	セレクト関数への参照
+			@return セレクト関数
+		*/
+		//-----------------------------------------------------------------//
+		SELECT_FUNC_TYPE& at_select_func() noexcept { return select_func_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	描画（見えている行だけ）
 			@param[in] rdr	描画インスタンス
 		*/
 		//-----------------------------------------------------------------//
 		template<class RDR>
 		void draw(RDR& rdr) noexcept
 		{
+			const auto& index = cache_.get();
 			auto r = vtx::srect(get_final_position(), get_location().size);
 			rdr.push_clip();
 			rdr.set_clip(r);
-			uint16_t num = (r.size.y + DEF_FILER_HEIGHT - 1) / DEF_FILER_HEIGHT;
+			auto num = get_rows_();
 			r.size.y = DEF_FILER_HEIGHT;
-			for(uint16_t i = 0; i < num; ++i) {
+			for(uint32_t i = 0; i < num; ++i) {
 				uint8_t inten = 64;
-				if(get_touch_state().level_ && focus_pos_ == i) {
+				if(get_touch_state().level_ && !drag_ && focus_pos_ == i) {
 					inten = 192;
 				} else {
-					if(i & 1) {
+					if((offset_ + i) & 1) {
 						inten = 96;
 					} else {
 						inten = 128;
@@ -215,21 +333,23 @@ namespace gui {
 				rdr.set_fore_color(sc);
 				rdr.fill_box(r);
 
-#if 0
-				if(check_draw_ && i == select_pos_) {
-					rdr.set_fore_color(get_base_color());
-					rdr.fill_box(
-						vtx::srect(r.org.x + DEF_MENU_SIGN_SPACE, r.org.y + (r.size.y - DEF_MENU_SIGN_SIZE) / 2,
-						DEF_MENU_SIGN_SIZE, DEF_MENU_SIGN_SIZE));
-				}
-
-				char tmp[32];
-				if(utils::str::get_word(get_title(), i, tmp, sizeof(tmp), ',')) {
-					auto sz = rdr.at_font().get_text_size(tmp);
+				auto idx = offset_ + i;
+				if(idx < index.size()) {
+					auto name = index.get_name(idx);
+					auto sz = rdr.at_font().get_text_size(name);
+					vtx::spos pos(r.org.x + 4, r.org.y + (r.size.y - sz.y) / 2);
 					rdr.set_fore_color(get_font_color());
-					rdr.draw_text(r.org + (r.size - sz) / 2, tmp);
+					pos.x = rdr.draw_text(pos, name);
+					if(index.is_dir(idx)) {
+						rdr.draw_text(pos, "/");
+					}
+				} else if(idx == index.size() && index.is_overflow()) {
+					// 溢れた以降のエントリーは、表示されない
+					auto sz = rdr.at_font().get_text_size(OVERFLOW_TEXT_);
+					vtx::spos pos(r.org.x + 4, r.org.y + (r.size.y - sz.y) / 2);
+					rdr.set_fore_color(graphics::def_color::Red);
+					rdr.draw_text(pos, OVERFLOW_TEXT_);
 				}
-#endif
 				r.org.y += DEF_FILER_HEIGHT;
 			}
 			rdr.pop_clip();
@@ -3,7 +3,7 @@
 /*!	@file
 	@brief	Widget クラス
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2019, 2022 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2019, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -77,7 +77,10 @@ namespace gui {
 
 		static constexpr int16_t DEF_FILER_HEIGHT          = 20;	///< 標準、ファイラー、アイテムの高さ
 		static constexpr int16_t DEF_FILER_DRAG_TH         = 10; 	///< 標準、ファイラー、ドラッグ開始のスレッショルド幅
-		static constexpr uint16_t DEF_FILER_LOOP		   = 2;		///< 標準、１フレームに取得するファイル情報数
+		static constexpr uint16_t DEF_FILER_LOOP		   = 16;	///< 標準、１フレームに取得するファイル情報数
+		static constexpr uint32_t DEF_FILER_ENTRY_MAX      = 256;	///< 標準、ファイラー、ディレクトリー毎のエントリー数
+		static constexpr uint32_t DEF_FILER_POOL_SIZE      = 4096;	///< 標準、ファイラー、ディレクトリー毎の名前プール
+		static constexpr uint32_t DEF_FILER_SLOT           = 2;		///< 標準、ファイラー、キャッシュするディレクトリー数
 
 		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
 		/*!
@@ -3,12 +3,13 @@
 /*!	@file
 	@brief	Widget ディレクター
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2019, 2024 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2019, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
 //=====================================================================//
 #include <array>
+#include <algorithm>
 #include "gui/widget.hpp"
 #include "gui/group.hpp"
 #include "gui/frame.hpp"
@@ -44,26 +45,71 @@ namespace gui {
 	template <class RDR, class TOUCH, uint32_t WNUM>
 	struct widget_director {
 
+		/// 描画関数型（insert 時に widget の型から決める）
+		typedef void (*DRAW_FUNC)(widget* w, RDR& rdr);
+
+		/// タッチ更新の種別
+		enum class POLL : uint8_t {
+			NONE,		///< タッチ更新不要（update_touch が空）
+			HIT,		///< タッチ位置にある場合と、タッチ状態が残っている場合のみ
+			ALWAYS,		///< 毎フレーム（スクロール、進捗更新、ファイル走査など）
+		};
+
 		struct widget_t {
 			widget*			w_;
 			const char*		title_;	// タイトルの変化を監視するパッド
+			DRAW_FUNC		draw_func_;
+			vtx::srect		rect_;	// ヒット・グリッド登録時の領域
 			widget::STATE	state_;
+			POLL			poll_;
 			bool			init_;
 			bool			focus_;
 			bool			draw_;
 			bool			refresh_;
 			uint8_t			exec_request_;
-			widget_t() : w_(nullptr), title_(nullptr),
-				state_(widget::STATE::DISABLE),
+			widget_t() : w_(nullptr), title_(nullptr), draw_func_(nullptr), rect_(0),
+				state_(widget::STATE::DISABLE), poll_(POLL::NONE),
 				init_(false), focus_(false), draw_(false), refresh_(false),
 				exec_request_(0) { }
 		};
 
 		typedef std::array<widget_t, WNUM> WIDGETS; 
 
+		/// 描画フック型（end: 描画前は「false」、描画後は「true」）
+		typedef void (*DRAW_HOOK)(const widget* w, bool end);
+
+		/// 時間計測関数型（単位は任意、差分だけを使う）
+		typedef uint32_t (*TICK_FUNC)();
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief	update 毎の計測カウンター
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct perf_t {
+			uint32_t	update;		///< update 回数（累計）
+			uint32_t	rebuild;	///< ヒット・グリッド再構築回数（累計）
+			uint16_t	touch;		///< update_touch 呼び出し数（直近の update）
+			uint16_t	draw;		///< 描画 widget 数（直近の update）
+			uint32_t	touch_tick;	///< 状態更新に掛かった時間（直近の update）
+			uint32_t	draw_tick;	///< 描画に掛かった時間（直近の update）
+			perf_t() noexcept : update(0), rebuild(0), touch(0), draw(0),
+				touch_tick(0), draw_tick(0) { }
+		};
+
 	private:
 		using GLC = typename RDR::glc_type;
 
+		// widget 集合（インデックスのビットセット）
+		static constexpr uint32_t BITS_NUM = (WNUM + 31) / 32;
+		typedef std::array<uint32_t, BITS_NUM> BITS;
+
+		// ヒット・グリッド（画面を GRID_X x GRID_Y に分割）
+		static constexpr int16_t GRID_X = 8;
+		static constexpr int16_t GRID_Y = 8;
+		static constexpr int16_t CELL_W = (GLC::width  + GRID_X - 1) / GRID_X;
+		static constexpr int16_t CELL_H = (GLC::height + GRID_Y - 1) / GRID_Y;
+
 		RDR&		rdr_;
 		TOUCH&		touch_;
 
@@ -73,6 +119,125 @@ namespace gui {
 
 		widget*		current_;
 
+		DRAW_HOOK	draw_hook_;
+		TICK_FUNC	tick_func_;
+
+		BITS		used_;
+		BITS		dirty_;
+		std::array<BITS, GRID_X * GRID_Y>	grid_;
+		bool		grid_dirty_;
+
+		perf_t		perf_;
+
+
+		static void set_bit_(BITS& bits, uint32_t idx) noexcept { bits[idx >> 5] |= 1 << (idx & 31); }
+		static void clr_bit_(BITS& bits, uint32_t idx) noexcept { bits[idx >> 5] &= ~(1 << (idx & 31)); }
+		static bool tst_bit_(const BITS& bits, uint32_t idx) noexcept { return (bits[idx >> 5] & (1 << (idx & 31))) != 0; }
+
+		// ビットセットの widget をインデックス順に走査
+		template <class FUNC>
+		static void scan_bits_(const BITS& bits, FUNC func) noexcept
+		{
+			for(uint32_t i = 0; i < BITS_NUM; ++i) {
+				auto b = bits[i];
+				while(b != 0) {
+					auto n = __builtin_ctz(b);
+					b &= b - 1;
+					func((i << 5) + n);
+				}
+			}
+		}
+
+		uint32_t tick_() const noexcept { return tick_func_ != nullptr ? tick_func_() : 0; }
+
+		void mark_(uint32_t idx) noexcept
+		{
+			widgets_[idx].draw_ = true;
+			set_bit_(dirty_, idx);
+		}
+
+		template <class T>
+		static void draw_type_(widget* w, RDR& rdr) noexcept
+		{
+			static_cast<T*>(w)->draw(rdr);
+		}
+
+		static DRAW_FUNC get_draw_func_(widget::ID id) noexcept
+		{
+			switch(id) {
+			case widget::ID::FRAME:		return draw_type_<frame>;
+			case widget::ID::BOX:		return draw_type_<box>;
+			case widget::ID::TEXT:		return draw_type_<text>;
+			case widget::ID::TEXTBOX:	return draw_type_<textbox>;
+			case widget::ID::DIALOG:	return draw_type_<dialog>;
+			case widget::ID::BUTTON:	return draw_type_<button>;
+			case widget::ID::CHECK:		return draw_type_<check>;
+			case widget::ID::RADIO:		return draw_type_<radio>;
+			case widget::ID::SLIDER:	return draw_type_<slider>;
+			case widget::ID::MENU:		return draw_type_<menu>;
+			case widget::ID::TERM:		return draw_type_<term>;
+			case widget::ID::SPINBOX:	return draw_type_<spinbox>;
+			case widget::ID::SPINBOXT:	return draw_type_<spinboxt>;
+			case widget::ID::TOGGLE:	return draw_type_<toggle>;
+			case widget::ID::PROGRESS:	return draw_type_<progress>;
+			case widget::ID::CLOSEBOX:	return draw_type_<closebox>;
+			case widget::ID::FILER:		return draw_type_<filer>;
+			case widget::ID::KEY_ASC:	return draw_type_<key_asc>;
+			case widget::ID::KEY_10:	return draw_type_<key_10>;
+			default:
+				return nullptr;
+			}
+		}
+
+		static POLL get_poll_(widget::ID id) noexcept
+		{
+			switch(id) {
+			case widget::ID::GROUP:
+			case widget::ID::FRAME:
+			case widget::ID::BOX:
+			case widget::ID::TEXTBOX:
+			case widget::ID::DIALOG:
+			case widget::ID::TERM:
+				return POLL::NONE;
+			case widget::ID::TEXT:
+			case widget::ID::PROGRESS:
+			case widget::ID::FILER:
+				return POLL::ALWAYS;
+			default:
+				return POLL::HIT;
+			}
+		}
+
+		// タッチ判定に使う領域（フォーカス拡張を含む）
+		static vtx::srect touch_rect_(const widget* w) noexcept
+		{
+			const auto& exp = w->get_touch_state().expand_;
+			vtx::srect r(w->get_final_position(), w->get_location().size);
+			r.org  -= exp;
+			r.size += exp * 2;
+			return r;
+		}
+
+		void rebuild_grid_() noexcept
+		{
+			for(auto& c : grid_) c.fill(0);
+			scan_bits_(used_, [this](uint32_t idx) {
+				const auto& t = widgets_[idx];
+				if(t.poll_ != POLL::HIT) return;
+				const auto& r = t.rect_;
+				auto x0 = std::max<int16_t>(r.org.x, 0) / CELL_W;
+				auto y0 = std::max<int16_t>(r.org.y, 0) / CELL_H;
+				auto x1 = std::min<int16_t>(r.org.x + r.size.x - 1, GLC::width  - 1) / CELL_W;
+				auto y1 = std::min<int16_t>(r.org.y + r.size.y - 1, GLC::height - 1) / CELL_H;
+				for(auto y = y0; y <= y1; ++y) {
+					for(auto x = x0; x <= x1; ++x) {
+						set_bit_(grid_[y * GRID_X + x], idx);
+					}
+				}
+			});
+			grid_dirty_ = false;
+			++perf_.rebuild;
+		}
 
 		// ipass 自分を含めない場合「false」
 		// 「子」のリストを作成
@@ -100,16 +265,16 @@ namespace gui {
 		uint32_t redraw_overlap_widget_(widget* area)
 		{
 			uint32_t cnt = 0;
-			for(auto& t : widgets_) {
-				if(t.w_ == nullptr) continue;
-				if(t.w_->get_state() == widget::STATE::STALL) continue;
-				if(t.w_ == area) continue;  // 自分は評価しない
-				if(t.w_->get_parents() != nullptr) continue;  // 子は評価しない
+			scan_bits_(used_, [&](uint32_t idx) {
+				auto& t = widgets_[idx];
+				if(t.w_->get_state() == widget::STATE::STALL) return;
+				if(t.w_ == area) return;  // 自分は評価しない
+				if(t.w_->get_parents() != nullptr) return;  // 子は評価しない
 				if(area->get_location().is_overlap(t.w_->get_location())) {
-					t.w_.draw_ = true;
+					mark_(idx);
 					++cnt;
 				}
-			}
+			});
 			return cnt;
 		}
 
@@ -123,7 +288,9 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		widget_director(RDR& rdr, TOUCH& touch) noexcept :
 			rdr_(rdr), touch_(touch), widgets_(),
-			back_color_(graphics::def_color::Black), current_(nullptr)
+			back_color_(graphics::def_color::Black), current_(nullptr),
+			draw_hook_(nullptr), tick_func_(nullptr),
+			used_{ }, dirty_{ }, grid_{ }, grid_dirty_(false), perf_()
 		{ }
 
 
@@ -159,6 +326,35 @@ namespace gui {
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	描画フックの設定 @n
+					widget 毎の描画時間計測などに使う。
+			@param[in]	hook	描画フック（nullptr で解除）
+		*/
+		//-----------------------------------------------------------------//
+		void set_draw_hook(DRAW_HOOK hook) noexcept { draw_hook_ = hook; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	時間計測関数の設定 @n
+					設定すると、perf_t の touch_tick、draw_tick が計測される。
+			@param[in]	func	時間計測関数（nullptr で解除）
+		*/
+		//-----------------------------------------------------------------//
+		void set_tick_func(TICK_FUNC func) noexcept { tick_func_ = func; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	計測カウンターの取得
+			@return 計測カウンター
+		*/
+		//-----------------------------------------------------------------//
+		const auto& get_perf() const noexcept { return perf_; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief	widget の登録
@@ -168,12 +364,18 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		bool insert(widget* w) noexcept
 		{
-			for(auto& t : widgets_) {
+			for(uint32_t i = 0; i < WNUM; ++i) {
+				auto& t = widgets_[i];
 				if(t.w_ == nullptr) {
 					t.w_ = w;
 					t.title_ = w->get_title();
+					t.draw_func_ = get_draw_func_(w->get_id());
+					t.poll_ = get_poll_(w->get_id());
+					t.rect_ = touch_rect_(w);
 					t.init_ = false;
-					t.draw_ = true;
+					set_bit_(used_, i);
+					mark_(i);
+					grid_dirty_ = true;
 					return true;
 				}
 			}
@@ -190,9 +392,16 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		bool remove(widget* w) noexcept
 		{
-			for(auto& t : widgets_) {
+			for(uint32_t i = 0; i < WNUM; ++i) {
+				auto& t = widgets_[i];
 				if(t.w_ == w) {
 					t.w_ = nullptr;
+					t.draw_ = false;
+					t.refresh_ = false;
+					clr_bit_(used_, i);
+					clr_bit_(dirty_, i);
+					if(current_ == w) current_ = nullptr;
+					grid_dirty_ = true;
 					return true;
 				}
 			}
@@ -268,12 +477,11 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		void redraw_all() noexcept
 		{
-			for(auto& t : widgets_) {
-				if(t.w_ == nullptr) continue;
-				if(t.w_->get_state() == widget::STATE::ENABLE) {
-					t.draw_ = true;
+			scan_bits_(used_, [this](uint32_t idx) {
+				if(widgets_[idx].w_->get_state() == widget::STATE::ENABLE) {
+					mark_(idx);
 				}
-			}
+			});
 		}
 
 
@@ -284,251 +492,173 @@ namespace gui {
 		//-----------------------------------------------------------------//
 		void refresh() noexcept
 		{
-			for(auto& t : widgets_) {
-				if(t.w_ == nullptr) continue;
+			scan_bits_(used_, [this](uint32_t idx) {
+				auto& t = widgets_[idx];
 				if(t.w_->get_state() == widget::STATE::ENABLE) {
 					t.refresh_ = true;
+					set_bit_(dirty_, idx);
 				}
-			}
+			});
 		}
 
 
 		//-----------------------------------------------------------------//
 		/*!
-			@brief	アップデート（管理と描画）
+			@brief	アップデート（管理と描画） @n
+					・update_touch は、タッチ位置のセルにある widget と、タッチ状態が @n
+					  残っている widget、毎フレーム更新が必要な widget だけに呼ぶ。 @n
+					・描画は、変更のあった widget（ダーティ・リスト）だけを行う。
 			@return 書き換えアイテムがあれば「true」
 		*/
 		//-----------------------------------------------------------------//
 		bool update() noexcept
 		{
+			auto tick0 = tick_();
+			auto num = touch_.get_touch_num();
+			const auto& tp = touch_.get_touch_pos(0);
+
+			BITS called{ };	// update_touch を呼んだ widget
+			BITS check{ };	// 選択推移を検査する widget
+			uint16_t ntouch = 0;
+
 			// 状態の生成とGUIへ反映
-			{
-				auto num = touch_.get_touch_num();
-				const auto& tp = touch_.get_touch_pos(0);
-				for(auto& t : widgets_) {
-					if(t.w_ == nullptr) continue;
-					if(!t.init_) {  // 初期化プロセス
-						t.w_->init();
-						t.init_ = true;
-						t.draw_ = true;
-					}
-					if(t.state_ != t.w_->get_state()) {
-						t.state_ = t.w_->get_state();
-						if(t.state_ != widget::STATE::DISABLE) {
-							t.draw_ = true;
-						}
+			scan_bits_(used_, [&](uint32_t idx) {
+				auto& t = widgets_[idx];
+				auto* w = t.w_;
+				if(!t.init_) {  // 初期化プロセス
+					w->init();
+					t.init_ = true;
+					mark_(idx);
+				}
+				auto st = w->get_state();
+				if(t.state_ != st) {
+					t.state_ = st;
+					if(st != widget::STATE::DISABLE) {
+						mark_(idx);
 					}
-					if(t.w_->get_state() == widget::STATE::ENABLE) {
-						t.w_->update_touch(tp.pos, num);
+				}
+				if(t.poll_ == POLL::HIT) {  // 移動、サイズ変更でグリッドを作り直す
+					auto r = touch_rect_(w);
+					if(r.org != t.rect_.org || r.size != t.rect_.size) {
+						t.rect_ = r;
+						grid_dirty_ = true;
 					}
-					if(t.focus_ != t.w_->get_focus()) {
-						t.focus_ = t.w_->get_focus();
-						t.draw_ = true;
+				}
+				if(st == widget::STATE::ENABLE) {
+					bool call = t.poll_ == POLL::ALWAYS;
+					if(t.poll_ == POLL::HIT) {
+						const auto& ts = w->get_touch_state();
+						call = w->get_focus() || ts.level_ || ts.positive_ || ts.negative_;
 					}
-					if(t.w_->get_title() != t.title_) {  // タイトル変更で再描画
-						t.w_->update_title();  // タイトル更新前処理
-						t.title_ = t.w_->get_title();
-						t.draw_ = true;
+					if(call) {
+						w->update_touch(tp.pos, num);
+						set_bit_(called, idx);
+						++ntouch;
 					}
-					if(t.w_->get_update()) {  // 描画更新リクエス？
-						t.w_->set_update(false);
-						t.draw_ = true;
+					if(call || t.exec_request_ != w->get_exec_request()) {
+						set_bit_(check, idx);
 					}
 				}
+				if(w->get_title() != t.title_) {  // タイトル変更で再描画
+					w->update_title();  // タイトル更新前処理
+					t.title_ = w->get_title();
+					mark_(idx);
+				}
+				if(w->get_update()) {  // 描画更新リクエス？
+					w->set_update(false);
+					mark_(idx);
+				}
+			});
+
+			// タッチ位置のセルにある widget だけ判定する
+			if(grid_dirty_) {
+				rebuild_grid_();
+			}
+			if(static_cast<uint16_t>(tp.pos.x) < static_cast<uint16_t>(GLC::width)
+				&& static_cast<uint16_t>(tp.pos.y) < static_cast<uint16_t>(GLC::height)) {
+				const auto& cell = grid_[(tp.pos.y / CELL_H) * GRID_X + (tp.pos.x / CELL_W)];
+				scan_bits_(cell, [&](uint32_t idx) {
+					if(tst_bit_(called, idx)) return;
+					auto& t = widgets_[idx];
+					auto* w = t.w_;
+					if(w->get_state() != widget::STATE::ENABLE) return;
+					w->update_touch(tp.pos, num);
+					set_bit_(check, idx);
+					++ntouch;
+					if(w->get_update()) {
+						w->set_update(false);
+						mark_(idx);
+					}
+				});
 			}
 
-			for(auto& t : widgets_) {
-				if(t.w_ == nullptr) continue;
-				if(t.w_->get_state() == widget::STATE::ENABLE) {
-					const auto& ts = t.w_->get_touch_state();
-					if(ts.negative_ || t.exec_request_ != t.w_->get_exec_request()) {
-						t.exec_request_ = t.w_->get_exec_request();
-						t.w_->exec_select();
-						current_ = t.w_;
-						t.draw_ = true;
-						if(t.w_->get_id() == widget::ID::RADIO) {  // ラジオボタン、個別案件の処理
-							widget_t* list[16];
-							auto n = create_childs_(t.w_, list, 16, true);  // 自分以外のラジオボタンを集める
-							for(uint16_t i = 0; i < n; ++i) {
-								auto* w = dynamic_cast<radio*>(list[i]->w_);
-								if(w->get_switch_state()) {  // 許可されているボタンを不許可にする。
-									w->exec_select();
-									list[i]->draw_ = true;
-								} else {
-									continue;
-								}
+			scan_bits_(check, [&](uint32_t idx) {
+				auto& t = widgets_[idx];
+				auto* w = t.w_;
+				if(t.focus_ != w->get_focus()) {
+					t.focus_ = w->get_focus();
+					mark_(idx);
+				}
+				if(w->get_state() != widget::STATE::ENABLE) return;
+				const auto& ts = w->get_touch_state();
+				if(ts.negative_ || t.exec_request_ != w->get_exec_request()) {
+					t.exec_request_ = w->get_exec_request();
+					w->exec_select();
+					current_ = w;
+					mark_(idx);
+					if(w->get_id() == widget::ID::RADIO) {  // ラジオボタン、個別案件の処理
+						widget_t* list[16];
+						auto n = create_childs_(w, list, 16, true);  // 自分以外のラジオボタンを集める
+						for(uint16_t i = 0; i < n; ++i) {
+							auto* r = static_cast<radio*>(list[i]->w_);
+							if(r->get_switch_state()) {  // 許可されているボタンを不許可にする。
+								r->exec_select();
+								mark_(list[i] - &widgets_[0]);
 							}
 						}
 					}
-					if(ts.positive_) {
-						t.draw_ = true;
-					}
-					if(ts.level_) {
-						if(t.w_->get_id() == widget::ID::SLIDER) {  // スライダー、個別案件の処理
-							t.draw_ = true;
-						} else if(t.w_->get_id() == widget::ID::MENU) {  // メニュー、個別案件の処理
-							t.draw_ = true;
-						}
+				}
+				if(ts.positive_) {
+					mark_(idx);
+				}
+				if(ts.level_) {
+					if(w->get_id() == widget::ID::SLIDER) {  // スライダー、個別案件の処理
+						mark_(idx);
+					} else if(w->get_id() == widget::ID::MENU) {  // メニュー、個別案件の処理
+						mark_(idx);
 					}
 				}
-			}
+			});
 
+			auto tick1 = tick_();
+
+			// ダーティ・リストの widget だけ描画
 			uint32_t dc = 0;
-			for(auto& t : widgets_) {
-				if(t.w_ == nullptr) continue;
-				if(t.w_->get_state() == widget::STATE::DISABLE) continue;
-				bool draw = false;
+			uint16_t ndraw = 0;
+			scan_bits_(dirty_, [&](uint32_t idx) {
+				auto& t = widgets_[idx];
+				if(t.w_->get_state() == widget::STATE::DISABLE) return;  // 許可されるまで保留
+				clr_bit_(dirty_, idx);
 				if(t.draw_) {
-					draw = true;
 					t.draw_ = false;
 					++dc;
 				}
-				if(t.refresh_) {
-					draw = true;
-					t.refresh_ = false;
-				}
-				if(!draw) continue;
-
-				switch(t.w_->get_id()) {
-				case widget::ID::GROUP:
-					break;
-				case widget::ID::FRAME:
-					{
-						auto* w = dynamic_cast<frame*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::BOX:
-					{
-						auto* w = dynamic_cast<box*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::TEXT:
-					{
-						auto* w = dynamic_cast<text*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::TEXTBOX:
-					{
-						auto* w = dynamic_cast<textbox*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::DIALOG:
-					{
-						auto* w = dynamic_cast<dialog*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::BUTTON:
-					{
-						auto* w = dynamic_cast<button*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::CHECK:
-					{
-						auto* w = dynamic_cast<check*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::RADIO:
-					{
-						auto* w = dynamic_cast<radio*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::SLIDER:
-					{
-						auto* w = dynamic_cast<slider*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::MENU:
-					{
-						auto* w = dynamic_cast<menu*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::TERM:
-					{
-						auto* w = dynamic_cast<term*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::SPINBOX:
-					{
-						auto* w = dynamic_cast<spinbox*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::SPINBOXT:
-					{
-						auto* w = dynamic_cast<spinboxt*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::TOGGLE:
-					{
-						auto* w = dynamic_cast<toggle*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::PROGRESS:
-					{
-						auto* w = dynamic_cast<progress*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::CLOSEBOX:
-					{
-						auto* w = dynamic_cast<closebox*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::FILER:
-					{
-						auto* w = dynamic_cast<filer*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::KEY_ASC:
-					{
-						auto* w = dynamic_cast<key_asc*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				case widget::ID::KEY_10:
-					{
-						auto* w = dynamic_cast<key_10*>(t.w_);
-						if(w == nullptr) break;
-						w->draw(rdr_);
-					}
-					break;
-				default:
-					break;
-				}
-			}
+				t.refresh_ = false;
+				if(t.draw_func_ == nullptr) return;
+
+				if(draw_hook_ != nullptr) draw_hook_(t.w_, false);
+				t.draw_func_(t.w_, rdr_);
+				if(draw_hook_ != nullptr) draw_hook_(t.w_, true);
+				++ndraw;
+			});
+
+			auto tick2 = tick_();
+			++perf_.update;
+			perf_.touch = ntouch;
+			perf_.draw = ndraw;
+			perf_.touch_tick = tick1 - tick0;
+			perf_.draw_tick = tick2 - tick1;
+
 			return dc != 0;
 		}
 
@@ -5,7 +5,8 @@
 			ファミコン内蔵音源と同じような機能を持った波形生成 @n
 			波形をレンダリングして波形バッファに生成する。 @n
 			生成した波形メモリを PWM 変調などで出力する事を前提にしている。 @n
-			分解能は８ビット
+			分解能は８ビット、又は１６ビット（D/A 出力向け） @n
+			矩形波は PolyBLEP により帯域制限する事が出来る。
     @author 平松邦仁 (hira@rvf-rc45.net)
 	@copyright	Copyright (C) 2021, 2025 Kunihito Hiramatsu @n
 				Released under the MIT license @n
@@ -291,12 +292,26 @@ namespace utils {
 		static constexpr uint8_t	SUB_SCORE_NUM = 8;  // サブスコア最大数
 		static constexpr uint8_t	STACK_DEPTH = 4;  // 4 レベル
 		static constexpr uint16_t	ENV_CYCLE = SAMPLE / TICK;
+		static constexpr uint16_t	BLOCK = 64;  // レンダリング・ブロック長
+		static constexpr uint8_t	KEY_NUM = 88;
+
+		// キー番号から位相速度への変換テーブル（演奏中の除算を無くす）
+		struct spd_table_t {
+			uint16_t	spd[KEY_NUM];
+			constexpr spd_table_t() noexcept : spd{ 0 } {
+				for(uint8_t i = 0; i < KEY_NUM; ++i) {
+					spd[i] = key_tbl_[i % 12] >> (7 - (i / 12));
+				}
+			}
+		};
+		static constexpr spd_table_t spd_tbl_ = spd_table_t();
 
 		struct share_t {
 			const SCORE*	sub_score_[SUB_SCORE_NUM];
 			bool			pause_;
+			bool			blep_;
 			share_t() noexcept :
-				sub_score_{ nullptr }, pause_(false)
+				sub_score_{ nullptr }, pause_(false), blep_(false)
 			{ }
 		};
 		share_t		share_;
@@ -400,6 +415,107 @@ namespace utils {
 				acc_ += spd_;
 			}
 
+			void step_env_() noexcept
+			{
+				if(rel_count_ > 0) {
+					rel_count_--;
+					// +エンベロープ
+					env_ += static_cast<uint16_t>((volume_ - env_) * attack_) >> 8;
+				} else {
+					// -エンベロープ
+					uint8_t n = static_cast<uint16_t>(env_ * release_) >> 8;
+					if(n > 0) env_ -= n;
+					else {
+						if(env_ > 0) --env_;
+					}
+				}
+			}
+
+			// 位相 x（0 ~ 65535 で１周期）の立ち上がりエッジに対する PolyBLEP 補正値（Q15）
+			int32_t blep_(uint16_t x) const noexcept
+			{
+				int32_t dt = spd_;
+				if(x < dt) {
+					int32_t r = (static_cast<int32_t>(x) << 15) / dt;
+					return r + r - ((r * r) >> 15) - 32768;
+				} else if(x > (65536 - dt)) {
+					int32_t r = ((static_cast<int32_t>(x) - 65536) << 15) / dt;
+					return ((r * r) >> 15) + r + r + 32768;
+				}
+				return 0;
+			}
+
+			//-------------------------------------------------------------//
+			/*!
+				@brief  ブロック・レンダリング（８ビット振幅を２５６倍したスケールで加算）
+				@param[in]	out		加算先
+				@param[in]	len		サンプル数
+				@param[in]	blep	帯域制限を行う場合「true」
+			*/
+			//-------------------------------------------------------------//
+			void render(int32_t* out, uint16_t len, bool blep) noexcept
+			{
+				if(spd_ == 0) return;
+
+				while(len > 0) {
+					// エンベロープが変化しない区間をまとめて処理
+					uint16_t run = ENV_CYCLE - env_cycle_;
+					if(run > len) run = len;
+					switch(wtype_) {
+					case WTYPE::SQ25:
+					case WTYPE::SQ50:
+					case WTYPE::SQ75:
+						{
+							// 矩形波は、三角波に比べて、音圧が高いので、バランスを取る為少し弱める。
+							int32_t amp = static_cast<int32_t>(env_ - (env_ >> 3)) << 8;
+							uint16_t edge = 0xc000;
+							if(wtype_ == WTYPE::SQ50) edge = 0x8000;
+							else if(wtype_ == WTYPE::SQ75) edge = 0x4000;
+							for(uint16_t i = 0; i < run; ++i) {
+								acc_ += spd_;
+								int32_t w = (acc_ & 0xc000) >= edge ? amp : -amp;
+								if(blep) {
+									int32_t c = blep_(acc_ - edge) - blep_(acc_);
+									if(c != 0) w += (amp * c) >> 15;
+								}
+								out[i] += w;
+							}
+						}
+						break;
+					case WTYPE::TRI:
+						{
+							int32_t step = env_ >> 3;
+							int32_t amp = step * 7;
+							for(uint16_t i = 0; i < run; ++i) {
+								acc_ += spd_;
+								int32_t w;
+								if(blep) {  // 階段状では無い直線の三角波
+									uint16_t q = acc_ & 0x7fff;
+									if(q >= 0x4000) q = 0x8000 - q;
+									w = (amp * q) >> 6;
+								} else {
+									w = (acc_ >> 11) & 0b111;
+									if((acc_ & 0x4000) != 0) w ^= 0b111;
+									w = (w * step) << 8;
+								}
+								out[i] += (acc_ & 0x8000) != 0 ? w : -w;
+							}
+						}
+						break;
+					case WTYPE::NOISE:
+						acc_ += spd_ * run;
+						break;
+					}
+					out += run;
+					len -= run;
+					env_cycle_ += run;
+					if(env_cycle_ >= ENV_CYCLE) {
+						env_cycle_ = 0;
+						step_env_();
+					}
+				}
+			}
+
 			int8_t get() noexcept
 			{
 				if(spd_ == 0) return 0;
@@ -441,24 +557,15 @@ namespace utils {
 				++env_cycle_;
 				if(env_cycle_ >= ENV_CYCLE) {
 					env_cycle_ = 0;
-					if(rel_count_ > 0) {
-						rel_count_--;
-						// +エンベロープ
-						env_ += static_cast<uint16_t>((volume_ - env_) * attack_) >> 8;
-					} else {
-						// -エンベロープ
-						uint8_t n = static_cast<uint16_t>(env_ * release_) >> 8;
-						if(n > 0) env_ -= n;
-						else {
-							if(env_ > 0) --env_;
-						}
-					}
+					step_env_();
 				}
 				return w;
 			}
 
 			void set_freq(uint16_t frq) noexcept { spd_ = (static_cast<uint32_t>(frq) << 16) / SAMPLE; }
 
+			void set_key(uint8_t key) noexcept { spd_ = spd_tbl_.spd[key]; }
+
 			// 完了なら「true」
 			bool service() noexcept
 			{
@@ -487,10 +594,8 @@ namespace utils {
 				if(v.key < KEY::Q) {
 					v.len += tr_;
 					if(v.len >= 0x80) v.len = 0;
-					else if(v.len >= 88) v.len = 87;
-					auto o = v.len / 12;
-					auto k = v.len % 12;
-					spd_ = key_tbl_[k] >> (7 - o);
+					else if(v.len >= KEY_NUM) v.len = KEY_NUM - 1;
+					set_key(v.len);
 					acc_ = 0;
 					env_ = 0;
 					total_count_ += score_org_[score_pos_].len;
@@ -611,6 +716,34 @@ namespace utils {
 
 		channel		channel_[CNUM];
 
+		template <typename T>
+		void render_(uint16_t count, T* out, uint8_t shift) noexcept
+		{
+			// int8_t n = 0;
+			int32_t n = 1;  // 理由がイマイチ判らないが、フルスケールで合成するとノイズが乗るので、とりあえず、全体のゲインを下げる。
+			// ノイズが乗る原因は、そもそも PWM 変調に問題があるのかもしれない・・
+			for(uint8_t j = 0; j < CNUM; ++j) {
+				if(channel_[j].score_org_ != nullptr) ++n;
+			}
+			// サンプル毎の除算を避け、逆数の乗算で正規化する。
+			const int32_t recip = (1 << 14) / n;
+			int32_t tmp[BLOCK];
+			while(count > 0) {
+				uint16_t len = count < BLOCK ? count : BLOCK;
+				for(uint16_t i = 0; i < len; ++i) tmp[i] = 0;
+				for(uint8_t j = 0; j < CNUM; ++j) {
+					if(channel_[j].score_org_ != nullptr) {
+						channel_[j].render(tmp, len, share_.blep_);
+					}
+				}
+				for(uint16_t i = 0; i < len; ++i) {
+					out[i] = static_cast<T>((tmp[i] * recip) >> shift);
+				}
+				out += len;
+				count -= len;
+			}
+		}
+
 	public:
 		//-----------------------------------------------------------------//
 		/*!
@@ -675,10 +808,8 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		void set_key(uint8_t ch, KEY key) noexcept
 		{
-			if(ch >= CNUM) return;
-			auto o = static_cast<uint8_t>(key) / 12;
-			auto k = static_cast<uint8_t>(key) % 12;
-			channel_[ch].spd_ = key_tbl_[k] >> (7 - o);
+			if(ch >= CNUM || key >= KEY::Q) return;
+			channel_[ch].set_key(static_cast<uint8_t>(key));
 			channel_[ch].acc_ = 0;
 		}
 
@@ -692,23 +823,33 @@ namespace utils {
 		//-----------------------------------------------------------------//
 		void render(uint16_t count, int8_t* out) noexcept
 		{
-			for(uint16_t i = 0; i < count; ++i) {
-				int16_t sum = 0;
-				// int8_t n = 0;
-				int8_t n = 1;  // 理由がイマイチ判らないが、フルスケールで合成するとノイズが乗るので、とりあえず、全体のゲインを下げる。
-				// ノイズが乗る原因は、そもそも PWM 変調に問題があるのかもしれない・・
-				for(uint8_t j = 0; j < CNUM; ++j) {
-					if(channel_[j].score_org_ != nullptr) {
-						channel_[j].update();
-						sum += static_cast<int16_t>(channel_[j].get());
-						++n;
-					}
-				}
-				out[i] = (sum / n);
-			}
+			render_(count, out, 14 + 8);
 		}
 
 
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  レンダリング（１６ビット出力、D/A 向け）
+			@param[in]	count	波形数
+			@param[out]	out		波形出力
+		*/
+		//-----------------------------------------------------------------//
+		void render(uint16_t count, int16_t* out) noexcept
+		{
+			render_(count, out, 14);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  帯域制限（PolyBLEP）の許可 @n
+					矩形波のエイリアスを抑え、三角波は直線補間になる。
+			@param[in]	ena		「false」を指定すると従来の波形
+		*/
+		//-----------------------------------------------------------------//
+		void enable_blep(bool ena = true) noexcept { share_.blep_ = ena; }
+
+
 		//-----------------------------------------------------------------//
 		/*!
 			@brief  スコアの設定
@@ -785,4 +926,6 @@ namespace utils {
 
 	template<uint16_t SAMPLE, uint16_t TICK, uint16_t CNUM>
 		constexpr uint16_t psg_mng<SAMPLE, TICK, CNUM>::key_tbl_[12];
+	template<uint16_t SAMPLE, uint16_t TICK, uint16_t CNUM>
+		constexpr typename psg_mng<SAMPLE, TICK, CNUM>::spd_table_t psg_mng<SAMPLE, TICK, CNUM>::spd_tbl_;
 }
\ No newline at end of file
@@ -202,6 +202,23 @@ void Dx7Note::compute(int32_t *buf, int32_t lfo_val, int32_t lfo_delay,
   core_.compute(buf, params_, algorithm_, fb_buf_, fb_shift_);
 }
 
+bool Dx7Note::isPlaying() const {
+  for (int op = 0; op < 6; op++) {
+    if (env_[op].isActive() || params_[op].gain[1] >= FmCore::kLevelThresh) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int32_t Dx7Note::getLevel() const {
+  int32_t level = 0;
+  for (int op = 0; op < 6; op++) {
+    level = max(level, params_[op].gain[1]);
+  }
+  return level;
+}
+
 void Dx7Note::keyup() {
   for (int op = 0; op < 6; op++) {
     env_[op].keydown(false);
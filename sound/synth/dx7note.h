@@ -38,12 +38,12 @@ class Dx7Note {
 
   void keyup();
 
-  // TODO: parameter changes
+  // True while any envelope is still moving or any operator is audible.
+  // Valid after the first compute(); the voice can be recycled once false.
+  bool isPlaying() const;
 
-  // TODO: some way of indicating end-of-note. Maybe should be a return
-  // value from the compute method? (Having a count return from keyup
-  // is also tempting, but if there's a dynamic parameter change after
-  // keyup, that won't work.
+  // Largest operator gain of the last block, used to pick a voice to steal.
+  int32_t getLevel() const;
 
  private:
   FmCore core_;
@@ -38,6 +38,10 @@ class Env {
   int32_t getsample();
 
   void keydown(bool down);
+
+  // False once the release segment has reached its target level.
+  bool isActive() const { return ix_ < 4; }
+
   void setparam(int param, int value);
   static int scaleoutlevel(int outlevel);
  private:
@@ -109,7 +109,6 @@ void FmCore::dump() {
 
 void FmCore::compute(int32_t *output, FmOpParams *params, int algorithm,
                      int32_t *fb_buf, int32_t feedback_shift) {
-  const int kLevelThresh = 1120;
   const FmAlgorithm alg = algorithms[algorithm];
   bool has_contents[3] = { true, false, false };
   for (int op = 0; op < 6; op++) {
@@ -27,6 +27,9 @@ struct FmOpParams {
 
 class FmCore {
  public:
+  // Operators whose gain stays below this are skipped entirely.
+  static const int32_t kLevelThresh = 1120;
+
   static void dump();
   void compute(int32_t *output, FmOpParams *params, int algorithm,
                int32_t *fb_buf, int32_t feedback_gain);
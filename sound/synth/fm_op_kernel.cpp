@@ -151,66 +151,77 @@ const int32_t __attribute__ ((aligned(16))) zeros[N] = {0};
 
 #endif
 
+// Q24 sine times the Q24 gain, (y * gain) >> 24.
+// On RXv2/v3 the product goes through the DSP accumulator A0: EMULA makes
+// the 64-bit product of (y << 6) and gain, and MVFACHI #2 takes bits 61..30
+// of it, which is exactly (y * gain) >> 24 (|y| <= 2^24, so y << 6 fits).
+// This replaces EMUL and a 64-bit shift per sample. The compiler never
+// allocates the accumulators, so nothing else needs saving here; an ISR
+// that used A0 would have to save it.
+static inline int32_t mul_gain(int32_t y, int32_t gain) {
+#if defined(__RXv2__) || defined(__RXv3__)
+  int32_t r;
+  __asm__ volatile ("emula %1, %2, a0\n\tmvfachi #2, a0, %0"
+    : "=r" (r) : "r" (y << 6), "r" (gain));
+  return r;
+#else
+  return ((int64_t)y * (int64_t)gain) >> 24;
+#endif
+}
+
+// One operator over a whole block. 'add' and the presence of a modulator
+// input are template parameters, so each combination is one straight loop
+// without per-sample tests; the loop is unrolled by four (SYNTH_N is a
+// multiple of four).
+template <bool ADD, bool INPUT>
+static inline void op_block(int32_t *output, const int32_t *input,
+                            int32_t phase, int32_t freq,
+                            int32_t gain, int32_t dgain) {
+  for (int i = 0; i < SYNTH_N; i += 4) {
+    for (int j = 0; j < 4; j++) {
+      gain += dgain;
+      int32_t y = Sin::lookup(INPUT ? phase + input[i + j] : phase);
+      y = mul_gain(y, gain);
+      if (ADD) {
+        output[i + j] += y;
+      } else {
+        output[i + j] = y;
+      }
+      phase += freq;
+    }
+  }
+}
+
 void FmOpKernel::compute(int32_t *output, const int32_t *input,
                          int32_t phase0, int32_t freq,
                          int32_t gain1, int32_t gain2, bool add) {
   int32_t dgain = (gain2 - gain1 + (SYNTH_N >> 1)) >> SYNTH_LG_N;
-  int32_t gain = gain1;
-  int32_t phase = phase0;
   if (hasNeon()) {
 #ifdef HAVE_NEON_INTRINSICS
     neon_fm_kernel(input, add ? output : zeros, output, N,
-      phase0, freq, gain, dgain);
+      phase0, freq, gain1, dgain);
 #endif
+  } else if (add) {
+    op_block<true, true>(output, input, phase0, freq, gain1, dgain);
   } else {
-    if (add) {
-      for (int i = 0; i < SYNTH_N; i++) {
-        gain += dgain;
-        int32_t y = Sin::lookup(phase + input[i]);
-        output[i] += ((int64_t)y * (int64_t)gain) >> 24;
-        phase += freq;
-      }
-    } else {
-      for (int i = 0; i < SYNTH_N; i++) {
-        gain += dgain;
-        int32_t y = Sin::lookup(phase + input[i]);
-        output[i] = ((int64_t)y * (int64_t)gain) >> 24;
-        phase += freq;
-      }
-    }
+    op_block<false, true>(output, input, phase0, freq, gain1, dgain);
   }
 }
 
-#if 1
 void FmOpKernel::compute_pure(int32_t *output, int32_t phase0, int32_t freq,
                               int32_t gain1, int32_t gain2, bool add) {
   int32_t dgain = (gain2 - gain1 + (SYNTH_N >> 1)) >> SYNTH_LG_N;
-  int32_t gain = gain1;
-  int32_t phase = phase0;
   if (hasNeon()) {
 #ifdef HAVE_NEON_INTRINSICS
     neon_fm_kernel(zeros, add ? output : zeros, output, N,
-      phase0, freq, gain, dgain);
+      phase0, freq, gain1, dgain);
 #endif
+  } else if (add) {
+    op_block<true, false>(output, nullptr, phase0, freq, gain1, dgain);
   } else {
-    if (add) {
-      for (int i = 0; i < SYNTH_N; i++) {
-        gain += dgain;
-        int32_t y = Sin::lookup(phase);
-        output[i] += ((int64_t)y * (int64_t)gain) >> 24;
-        phase += freq;
-      }
-    } else {
-      for (int i = 0; i < SYNTH_N; i++) {
-        gain += dgain;
-        int32_t y = Sin::lookup(phase);
-        output[i] = ((int64_t)y * (int64_t)gain) >> 24;
-        phase += freq;
-      }
-    }
+    op_block<false, false>(output, nullptr, phase0, freq, gain1, dgain);
   }
 }
-#endif
 
 #define noDOUBLE_ACCURACY
 #define HIGH_ACCURACY
@@ -361,8 +372,7 @@ void FmOpKernel::compute_fb(int32_t *output, int32_t phase0, int32_t freq,
       gain += dgain;
       int32_t scaled_fb = (y0 + y) >> (fb_shift + 1);
       y0 = y;
-      y = Sin::lookup(phase + scaled_fb);
-      y = ((int64_t)y * (int64_t)gain) >> 24;
+      y = mul_gain(Sin::lookup(phase + scaled_fb), gain);
       output[i] += y;
       phase += freq;
     }
@@ -371,8 +381,7 @@ void FmOpKernel::compute_fb(int32_t *output, int32_t phase0, int32_t freq,
       gain += dgain;
       int32_t scaled_fb = (y0 + y) >> (fb_shift + 1);
       y0 = y;
-      y = Sin::lookup(phase + scaled_fb);
-      y = ((int64_t)y * (int64_t)gain) >> 24;
+      y = mul_gain(Sin::lookup(phase + scaled_fb), gain);
       output[i] = y;
       phase += freq;
     }
@@ -50,7 +50,9 @@ int32_t Sin::lookup(int32_t phase) {
   int dy = sintab[phase_int];
   int y0 = sintab[phase_int + 1];
 
-  return y0 + (((int64_t)dy * (int64_t)lowbits) >> SHIFT);
+  // |dy| < 2^17 (Q24 sine, 1024 steps) and lowbits < 2^14, so the product
+  // fits in 32 bits; avoids a 64-bit multiply/shift per sample on RX.
+  return y0 + ((dy * lowbits) >> SHIFT);
 #else
   int phase_int = (phase >> SHIFT) & (SIN_N_SAMPLES - 1);
   int y0 = sintab[phase_int];
@@ -53,11 +53,16 @@ void SynthUnit::init_()
     active_note_[note].keydown = false;
     active_note_[note].sustained = false;
     active_note_[note].live = false;
+    active_note_[note].age = 0;
   }
   input_buffer_index_ = 0;
   memcpy(patch_data_, epiano, sizeof(epiano));
   ProgramChange(0);
   current_note_ = 0;
+  note_age_ = 0;
+  voice_limit_ = max_active_notes;
+  live_voices_ = 0;
+  steal_count_ = 0;
   filter_control_[0] = 258847126;
   filter_control_[1] = 0;
   filter_control_[2] = 0;
@@ -98,15 +103,45 @@ void SynthUnit::ConsumeInput(int n_input_bytes) {
 }
 
 int SynthUnit::AllocateNote() {
-  int note = current_note_;
-  for (int i = 0; i < max_active_notes; i++) {
-    if (!active_note_[note].keydown) {
-      current_note_ = (note + 1) % max_active_notes;
-      return note;
+  if (live_voices_ < voice_limit_) {
+    int note = current_note_;
+    for (int i = 0; i < max_active_notes; i++) {
+      if (!active_note_[note].live) {
+        current_note_ = (note + 1) % max_active_notes;
+        return note;
+      }
+      note = (note + 1) % max_active_notes;
+    }
+  }
+  return StealNote();
+}
+
+int SynthUnit::StealNote() {
+  // Released voices first, quietest wins; otherwise the oldest held note.
+  int released = -1;
+  int32_t released_level = 0;
+  int held = -1;
+  for (int note = 0; note < max_active_notes; ++note) {
+    const ActiveNote &an = active_note_[note];
+    if (!an.live) continue;
+    if (!an.keydown && !an.sustained) {
+      int32_t level = an.dx7_note->getLevel();
+      if (released < 0 || level < released_level) {
+        released = note;
+        released_level = level;
+      }
+    } else if (held < 0 ||
+        (int32_t)(an.age - active_note_[held].age) < 0) {
+      held = note;
     }
-    note = (note + 1) % max_active_notes;
   }
-  return -1;
+  int note = released >= 0 ? released : held;
+  if (note >= 0) {
+    active_note_[note].live = false;
+    --live_voices_;
+    ++steal_count_;
+  }
+  return note;
 }
 
 void SynthUnit::ProgramChange(int p) {
@@ -149,8 +184,10 @@ int SynthUnit::ProcessMidiMessage(const uint8_t *buf, int buf_size) {
         lfo_.keydown();  // TODO: should only do this if # keys down was 0
         active_note_[note_ix].midi_note = buf[1];
         active_note_[note_ix].keydown = true;
-        active_note_[note_ix].sustained = sustain_;
+        active_note_[note_ix].sustained = false;
         active_note_[note_ix].live = true;
+        active_note_[note_ix].age = note_age_++;
+        ++live_voices_;
         active_note_[note_ix].dx7_note->init(unpacked_patch_, buf[1], buf[2]);
       }
       return 3;
@@ -266,9 +303,15 @@ void SynthUnit::GetSamples(int n_samples, int16_t *buffer) {
     int32_t lfovalue = lfo_.getsample();
     int32_t lfodelay = lfo_.getdelay();
     for (int note = 0; note < max_active_notes; ++note) {
-      if (active_note_[note].live) {
-        active_note_[note].dx7_note->compute(audiobuf.get(), lfovalue, lfodelay,
+      ActiveNote &an = active_note_[note];
+      if (an.live) {
+        an.dx7_note->compute(audiobuf.get(), lfovalue, lfodelay,
           &controllers_);
+        // Finished voices drop out so they cost nothing until reused.
+        if (!an.keydown && !an.sustained && !an.dx7_note->isPlaying()) {
+          an.live = false;
+          --live_voices_;
+        }
       }
     }
     const int32_t *bufs[] = { audiobuf.get() };
@@ -26,6 +26,7 @@ struct ActiveNote {
   bool keydown;
   bool sustained;
   bool live;
+  uint32_t age;
   Dx7Note *dx7_note;
 };
 
@@ -51,6 +52,33 @@ class SynthUnit {
 		dst[10] = 0;
 		return true;
 	} 
+
+  // Polyphony control. The voice limit caps how many voices render at once;
+  // note-on beyond it steals a voice (released and quietest first, then the
+  // oldest held note). Lowering the limit below the live voices steals the
+  // excess at once, in the same order.
+  static int GetMaxVoices() { return max_active_notes; }
+  void SetVoiceLimit(int limit) {
+    // Copy first: min() takes references, which would odr-use the
+    // in-class constant that has no definition.
+    const int n = max_active_notes;
+    voice_limit_ = max(1, min(limit, n));
+    while (live_voices_ > voice_limit_ && StealNote() >= 0) { }
+  }
+  int GetVoiceLimit() const { return voice_limit_; }
+
+  // Feed the measured CPU load of GetSamples (percent of real time); the
+  // voice limit follows the budget with some hysteresis.
+  void AdjustVoiceLimit(int load, int budget) {
+    if (load > budget) {
+      SetVoiceLimit(voice_limit_ - 1);
+    } else if (load < (budget * 3 / 4) && live_voices_ >= voice_limit_) {
+      SetVoiceLimit(voice_limit_ + 1);
+    }
+  }
+
+  int GetLiveVoices() const { return live_voices_; }
+  uint32_t GetStealCount() const { return steal_count_; }
  private:
   void TransferInput();
 
@@ -60,6 +88,9 @@ class SynthUnit {
   // none available.
   int AllocateNote();
 
+  // Pick a sounding voice to reuse when the voice limit is reached.
+  int StealNote();
+
   // zero-based
   void ProgramChange(int p);
 
@@ -78,6 +109,10 @@ class SynthUnit {
 #endif
   ActiveNote active_note_[max_active_notes];
   int current_note_;
+  uint32_t note_age_;
+  int voice_limit_;
+  int live_voices_;
+  uint32_t steal_count_;
   uint8_t input_buffer_[8192];
   size_t input_buffer_index_;
 
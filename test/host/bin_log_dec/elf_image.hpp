@@ -0,0 +1,138 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ELF イメージ（ホスト用） @n
+			ELF32/ELF64（リトルエンディアン）のアロケート・セクションを読み込み、 @n
+			アドレスから文字列を参照する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <elf.h>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  ELF イメージ・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class elf_image {
+
+		struct section_t {
+			std::string		name;
+			uint64_t		addr;
+			std::vector<char>	data;
+		};
+
+		std::vector<section_t>	secs_;
+
+		template <class EHDR, class SHDR>
+		bool load_(const std::vector<char>& img) noexcept
+		{
+			if(img.size() < sizeof(EHDR)) return false;
+			EHDR eh;
+			memcpy(&eh, img.data(), sizeof(eh));
+			if(eh.e_shoff == 0 || eh.e_shentsize != sizeof(SHDR)) return false;
+			if((eh.e_shoff + eh.e_shnum * sizeof(SHDR)) > img.size()) return false;
+
+			std::vector<SHDR> shs(eh.e_shnum);
+			memcpy(shs.data(), &img[eh.e_shoff], eh.e_shnum * sizeof(SHDR));
+			const char* strs = nullptr;
+			if(eh.e_shstrndx < eh.e_shnum && (shs[eh.e_shstrndx].sh_offset < img.size())) {
+				strs = &img[shs[eh.e_shstrndx].sh_offset];
+			}
+			for(const auto& sh : shs) {
+				if(sh.sh_type != SHT_PROGBITS || (sh.sh_flags & SHF_ALLOC) == 0) continue;
+				if(sh.sh_size == 0 || (sh.sh_offset + sh.sh_size) > img.size()) continue;
+				section_t s;
+				if(strs != nullptr) s.name = &strs[sh.sh_name];
+				s.addr = sh.sh_addr;
+				s.data.assign(&img[sh.sh_offset], &img[sh.sh_offset + sh.sh_size]);
+				secs_.push_back(std::move(s));
+			}
+			return true;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		elf_image() noexcept : secs_() { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ELF ファイルの読み込み
+			@param[in]	file	ファイル名
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool load(const char* file) noexcept
+		{
+			auto fp = fopen(file, "rb");
+			if(fp == nullptr) return false;
+			std::vector<char> img;
+			char tmp[4096];
+			size_t n;
+			while((n = fread(tmp, 1, sizeof(tmp), fp)) > 0) {
+				img.insert(img.end(), tmp, tmp + n);
+			}
+			fclose(fp);
+
+			secs_.clear();
+			if(img.size() < EI_NIDENT || memcmp(img.data(), ELFMAG, SELFMAG) != 0) return false;
+			if(img[EI_DATA] != ELFDATA2LSB) return false;
+			if(img[EI_CLASS] == ELFCLASS32) {
+				return load_<Elf32_Ehdr, Elf32_Shdr>(img);
+			} else if(img[EI_CLASS] == ELFCLASS64) {
+				return load_<Elf64_Ehdr, Elf64_Shdr>(img);
+			}
+			return false;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	アドレスの文字列を参照
+			@param[in]	addr	アドレス
+			@return 文字列（無い、又は終端が無い場合 nullptr）
+		*/
+		//-----------------------------------------------------------------//
+		const char* get_str(uint64_t addr) const noexcept
+		{
+			for(const auto& s : secs_) {
+				if(addr < s.addr || addr >= (s.addr + s.data.size())) continue;
+				auto ofs = addr - s.addr;
+				if(memchr(&s.data[ofs], 0, s.data.size() - ofs) == nullptr) return nullptr;
+				return &s.data[ofs];
+			}
+			return nullptr;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	名前が「.bin_log」で始まるセクションの数を取得
+			@return セクションの数
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_log_section_num() const noexcept
+		{
+			uint32_t n = 0;
+			for(const auto& s : secs_) {
+				if(s.name.compare(0, 8, ".bin_log") == 0) ++n;
+			}
+			return n;
+		}
+	};
+}
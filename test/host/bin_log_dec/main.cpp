@@ -0,0 +1,221 @@
+//=========================================================================//
+/*! @file
+    @brief  バイナリ・ログ・デコーダー（ホスト用） @n
+			utils::bin_log が出力したレコード列を、ELF のフォーマット文字列を使い @n
+			テキストに戻す。 @n
+			フォーマットは utils::format（実行時フォーマット）で行うので、ターゲットで @n
+			utils::format を使った場合と同じ表示になる。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "common/format.hpp"
+
+#include "elf_image.hpp"
+
+namespace {
+
+	static constexpr uint8_t  MARK = 0xA5;
+	static constexpr uint32_t HEAD_SIZE = 10;
+
+	utils::elf_image	elf_;
+	double				freq_ = 0.0;
+
+	uint32_t	records_ = 0;
+	uint32_t	skip_ = 0;
+
+	uint32_t get32_(const uint8_t* p) noexcept
+	{
+		return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+			| (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+	}
+
+	bool is_conv_(char ch) noexcept
+	{
+		switch(ch) {
+		case 's': case 'c': case 'd': case 'i': case 'u': case 'x': case 'X':
+		case 'y': case 'p': case '%': case 'b': case 'o':
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// 引数を取る変換文字の列
+	bool scan_conv_(const char* form, std::vector<char>& convs) noexcept
+	{
+		convs.clear();
+		while(*form != 0) {
+			if(*form++ != '%') continue;
+			while(*form != 0 && !is_conv_(*form)) ++form;
+			if(*form == 0) return false;
+			if(*form != '%') convs.push_back(*form);
+			++form;
+		}
+		return true;
+	}
+
+	bool is_float_(char conv) noexcept
+	{
+		switch(conv) {
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	// 引数領域のサイズを検査
+	bool check_args_(const std::vector<char>& convs, const uint8_t* p, uint32_t len) noexcept
+	{
+		uint32_t pos = 0;
+		for(auto c : convs) {
+			if(c == 's') {
+				if(pos >= len) return false;
+				pos += 1 + p[pos];
+			} else if(c == 'c') {
+				++pos;
+			} else {
+				pos += 4;
+			}
+			if(pos > len) return false;
+		}
+		return pos == len;
+	}
+
+	void render_(const char* form, const std::vector<char>& convs, const uint8_t* p) noexcept
+	{
+		utils::format f(form);
+		for(auto c : convs) {
+			if(c == 's') {
+				uint32_t l = *p++;
+				std::string s(reinterpret_cast<const char*>(p), l);
+				f % s;
+				p += l;
+			} else if(c == 'c') {
+				f % static_cast<char>(*p++);
+			} else {
+				auto v = get32_(p);
+				p += 4;
+				if(is_float_(c)) {
+					float a;
+					memcpy(&a, &v, 4);
+					f % a;
+				} else if(c == 'd' || c == 'i' || c == 'y') {
+					f % static_cast<int32_t>(v);
+				} else if(c == 'p') {
+					f % reinterpret_cast<const void*>(static_cast<uintptr_t>(v));
+				} else {
+					f % v;
+				}
+			}
+		}
+	}
+
+	// レコードを処理して、処理したバイト数を返す（データ不足なら０）
+	uint32_t decode_(const uint8_t* p, uint32_t len) noexcept
+	{
+		if(p[0] != MARK) return 1;
+		if(len < 2) return 0;
+		uint32_t rlen = p[1];
+		if(rlen < HEAD_SIZE) return 1;
+		if(rlen > len) return 0;
+
+		auto form = elf_.get_str(get32_(&p[2]));
+		if(form == nullptr) return 1;
+		std::vector<char> convs;
+		if(!scan_conv_(form, convs)) return 1;
+		if(!check_args_(convs, &p[HEAD_SIZE], rlen - HEAD_SIZE)) return 1;
+
+		auto t = get32_(&p[6]);
+		if(freq_ > 0.0) {
+			utils::format("%12.6f: ") % (static_cast<double>(t) / freq_);
+		} else {
+			utils::format("%10u: ") % t;
+		}
+		render_(form, convs, &p[HEAD_SIZE]);
+		++records_;
+		return rlen;
+	}
+
+	void usage_(const char* cmd) noexcept
+	{
+		utils::format("Binary log decoder\n");
+		utils::format("usage: %s [-freq N] elf-file [log-file]\n") % cmd;
+		utils::format("    -freq N   timestamp frequency [Hz] (display in seconds)\n");
+		utils::format("    log-file  record stream (stdin if omitted)\n");
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	const char* elf = nullptr;
+	const char* log = nullptr;
+	for(int i = 1; i < argc; ++i) {
+		if(strcmp(argv[i], "-freq") == 0 && (i + 1) < argc) {
+			freq_ = strtod(argv[i + 1], nullptr);
+			++i;
+		} else if(argv[i][0] != '-' && elf == nullptr) {
+			elf = argv[i];
+		} else if(argv[i][0] != '-' && log == nullptr) {
+			log = argv[i];
+		} else {
+			usage_(argv[0]);
+			return 1;
+		}
+	}
+	if(elf == nullptr) {
+		usage_(argv[0]);
+		return 1;
+	}
+
+	if(!elf_.load(elf)) {
+		utils::format("ELF load error: '%s'\n") % elf;
+		return 1;
+	}
+	if(elf_.get_log_section_num() == 0) {
+		fprintf(stderr, "Warning: '.bin_log' section not found in '%s'\n", elf);
+	}
+
+	auto fp = stdin;
+	if(log != nullptr) {
+		fp = fopen(log, "rb");
+		if(fp == nullptr) {
+			utils::format("Log open error: '%s'\n") % log;
+			return 1;
+		}
+	}
+
+	// ストリーム（シリアルなど）でも処理出来るように、少しずつ読む
+	std::vector<uint8_t> buf;
+	uint8_t tmp[1024];
+	size_t n;
+	while((n = fread(tmp, 1, sizeof(tmp), fp)) > 0) {
+		buf.insert(buf.end(), tmp, tmp + n);
+		uint32_t pos = 0;
+		while(pos < buf.size()) {
+			auto l = decode_(&buf[pos], buf.size() - pos);
+			if(l == 0) break;
+			if(l == 1) ++skip_;
+			pos += l;
+		}
+		buf.erase(buf.begin(), buf.begin() + pos);
+		fflush(stdout);
+	}
+	skip_ += buf.size();
+
+	if(fp != stdin) fclose(fp);
+
+	fprintf(stderr, "Records: %u, Skip: %u [bytes]\n", records_, skip_);
+}
@@ -0,0 +1,202 @@
+//=========================================================================//
+/*! @file
+    @brief  CAN 通信解析の検証（ホスト用） @n
+			utils::can_analize に、疑似的な CAN バスのフレームを流して、集計を調べる。 @n
+			・TS（１６ビット、１ビット時間毎）の一周より長い周期の ID の到着間隔 @n
+			・メインループが TS の一周より長く止まった場合、３２ビットの時間基準 @n
+			  （CMT のカウンター）で周回を補い、止まった回数を数えるか @n
+			・TS だけで追う service() では、止まった分の時間が失われる事 @n
+			・表が一杯の場合、フィルター、ID の削除
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cmath>
+#include <deque>
+
+#include "common/can_analize.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr uint32_t SPEED = 1'000'000;	// 1Mbps（TS は約 65.5ms で一周）
+	static constexpr uint32_t TICK = 100;			// CMT の周期 [Hz]
+
+	// can_analize が使う can_io の関数だけを持つ、疑似的な CAN
+	class can_sim {
+		uint64_t	time_;	// ビット時間
+		std::deque<device::can_frame>	recv_;
+
+	public:
+		can_sim() : time_(0), recv_() { }
+
+		void clear() { time_ = 12345; recv_.clear(); }
+
+		uint64_t get_time() const { return time_; }
+
+		void step(uint64_t bits) { time_ += bits; }
+
+		void recv(uint32_t id, uint8_t d0)
+		{
+			device::can_frame frm;
+			frm.set_id(id);
+			frm.set_DLC(1);
+			frm.set_DATA(0, d0);
+			frm.set_TS(static_cast<uint16_t>(time_));
+			recv_.push_back(frm);
+		}
+
+		uint32_t get_recv_num() const { return recv_.size(); }
+
+		device::can_frame get_recv_frame()
+		{
+			auto frm = recv_.front();
+			recv_.pop_front();
+			return frm;
+		}
+
+		uint16_t get_time_stamp() const { return static_cast<uint16_t>(time_); }
+
+		uint32_t get_speed() const { return SPEED; }
+	};
+
+	can_sim		can_;
+
+	typedef utils::can_analize<can_sim, 16> ANALIZE;
+
+	struct id_t {
+		uint32_t	id;
+		uint32_t	ms;		// 周期
+		uint32_t	ofs;	// 最初のフレームの時間
+	};
+	static constexpr id_t ids_[] = {
+		{ 0x100,  10, 1 },
+		{ 0x200, 100, 3 },
+		{ 0x7df, 500, 7 },
+	};
+	// TS の一周より長い周期だけ（フレームの間で TS が一周する）
+	static constexpr uint32_t SPARSE = 1;
+	static constexpr uint32_t ALL = 0;
+
+	// 1ms 毎にバスを進め、10ms 毎に service を呼ぶ（stall の間は呼ばない）
+	void run_(ANALIZE& ana, uint32_t top, uint32_t ms, uint32_t stall_every, uint32_t stall_ms, bool tick)
+	{
+		can_.clear();
+		uint32_t stall = 0;
+		for(uint32_t t = 0; t < ms; ++t) {
+			for(uint32_t n = top; n < (sizeof(ids_) / sizeof(ids_[0])); ++n) {
+				const auto& i = ids_[n];
+				if(t >= i.ofs && ((t - i.ofs) % i.ms) == 0) {
+					can_.recv(i.id, static_cast<uint8_t>(t / i.ms));
+				}
+			}
+			can_.step(SPEED / 1000);
+			if(stall_every > 0 && (t % stall_every) == (stall_every - 1)) {
+				stall = stall_ms;
+			}
+			if(stall > 0) {
+				--stall;
+				continue;
+			}
+			if((t % 10) == 9) {
+				if(tick) {
+					ana.service(static_cast<uint32_t>(can_.get_time() * TICK / SPEED), TICK);
+				} else {
+					ana.service();
+				}
+			}
+		}
+	}
+
+	// 平均の到着間隔 [ms]
+	double mean_(const ANALIZE::info_t& t)
+	{
+		return static_cast<double>(t.last_ - t.first_) / static_cast<double>(t.count_ - 1)
+			* 1000.0 / static_cast<double>(SPEED);
+	}
+
+	bool check_mean_(const ANALIZE& ana, uint32_t top)
+	{
+		bool ok = true;
+		for(uint32_t n = top; n < (sizeof(ids_) / sizeof(ids_[0])); ++n) {
+			const auto& i = ids_[n];
+			auto t = ana.get(i.id);
+			if(t == nullptr || t->count_ < 2) return false;
+			if(std::fabs(mean_(*t) - i.ms) > 0.01) ok = false;
+		}
+		return ok;
+	}
+
+	void test_period_()
+	{
+		static ANALIZE ana(can_);
+		run_(ana, ALL, 3000, 0, 0, true);
+		bool ok = check_mean_(ana, ALL) && ana.get_gap() == 0;
+		// TS の一周より長い周期でも、到着間隔は正しい
+		auto t = ana.get(0x200);
+		if(t == nullptr || t->ival_min_ != SPEED / 10 || t->ival_max_ != SPEED / 10) ok = false;
+		host::check(ok, "period:   intervals over the TS wrap (100/500 ms)");
+	}
+
+	void test_stall_()
+	{
+		// 2 秒毎に、メインループが 300ms 止まる（TS は４周以上進む）
+		// 最後の停止の後は service を呼ばないので、数える停止は４回
+		static ANALIZE ana(can_);
+		run_(ana, SPARSE, 10000, 2000, 300, true);
+		bool ok = check_mean_(ana, SPARSE) && ana.get_gap() == 4;
+		auto t = ana.get(0x200);
+		if(t == nullptr || t->count_ != 100) ok = false;
+		host::check(ok, "stall:    32-bit tick keeps the time over 300 ms stalls (gap %u)", ana.get_gap());
+
+		// TS だけでは、止まった分の時間が失われる
+		static ANALIZE ts(can_);
+		run_(ts, SPARSE, 10000, 2000, 300, false);
+		auto u = ts.get(0x200);
+		host::check(u != nullptr && mean_(*u) < 99.0 && ts.get_gap() == 0,
+			"stall:    TS only service() loses the wraps (mean %.3f ms)", u != nullptr ? mean_(*u) : 0.0);
+	}
+
+	void test_table_()
+	{
+		static ANALIZE ana(can_);
+		can_.clear();
+		bool ok = true;
+		for(uint32_t i = 0; i < 20; ++i) {
+			can_.recv(0x400 + i, 0);
+		}
+		ana.service();
+		if(ana.size() != ANALIZE::LIMIT || ana.get_overflow() != (20 - ANALIZE::LIMIT)) ok = false;
+
+		// 削除の後、後ろの要素が見つかる事
+		for(uint32_t i = 0; i < ANALIZE::LIMIT; i += 2) {
+			if(!ana.clear(0x400 + i)) ok = false;
+		}
+		for(uint32_t i = 1; i < ANALIZE::LIMIT; i += 2) {
+			if(!ana.find(0x400 + i)) ok = false;
+		}
+
+		ana.clear_all();
+		ana.set_filter(0, 0x100, 0x1ff);
+		for(uint32_t i = 0; i < 4; ++i) {
+			can_.recv(0x0ff + i, 0);
+		}
+		ana.service();
+		if(ana.size() != 3 || ana.get_filtered() != 1) ok = false;
+		host::check(ok, "table:    overflow, clear, filter");
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	std::printf("CAN analize (%u bps, TS wraps every %.1f ms):\n", SPEED, 65536.0 * 1000.0 / SPEED);
+	test_period_();
+	test_stall_();
+	test_table_();
+
+	return host::result();
+}
@@ -0,0 +1,25 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	CAN 制御（ホスト・テスト用） @n
+			can_analize が使う can_frame と can_io_def だけを用意する。 @n
+			※ホストには CAN ペリフェラルが無いので、can_io 本体は使わない。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/format.hpp"
+#include "RX600/can_frame.hpp"
+
+namespace device {
+
+	class can_io_def {
+	public:
+		static void list(const can_frame& src, const char* ht = "") noexcept
+		{
+			utils::format("%sID: 0x%08X, TS: %u\n") % ht % src.get_id() % src.get_TS();
+		}
+	};
+}
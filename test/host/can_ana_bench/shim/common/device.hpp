@@ -0,0 +1,12 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	デバイス定義（ホスト・テスト用） @n
+			RX600/can_frame.hpp が使う型だけ。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "common/io_utils.hpp"
@@ -0,0 +1,256 @@
+//=========================================================================//
+/*! @file
+    @brief  CP932 変換ベンチマーク（ホスト用） @n
+			utils::cp932（直接参照テーブル）と、FatFs の ffunicode（二分探索）の @n
+			変換結果を比較し、１文字（文字列は１バイト）当たりのサイクル数を測る。 @n
+			・１文字変換（CP932 → Unicode、Unicode → CP932）の全コード @n
+			・文字列変換（ファイル名の様な、ASCII と日本語が混在した文字列）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstring>
+#include <vector>
+
+#include "common/format.hpp"
+#include "common/cp932.hpp"
+
+#include "test/host/host_test.hpp"
+
+extern "C" {
+	uint16_t ff_oem2uni(uint16_t oem, uint16_t cp);
+	uint16_t ff_uni2oem(uint32_t uni, uint16_t cp);
+}
+
+namespace {
+
+	static constexpr uint16_t CODE_PAGE = 932;
+
+	// 測定対象の文字列（UTF-8）
+	static const char* names_[] = {
+		"README.md", "main.cpp", "Makefile", "kfont16.bin",
+		"日本語のファイル名.txt", "音楽/アルバム/01_トラック.mp3",
+		"写真_2026_0101.jpg", "ﾊﾝｶｸｶﾀｶﾅ.TXT", "設定ファイル.ini",
+		"very_long_ascii_file_name_for_directory_listing.dat",
+	};
+
+	volatile uint32_t sink_;
+
+	// 以前の utils::str::oemc_to_utf8 と同じ処理（ffunicode を使う）
+	uint32_t put_utf8_(uint16_t code, char* dst, uint32_t dsz) noexcept
+	{
+		if(code < 0x80) {
+			if(dsz < 1) return 0;
+			dst[0] = code;
+			return 1;
+		} else if(code < 0x800) {
+			if(dsz < 2) return 0;
+			dst[0] = 0xc0 | (code >> 6);
+			dst[1] = 0x80 | (code & 0x3f);
+			return 2;
+		} else {
+			if(dsz < 3) return 0;
+			dst[0] = 0xe0 | (code >> 12);
+			dst[1] = 0x80 | ((code >> 6) & 0x3f);
+			dst[2] = 0x80 | (code & 0x3f);
+			return 3;
+		}
+	}
+
+	bool ff_to_utf8_(const char* src, char* dst, uint32_t dsz) noexcept
+	{
+		uint16_t wc = 0;
+		char ch;
+		while((ch = *src++) != 0 && dsz > 1) {
+			uint8_t c = static_cast<uint8_t>(ch);
+			if(wc) {
+				if((0x40 <= c && c <= 0x7e) || (0x80 <= c && c <= 0xfc)) {
+					wc <<= 8;
+					wc |= c;
+					auto len = put_utf8_(ff_oem2uni(wc, CODE_PAGE), dst, dsz - 1);
+					if(len == 0) break;
+					dst += len;
+					dsz -= len;
+				}
+				wc = 0;
+			} else {
+				if(0x81 <= c && c <= 0x9f) wc = c;
+				else if(0xe0 <= c && c <= 0xfc) wc = c;
+				else if(c >= 0x80) {
+					auto len = put_utf8_(ff_oem2uni(c, CODE_PAGE), dst, dsz - 1);
+					if(len == 0) break;
+					dst += len;
+					dsz -= len;
+				} else {
+					*dst++ = c;
+					dsz -= 1;
+				}
+			}
+		}
+		*dst = 0;
+		return dsz > 0;
+	}
+
+	// 以前の utils::str::utf8_to_oemc と同じ処理（ffunicode を使う）
+	bool ff_from_utf8_(const char* src, char* dst, uint32_t dsz) noexcept
+	{
+		int8_t cnt = 0;
+		uint16_t code = 0;
+		char tc;
+		while((tc = *src++) != 0) {
+			uint8_t c = static_cast<uint8_t>(tc);
+			if(c < 0x80) {
+				if(dsz <= 1) break;
+				*dst++ = tc;
+				code = 0;
+				--dsz;
+			} else if((c & 0xf0) == 0xe0) {
+				code = (c & 0x0f);
+				cnt = 2;
+			} else if((c & 0xe0) == 0xc0) {
+				code = (c & 0x1f);
+				cnt = 1;
+			} else if((c & 0xc0) == 0x80) {
+				code <<= 6;
+				code |= c & 0x3f;
+				cnt--;
+				if(cnt < 0) code = 0;
+			}
+			if(cnt == 0 && code != 0) {
+				if(dsz <= 2) break;
+				auto wc = ff_uni2oem(code, CODE_PAGE);
+				if(wc >= 0x100) {
+					*dst++ = static_cast<char>(wc >> 8);
+					--dsz;
+				}
+				*dst++ = static_cast<char>(wc & 0xff);
+				--dsz;
+				code = 0;
+			}
+		}
+		*dst = 0;
+		return dsz > 0;
+	}
+
+	template <class FUNC>
+	double measure_(uint32_t loop, FUNC func) noexcept
+	{
+		host::stop_watch t;
+		for(uint32_t i = 0; i < loop; ++i) {
+			func();
+		}
+		return t.stop();
+	}
+
+	void report_(const char* title, uint64_t num, double ref, double tbl) noexcept
+	{
+		utils::format("  %-24s ffunicode: %6.2f, cp932: %6.2f [%s] (x%.1f)\n")
+			% title
+			% (ref / static_cast<double>(num))
+			% (tbl / static_cast<double>(num))
+			% host::stop_watch::unit()
+			% (ref / tbl);
+	}
+
+	void verify_() noexcept
+	{
+		uint32_t err = 0;
+		for(uint32_t c = 0; c < 0x10000; ++c) {
+			if(utils::cp932::to_unicode(c) != ff_oem2uni(c, CODE_PAGE)) ++err;
+			if(utils::cp932::from_unicode(c) != ff_uni2oem(c, CODE_PAGE)) ++err;
+		}
+		host::check(err == 0, "verify:   all 65536 codes in both directions match ffunicode (%u errors)", err);
+	}
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	auto loop = host::arg(argc, argv, 1, 200);
+	if(loop == 0) {
+		utils::format("usage: %s [loop]\n") % argv[0];
+		return 1;
+	}
+
+#ifdef CP932_COMPACT
+	utils::format("CP932 benchmark (CP932_COMPACT)\n");
+#else
+	utils::format("CP932 benchmark\n");
+#endif
+
+	verify_();
+
+	// １文字変換（有効なコードだけ）
+	std::vector<uint16_t> oems;
+	std::vector<uint16_t> unis;
+	for(uint32_t c = 0x80; c < 0x10000; ++c) {
+		if(ff_oem2uni(c, CODE_PAGE) != 0) oems.push_back(c);
+		if(ff_uni2oem(c, CODE_PAGE) != 0) unis.push_back(c);
+	}
+
+	uint32_t sum = 0;
+	auto ref = measure_(loop, [&]() { for(auto c : oems) sum += ff_oem2uni(c, CODE_PAGE); });
+	auto tbl = measure_(loop, [&]() { for(auto c : oems) sum += utils::cp932::to_unicode(c); });
+	report_("CP932 -> Unicode:", static_cast<uint64_t>(oems.size()) * loop, ref, tbl);
+
+	ref = measure_(loop, [&]() { for(auto c : unis) sum += ff_uni2oem(c, CODE_PAGE); });
+	tbl = measure_(loop, [&]() { for(auto c : unis) sum += utils::cp932::from_unicode(c); });
+	report_("Unicode -> CP932:", static_cast<uint64_t>(unis.size()) * loop, ref, tbl);
+
+	// 文字列変換（バイト数で評価）
+	static constexpr uint32_t DSZ = 256;
+	std::vector<char> utf8;
+	std::vector<char> oemc;
+	bool ok = true;
+	for(auto s : names_) {
+		char tmp[DSZ];
+		utils::cp932::from_utf8(s, tmp, sizeof(tmp));
+		char ref_tmp[DSZ];
+		ff_from_utf8_(s, ref_tmp, sizeof(ref_tmp));
+		char back[DSZ];
+		utils::cp932::to_utf8(tmp, back, sizeof(back));
+		if(strcmp(tmp, ref_tmp) != 0 || strcmp(back, s) != 0) {
+			utils::format("  String verify error: '%s'\n") % s;
+			ok = false;
+		}
+		utf8.insert(utf8.end(), s, s + strlen(s) + 1);
+		oemc.insert(oemc.end(), tmp, tmp + strlen(tmp) + 1);
+	}
+	host::check(ok, "string:   file names to CP932 and back to UTF-8");
+	uint32_t num = sizeof(names_) / sizeof(names_[0]);
+	auto str_loop = loop * 100;
+
+	auto oem_to_utf8 = [&](bool (*conv)(const char*, char*, uint32_t)) {
+		char dst[DSZ];
+		const char* p = oemc.data();
+		for(uint32_t i = 0; i < num; ++i) {
+			conv(p, dst, sizeof(dst));
+			sum += dst[0];
+			p += strlen(p) + 1;
+		}
+	};
+	ref = measure_(str_loop, [&]() { oem_to_utf8(ff_to_utf8_); });
+	tbl = measure_(str_loop, [&]() { oem_to_utf8(utils::cp932::to_utf8); });
+	report_("CP932 -> UTF-8 (bytes):", static_cast<uint64_t>(oemc.size()) * str_loop, ref, tbl);
+
+	auto utf8_to_oem = [&](bool (*conv)(const char*, char*, uint32_t)) {
+		char dst[DSZ];
+		const char* p = utf8.data();
+		for(uint32_t i = 0; i < num; ++i) {
+			conv(p, dst, sizeof(dst));
+			sum += dst[0];
+			p += strlen(p) + 1;
+		}
+	};
+	ref = measure_(str_loop, [&]() { utf8_to_oem(ff_from_utf8_); });
+	tbl = measure_(str_loop, [&]() { utf8_to_oem(utils::cp932::from_utf8); });
+	report_("UTF-8 -> CP932 (bytes):", static_cast<uint64_t>(utf8.size()) * str_loop, ref, tbl);
+
+	sink_ = sum;
+
+	return host::result();
+}
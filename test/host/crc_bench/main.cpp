@@ -0,0 +1,181 @@
+//=========================================================================//
+/*! @file
+    @brief  CRC エンジン・ベンチマーク（ホスト用） @n
+			utils::crc_engine（slice-by-1/4/8）と utils::inet_sum を、ビット毎に @n
+			計算する参照実装と比べ、１バイト当たりのサイクル数を測る。 @n
+			・"123456789" のチェック値 @n
+			・ランダムな長さ、位置、分割（update の継続）で、参照実装と一致するか @n
+			・インターネット・チェック・サム（桁上げの多いデータを含む）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "common/crc_engine.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	typedef utils::crc_def::TYPE TYPE;
+
+	std::mt19937	rnd_(1234);
+
+	// ビット毎に計算する参照実装
+	uint32_t crc_bit_(TYPE type, const uint8_t* p, uint32_t len)
+	{
+		auto spec = utils::crc_def::get_spec(type);
+		uint32_t mask = spec.width == 32 ? 0xffff'ffff : ((1u << spec.width) - 1);
+		uint32_t top = 1u << (spec.width - 1);
+		uint32_t c = spec.init;
+		for(uint32_t i = 0; i < len; ++i) {
+			uint8_t d = p[i];
+			for(uint32_t j = 0; j < 8; ++j) {
+				uint32_t bit = spec.refl ? ((d >> j) & 1) : ((d >> (7 - j)) & 1);
+				if(spec.refl) {
+					// 入出力を反転した形（レジスタは反転したまま持つ）
+					uint32_t msb = c & 1;
+					c >>= 1;
+					if(msb ^ bit) {
+						uint32_t r = 0;
+						for(uint32_t k = 0; k < spec.width; ++k) r |= ((spec.poly >> k) & 1) << (spec.width - 1 - k);
+						c ^= r;
+					}
+				} else {
+					uint32_t msb = (c & top) ? 1 : 0;
+					c = (c << 1) & mask;
+					if(msb ^ bit) c ^= spec.poly;
+				}
+			}
+		}
+		return (c ^ spec.xorout) & mask;
+	}
+
+	uint16_t inet_ref_(const uint8_t* p, uint32_t len, uint16_t sumorg)
+	{
+		uint64_t sum = sumorg;
+		for(uint32_t i = 0; i < len; i += 2) {
+			sum += static_cast<uint32_t>(p[i]) << 8;
+			if((i + 1) < len) sum += p[i + 1];
+		}
+		while(sum >> 16) sum = (sum & 0xffff) + (sum >> 16);
+		return ~sum;
+	}
+
+	volatile uint32_t sink_;
+
+	template <class F>
+	double bench_(F f, const std::vector<uint8_t>& buf, uint32_t loop)
+	{
+		auto best = host::best_of(5, [&]() {
+			uint32_t s = 0;
+			for(uint32_t i = 0; i < loop; ++i) {
+				s += f(buf.data(), buf.size());
+			}
+			sink_ = s;
+		});
+		return best / (static_cast<double>(buf.size()) * loop);
+	}
+
+
+	template <TYPE T, uint32_t SLICE>
+	bool verify_(const std::vector<uint8_t>& buf, uint32_t loop)
+	{
+		typedef utils::crc_engine<T, SLICE> CRC;
+		for(uint32_t n = 0; n < loop; ++n) {
+			uint32_t ofs = rnd_() % 16;
+			uint32_t len = rnd_() % 2000;
+			auto p = buf.data() + ofs;
+			auto ref = crc_bit_(T, p, len);
+			// ランダムな位置で分割して、update を続ける
+			auto reg = CRC::init();
+			uint32_t pos = 0;
+			while(pos < len) {
+				uint32_t l = rnd_() % 40;
+				if(l > (len - pos)) l = len - pos;
+				reg = CRC::update(reg, p + pos, l);
+				pos += l;
+			}
+			if(CRC::final(reg) != ref || CRC::calc(p, len) != ref) {
+				std::printf("  mismatch: type %u, slice %u, len %u\n",
+					static_cast<uint32_t>(T), SLICE, len);
+				return false;
+			}
+		}
+		return true;
+	}
+
+
+	template <TYPE T>
+	void test_(const char* title, const std::vector<uint8_t>& buf, uint32_t loop)
+	{
+		static const char* chk = "123456789";
+		auto spec = utils::crc_def::get_spec(T);
+		auto ck = reinterpret_cast<const uint8_t*>(chk);
+		bool ok = crc_bit_(T, ck, 9) == spec.check;
+		ok = ok && utils::crc_engine<T, 1>::calc(chk, 9) == spec.check;
+		ok = ok && utils::crc_engine<T, 4>::calc(chk, 9) == spec.check;
+		ok = ok && utils::crc_engine<T, 8>::calc(chk, 9) == spec.check;
+		ok = ok && verify_<T, 1>(buf, loop);
+		ok = ok && verify_<T, 4>(buf, loop);
+		ok = ok && verify_<T, 8>(buf, loop);
+
+		auto r0 = bench_([](const uint8_t* p, uint32_t l) { return crc_bit_(T, p, l); }, buf, 1);
+		auto r1 = bench_([](const uint8_t* p, uint32_t l) { return utils::crc_engine<T, 1>::calc(p, l); }, buf, 8);
+		auto r4 = bench_([](const uint8_t* p, uint32_t l) { return utils::crc_engine<T, 4>::calc(p, l); }, buf, 8);
+		auto r8 = bench_([](const uint8_t* p, uint32_t l) { return utils::crc_engine<T, 8>::calc(p, l); }, buf, 8);
+		host::check(ok, "%-12s check %08X  bit %6.3f  slice-1 %6.3f  slice-4 %6.3f  slice-8 %6.3f",
+			title, spec.check, r0, r1, r4, r8);
+	}
+
+
+	void test_inet_(std::vector<uint8_t> buf, uint32_t loop)
+	{
+		bool ok = true;
+		for(uint32_t n = 0; n < loop; ++n) {
+			uint32_t ofs = rnd_() % 16;
+			uint32_t len = rnd_() % 2000;
+			uint16_t org = rnd_();
+			auto p = buf.data() + ofs;
+			if(utils::inet_sum::calc(p, len, org) != inet_ref_(p, len, org)) {
+				std::printf("  inet_sum mismatch: len %u\n", len);
+				ok = false;
+				break;
+			}
+		}
+		// 桁上げが何度も起こるデータ
+		std::vector<uint8_t> ff(65536, 0xff);
+		ff[0] = 0xfe;
+		ok = ok && utils::inet_sum::calc(ff.data(), ff.size(), 0xffff) == inet_ref_(ff.data(), ff.size(), 0xffff);
+
+		auto r = bench_([](const uint8_t* p, uint32_t l) -> uint32_t { return utils::inet_sum::calc(p, l); }, buf, 8);
+		host::check(ok, "%-12s %6.3f", "inet_sum", r);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto loop = host::arg(argc, argv, 1, 2000);
+
+	std::vector<uint8_t> buf(65536);
+	for(auto& d : buf) d = rnd_();
+
+	std::printf("CRC (%u trials, %u bytes buffer, %s/byte):\n", loop, static_cast<uint32_t>(buf.size()),
+		host::stop_watch::unit());
+	test_<TYPE::CRC8>("CRC-8", buf, loop);
+	test_<TYPE::CRC16>("CRC-16", buf, loop);
+	test_<TYPE::CRC16_CCITT>("CRC-16-CCITT", buf, loop);
+	test_<TYPE::CRC32>("CRC-32", buf, loop);
+	test_<TYPE::CRC32C>("CRC-32C", buf, loop);
+
+	std::printf("Internet checksum:\n");
+	test_inet_(buf, loop);
+
+	return host::result();
+}
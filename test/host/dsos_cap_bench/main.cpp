@@ -0,0 +1,310 @@
+//=========================================================================//
+/*! @file
+    @brief  DSOS キャプチャー・ブロック走査ベンチマーク（ホスト用） @n
+			dsos::capture（GLFW_SIM）のリングとブロック走査を、サンプル毎に @n
+			状態機械を回す参照実装（以前の割り込み処理）と比べる。 @n
+			・全てのトリガー型、ランダムな波形、基準値、走査の間隔で、 @n
+			  キャプチャー・データ、位置、トリガー位置、サイクルが一致するか @n
+			・トリガー待ちの区間で、１サンプルあたりのサイクル数
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace dsos {
+
+	// GLFW_SIM では、ディバイダーのポートはシミュレーター側で用意する
+	template <uint32_t N>
+	struct sim_port_t {
+		struct bit_t {
+			uint8_t	v_ = 0;
+			void operator = (uint32_t v) noexcept { v_ = v; }
+			uint8_t operator () () const noexcept { return v_; }
+		};
+		static inline bit_t P;
+		static void OUTPUT() noexcept { }
+	};
+	typedef sim_port_t<0> CH0_SA;
+	typedef sim_port_t<1> CH0_SB;
+	typedef sim_port_t<2> CH0_DC;
+	typedef sim_port_t<3> CH1_SA;
+	typedef sim_port_t<4> CH1_SB;
+	typedef sim_port_t<5> CH1_DC;
+}
+
+#include "DSOS_sample/capture.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr uint32_t CAPN = 16384;
+	typedef dsos::capture<CAPN> CAPTURE;
+	typedef CAPTURE::DATA DATA;
+	typedef dsos::render_base::TRG_MODE TRG_MODE;
+
+	CAPTURE		cap_;
+
+	std::mt19937	rnd_(1234);
+
+	// 参照実装（サンプル毎に状態機械を回す）
+	struct ref_t {
+		DATA		data_[CAPN];
+		uint32_t	pos_ = 0;
+		uint32_t	count_ = 0;
+		uint32_t	before_count_ = 0;
+		uint32_t	after_count_ = 0;
+		uint16_t	cycle_ = 0;
+		int16_t		trg_ref_ = 0;
+		uint32_t	trg_pos_ = 0;
+		TRG_MODE	trg_mode_main_ = TRG_MODE::STOP;
+		TRG_MODE	trg_mode_ = TRG_MODE::STOP;
+		bool		over_ = false;
+
+		void put_(const DATA& t)
+		{
+			data_[pos_] = t;
+			++count_;
+			++pos_;
+			pos_ &= CAPN - 1;
+		}
+
+		void fire_(const DATA& t, bool f)
+		{
+			data_[pos_] = t;
+			++count_;
+			if(f) {
+				trg_pos_ = pos_;
+				trg_mode_ = TRG_MODE::_TRG_AFTER;
+			}
+			++pos_;
+			pos_ &= CAPN - 1;
+		}
+
+		void step(const DATA& t)
+		{
+			switch(trg_mode_) {
+			case TRG_MODE::STOP:
+				if(t.y >= CAPTURE::ADC_MAX || t.y <= CAPTURE::ADC_MIN) over_ = true;
+				break;
+			case TRG_MODE::SINGLE:
+			case TRG_MODE::AUTO:
+				put_(t);
+				if(pos_ == (CAPN - 1)) {
+					if(trg_mode_ == TRG_MODE::SINGLE) {
+						trg_mode_ = TRG_MODE::STOP;
+					}
+					trg_pos_ = CAPN / 4;
+					pos_ = 0;
+					++cycle_;
+				}
+				break;
+			case TRG_MODE::_TRG_BEFORE:
+				put_(t);
+				if(before_count_ > 0) {
+					before_count_--;
+				} else {
+					trg_mode_ = trg_mode_main_;
+				}
+				break;
+			case TRG_MODE::CH0_POS:
+				put_(t);
+				if(t.x < trg_ref_) trg_mode_ = TRG_MODE::_CH0_POSA;
+				break;
+			case TRG_MODE::_CH0_POSA:
+				fire_(t, t.x >= trg_ref_);
+				break;
+			case TRG_MODE::CH1_POS:
+				put_(t);
+				if(t.y < trg_ref_) trg_mode_ = TRG_MODE::_CH1_POSA;
+				break;
+			case TRG_MODE::_CH1_POSA:
+				fire_(t, t.y >= trg_ref_);
+				break;
+			case TRG_MODE::CH0_NEG:
+				put_(t);
+				if(t.x > trg_ref_) trg_mode_ = TRG_MODE::_CH0_NEGA;
+				break;
+			case TRG_MODE::_CH0_NEGA:
+				fire_(t, t.x <= trg_ref_);
+				break;
+			case TRG_MODE::CH1_NEG:
+				put_(t);
+				if(t.y > trg_ref_) trg_mode_ = TRG_MODE::_CH1_NEGA;
+				break;
+			case TRG_MODE::_CH1_NEGA:
+				fire_(t, t.y <= trg_ref_);
+				break;
+			case TRG_MODE::_TRG_AFTER:
+				put_(t);
+				if(after_count_ > 0) {
+					after_count_--;
+				} else {
+					trg_mode_ = TRG_MODE::STOP;
+					++cycle_;
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		// capture::set_trg_mode と同じ初期化
+		void set(TRG_MODE mode, int16_t ref)
+		{
+			trg_ref_ = ref;
+			pos_ = 0;
+			before_count_ = cap_.get_before_count();
+			after_count_ = cap_.get_after_count();
+			trg_mode_main_ = mode;
+			if(mode == TRG_MODE::CH0_POS || mode == TRG_MODE::CH1_POS
+				|| mode == TRG_MODE::CH0_NEG || mode == TRG_MODE::CH1_NEG) {
+				trg_mode_ = TRG_MODE::_TRG_BEFORE;
+			} else {
+				trg_mode_ = mode;
+			}
+		}
+	};
+
+	ref_t	ref_;
+
+
+	// ノイズの乗った正弦波（長い無信号の区間を含む）
+	struct wave_t {
+		float	phase_ = 0.0f;
+		float	step_;
+		float	gain_;
+		int16_t	ofs_;
+		int16_t	noise_;
+		uint32_t	idle_ = 0;
+
+		wave_t()
+		{
+			step_ = std::uniform_real_distribution<float>(0.00005f, 0.01f)(rnd_);
+			gain_ = std::uniform_real_distribution<float>(0.0f, 2100.0f)(rnd_);
+			ofs_ = std::uniform_int_distribution<int>(-500, 500)(rnd_);
+			noise_ = std::uniform_int_distribution<int>(0, 40)(rnd_);
+		}
+
+		int16_t get()
+		{
+			if(idle_ > 0) {
+				--idle_;
+				return ofs_;
+			}
+			if(std::uniform_int_distribution<int>(0, 20000)(rnd_) == 0) {
+				idle_ = std::uniform_int_distribution<int>(1000, 30000)(rnd_);
+			}
+			phase_ += step_;
+			int32_t v = ofs_ + static_cast<int32_t>(std::sin(phase_ * 6.2831853f) * gain_);
+			if(noise_ > 0) v += std::uniform_int_distribution<int>(-noise_, noise_)(rnd_);
+			if(v < -CAPTURE::CAP_OFS) v = -CAPTURE::CAP_OFS;
+			else if(v > (CAPTURE::CAP_OFS - 1)) v = CAPTURE::CAP_OFS - 1;
+			return v;
+		}
+	};
+
+
+	bool same_()
+	{
+		const auto& t = cap_.get_cap_task();
+		if(t.pos_ != ref_.pos_ || t.count_ != ref_.count_ || t.cycle_ != ref_.cycle_
+			|| t.trg_pos_ != ref_.trg_pos_ || t.trg_mode_ != ref_.trg_mode_) return false;
+		if(t.before_count_ != ref_.before_count_ || t.after_count_ != ref_.after_count_) return false;
+		for(uint32_t i = 0; i < CAPN; ++i) {
+			if(t.data_[i].x != ref_.data_[i].x || t.data_[i].y != ref_.data_[i].y) return false;
+		}
+		return true;
+	}
+
+
+	void test_mode_(TRG_MODE mode, const char* name, uint32_t loop)
+	{
+		bool ok = true;
+		uint32_t trg = 0;
+		for(uint32_t n = 0; n < loop && ok; ++n) {
+			wave_t w0;
+			wave_t w1;
+			int16_t ref = std::uniform_int_distribution<int>(-1500, 1500)(rnd_);
+			auto& task = cap_.at_cap_task();
+			task.count_ = 0;
+			task.cycle_ = 0;
+			task.trg_pos_ = 0;
+			ref_.count_ = 0;
+			ref_.cycle_ = 0;
+			ref_.trg_pos_ = 0;
+			cap_.set_trg_mode(mode, ref);
+			ref_.set(mode, ref);
+			auto num = std::uniform_int_distribution<uint32_t>(CAPN, CAPN * 8)(rnd_);
+			uint32_t i = 0;
+			while(i < num) {
+				// 走査の間隔（ハードウェアでは、走査タイマーの周期で変わる）
+				auto k = std::uniform_int_distribution<uint32_t>(1, CAPN - 1)(rnd_);
+				for(uint32_t j = 0; j < k && i < num; ++j, ++i) {
+					DATA t(w0.get(), w1.get());
+					task.put(t);
+					ref_.step(t);
+				}
+				task();
+			}
+			ok = same_();
+			if(ref_.cycle_ > 0) ++trg;
+		}
+		host::check(ok, "%-8s %u captures (%u completed), random scan interval", name, loop, trg);
+	}
+
+
+	void bench_()
+	{
+		// トリガーが来ない区間（基準値を越えない）
+		auto& task = cap_.at_cap_task();
+		static constexpr uint32_t NUM = CAPN - 1;
+		double best_b = 1e30;
+		double best_r = 1e30;
+		for(uint32_t n = 0; n < 20; ++n) {
+			cap_.set_trg_mode(TRG_MODE::CH0_POS, 2000);
+			ref_.set(TRG_MODE::CH0_POS, 2000);
+			wave_t w;
+			std::vector<DATA> src(NUM);
+			for(auto& t : src) {
+				t.x = w.get() / 2;
+				t.y = t.x;
+			}
+			for(const auto& t : src) task.put(t);
+			host::stop_watch sw;
+			task();
+			auto b = sw.stop();
+			if(b < best_b) best_b = b;
+
+			sw.start();
+			for(const auto& t : src) ref_.step(t);
+			auto r = sw.stop();
+			if(r < best_r) best_r = r;
+		}
+		std::printf("  bench:    trigger wait: block scan %.2f, per sample %.2f %s/sample\n",
+			best_b / NUM, best_r / NUM, host::stop_watch::unit());
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto loop = host::arg(argc, argv, 1, 20);
+
+	std::printf("DSOS capture ring, block trigger scan (%u samples, block %u):\n",
+		CAPN, CAPTURE::SCAN_BLOCK);
+	test_mode_(TRG_MODE::AUTO,    "AUTO",    loop);
+	test_mode_(TRG_MODE::SINGLE,  "SINGLE",  loop);
+	test_mode_(TRG_MODE::CH0_POS, "CH0_POS", loop);
+	test_mode_(TRG_MODE::CH0_NEG, "CH0_NEG", loop);
+	test_mode_(TRG_MODE::CH1_POS, "CH1_POS", loop);
+	test_mode_(TRG_MODE::CH1_NEG, "CH1_NEG", loop);
+	bench_();
+
+	return host::result();
+}
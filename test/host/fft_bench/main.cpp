@@ -0,0 +1,192 @@
+//=========================================================================//
+/*! @file
+    @brief  固定小数点 FFT 検証とベンチマーク（ホスト用） @n
+			utils::fixed_fft を、倍精度の DFT と比べ、サイクル数を測る。 @n
+			・コンパイル時に作る窓関数テーブルと、倍精度の cos から作る値の差 @n
+			・ランダム入力の変換結果と、倍精度 DFT（x 1/N）の最大誤差 @n
+			・正弦波のピーク・ビン、power_to_db() の誤差 @n
+			・transform() と、構築（テーブル作成）のサイクル数
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "common/fixed_fft.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr double PI2 = 6.28318530717958647692;
+
+	std::mt19937	rnd_(1234);
+
+	int16_t q15_(double v)
+	{
+		auto a = std::floor(v * 32767.0 + 0.5);
+		if(a > 32767.0) a = 32767.0;
+		else if(a < -32768.0) a = -32768.0;
+		return static_cast<int16_t>(a);
+	}
+
+	// 実行時に cos で作る窓関数（以前の実装と同じ）
+	template <uint32_t N>
+	void make_window_(typename utils::fixed_fft<N>::WINDOW win, int16_t* out)
+	{
+		typedef utils::fixed_fft<N> FFT;
+		for(uint32_t i = 0; i < N; ++i) {
+			double a = PI2 * static_cast<double>(i) / static_cast<double>(N);
+			double w = 1.0;
+			if(win == FFT::WINDOW::HANN) {
+				w = 0.5 - 0.5 * cos(a);
+			} else if(win == FFT::WINDOW::BLACKMAN) {
+				w = 0.42 - 0.5 * cos(a) + 0.08 * cos(a * 2.0);
+			}
+			out[i] = q15_(w);
+		}
+	}
+
+	// 窓関数テーブル：１ LSB 以内（cos の丸めの差）
+	template <uint32_t N>
+	void test_table_()
+	{
+		typedef utils::fixed_fft<N> FFT;
+		static FFT fft;
+		std::vector<int16_t> ref(N);
+		int32_t err = 0;
+		for(auto win : { FFT::WINDOW::HANN, FFT::WINDOW::BLACKMAN }) {
+			fft.set_window(win);
+			make_window_<N>(win, &ref[0]);
+			for(uint32_t i = 0; i < N; ++i) {
+				fft.set(i, FFT::ONE);  // 1.0 x 窓 = 窓の値
+				auto d = std::abs(fft.get_re()[i] - ref[i]);
+				if(d > err) err = d;
+			}
+		}
+		fft.set_window(FFT::WINDOW::RECT);
+		fft.set(3, 12345);
+		host::check(err <= 1 && fft.get_re()[3] == 12345, "table:    N=%4u, window vs run-time cos: max %d LSB", N, err);
+	}
+
+	// ランダム入力：倍精度 DFT（x 1/N）との最大誤差
+	template <uint32_t N>
+	void test_dft_(int32_t limit)
+	{
+		typedef utils::fixed_fft<N> FFT;
+		static FFT fft(FFT::WINDOW::RECT);
+		std::vector<int32_t> in(N);
+		double err = 0.0;
+		for(uint32_t loop = 0; loop < 4; ++loop) {
+			for(uint32_t i = 0; i < N; ++i) {
+				in[i] = static_cast<int32_t>(rnd_() % 65535) - 32767;
+				fft.set(i, in[i]);
+			}
+			fft.transform();
+			for(uint32_t k = 0; k < N; ++k) {
+				double re = 0.0;
+				double im = 0.0;
+				for(uint32_t n = 0; n < N; ++n) {
+					double a = PI2 * static_cast<double>((static_cast<uint64_t>(n) * k) % N) / static_cast<double>(N);
+					re += in[n] * cos(a);
+					im -= in[n] * sin(a);
+				}
+				re /= N;
+				im /= N;
+				err = std::max(err, std::fabs(fft.get_re()[k] - re));
+				err = std::max(err, std::fabs(fft.get_im()[k] - im));
+			}
+		}
+		host::check(err <= limit, "dft:      N=%4u, random input vs double DFT: max %.1f LSB (limit %d)", N, err, limit);
+	}
+
+	// 正弦波：ピーク・ビン
+	template <uint32_t N>
+	void test_tone_()
+	{
+		typedef utils::fixed_fft<N> FFT;
+		static FFT fft(FFT::WINDOW::HANN);
+		bool ok = true;
+		for(uint32_t bin : { 1u, 5u, N / 8, N / 2 - 3 }) {
+			for(uint32_t i = 0; i < N; ++i) {
+				auto v = 30000.0 * sin(PI2 * bin * i / N);
+				fft.set(i, static_cast<int32_t>(v));
+			}
+			fft.transform();
+			uint32_t peak = 0;
+			uint32_t pmax = 0;
+			for(uint32_t k = 0; k < N / 2; ++k) {
+				auto p = fft.get_power(k);
+				if(p > pmax) { pmax = p; peak = k; }
+			}
+			if(peak != bin) ok = false;
+		}
+		host::check(ok, "tone:     N=%4u, Hann window sine peak bin", N);
+	}
+
+	void test_db_()
+	{
+		double err = 0.0;
+		for(uint32_t i = 0; i < 100000; ++i) {
+			uint32_t p = rnd_() >> (rnd_() % 32);
+			if(p == 0) continue;
+			auto db = utils::fixed_fft<64>::power_to_db(p) / 256.0;
+			err = std::max(err, std::fabs(db - 10.0 * log10(static_cast<double>(p))));
+		}
+		host::check(err < 0.1, "db:       power_to_db() vs 10 log10: max %.3f dB", err);
+	}
+
+	template <uint32_t N>
+	void bench_()
+	{
+		typedef utils::fixed_fft<N> FFT;
+		static FFT fft(FFT::WINDOW::HANN);
+		double best = 1e30;
+		for(uint32_t loop = 0; loop < 50; ++loop) {
+			for(uint32_t i = 0; i < N; ++i) {
+				fft.set(i, static_cast<int32_t>(rnd_() % 65535) - 32767);
+			}
+			host::stop_watch t;
+			fft.transform();
+			auto d = t.stop();
+			if(d < best) best = d;
+		}
+
+		// 構築：テーブルはコンパイル時に出来ているので、窓の選択だけ
+		uint32_t n = 0;
+		auto ctor = host::best_of(20, [&]() {
+			fft.set_window((++n & 1) ? FFT::WINDOW::HANN : FFT::WINDOW::BLACKMAN);
+		});
+		std::vector<int16_t> tmp(N);
+		auto rt = host::best_of(20, [&]() { make_window_<N>(FFT::WINDOW::BLACKMAN, &tmp[0]); });
+		auto u = host::stop_watch::unit();
+		std::printf("  bench:    N=%4u, transform %.0f %s, set_window %.0f %s (run-time cos %.0f %s)\n",
+			N, best, u, ctor, u, rt, u);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	std::printf("Fixed-point radix-4 FFT:\n");
+	test_table_<64>();
+	test_table_<256>();
+	test_table_<1024>();
+	test_table_<4096>();
+	test_dft_<64>(4);
+	test_dft_<256>(4);
+	test_dft_<1024>(4);
+	test_tone_<256>();
+	test_tone_<1024>();
+	test_db_();
+	bench_<64>();
+	bench_<256>();
+	bench_<1024>();
+	bench_<4096>();
+
+	return host::result();
+}
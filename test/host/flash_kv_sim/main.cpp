@@ -0,0 +1,455 @@
+//=========================================================================//
+/*! @file
+    @brief  データ・フラッシュ KV ストア・シミュレーター（ホスト用） @n
+			utils::flash_kv を、データ・フラッシュのモデル上で動かし、 @n
+			耐久性（消去回数の分布、書き込み増幅）、書き込み時間、 @n
+			電源断からの復帰を検査する。 @n
+			データ・フラッシュのモデル： @n
+			・消去されたワードの読み出し値は不定（乱数を返す） @n
+			・書き込みは消去後に一度だけ（二度書きはエラー） @n
+			・書き込み、消去、ブランク・チェックの時間を積算 @n
+			・指定回数の操作後に電源断（途中のワードは不定値で書かれる）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstring>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "common/flash_kv.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  データ・フラッシュのモデル（RX64M 相当、FIO インターフェース）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class data_flash_sim {
+	public:
+		static constexpr uint32_t DATA_SIZE = 32768;
+		static constexpr uint32_t DATA_BLANK_SIZE = 64;
+		static constexpr uint32_t DATA_BLANK_NUM = DATA_SIZE / DATA_BLANK_SIZE;
+		static constexpr uint32_t DATA_ERASE_SIZE = 64;
+		static constexpr uint32_t DATA_ERASE_NUM = DATA_SIZE / DATA_ERASE_SIZE;
+		static constexpr uint32_t WORD_SIZE = 4;
+
+		// 時間のモデル（マイクロ秒）
+		static constexpr uint32_t WRITE_US = 52;	///< ４バイトの書き込み
+		static constexpr uint32_t ERASE_US = 400;	///< 消去単位の消去
+		static constexpr uint32_t CHECK_US = 2;		///< ワードのブランク・チェック
+		static constexpr uint32_t READ_US = 1;		///< ４バイトの読み出し
+
+	private:
+		uint8_t		mem_[DATA_SIZE];
+		bool		prog_[DATA_SIZE / WORD_SIZE];
+		uint32_t	erase_cnt_[DATA_ERASE_NUM];
+		std::mt19937	rnd_;
+
+		uint64_t	time_us_;
+		uint64_t	prog_words_;
+		uint32_t	violation_;
+		int32_t		fail_;		// 電源断までの操作数（負なら無効）
+		bool		dead_;
+
+		bool step_() noexcept
+		{
+			if(dead_) return false;
+			if(fail_ < 0) return true;
+			if(fail_ == 0) {
+				dead_ = true;
+				return false;
+			}
+			--fail_;
+			return true;
+		}
+
+	public:
+		data_flash_sim() noexcept : mem_{ }, prog_{ }, erase_cnt_{ }, rnd_(1),
+			time_us_(0), prog_words_(0), violation_(0), fail_(-1), dead_(false)
+		{
+			for(uint32_t i = 0; i < DATA_SIZE; ++i) mem_[i] = rnd_();
+		}
+
+		bool read(uint32_t org, void* dst, uint32_t len) noexcept
+		{
+			if(org >= DATA_SIZE || (org + len) > DATA_SIZE) return false;
+			auto p = static_cast<uint8_t*>(dst);
+			for(uint32_t i = 0; i < len; ++i) {
+				auto a = org + i;
+				p[i] = prog_[a / WORD_SIZE] ? mem_[a] : static_cast<uint8_t>(rnd_());
+			}
+			time_us_ += (len + 3) / 4 * READ_US;
+			return true;
+		}
+
+		bool write(uint32_t org, const void* src, uint32_t len) noexcept
+		{
+			if(org >= DATA_SIZE || (org + len) > DATA_SIZE) return false;
+			if((org % WORD_SIZE) != 0 || (len % WORD_SIZE) != 0) {
+				++violation_;
+				return false;
+			}
+			auto p = static_cast<const uint8_t*>(src);
+			for(uint32_t i = 0; i < len; i += WORD_SIZE) {
+				auto w = (org + i) / WORD_SIZE;
+				if(prog_[w]) {
+					++violation_;
+					return false;
+				}
+				if(!step_()) {
+					if(dead_ && (rnd_() & 1)) {  // 途中まで書かれたワード
+						prog_[w] = true;
+						for(uint32_t j = 0; j < WORD_SIZE; ++j) mem_[org + i + j] = rnd_();
+					}
+					return false;
+				}
+				std::memcpy(&mem_[org + i], p + i, WORD_SIZE);
+				prog_[w] = true;
+				++prog_words_;
+				time_us_ += WRITE_US;
+			}
+			return true;
+		}
+
+		bool erase(uint32_t bank) noexcept
+		{
+			if(bank >= DATA_ERASE_NUM) return false;
+			if(!step_()) {
+				if(dead_) {  // 途中まで消去されたブロック
+					for(uint32_t i = 0; i < DATA_ERASE_SIZE; i += WORD_SIZE) {
+						auto a = bank * DATA_ERASE_SIZE + i;
+						prog_[a / WORD_SIZE] = rnd_() & 1;
+						for(uint32_t j = 0; j < WORD_SIZE; ++j) mem_[a + j] = rnd_();
+					}
+				}
+				return false;
+			}
+			for(uint32_t i = 0; i < DATA_ERASE_SIZE; i += WORD_SIZE) {
+				prog_[(bank * DATA_ERASE_SIZE + i) / WORD_SIZE] = false;
+			}
+			++erase_cnt_[bank];
+			time_us_ += ERASE_US;
+			return true;
+		}
+
+		bool erase_check_w(uint32_t adrs) noexcept
+		{
+			if(adrs >= DATA_SIZE) return false;
+			time_us_ += CHECK_US;
+			return !prog_[adrs / WORD_SIZE];
+		}
+
+		bool erase_check(uint32_t bank) noexcept
+		{
+			if(bank >= DATA_BLANK_NUM) return false;
+			for(uint32_t i = 0; i < DATA_BLANK_SIZE; i += WORD_SIZE) {
+				if(!erase_check_w(bank * DATA_BLANK_SIZE + i)) return false;
+			}
+			return true;
+		}
+
+		void set_fail(int32_t n) noexcept
+		{
+			fail_ = n;
+			dead_ = false;
+		}
+
+		bool is_dead() const noexcept { return dead_; }
+
+		uint64_t get_time() const noexcept { return time_us_; }
+
+		uint64_t get_prog_words() const noexcept { return prog_words_; }
+
+		uint32_t get_violation() const noexcept { return violation_; }
+
+		void get_erase_range(uint32_t& mn, uint32_t& mx) const noexcept
+		{
+			mn = 0xffff'ffff;
+			mx = 0;
+			for(uint32_t i = 0; i < DATA_ERASE_NUM; ++i) {
+				mn = std::min(mn, erase_cnt_[i]);
+				mx = std::max(mx, erase_cnt_[i]);
+			}
+		}
+	};
+
+	static constexpr uint32_t SEG_SIZE = 1024;
+	static constexpr uint32_t KEY_MAX = 64;
+	typedef utils::flash_kv<data_flash_sim, SEG_SIZE, KEY_MAX> KV;
+
+	typedef std::map<uint16_t, std::vector<uint8_t>> SHADOW;
+
+	data_flash_sim	flash_;
+	std::mt19937	rnd_(12345);
+
+	std::vector<uint8_t> make_value_(uint32_t len)
+	{
+		std::vector<uint8_t> v(len);
+		for(auto& d : v) d = rnd_();
+		return v;
+	}
+
+	bool verify_(KV& kv, const SHADOW& sh, uint16_t skip = KV::KEY_NONE)
+	{
+		bool ok = true;
+		for(uint32_t k = 0; k < KEY_MAX; ++k) {
+			if(k == skip) continue;
+			auto it = sh.find(k);
+			if(it == sh.end()) {
+				if(kv.probe(k)) {
+					std::printf("  key %u: exists (removed)\n", k);
+					ok = false;
+				}
+				continue;
+			}
+			uint8_t tmp[KV::VALUE_MAX];
+			auto n = kv.read(k, tmp, sizeof(tmp));
+			if(n != it->second.size() || kv.get_size(k) != n || std::memcmp(tmp, it->second.data(), n) != 0) {
+				std::printf("  key %u: mismatch (%u / %u)\n", k, n, static_cast<uint32_t>(it->second.size()));
+				ok = false;
+			}
+		}
+		return ok;
+	}
+
+	// 書き込みの負荷（２割のキーに８割の書き込み、一部のキーは書き換えない）
+	void workload_(uint32_t& key, std::vector<uint8_t>& val, bool& rem)
+	{
+		auto r = rnd_() % 100;
+		if(r < 80) {
+			key = 8 + rnd_() % 8;
+		} else {
+			key = 16 + rnd_() % (KEY_MAX - 16);
+		}
+		rem = (rnd_() % 20) == 0;
+		val = make_value_(4 + rnd_() % 61);
+	}
+
+
+	void test_basic_()
+	{
+		std::printf("Basic:\n");
+		KV kv(flash_);
+		kv.mount();
+		if(!kv.format()) {
+			host::check(false, "format");
+			return;
+		}
+		SHADOW sh;
+		for(uint32_t k = 0; k < KEY_MAX; ++k) {
+			auto v = make_value_(k % 7 == 0 ? 0 : 1 + (k * 13) % 100);
+			if(!kv.write(k, v.data(), v.size())) {
+				host::check(false, "write %u", k);
+				return;
+			}
+			sh[k] = v;
+		}
+		uint8_t d = 0;
+		if(kv.write(KEY_MAX + 1, &d, 1)) {
+			host::check(false, "KEY_MAX overflow");
+			return;
+		}
+		for(uint32_t k = 0; k < KEY_MAX; k += 5) {
+			kv.remove(k);
+			sh.erase(k);
+		}
+		// 同じ値は書き込まない
+		auto t = flash_.get_prog_words();
+		auto& v1 = sh[1];
+		kv.write(1, v1.data(), v1.size());
+		bool ok = flash_.get_prog_words() == t;
+		if(!ok) std::printf("  same value rewritten\n");
+		ok = verify_(kv, sh) && ok;
+
+		KV kv2(flash_);
+		kv2.mount();
+		ok = verify_(kv2, sh) && ok;
+		host::check(ok, "write / read / remove %u keys, remount", KEY_MAX);
+	}
+
+
+	void test_endurance_(uint32_t loop, bool background)
+	{
+		std::printf("Endurance (%u writes, %s GC):\n", loop, background ? "background" : "foreground");
+		flash_ = data_flash_sim();
+		KV kv(flash_);
+		kv.mount();
+		kv.format();
+		SHADOW sh;
+		// 書き換えない（冷たい）キー
+		for(uint32_t k = 0; k < 8; ++k) {
+			auto v = make_value_(64);
+			kv.write(k, v.data(), v.size());
+			sh[k] = v;
+		}
+
+		std::vector<uint32_t> lat;
+		lat.reserve(loop);
+		uint64_t user = 0;
+		auto prog0 = flash_.get_prog_words();
+		bool ok = true;
+		for(uint32_t i = 0; i < loop; ++i) {
+			uint32_t key;
+			std::vector<uint8_t> val;
+			bool rem;
+			workload_(key, val, rem);
+			auto t0 = flash_.get_time();
+			bool f;
+			if(rem) {
+				f = kv.remove(key) || sh.count(key) == 0;
+				sh.erase(key);
+			} else {
+				f = kv.write(key, val.data(), val.size());
+				sh[key] = val;
+				user += val.size();
+			}
+			lat.push_back(flash_.get_time() - t0);
+			if(!f) {
+				std::printf("  write fail: %u\n", i);
+				ok = false;
+				break;
+			}
+			if(background) {  // 書き込みの間に、service を何度か呼ぶ
+				for(int j = 0; j < 4; ++j) kv.service();
+			}
+			if((i % 1000) == 0) {
+				if(!verify_(kv, sh)) {
+					ok = false;
+					break;
+				}
+			}
+		}
+		KV kv2(flash_);
+		kv2.mount();
+		ok = verify_(kv2, sh) && ok;
+
+		std::sort(lat.begin(), lat.end());
+		uint64_t sum = 0;
+		for(auto t : lat) sum += t;
+		uint32_t emin, emax;
+		flash_.get_erase_range(emin, emax);
+		auto info = kv2.get_info();
+		if(!lat.empty()) {
+			std::printf("  latency (us): avg %u, p50 %u, p99 %u, max %u\n",
+				static_cast<uint32_t>(sum / lat.size()), lat[lat.size() / 2],
+				lat[lat.size() * 99 / 100], lat.back());
+		}
+		std::printf("  write amplification: %.2f\n",
+			static_cast<double>((flash_.get_prog_words() - prog0) * 4) / static_cast<double>(user));
+		std::printf("  erase count: min %u, max %u, GC %u segments\n", emin, emax, kv.get_info().gc_count);
+		std::printf("  keys %u, live %u bytes, free segments %u\n", info.keys, info.live, info.seg_free);
+		if(flash_.get_violation() != 0) {
+			std::printf("  program violation: %u\n", flash_.get_violation());
+			ok = false;
+		}
+		host::check(ok, "all keys after remount");
+	}
+
+
+	void test_power_fail_(uint32_t loop)
+	{
+		std::printf("Power fail (%u trials):\n", loop);
+		flash_ = data_flash_sim();
+		SHADOW sh;
+		{
+			KV kv(flash_);
+			kv.mount();
+			kv.format();
+		}
+		uint32_t fail = 0;
+		uint32_t old_val = 0;
+		uint32_t new_val = 0;
+		for(uint32_t n = 0; n < loop; ++n) {
+			KV kv(flash_);
+			if(!kv.mount()) {
+				std::printf("  mount fail: %u\n", n);
+				++fail;
+				break;
+			}
+			// 電源断の前に、service を何度か呼ぶ（GC の途中の電源断も試す）
+			flash_.set_fail(rnd_() % 400);
+			uint32_t key = 0;
+			std::vector<uint8_t> val;
+			bool rem = false;
+			while(1) {
+				workload_(key, val, rem);
+				bool f;
+				if(rem) {
+					f = kv.remove(key) || sh.count(key) == 0;
+				} else {
+					f = kv.write(key, val.data(), val.size());
+				}
+				if(flash_.is_dead()) break;
+				if(!f) {
+					auto t = kv.get_info();
+					std::printf("  write fail: %u (free %u, dirty %u)\n", n, t.seg_free, t.seg_dirty);
+					++fail;
+					break;
+				}
+				if(rem) sh.erase(key);
+				else sh[key] = val;
+				kv.service();
+				if(flash_.is_dead()) {
+					key = KV::KEY_NONE;
+					break;
+				}
+			}
+			flash_.set_fail(-1);
+
+			KV kv2(flash_);
+			kv2.mount();
+			if(!verify_(kv2, sh, key)) {
+				++fail;
+				continue;
+			}
+			if(key == KV::KEY_NONE) continue;
+			// 途中だったキーは、古い値か新しい値のどちらか
+			uint8_t tmp[KV::VALUE_MAX];
+			auto sz = kv2.read(key, tmp, sizeof(tmp));
+			bool is_new = rem ? !kv2.probe(key) : (sz == val.size() && std::memcmp(tmp, val.data(), sz) == 0);
+			auto it = sh.find(key);
+			bool is_old = it == sh.end() ? !kv2.probe(key) :
+				(sz == it->second.size() && std::memcmp(tmp, it->second.data(), sz) == 0);
+			if(is_new) {
+				++new_val;
+				if(rem) sh.erase(key);
+				else sh[key] = val;
+			} else if(is_old) {
+				++old_val;
+			} else {
+				std::printf("  key %u: torn value\n", key);
+				++fail;
+			}
+		}
+		std::printf("  interrupted write: old %u, new %u\n", old_val, new_val);
+		if(flash_.get_violation() != 0) {
+			std::printf("  program violation: %u\n", flash_.get_violation());
+			++fail;
+		}
+		host::check(fail == 0, "old or new value, no torn value (%u fail)", fail);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto loop = host::arg(argc, argv, 1, 100000);
+
+	std::printf("Data flash: %u bytes, erase unit %u, segment %u x %u\n",
+		data_flash_sim::DATA_SIZE, data_flash_sim::DATA_ERASE_SIZE, KV::SEG_NUM, SEG_SIZE);
+
+	test_basic_();
+	test_endurance_(loop, false);
+	test_endurance_(loop, true);
+	test_power_fail_(loop / 50);
+
+	return host::result();
+}
@@ -0,0 +1,164 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	FT5206 タッチ・シミュレーター（ホスト用） @n
+			chip::FT5206 と同じインターフェースで、タッチ入力をプログラム（スクリプト） @n
+			から与える。シングル・タッチのみ。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include "common/vtx.hpp"
+
+namespace chip {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  FT5206 シミュレーター・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class FT5206_sim {
+	public:
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  Touch Event Type
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class EVENT : uint8_t {
+			DOWN,		///< Touch Down
+			UP,			///< Touch Up
+			CONTACT,	///< Contact
+			NONE
+		};
+
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  Touch Struct
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		struct touch_t {
+			EVENT		before;	///< Touch Event (before)
+			EVENT		event;	///< Touch Event
+			uint8_t		id;		///< Touch ID
+			vtx::spos	pos;	///< Touch Position
+			vtx::spos	org;	///< Touch Down Position
+			vtx::spos	end;	///< Touch Up Position
+
+			touch_t() noexcept : before(EVENT::NONE), event(EVENT::NONE), id(0),
+				pos(0), org(0), end(0) { }
+
+			uint32_t length_sqr() const noexcept
+			{
+				auto d = end - org;
+				return d.x * d.x + d.y * d.y;
+			}
+		};
+
+	private:
+		static constexpr uint32_t TOUCH_NUM = 4;
+
+		touch_t		t_[TOUCH_NUM];
+		uint8_t		touch_num_;
+		bool		req_;
+		vtx::spos	req_pos_;
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		FT5206_sim() noexcept : t_{ }, touch_num_(0), req_(false), req_pos_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	開始
+			@return 常に「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool start() noexcept { return true; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	起動済みか（常に「true」）
+			@return 常に「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool get_startup() const noexcept { return true; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	タッチ（押下、又は移動）を設定 @n
+					次の update で反映される。
+			@param[in]	pos		タッチ位置
+		*/
+		//-----------------------------------------------------------------//
+		void touch(const vtx::spos& pos) noexcept
+		{
+			req_ = true;
+			req_pos_ = pos;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	タッチを離す @n
+					次の update で反映される。
+		*/
+		//-----------------------------------------------------------------//
+		void release() noexcept { req_ = false; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	アップデート（フレーム毎に呼ぶ）
+		*/
+		//-----------------------------------------------------------------//
+		void update() noexcept
+		{
+			auto& t = t_[0];
+			t.before = t.event;
+			if(req_) {
+				if(touch_num_ == 0) {
+					t.event = EVENT::DOWN;
+					t.org = req_pos_;
+				} else {
+					t.event = EVENT::CONTACT;
+				}
+				t.pos = req_pos_;
+				touch_num_ = 1;
+			} else {
+				if(touch_num_ != 0) {
+					t.event = EVENT::UP;
+					t.end = t.pos;
+				}
+				touch_num_ = 0;
+			}
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	タッチ数を取得
+			@return タッチ数
+		 */
+		//-----------------------------------------------------------------//
+		uint8_t get_touch_num() const noexcept { return touch_num_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	タッチ位置を取得
+			@param[in]	idx	タッチ・インデックス（０～３）
+			@return タッチ位置
+		 */
+		//-----------------------------------------------------------------//
+		const touch_t& get_touch_pos(uint8_t idx) const noexcept { return t_[idx & 3]; }
+	};
+}
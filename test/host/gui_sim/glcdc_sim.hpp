@@ -0,0 +1,206 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	GLCDC シミュレーター（ホスト用、ヘッドレス） @n
+			glcdc_mgr と同じインターフェースで、フレームバッファを RAM に持つ。 @n
+			graphics::render、gui::widget_director をホストで動かす為に使う。 @n
+			フレームは PPM 形式で保存でき、ハッシュ値で描画結果を比較できる。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstdio>
+#include "graphics/pixel.hpp"
+
+namespace device {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  GLCDC シミュレーター class
+		@param[in]	XSIZE	X 方向ピクセルサイズ
+		@param[in]	YSIZE	Y 方向ピクセルサイズ
+		@param[in]	PXT_	ピクセル・タイプ（RGB565 のみ）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <int16_t XSIZE, int16_t YSIZE, graphics::pixel::TYPE PXT_>
+	class glcdc_sim {
+	public:
+		static constexpr int16_t width  = XSIZE;
+		static constexpr int16_t height = YSIZE;
+		static constexpr graphics::pixel::TYPE PXT = PXT_;
+		static constexpr int16_t line_width =
+			(((width * static_cast<int16_t>(PXT) / 8) + 63) & 0x7fc0) / (static_cast<int16_t>(PXT) / 8);
+		static constexpr uint32_t frame_size =
+			line_width * (static_cast<uint32_t>(PXT) / 8) * height;
+
+		static_assert(PXT == graphics::pixel::TYPE::RGB565, "glcdc_sim supports RGB565 only");
+
+	private:
+		uint16_t	fb_[2][frame_size / 2];
+		bool		enable_double_;
+		uint32_t	flip_count_;
+		uint32_t	vpos_count_;
+
+		uint32_t draw_index_() const noexcept
+		{
+			if(enable_double_) {
+				return (flip_count_ & 1) != 0 ? 0 : 1;
+			}
+			return 0;
+		}
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		glcdc_sim() noexcept : fb_{ }, enable_double_(false), flip_count_(0), vpos_count_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	開始（ホストでは何もしない）
+			@return 常に「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool start() noexcept { return true; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ダブルバッファの許可
+			@param[in]	ena		不許可の場合「false」
+			@return 常に「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool enable_double_buffer(bool ena = true) noexcept
+		{
+			enable_double_ = ena;
+			return true;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	ダブルバッファが有効か検査
+			@return 有効な場合「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool is_double_buffer() const noexcept { return enable_double_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	描画フレームバッファのアドレスを取得
+			@return フレームバッファ
+		*/
+		//-----------------------------------------------------------------//
+		void* get_fbp() const noexcept
+		{
+			return const_cast<uint16_t*>(fb_[draw_index_()]);
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	表示フレームバッファのアドレスを取得 @n
+					※ダブルバッファの場合、描画中では無い方
+			@return フレームバッファ
+		*/
+		//-----------------------------------------------------------------//
+		const uint16_t* get_display_fbp() const noexcept
+		{
+			return fb_[enable_double_ ? (draw_index_() ^ 1) : 0];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  VPOS との同期（ホストでは待たずに、カウントだけ進める）
+		*/
+		//-----------------------------------------------------------------//
+		void sync_vpos() noexcept
+		{
+			++vpos_count_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  バッファの FLIP
+		*/
+		//-----------------------------------------------------------------//
+		void flip() noexcept
+		{
+			++flip_count_;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  VPOS カウントの取得
+			@return VPOS カウント
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_vpos_count() const noexcept { return vpos_count_; }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  表示フレームのハッシュ（FNV-1a）を取得 @n
+					描画結果の回帰比較に使う。
+			@return ハッシュ値
+		*/
+		//-----------------------------------------------------------------//
+		uint32_t get_hash() const noexcept
+		{
+			const auto* fb = get_display_fbp();
+			uint32_t h = 0x811c9dc5;
+			for(int16_t y = 0; y < height; ++y) {
+				const auto* p = &fb[y * line_width];
+				for(int16_t x = 0; x < width; ++x) {
+					h = (h ^ (p[x] & 0xff)) * 0x01000193;
+					h = (h ^ (p[x] >> 8)) * 0x01000193;
+				}
+			}
+			return h;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief  表示フレームを PPM（P6）形式で保存
+			@param[in]	file	ファイル名
+			@return 成功なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool save_ppm(const char* file) const noexcept
+		{
+			auto fp = fopen(file, "wb");
+			if(fp == nullptr) return false;
+
+			fprintf(fp, "P6\n%d %d\n255\n", width, height);
+			const auto* fb = get_display_fbp();
+			for(int16_t y = 0; y < height; ++y) {
+				const auto* p = &fb[y * line_width];
+				for(int16_t x = 0; x < width; ++x) {
+					auto c = p[x];
+					uint8_t rgb[3];
+					rgb[0] = ((c >> 11) & 0x1f) << 3;
+					rgb[1] = ((c >> 5) & 0x3f) << 2;
+					rgb[2] = (c & 0x1f) << 3;
+					rgb[0] |= rgb[0] >> 5;
+					rgb[1] |= rgb[1] >> 6;
+					rgb[2] |= rgb[2] >> 5;
+					fwrite(rgb, 1, 3, fp);
+				}
+			}
+			fclose(fp);
+			return true;
+		}
+	};
+}
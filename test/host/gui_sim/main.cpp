@@ -0,0 +1,373 @@
+//=========================================================================//
+/*! @file
+    @brief  GUI シミュレーター（ホスト用、ヘッドレス） @n
+			GUI_sample と同じ widget 構成を、RAM 上のフレームバッファに描画する。 @n
+			タッチ入力はスクリプトで与え、同じ入力なら同じフレームが得られる。 @n
+			フレーム毎、widget 毎の描画時間を計測して、最後に一覧を出力する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "common/format.hpp"
+#include "common/fixed_string.hpp"
+
+#include "graphics/font8x16.hpp"
+#include "graphics/kfont.hpp"
+#include "graphics/graphics.hpp"
+
+#include "gui/widget_director.hpp"
+
+#include "glcdc_sim.hpp"
+#include "FT5206_sim.hpp"
+#include "sim_script.hpp"
+
+namespace {
+
+	// LCD 定義
+	static constexpr int16_t LCD_X = 480;
+	static constexpr int16_t LCD_Y = 272;
+	static constexpr auto PIX = graphics::pixel::TYPE::RGB565;
+
+	typedef device::glcdc_sim<LCD_X, LCD_Y, PIX> GLCDC;
+
+	// フォントの定義
+	typedef graphics::font8x16 AFONT;
+	typedef graphics::kfont<16, 16> KFONT;
+	typedef graphics::font<AFONT, KFONT> FONT;
+
+	// ソフトウェアーレンダラー
+	typedef graphics::render<GLCDC, FONT> RENDER;
+	typedef graphics::def_color DEF_COLOR;
+
+	GLCDC		glcdc_;
+	AFONT		afont_;
+	KFONT		kfont_;
+	FONT		font_(afont_, kfont_);
+	RENDER		render_(glcdc_, font_);
+
+	typedef chip::FT5206_sim TOUCH;
+	TOUCH		touch_;
+
+	typedef gui::widget_director<RENDER, TOUCH, 32> WIDD;
+	WIDD		widd_(render_, touch_);
+
+	typedef gui::widget WIDGET;
+
+	// --- page 0
+	typedef gui::button BUTTON;
+	BUTTON		button_(vtx::srect(10, 10, 80, 32), "Button");
+	BUTTON		button_stall_(vtx::srect(100, 10, 80, 32), "Stall");
+	typedef gui::check CHECK;
+	CHECK		check_(vtx::srect(   10, 10+50, 0, 0), "Check");
+	typedef gui::group<3> GROUP3;
+	GROUP3		group_(vtx::srect(   10, 10+50+40, 0, 0));
+	typedef gui::radio RADIO;
+	RADIO		radioR_(vtx::srect(   0, 40*0, 0, 0), "Red");
+	RADIO		radioG_(vtx::srect(   0, 40*1, 0, 0), "Green");
+	RADIO		radioB_(vtx::srect(   0, 40*2, 0, 0), "Blue");
+	typedef gui::slider SLIDER;
+	SLIDER		sliderh_(vtx::srect(200, 20, 200, 0), 0.5f);
+	SLIDER		sliderv_(vtx::srect(460, 20, 0, 200), 0.0f);
+	typedef gui::menu MENU;
+	MENU		menu_(vtx::srect(120, 70, 100, 0), "ItemA,ItemB,ItemC,ItemD");
+	typedef gui::text TEXT;
+	TEXT		text_(vtx::srect(240, 70, 150, 20), "１６ピクセル漢字の表示サンプル～");
+	typedef gui::textbox TEXTBOX;
+	TEXTBOX		textbox_(vtx::srect(240, 100, 160, 80), "");
+	typedef gui::spinbox SPINBOX;
+	SPINBOX		spinbox_(vtx::srect(20, 220, 120, 0),
+					{ .min = -100, .value = 0, .max = 100, .step = 1, .accel = true });
+	typedef gui::toggle TOGGLE;
+	TOGGLE		toggle_(vtx::srect(160, 220, 0, 0));
+	typedef gui::progress PROGRESS;
+	PROGRESS	progress_(vtx::srect(240, 220, 150, 0));
+
+	BUTTON		next0_(vtx::srect(480-45, 272-45, 40, 40), ">", BUTTON::STYLE::CIRCLE_WITH_FRAME);
+
+	// --- page 1
+	BUTTON		prev1_(vtx::srect(5, 5, 40, 40), "<", BUTTON::STYLE::CIRCLE_WITH_FRAME);
+	TEXT		text_asc_(vtx::srect(70, 0, 260, 20));
+	typedef gui::key_asc KEY_ASC;
+	KEY_ASC		key_asc_(vtx::srect((480 - KEY_ASC::BOARD_WIDTH) / 2, 272 - KEY_ASC::BOARD_HEIGHT, WIDGET::SIZE_AUTO, WIDGET::SIZE_AUTO));
+
+	utils::fixed_string<32> buff_asc_;
+
+	// widget 毎の描画時間
+	static constexpr uint32_t PROF_NUM = 32;
+	struct prof_t {
+		const gui::widget*	w;
+		uint32_t	count;
+		uint64_t	total;	// ナノ秒
+		uint64_t	max;
+	};
+	prof_t		prof_[PROF_NUM];
+	std::chrono::steady_clock::time_point	prof_t0_;
+
+	void draw_hook_(const gui::widget* w, bool end)
+	{
+		if(!end) {
+			prof_t0_ = std::chrono::steady_clock::now();
+			return;
+		}
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - prof_t0_).count();
+		for(auto& t : prof_) {
+			if(t.w == nullptr) {
+				t.w = w;
+			}
+			if(t.w == w) {
+				++t.count;
+				t.total += ns;
+				if(static_cast<uint64_t>(ns) > t.max) t.max = ns;
+				break;
+			}
+		}
+	}
+
+
+	void setup_gui_()
+	{
+		button_.set_layer(WIDGET::LAYER::_0);
+		button_.at_select_func() = [=](uint32_t id) {
+			utils::format("Select Button: %d\n") % id;
+			if(button_stall_.get_state() == BUTTON::STATE::STALL) {
+				button_stall_.set_state(BUTTON::STATE::ENABLE);
+				button_stall_.set_title("Active");
+			} else if(button_stall_.get_state() == BUTTON::STATE::ENABLE) {
+				button_stall_.set_state(BUTTON::STATE::STALL);
+				button_stall_.set_title("Stall");
+			}
+		};
+		button_stall_.set_layer(WIDGET::LAYER::_0);
+		button_stall_.set_state(BUTTON::STATE::STALL);
+
+		check_.set_layer(WIDGET::LAYER::_0);
+		check_.at_select_func() = [=](bool ena) {
+			utils::format("Select Check: %s\n") % (ena ? "On" : "Off");
+		};
+
+		group_ + radioR_ + radioG_ + radioB_;
+		group_.set_layer(WIDGET::LAYER::_0);
+		radioR_.at_select_func() = [=](bool ena) {
+			utils::format("Select Red: %s\n") % (ena ? "On" : "Off");
+		};
+		radioG_.at_select_func() = [=](bool ena) {
+			utils::format("Select Green: %s\n") % (ena ? "On" : "Off");
+		};
+		radioB_.at_select_func() = [=](bool ena) {
+			utils::format("Select Blue: %s\n") % (ena ? "On" : "Off");
+		};
+		radioG_.exec_select();
+
+		sliderh_.set_layer(WIDGET::LAYER::_0);
+		sliderh_.at_select_func() = [=](float val) {
+			utils::format("Slider H: %3.2f\n") % val;
+		};
+		sliderv_.set_layer(WIDGET::LAYER::_0);
+		sliderv_.at_select_func() = [=](float val) {
+			utils::format("Slider V: %3.2f\n") % val;
+		};
+
+		menu_.set_layer(WIDGET::LAYER::_0);
+		menu_.at_select_func() = [=](uint32_t pos, uint32_t num) {
+			char tmp[32];
+			menu_.get_select_text(tmp, sizeof(tmp));
+			utils::format("Menu: '%s', %u/%u\n") % tmp % pos % num;
+		};
+
+		text_.set_layer(WIDGET::LAYER::_0);
+
+		textbox_.set_layer(WIDGET::LAYER::_0);
+		textbox_.set_title("(1) 項目\n(2) GUI サンプルについて。\n(3) まとめ");
+		textbox_.set_vertical_alignment(TEXTBOX::V_ALIGNMENT::CENTER);
+
+		spinbox_.set_layer(WIDGET::LAYER::_0);
+		spinbox_.at_select_func() = [=](SPINBOX::TOUCH_AREA area, int16_t value) {
+			utils::format("Spinbox: %d\n") % value;
+		};
+
+		toggle_.set_layer(WIDGET::LAYER::_0);
+		toggle_.at_select_func() = [=](bool state) {
+			utils::format("Toggle: %s\n") % (state ? "OFF" : "ON");
+		};
+
+		progress_.set_layer(WIDGET::LAYER::_0);
+		progress_.at_update_func() = [=](float ratio) {
+			if(toggle_.get_switch_state()) {
+				ratio += 1.0f / 120.0f;
+				if(ratio > 1.0f) ratio = 1.0f;
+			} else {
+				ratio = 0.0f;
+			}
+			return ratio;
+		};
+
+		next0_.set_layer(WIDGET::LAYER::_0);
+		next0_.at_select_func() = [=](uint32_t id) {
+			widd_.clear();
+			widd_.enable(WIDGET::LAYER::_0, false);
+			widd_.enable(WIDGET::LAYER::_1);
+		};
+
+		prev1_.set_layer(WIDGET::LAYER::_1);
+		prev1_.at_select_func() = [=](uint32_t id) {
+			widd_.clear();
+			widd_.enable(WIDGET::LAYER::_0);
+			widd_.enable(WIDGET::LAYER::_1, false);
+		};
+
+		text_asc_.set_layer(WIDGET::LAYER::_1);
+		text_asc_.enable_scroll(false);
+		text_asc_.set_title(buff_asc_.c_str());
+
+		key_asc_.set_layer(WIDGET::LAYER::_1);
+		key_asc_.at_select_func() = [=](char code, KEY_ASC::KEY_MAP key_map) {
+			if(code == KEY_ASC::KEY_BACK_SPACE || code == KEY_ASC::KEY_DEL) {
+				buff_asc_.pop_back();
+			} else if(code == KEY_ASC::KEY_ENTER) {
+				buff_asc_.clear();
+			} else if(code >= 0x20 && code <= 0x7f) {
+				if(buff_asc_.capacity() == buff_asc_.size()) {
+					buff_asc_.erase(0, 1);
+				}
+				buff_asc_ += code;
+			}
+			text_asc_.set_update();
+		};
+
+		widd_.enable(WIDGET::LAYER::_0);
+	}
+
+
+	void list_profile_(uint32_t frames, uint64_t frame_total, uint64_t frame_max)
+	{
+		utils::format("Frames: %u, average: %u [us], max: %u [us]\n")
+			% frames
+			% static_cast<uint32_t>(frames != 0 ? (frame_total / frames / 1000) : 0)
+			% static_cast<uint32_t>(frame_max / 1000);
+		utils::format("Widget             count  average[us]  max[us]\n");
+		for(const auto& t : prof_) {
+			if(t.w == nullptr) break;
+			char tmp[20];
+			utils::sformat("%s(%d)", tmp, sizeof(tmp)) % t.w->get_name()
+				% static_cast<int>(t.w->get_id());
+			utils::format("%-18s %5u  %11u  %7u\n") % tmp % t.count
+				% static_cast<uint32_t>(t.total / t.count / 1000)
+				% static_cast<uint32_t>(t.max / 1000);
+		}
+	}
+
+
+	void usage_(const char* cmd)
+	{
+		utils::format("usage:\n");
+		utils::format("    %s [options] script-file\n") % cmd;
+		utils::format("options:\n");
+		utils::format("    -frame N    maximum frames (default 600)\n");
+		utils::format("    -double     enable double buffer\n");
+	}
+}
+
+
+/// widget の登録・グローバル関数
+bool insert_widget(gui::widget* w)
+{
+    return widd_.insert(w);
+}
+
+/// widget の解除・グローバル関数
+void remove_widget(gui::widget* w)
+{
+    widd_.remove(w);
+}
+
+
+int main(int argc, char** argv);
+
+int main(int argc, char** argv)
+{
+	const char* script = nullptr;
+	uint32_t frame_limit = 600;
+	for(int i = 1; i < argc; ++i) {
+		if(strcmp(argv[i], "-frame") == 0 && (i + 1) < argc) {
+			frame_limit = strtoul(argv[i + 1], nullptr, 10);
+			++i;
+		} else if(strcmp(argv[i], "-double") == 0) {
+			glcdc_.enable_double_buffer();
+		} else if(argv[i][0] != '-') {
+			script = argv[i];
+		} else {
+			usage_(argv[0]);
+			return 1;
+		}
+	}
+
+	utils::sim_script scr;
+	if(script != nullptr) {
+		if(!scr.load(script)) {
+			utils::format("Script load error: '%s'\n") % script;
+			return 1;
+		}
+	}
+
+	setup_gui_();
+	widd_.set_draw_hook(draw_hook_);
+
+	render_.clear(DEF_COLOR::Black);
+	render_.sync_frame();
+	render_.clear(DEF_COLOR::Black);
+
+	uint64_t frame_total = 0;
+	uint64_t frame_max = 0;
+	uint32_t frame = 0;
+	bool loop = true;
+	while(loop && frame < frame_limit) {
+		render_.sync_frame();
+
+		const utils::sim_script::cmd_t* t;
+		while((t = scr.fetch(frame)) != nullptr) {
+			switch(t->cmd) {
+			case utils::sim_script::CMD::DOWN:
+			case utils::sim_script::CMD::MOVE:
+				touch_.touch(vtx::spos(t->x, t->y));
+				break;
+			case utils::sim_script::CMD::UP:
+				touch_.release();
+				break;
+			case utils::sim_script::CMD::SHOT:
+				if(!glcdc_.save_ppm(t->arg.c_str())) {
+					utils::format("Can't write: '%s'\n") % t->arg.c_str();
+				}
+				break;
+			case utils::sim_script::CMD::HASH:
+				utils::format("Frame %u hash: %08X\n") % frame % glcdc_.get_hash();
+				break;
+			case utils::sim_script::CMD::END:
+				loop = false;
+				break;
+			}
+		}
+		if(!loop) break;
+
+		touch_.update();
+
+		auto t0 = std::chrono::steady_clock::now();
+		widd_.update();
+		uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - t0).count();
+		frame_total += ns;
+		if(ns > frame_max) frame_max = ns;
+
+		render_.flip();
+		++frame;
+	}
+
+	list_profile_(frame, frame_total, frame_max);
+}
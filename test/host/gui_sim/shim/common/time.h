@@ -0,0 +1,45 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	時間関数（ホスト・シミュレーター用） @n
+			※ホストの time.h を使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <stdint.h>
+#include <time.h>
+
+//-----------------------------------------------------------------//
+/*!
+	@brief	「曜日」文字列を取得
+	@param[in]	idx	インデックス
+	@return 文字列（３文字）
+*/
+//-----------------------------------------------------------------//
+inline const char* get_wday(uint8_t idx)
+{
+	static const char* wday[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+	if(idx >= 7) return "---";
+	return wday[idx];
+}
+
+
+//-----------------------------------------------------------------//
+/*!
+	@brief	「月」文字列を取得
+	@param[in]	idx	インデックス
+	@return 文字列（３文字）
+*/
+//-----------------------------------------------------------------//
+inline const char* get_mon(uint8_t idx)
+{
+	static const char* mon[] = {
+		"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+		"Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+	};
+	if(idx >= 12) return "---";
+	return mon[idx];
+}
@@ -0,0 +1,13 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	MMC（SD カード）ドライバー（ホスト・シミュレーター用） @n
+			※ホストにはカード・スロットが無いので、ヘッダーのみ。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include "ff14/source/ff.h"
+#include "ff14/source/diskio.h"
@@ -0,0 +1,157 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	GUI シミュレーター・スクリプト（ホスト用） @n
+			１行１コマンド、先頭はフレーム番号（昇順）。 @n
+			「#」以降はコメント。 @n
+				<frame> down x y	タッチ押下 @n
+				<frame> move x y	タッチ移動 @n
+				<frame> up			タッチを離す @n
+				<frame> shot file	表示フレームを PPM で保存 @n
+				<frame> hash		表示フレームのハッシュを出力 @n
+				<frame> end			終了
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  シミュレーター・スクリプト・クラス
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class sim_script {
+	public:
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		/*!
+			@brief  コマンド型
+		*/
+		//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+		enum class CMD : uint8_t {
+			DOWN,	///< タッチ押下
+			MOVE,	///< タッチ移動
+			UP,		///< タッチを離す
+			SHOT,	///< フレーム保存
+			HASH,	///< フレーム・ハッシュ出力
+			END,	///< 終了
+		};
+
+		struct cmd_t {
+			uint32_t	frame;
+			CMD			cmd;
+			int16_t		x;
+			int16_t		y;
+			std::string	arg;
+		};
+
+	private:
+		std::vector<cmd_t>	cmds_;
+		uint32_t			pos_;
+
+	public:
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	コンストラクター
+		*/
+		//-----------------------------------------------------------------//
+		sim_script() noexcept : cmds_(), pos_(0) { }
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	スクリプトの読み込み
+			@param[in]	file	ファイル名
+			@return 成功なら「true」（エラー行は標準エラーに出力）
+		*/
+		//-----------------------------------------------------------------//
+		bool load(const char* file)
+		{
+			auto fp = fopen(file, "rb");
+			if(fp == nullptr) return false;
+
+			cmds_.clear();
+			pos_ = 0;
+			char line[256];
+			uint32_t lno = 0;
+			bool ret = true;
+			while(fgets(line, sizeof(line), fp) != nullptr) {
+				++lno;
+				auto p = strchr(line, '#');
+				if(p != nullptr) *p = 0;
+				unsigned int frame;
+				char cmd[16];
+				char arg[200];
+				int n = sscanf(line, "%u %15s %199s", &frame, cmd, arg);
+				if(n <= 0) continue;
+				cmd_t t;
+				t.frame = frame;
+				t.x = 0;
+				t.y = 0;
+				bool ok = n >= 2;
+				if(ok && (strcmp(cmd, "down") == 0 || strcmp(cmd, "move") == 0)) {
+					t.cmd = cmd[0] == 'd' ? CMD::DOWN : CMD::MOVE;
+					int x, y;
+					ok = sscanf(line, "%*u %*s %d %d", &x, &y) == 2;
+					t.x = x;
+					t.y = y;
+				} else if(ok && strcmp(cmd, "up") == 0) {
+					t.cmd = CMD::UP;
+				} else if(ok && strcmp(cmd, "shot") == 0) {
+					t.cmd = CMD::SHOT;
+					ok = n == 3;
+					if(ok) t.arg = arg;
+				} else if(ok && strcmp(cmd, "hash") == 0) {
+					t.cmd = CMD::HASH;
+				} else if(ok && strcmp(cmd, "end") == 0) {
+					t.cmd = CMD::END;
+				} else {
+					ok = false;
+				}
+				if(ok && !cmds_.empty() && cmds_.back().frame > t.frame) {
+					ok = false;
+				}
+				if(!ok) {
+					fprintf(stderr, "%s(%u): script error\n", file, lno);
+					ret = false;
+					continue;
+				}
+				cmds_.push_back(t);
+			}
+			fclose(fp);
+			return ret;
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	フレームのコマンドを取り出す
+			@param[in]	frame	現在のフレーム
+			@return コマンド（無ければ nullptr）
+		*/
+		//-----------------------------------------------------------------//
+		const cmd_t* fetch(uint32_t frame) noexcept
+		{
+			if(pos_ >= cmds_.size()) return nullptr;
+			if(cmds_[pos_].frame > frame) return nullptr;
+			return &cmds_[pos_++];
+		}
+
+
+		//-----------------------------------------------------------------//
+		/*!
+			@brief	全てのコマンドを処理したか
+			@return 処理済なら「true」
+		*/
+		//-----------------------------------------------------------------//
+		bool empty() const noexcept { return pos_ >= cmds_.size(); }
+	};
+}
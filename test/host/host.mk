@@ -0,0 +1,127 @@
+# -*- tab-width : 4 -*-
+#=======================================================================
+#   @file
+#   @brief  ホスト用テスト、ベンチマーク共通 Makefile @n
+#			各ディレクトリの Makefile で TARGET などを定義してから @n
+#			include する。 @n
+#			TARGET		実行ファイル名（必須） @n
+#			PSOURCES	C++ ソース（省略時 main.cpp） @n
+#			CSOURCES	C ソース @n
+#			VPATH		ソースの検索パス（$(ROOT) からの相対で書く） @n
+#			PINC_APP	インクルード・パス（省略時 $(ROOT)） @n
+#			PFLAGS		C++ の定義（省略時 -DUSE_PUTCHAR） @n
+#			RUN_ARGS	「make run」、「make check」で渡す引数
+#   @author 平松邦仁 (hira@rvf-rc45.net)
+#	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+#				Released under the MIT license @n
+#				https://github.com/hirakuni45/RX/blob/master/LICENSE
+#=======================================================================
+# リポジトリのルート（test/host/xxx から見て）
+ROOT		=	../../..
+
+# 'debug' or 'release'
+BUILD		?=	release
+
+PSOURCES	?=	main.cpp
+CSOURCES	?=
+
+STDLIBS		?=
+OPTLIBS		?=
+
+PINC_APP	?=	$(ROOT)
+CINC_APP	?=	$(ROOT)
+LIBDIR		?=
+
+INC_P	=	$(addprefix -I, $(PINC_APP))
+INC_C	=	$(addprefix -I, $(CINC_APP))
+CINCS	=	$(INC_C)
+PINCS	=	$(INC_P)
+LIBS	=	$(addprefix -L, $(LIBDIR))
+LIBN	=	$(addprefix -l, $(STDLIBS))
+LIBN	+=	$(addprefix -l, $(OPTLIBS))
+
+#
+# Compiler, Linker Options
+#
+CP	=	g++
+CC	=	gcc
+LK	=	g++
+
+POPT	=	-std=gnu++17
+COPT	=
+LOPT	=
+
+PFLAGS	?=	-DUSE_PUTCHAR
+CFLAGS	?=
+
+ifeq ($(BUILD),debug)
+	POPT += -O0 -g
+	COPT += -O0 -g
+	PFLAGS += -DDEBUG
+	CFLAGS += -DDEBUG
+endif
+
+ifeq ($(BUILD),release)
+	POPT += -O2
+	COPT += -O2
+	PFLAGS += -DNDEBUG
+	CFLAGS += -DNDEBUG
+endif
+
+LFLAGS =
+
+CCWARN	=	-Wimplicit -Wreturn-type -Wswitch \
+			-Wformat
+CPWARN	=	-Wall \
+			-Wno-unused-function
+
+OBJECTS	=	$(addprefix $(BUILD)/,$(patsubst %.cpp,%.o,$(PSOURCES))) \
+			$(addprefix $(BUILD)/,$(patsubst %.c,%.o,$(CSOURCES)))
+DEPENDS =   $(patsubst %.o,%.d, $(OBJECTS))
+
+.PHONY: all clean clean_depend run check
+.SUFFIXES :
+.SUFFIXES : .hpp .h .c .cpp .o
+
+all: $(BUILD) $(TARGET)
+
+$(TARGET): $(OBJECTS) Makefile $(ROOT)/test/host/host.mk
+	$(LK) $(LFLAGS) $(LIBS) $(OBJECTS) $(LIBN) -o $(TARGET)
+
+$(BUILD)/%.o : %.c
+	mkdir -p $(dir $@); \
+	$(CC) -c $(COPT) $(CFLAGS) $(CINCS) $(CCWARN) -o $@ $<
+
+$(BUILD)/%.o : %.cpp
+	mkdir -p $(dir $@); \
+	$(CP) -c $(POPT) $(PFLAGS) $(PINCS) $(CPWARN) -o $@ $<
+
+$(BUILD)/%.d : %.c
+	mkdir -p $(dir $@); \
+	$(CC) -MM -DDEPEND_ESCAPE $(COPT) $(CFLAGS) $(CINCS) $< \
+	| sed 's/$(notdir $*)\.o:/$(subst /,\/,$(patsubst %.d,%.o,$@) $@):/' > $@ ; \
+	[ -s $@ ] || rm -f $@
+
+$(BUILD)/%.d : %.cpp
+	mkdir -p $(dir $@); \
+	$(CP) -MM -DDEPEND_ESCAPE $(POPT) $(PFLAGS) $(PINCS) $< \
+	| sed 's/$(notdir $*)\.o:/$(subst /,\/,$(patsubst %.d,%.o,$@) $@):/' > $@ ; \
+	[ -s $@ ] || rm -f $@
+
+$(BUILD):
+	mkdir -p $(BUILD)
+
+run: all
+	./$(TARGET) $(RUN_ARGS)
+
+# 終了コードで合否を返す
+check: all
+	./$(TARGET) $(RUN_ARGS) > /dev/null
+
+clean:
+	rm -rf $(BUILD) $(TARGET) $(CLEAN_FILES)
+
+clean_depend:
+	rm -f $(DEPENDS)
+
+-include $(DEPENDS)
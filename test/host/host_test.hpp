@@ -0,0 +1,140 @@
+#pragma once
+//=========================================================================//
+/*! @file
+    @brief  ホスト用テスト、ベンチマーク共通ヘルパー @n
+			・check()	結果を「  ...: OK/NG」の形で表示して、NG を数える @n
+			・result()	main の戻り値（NG が無ければ 0） @n
+			・arg()		数値の引数（省略時は既定値） @n
+			・stop_watch, best_of()	サイクル数（TSC が無い場合は ns）の計測 @n
+			各ディレクトリの main.cpp から「test/host/host_test.hpp」で使う。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cstdint>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace host {
+
+	inline uint32_t	ng_count_ = 0;
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief  結果を表示して、NG を数える
+		@param[in]	ok	結果
+		@param[in]	fmt	書式（行頭の空白、末尾の「: OK」は付けない）
+		@return 結果をそのまま返す
+	*/
+	//-----------------------------------------------------------------//
+	inline bool check(bool ok, const char* fmt, ...) noexcept
+	{
+		std::printf("  ");
+		va_list ap;
+		va_start(ap, fmt);
+		std::vprintf(fmt, ap);
+		va_end(ap);
+		std::printf(": %s\n", ok ? "OK" : "NG");
+		if(!ok) ++ng_count_;
+		return ok;
+	}
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief  main の戻り値を取得
+		@return NG が無ければ 0
+	*/
+	//-----------------------------------------------------------------//
+	inline int result() noexcept { return ng_count_ == 0 ? 0 : 1; }
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief  数値の引数を取得
+		@param[in]	argc	main の argc
+		@param[in]	argv	main の argv
+		@param[in]	idx		引数の位置（1 から）
+		@param[in]	def		省略時の値
+		@return 値
+	*/
+	//-----------------------------------------------------------------//
+	inline uint32_t arg(int argc, char* argv[], int idx, uint32_t def) noexcept
+	{
+		if(idx < argc) {
+			return std::strtoul(argv[idx], nullptr, 0);
+		}
+		return def;
+	}
+
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  ストップ・ウォッチ（x86 は TSC のサイクル数、それ以外は ns）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	class stop_watch {
+		uint64_t	t_;
+		std::chrono::steady_clock::time_point	c_;
+
+	public:
+		stop_watch() noexcept : t_(0), c_() { start(); }
+
+		void start() noexcept
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			t_ = __rdtsc();
+#else
+			c_ = std::chrono::steady_clock::now();
+#endif
+		}
+
+		double stop() const noexcept
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			return static_cast<double>(__rdtsc() - t_);
+#else
+			return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - c_).count();
+#endif
+		}
+
+		static const char* unit() noexcept
+		{
+#if defined(__x86_64__) || defined(__i386__)
+			return "cycles";
+#else
+			return "ns";
+#endif
+		}
+	};
+
+
+	//-----------------------------------------------------------------//
+	/*!
+		@brief  何度か計って、一番速い値を取得
+		@param[in]	n	回数
+		@param[in]	f	計る処理
+		@return 一番速い値（stop_watch::unit() の単位）
+	*/
+	//-----------------------------------------------------------------//
+	template <class F>
+	double best_of(uint32_t n, F f)
+	{
+		double best = 1e30;
+		for(uint32_t i = 0; i < n; ++i) {
+			stop_watch t;
+			f();
+			auto c = t.stop();
+			if(c < best) best = c;
+		}
+		return best;
+	}
+}
@@ -0,0 +1,326 @@
+//=========================================================================//
+/*! @file
+    @brief  HUB75 BCM ストリーム検証（ホスト用） @n
+			chip::HUB75_BCM が作るポート・パターンを、パネルのモデル（シフト・ @n
+			レジスター、ラッチ、プレーン毎の表示時間）に流し、見える明るさを調べる。 @n
+			・ガンマ・テーブルの端点と単調性 @n
+			・RGB888/RGB565 の画像で、全ピクセル、全色の「Σ 2^plane」が @n
+			  ガンマ補正した値と一致するか @n
+			・１プレーンで CLK の立ち上がりが WIDTH 回か、B7 が０か @n
+			・行、プレーンの順番、フレーム境界 @n
+			・フレームの途中で切り替えを要求しても、次の境界まで切り替わらないか
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstring>
+#include <random>
+
+#include "chip/HUB75_BCM.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr uint32_t WIDTH  = 64;
+	static constexpr uint32_t HEIGHT = 32;
+	static constexpr uint32_t DEPTH  = 8;
+	typedef chip::HUB75_BCM<WIDTH, HEIGHT, DEPTH> BCM;
+
+	BCM		bcm_;
+
+	std::mt19937	rnd_(1234);
+
+	// パネルのモデル：CLK の立ち上がりでシフトし、ラッチした内容を 2^plane の時間表示する
+	// （最初にシフトしたビットが x = 0 に来る配線とする）
+	struct panel_t {
+		uint8_t		sreg_[WIDTH];
+		uint32_t	clocks_;
+		bool		clk_;
+		uint32_t	light_[HEIGHT][WIDTH][3];
+		uint32_t	errors_;
+
+		void reset()
+		{
+			std::memset(sreg_, 0, sizeof(sreg_));
+			std::memset(light_, 0, sizeof(light_));
+			clocks_ = 0;
+			clk_ = true;
+			errors_ = 0;
+		}
+
+		void shift(const uint8_t* src, uint32_t len)
+		{
+			clocks_ = 0;
+			for(uint32_t i = 0; i < len; ++i) {
+				auto d = src[i];
+				if(d & 0x80) ++errors_;
+				bool clk = (d & BCM::CLK) != 0;
+				if(clk && !clk_) {
+					if(clocks_ < WIDTH) sreg_[clocks_] = d;
+					++clocks_;
+				}
+				clk_ = clk;
+			}
+		}
+
+		void latch(uint32_t row, uint32_t plane)
+		{
+			auto w = 1u << plane;
+			for(uint32_t x = 0; x < WIDTH; ++x) {
+				auto d = sreg_[x];
+				if(d & BCM::R1) light_[row][x][0] += w;
+				if(d & BCM::G1) light_[row][x][1] += w;
+				if(d & BCM::B1) light_[row][x][2] += w;
+				if(d & BCM::R2) light_[row + BCM::ROWS][x][0] += w;
+				if(d & BCM::G2) light_[row + BCM::ROWS][x][1] += w;
+				if(d & BCM::B2) light_[row + BCM::ROWS][x][2] += w;
+			}
+		}
+	};
+
+	panel_t		panel_;
+
+	// 期待値（ガンマ補正後）、RGB888
+	uint8_t		ref_[HEIGHT][WIDTH][3];
+
+	// １フレーム分スキャン（ドライバーの割り込みと同じ順番）
+	// stop_step 番目のプレーンで hook を呼ぶ
+	template <class HOOK>
+	bool scan_frame_(HOOK hook, uint32_t stop_step = 0xffff'ffff)
+	{
+		panel_.reset();
+		bool ok = true;
+		uint32_t n = 0;
+		while(1) {
+			auto row = bcm_.get_row();
+			auto plane = bcm_.get_plane();
+			if(row != n / DEPTH || plane != n % DEPTH) {
+				std::printf("  order mismatch: step %u, row %u, plane %u\n", n, row, plane);
+				return false;
+			}
+			panel_.shift(bcm_.get_line(), BCM::LINE_SIZE);
+			if(panel_.clocks_ != WIDTH) {
+				std::printf("  clock mismatch: row %u, plane %u, %u clocks\n", row, plane, panel_.clocks_);
+				ok = false;
+			}
+			panel_.latch(row, plane);
+			if(n == stop_step) hook();
+			++n;
+			if(bcm_.step()) break;
+		}
+		if(n != BCM::ROWS * DEPTH) {
+			std::printf("  frame length mismatch: %u steps\n", n);
+			ok = false;
+		}
+		if(panel_.errors_ != 0) {
+			std::printf("  B7 is not zero: %u bytes\n", panel_.errors_);
+			ok = false;
+		}
+		return ok;
+	}
+
+	uint32_t compare_(const uint8_t* gamma)
+	{
+		uint32_t err = 0;
+		for(uint32_t y = 0; y < HEIGHT; ++y) {
+			for(uint32_t x = 0; x < WIDTH; ++x) {
+				for(uint32_t c = 0; c < 3; ++c) {
+					if(panel_.light_[y][x][c] != gamma[ref_[y][x][c]]) {
+						if(err < 4) {
+							std::printf("  pixel mismatch: (%u, %u) ch %u: %u / %u\n",
+								x, y, c, panel_.light_[y][x][c], gamma[ref_[y][x][c]]);
+						}
+						++err;
+					}
+				}
+			}
+		}
+		return err;
+	}
+
+	void make_image_(uint32_t type)
+	{
+		for(uint32_t y = 0; y < HEIGHT; ++y) {
+			for(uint32_t x = 0; x < WIDTH; ++x) {
+				auto p = ref_[y][x];
+				switch(type) {
+				case 0:  // グラデーション
+					p[0] = x * 255 / (WIDTH - 1);
+					p[1] = y * 255 / (HEIGHT - 1);
+					p[2] = 255 - p[0];
+					break;
+				case 1:  // 縦縞
+					p[0] = p[1] = p[2] = (x & 1) ? 255 : 0;
+					break;
+				default:  // ランダム
+					p[0] = rnd_();
+					p[1] = rnd_();
+					p[2] = rnd_();
+					break;
+				}
+			}
+		}
+	}
+
+	void test_gamma_()
+	{
+		bool ok = true;
+		for(float g : { 1.0f, 1.8f, 2.2f, 2.8f }) {
+			bcm_.set_gamma(g);
+			auto t = bcm_.get_gamma();
+			if(t[0] != 0 || t[255] != BCM::LEVEL_MAX) ok = false;
+			for(uint32_t i = 1; i < 256; ++i) {
+				if(t[i] < t[i - 1]) ok = false;
+			}
+			if(g == 1.0f) {
+				for(uint32_t i = 0; i < 256; ++i) {
+					if(t[i] != i * BCM::LEVEL_MAX / 255) ok = false;
+				}
+			}
+		}
+		bcm_.set_gamma(2.2f);
+		host::check(ok, "gamma:    end points, monotonic, linear at 1.0");
+	}
+
+	void test_888_()
+	{
+		bool ok = true;
+		static uint8_t src[HEIGHT][WIDTH][3];
+		for(uint32_t type = 0; type < 3; ++type) {
+			make_image_(type);
+			std::memcpy(src, ref_, sizeof(src));
+			bcm_.convert(&src[0][0][0]);
+			bcm_.flip();
+			// 切り替えの前のフレームを１枚流す
+			if(!scan_frame_([]{ })) ok = false;
+			if(!scan_frame_([]{ })) ok = false;
+			if(compare_(bcm_.get_gamma()) != 0) ok = false;
+		}
+		host::check(ok, "RGB888:   %u x %u, %u planes, stream / brightness", WIDTH, HEIGHT, DEPTH);
+	}
+
+	void test_565_()
+	{
+		bool ok = true;
+		static uint16_t src[HEIGHT][WIDTH];
+		for(uint32_t type = 0; type < 3; ++type) {
+			make_image_(type);
+			for(uint32_t y = 0; y < HEIGHT; ++y) {
+				for(uint32_t x = 0; x < WIDTH; ++x) {
+					auto p = ref_[y][x];
+					uint16_t c = ((p[0] >> 3) << 11) | ((p[1] >> 2) << 5) | (p[2] >> 3);
+					src[y][x] = c;
+					// 期待値は、565 を８ビットに戻した値
+					auto r = (c >> 11) & 0x1f;
+					auto g = (c >> 5) & 0x3f;
+					auto b = c & 0x1f;
+					p[0] = (r << 3) | (r >> 2);
+					p[1] = (g << 2) | (g >> 4);
+					p[2] = (b << 3) | (b >> 2);
+				}
+			}
+			bcm_.convert(&src[0][0]);
+			bcm_.flip();
+			if(!scan_frame_([]{ })) ok = false;
+			if(!scan_frame_([]{ })) ok = false;
+			if(compare_(bcm_.get_gamma()) != 0) ok = false;
+		}
+		host::check(ok, "RGB565:   %u x %u, %u planes, stream / brightness", WIDTH, HEIGHT, DEPTH);
+	}
+
+	// フレームの途中で書き換え、切り替えを要求しても、そのフレームは乱れない
+	void test_flip_()
+	{
+		bool ok = true;
+		static uint8_t a[HEIGHT][WIDTH][3];
+		static uint8_t b[HEIGHT][WIDTH][3];
+		make_image_(0);
+		std::memcpy(a, ref_, sizeof(a));
+		make_image_(2);
+		std::memcpy(b, ref_, sizeof(b));
+
+		bcm_.convert(&a[0][0][0]);
+		bcm_.flip();
+		scan_frame_([]{ });
+		if(bcm_.is_flip()) ok = false;
+
+		auto front = bcm_.get_front();
+		auto hook = [&] {
+			bcm_.convert(&b[0][0][0]);
+			bcm_.flip();
+		};
+		if(!scan_frame_(hook, BCM::ROWS * DEPTH / 2)) ok = false;
+		std::memcpy(ref_, a, sizeof(ref_));
+		if(compare_(bcm_.get_gamma()) != 0) ok = false;
+		if(bcm_.is_flip() || bcm_.get_front() == front) ok = false;
+
+		if(!scan_frame_([]{ })) ok = false;
+		std::memcpy(ref_, b, sizeof(ref_));
+		if(compare_(bcm_.get_gamma()) != 0) ok = false;
+
+		// 要求が無ければ切り替わらない
+		front = bcm_.get_front();
+		if(!scan_frame_([]{ })) ok = false;
+		if(bcm_.get_front() != front) ok = false;
+
+		host::check(ok, "flip:     request in mid frame switches at the frame boundary");
+	}
+
+	void bench_(uint32_t loop)
+	{
+		static uint8_t s888[HEIGHT][WIDTH][3];
+		static uint16_t s565[HEIGHT][WIDTH];
+		make_image_(2);
+		std::memcpy(s888, ref_, sizeof(s888));
+		for(uint32_t y = 0; y < HEIGHT; ++y) {
+			for(uint32_t x = 0; x < WIDTH; ++x) {
+				s565[y][x] = rnd_();
+			}
+		}
+
+		auto best888 = host::best_of(loop, [&]() { bcm_.convert(&s888[0][0][0]); });
+		auto best565 = host::best_of(loop, [&]() { bcm_.convert(&s565[0][0]); });
+		std::printf("  bench:    convert RGB888 %.0f, RGB565 %.0f %s/frame (%.1f / %.1f per pixel)\n",
+			best888, best565, host::stop_watch::unit(), best888 / (WIDTH * HEIGHT), best565 / (WIDTH * HEIGHT));
+	}
+
+	// リフレッシュ・レートの見積もり（ドライバーと同じく、シフトと表示を並行して行う）
+	void estimate_(uint32_t shift_freq, uint32_t base, uint32_t pclk)
+	{
+		auto shift = static_cast<double>(BCM::LINE_SIZE) / shift_freq;
+		auto unit = 8.0 / pclk;
+		double frame = 0.0;
+		double on = 0.0;
+		for(uint32_t p = 0; p < DEPTH; ++p) {
+			auto show = unit * (base << p);
+			frame += shift > show ? shift : show;
+			on += show;
+		}
+		frame *= BCM::ROWS;
+		on *= BCM::ROWS;
+		std::printf("  refresh:  shift %u Hz, base %u (PCLK %u Hz): %.1f Hz, OE duty %.1f %%\n",
+			shift_freq, base, pclk, 1.0 / frame, on / frame * 100.0);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto shift_freq = host::arg(argc, argv, 1, 3'000'000);
+	auto base = host::arg(argc, argv, 2, 16);
+	auto pclk = host::arg(argc, argv, 3, 60'000'000);
+
+	std::printf("HUB75 BCM (%u x %u, %u planes, 1/%u scan, %u bytes/frame):\n",
+		WIDTH, HEIGHT, DEPTH, BCM::ROWS, BCM::FRAME_SIZE);
+	test_gamma_();
+	test_888_();
+	test_565_();
+	test_flip_();
+	bench_(200);
+	estimate_(shift_freq, base, pclk);
+
+	return host::result();
+}
@@ -0,0 +1,273 @@
+//=========================================================================//
+/*! @file
+    @brief  ログ・マネージャー・ベンチマーク（ホスト用） @n
+			utils::log_man を、I2C EEPROM（24C256 相当）のモデル上で動かし、 @n
+			ログ１バイト当たりの書き込み量と、電源断からの復帰を検査する。 @n
+			・書き込みバイト数、I2C 転送バイト数（アドレスを含む）、 @n
+			  ページ書き込み回数（一回 5ms）を数える @n
+			・指定したバイト数を書き込んだ後に電源断（途中の転送は途切れる）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cstring>
+#include <string>
+#include <random>
+
+#include "common/log_man.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  EEPROM のモデル（MEMIO インターフェース）
+		@param[in]	ID	インスタンス識別
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	template <uint32_t ID>
+	struct eeprom_sim {
+		static constexpr uint32_t SIZE = 8192;
+		static constexpr uint32_t PAGE = 64;		///< EEPROM のページ
+		static constexpr uint32_t WRITE_US = 5000;	///< ページ書き込み時間
+		static constexpr uint32_t ADDR_BYTES = 3;	///< デバイス・アドレスとメモリー・アドレス
+
+		static uint8_t	mem_[SIZE];
+		static uint64_t	wr_bytes_;
+		static uint64_t	bus_bytes_;
+		static uint64_t	pages_;
+		static int64_t	fail_;	// 電源断までのバイト数（負なら無効）
+
+		static void reset() noexcept
+		{
+			wr_bytes_ = 0;
+			bus_bytes_ = 0;
+			pages_ = 0;
+		}
+
+		static void start() noexcept { }
+
+		// ページを跨がない転送に分ける
+		static uint32_t write_(const uint8_t* src, uint32_t len, uint32_t dst) noexcept
+		{
+			uint32_t n = 0;
+			while(n < len) {
+				auto l = PAGE - ((dst + n) % PAGE);
+				if(l > (len - n)) l = len - n;
+				bus_bytes_ += ADDR_BYTES + l;
+				for(uint32_t i = 0; i < l; ++i) {
+					if(fail_ == 0) return n;  // 電源断
+					if(fail_ > 0) --fail_;
+					mem_[dst + n + i] = src[n + i];
+					++wr_bytes_;
+				}
+				++pages_;
+				n += l;
+			}
+			return n;
+		}
+
+		static bool put8(uint32_t pos, uint8_t data) noexcept
+		{
+			if(pos >= SIZE) return false;
+			write_(&data, 1, pos);
+			return true;
+		}
+
+		static bool get8(uint32_t pos, uint8_t& data) noexcept
+		{
+			if(pos >= SIZE) return false;
+			data = mem_[pos];
+			return true;
+		}
+
+		static uint32_t copy(const void* src, uint32_t len, uint32_t dst) noexcept
+		{
+			if(dst >= SIZE || len > SIZE || src == nullptr) return 0;
+			if((dst + len) > SIZE) len = SIZE - dst;
+			return write_(static_cast<const uint8_t*>(src), len, dst);
+		}
+
+		static uint32_t copy(uint32_t src, uint32_t len, void* dst) noexcept
+		{
+			if(dst == nullptr || src >= SIZE || len > SIZE) return 0;
+			if((src + len) > SIZE) len = SIZE - src;
+			std::memcpy(dst, &mem_[src], len);
+			return len;
+		}
+	};
+
+	template <uint32_t ID> uint8_t eeprom_sim<ID>::mem_[SIZE];
+	template <uint32_t ID> uint64_t eeprom_sim<ID>::wr_bytes_;
+	template <uint32_t ID> uint64_t eeprom_sim<ID>::bus_bytes_;
+	template <uint32_t ID> uint64_t eeprom_sim<ID>::pages_;
+	template <uint32_t ID> int64_t eeprom_sim<ID>::fail_ = -1;
+
+	std::mt19937	rnd_(4321);
+
+	std::string make_text_(uint32_t len)
+	{
+		std::string s;
+		uint32_t n = 0;
+		while(s.size() < len) {
+			char tmp[64];
+			std::snprintf(tmp, sizeof(tmp), "%06u T=%u.%02u V=%u.%03u\n", n,
+				static_cast<uint32_t>(rnd_() % 60), static_cast<uint32_t>(rnd_() % 100),
+				static_cast<uint32_t>(rnd_() % 5), static_cast<uint32_t>(rnd_() % 1000));
+			s += tmp;
+			++n;
+		}
+		s.resize(len);
+		return s;
+	}
+
+
+	template <class LOG, class MEM>
+	void traffic_(const char* title, const std::string& text)
+	{
+		MEM::reset();
+		LOG log;
+		log.start();
+		log.clear();
+		MEM::reset();
+		for(auto ch : text) {
+			log.putch(ch);
+		}
+		log.flush();
+		double n = static_cast<double>(text.size());
+		std::printf("  %-22s write %6.2f, bus %6.2f, pages %6.3f / byte, time %8.1f ms\n",
+			title, MEM::wr_bytes_ / n, MEM::bus_bytes_ / n, MEM::pages_ / n,
+			static_cast<double>(MEM::pages_ * MEM::WRITE_US) / 1000.0);
+	}
+
+
+	template <class LOG, class MEM, uint32_t LOST_MAX>
+	void recovery_(const char* title, uint32_t loop)
+	{
+		uint32_t fail = 0;
+		uint32_t lost_max = 0;
+		uint64_t lost_sum = 0;
+		for(uint32_t n = 0; n < loop; ++n) {
+			MEM::fail_ = -1;
+			{
+				LOG log;
+				log.start();
+				log.clear();
+			}
+			// ログ領域を越えない範囲で書き込み、途中で電源断
+			auto text = make_text_(1000 + rnd_() % 6000);
+			MEM::fail_ = rnd_() % (text.size() * 2);
+			uint32_t done = 0;
+			{
+				LOG log;
+				log.start();
+				for(auto ch : text) {
+					if(MEM::fail_ == 0) break;
+					log.putch(ch);
+					++done;
+				}
+			}
+			MEM::fail_ = -1;
+
+			LOG log;
+			if(!log.start()) {
+				std::printf("  %s: header lost (%u)\n", title, n);
+				++fail;
+				continue;
+			}
+			auto len = log.get_length();
+			std::string s;
+			for(uint32_t i = 0; i < len; ++i) {
+				s += log.getch(i);
+			}
+			if(len > done || text.compare(0, len, s) != 0) {
+				std::printf("  %s: mismatch (%u, %u / %u)\n", title, n, len, done);
+				++fail;
+				continue;
+			}
+			auto lost = done - len;
+			if(lost > LOST_MAX) {
+				std::printf("  %s: lost %u bytes (%u)\n", title, lost, n);
+				++fail;
+			}
+			if(lost > lost_max) lost_max = lost;
+			lost_sum += lost;
+		}
+		host::check(fail == 0, "%-22s lost avg %5.1f, max %4u bytes", title,
+			static_cast<double>(lost_sum) / loop, lost_max);
+	}
+
+
+	template <class LOG>
+	void records_()
+	{
+		LOG log;
+		log.start();
+		log.clear();
+		struct rec_t {
+			uint32_t	time;
+			uint8_t		data[32];
+			uint32_t	len;
+		};
+		rec_t recs[100];
+		for(uint32_t i = 0; i < 100; ++i) {
+			auto& r = recs[i];
+			r.time = i * 1000 + rnd_() % 1000;
+			r.len = rnd_() % 33;
+			for(uint32_t j = 0; j < r.len; ++j) r.data[j] = rnd_();
+			log.puts("text line\n");
+			log.put_record(r.time, r.data, r.len);
+		}
+		log.flush();
+
+		LOG log2;
+		log2.start();
+		uint32_t pos = 0;
+		uint32_t n = 0;
+		bool ok = true;
+		while(1) {
+			uint32_t time;
+			uint8_t tmp[256];
+			uint32_t len = sizeof(tmp);
+			if(!log2.get_record(pos, time, tmp, len)) break;
+			if(n >= 100 || time != recs[n].time || len != recs[n].len || std::memcmp(tmp, recs[n].data, len) != 0) {
+				ok = false;
+				break;
+			}
+			++n;
+		}
+		host::check(ok && n == 100, "records: %u / 100", n);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto loop = host::arg(argc, argv, 1, 500);
+
+	typedef eeprom_sim<0> MEM0;
+	typedef eeprom_sim<1> MEM1;
+	typedef eeprom_sim<2> MEM2;
+	typedef utils::log_man<MEM0> LOG0;				// 以前と同じ（１バイト毎にヘッダー）
+	typedef utils::log_man<MEM1, 64, 256> LOG1;
+	typedef utils::log_man<MEM2, 64, 1024> LOG2;
+
+	auto text = make_text_(100000);
+	std::printf("Traffic (%u bytes logged, EEPROM page %u):\n", static_cast<uint32_t>(text.size()), MEM0::PAGE);
+	traffic_<LOG0, MEM0>("write through", text);
+	traffic_<LOG1, MEM1>("PAGE 64, CHECK 256", text);
+	traffic_<LOG2, MEM2>("PAGE 64, CHECK 1024", text);
+
+	std::printf("Power fail (%u trials):\n", loop);
+	recovery_<LOG0, MEM0, 1>("write through", loop);
+	recovery_<LOG1, MEM1, 256 + 64>("PAGE 64, CHECK 256", loop);
+	recovery_<LOG2, MEM2, 1024 + 64>("PAGE 64, CHECK 1024", loop);
+
+	std::printf("Binary records:\n");
+	records_<LOG1>();
+
+	return host::result();
+}
@@ -0,0 +1,201 @@
+//=========================================================================//
+/*! @file
+    @brief  LTC2348-16 フレーム・リング検証（ホスト用） @n
+			chip::LTC2348_16_FRAME（バースト取得のリング）を調べる。 @n
+			・24 ビット・ワードの変換値、チャネル ID、スパンの分解 @n
+			・チャネル ID が並び順と違うフレームの検出 @n
+			・スパン毎の電圧（バイポーラは２の補数）の端点 @n
+			・割り込み側とメイン側の取り出し間隔がずれても、変換番号が @n
+			  連続し、一杯の時は捨てたフレームとして数えるか
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "chip/LTC2348_16_FRAME.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr uint32_t FRAMES = 256;
+
+	typedef chip::LTC2348_16_FRAME<FRAMES> FRAME;
+	typedef FRAME::raw_t raw_t;
+	typedef FRAME::frame_t frame_t;
+
+	FRAME	frame_;
+
+	std::mt19937	rnd_(1234);
+
+	// SDO0 のワード：D15～D0, 0, 0, チャネル ID(3), スパン(3)
+	uint32_t make_word_(uint16_t value, uint32_t ch, uint32_t span)
+	{
+		return (static_cast<uint32_t>(value) << 8) | ((ch & 7) << 3) | (span & 7);
+	}
+
+	void make_raw_(raw_t& raw, uint32_t seq, const uint16_t* value, uint32_t span)
+	{
+		raw.seq = seq;
+		for(uint32_t i = 0; i < FRAME::CHANNELS; ++i) {
+			raw.word[i] = make_word_(value[i], i, span >> (i * 3));
+		}
+	}
+
+	void test_decode_()
+	{
+		bool ok = true;
+		for(uint32_t n = 0; n < 1000; ++n) {
+			uint16_t value[FRAME::CHANNELS];
+			for(auto& v : value) v = rnd_();
+			uint32_t span = rnd_() & 0xffffff;
+			raw_t raw;
+			make_raw_(raw, n, value, span);
+			frame_t f;
+			if(!FRAME::decode(raw, f)) ok = false;
+			if(f.seq != n || f.span != span) ok = false;
+			for(uint32_t i = 0; i < FRAME::CHANNELS; ++i) {
+				if(f.value[i] != value[i]) ok = false;
+			}
+			// チャネル ID のずれ（１ワード分シフトして読んだ）
+			raw.word[n & 7] = make_word_(value[n & 7], (n & 7) + 1, 0);
+			if(FRAME::decode(raw, f)) ok = false;
+			// 「０」のビットが立っている
+			make_raw_(raw, n, value, span);
+			raw.word[3] |= 0x40;
+			if(FRAME::decode(raw, f)) ok = false;
+		}
+		host::check(ok, "decode:   value / channel ID / span, ID mismatch detection");
+	}
+
+	bool near_(float a, float b)
+	{
+		return std::fabs(a - b) < 0.001f;
+	}
+
+	void test_voltage_()
+	{
+		bool ok = true;
+		static constexpr float fs[8] = { 0.0f, 5.12f, 10.0f, 10.24f, 10.0f, 10.24f, 20.0f, 20.48f };
+		for(uint32_t s = 1; s < 8; ++s) {
+			bool bipolar = (s == 2 || s == 3 || s == 6 || s == 7);
+			auto lsb = fs[s] / 65536.0f;
+			if(bipolar) {
+				ok = near_(FRAME::to_voltage(0x0000, s), 0.0f) && ok;
+				ok = near_(FRAME::to_voltage(0x7fff, s), fs[s] / 2 - lsb) && ok;
+				ok = near_(FRAME::to_voltage(0x8000, s), -fs[s] / 2) && ok;
+				ok = near_(FRAME::to_voltage(0xffff, s), -lsb) && ok;
+			} else {
+				ok = near_(FRAME::to_voltage(0x0000, s), 0.0f) && ok;
+				ok = near_(FRAME::to_voltage(0xffff, s), fs[s] - lsb) && ok;
+			}
+		}
+		ok = near_(FRAME::to_voltage(0x1234, 0), 0.0f) && ok;
+		host::check(ok, "voltage:  end points for spans 1 to 7 (two's complement for bipolar)");
+	}
+
+	// 割り込み側：変換番号 seq のフレームを置く
+	bool put_(uint32_t seq)
+	{
+		auto raw = frame_.alloc();
+		if(raw == nullptr) return false;
+		uint16_t value[FRAME::CHANNELS];
+		for(uint32_t i = 0; i < FRAME::CHANNELS; ++i) {
+			value[i] = seq * 8 + i;
+		}
+		make_raw_(*raw, seq, value, 0xffffff);
+		frame_.commit();
+		return true;
+	}
+
+	void test_ring_(uint32_t total)
+	{
+		bool ok = true;
+		std::vector<frame_t> out(FRAMES);
+
+		// 取り出しが間に合っている場合：捨てない、番号が連続
+		frame_.clear();
+		uint32_t seq = 0;
+		uint32_t next = 0;
+		while(next < total) {
+			auto n = rnd_() % (FRAMES / 2) + 1;
+			if(n > (FRAMES - frame_.length())) n = FRAMES - frame_.length();
+			for(uint32_t i = 0; i < n && seq < total; ++i) {
+				put_(seq++);
+			}
+			if(frame_.length() > FRAMES) ok = false;
+			auto m = frame_.read(&out[0], rnd_() % FRAMES + 1);
+			for(uint32_t i = 0; i < m; ++i) {
+				auto& f = out[i];
+				if(f.seq != next || f.value[5] != static_cast<uint16_t>(next * 8 + 5) || f.span != 0xffffff) ok = false;
+				++next;
+			}
+		}
+		if(frame_.get_dropped() != 0 || frame_.get_error() != 0) ok = false;
+
+		// 取り出しが止まった場合：一杯の後は捨てる、再開後は欠けた番号が分かる
+		frame_.clear();
+		uint32_t put = 0;
+		for(uint32_t i = 0; i < FRAMES + 10; ++i) {
+			if(put_(i)) ++put;
+		}
+		if(put != FRAMES || frame_.get_dropped() != 10) ok = false;
+		auto m = frame_.read(&out[0], FRAMES);
+		if(m != FRAMES || out[FRAMES - 1].seq != FRAMES - 1) ok = false;
+		put_(FRAMES + 10);
+		m = frame_.read(&out[0], FRAMES);
+		if(m != 1 || out[0].seq != FRAMES + 10) ok = false;
+
+		host::check(ok, "ring:     %u frames, %u conversions, sequence / drop count", FRAMES, total);
+	}
+
+	// SPI で８ワード（192 ビット）を読む時間から、最大サンプル・レートの目安
+	void estimate_()
+	{
+		static constexpr float TCONV_US = 3.0f;  // ８チャネルの変換時間（目安）
+		static constexpr float ISR_US = 1.0f;    // 割り込みの出入り（目安）
+		for(uint32_t spi : { 15'000'000, 30'000'000, 60'000'000 }) {
+			auto rd = 192.0f * 1e6f / static_cast<float>(spi);
+			auto t = TCONV_US + ISR_US + rd;
+			std::printf("  estimate: SPI %2u MHz: read %.1f us, frame %.1f us, max %.0f frames/s (%.0f KB/s)\n",
+				spi / 1'000'000, rd, t, 1e6f / t, 1e3f / t * sizeof(frame_t));
+		}
+	}
+
+	void bench_()
+	{
+		std::vector<frame_t> out(FRAMES);
+		double best = 1e30;
+		for(uint32_t i = 0; i < 100; ++i) {
+			frame_.clear();
+			for(uint32_t j = 0; j < FRAMES; ++j) put_(j);
+			host::stop_watch t;
+			frame_.read(&out[0], FRAMES);
+			auto d = t.stop();
+			if(d < best) best = d;
+		}
+		std::printf("  bench:    read (decode) %.1f %s/frame (%u frames per call)\n",
+			best / FRAMES, host::stop_watch::unit(), FRAMES);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto total = host::arg(argc, argv, 1, 100'000);
+
+	std::printf("LTC2348-16 frame ring (%u channels, frame %u bytes):\n",
+		FRAME::CHANNELS, static_cast<uint32_t>(sizeof(frame_t)));
+	test_decode_();
+	test_voltage_();
+	test_ring_(total);
+	estimate_();
+	bench_();
+
+	return host::result();
+}
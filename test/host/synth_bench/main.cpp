@@ -0,0 +1,245 @@
+//=========================================================================//
+/*! @file
+    @brief  FM シンセサイザー発音管理の検証（ホスト用） @n
+			SynthUnit（sound/synth）の発音の管理を調べ、１フレームの負荷を測る。 @n
+			・鳴り終わった発音は、空きに戻るか @n
+			・サステイン中のノート・オン（同じ鍵の再打鍵を含む）の後、ペダルと @n
+			  ノート・オフで、全ての発音が空きに戻るか @n
+			・発音数の上限を超えたノート・オンは、発音を奪うか @n
+			・上限の設定範囲、負荷に合わせた上限の増減 @n
+			・上限を下げると、超えた発音をすぐに奪うか @n
+			・ブロック化したオペレーター・カーネルが、１サンプル毎の式と一致するか @n
+			※「make BUILD=debug」で、-O0 でもリンク出来る事を確認する。
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <random>
+
+#include "sound/synth/synth_unit.h"
+#include "sound/synth/sin.h"
+#include "sound/synth/fm_op_kernel.h"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr int SAMPLE_RATE = 48'000;
+	static constexpr int FRAME = SAMPLE_RATE / 60;  // １フレーム（60Hz）のサンプル数
+
+	RingBuffer	ring_;
+
+	int16_t		wave_[FRAME];
+
+	void midi_(uint8_t a, uint8_t b, uint8_t c)
+	{
+		uint8_t tmp[3] = { a, b, c };
+		ring_.Write(tmp, 3);
+	}
+
+	void note_on_(uint8_t key) { midi_(0x90, key, 100); }
+	void note_off_(uint8_t key) { midi_(0x80, key, 0); }
+	void pedal_(bool on) { midi_(0xb0, 64, on ? 127 : 0); }
+
+	void frame_(SynthUnit& su, int n = 1)
+	{
+		for(int i = 0; i < n; ++i) {
+			su.GetSamples(FRAME, wave_);
+		}
+	}
+
+	// 鳴り終わるまで回す（最大 10 秒）
+	bool drain_(SynthUnit& su)
+	{
+		for(int i = 0; i < 600; ++i) {
+			frame_(su);
+			if(su.GetLiveVoices() == 0) return true;
+		}
+		return false;
+	}
+
+	void test_release_()
+	{
+		SynthUnit su(ring_);
+		bool ok = true;
+		note_on_(60);
+		note_on_(64);
+		frame_(su, 10);
+		if(su.GetLiveVoices() != 2) ok = false;
+		note_off_(60);
+		note_off_(64);
+		ok = drain_(su) && ok;
+		host::check(ok, "release:  voices return after note off");
+	}
+
+	void test_sustain_()
+	{
+		SynthUnit su(ring_);
+		bool ok = true;
+		// ペダルを踏んだまま打鍵、離鍵、同じ鍵を再打鍵
+		pedal_(true);
+		note_on_(60);
+		frame_(su, 5);
+		note_off_(60);
+		frame_(su, 5);
+		note_on_(60);
+		note_on_(67);
+		frame_(su, 5);
+		if(su.GetLiveVoices() != 3) ok = false;
+		// ペダルを離してから離鍵
+		pedal_(false);
+		frame_(su, 5);
+		note_off_(60);
+		note_off_(67);
+		ok = drain_(su) && ok;
+
+		// 離鍵の後にペダルを離す
+		pedal_(true);
+		note_on_(72);
+		frame_(su, 5);
+		note_off_(72);
+		frame_(su, 60);
+		if(su.GetLiveVoices() != 1) ok = false;  // ペダルで保持
+		pedal_(false);
+		ok = drain_(su) && ok;
+		host::check(ok, "sustain:  note on while sustained, pedal and note off release all voices");
+	}
+
+	void test_limit_()
+	{
+		SynthUnit su(ring_);
+		bool ok = true;
+		su.SetVoiceLimit(1000);
+		if(su.GetVoiceLimit() != SynthUnit::GetMaxVoices()) ok = false;
+		su.SetVoiceLimit(0);
+		if(su.GetVoiceLimit() != 1) ok = false;
+
+		su.SetVoiceLimit(4);
+		for(int i = 0; i < 8; ++i) {
+			note_on_(48 + i);
+			frame_(su);
+			if(su.GetLiveVoices() > 4) ok = false;
+		}
+		if(su.GetLiveVoices() != 4 || su.GetStealCount() != 4) ok = false;
+		for(int i = 0; i < 8; ++i) note_off_(48 + i);
+		ok = drain_(su) && ok;
+
+		// 負荷に合わせた増減（上限に達している時だけ増やす）
+		su.SetVoiceLimit(4);
+		su.AdjustVoiceLimit(80, 50);
+		if(su.GetVoiceLimit() != 3) ok = false;
+		su.AdjustVoiceLimit(10, 50);
+		if(su.GetVoiceLimit() != 3) ok = false;
+		for(int i = 0; i < 3; ++i) note_on_(60 + i);
+		frame_(su);
+		su.AdjustVoiceLimit(10, 50);
+		if(su.GetVoiceLimit() != 4) ok = false;
+		su.AdjustVoiceLimit(45, 50);  // ヒステリシスの範囲
+		if(su.GetVoiceLimit() != 4) ok = false;
+		for(int i = 0; i < 3; ++i) note_off_(60 + i);
+		ok = drain_(su) && ok;
+
+		// 上限を下げたら、超えた発音は次のノート・オンを待たずに奪う
+		auto steal = su.GetStealCount();
+		su.SetVoiceLimit(4);
+		for(int i = 0; i < 4; ++i) note_on_(60 + i);
+		frame_(su);
+		if(su.GetLiveVoices() != 4) ok = false;
+		su.SetVoiceLimit(2);
+		if(su.GetLiveVoices() != 2 || su.GetStealCount() != steal + 2) ok = false;
+		su.AdjustVoiceLimit(80, 50);
+		if(su.GetLiveVoices() != 1 || su.GetStealCount() != steal + 3) ok = false;
+		frame_(su);
+		for(int i = 0; i < 4; ++i) note_off_(60 + i);
+		ok = drain_(su) && ok;
+
+		host::check(ok, "limit:    range, voice stealing over the limit, lowered limit, load adjustment");
+	}
+
+
+	// １サンプル毎の式（カーネルの元の形）
+	void ref_op_(int32_t* out, const int32_t* in, int32_t phase, int32_t freq,
+		int32_t gain1, int32_t gain2, bool add)
+	{
+		int32_t dgain = (gain2 - gain1 + (SYNTH_N >> 1)) >> SYNTH_LG_N;
+		int32_t gain = gain1;
+		for(int i = 0; i < SYNTH_N; ++i) {
+			gain += dgain;
+			int32_t y = Sin::lookup(phase + (in != nullptr ? in[i] : 0));
+			int32_t y1 = (static_cast<int64_t>(y) * static_cast<int64_t>(gain)) >> 24;
+			out[i] = add ? out[i] + y1 : y1;
+			phase += freq;
+		}
+	}
+
+	void test_kernel_()
+	{
+		std::mt19937 rnd(5678);
+		int32_t in[SYNTH_N];
+		int32_t a[SYNTH_N];
+		int32_t b[SYNTH_N];
+		bool ok = true;
+		for(int n = 0; n < 10000 && ok; ++n) {
+			int32_t phase = rnd();
+			int32_t freq = rnd() & 0xfffff;
+			// ゲインは Q24 で 0 から 1 倍
+			int32_t gain1 = rnd() % (1 << 24);
+			int32_t gain2 = rnd() % (1 << 24);
+			bool add = (n & 1) != 0;
+			for(int i = 0; i < SYNTH_N; ++i) {
+				in[i] = static_cast<int32_t>(rnd() % (1 << 25)) - (1 << 24);
+				a[i] = b[i] = static_cast<int32_t>(rnd() % (1 << 24)) - (1 << 23);
+			}
+			if((n & 2) == 0) {
+				FmOpKernel::compute(a, in, phase, freq, gain1, gain2, add);
+				ref_op_(b, in, phase, freq, gain1, gain2, add);
+			} else {
+				FmOpKernel::compute_pure(a, phase, freq, gain1, gain2, add);
+				ref_op_(b, nullptr, phase, freq, gain1, gain2, add);
+			}
+			for(int i = 0; i < SYNTH_N; ++i) {
+				if(a[i] != b[i]) {
+					std::printf("  kernel mismatch: %d, [%d] %d / %d\n", n, i, a[i], b[i]);
+					ok = false;
+					break;
+				}
+			}
+		}
+		host::check(ok, "kernel:   block kernel (compute / compute_pure) matches the per sample formula");
+	}
+
+	// 発音数毎の、１フレームの処理時間
+	void bench_()
+	{
+		SynthUnit su(ring_);
+		int n = 0;
+		for(int voices : { 1, 4, 8, 16 }) {
+			if(voices > SynthUnit::GetMaxVoices()) break;
+			while(n < voices) {
+				note_on_(36 + n * 3);
+				++n;
+			}
+			frame_(su);
+			auto best = host::best_of(50, [&]() { frame_(su); });
+			std::printf("  bench:    %2d voices: %.0f %s/frame (%d samples)\n",
+				su.GetLiveVoices(), best, host::stop_watch::unit(), FRAME);
+		}
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	SynthUnit::Init(SAMPLE_RATE);
+
+	std::printf("FM synth voice management (max %d voices):\n", SynthUnit::GetMaxVoices());
+	test_release_();
+	test_sustain_();
+	test_limit_();
+	test_kernel_();
+	bench_();
+
+	return host::result();
+}
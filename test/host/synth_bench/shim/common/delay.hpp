@@ -0,0 +1,36 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	遅延ユーティリティー（ホスト・シミュレーター用）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cstdint>
+#include <chrono>
+#include <thread>
+
+namespace utils {
+
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	/*!
+		@brief  遅延（ホストではスレッドをスリープする）
+	*/
+	//+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++//
+	struct delay {
+
+		static void loop(uint32_t cnt) noexcept { }
+
+		static void micro_second(uint32_t us) noexcept
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(us));
+		}
+
+		static void milli_second(uint32_t ms) noexcept
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+		}
+	};
+}
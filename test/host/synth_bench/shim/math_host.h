@@ -0,0 +1,15 @@
+#pragma once
+//=====================================================================//
+/*!	@file
+	@brief	ホスト用 math.h の調整 @n
+			glibc の math.h は M_PI をマクロで定義するが、sound/synth は @n
+			同じ名前の定数を定義するので、先に読み込んで取り消す。 @n
+			（-include で、全てのソースの先頭に読み込む）
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=====================================================================//
+#include <cmath>
+#undef M_PI
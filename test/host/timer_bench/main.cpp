@@ -0,0 +1,280 @@
+//=========================================================================//
+/*! @file
+    @brief  タイマー・ホイール・ベンチマーク（ホスト用） @n
+			utils::timer_wheel を、全てのタイマーを毎回調べる参照実装と比べ、 @n
+			登録、取り消し、時間を進める処理のサイクル数を測る。 @n
+			・ランダムな期限、周期、取り消し、進める幅で、呼ばれる時刻と順番が @n
+			  参照実装と一致するか（2^25 ティックを超える期限を含む） @n
+			・コールバックの中での取り消し、登録 @n
+			・next() が、次に呼ばれる時刻より後を返さないか
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <random>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+#include "common/timer_wheel.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	static constexpr uint32_t TIMER_MAX = 64;
+	typedef utils::timer_wheel<TIMER_MAX> WHEEL;
+
+	std::mt19937	rnd_(1234);
+
+	WHEEL	wheel_;
+
+	struct event_t {
+		uint32_t	tick;
+		uint32_t	id;
+		bool operator < (const event_t& t) const {
+			return tick != t.tick ? (tick < t.tick) : (id < t.id);
+		}
+		bool operator == (const event_t& t) const { return tick == t.tick && id == t.id; }
+	};
+
+	std::vector<event_t>	fired_;
+
+	void task_(uint32_t id, void* ctx)
+	{
+		fired_.push_back(event_t { wheel_.get_now(), id });
+	}
+
+	// 参照実装（全てのタイマーを毎回調べる）
+	struct ref_t {
+		struct timer_t {
+			uint32_t	expire;
+			uint32_t	period;
+		};
+		std::map<uint32_t, timer_t>	map_;
+		uint32_t	now_ = 0;
+
+		void advance(uint32_t ticks, std::vector<event_t>& out)
+		{
+			auto end = now_ + ticks;
+			// ホイールと同じ規則：期限順に呼び、取り残した周期は飛ばす
+			while(1) {
+				uint32_t best = 0xffff'ffff;
+				for(const auto& t : map_) {
+					auto d = t.second.expire - now_;
+					if(d <= ticks && d < best) best = d;
+				}
+				if(best == 0xffff'ffff) break;
+				auto tick = now_ + best;
+				ticks -= best;
+				now_ = tick;
+				for(auto it = map_.begin(); it != map_.end(); ) {
+					if(it->second.expire != tick) { ++it; continue; }
+					out.push_back(event_t { tick, it->first });
+					if(it->second.period != 0) {
+						auto& t = it->second;
+						t.expire += t.period;
+						auto late = end - t.expire;
+						if(late != 0 && late < 0x8000'0000) {
+							t.expire += ((late - 1) / t.period + 1) * t.period;
+						}
+						++it;
+					} else {
+						it = map_.erase(it);
+					}
+				}
+			}
+			now_ = end;
+		}
+	};
+
+	uint32_t rand_delay_()
+	{
+		switch(rnd_() % 8) {
+		case 0:  return rnd_() % 4;
+		case 1:  return rnd_() % 40;
+		case 2:  return rnd_() % 2000;
+		case 3:  return rnd_() % 70000;
+		case 4:  return rnd_() % 3000000;
+		case 5:  return WHEEL::RANGE - 10 + rnd_() % 20;
+		case 6:  return WHEEL::RANGE + rnd_() % (WHEEL::RANGE * 3);
+		default: return rnd_() % 300;
+		}
+	}
+
+
+	bool test_random_(uint32_t loop)
+	{
+		wheel_.reset(0xffff'f000);  // 32 ビットの一周も試す
+		ref_t ref;
+		ref.now_ = wheel_.get_now();
+		std::vector<uint32_t> ids;
+		std::vector<event_t> exp;
+		fired_.clear();
+
+		for(uint32_t n = 0; n < loop; ++n) {
+			auto op = rnd_() % 10;
+			if(op < 4 && wheel_.size() < TIMER_MAX) {
+				auto delay = rand_delay_();
+				if(delay == 0) delay = 1;
+				uint32_t period = 0;
+				if(rnd_() % 3 == 0) period = 1 + rand_delay_() % 5000;
+				auto id = wheel_.add(delay, period, task_);
+				if(id == WHEEL::ID_NONE) {
+					std::printf("  add failed\n");
+					return host::check(false, "random");
+				}
+				ref.map_[id] = ref_t::timer_t { ref.now_ + delay, period };
+				ids.push_back(id);
+			} else if(op < 6 && !ids.empty()) {
+				auto i = rnd_() % ids.size();
+				auto id = ids[i];
+				bool a = wheel_.cancel(id);
+				bool b = ref.map_.erase(id) != 0;
+				if(a != b) {
+					std::printf("  cancel mismatch: id %08X\n", id);
+					return host::check(false, "random");
+				}
+				ids.erase(ids.begin() + i);
+			} else {
+				uint32_t ticks;
+				switch(rnd_() % 4) {
+				case 0:  ticks = rnd_() % 4; break;
+				case 1:  ticks = rnd_() % 100; break;
+				case 2:  ticks = rnd_() % 100000; break;
+				default: ticks = rnd_() % 20000000; break;
+				}
+				// next() より前に呼ばれるものが無いか
+				auto nx = wheel_.next();
+				auto org = fired_.size();
+				wheel_.advance(ticks);
+				ref.advance(ticks, exp);
+				if(fired_.size() > org && nx != WHEEL::TICK_NONE) {
+					auto first = fired_[org].tick - (wheel_.get_now() - ticks);
+					if(first < nx) {
+						std::printf("  next() too late: %u > %u\n", nx, first);
+						return host::check(false, "random");
+					}
+				}
+				if(wheel_.get_now() != ref.now_ || wheel_.size() != ref.map_.size()) {
+					std::printf("  state mismatch: size %u / %u\n",
+						wheel_.size(), static_cast<uint32_t>(ref.map_.size()));
+					return host::check(false, "random");
+				}
+			}
+		}
+		std::sort(fired_.begin(), fired_.end());
+		std::sort(exp.begin(), exp.end());
+		if(fired_ != exp) {
+			std::printf("  fire mismatch: %u / %u events\n",
+				static_cast<uint32_t>(fired_.size()), static_cast<uint32_t>(exp.size()));
+			return host::check(false, "random");
+		}
+		auto& st = wheel_.get_stat();
+		return host::check(true, "random:   %u events, %u cascades, %u steps, %u skipped ticks",
+			st.fired, st.cascades, st.steps, st.skips);
+	}
+
+
+	uint32_t self_id_;
+	uint32_t self_cnt_;
+	uint32_t other_id_;
+
+	void self_task_(uint32_t id, void* ctx)
+	{
+		++self_cnt_;
+		if(self_cnt_ == 3) {
+			wheel_.cancel(id);
+			wheel_.cancel(other_id_);
+			wheel_.add(5, 0, task_);
+		}
+	}
+
+	void test_callback_()
+	{
+		wheel_.reset();
+		fired_.clear();
+		self_cnt_ = 0;
+		self_id_ = wheel_.add(10, 10, self_task_);
+		other_id_ = wheel_.add(31, 0, task_);  // 呼ばれる前に取り消される
+		for(uint32_t i = 0; i < 100; ++i) wheel_.advance(1);
+		bool ok = self_cnt_ == 3 && fired_.size() == 1 && fired_[0].tick == 35
+			&& wheel_.size() == 0 && !wheel_.is_active(self_id_);
+		// まとめて進めると、取り残した周期は飛ばす（遅れて一回だけ呼ぶ）
+		wheel_.reset();
+		self_cnt_ = 0;
+		auto id = wheel_.add(10, 10, self_task_);
+		wheel_.advance(95);
+		ok = ok && self_cnt_ == 1 && wheel_.get_stat().overruns == 8 && wheel_.get_remain(id) == 5;
+		host::check(ok, "callback: cancel / add in callback, skip of late periods");
+	}
+
+
+	void null_task_(uint32_t id, void* ctx) { }
+
+	void bench_()
+	{
+		wheel_.reset();
+		std::vector<uint32_t> ids(TIMER_MAX);
+		std::vector<uint32_t> delay(TIMER_MAX);
+		for(auto& d : delay) d = 1 + rand_delay_() % 1000000;
+
+		double add_best = 1e30;
+		double cancel_best = 1e30;
+		for(uint32_t n = 0; n < 100; ++n) {
+			host::stop_watch t;
+			for(uint32_t i = 0; i < TIMER_MAX; ++i) ids[i] = wheel_.add(delay[i], 0, null_task_);
+			auto a = t.stop();
+			t.start();
+			for(uint32_t i = 0; i < TIMER_MAX; ++i) wheel_.cancel(ids[i]);
+			auto c = t.stop();
+			if(a < add_best) add_best = a;
+			if(c < cancel_best) cancel_best = c;
+		}
+
+		// 周期タイマーで埋めて、１ティック毎に進める
+		for(uint32_t i = 0; i < TIMER_MAX; ++i) wheel_.add(1 + i, 10 + i * 7, null_task_);
+		wheel_.clear_stat();
+		host::stop_watch t;
+		for(uint32_t i = 0; i < 100000; ++i) wheel_.advance(1);
+		auto tick = t.stop() / 100000;
+		auto fired = wheel_.get_stat().fired;
+
+		// 長い期限だけの時、まとめて進める（ティックレスの形）
+		wheel_.reset();
+		for(uint32_t i = 0; i < 8; ++i) wheel_.add(1000 + i * 999, 5000 + i * 1234, null_task_);
+		wheel_.clear_stat();
+		t.start();
+		uint32_t wake = 0;
+		for(uint32_t i = 0; i < 10000; ++i) {
+			wheel_.advance(wheel_.next());
+			++wake;
+		}
+		auto sleep = t.stop() / wake;
+		auto& st = wheel_.get_stat();
+
+		auto u = host::stop_watch::unit();
+		std::printf("  bench:    add %.1f, cancel %.1f %s/timer\n",
+			add_best / TIMER_MAX, cancel_best / TIMER_MAX, u);
+		std::printf("            advance(1) with %u periodic timers: %.1f %s/tick (%u callbacks)\n",
+			TIMER_MAX, tick, u, fired);
+		std::printf("            advance(next()): %.1f %s/wakeup, %.1f ticks/wakeup\n",
+			sleep, u, static_cast<double>(st.steps + st.skips) / wake);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto loop = host::arg(argc, argv, 1, 200000);
+
+	std::printf("Timer wheel (%u slots x %u levels, %u timers, %u operations):\n",
+		WHEEL::SLOT_NUM, WHEEL::LEVEL_NUM, TIMER_MAX, loop);
+	test_random_(loop);
+	test_callback_();
+	bench_();
+
+	return host::result();
+}
@@ -0,0 +1,219 @@
+//=========================================================================//
+/*! @file
+    @brief  WS2812B ビット・ストリーム検証（ホスト用） @n
+			chip::WS2812B_ENC が作るデューティーの列を、波形に戻して調べる。 @n
+			・階調テーブル（ガンマ、明るさ）の端点と単調性 @n
+			・PCLK 毎に、T0H, T0L, T1H, T1L がデータシートの範囲（±150ns）か @n
+			・ドライバーと同じリング・バッファの補充で、DMA が読む順に並べた @n
+			  波形を復号して、元の GRB（階調テーブル後）と一致するか @n
+			・補充の間隔がずれても、DMA に追い越されないか
+    @author 平松邦仁 (hira@rvf-rc45.net)
+	@copyright	Copyright (C) 2026 Kunihito Hiramatsu @n
+				Released under the MIT license @n
+				https://github.com/hirakuni45/RX/blob/master/LICENSE
+*/
+//=========================================================================//
+#include <random>
+#include <vector>
+
+#include "chip/WS2812B_ENC.hpp"
+
+#include "test/host/host_test.hpp"
+
+namespace {
+
+	typedef chip::WS2812B_ENC ENC;
+
+	static constexpr uint32_t RING_SLOTS = 256;
+	static constexpr uint32_t TOL_NS = 150;
+
+	ENC		enc_;
+
+	std::mt19937	rnd_(1234);
+
+	bool in_range_(double v, double ref, double tol)
+	{
+		return v >= (ref - tol) && v <= (ref + tol);
+	}
+
+	void test_tone_()
+	{
+		bool ok = true;
+		auto t = enc_.get_tone();
+		for(uint32_t i = 0; i < 256; ++i) {
+			if(t[i] != i) ok = false;
+		}
+		for(float g : { 1.0f, 2.2f, 2.8f }) {
+			enc_.set_gamma(g);
+			for(uint32_t b : { 255, 128, 32 }) {
+				enc_.set_brightness(b);
+				t = enc_.get_tone();
+				if(t[0] != 0 || t[255] != b) ok = false;
+				for(uint32_t i = 1; i < 256; ++i) {
+					if(t[i] < t[i - 1]) ok = false;
+				}
+			}
+		}
+		enc_.set_gamma(1.0f);
+		enc_.set_brightness(255);
+		host::check(ok, "tone:     identity by default, end points, monotonic");
+	}
+
+	// MTU の周期は PCLK / 800KHz（分周無し）
+	void test_timing_()
+	{
+		for(uint32_t pclk : { 24'000'000, 32'000'000, 48'000'000, 50'000'000, 60'000'000, 120'000'000 }) {
+			uint32_t period = (pclk + 400'000) / 800'000;
+			enc_.set_timing(period);
+			auto ns = 1e9 / pclk;
+			auto t = period * ns;
+			auto t0h = enc_.get_t0() * ns;
+			auto t1h = enc_.get_t1() * ns;
+			bool f = in_range_(t, ENC::PERIOD_NS, 600)
+				&& in_range_(t0h, ENC::T0H_NS, TOL_NS) && in_range_(t - t0h, 850, TOL_NS)
+				&& in_range_(t1h, ENC::T1H_NS, TOL_NS) && in_range_(t - t1h, 450, TOL_NS);
+			host::check(f, "timing:   PCLK %3u MHz, period %3u: T0H %.0f, T0L %.0f, T1H %.0f, T1L %.0f [ns]",
+				pclk / 1'000'000, period, t0h, t - t0h, t1h, t - t1h);
+		}
+	}
+
+	// ドライバーの補充（WS2812B::fill_）と同じ：DMA が読んだ分だけ続きを変換
+	struct ring_t {
+		uint16_t	ring_[RING_SLOTS];
+		uint32_t	wpos_;
+		uint32_t	total_;
+		uint32_t	underrun_;
+
+		void begin(const uint8_t* src, uint32_t len)
+		{
+			enc_.begin(src, len);
+			total_ = enc_.get_total();
+			wpos_ = enc_.encode(ring_, RING_SLOTS);
+			underrun_ = 0;
+		}
+
+		void fill(uint32_t done)
+		{
+			if(done > wpos_) ++underrun_;
+			auto lim = done + RING_SLOTS;
+			if(lim > total_) lim = total_;
+			while(wpos_ < lim) {
+				auto ofs = wpos_ & (RING_SLOTS - 1);
+				auto n = lim - wpos_;
+				if(n > (RING_SLOTS - ofs)) n = RING_SLOTS - ofs;
+				enc_.encode(&ring_[ofs], n);
+				wpos_ += n;
+			}
+		}
+	};
+
+	ring_t	ring_;
+
+	// 送る（step_max：補充の間に DMA が読むスロット数の最大）
+	uint32_t send_(const uint8_t* src, uint32_t len, uint32_t step_max, std::vector<uint16_t>& out)
+	{
+		out.clear();
+		ring_.begin(src, len);
+		uint32_t done = 0;
+		while(done < ring_.total_) {
+			auto n = (rnd_() % step_max) + 1;
+			for(uint32_t i = 0; i < n && done < ring_.total_; ++i) {
+				out.push_back(ring_.ring_[done & (RING_SLOTS - 1)]);
+				++done;
+			}
+			ring_.fill(done);
+		}
+		return ring_.underrun_;
+	}
+
+	// 波形（High 時間）から復号
+	bool decode_(const std::vector<uint16_t>& slot, uint32_t period, const uint8_t* src, uint32_t len)
+	{
+		if(slot.size() != len * 8 + 1) {
+			std::printf("  length mismatch: %u / %u\n", static_cast<uint32_t>(slot.size()), len * 8 + 1);
+			return false;
+		}
+		auto tone = enc_.get_tone();
+		uint32_t err = 0;
+		for(uint32_t i = 0; i < len; ++i) {
+			uint8_t v = 0;
+			for(uint32_t j = 0; j < 8; ++j) {
+				auto h = slot[i * 8 + j];
+				if(h != enc_.get_t0() && h != enc_.get_t1()) ++err;
+				v <<= 1;
+				if(h > period / 2) v |= 1;
+			}
+			if(v != tone[src[i]]) {
+				if(err < 4) std::printf("  byte mismatch: %u: %02X / %02X\n", i, v, tone[src[i]]);
+				++err;
+			}
+		}
+		if(slot.back() != 0) ++err;  // 最後は Low
+		return err == 0;
+	}
+
+	void test_stream_(uint32_t leds)
+	{
+		bool ok = true;
+		uint32_t period = 75;  // 60MHz
+		enc_.set_timing(period);
+		std::vector<uint8_t> src(leds * 3);
+		for(auto& v : src) v = rnd_();
+		std::vector<uint16_t> out;
+
+		for(float g : { 1.0f, 2.2f }) {
+			enc_.set_gamma(g);
+			enc_.set_brightness(g == 1.0f ? 255 : 100);
+			// 補充の周期は１周の 1/4、割り込みの遅れで最大２倍まで
+			auto ur = send_(&src[0], src.size(), RING_SLOTS / 2, out);
+			if(ur != 0) {
+				std::printf("  underrun: %u\n", ur);
+				ok = false;
+			}
+			if(!decode_(out, period, &src[0], src.size())) ok = false;
+		}
+		// 補充が１周より遅れたら、検出出来るか
+		auto ur = send_(&src[0], src.size(), RING_SLOTS * 2, out);
+		if(ur == 0) ok = false;
+
+		enc_.set_gamma(1.0f);
+		enc_.set_brightness(255);
+		host::check(ok, "stream:   %u LEDs, ring %u slots (%u bytes), decode / underrun detection",
+			leds, RING_SLOTS, static_cast<uint32_t>(RING_SLOTS * sizeof(uint16_t)));
+	}
+
+	void bench_(uint32_t leds)
+	{
+		std::vector<uint8_t> src(leds * 3);
+		for(auto& v : src) v = rnd_();
+		static uint16_t dst[RING_SLOTS];
+		enc_.set_timing(75);
+		double best = 1e30;
+		for(uint32_t i = 0; i < 100; ++i) {
+			enc_.begin(&src[0], src.size());
+			host::stop_watch t;
+			while(enc_.get_remain() > 0) {
+				enc_.encode(dst, RING_SLOTS / 4);
+			}
+			auto d = t.stop();
+			if(d < best) best = d;
+		}
+		std::printf("  bench:    encode %.1f %s/LED (%u LEDs, %u slots per call)\n",
+			best / leds, host::stop_watch::unit(), leds, RING_SLOTS / 4);
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	auto leds = host::arg(argc, argv, 1, 300);
+
+	std::printf("WS2812B bit stream (%u / %u / %u ns, reset %u us):\n",
+		ENC::PERIOD_NS, ENC::T0H_NS, ENC::T1H_NS, ENC::RESET_US);
+	test_tone_();
+	test_timing_();
+	test_stream_(leds);
+	bench_(leds);
+
+	return host::result();
+}
@@ -3,7 +3,7 @@
     @brief  テスト・プロジェクト（unittest では無い！） @n
 			RX72N Envision kit
     @author 平松邦仁 (hira@rvf-rc45.net)
-	@copyright	Copyright (C) 2018, 2021 Kunihito Hiramatsu @n
+	@copyright	Copyright (C) 2018, 2026 Kunihito Hiramatsu @n
 				Released under the MIT license @n
 				https://github.com/hirakuni45/RX/blob/master/LICENSE
 */
@@ -25,6 +25,7 @@
 // #define TEST_QSPI
 // #define TEST_MTU
 // #define TEST_TMR
+// #define TEST_CP932  // Makefile の CSOURCES に $(FATFS_VER)/ffunicode.c を加える
 #define TINY_USB
 
 #ifdef OUT_TPU
@@ -57,6 +58,14 @@
 #include "usb/tinyusb_mng.hpp"
 #endif
 
+#ifdef TEST_CP932
+#include "common/cp932.hpp"
+extern "C" {
+	uint16_t ff_oem2uni(uint16_t oem, uint16_t cp);
+	uint16_t ff_uni2oem(uint32_t uni, uint16_t cp);
+};
+#endif
+
 #if 0
 extern "C" {
 	void __init_tfu(void);
@@ -109,6 +118,60 @@ namespace {
 	typedef utils::command<256> CMD;
 	CMD		cmd_;
 
+#ifdef TEST_CP932
+	typedef device::cmt_mgr<device::CMT1> BENCH_CMT;
+	BENCH_CMT	bench_cmt_;
+
+	volatile uint32_t bench_sum_;
+
+	// 1000Hz の CMT で、変換を繰り返した時間を測る
+	template <class FUNC>
+	void bench_cp932_(const char* title, FUNC func)
+	{
+		static constexpr uint32_t LOOP = 4;
+		uint32_t num = 0;
+		auto st = bench_cmt_.get_counter();
+		for(uint32_t i = 0; i < LOOP; ++i) {
+			num += func();
+		}
+		auto t = bench_cmt_.get_counter() - st;
+		if(t == 0) t = 1;
+		utils::format("%-20s %6u [ms], %8u [chars/s]\n") % title % t
+			% static_cast<uint32_t>(static_cast<uint64_t>(num) * 1000 / t);
+	}
+
+	void test_cp932_()
+	{
+		bench_cmt_.start(1000, device::ICU::LEVEL::_3);
+
+		uint32_t err = 0;
+		for(uint32_t c = 0; c < 0x10000; ++c) {
+			if(utils::cp932::to_unicode(c) != ff_oem2uni(c, 932)) ++err;
+			if(utils::cp932::from_unicode(c) != ff_uni2oem(c, 932)) ++err;
+		}
+		utils::format("CP932 verify: %u errors\n") % err;
+
+		uint32_t sum = 0;
+		bench_cp932_("ff_oem2uni:", [&]() {
+			uint32_t n = 0;
+			for(uint32_t c = 0x8140; c < 0xfcfc; ++c) { sum += ff_oem2uni(c, 932); ++n; }
+			return n; });
+		bench_cp932_("cp932::to_unicode:", [&]() {
+			uint32_t n = 0;
+			for(uint32_t c = 0x8140; c < 0xfcfc; ++c) { sum += utils::cp932::to_unicode(c); ++n; }
+			return n; });
+		bench_cp932_("ff_uni2oem:", [&]() {
+			uint32_t n = 0;
+			for(uint32_t c = 0x80; c < 0x10000; ++c) { sum += ff_uni2oem(c, 932); ++n; }
+			return n; });
+		bench_cp932_("cp932::from_unicode:", [&]() {
+			uint32_t n = 0;
+			for(uint32_t c = 0x80; c < 0x10000; ++c) { sum += utils::cp932::from_unicode(c); ++n; }
+			return n; });
+		bench_sum_ = sum;
+	}
+#endif
+
 #ifdef TEST_CMT
 	static const char* module_str_ = { "CMT" };
 	typedef device::cmt_mgr<device::CMT0> CMT;
@@ -356,6 +419,10 @@ int main(int argc, char** argv)
 	}
 #endif
 
+#ifdef TEST_CP932
+	test_cp932_();
+#endif
+
 	cmd_.set_prompt("# ");
 
 	uint16_t cnt = 0;